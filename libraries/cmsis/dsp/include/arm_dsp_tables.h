@@ -0,0 +1,639 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_dsp_tables.h
+ * Description:  Table registry selecting the FFT and fast math tables to build
+ *
+ * @version  V1.10.0
+ * @date     08 July 2021
+ *
+ * Target Processor: Cortex-M and Cortex-A cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2021 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * The tables of arm_common_tables.c and the structures of arm_const_structs.c
+ * are large, a build linking the whole library carries all of them even when
+ * the application calls a single transform size. With this registry the
+ * application lists the transforms it uses in arm_dsp_tables_conf.h and only
+ * the matching tables and structures are compiled.
+ *
+ * The table guards are evaluated at the top of the aggregate sources
+ * (FastMathFunctions.c, ControllerFunctions.c...), before any cmsis-dsp header,
+ * so this header has to be force included in every translation unit of the
+ * project:
+ *   - mdk (armcc) : --preinclude=arm_dsp_tables.h
+ *   - iar         : --preinclude arm_dsp_tables.h
+ *   - gcc         : -include arm_dsp_tables.h
+ *
+ * The option names follow the cmake options of Source/fft.cmake and
+ * Source/interpol.cmake (ARM_COS_F32 becomes ARM_DSP_USE_COS_F32), each one
+ * selects the same ARM_TABLE_xxx macros as the cmake build. The init function
+ * of a transform size that is not selected returns ARM_MATH_ARGUMENT_ERROR.
+ */
+
+#ifndef _ARM_DSP_TABLES_H
+#define _ARM_DSP_TABLES_H
+
+#include "arm_dsp_tables_conf.h"
+
+#define ARM_DSP_CONFIG_TABLES
+#define ARM_FFT_ALLOW_TABLES
+#define ARM_FAST_ALLOW_TABLES
+
+#if defined(ARM_DSP_USE_ALL_FFT)
+  #define ARM_ALL_FFT_TABLES
+#endif
+
+#if defined(ARM_DSP_USE_ALL_FAST)
+  #define ARM_ALL_FAST_TABLES
+#endif
+
+/* complex, real and dct4 transforms */
+#if defined(ARM_DSP_USE_CFFT_F32_16)
+  #define ARM_TABLE_TWIDDLECOEF_F32_16
+  #define ARM_TABLE_BITREVIDX_FLT_16
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_F32_32)
+  #define ARM_TABLE_TWIDDLECOEF_F32_32
+  #define ARM_TABLE_BITREVIDX_FLT_32
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_F32_64)
+  #define ARM_TABLE_TWIDDLECOEF_F32_64
+  #define ARM_TABLE_BITREVIDX_FLT_64
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_F32_128)
+  #define ARM_TABLE_TWIDDLECOEF_F32_128
+  #define ARM_TABLE_BITREVIDX_FLT_128
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_F32_256)
+  #define ARM_TABLE_TWIDDLECOEF_F32_256
+  #define ARM_TABLE_BITREVIDX_FLT_256
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_F32_512)
+  #define ARM_TABLE_TWIDDLECOEF_F32_512
+  #define ARM_TABLE_BITREVIDX_FLT_512
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_F32_1024)
+  #define ARM_TABLE_TWIDDLECOEF_F32_1024
+  #define ARM_TABLE_BITREVIDX_FLT_1024
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_F32_2048)
+  #define ARM_TABLE_TWIDDLECOEF_F32_2048
+  #define ARM_TABLE_BITREVIDX_FLT_2048
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_F32_4096)
+  #define ARM_TABLE_TWIDDLECOEF_F32_4096
+  #define ARM_TABLE_BITREVIDX_FLT_4096
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_F64_16)
+  #define ARM_TABLE_TWIDDLECOEF_F64_16
+  #define ARM_TABLE_BITREVIDX_FLT64_16
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_F64_32)
+  #define ARM_TABLE_TWIDDLECOEF_F64_32
+  #define ARM_TABLE_BITREVIDX_FLT64_32
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_F64_64)
+  #define ARM_TABLE_TWIDDLECOEF_F64_64
+  #define ARM_TABLE_BITREVIDX_FLT64_64
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_F64_128)
+  #define ARM_TABLE_TWIDDLECOEF_F64_128
+  #define ARM_TABLE_BITREVIDX_FLT64_128
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_F64_256)
+  #define ARM_TABLE_TWIDDLECOEF_F64_256
+  #define ARM_TABLE_BITREVIDX_FLT64_256
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_F64_512)
+  #define ARM_TABLE_TWIDDLECOEF_F64_512
+  #define ARM_TABLE_BITREVIDX_FLT64_512
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_F64_1024)
+  #define ARM_TABLE_TWIDDLECOEF_F64_1024
+  #define ARM_TABLE_BITREVIDX_FLT64_1024
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_F64_2048)
+  #define ARM_TABLE_TWIDDLECOEF_F64_2048
+  #define ARM_TABLE_BITREVIDX_FLT64_2048
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_F64_4096)
+  #define ARM_TABLE_TWIDDLECOEF_F64_4096
+  #define ARM_TABLE_BITREVIDX_FLT64_4096
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_Q31_16)
+  #define ARM_TABLE_TWIDDLECOEF_Q31_16
+  #define ARM_TABLE_BITREVIDX_FXT_16
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_Q31_32)
+  #define ARM_TABLE_TWIDDLECOEF_Q31_32
+  #define ARM_TABLE_BITREVIDX_FXT_32
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_Q31_64)
+  #define ARM_TABLE_TWIDDLECOEF_Q31_64
+  #define ARM_TABLE_BITREVIDX_FXT_64
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_Q31_128)
+  #define ARM_TABLE_TWIDDLECOEF_Q31_128
+  #define ARM_TABLE_BITREVIDX_FXT_128
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_Q31_256)
+  #define ARM_TABLE_TWIDDLECOEF_Q31_256
+  #define ARM_TABLE_BITREVIDX_FXT_256
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_Q31_512)
+  #define ARM_TABLE_TWIDDLECOEF_Q31_512
+  #define ARM_TABLE_BITREVIDX_FXT_512
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_Q31_1024)
+  #define ARM_TABLE_TWIDDLECOEF_Q31_1024
+  #define ARM_TABLE_BITREVIDX_FXT_1024
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_Q31_2048)
+  #define ARM_TABLE_TWIDDLECOEF_Q31_2048
+  #define ARM_TABLE_BITREVIDX_FXT_2048
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_Q31_4096)
+  #define ARM_TABLE_TWIDDLECOEF_Q31_4096
+  #define ARM_TABLE_BITREVIDX_FXT_4096
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_Q15_16)
+  #define ARM_TABLE_TWIDDLECOEF_Q15_16
+  #define ARM_TABLE_BITREVIDX_FXT_16
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_Q15_32)
+  #define ARM_TABLE_TWIDDLECOEF_Q15_32
+  #define ARM_TABLE_BITREVIDX_FXT_32
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_Q15_64)
+  #define ARM_TABLE_TWIDDLECOEF_Q15_64
+  #define ARM_TABLE_BITREVIDX_FXT_64
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_Q15_128)
+  #define ARM_TABLE_TWIDDLECOEF_Q15_128
+  #define ARM_TABLE_BITREVIDX_FXT_128
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_Q15_256)
+  #define ARM_TABLE_TWIDDLECOEF_Q15_256
+  #define ARM_TABLE_BITREVIDX_FXT_256
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_Q15_512)
+  #define ARM_TABLE_TWIDDLECOEF_Q15_512
+  #define ARM_TABLE_BITREVIDX_FXT_512
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_Q15_1024)
+  #define ARM_TABLE_TWIDDLECOEF_Q15_1024
+  #define ARM_TABLE_BITREVIDX_FXT_1024
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_Q15_2048)
+  #define ARM_TABLE_TWIDDLECOEF_Q15_2048
+  #define ARM_TABLE_BITREVIDX_FXT_2048
+#endif
+
+#if defined(ARM_DSP_USE_CFFT_Q15_4096)
+  #define ARM_TABLE_TWIDDLECOEF_Q15_4096
+  #define ARM_TABLE_BITREVIDX_FXT_4096
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_FAST_F64_32)
+  #define ARM_TABLE_TWIDDLECOEF_F64_16
+  #define ARM_TABLE_BITREVIDX_FLT64_16
+  #define ARM_TABLE_TWIDDLECOEF_RFFT_F64_32
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_FAST_F64_64)
+  #define ARM_TABLE_TWIDDLECOEF_F64_32
+  #define ARM_TABLE_BITREVIDX_FLT64_32
+  #define ARM_TABLE_TWIDDLECOEF_RFFT_F64_64
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_FAST_F64_128)
+  #define ARM_TABLE_TWIDDLECOEF_F64_64
+  #define ARM_TABLE_BITREVIDX_FLT64_64
+  #define ARM_TABLE_TWIDDLECOEF_RFFT_F64_128
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_FAST_F64_256)
+  #define ARM_TABLE_TWIDDLECOEF_F64_128
+  #define ARM_TABLE_BITREVIDX_FLT64_128
+  #define ARM_TABLE_TWIDDLECOEF_RFFT_F64_256
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_FAST_F64_512)
+  #define ARM_TABLE_TWIDDLECOEF_F64_256
+  #define ARM_TABLE_BITREVIDX_FLT64_256
+  #define ARM_TABLE_TWIDDLECOEF_RFFT_F64_512
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_FAST_F64_1024)
+  #define ARM_TABLE_TWIDDLECOEF_F64_512
+  #define ARM_TABLE_BITREVIDX_FLT64_512
+  #define ARM_TABLE_TWIDDLECOEF_RFFT_F64_1024
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_FAST_F64_2048)
+  #define ARM_TABLE_TWIDDLECOEF_F64_1024
+  #define ARM_TABLE_BITREVIDX_FLT64_1024
+  #define ARM_TABLE_TWIDDLECOEF_RFFT_F64_2048
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_FAST_F64_4096)
+  #define ARM_TABLE_TWIDDLECOEF_F64_2048
+  #define ARM_TABLE_BITREVIDX_FLT64_2048
+  #define ARM_TABLE_TWIDDLECOEF_RFFT_F64_4096
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_FAST_F32_32)
+  #define ARM_TABLE_TWIDDLECOEF_F32_16
+  #define ARM_TABLE_BITREVIDX_FLT_16
+  #define ARM_TABLE_TWIDDLECOEF_RFFT_F32_32
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_FAST_F32_64)
+  #define ARM_TABLE_TWIDDLECOEF_F32_32
+  #define ARM_TABLE_BITREVIDX_FLT_32
+  #define ARM_TABLE_TWIDDLECOEF_RFFT_F32_64
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_FAST_F32_128)
+  #define ARM_TABLE_TWIDDLECOEF_F32_64
+  #define ARM_TABLE_BITREVIDX_FLT_64
+  #define ARM_TABLE_TWIDDLECOEF_RFFT_F32_128
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_FAST_F32_256)
+  #define ARM_TABLE_TWIDDLECOEF_F32_128
+  #define ARM_TABLE_BITREVIDX_FLT_128
+  #define ARM_TABLE_TWIDDLECOEF_RFFT_F32_256
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_FAST_F32_512)
+  #define ARM_TABLE_TWIDDLECOEF_F32_256
+  #define ARM_TABLE_BITREVIDX_FLT_256
+  #define ARM_TABLE_TWIDDLECOEF_RFFT_F32_512
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_FAST_F32_1024)
+  #define ARM_TABLE_TWIDDLECOEF_F32_512
+  #define ARM_TABLE_BITREVIDX_FLT_512
+  #define ARM_TABLE_TWIDDLECOEF_RFFT_F32_1024
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_FAST_F32_2048)
+  #define ARM_TABLE_TWIDDLECOEF_F32_1024
+  #define ARM_TABLE_BITREVIDX_FLT_1024
+  #define ARM_TABLE_TWIDDLECOEF_RFFT_F32_2048
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_FAST_F32_4096)
+  #define ARM_TABLE_TWIDDLECOEF_F32_2048
+  #define ARM_TABLE_BITREVIDX_FLT_2048
+  #define ARM_TABLE_TWIDDLECOEF_RFFT_F32_4096
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_F32_32)
+  #define ARM_TABLE_REALCOEF_F32
+  #define ARM_TABLE_BITREV_1024
+  #define ARM_TABLE_TWIDDLECOEF_F32_4096
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_F32_64)
+  #define ARM_TABLE_REALCOEF_F32
+  #define ARM_TABLE_BITREV_1024
+  #define ARM_TABLE_TWIDDLECOEF_F32_4096
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_F32_128)
+  #define ARM_TABLE_REALCOEF_F32
+  #define ARM_TABLE_BITREV_1024
+  #define ARM_TABLE_TWIDDLECOEF_F32_4096
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_F32_256)
+  #define ARM_TABLE_REALCOEF_F32
+  #define ARM_TABLE_BITREV_1024
+  #define ARM_TABLE_TWIDDLECOEF_F32_4096
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_F32_512)
+  #define ARM_TABLE_REALCOEF_F32
+  #define ARM_TABLE_BITREV_1024
+  #define ARM_TABLE_TWIDDLECOEF_F32_4096
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_F32_1024)
+  #define ARM_TABLE_REALCOEF_F32
+  #define ARM_TABLE_BITREV_1024
+  #define ARM_TABLE_TWIDDLECOEF_F32_4096
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_F32_2048)
+  #define ARM_TABLE_REALCOEF_F32
+  #define ARM_TABLE_BITREV_1024
+  #define ARM_TABLE_TWIDDLECOEF_F32_4096
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_F32_4096)
+  #define ARM_TABLE_REALCOEF_F32
+  #define ARM_TABLE_BITREV_1024
+  #define ARM_TABLE_TWIDDLECOEF_F32_4096
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_F32_8192)
+  #define ARM_TABLE_REALCOEF_F32
+  #define ARM_TABLE_BITREV_1024
+  #define ARM_TABLE_TWIDDLECOEF_F32_4096
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_Q31_32)
+  #define ARM_TABLE_REALCOEF_Q31
+  #define ARM_TABLE_TWIDDLECOEF_Q31_16
+  #define ARM_TABLE_BITREVIDX_FXT_16
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_Q31_64)
+  #define ARM_TABLE_REALCOEF_Q31
+  #define ARM_TABLE_TWIDDLECOEF_Q31_32
+  #define ARM_TABLE_BITREVIDX_FXT_32
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_Q31_128)
+  #define ARM_TABLE_REALCOEF_Q31
+  #define ARM_TABLE_TWIDDLECOEF_Q31_64
+  #define ARM_TABLE_BITREVIDX_FXT_64
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_Q31_256)
+  #define ARM_TABLE_REALCOEF_Q31
+  #define ARM_TABLE_TWIDDLECOEF_Q31_128
+  #define ARM_TABLE_BITREVIDX_FXT_128
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_Q31_512)
+  #define ARM_TABLE_REALCOEF_Q31
+  #define ARM_TABLE_TWIDDLECOEF_Q31_256
+  #define ARM_TABLE_BITREVIDX_FXT_256
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_Q31_1024)
+  #define ARM_TABLE_REALCOEF_Q31
+  #define ARM_TABLE_TWIDDLECOEF_Q31_512
+  #define ARM_TABLE_BITREVIDX_FXT_512
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_Q31_2048)
+  #define ARM_TABLE_REALCOEF_Q31
+  #define ARM_TABLE_TWIDDLECOEF_Q31_1024
+  #define ARM_TABLE_BITREVIDX_FXT_1024
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_Q31_4096)
+  #define ARM_TABLE_REALCOEF_Q31
+  #define ARM_TABLE_TWIDDLECOEF_Q31_2048
+  #define ARM_TABLE_BITREVIDX_FXT_2048
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_Q31_8192)
+  #define ARM_TABLE_REALCOEF_Q31
+  #define ARM_TABLE_TWIDDLECOEF_Q31_4096
+  #define ARM_TABLE_BITREVIDX_FXT_4096
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_Q15_32)
+  #define ARM_TABLE_REALCOEF_Q15
+  #define ARM_TABLE_TWIDDLECOEF_Q15_16
+  #define ARM_TABLE_BITREVIDX_FXT_16
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_Q15_64)
+  #define ARM_TABLE_REALCOEF_Q15
+  #define ARM_TABLE_TWIDDLECOEF_Q15_32
+  #define ARM_TABLE_BITREVIDX_FXT_32
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_Q15_128)
+  #define ARM_TABLE_REALCOEF_Q15
+  #define ARM_TABLE_TWIDDLECOEF_Q15_64
+  #define ARM_TABLE_BITREVIDX_FXT_64
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_Q15_256)
+  #define ARM_TABLE_REALCOEF_Q15
+  #define ARM_TABLE_TWIDDLECOEF_Q15_128
+  #define ARM_TABLE_BITREVIDX_FXT_128
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_Q15_512)
+  #define ARM_TABLE_REALCOEF_Q15
+  #define ARM_TABLE_TWIDDLECOEF_Q15_256
+  #define ARM_TABLE_BITREVIDX_FXT_256
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_Q15_1024)
+  #define ARM_TABLE_REALCOEF_Q15
+  #define ARM_TABLE_TWIDDLECOEF_Q15_512
+  #define ARM_TABLE_BITREVIDX_FXT_512
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_Q15_2048)
+  #define ARM_TABLE_REALCOEF_Q15
+  #define ARM_TABLE_TWIDDLECOEF_Q15_1024
+  #define ARM_TABLE_BITREVIDX_FXT_1024
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_Q15_4096)
+  #define ARM_TABLE_REALCOEF_Q15
+  #define ARM_TABLE_TWIDDLECOEF_Q15_2048
+  #define ARM_TABLE_BITREVIDX_FXT_2048
+#endif
+
+#if defined(ARM_DSP_USE_RFFT_Q15_8192)
+  #define ARM_TABLE_REALCOEF_Q15
+  #define ARM_TABLE_TWIDDLECOEF_Q15_4096
+  #define ARM_TABLE_BITREVIDX_FXT_4096
+#endif
+
+#if defined(ARM_DSP_USE_DCT4_F32_128)
+  #define ARM_TABLE_DCT4_F32_128
+  #define ARM_TABLE_REALCOEF_F32
+  #define ARM_TABLE_BITREV_1024
+  #define ARM_TABLE_TWIDDLECOEF_F32_4096
+#endif
+
+#if defined(ARM_DSP_USE_DCT4_F32_512)
+  #define ARM_TABLE_DCT4_F32_512
+  #define ARM_TABLE_REALCOEF_F32
+  #define ARM_TABLE_BITREV_1024
+  #define ARM_TABLE_TWIDDLECOEF_F32_4096
+#endif
+
+#if defined(ARM_DSP_USE_DCT4_F32_2048)
+  #define ARM_TABLE_DCT4_F32_2048
+  #define ARM_TABLE_REALCOEF_F32
+  #define ARM_TABLE_BITREV_1024
+  #define ARM_TABLE_TWIDDLECOEF_F32_4096
+#endif
+
+#if defined(ARM_DSP_USE_DCT4_F32_8192)
+  #define ARM_TABLE_DCT4_F32_8192
+  #define ARM_TABLE_REALCOEF_F32
+  #define ARM_TABLE_BITREV_1024
+  #define ARM_TABLE_TWIDDLECOEF_F32_4096
+#endif
+
+#if defined(ARM_DSP_USE_DCT4_Q31_128)
+  #define ARM_TABLE_DCT4_Q31_128
+  #define ARM_TABLE_REALCOEF_Q31
+  #define ARM_TABLE_BITREV_1024
+  #define ARM_TABLE_TWIDDLECOEF_Q31_4096
+#endif
+
+#if defined(ARM_DSP_USE_DCT4_Q31_512)
+  #define ARM_TABLE_DCT4_Q31_512
+  #define ARM_TABLE_REALCOEF_Q31
+  #define ARM_TABLE_BITREV_1024
+  #define ARM_TABLE_TWIDDLECOEF_Q31_4096
+#endif
+
+#if defined(ARM_DSP_USE_DCT4_Q31_2048)
+  #define ARM_TABLE_DCT4_Q31_2048
+  #define ARM_TABLE_REALCOEF_Q31
+  #define ARM_TABLE_BITREV_1024
+  #define ARM_TABLE_TWIDDLECOEF_Q31_4096
+#endif
+
+#if defined(ARM_DSP_USE_DCT4_Q31_8192)
+  #define ARM_TABLE_DCT4_Q31_8192
+  #define ARM_TABLE_REALCOEF_Q31
+  #define ARM_TABLE_BITREV_1024
+  #define ARM_TABLE_TWIDDLECOEF_Q31_4096
+#endif
+
+#if defined(ARM_DSP_USE_DCT4_Q15_128)
+  #define ARM_TABLE_DCT4_Q15_128
+  #define ARM_TABLE_REALCOEF_Q15
+  #define ARM_TABLE_BITREV_1024
+  #define ARM_TABLE_TWIDDLECOEF_Q15_4096
+#endif
+
+#if defined(ARM_DSP_USE_DCT4_Q15_512)
+  #define ARM_TABLE_DCT4_Q15_512
+  #define ARM_TABLE_REALCOEF_Q15
+  #define ARM_TABLE_BITREV_1024
+  #define ARM_TABLE_TWIDDLECOEF_Q15_4096
+#endif
+
+#if defined(ARM_DSP_USE_DCT4_Q15_2048)
+  #define ARM_TABLE_DCT4_Q15_2048
+  #define ARM_TABLE_REALCOEF_Q15
+  #define ARM_TABLE_BITREV_1024
+  #define ARM_TABLE_TWIDDLECOEF_Q15_4096
+#endif
+
+#if defined(ARM_DSP_USE_DCT4_Q15_8192)
+  #define ARM_TABLE_DCT4_Q15_8192
+  #define ARM_TABLE_REALCOEF_Q15
+  #define ARM_TABLE_BITREV_1024
+  #define ARM_TABLE_TWIDDLECOEF_Q15_4096
+#endif
+
+/* fast math, controller and filtering functions */
+#if defined(ARM_DSP_USE_SQRT_Q31)
+  #define ARM_TABLE_SQRT_Q31
+#endif
+
+#if defined(ARM_DSP_USE_SQRT_Q15)
+  #define ARM_TABLE_SQRT_Q15
+#endif
+
+#if defined(ARM_DSP_USE_COS_F32)
+  #define ARM_TABLE_SIN_F32
+#endif
+
+#if defined(ARM_DSP_USE_COS_Q31)
+  #define ARM_TABLE_SIN_Q31
+#endif
+
+#if defined(ARM_DSP_USE_COS_Q15)
+  #define ARM_TABLE_SIN_Q15
+#endif
+
+#if defined(ARM_DSP_USE_SIN_F32)
+  #define ARM_TABLE_SIN_F32
+#endif
+
+#if defined(ARM_DSP_USE_SIN_Q31)
+  #define ARM_TABLE_SIN_Q31
+#endif
+
+#if defined(ARM_DSP_USE_SIN_Q15)
+  #define ARM_TABLE_SIN_Q15
+#endif
+
+#if defined(ARM_DSP_USE_SIN_COS_F32)
+  #define ARM_TABLE_SIN_F32
+#endif
+
+#if defined(ARM_DSP_USE_SIN_COS_Q31)
+  #define ARM_TABLE_SIN_Q31
+#endif
+
+#if defined(ARM_DSP_USE_LMS_NORM_Q31)
+  #define ARM_TABLE_RECIP_Q31
+#endif
+
+#if defined(ARM_DSP_USE_LMS_NORM_Q15)
+  #define ARM_TABLE_RECIP_Q15
+#endif
+
+#endif /* _ARM_DSP_TABLES_H */
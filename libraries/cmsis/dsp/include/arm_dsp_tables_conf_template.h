@@ -0,0 +1,162 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_dsp_tables_conf_template.h
+ * Description:  Template of the application table selection
+ *
+ * @version  V1.10.0
+ * @date     08 July 2021
+ *
+ * Target Processor: Cortex-M and Cortex-A cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2021 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Copy this file to the application include directory as
+ * arm_dsp_tables_conf.h and uncomment the transforms and functions the
+ * application calls. See arm_dsp_tables.h.
+ */
+
+#ifndef _ARM_DSP_TABLES_CONF_H
+#define _ARM_DSP_TABLES_CONF_H
+
+/* every fft/dct table, every fast math table */
+/* #define ARM_DSP_USE_ALL_FFT */
+/* #define ARM_DSP_USE_ALL_FAST */
+
+/* #define ARM_DSP_USE_CFFT_F32_16 */
+/* #define ARM_DSP_USE_CFFT_F32_32 */
+/* #define ARM_DSP_USE_CFFT_F32_64 */
+/* #define ARM_DSP_USE_CFFT_F32_128 */
+/* #define ARM_DSP_USE_CFFT_F32_256 */
+/* #define ARM_DSP_USE_CFFT_F32_512 */
+/* #define ARM_DSP_USE_CFFT_F32_1024 */
+/* #define ARM_DSP_USE_CFFT_F32_2048 */
+/* #define ARM_DSP_USE_CFFT_F32_4096 */
+
+/* #define ARM_DSP_USE_CFFT_F64_16 */
+/* #define ARM_DSP_USE_CFFT_F64_32 */
+/* #define ARM_DSP_USE_CFFT_F64_64 */
+/* #define ARM_DSP_USE_CFFT_F64_128 */
+/* #define ARM_DSP_USE_CFFT_F64_256 */
+/* #define ARM_DSP_USE_CFFT_F64_512 */
+/* #define ARM_DSP_USE_CFFT_F64_1024 */
+/* #define ARM_DSP_USE_CFFT_F64_2048 */
+/* #define ARM_DSP_USE_CFFT_F64_4096 */
+
+/* #define ARM_DSP_USE_CFFT_Q31_16 */
+/* #define ARM_DSP_USE_CFFT_Q31_32 */
+/* #define ARM_DSP_USE_CFFT_Q31_64 */
+/* #define ARM_DSP_USE_CFFT_Q31_128 */
+/* #define ARM_DSP_USE_CFFT_Q31_256 */
+/* #define ARM_DSP_USE_CFFT_Q31_512 */
+/* #define ARM_DSP_USE_CFFT_Q31_1024 */
+/* #define ARM_DSP_USE_CFFT_Q31_2048 */
+/* #define ARM_DSP_USE_CFFT_Q31_4096 */
+
+/* #define ARM_DSP_USE_CFFT_Q15_16 */
+/* #define ARM_DSP_USE_CFFT_Q15_32 */
+/* #define ARM_DSP_USE_CFFT_Q15_64 */
+/* #define ARM_DSP_USE_CFFT_Q15_128 */
+/* #define ARM_DSP_USE_CFFT_Q15_256 */
+/* #define ARM_DSP_USE_CFFT_Q15_512 */
+/* #define ARM_DSP_USE_CFFT_Q15_1024 */
+/* #define ARM_DSP_USE_CFFT_Q15_2048 */
+/* #define ARM_DSP_USE_CFFT_Q15_4096 */
+
+/* #define ARM_DSP_USE_RFFT_FAST_F64_32 */
+/* #define ARM_DSP_USE_RFFT_FAST_F64_64 */
+/* #define ARM_DSP_USE_RFFT_FAST_F64_128 */
+/* #define ARM_DSP_USE_RFFT_FAST_F64_256 */
+/* #define ARM_DSP_USE_RFFT_FAST_F64_512 */
+/* #define ARM_DSP_USE_RFFT_FAST_F64_1024 */
+/* #define ARM_DSP_USE_RFFT_FAST_F64_2048 */
+/* #define ARM_DSP_USE_RFFT_FAST_F64_4096 */
+
+/* #define ARM_DSP_USE_RFFT_FAST_F32_32 */
+/* #define ARM_DSP_USE_RFFT_FAST_F32_64 */
+/* #define ARM_DSP_USE_RFFT_FAST_F32_128 */
+/* #define ARM_DSP_USE_RFFT_FAST_F32_256 */
+/* #define ARM_DSP_USE_RFFT_FAST_F32_512 */
+/* #define ARM_DSP_USE_RFFT_FAST_F32_1024 */
+/* #define ARM_DSP_USE_RFFT_FAST_F32_2048 */
+/* #define ARM_DSP_USE_RFFT_FAST_F32_4096 */
+
+/* #define ARM_DSP_USE_RFFT_F32_32 */
+/* #define ARM_DSP_USE_RFFT_F32_64 */
+/* #define ARM_DSP_USE_RFFT_F32_128 */
+/* #define ARM_DSP_USE_RFFT_F32_256 */
+/* #define ARM_DSP_USE_RFFT_F32_512 */
+/* #define ARM_DSP_USE_RFFT_F32_1024 */
+/* #define ARM_DSP_USE_RFFT_F32_2048 */
+/* #define ARM_DSP_USE_RFFT_F32_4096 */
+/* #define ARM_DSP_USE_RFFT_F32_8192 */
+
+/* #define ARM_DSP_USE_RFFT_Q31_32 */
+/* #define ARM_DSP_USE_RFFT_Q31_64 */
+/* #define ARM_DSP_USE_RFFT_Q31_128 */
+/* #define ARM_DSP_USE_RFFT_Q31_256 */
+/* #define ARM_DSP_USE_RFFT_Q31_512 */
+/* #define ARM_DSP_USE_RFFT_Q31_1024 */
+/* #define ARM_DSP_USE_RFFT_Q31_2048 */
+/* #define ARM_DSP_USE_RFFT_Q31_4096 */
+/* #define ARM_DSP_USE_RFFT_Q31_8192 */
+
+/* #define ARM_DSP_USE_RFFT_Q15_32 */
+/* #define ARM_DSP_USE_RFFT_Q15_64 */
+/* #define ARM_DSP_USE_RFFT_Q15_128 */
+/* #define ARM_DSP_USE_RFFT_Q15_256 */
+/* #define ARM_DSP_USE_RFFT_Q15_512 */
+/* #define ARM_DSP_USE_RFFT_Q15_1024 */
+/* #define ARM_DSP_USE_RFFT_Q15_2048 */
+/* #define ARM_DSP_USE_RFFT_Q15_4096 */
+/* #define ARM_DSP_USE_RFFT_Q15_8192 */
+
+/* #define ARM_DSP_USE_DCT4_F32_128 */
+/* #define ARM_DSP_USE_DCT4_F32_512 */
+/* #define ARM_DSP_USE_DCT4_F32_2048 */
+/* #define ARM_DSP_USE_DCT4_F32_8192 */
+
+/* #define ARM_DSP_USE_DCT4_Q31_128 */
+/* #define ARM_DSP_USE_DCT4_Q31_512 */
+/* #define ARM_DSP_USE_DCT4_Q31_2048 */
+/* #define ARM_DSP_USE_DCT4_Q31_8192 */
+
+/* #define ARM_DSP_USE_DCT4_Q15_128 */
+/* #define ARM_DSP_USE_DCT4_Q15_512 */
+/* #define ARM_DSP_USE_DCT4_Q15_2048 */
+/* #define ARM_DSP_USE_DCT4_Q15_8192 */
+
+/* #define ARM_DSP_USE_SQRT_Q31 */
+/* #define ARM_DSP_USE_SQRT_Q15 */
+
+/* #define ARM_DSP_USE_COS_F32 */
+/* #define ARM_DSP_USE_COS_Q31 */
+/* #define ARM_DSP_USE_COS_Q15 */
+
+/* #define ARM_DSP_USE_SIN_F32 */
+/* #define ARM_DSP_USE_SIN_Q31 */
+/* #define ARM_DSP_USE_SIN_Q15 */
+
+/* #define ARM_DSP_USE_SIN_COS_F32 */
+/* #define ARM_DSP_USE_SIN_COS_Q31 */
+
+/* #define ARM_DSP_USE_LMS_NORM_Q31 */
+/* #define ARM_DSP_USE_LMS_NORM_Q15 */
+
+#endif /* _ARM_DSP_TABLES_CONF_H */
@@ -0,0 +1,409 @@
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS DSP Library
+ * Title:        arm_dsp_tables_report.h
+ * Description:  Size report of the tables selected by the table registry
+ *
+ * @version  V1.10.0
+ * @date     08 July 2021
+ *
+ * Target Processor: Cortex-M and Cortex-A cores
+ * -------------------------------------------------------------------- */
+/*
+ * Copyright (C) 2010-2021 ARM Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Size report of the tables selected by arm_dsp_tables.h. Include this header
+ * in one source file of the application, after arm_math.h, and walk the
+ * arm_dsp_table_info array up to the entry with a null name. The sizes are the
+ * sizes of the table objects, the structures of arm_const_structs.c are not
+ * counted.
+ */
+
+#ifndef _ARM_DSP_TABLES_REPORT_H
+#define _ARM_DSP_TABLES_REPORT_H
+
+#ifndef _ARM_DSP_TABLES_H
+  #error "arm_dsp_tables.h must be force included to use the table report"
+#endif
+
+#include "arm_common_tables.h"
+
+#ifdef   __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Name and size in bytes of one selected table.
+ */
+typedef struct
+{
+  const char *name;
+  uint32_t size;
+} arm_dsp_table_info_t;
+
+#define ARM_DSP_TABLE_INFO(table) { #table, (uint32_t)sizeof(table) }
+
+static const arm_dsp_table_info_t arm_dsp_table_info[] =
+{
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREV_1024)
+  ARM_DSP_TABLE_INFO(armBitRevTable),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_F64_16)
+  ARM_DSP_TABLE_INFO(twiddleCoefF64_16),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_F64_32)
+  ARM_DSP_TABLE_INFO(twiddleCoefF64_32),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_F64_64)
+  ARM_DSP_TABLE_INFO(twiddleCoefF64_64),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_F64_128)
+  ARM_DSP_TABLE_INFO(twiddleCoefF64_128),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_F64_256)
+  ARM_DSP_TABLE_INFO(twiddleCoefF64_256),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_F64_512)
+  ARM_DSP_TABLE_INFO(twiddleCoefF64_512),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_F64_1024)
+  ARM_DSP_TABLE_INFO(twiddleCoefF64_1024),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_F64_2048)
+  ARM_DSP_TABLE_INFO(twiddleCoefF64_2048),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_F64_4096)
+  ARM_DSP_TABLE_INFO(twiddleCoefF64_4096),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_F32_16)
+  ARM_DSP_TABLE_INFO(twiddleCoef_16),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_F32_32)
+  ARM_DSP_TABLE_INFO(twiddleCoef_32),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_F32_64)
+  ARM_DSP_TABLE_INFO(twiddleCoef_64),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_F32_128)
+  ARM_DSP_TABLE_INFO(twiddleCoef_128),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_F32_256)
+  ARM_DSP_TABLE_INFO(twiddleCoef_256),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_F32_512)
+  ARM_DSP_TABLE_INFO(twiddleCoef_512),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_F32_1024)
+  ARM_DSP_TABLE_INFO(twiddleCoef_1024),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_F32_2048)
+  ARM_DSP_TABLE_INFO(twiddleCoef_2048),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_F32_4096)
+  ARM_DSP_TABLE_INFO(twiddleCoef_4096),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_Q31_16)
+  ARM_DSP_TABLE_INFO(twiddleCoef_16_q31),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_Q31_32)
+  ARM_DSP_TABLE_INFO(twiddleCoef_32_q31),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_Q31_64)
+  ARM_DSP_TABLE_INFO(twiddleCoef_64_q31),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_Q31_128)
+  ARM_DSP_TABLE_INFO(twiddleCoef_128_q31),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_Q31_256)
+  ARM_DSP_TABLE_INFO(twiddleCoef_256_q31),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_Q31_512)
+  ARM_DSP_TABLE_INFO(twiddleCoef_512_q31),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_Q31_1024)
+  ARM_DSP_TABLE_INFO(twiddleCoef_1024_q31),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_Q31_2048)
+  ARM_DSP_TABLE_INFO(twiddleCoef_2048_q31),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_Q31_4096)
+  ARM_DSP_TABLE_INFO(twiddleCoef_4096_q31),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_Q15_16)
+  ARM_DSP_TABLE_INFO(twiddleCoef_16_q15),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_Q15_32)
+  ARM_DSP_TABLE_INFO(twiddleCoef_32_q15),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_Q15_64)
+  ARM_DSP_TABLE_INFO(twiddleCoef_64_q15),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_Q15_128)
+  ARM_DSP_TABLE_INFO(twiddleCoef_128_q15),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_Q15_256)
+  ARM_DSP_TABLE_INFO(twiddleCoef_256_q15),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_Q15_512)
+  ARM_DSP_TABLE_INFO(twiddleCoef_512_q15),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_Q15_1024)
+  ARM_DSP_TABLE_INFO(twiddleCoef_1024_q15),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_Q15_2048)
+  ARM_DSP_TABLE_INFO(twiddleCoef_2048_q15),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_Q15_4096)
+  ARM_DSP_TABLE_INFO(twiddleCoef_4096_q15),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_RFFT_F64_32)
+  ARM_DSP_TABLE_INFO(twiddleCoefF64_rfft_32),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_RFFT_F64_64)
+  ARM_DSP_TABLE_INFO(twiddleCoefF64_rfft_64),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_RFFT_F64_128)
+  ARM_DSP_TABLE_INFO(twiddleCoefF64_rfft_128),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_RFFT_F64_256)
+  ARM_DSP_TABLE_INFO(twiddleCoefF64_rfft_256),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_RFFT_F64_512)
+  ARM_DSP_TABLE_INFO(twiddleCoefF64_rfft_512),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_RFFT_F64_1024)
+  ARM_DSP_TABLE_INFO(twiddleCoefF64_rfft_1024),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_RFFT_F64_2048)
+  ARM_DSP_TABLE_INFO(twiddleCoefF64_rfft_2048),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_RFFT_F64_4096)
+  ARM_DSP_TABLE_INFO(twiddleCoefF64_rfft_4096),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_RFFT_F32_32)
+  ARM_DSP_TABLE_INFO(twiddleCoef_rfft_32),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_RFFT_F32_64)
+  ARM_DSP_TABLE_INFO(twiddleCoef_rfft_64),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_RFFT_F32_128)
+  ARM_DSP_TABLE_INFO(twiddleCoef_rfft_128),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_RFFT_F32_256)
+  ARM_DSP_TABLE_INFO(twiddleCoef_rfft_256),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_RFFT_F32_512)
+  ARM_DSP_TABLE_INFO(twiddleCoef_rfft_512),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_RFFT_F32_1024)
+  ARM_DSP_TABLE_INFO(twiddleCoef_rfft_1024),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_RFFT_F32_2048)
+  ARM_DSP_TABLE_INFO(twiddleCoef_rfft_2048),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_TWIDDLECOEF_RFFT_F32_4096)
+  ARM_DSP_TABLE_INFO(twiddleCoef_rfft_4096),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FLT64_16)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTableF64_16),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FLT64_32)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTableF64_32),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FLT64_64)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTableF64_64),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FLT64_128)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTableF64_128),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FLT64_256)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTableF64_256),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FLT64_512)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTableF64_512),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FLT64_1024)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTableF64_1024),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FLT64_2048)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTableF64_2048),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FLT64_4096)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTableF64_4096),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FLT_16)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTable16),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FLT_32)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTable32),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FLT_64)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTable64),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FLT_128)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTable128),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FLT_256)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTable256),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FLT_512)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTable512),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FLT_1024)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTable1024),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FLT_2048)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTable2048),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FLT_4096)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTable4096),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FXT_16)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTable_fixed_16),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FXT_32)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTable_fixed_32),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FXT_64)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTable_fixed_64),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FXT_128)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTable_fixed_128),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FXT_256)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTable_fixed_256),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FXT_512)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTable_fixed_512),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FXT_1024)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTable_fixed_1024),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FXT_2048)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTable_fixed_2048),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_BITREVIDX_FXT_4096)
+  ARM_DSP_TABLE_INFO(armBitRevIndexTable_fixed_4096),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_REALCOEF_F32)
+  ARM_DSP_TABLE_INFO(realCoefA),
+  ARM_DSP_TABLE_INFO(realCoefB),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_REALCOEF_Q31)
+  ARM_DSP_TABLE_INFO(realCoefAQ31),
+  ARM_DSP_TABLE_INFO(realCoefBQ31),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_REALCOEF_Q15)
+  ARM_DSP_TABLE_INFO(realCoefAQ15),
+  ARM_DSP_TABLE_INFO(realCoefBQ15),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_DCT4_F32_128)
+  ARM_DSP_TABLE_INFO(Weights_128),
+  ARM_DSP_TABLE_INFO(cos_factors_128),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_DCT4_F32_512)
+  ARM_DSP_TABLE_INFO(Weights_512),
+  ARM_DSP_TABLE_INFO(cos_factors_512),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_DCT4_F32_2048)
+  ARM_DSP_TABLE_INFO(Weights_2048),
+  ARM_DSP_TABLE_INFO(cos_factors_2048),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_DCT4_F32_8192)
+  ARM_DSP_TABLE_INFO(Weights_8192),
+  ARM_DSP_TABLE_INFO(cos_factors_8192),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_DCT4_Q15_128)
+  ARM_DSP_TABLE_INFO(WeightsQ15_128),
+  ARM_DSP_TABLE_INFO(cos_factorsQ15_128),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_DCT4_Q15_512)
+  ARM_DSP_TABLE_INFO(WeightsQ15_512),
+  ARM_DSP_TABLE_INFO(cos_factorsQ15_512),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_DCT4_Q15_2048)
+  ARM_DSP_TABLE_INFO(WeightsQ15_2048),
+  ARM_DSP_TABLE_INFO(cos_factorsQ15_2048),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_DCT4_Q15_8192)
+  ARM_DSP_TABLE_INFO(WeightsQ15_8192),
+  ARM_DSP_TABLE_INFO(cos_factorsQ15_8192),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_DCT4_Q31_128)
+  ARM_DSP_TABLE_INFO(WeightsQ31_128),
+  ARM_DSP_TABLE_INFO(cos_factorsQ31_128),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_DCT4_Q31_512)
+  ARM_DSP_TABLE_INFO(WeightsQ31_512),
+  ARM_DSP_TABLE_INFO(cos_factorsQ31_512),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_DCT4_Q31_2048)
+  ARM_DSP_TABLE_INFO(WeightsQ31_2048),
+  ARM_DSP_TABLE_INFO(cos_factorsQ31_2048),
+#endif
+#if defined(ARM_ALL_FFT_TABLES) || defined(ARM_TABLE_DCT4_Q31_8192)
+  ARM_DSP_TABLE_INFO(WeightsQ31_8192),
+  ARM_DSP_TABLE_INFO(cos_factorsQ31_8192),
+#endif
+#if defined(ARM_ALL_FAST_TABLES) || defined(ARM_TABLE_RECIP_Q15)
+  ARM_DSP_TABLE_INFO(armRecipTableQ15),
+#endif
+#if defined(ARM_ALL_FAST_TABLES) || defined(ARM_TABLE_RECIP_Q31)
+  ARM_DSP_TABLE_INFO(armRecipTableQ31),
+#endif
+#if defined(ARM_ALL_FAST_TABLES) || defined(ARM_TABLE_SIN_F32)
+  ARM_DSP_TABLE_INFO(sinTable_f32),
+#endif
+#if defined(ARM_ALL_FAST_TABLES) || defined(ARM_TABLE_SIN_Q31)
+  ARM_DSP_TABLE_INFO(sinTable_q31),
+#endif
+#if defined(ARM_ALL_FAST_TABLES) || defined(ARM_TABLE_SIN_Q15)
+  ARM_DSP_TABLE_INFO(sinTable_q15),
+#endif
+#if defined(ARM_ALL_FAST_TABLES) || defined(ARM_TABLE_SQRT_Q31)
+  ARM_DSP_TABLE_INFO(sqrt_initial_lut_q31),
+#endif
+#if defined(ARM_ALL_FAST_TABLES) || defined(ARM_TABLE_SQRT_Q15)
+  ARM_DSP_TABLE_INFO(sqrt_initial_lut_q15),
+#endif
+  { 0, 0 }
+};
+
+/**
+ * @brief  Total size in bytes of the selected tables.
+ * @return sum of the sizes listed in arm_dsp_table_info.
+ */
+__STATIC_INLINE uint32_t arm_dsp_tables_size(void)
+{
+  const arm_dsp_table_info_t *info;
+  uint32_t size = 0;
+
+  for(info = arm_dsp_table_info; info->name != 0; info++)
+  {
+    size += info->size;
+  }
+
+  return size;
+}
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif /* _ARM_DSP_TABLES_REPORT_H */
@@ -277,6 +277,18 @@
 #endif
 
 
+/* Streaming write */
+#if FF_USE_STREAM && !FF_USE_EXPAND
+#error FF_USE_STREAM requires FF_USE_EXPAND
+#endif
+
+
+/* Free cluster region map */
+#if FF_USE_FREEMAP && FF_FREEMAP_SIZE < 1
+#error Wrong FF_FREEMAP_SIZE setting
+#endif
+
+
 /* File lock controls */
 #if FF_FS_LOCK != 0
 #if FF_FS_READONLY
@@ -1391,6 +1403,79 @@ static FRESULT fill_last_frag (
 
 
 
+#if FF_USE_FREEMAP && !FF_FS_READONLY
+/*-----------------------------------------------------------------------*/
+/* FAT handling - Free cluster region map                                */
+/*-----------------------------------------------------------------------*/
+/* The FAT is divided into regions of 2^fm_shift clusters and a bit per  */
+/* region is set when the region is known to have no free cluster. The   */
+/* bits are set by a scan that walked the whole region and cleared when  */
+/* a cluster in the region gets free, so a set bit is always exact.      */
+
+static void fm_init (
+	FATFS* fs		/* Filesystem object */
+)
+{
+	BYTE sh = 0;
+
+
+	while (((fs->n_fatent - 1) >> sh) >= FF_FREEMAP_SIZE * 8) sh++;	/* Find the smallest region fits in the map */
+	fs->fm_shift = sh;
+	memset(fs->fm_full, 0, FF_FREEMAP_SIZE);	/* All regions are unknown */
+	fs->fm_free = 0;
+	fs->fm_scan = (fs->fs_type == FS_EXFAT) ? 0 : 2;	/* exFAT has its own allocation bitmap */
+}
+
+
+static int fm_test (	/* 1:The region has no free cluster, 0:Unknown */
+	FATFS* fs,		/* Filesystem object */
+	DWORD clst		/* Cluster# in the region */
+)
+{
+	DWORD r = clst >> fs->fm_shift;
+
+	return (fs->fm_full[r / 8] >> (r % 8)) & 1;
+}
+
+
+static void fm_mark (
+	FATFS* fs,		/* Filesystem object */
+	DWORD clst,		/* Cluster# in the region */
+	int full		/* 1:No free cluster in the region, 0:Unknown */
+)
+{
+	DWORD r = clst >> fs->fm_shift;
+
+	if (full) {
+		fs->fm_full[r / 8] |= (BYTE)(1 << (r % 8));
+	} else {
+		fs->fm_full[r / 8] &= (BYTE)~(1 << (r % 8));
+	}
+}
+
+
+static void fm_alloc (
+	FATFS* fs,		/* Filesystem object */
+	DWORD clst		/* Cluster# got 'in use' */
+)
+{
+	if (fs->fm_scan != 0 && clst < fs->fm_scan) fs->fm_free--;	/* Correct the count of the scanned part */
+}
+
+
+static void fm_release (
+	FATFS* fs,		/* Filesystem object */
+	DWORD clst		/* Cluster# got 'free' */
+)
+{
+	fm_mark(fs, clst, 0);
+	if (fs->fm_scan != 0 && clst < fs->fm_scan) fs->fm_free++;	/* Correct the count of the scanned part */
+}
+
+#endif	/* FF_USE_FREEMAP && !FF_FS_READONLY */
+
+
+
 #if !FF_FS_READONLY
 /*-----------------------------------------------------------------------*/
 /* FAT handling - Remove a cluster chain                                 */
@@ -1429,6 +1514,9 @@ static FRESULT remove_chain (	/* FR_OK(0):succeeded, !=0:error */
 		if (!FF_FS_EXFAT || fs->fs_type != FS_EXFAT) {
 			res = put_fat(fs, clst, 0);		/* Mark the cluster 'free' on the FAT */
 			if (res != FR_OK) return res;
+#if FF_USE_FREEMAP
+			fm_release(fs, clst);
+#endif
 		}
 		if (fs->free_clst < fs->n_fatent - 2) {	/* Update FSINFO */
 			fs->free_clst++;
@@ -1499,6 +1587,10 @@ static DWORD create_chain (	/* 0:No free cluster, 1:Internal error, 0xFFFFFFFF:D
 	DWORD cs, ncl, scl;
 	FRESULT res;
 	FATFS *fs = obj->fs;
+#if FF_USE_FREEMAP
+	DWORD rmsk = ((DWORD)1 << fs->fm_shift) - 1;
+	BYTE rtop = 0;
+#endif
 
 
 	if (clst == 0) {	/* Create a new chain */
@@ -1561,13 +1653,31 @@ static DWORD create_chain (	/* 0:No free cluster, 1:Internal error, 0xFFFFFFFF:D
 					ncl = 2;
 					if (ncl > scl) return 0;	/* No free cluster found? */
 				}
+#if FF_USE_FREEMAP
+				if (fm_test(fs, ncl)) {			/* Skip the region without reading its FAT sectors */
+					cs = ncl | rmsk;			/* Last cluster in the region */
+					if (scl >= ncl && scl <= cs) return 0;	/* No free cluster found? */
+					ncl = cs; rtop = 0;
+					continue;
+				}
+				if ((ncl & rmsk) == 0 || ncl == 2) rtop = 1;	/* Scanning the region from its top */
+#endif
 				cs = get_fat(obj, ncl);			/* Get the cluster status */
 				if (cs == 0) break;				/* Found a free cluster? */
 				if (cs == 1 || cs == 0xFFFFFFFF) return cs;	/* Test for error */
 				if (ncl == scl) return 0;		/* No free cluster found? */
+#if FF_USE_FREEMAP
+				if (rtop && (((ncl + 1) & rmsk) == 0 || ncl + 1 == fs->n_fatent)) {	/* Whole region has been scanned? */
+					fm_mark(fs, ncl, 1);		/* Remember it has no free cluster */
+					rtop = 0;
+				}
+#endif
 			}
 		}
 		res = put_fat(fs, ncl, 0xFFFFFFFF);		/* Mark the new cluster 'EOC' */
+#if FF_USE_FREEMAP
+		if (res == FR_OK) fm_alloc(fs, ncl);
+#endif
 		if (res == FR_OK && clst != 0) {
 			res = put_fat(fs, clst, ncl);		/* Link it from the previous one if needed */
 		}
@@ -3536,6 +3646,9 @@ static FRESULT mount_volume (	/* FR_OK(0): successful, !=0: an error occurred */
 
 	fs->fs_type = (BYTE)fmt;/* FAT sub-type */
 	fs->id = ++Fsid;		/* Volume mount ID */
+#if FF_USE_FREEMAP && !FF_FS_READONLY
+	fm_init(fs);			/* Initialize free cluster region map */
+#endif
 #if FF_USE_LFN == 1
 	fs->lfnbuf = LfnBuf;	/* Static LFN working buffer */
 #if FF_FS_EXFAT
@@ -3793,6 +3906,10 @@ FRESULT f_open (
 			}
 #if FF_USE_FASTSEEK
 			fp->cltbl = 0;		/* Disable fast seek mode */
+#endif
+#if FF_USE_STREAM
+			fp->ct_sclust = 0;	/* Contiguity of the allocation is not verified yet */
+			fp->ct_size = 0;
 #endif
 			fp->obj.fs = fs;	/* Validate the file object */
 			fp->obj.id = fs->id;
@@ -4867,6 +4984,9 @@ FRESULT f_truncate (
 		}
 		fp->obj.objsize = fp->fptr;	/* Set file size to current read/write point */
 		fp->flag |= FA_MODIFIED;
+#if FF_USE_STREAM
+		if (fp->ct_size > fp->fptr) fp->ct_size = fp->fptr;	/* Clusters beyond it are released */
+#endif
 #if !FF_FS_TINY
 		if (res == FR_OK && (fp->flag & FA_DIRTY)) {
 			if (disk_write(fs->pdrv, fp->buf, fp->sect, 1) != RES_OK) {
@@ -5483,6 +5603,62 @@ FRESULT f_setlabel (
 
 
 
+#if FF_USE_FREEMAP && !FF_FS_READONLY
+/*-----------------------------------------------------------------------*/
+/* Scan the FAT Incrementally to Build the Free Cluster Region Map       */
+/*-----------------------------------------------------------------------*/
+/* Each call scans up to nreg whole regions from where the previous call */
+/* stopped. When the scan reaches the end of the FAT, the counted number */
+/* of free clusters is set to the FSINFO, so f_getfree() needs no scan.  */
+
+FRESULT f_freemap_scan (
+	const TCHAR* path,	/* Logical drive number */
+	UINT nreg,			/* Number of regions to scan in this call */
+	DWORD* nleft		/* Pointer to return number of clusters left to scan (0:Completed) */
+)
+{
+	FRESULT res;
+	FATFS *fs;
+	DWORD clst, ecl, stat, nfree;
+	FFOBJID obj;
+
+
+	/* Get logical drive */
+	res = mount_volume(&path, &fs, 0);
+	if (res == FR_OK) {
+		obj.fs = fs;
+		clst = fs->fm_scan;
+		while (clst != 0 && nreg > 0) {
+			ecl = (clst | (((DWORD)1 << fs->fm_shift) - 1)) + 1;	/* End of the region */
+			if (ecl > fs->n_fatent) ecl = fs->n_fatent;
+			nfree = 0;
+			for ( ; clst < ecl; clst++) {	/* Count free clusters in the region */
+				stat = get_fat(&obj, clst);
+				if (stat == 0xFFFFFFFF) { res = FR_DISK_ERR; break; }
+				if (stat == 1) { res = FR_INT_ERR; break; }
+				if (stat == 0) nfree++;
+			}
+			if (res != FR_OK) break;		/* The region will be scanned again at next call */
+			fm_mark(fs, ecl - 1, nfree == 0);
+			fs->fm_free += nfree;
+			if (ecl == fs->n_fatent) {		/* Has the scan reached the end of the FAT? */
+				fs->free_clst = fs->fm_free;	/* Now free_clst is valid */
+				fs->fsi_flag |= 1;
+				clst = 0;
+			}
+			fs->fm_scan = clst;
+			nreg--;
+		}
+		*nleft = (fs->fm_scan != 0) ? fs->n_fatent - fs->fm_scan : 0;
+	}
+
+	LEAVE_FF(fs, res);
+}
+
+#endif /* FF_USE_FREEMAP && !FF_FS_READONLY */
+
+
+
 #if FF_USE_EXPAND && !FF_FS_READONLY
 /*-----------------------------------------------------------------------*/
 /* Allocate a Contiguous Blocks to the File                              */
@@ -5528,6 +5704,17 @@ FRESULT f_expand (
 	{
 		scl = clst = stcl; ncl = 0;
 		for (;;) {	/* Find a contiguous cluster block */
+#if FF_USE_FREEMAP
+			if (fm_test(fs, clst)) {	/* The block cannot lie over a region without free cluster */
+				n = clst | (((DWORD)1 << fs->fm_shift) - 1);	/* Last cluster in the region */
+				if (stcl > clst && stcl <= n) { res = FR_DENIED; break; }	/* No contiguous cluster? */
+				clst = n + 1;
+				if (clst >= fs->n_fatent) clst = 2;
+				if (clst == stcl) { res = FR_DENIED; break; }	/* No contiguous cluster? */
+				scl = clst; ncl = 0;
+				continue;
+			}
+#endif
 			n = get_fat(&fp->obj, clst);
 			if (++clst >= fs->n_fatent) clst = 2;
 			if (n == 1) { res = FR_INT_ERR; break; }
@@ -5545,6 +5732,9 @@ FRESULT f_expand (
 					res = put_fat(fs, clst, (n == 1) ? 0xFFFFFFFF : clst + 1);
 					if (res != FR_OK) break;
 					lclst = clst;
+#if FF_USE_FREEMAP
+					fm_alloc(fs, clst);
+#endif
 				}
 			} else {		/* Set it as suggested point for next allocation */
 				lclst = scl - 1;
@@ -5558,6 +5748,10 @@ FRESULT f_expand (
 			fp->obj.sclust = scl;		/* Update object allocation information */
 			fp->obj.objsize = fsz;
 			if (FF_FS_EXFAT) fp->obj.stat = 2;	/* Set status 'contiguous chain' */
+#if FF_USE_STREAM
+			fp->ct_sclust = scl;		/* The whole allocation is a contiguous block */
+			fp->ct_size = fsz;
+#endif
 			fp->flag |= FA_MODIFIED;
 			if (fs->free_clst <= fs->n_fatent - 2) {	/* Update FSINFO */
 				fs->free_clst -= tcl;
@@ -5569,6 +5763,131 @@ FRESULT f_expand (
 	LEAVE_FF(fs, res);
 }
 
+#if FF_USE_STREAM
+/*-----------------------------------------------------------------------*/
+/* Verify the Allocation of a File is a Contiguous Cluster Block         */
+/*-----------------------------------------------------------------------*/
+
+static FRESULT check_contiguous (	/* FR_OK(0):contiguous, FR_DENIED:fragmented, others:error */
+	FIL* fp			/* Pointer to the file object */
+)
+{
+	FATFS *fs = fp->obj.fs;
+	DWORD clst, ncl, nxt;
+	FSIZE_t csz;
+
+
+	csz = (FSIZE_t)fs->csize * SS(fs);
+	ncl = (DWORD)((fp->obj.objsize + csz - 1) / csz);	/* Number of clusters in the allocation */
+	for (clst = fp->obj.sclust; ncl > 1; clst++, ncl--) {	/* Follow the chain once */
+		nxt = get_fat(&fp->obj, clst);
+		if (nxt == 1) return FR_INT_ERR;
+		if (nxt == 0xFFFFFFFF) return FR_DISK_ERR;
+		if (nxt != clst + 1) return FR_DENIED;	/* Fragmented */
+	}
+	fp->ct_sclust = fp->obj.sclust;		/* Remember the verified block */
+	fp->ct_size = fp->obj.objsize;
+
+	return FR_OK;
+}
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Write Sectors Directly into a Preallocated Contiguous File            */
+/*-----------------------------------------------------------------------*/
+/* The file should have been allocated by f_expand(fp, fsz, 1) so that   */
+/* the whole data area is a single contiguous cluster block. Any other   */
+/* allocation is verified on the FAT once and rejected with FR_DENIED if */
+/* it is fragmented. The sectors are mapped by arithmetic from the start */
+/* cluster and written in one disk_write() call without any FAT access. */
+/* The directory entry is not updated here, use f_stream_commit() to     */
+/* record the committed size.                                            */
+
+FRESULT f_stream_write (
+	FIL* fp,			/* Pointer to the file object */
+	const void* buff,	/* Pointer to the data to be written */
+	UINT nsect			/* Number of sectors to write */
+)
+{
+	FRESULT res;
+	FATFS *fs;
+	LBA_t sect;
+	FSIZE_t csz;
+	const BYTE *wbuff = (const BYTE*)buff;
+
+
+	res = validate(&fp->obj, &fs);		/* Check validity of the file object */
+	if (res != FR_OK || (res = (FRESULT)fp->err) != FR_OK) LEAVE_FF(fs, res);
+	if (!(fp->flag & FA_WRITE) || fp->obj.sclust == 0) LEAVE_FF(fs, FR_DENIED);	/* Check access mode and allocation */
+	if (fp->fptr % SS(fs) != 0) LEAVE_FF(fs, FR_DENIED);	/* File pointer must be on the sector boundary */
+	if ((FSIZE_t)nsect * SS(fs) > fp->obj.objsize - fp->fptr) LEAVE_FF(fs, FR_DENIED);	/* Never write beyond the allocation */
+	if (nsect == 0) LEAVE_FF(fs, FR_OK);
+	if (fp->ct_sclust != fp->obj.sclust || fp->fptr + (FSIZE_t)nsect * SS(fs) > fp->ct_size) {	/* Not verified to be contiguous? */
+		res = check_contiguous(fp);
+		if (res == FR_DENIED) LEAVE_FF(fs, res);
+		if (res != FR_OK) ABORT(fs, res);
+	}
+
+	sect = clst2sect(fs, fp->obj.sclust);
+	if (sect == 0) ABORT(fs, FR_INT_ERR);
+	sect += (LBA_t)(fp->fptr / SS(fs));	/* Sector offset in the contiguous block */
+	if (disk_write(fs->pdrv, wbuff, sect, nsect) != RES_OK) ABORT(fs, FR_DISK_ERR);
+#if FF_FS_MINIMIZE <= 2
+#if FF_FS_TINY
+	if (fs->winsect - sect < nsect) {	/* Refill sector cache if it gets invalidated by the direct write */
+		memcpy(fs->win, wbuff + ((fs->winsect - sect) * SS(fs)), SS(fs));
+		fs->wflag = 0;
+	}
+#else
+	if (fp->sect - sect < nsect) { /* Refill sector cache if it gets invalidated by the direct write */
+		memcpy(fp->buf, wbuff + ((fp->sect - sect) * SS(fs)), SS(fs));
+		fp->flag &= (BYTE)~FA_DIRTY;
+	}
+#endif
+#endif
+	fp->fptr += (FSIZE_t)nsect * SS(fs);	/* Advance file read/write pointer */
+	csz = (FSIZE_t)fs->csize * SS(fs);
+	fp->clust = fp->obj.sclust + (DWORD)((fp->fptr - 1) / csz);	/* Keep current cluster coherent for f_lseek */
+
+	LEAVE_FF(fs, FR_OK);
+}
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Commit the Size of a Streamed File to the Directory                   */
+/*-----------------------------------------------------------------------*/
+/* Records fsz as the file size in the directory entry and flushes the   */
+/* cached information while the preallocated cluster chain stays intact, */
+/* so a power loss leaves a valid file of the last committed size. If    */
+/* f_sync() fails, the file keeps the changes it has not recorded yet.   */
+
+FRESULT f_stream_commit (
+	FIL* fp,		/* Pointer to the file object */
+	FSIZE_t fsz		/* Size of valid data (<= file read/write pointer) */
+)
+{
+	FRESULT res;
+	FSIZE_t asz;
+
+
+	if (!fp || !fp->obj.fs) return FR_INVALID_OBJECT;
+	if (!(fp->flag & FA_WRITE) || fsz > fp->fptr) return FR_DENIED;
+
+	asz = fp->obj.objsize;		/* Save the allocated size */
+	fp->obj.objsize = fsz;		/* Record only the committed part */
+	fp->flag |= FA_MODIFIED;
+	res = f_sync(fp);
+	fp->obj.objsize = asz;		/* Restore the allocated size, a failed sync leaves the file modified */
+
+	return res;
+}
+
+#endif /* FF_USE_STREAM */
+
 #endif /* FF_USE_EXPAND && !FF_FS_READONLY */
 
 
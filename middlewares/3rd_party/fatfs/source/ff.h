@@ -153,6 +153,12 @@ typedef struct {
 #if !FF_FS_READONLY
 	DWORD	last_clst;		/* Last allocated cluster */
 	DWORD	free_clst;		/* Number of free clusters */
+#if FF_USE_FREEMAP
+	DWORD	fm_scan;		/* Next cluster of the incremental FAT scan (0:Completed) */
+	DWORD	fm_free;		/* Number of free clusters counted by the scan */
+	BYTE	fm_shift;		/* Region size [clusters] in log2 */
+	BYTE	fm_full[FF_FREEMAP_SIZE];	/* Region map (b:1 the region has no free cluster) */
+#endif
 #endif
 #if FF_FS_RPATH
 	DWORD	cdir;			/* Current directory start cluster (0:root) */
@@ -216,6 +222,10 @@ typedef struct {
 #if FF_USE_FASTSEEK
 	DWORD*	cltbl;			/* Pointer to the cluster link map table (nulled on open, set by application) */
 #endif
+#if FF_USE_STREAM
+	DWORD	ct_sclust;		/* Start cluster of the block verified to be contiguous */
+	FSIZE_t	ct_size;		/* Size verified to be contiguous from ct_sclust (0:not verified) */
+#endif
 #if !FF_FS_TINY
 	BYTE	buf[FF_MAX_SS];	/* File private data read/write window */
 #endif
@@ -327,6 +337,9 @@ FRESULT f_getlabel (const TCHAR* path, TCHAR* label, DWORD* vsn);	/* Get volume
 FRESULT f_setlabel (const TCHAR* label);							/* Set volume label */
 FRESULT f_forward (FIL* fp, UINT(*func)(const BYTE*,UINT), UINT btf, UINT* bf);	/* Forward data to the stream */
 FRESULT f_expand (FIL* fp, FSIZE_t fsz, BYTE opt);					/* Allocate a contiguous block to the file */
+FRESULT f_stream_write (FIL* fp, const void* buff, UINT nsect);		/* Write sectors directly into a preallocated file */
+FRESULT f_stream_commit (FIL* fp, FSIZE_t fsz);						/* Commit the size of a streamed file */
+FRESULT f_freemap_scan (const TCHAR* path, UINT nreg, DWORD* nleft);	/* Scan the FAT to build the free cluster region map */
 FRESULT f_mount (FATFS* fs, const TCHAR* path, BYTE opt);			/* Mount/Unmount a logical drive */
 FRESULT f_mkfs (const TCHAR* path, const MKFS_PARM* opt, void* work, UINT len);	/* Create a FAT volume */
 FRESULT f_fdisk (BYTE pdrv, const LBA_t ptbl[], void* work);		/* Divide a physical drive into some partitions */
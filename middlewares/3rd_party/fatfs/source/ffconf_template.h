@@ -42,6 +42,25 @@
 /* This option switches f_expand function. (0:Disable or 1:Enable) */
 
 
+#define FF_USE_FREEMAP	0
+#define FF_FREEMAP_SIZE	128
+/* FF_USE_FREEMAP switches the free cluster region map and f_freemap_scan function
+/  for FAT/FAT32 volume. (0:Disable or 1:Enable)
+/  The map divides the FAT into regions and holds a bit per region in the
+/  filesystem object, set when the region has no free cluster, so that the
+/  cluster allocation skips the full part of the volume without reading its FAT
+/  sectors. FF_FREEMAP_SIZE defines RAM for the map in unit of byte, a byte covers
+/  eight regions and the region size is the smallest power of two that fits the
+/  volume in the map. The map is built lazily by the allocation and by
+/  f_freemap_scan, which also counts free clusters when FSINFO is not valid. */
+
+
+#define FF_USE_STREAM	0
+/* This option switches f_stream_write and f_stream_commit functions, which write
+/  sectors directly into a file preallocated by f_expand. (0:Disable or 1:Enable)
+/  To enable it, also FF_USE_EXPAND needs to be set to 1. */
+
+
 #define FF_USE_CHMOD	0
 /* This option switches attribute manipulation functions, f_chmod() and f_utime().
 /  (0:Disable or 1:Enable) Also FF_FS_READONLY needs to be 0 to enable this option. */
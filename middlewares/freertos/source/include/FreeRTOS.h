@@ -846,6 +846,10 @@
     #define configUSE_TRACE_FACILITY    0
 #endif
 
+#ifndef configUSE_STREAM_BUFFER_ZERO_COPY
+    #define configUSE_STREAM_BUFFER_ZERO_COPY    0
+#endif
+
 #ifndef mtCOVERAGE_TEST_MARKER
     #define mtCOVERAGE_TEST_MARKER()
 #endif
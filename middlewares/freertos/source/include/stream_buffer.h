@@ -838,6 +838,159 @@ BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer
 BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer,
                                                  BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+/**
+ * stream_buffer.h
+ *
+ * <pre>
+ * size_t xStreamBufferWriteAcquire( StreamBufferHandle_t xStreamBuffer, uint8_t ** ppucData, TickType_t xTicksToWait );
+ * </pre>
+ *
+ * Returns the contiguous free region at the head of a stream buffer so the
+ * writer, typically a peripheral DMA, can place data in the storage area
+ * directly instead of passing it to xStreamBufferSend().  The data becomes
+ * visible to the reader when it is committed with xStreamBufferWriteCommit()
+ * or xStreamBufferWriteCommitFromISR().
+ *
+ * The region ends at the end of the storage area, so when the free space wraps
+ * a second acquire after the commit returns the part at the start of the
+ * storage area.  Only the single writer of the stream buffer may acquire, and
+ * nothing else may be written between the acquire and the commit.  Message
+ * buffers are not supported.
+ *
+ * Set configUSE_STREAM_BUFFER_ZERO_COPY to 1 in FreeRTOSConfig.h for this
+ * function to be available.  It can be called from an interrupt when
+ * xTicksToWait is 0.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to write to.
+ *
+ * @param ppucData Set to the start of the free region.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state waiting for at least one byte of space.
+ *
+ * @return The number of bytes that can be written at *ppucData, 0 if the
+ * stream buffer stayed full.
+ *
+ * \defgroup xStreamBufferWriteAcquire xStreamBufferWriteAcquire
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferWriteAcquire( StreamBufferHandle_t xStreamBuffer,
+                                      uint8_t ** ppucData,
+                                      TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * <pre>
+ * size_t xStreamBufferWriteCommit( StreamBufferHandle_t xStreamBuffer, size_t xDataLengthBytes );
+ * size_t xStreamBufferWriteCommitFromISR( StreamBufferHandle_t xStreamBuffer, size_t xDataLengthBytes, BaseType_t * const pxHigherPriorityTaskWoken );
+ * </pre>
+ *
+ * Makes xDataLengthBytes bytes written in the region returned by
+ * xStreamBufferWriteAcquire() available to the reader, and unblocks a reader
+ * waiting for data when the trigger level is reached, the same as
+ * xStreamBufferSend().  xDataLengthBytes may be less than the acquired length,
+ * for example when a receive DMA is stopped early by an idle line.  The
+ * FromISR() version is called from the DMA transfer complete interrupt.
+ *
+ * @param xStreamBuffer The handle of the stream buffer written to.
+ *
+ * @param xDataLengthBytes The number of bytes written, at most the number
+ * returned by the last xStreamBufferWriteAcquire().
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a reader of higher
+ * priority than the running task was unblocked, in which case a context switch
+ * should be requested before the interrupt exits.
+ *
+ * @return xDataLengthBytes.
+ *
+ * \defgroup xStreamBufferWriteCommit xStreamBufferWriteCommit
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferWriteCommit( StreamBufferHandle_t xStreamBuffer,
+                                     size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+    size_t xStreamBufferWriteCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+                                            size_t xDataLengthBytes,
+                                            BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * <pre>
+ * size_t xStreamBufferReadAcquire( StreamBufferHandle_t xStreamBuffer, uint8_t ** ppucData, TickType_t xTicksToWait );
+ * </pre>
+ *
+ * Returns the contiguous data at the tail of a stream buffer so the reader,
+ * typically a transmit DMA or a parser, can consume it from the storage area
+ * directly instead of copying it out with xStreamBufferReceive().  The data
+ * stays in the stream buffer until it is released with
+ * xStreamBufferReadRelease() or xStreamBufferReadReleaseFromISR().
+ *
+ * The region ends at the end of the storage area, so wrapped data is returned
+ * by a second acquire after the release.  Only the single reader of the
+ * stream buffer may acquire.  Message buffers are not supported.
+ *
+ * Set configUSE_STREAM_BUFFER_ZERO_COPY to 1 in FreeRTOSConfig.h for this
+ * function to be available.  It can be called from an interrupt when
+ * xTicksToWait is 0.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to read from.
+ *
+ * @param ppucData Set to the start of the data.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state waiting for data, the task is unblocked when
+ * the trigger level is reached.
+ *
+ * @return The number of bytes that can be read at *ppucData, 0 if the stream
+ * buffer stayed empty.
+ *
+ * \defgroup xStreamBufferReadAcquire xStreamBufferReadAcquire
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferReadAcquire( StreamBufferHandle_t xStreamBuffer,
+                                     uint8_t ** ppucData,
+                                     TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * <pre>
+ * size_t xStreamBufferReadRelease( StreamBufferHandle_t xStreamBuffer, size_t xDataLengthBytes );
+ * size_t xStreamBufferReadReleaseFromISR( StreamBufferHandle_t xStreamBuffer, size_t xDataLengthBytes, BaseType_t * const pxHigherPriorityTaskWoken );
+ * </pre>
+ *
+ * Frees xDataLengthBytes bytes of the region returned by
+ * xStreamBufferReadAcquire(), and unblocks a writer waiting for space, the
+ * same as xStreamBufferReceive().  The FromISR() version is called from the
+ * DMA transfer complete interrupt.
+ *
+ * @param xStreamBuffer The handle of the stream buffer read from.
+ *
+ * @param xDataLengthBytes The number of bytes consumed, at most the number
+ * returned by the last xStreamBufferReadAcquire().
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a writer of higher
+ * priority than the running task was unblocked, in which case a context switch
+ * should be requested before the interrupt exits.
+ *
+ * @return xDataLengthBytes.
+ *
+ * \defgroup xStreamBufferReadRelease xStreamBufferReadRelease
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferReadRelease( StreamBufferHandle_t xStreamBuffer,
+                                     size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+    size_t xStreamBufferReadReleaseFromISR( StreamBufferHandle_t xStreamBuffer,
+                                            size_t xDataLengthBytes,
+                                            BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+
 /* Functions below here are not part of the public API. */
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
                                                  size_t xTriggerLevelBytes,
@@ -1128,6 +1128,305 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+    size_t xStreamBufferWriteAcquire( StreamBufferHandle_t xStreamBuffer,
+                                      uint8_t ** ppucData,
+                                      TickType_t xTicksToWait )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xSpace = 0;
+        TimeOut_t xTimeOut;
+
+        configASSERT( ppucData );
+        configASSERT( pxStreamBuffer );
+
+        /* The data of a message buffer is prefixed with its length, which the
+         * caller cannot write in place. */
+        configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+        if( xTicksToWait != ( TickType_t ) 0 )
+        {
+            vTaskSetTimeOutState( &xTimeOut );
+
+            do
+            {
+                /* Wait until at least one byte is free. */
+                taskENTER_CRITICAL();
+                {
+                    xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+                    if( xSpace == ( size_t ) 0 )
+                    {
+                        /* Clear notification state as going to wait for space. */
+                        ( void ) xTaskNotifyStateClear( NULL );
+
+                        /* Should only be one writer. */
+                        configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+                        pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+                    }
+                    else
+                    {
+                        taskEXIT_CRITICAL();
+                        break;
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+                ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+                pxStreamBuffer->xTaskWaitingToSend = NULL;
+            } while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xSpace == ( size_t ) 0 )
+        {
+            xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Only the part of the free space before the end of the storage area is
+         * contiguous, the rest is returned by the next acquire. */
+        *ppucData = &( pxStreamBuffer->pucBuffer[ pxStreamBuffer->xHead ] );
+
+        return configMIN( xSpace, pxStreamBuffer->xLength - pxStreamBuffer->xHead );
+    }
+/*-----------------------------------------------------------*/
+
+    /* Moves the head past xCount bytes written in place by the caller. */
+    static void prvCommitBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                        size_t xCount )
+    {
+        size_t xNextHead;
+
+        configASSERT( xCount <= xStreamBufferSpacesAvailable( pxStreamBuffer ) );
+        configASSERT( ( pxStreamBuffer->xHead + xCount ) <= pxStreamBuffer->xLength );
+
+        xNextHead = pxStreamBuffer->xHead + xCount;
+
+        if( xNextHead >= pxStreamBuffer->xLength )
+        {
+            xNextHead -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxStreamBuffer->xHead = xNextHead;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xStreamBufferWriteCommit( StreamBufferHandle_t xStreamBuffer,
+                                     size_t xDataLengthBytes )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        configASSERT( pxStreamBuffer );
+
+        if( xDataLengthBytes > ( size_t ) 0 )
+        {
+            prvCommitBytesToBuffer( pxStreamBuffer, xDataLengthBytes );
+            traceSTREAM_BUFFER_SEND( xStreamBuffer, xDataLengthBytes );
+
+            /* Was a task waiting for the data? */
+            if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+            {
+                sbSEND_COMPLETED( pxStreamBuffer );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xDataLengthBytes;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xStreamBufferWriteCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+                                            size_t xDataLengthBytes,
+                                            BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        configASSERT( pxStreamBuffer );
+
+        if( xDataLengthBytes > ( size_t ) 0 )
+        {
+            prvCommitBytesToBuffer( pxStreamBuffer, xDataLengthBytes );
+
+            /* Was a task waiting for the data? */
+            if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+            {
+                sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xDataLengthBytes );
+
+        return xDataLengthBytes;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xStreamBufferReadAcquire( StreamBufferHandle_t xStreamBuffer,
+                                     uint8_t ** ppucData,
+                                     TickType_t xTicksToWait )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xBytesAvailable;
+
+        configASSERT( ppucData );
+        configASSERT( pxStreamBuffer );
+        configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+        if( xTicksToWait != ( TickType_t ) 0 )
+        {
+            /* Checking if there is data and clearing the notification state must be
+             * performed atomically. */
+            taskENTER_CRITICAL();
+            {
+                xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+                if( xBytesAvailable == ( size_t ) 0 )
+                {
+                    /* Clear notification state as going to wait for data. */
+                    ( void ) xTaskNotifyStateClear( NULL );
+
+                    /* Should only be one reader. */
+                    configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+                    pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xBytesAvailable == ( size_t ) 0 )
+            {
+                /* Wait for data to be available. */
+                traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+                ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+                pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+                /* Recheck the data available after blocking. */
+                xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+        }
+
+        /* Only the data before the end of the storage area is contiguous, the
+         * rest is returned by the next acquire. */
+        *ppucData = &( pxStreamBuffer->pucBuffer[ pxStreamBuffer->xTail ] );
+
+        return configMIN( xBytesAvailable, pxStreamBuffer->xLength - pxStreamBuffer->xTail );
+    }
+/*-----------------------------------------------------------*/
+
+    /* Moves the tail past xCount bytes consumed in place by the caller. */
+    static void prvReleaseBytesFromBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                           size_t xCount )
+    {
+        size_t xNextTail;
+
+        configASSERT( xCount <= prvBytesInBuffer( pxStreamBuffer ) );
+        configASSERT( ( pxStreamBuffer->xTail + xCount ) <= pxStreamBuffer->xLength );
+
+        xNextTail = pxStreamBuffer->xTail + xCount;
+
+        if( xNextTail >= pxStreamBuffer->xLength )
+        {
+            xNextTail -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxStreamBuffer->xTail = xNextTail;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xStreamBufferReadRelease( StreamBufferHandle_t xStreamBuffer,
+                                     size_t xDataLengthBytes )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        configASSERT( pxStreamBuffer );
+
+        if( xDataLengthBytes > ( size_t ) 0 )
+        {
+            prvReleaseBytesFromBuffer( pxStreamBuffer, xDataLengthBytes );
+            traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xDataLengthBytes );
+
+            /* Was a task waiting for space in the buffer? */
+            sbRECEIVE_COMPLETED( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xDataLengthBytes;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xStreamBufferReadReleaseFromISR( StreamBufferHandle_t xStreamBuffer,
+                                            size_t xDataLengthBytes,
+                                            BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        configASSERT( pxStreamBuffer );
+
+        if( xDataLengthBytes > ( size_t ) 0 )
+        {
+            prvReleaseBytesFromBuffer( pxStreamBuffer, xDataLengthBytes );
+
+            /* Was a task waiting for space in the buffer? */
+            sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xDataLengthBytes );
+
+        return xDataLengthBytes;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+
 static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
                                      const uint8_t * pucData,
                                      size_t xCount )
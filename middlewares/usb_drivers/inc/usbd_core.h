@@ -95,6 +95,34 @@ typedef struct
 #endif
 }usbd_desc_handler;
 
+/**
+  * @brief usb device out endpoint buffer pool max buffer number,
+  *        can be overridden in usb_conf.h (max 32)
+  */
+#ifndef USBD_POOL_MAX_BUF_NUM
+#define USBD_POOL_MAX_BUF_NUM            8
+#endif
+#define USBD_POOL_NONE                   0xFF
+
+/**
+  * @brief usb device out endpoint buffer pool, the core receives the out
+  *        packets straight from the fifo into the pool buffers and passes
+  *        the filled buffers to the class by pointer
+  */
+typedef struct
+{
+  uint8_t                                *buffer;                    /*!< pool storage, buf_num * buf_size bytes, 4 bytes aligned */
+  uint16_t                               buf_size;                   /*!< size of one buffer, multiple of the max packet size */
+  uint8_t                                buf_num;                    /*!< number of buffers */
+  uint8_t                                ept_addr;                   /*!< out endpoint address */
+  uint8_t                                armed;                      /*!< buffer armed on the endpoint, USBD_POOL_NONE when nak */
+  uint8_t                                ready_head;                 /*!< oldest filled buffer in ready_idx */
+  __IO uint8_t                           ready_count;                /*!< filled buffers not yet taken */
+  __IO uint32_t                          free_mask;                  /*!< bit n set when buffer n is free */
+  uint8_t                                ready_idx[USBD_POOL_MAX_BUF_NUM]; /*!< filled buffers in receive order */
+  uint16_t                               ready_len[USBD_POOL_MAX_BUF_NUM]; /*!< received length of filled buffers */
+}usbd_ept_pool_type;
+
 /**
   * @brief usb device class handler
   */
@@ -124,6 +152,7 @@ typedef struct
 
   usb_ept_info                           ept_in[USB_EPT_MAX_NUM];    /*!< usb in endpoint infomation struct */
   usb_ept_info                           ept_out[USB_EPT_MAX_NUM];   /*!< usb out endpoint infomation struct */
+  usbd_ept_pool_type                     *ept_pool[USB_EPT_MAX_NUM]; /*!< usb out endpoint buffer pool, null when not used */
 
   usb_setup_type                         setup;                      /*!< usb setup type struct */
   uint8_t                                setup_buffer[12];           /*!< usb setup request buffer */
@@ -157,6 +186,10 @@ void usbd_ept_in_check_fifo(usbd_core_type *udev, uint8_t ept_addr);
 void usbd_ept_close(usbd_core_type *udev, uint8_t ept_addr);
 void usbd_ept_send(usbd_core_type *udev, uint8_t ept_num, uint8_t *buffer, uint16_t len);
 void usbd_ept_recv(usbd_core_type *udev, uint8_t ept_num, uint8_t *buffer, uint16_t len);
+void usbd_ept_pool_init(usbd_core_type *udev, usbd_ept_pool_type *pool, uint8_t ept_addr,
+                        uint8_t *buffer, uint16_t buf_size, uint8_t buf_num);
+uint8_t *usbd_ept_pool_get(usbd_core_type *udev, uint8_t ept_addr, uint32_t *len);
+void usbd_ept_pool_free(usbd_core_type *udev, uint8_t ept_addr, uint8_t *buffer);
 void usbd_connect(usbd_core_type *udev);
 void usbd_disconnect(usbd_core_type *udev);
 void usbd_set_device_addr(usbd_core_type *udev, uint8_t address);
@@ -40,6 +40,9 @@
   * @{
   */
 
+static void usbd_ept_pool_arm(usbd_core_type *udev, usbd_ept_pool_type *pool);
+static void usbd_ept_pool_complete(usbd_core_type *udev, usbd_ept_pool_type *pool);
+
 /**
   * @brief  usb core in transfer complete handler
   * @param  udev: to the structure of usbd_core_type
@@ -126,6 +129,12 @@ void usbd_core_out_handler(usbd_core_type *udev, uint8_t ept_addr)
   else if(udev->class_handler->out_handler != 0 &&
           udev->conn_state == USB_CONN_STATE_CONFIGURED)
   {
+    /* endpoint with a buffer pool, queue the filled buffer and re-arm */
+    if(udev->ept_pool[ept_addr & 0x7F] != NULL)
+    {
+      usbd_ept_pool_complete(udev, udev->ept_pool[ept_addr & 0x7F]);
+    }
+
     /* other user define endpoint */
     udev->class_handler->out_handler(udev, ept_addr);
   }
@@ -613,6 +622,141 @@ void usbd_ept_recv(usbd_core_type *udev, uint8_t ept_addr, uint8_t *buffer, uint
   ept_out->doepctl_bit.eptena = TRUE;
 }
 
+/**
+  * @brief  arm the out endpoint with a free pool buffer, the endpoint
+  *         stays nak when the pool has no free buffer
+  * @param  udev: to the structure of usbd_core_type
+  * @param  pool: endpoint buffer pool
+  * @retval none
+  */
+static void usbd_ept_pool_arm(usbd_core_type *udev, usbd_ept_pool_type *pool)
+{
+  uint8_t index;
+
+  if(pool->armed != USBD_POOL_NONE || pool->free_mask == 0)
+  {
+    return;
+  }
+
+  for(index = 0; (pool->free_mask & (1UL << index)) == 0; index ++);
+  pool->free_mask &= ~(1UL << index);
+  pool->armed = index;
+
+  usbd_ept_recv(udev, pool->ept_addr, pool->buffer + index * pool->buf_size, pool->buf_size);
+}
+
+/**
+  * @brief  out transfer complete on a pool endpoint, called in interrupt
+  * @param  udev: to the structure of usbd_core_type
+  * @param  pool: endpoint buffer pool
+  * @retval none
+  */
+static void usbd_ept_pool_complete(usbd_core_type *udev, usbd_ept_pool_type *pool)
+{
+  uint8_t slot;
+
+  if(pool->armed == USBD_POOL_NONE)
+  {
+    return;
+  }
+
+  slot = (pool->ready_head + pool->ready_count) % pool->buf_num;
+  pool->ready_idx[slot] = pool->armed;
+  pool->ready_len[slot] = (uint16_t)udev->ept_out[pool->ept_addr & 0x7F].trans_len;
+  pool->ready_count ++;
+  pool->armed = USBD_POOL_NONE;
+
+  usbd_ept_pool_arm(udev, pool);
+}
+
+/**
+  * @brief  lend a set of buffers to an out endpoint, call it after
+  *         usbd_ept_open instead of usbd_ept_recv
+  * @param  udev: to the structure of usbd_core_type
+  * @param  pool: endpoint buffer pool
+  * @param  ept_addr: out endpoint address
+  * @param  buffer: pool storage, buf_num * buf_size bytes, 4 bytes aligned
+  * @param  buf_size: size of one buffer, multiple of the max packet size
+  * @param  buf_num: number of buffers, max USBD_POOL_MAX_BUF_NUM
+  * @retval none
+  */
+void usbd_ept_pool_init(usbd_core_type *udev, usbd_ept_pool_type *pool, uint8_t ept_addr,
+                        uint8_t *buffer, uint16_t buf_size, uint8_t buf_num)
+{
+  if(buf_num > USBD_POOL_MAX_BUF_NUM)
+  {
+    buf_num = USBD_POOL_MAX_BUF_NUM;
+  }
+
+  pool->buffer = buffer;
+  pool->buf_size = buf_size;
+  pool->buf_num = buf_num;
+  pool->ept_addr = ept_addr;
+  pool->armed = USBD_POOL_NONE;
+  pool->ready_head = 0;
+  pool->ready_count = 0;
+  pool->free_mask = (buf_num >= 32) ? 0xFFFFFFFF : ((1UL << buf_num) - 1);
+
+  udev->ept_pool[ept_addr & 0x7F] = pool;
+
+  usbd_ept_pool_arm(udev, pool);
+}
+
+/**
+  * @brief  take the oldest filled buffer of a pool endpoint, the caller
+  *         owns the buffer until it is given back with usbd_ept_pool_free
+  * @param  udev: to the structure of usbd_core_type
+  * @param  ept_addr: out endpoint address
+  * @param  len: received data length
+  * @retval buffer address or null when no data is received
+  */
+uint8_t *usbd_ept_pool_get(usbd_core_type *udev, uint8_t ept_addr, uint32_t *len)
+{
+  usbd_ept_pool_type *pool = udev->ept_pool[ept_addr & 0x7F];
+  uint8_t *buffer = NULL;
+  uint32_t primask;
+
+  if(pool == NULL || pool->ready_count == 0)
+  {
+    return NULL;
+  }
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  buffer = pool->buffer + pool->ready_idx[pool->ready_head] * pool->buf_size;
+  *len = pool->ready_len[pool->ready_head];
+  pool->ready_head = (pool->ready_head + 1) % pool->buf_num;
+  pool->ready_count --;
+  __set_PRIMASK(primask);
+
+  return buffer;
+}
+
+/**
+  * @brief  give a buffer back to the pool, the endpoint is armed again if
+  *         it was waiting for a free buffer
+  * @param  udev: to the structure of usbd_core_type
+  * @param  ept_addr: out endpoint address
+  * @param  buffer: buffer returned by usbd_ept_pool_get
+  * @retval none
+  */
+void usbd_ept_pool_free(usbd_core_type *udev, uint8_t ept_addr, uint8_t *buffer)
+{
+  usbd_ept_pool_type *pool = udev->ept_pool[ept_addr & 0x7F];
+  uint32_t primask;
+
+  if(pool == NULL || buffer < pool->buffer)
+  {
+    return;
+  }
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  pool->free_mask |= 1UL << ((buffer - pool->buffer) / pool->buf_size);
+  usbd_ept_pool_arm(udev, pool);
+  __set_PRIMASK(primask);
+}
+
 /**
   * @brief  get usb connect state
   * @param  udev: to the structure of usbd_core_type
@@ -754,6 +898,12 @@ usb_sts_type usbd_core_init(usbd_core_type *udev,
   udev->device_addr = 0;
   udev->class_handler = class_handler;
   udev->desc_handler = desc_handler;
+
+  /* no out endpoint uses a buffer pool until the class sets one */
+  for(i_index = 0; i_index < USB_EPT_MAX_NUM; i_index ++)
+  {
+    udev->ept_pool[i_index] = NULL;
+  }
   /* set device disconnect */
   usbd_disconnect(udev);
 
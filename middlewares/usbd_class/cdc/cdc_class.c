@@ -101,8 +101,9 @@ static usb_sts_type class_init_handler(void *udev)
   /* open out endpoint */
   usbd_ept_open(pudev, USBD_CDC_BULK_OUT_EPT, EPT_BULK_TYPE, USBD_CDC_OUT_MAXPACKET_SIZE);
 
-  /* set out endpoint to receive status */
-  usbd_ept_recv(pudev, USBD_CDC_BULK_OUT_EPT, pcdc->g_rx_buff, USBD_CDC_OUT_MAXPACKET_SIZE);
+  /* lend the receive buffers to the out endpoint */
+  usbd_ept_pool_init(pudev, &pcdc->rx_pool, USBD_CDC_BULK_OUT_EPT, pcdc->g_rx_pool,
+                     USBD_CDC_OUT_MAXPACKET_SIZE, USBD_CDC_RX_POOL_NUM);
 
   return status;
 }
@@ -255,14 +256,8 @@ static usb_sts_type class_in_handler(void *udev, uint8_t ept_num)
 static usb_sts_type class_out_handler(void *udev, uint8_t ept_num)
 {
   usb_sts_type status = USB_OK;
-  usbd_core_type *pudev = (usbd_core_type *)udev;
-  cdc_struct_type *pcdc = (cdc_struct_type *)pudev->class_handler->pdata;
-
-  /* get endpoint receive data length  */
-  pcdc->g_rxlen = usbd_get_recv_len(pudev, ept_num);
 
-  /*set recv flag*/
-  pcdc->g_rx_completed = 1;
+  /* the received buffer is queued in the out buffer pool by the core */
 
   return status;
 }
@@ -325,7 +320,6 @@ static usb_sts_type class_event_handler(void *udev, usbd_event_type event)
 static usb_sts_type cdc_struct_init(cdc_struct_type *pcdc)
 {
   pcdc->g_tx_completed = 1;
-  pcdc->g_rx_completed = 0;
   pcdc->alt_setting = 0;
   pcdc->linecoding.bitrate = linecoding.bitrate;
   pcdc->linecoding.data = linecoding.data;
@@ -344,25 +338,56 @@ uint16_t usb_vcp_get_rxdata(void *udev, uint8_t *recv_data)
 {
   uint16_t i_index = 0;
   uint16_t tmp_len = 0;
-  usbd_core_type *pudev = (usbd_core_type *)udev;
-  cdc_struct_type *pcdc = (cdc_struct_type *)pudev->class_handler->pdata;
+  uint8_t *buffer;
 
-  if(pcdc->g_rx_completed == 0)
+  buffer = usb_vcp_rx_acquire(udev, &tmp_len);
+  if(buffer == NULL)
   {
     return 0;
   }
-  pcdc->g_rx_completed = 0;
-  tmp_len = pcdc->g_rxlen;
-  for(i_index = 0; i_index < pcdc->g_rxlen; i_index ++)
+
+  for(i_index = 0; i_index < tmp_len; i_index ++)
   {
-    recv_data[i_index] = pcdc->g_rx_buff[i_index];
+    recv_data[i_index] = buffer[i_index];
   }
 
-  usbd_ept_recv(pudev, USBD_CDC_BULK_OUT_EPT, pcdc->g_rx_buff, USBD_CDC_OUT_MAXPACKET_SIZE);
+  usb_vcp_rx_release(udev, buffer);
 
   return tmp_len;
 }
 
+/**
+  * @brief  usb device class take a received packet without copy, the
+  *         buffer must be given back with usb_vcp_rx_release
+  * @param  udev: to the structure of usbd_core_type
+  * @param  len: receive data len
+  * @retval receive buffer or null when no data is received
+  */
+uint8_t *usb_vcp_rx_acquire(void *udev, uint16_t *len)
+{
+  usbd_core_type *pudev = (usbd_core_type *)udev;
+  uint32_t recv_len = 0;
+  uint8_t *buffer;
+
+  buffer = usbd_ept_pool_get(pudev, USBD_CDC_BULK_OUT_EPT, &recv_len);
+  *len = (uint16_t)recv_len;
+
+  return buffer;
+}
+
+/**
+  * @brief  usb device class give a received buffer back to the out pool
+  * @param  udev: to the structure of usbd_core_type
+  * @param  buffer: buffer returned by usb_vcp_rx_acquire
+  * @retval none
+  */
+void usb_vcp_rx_release(void *udev, uint8_t *buffer)
+{
+  usbd_core_type *pudev = (usbd_core_type *)udev;
+
+  usbd_ept_pool_free(pudev, USBD_CDC_BULK_OUT_EPT, buffer);
+}
+
 /**
   * @brief  usb device class send data
   * @param  udev: to the structure of usbd_core_type
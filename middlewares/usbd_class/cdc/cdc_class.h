@@ -60,6 +60,13 @@ extern "C" {
 #define USBD_CDC_OUT_MAXPACKET_SIZE       0x40
 #define USBD_CDC_CMD_MAXPACKET_SIZE       0x08
 
+/**
+  * @brief usb cdc out buffer pool, number of max packet buffers
+  */
+#ifndef USBD_CDC_RX_POOL_NUM
+#define USBD_CDC_RX_POOL_NUM              4
+#endif
+
 /**
   * @}
   */
@@ -74,11 +81,12 @@ extern "C" {
 typedef struct
 {
   uint32_t alt_setting;
-  uint8_t g_rx_buff[USBD_CDC_OUT_MAXPACKET_SIZE];
+  uint8_t g_rx_pool[USBD_CDC_RX_POOL_NUM * USBD_CDC_OUT_MAXPACKET_SIZE];
+  usbd_ept_pool_type rx_pool;
   uint8_t g_cmd[USBD_CDC_CMD_MAXPACKET_SIZE];
   uint8_t g_req;
-  uint16_t g_len, g_rxlen;
-  __IO uint8_t g_tx_completed, g_rx_completed;
+  uint16_t g_len;
+  __IO uint8_t g_tx_completed;
   linecoding_type linecoding;
 }cdc_struct_type;
 
@@ -92,6 +100,8 @@ typedef struct
   */
 extern usbd_class_handler cdc_class_handler;
 uint16_t usb_vcp_get_rxdata(void *udev, uint8_t *recv_data);
+uint8_t *usb_vcp_rx_acquire(void *udev, uint16_t *len);
+void usb_vcp_rx_release(void *udev, uint8_t *buffer);
 error_status usb_vcp_send_data(void *udev, uint8_t *send_data, uint16_t len);
 
 /**
@@ -307,7 +307,10 @@ usb_sts_type bot_scsi_check_address(void *udev, uint8_t lun, uint32_t blk_offset
 {
   usbd_core_type *pudev = (usbd_core_type *)udev;
   cdc_msc_struct_type *pmsc = (cdc_msc_struct_type *)pudev->class_handler->pdata;
-  if((blk_offset + blk_count) > pmsc->blk_nbr[lun])
+
+  /* no wrap of the block range, the byte length of the transfer must fit 32 bits */
+  if(blk_offset >= pmsc->blk_nbr[lun] || blk_count > pmsc->blk_nbr[lun] - blk_offset ||
+     blk_count > 0xFFFFFFFF / pmsc->blk_size[lun])
   {
     bot_scsi_sense_code(udev, SENSE_KEY_ILLEGAL_REQUEST, ADDRESS_OUT_OF_RANGE);
     return USB_FAIL;
@@ -83,11 +83,18 @@ static usb_sts_type class_init_handler(void *udev)
   /* open custom hid out endpoint */
   usbd_ept_open(pudev, USBD_CUSTOM_HID_OUT_EPT, EPT_INT_TYPE, USBD_CUSTOM_OUT_MAXPACKET_SIZE);
 
-  /* set out endpoint to receive status */
-  usbd_ept_recv(pudev, USBD_CUSTOM_HID_OUT_EPT, pcshid->g_rxhid_buff, USBD_CUSTOM_OUT_MAXPACKET_SIZE);
-
   pcshid->send_state = 0;
-  
+  pcshid->sof_count = 0;
+  pcshid->tx_head = 0;
+  pcshid->tx_count = 0;
+  pcshid->rx_head = 0;
+  pcshid->rx_tail = 0;
+  pcshid->rx_count = 0;
+  pcshid->rx_pause = 0;
+
+  /* set out endpoint to receive status, directly into the first ring slot */
+  usbd_ept_recv(pudev, USBD_CUSTOM_HID_OUT_EPT, pcshid->rx_queue[0].report, USBD_CUSTOM_OUT_MAXPACKET_SIZE);
+
   return status;
 }
 
@@ -226,7 +233,7 @@ static usb_sts_type class_ept0_rx_handler(void *udev)
   /* ...user code... */
   if( pcshid->hid_state == HID_REQ_SET_REPORT)
   {
-    /* hid buffer process */
+    /* control endpoint reports are host paced, process them directly */
     usb_hid_buf_process(udev, pcshid->hid_set_report, recv_len);
     pcshid->hid_state = 0;
   }
@@ -245,12 +252,14 @@ static usb_sts_type class_in_handler(void *udev, uint8_t ept_num)
   usb_sts_type status = USB_OK;
   usbd_core_type *pudev = (usbd_core_type *)udev;
   custom_hid_type *pcshid = (custom_hid_type *)pudev->class_handler->pdata;
-  
-  pcshid->send_state = 0;
-  
-  /* ...user code...
-    trans next packet data
-  */
+
+  /* release the report slot, the next one is sent from sof */
+  if(pcshid->send_state == 1)
+  {
+    pcshid->tx_head = (pcshid->tx_head + 1) % CUSTOM_HID_TX_QUEUE_DEPTH;
+    pcshid->tx_count --;
+    pcshid->send_state = 0;
+  }
 
   return status;
 }
@@ -270,11 +279,21 @@ static usb_sts_type class_out_handler(void *udev, uint8_t ept_num)
   /* get endpoint receive data length  */
   uint32_t recv_len = usbd_get_recv_len(pudev, ept_num);
 
-  /* hid buffer process */
-  usb_hid_buf_process(udev, pcshid->g_rxhid_buff, recv_len);
+  /* commit the report to the ring, it is processed by custom_hid_class_process */
+  pcshid->rx_queue[pcshid->rx_tail].len = recv_len;
+  pcshid->rx_tail = (pcshid->rx_tail + 1) % CUSTOM_HID_RX_QUEUE_DEPTH;
+  pcshid->rx_count ++;
 
-  /* start receive next packet */
-  usbd_ept_recv(pudev, USBD_CUSTOM_HID_OUT_EPT, pcshid->g_rxhid_buff, recv_len);
+  if(pcshid->rx_count < CUSTOM_HID_RX_QUEUE_DEPTH)
+  {
+    /* start receive next packet */
+    usbd_ept_recv(pudev, USBD_CUSTOM_HID_OUT_EPT, pcshid->rx_queue[pcshid->rx_tail].report, USBD_CUSTOM_OUT_MAXPACKET_SIZE);
+  }
+  else
+  {
+    /* ring is full, keep the endpoint nak until a slot is released */
+    pcshid->rx_pause = 1;
+  }
 
   return status;
 }
@@ -287,8 +306,29 @@ static usb_sts_type class_out_handler(void *udev, uint8_t ept_num)
 static usb_sts_type class_sof_handler(void *udev)
 {
   usb_sts_type status = USB_OK;
+  usbd_core_type *pudev = (usbd_core_type *)udev;
+  custom_hid_type *pcshid = (custom_hid_type *)pudev->class_handler->pdata;
 
-  /* ...user code... */
+  if(usbd_connect_state_get(pudev) != USB_CONN_STATE_CONFIGURED)
+  {
+    return status;
+  }
+
+  if(pcshid->sof_count < CUSHID_BINTERVAL_TIME)
+  {
+    pcshid->sof_count ++;
+  }
+
+  /* send at most one queued report per binterval */
+  if(pcshid->sof_count >= CUSHID_BINTERVAL_TIME &&
+     pcshid->send_state == 0 && pcshid->tx_count > 0)
+  {
+    pcshid->sof_count = 0;
+    pcshid->send_state = 1;
+    usbd_ept_send(pudev, USBD_CUSTOM_HID_IN_EPT,
+                  pcshid->tx_queue[pcshid->tx_head].report,
+                  pcshid->tx_queue[pcshid->tx_head].len);
+  }
 
   return status;
 }
@@ -325,27 +365,102 @@ static usb_sts_type class_event_handler(void *udev, usbd_event_type event)
 }
 
 /**
-  * @brief  usb device class send report
+  * @brief  usb device class send report, the report is copied into the in
+  *         report queue and sent from the sof handler once per binterval.
+  *         a queued report with the same report id that is not yet on the
+  *         bus is replaced, so only the newest state of each report is sent.
   * @param  udev: to the structure of usbd_core_type
   * @param  report: report buffer
   * @param  len: report length
-  * @retval status of usb_sts_type
+  * @retval status of usb_sts_type, USB_FAIL if not configured or queue full
   */
 usb_sts_type custom_hid_class_send_report(void *udev, uint8_t *report, uint16_t len)
 {
   usb_sts_type status = USB_FAIL;
   usbd_core_type *pudev = (usbd_core_type *)udev;
   custom_hid_type *pcshid = (custom_hid_type *)pudev->class_handler->pdata;
+  custom_hid_report_type *pslot = NULL;
+  uint32_t primask, i_index, i_slot;
 
-  if(usbd_connect_state_get(pudev) == USB_CONN_STATE_CONFIGURED && pcshid->send_state == 0)
+  if(usbd_connect_state_get(pudev) != USB_CONN_STATE_CONFIGURED ||
+     len == 0 || len > USBD_CUSTOM_IN_MAXPACKET_SIZE)
   {
-    pcshid->send_state = 1;
-    usbd_ept_send(pudev, USBD_CUSTOM_HID_IN_EPT, report, len);
+    return status;
+  }
+
+  /* the queue is shared with the sof and in handlers */
+  primask = __get_PRIMASK();
+  __disable_irq();
+
+  /* look for a pending report with the same id, skip the one on the bus */
+  for(i_index = pcshid->send_state; i_index < pcshid->tx_count; i_index ++)
+  {
+    i_slot = (pcshid->tx_head + i_index) % CUSTOM_HID_TX_QUEUE_DEPTH;
+    if(pcshid->tx_queue[i_slot].report[0] == report[0])
+    {
+      pslot = &pcshid->tx_queue[i_slot];
+      break;
+    }
+  }
+
+  if(pslot == NULL && pcshid->tx_count < CUSTOM_HID_TX_QUEUE_DEPTH)
+  {
+    i_slot = (pcshid->tx_head + pcshid->tx_count) % CUSTOM_HID_TX_QUEUE_DEPTH;
+    pslot = &pcshid->tx_queue[i_slot];
+    pcshid->tx_count ++;
+  }
+
+  if(pslot != NULL)
+  {
+    for(i_index = 0; i_index < len; i_index ++)
+    {
+      pslot->report[i_index] = report[i_index];
+    }
+    pslot->len = len;
     status = USB_OK;
   }
+
+  __set_PRIMASK(primask);
+
   return status;
 }
 
+/**
+  * @brief  usb device class process the out reports queued by the out
+  *         endpoint handler, call it from the application main loop
+  * @param  udev: to the structure of usbd_core_type
+  * @retval none
+  */
+void custom_hid_class_process(void *udev)
+{
+  usbd_core_type *pudev = (usbd_core_type *)udev;
+  custom_hid_type *pcshid = (custom_hid_type *)pudev->class_handler->pdata;
+  custom_hid_report_type *pslot;
+  uint32_t primask;
+
+  while(pcshid->rx_count > 0)
+  {
+    pslot = &pcshid->rx_queue[pcshid->rx_head];
+
+    /* hid buffer process */
+    usb_hid_buf_process(udev, pslot->report, pslot->len);
+
+    pcshid->rx_head = (pcshid->rx_head + 1) % CUSTOM_HID_RX_QUEUE_DEPTH;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    pcshid->rx_count --;
+
+    /* a slot is free again, resume the out endpoint */
+    if(pcshid->rx_pause)
+    {
+      pcshid->rx_pause = 0;
+      usbd_ept_recv(pudev, USBD_CUSTOM_HID_OUT_EPT, pcshid->rx_queue[pcshid->rx_tail].report, USBD_CUSTOM_OUT_MAXPACKET_SIZE);
+    }
+    __set_PRIMASK(primask);
+  }
+}
+
 /**
   * @brief  usb device report function
   * @param  udev: to the structure of usbd_core_type
@@ -355,14 +470,12 @@ usb_sts_type custom_hid_class_send_report(void *udev, uint8_t *report, uint16_t
   */
 static void usb_hid_buf_process(void *udev, uint8_t *report, uint16_t len)
 {
-  uint32_t i_index;
   usbd_core_type *pudev = (usbd_core_type *)udev;
-  custom_hid_type *pcshid = (custom_hid_type *)pudev->class_handler->pdata;
 
   switch(report[0])
   {
     case HID_REPORT_ID_2:
-      if(pcshid->g_rxhid_buff[1] == 0)
+      if(report[1] == 0)
       {
         at32_led_off(LED2);
       }
@@ -372,7 +485,7 @@ static void usb_hid_buf_process(void *udev, uint8_t *report, uint16_t len)
       }
       break;
     case HID_REPORT_ID_3:
-      if(pcshid->g_rxhid_buff[1] == 0)
+      if(report[1] == 0)
       {
         at32_led_off(LED3);
       }
@@ -382,7 +495,7 @@ static void usb_hid_buf_process(void *udev, uint8_t *report, uint16_t len)
       }
       break;
     case HID_REPORT_ID_4:
-      if(pcshid->g_rxhid_buff[1] == 0)
+      if(report[1] == 0)
       {
         at32_led_off(LED4);
       }
@@ -392,11 +505,8 @@ static void usb_hid_buf_process(void *udev, uint8_t *report, uint16_t len)
       }
       break;
     case HID_REPORT_ID_6:
-      for(i_index = 0; i_index < len; i_index ++)
-      {
-        pcshid->g_txhid_buff[i_index] = report[i_index];
-      }
-      custom_hid_class_send_report(pudev, pcshid->g_txhid_buff, len);
+      /* echo back, the report is copied into the in report queue */
+      custom_hid_class_send_report(pudev, report, len);
       break;
     default:
       break;
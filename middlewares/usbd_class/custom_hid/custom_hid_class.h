@@ -58,6 +58,22 @@ extern "C" {
 #define USBD_CUSTOM_IN_MAXPACKET_SIZE           0x40
 #define USBD_CUSTOM_OUT_MAXPACKET_SIZE          0x40
 
+/**
+  * @brief usb custom hid in report queue depth (in reports),
+  *        can be overridden in usb_conf.h
+  */
+#ifndef CUSTOM_HID_TX_QUEUE_DEPTH
+#define CUSTOM_HID_TX_QUEUE_DEPTH               8
+#endif
+
+/**
+  * @brief usb custom hid out report ring depth (in reports),
+  *        can be overridden in usb_conf.h
+  */
+#ifndef CUSTOM_HID_RX_QUEUE_DEPTH
+#define CUSTOM_HID_RX_QUEUE_DEPTH               4
+#endif
+
 /**
   * @}
   */
@@ -66,19 +82,36 @@ extern "C" {
   * @{
   */
 
+/**
+  * @brief usb custom hid queued report
+  */
 typedef struct
 {
-  uint8_t g_rxhid_buff[USBD_CUSTOM_OUT_MAXPACKET_SIZE];
-  uint8_t g_txhid_buff[USBD_CUSTOM_IN_MAXPACKET_SIZE];
+  uint8_t report[USBD_CUSTOM_IN_MAXPACKET_SIZE];                   /*!< report data, report[0] is report id */
+  uint32_t len;                                                    /*!< report length */
+}custom_hid_report_type;
 
+typedef struct
+{
   uint32_t hid_protocol;
   uint32_t hid_set_idle;
   uint32_t alt_setting;
-  
+
+  custom_hid_report_type tx_queue[CUSTOM_HID_TX_QUEUE_DEPTH];      /*!< in report queue, drained from sof */
+  custom_hid_report_type rx_queue[CUSTOM_HID_RX_QUEUE_DEPTH];      /*!< out report ring, drained by custom_hid_class_process */
+
   uint8_t hid_set_report[64];
   uint8_t hid_get_report[64];
   uint8_t hid_state;
   uint8_t send_state;
+
+  uint8_t tx_head;                                                 /*!< next report to send */
+  uint8_t tx_count;                                                /*!< reports waiting in tx_queue */
+  uint8_t rx_head;                                                 /*!< next report to process */
+  uint8_t rx_tail;                                                 /*!< slot armed for out endpoint */
+  uint8_t rx_count;                                                /*!< reports waiting in rx_queue */
+  uint8_t rx_pause;                                                /*!< out endpoint left nak because ring is full */
+  uint16_t sof_count;                                              /*!< frames since the last in transfer */
 }custom_hid_type;
 
 /**
@@ -90,6 +123,7 @@ typedef struct
   */
 extern usbd_class_handler custom_hid_class_handler;
 usb_sts_type custom_hid_class_send_report(void *udev, uint8_t *report, uint16_t len);
+void custom_hid_class_process(void *udev);
 /**
   * @}
   */
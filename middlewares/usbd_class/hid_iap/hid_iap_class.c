@@ -261,11 +261,13 @@ static usb_sts_type class_out_handler(void *udev, uint8_t ept_num)
   /* get endpoint receive data length  */
   uint32_t recv_len = usbd_get_recv_len(pudev, ept_num);
 
-  /* hid iap process */
-  usbd_hid_iap_process(udev, piap->g_rxhid_buff, recv_len);
-
-  /* start receive next packet */
-  usbd_ept_recv(pudev, USBD_HIDIAP_OUT_EPT, piap->g_rxhid_buff, USBD_HIDIAP_OUT_MAXPACKET_SIZE);
+  /* hid iap process, IAP_WAIT keeps the report in the buffer and the
+     endpoint nak until usb_iap_class_recv_resume is called */
+  if(usbd_hid_iap_process(udev, piap->g_rxhid_buff, recv_len) != IAP_WAIT)
+  {
+    /* start receive next packet */
+    usbd_ept_recv(pudev, USBD_HIDIAP_OUT_EPT, piap->g_rxhid_buff, USBD_HIDIAP_OUT_MAXPACKET_SIZE);
+  }
 
   return status;
 }
@@ -333,6 +335,19 @@ usb_sts_type usb_iap_class_send_report(void *udev, uint8_t *report, uint16_t len
   return status;
 }
 
+/**
+  * @brief  usb device class restart receive after a report was held with IAP_WAIT
+  * @param  udev: to the structure of usbd_core_type
+  * @retval none
+  */
+void usb_iap_class_recv_resume(void *udev)
+{
+  usbd_core_type *pudev = (usbd_core_type *)udev;
+  iap_info_type *piap = (iap_info_type *)pudev->class_handler->pdata;
+
+  usbd_ept_recv(pudev, USBD_HIDIAP_OUT_EPT, piap->g_rxhid_buff, USBD_HIDIAP_OUT_MAXPACKET_SIZE);
+}
+
 /**
   * @}
   */
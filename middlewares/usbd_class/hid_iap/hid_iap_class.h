@@ -72,6 +72,9 @@ extern "C" {
 #define IAP_CMD_CRC                      0x5AA5
 #define IAP_CMD_JMP                      0x5AA6
 #define IAP_CMD_GET                      0x5AA7
+#define IAP_CMD_WSTART                   0x5AA8
+#define IAP_CMD_WDATA                    0x5AA9
+#define IAP_CMD_WFLUSH                   0x5AAA
 
 #define HID_IAP_BUFFER_LEN               1024
 #define IAP_UPGRADE_COMPLETE_FLAG        0x41544B38
@@ -98,6 +101,7 @@ typedef enum
   IAP_STS_CRC,
   IAP_STS_JMP_WAIT,
   IAP_STS_JMP,
+  IAP_STS_WINDOW,
 }iap_machine_state_type;
 
 typedef struct
@@ -135,6 +139,7 @@ typedef struct
 extern usbd_class_handler hid_iap_class_handler;
 extern iap_info_type iap_info;
 usb_sts_type usb_iap_class_send_report(void *udev, uint8_t *report, uint16_t len);
+void usb_iap_class_recv_resume(void *udev);
 iap_result_type usbd_hid_iap_process(void *udev, uint8_t *report, uint16_t len);
 void usbd_hid_iap_in_complete(void *udev);
 
@@ -38,6 +38,8 @@
   * @{
   */
 
+static uint32_t bot_scsi_get_blk_len(uint8_t *cmd);
+
 
 #if defined ( __ICCARM__ ) /* iar compiler */
   #pragma data_alignment=4
@@ -104,11 +106,17 @@ void bot_scsi_init(void *udev)
 {
   usbd_core_type *pudev = (usbd_core_type *)udev;
   msc_type *pmsc = (msc_type *)pudev->class_handler->pdata;
+  uint8_t lun;
   pmsc->msc_state = MSC_STATE_MACHINE_IDLE;
   pmsc->bot_status = MSC_BOT_STATE_IDLE;
   pmsc->max_lun = MSC_SUPPORT_MAX_LUN - 1;
   pmsc->scsi_medium_state = SCSI_MEDIUM_UNLOCKED;
 
+  for(lun = 0; lun < MSC_SUPPORT_MAX_LUN; lun ++)
+  {
+    msc_media_ops[lun]->init();
+  }
+
   pmsc->csw_struct.dCSWSignature = CSW_DCSWSIGNATURE;
   pmsc->csw_struct.dCSWDataResidue = 0;
   pmsc->csw_struct.dCSWSignature = 0;
@@ -208,7 +216,7 @@ void bot_cbw_decode(void *udev)
   /* check param */
   if((pmsc->cbw_struct.dCBWSignature != CBW_DCBWSIGNATURE) ||
     (usbd_get_recv_len(pudev, USBD_MSC_BULK_OUT_EPT) != CBW_CMD_LENGTH)
-    || (pmsc->cbw_struct.bCBWLUN > MSC_SUPPORT_MAX_LUN) ||
+    || (pmsc->cbw_struct.bCBWLUN > pmsc->max_lun) ||
       (pmsc->cbw_struct.bCBWCBLength < 1) || (pmsc->cbw_struct.bCBWCBLength > 16))
   {
     bot_scsi_sense_code(udev, SENSE_KEY_ILLEGAL_REQUEST, INVALID_COMMAND);
@@ -315,7 +323,10 @@ usb_sts_type bot_scsi_check_address(void *udev, uint8_t lun, uint32_t blk_offset
 {
   usbd_core_type *pudev = (usbd_core_type *)udev;
   msc_type *pmsc = (msc_type *)pudev->class_handler->pdata;
-  if((blk_offset + blk_count) > pmsc->blk_nbr[lun])
+
+  /* no wrap of the block range, the byte length of the transfer must fit 32 bits */
+  if(blk_offset >= pmsc->blk_nbr[lun] || blk_count > pmsc->blk_nbr[lun] - blk_offset ||
+     blk_count > 0xFFFFFFFF / pmsc->blk_size[lun])
   {
     bot_scsi_sense_code(udev, SENSE_KEY_ILLEGAL_REQUEST, ADDRESS_OUT_OF_RANGE);
     return USB_FAIL;
@@ -366,7 +377,8 @@ usb_sts_type bot_scsi_test_unit(void *udev, uint8_t lun)
     return USB_FAIL;
   }
   
-  if(pmsc->scsi_medium_state == SCSI_MEDIUM_EJECTED)
+  if(pmsc->scsi_medium_state == SCSI_MEDIUM_EJECTED ||
+     msc_media_ops[lun]->ready() != USB_OK)
   {
     bot_scsi_sense_code(udev, SENSE_KEY_NOT_READY, MEDIUM_NOT_PRESENT);
     pmsc->msc_state = MSC_STATE_MACHINE_NO_DATA;
@@ -385,7 +397,7 @@ usb_sts_type bot_scsi_test_unit(void *udev, uint8_t lun)
   */
 usb_sts_type bot_scsi_inquiry(void *udev, uint8_t lun)
 {
-  uint8_t *pdata;
+  const uint8_t *pdata;
   uint32_t trans_len = 0;
   usb_sts_type status = USB_OK;
   usbd_core_type *pudev = (usbd_core_type *)udev;
@@ -398,7 +410,7 @@ usb_sts_type bot_scsi_inquiry(void *udev, uint8_t lun)
   }
   else
   {
-    pdata = get_inquiry(lun);
+    pdata = msc_media_ops[lun]->inquiry;
     if(pmsc->cbw_struct.dCBWDataTransferLength < SCSI_INQUIRY_DATA_LENGTH)
     {
       trans_len = pmsc->cbw_struct.dCBWDataTransferLength;
@@ -530,9 +542,8 @@ usb_sts_type bot_scsi_capacity(void *udev, uint8_t lun)
   usbd_core_type *pudev = (usbd_core_type *)udev;
   msc_type *pmsc = (msc_type *)pudev->class_handler->pdata;
   uint8_t *pdata = pmsc->data;
-  msc_disk_capacity(lun, &pmsc->blk_nbr[lun], &pmsc->blk_size[lun]);
-  
-  if(pmsc->scsi_medium_state == SCSI_MEDIUM_EJECTED)
+  if(pmsc->scsi_medium_state == SCSI_MEDIUM_EJECTED ||
+     msc_media_ops[lun]->capacity(&pmsc->blk_nbr[lun], &pmsc->blk_size[lun]) != USB_OK)
   {
     bot_scsi_sense_code(udev, SENSE_KEY_NOT_READY, MEDIUM_NOT_PRESENT);
     return USB_FAIL;
@@ -569,9 +580,8 @@ usb_sts_type bot_scsi_format_capacity(void *udev, uint8_t lun)
   pdata[2] = 0;
   pdata[3] = 0x08;
 
-  msc_disk_capacity(lun, &pmsc->blk_nbr[lun], &pmsc->blk_size[lun]);
-  
-  if(pmsc->scsi_medium_state == SCSI_MEDIUM_EJECTED)
+  if(pmsc->scsi_medium_state == SCSI_MEDIUM_EJECTED ||
+     msc_media_ops[lun]->capacity(&pmsc->blk_nbr[lun], &pmsc->blk_size[lun]) != USB_OK)
   {
     bot_scsi_sense_code(udev, SENSE_KEY_NOT_READY, MEDIUM_NOT_PRESENT);
     return USB_FAIL;
@@ -631,7 +641,23 @@ usb_sts_type bot_scsi_request_sense(void *udev, uint8_t lun)
 }
 
 /**
-  * @brief  bulk-only transport scsi command verify
+  * @brief  get the transfer length in blocks of a read/write command
+  * @param  cmd: command block
+  * @retval number of blocks
+  */
+static uint32_t bot_scsi_get_blk_len(uint8_t *cmd)
+{
+  if(cmd[0] == MSC_CMD_READ_12 || cmd[0] == MSC_CMD_WRITE_12)
+  {
+    return (uint32_t)cmd[6] << 24 | cmd[7] << 16 | cmd[8] << 8 | cmd[9];
+  }
+  return cmd[7] << 8 | cmd[8];
+}
+
+/**
+  * @brief  bulk-only transport scsi command verify. without bytchk every
+  *         block of the range is read back from the medium, with bytchk
+  *         the data sent by the host is compared with the medium.
   * @param  udev: to the structure of usbd_core_type
   * @param  lun: logical units number
   * @retval status of usb_sts_type
@@ -641,20 +667,92 @@ usb_sts_type bot_scsi_verify(void *udev, uint8_t lun)
   usbd_core_type *pudev = (usbd_core_type *)udev;
   msc_type *pmsc = (msc_type *)pudev->class_handler->pdata;
   uint8_t *cmd = pmsc->cbw_struct.CBWCB;
-  if((pmsc->cbw_struct.CBWCB[1] & 0x02) == 0x02)
+  uint8_t medium_buf[64];
+  uint32_t len, offset, i_index, cmp_len;
+
+  if(pmsc->msc_state == MSC_STATE_MACHINE_IDLE)
   {
-    bot_scsi_sense_code(udev, SENSE_KEY_ILLEGAL_REQUEST, INVALID_FIELED_IN_COMMAND);
-    return USB_FAIL;
+    pmsc->blk_addr = cmd[2] << 24 | cmd[3] << 16 | cmd[4] << 8 | cmd[5];
+    pmsc->blk_len = cmd[7] << 8 | cmd[8];
+
+    if(bot_scsi_check_address(udev, lun, pmsc->blk_addr, pmsc->blk_len) != USB_OK)
+    {
+      return USB_FAIL;
+    }
+
+    pmsc->blk_addr *= pmsc->blk_size[lun];
+    pmsc->blk_len *= pmsc->blk_size[lun];
+
+    if((cmd[1] & 0x02) == 0x02)
+    {
+      /* bytchk, the host sends the data to compare */
+      if(pmsc->cbw_struct.dCBWDataTransferLength != pmsc->blk_len)
+      {
+        bot_scsi_sense_code(udev, SENSE_KEY_ILLEGAL_REQUEST, INVALID_FIELED_IN_COMMAND);
+        return USB_FAIL;
+      }
+
+      /* verification length 0, no data phase follows, the csw is sent now */
+      if(pmsc->blk_len == 0)
+      {
+        pmsc->data_len = 0;
+        return USB_OK;
+      }
+      pmsc->msc_state = MSC_STATE_MACHINE_DATA_OUT;
+      len = MIN(pmsc->blk_len, MSC_MAX_DATA_BUF_LEN);
+      usbd_ept_recv(pudev, USBD_MSC_BULK_OUT_EPT, (uint8_t *)pmsc->data, len);
+      return USB_OK;
+    }
+
+    /* medium verification, read every block of the range */
+    while(pmsc->blk_len)
+    {
+      len = MIN(pmsc->blk_len, MSC_MAX_DATA_BUF_LEN);
+      if(msc_media_ops[lun]->read(pmsc->blk_addr, pmsc->data, len) != USB_OK)
+      {
+        bot_scsi_sense_code(udev, SENSE_KEY_MEDIUM_ERROR, MEDIUM_NOT_PRESENT);
+        return USB_FAIL;
+      }
+      pmsc->blk_addr += len;
+      pmsc->blk_len -= len;
+    }
+    pmsc->data_len = 0;
+    return USB_OK;
+  }
+
+  /* compare the received data with the medium */
+  len = MIN(pmsc->blk_len, MSC_MAX_DATA_BUF_LEN);
+  for(offset = 0; offset < len; offset += cmp_len)
+  {
+    cmp_len = MIN(len - offset, sizeof(medium_buf));
+    if(msc_media_ops[lun]->read(pmsc->blk_addr + offset, medium_buf, cmp_len) != USB_OK)
+    {
+      bot_scsi_sense_code(udev, SENSE_KEY_MEDIUM_ERROR, MEDIUM_NOT_PRESENT);
+      return USB_FAIL;
+    }
+    for(i_index = 0; i_index < cmp_len; i_index ++)
+    {
+      if(medium_buf[i_index] != pmsc->data[offset + i_index])
+      {
+        bot_scsi_sense_code(udev, SENSE_KEY_MISCOMPARE, 0x1D);
+        return USB_FAIL;
+      }
+    }
   }
 
-  pmsc->blk_addr = cmd[2] << 24 | cmd[3] << 16 | cmd[4] << 8 | cmd[5];
-  pmsc->blk_len = cmd[7] << 8 | cmd[8];
+  pmsc->blk_addr += len;
+  pmsc->blk_len -= len;
+  pmsc->csw_struct.dCSWDataResidue -= len;
 
-  if(bot_scsi_check_address(udev, lun, pmsc->blk_addr, pmsc->blk_len) != USB_OK)
+  if(pmsc->blk_len == 0)
   {
-    return USB_FAIL;
+    bot_scsi_send_csw(udev, CSW_BCSWSTATUS_PASS);
+  }
+  else
+  {
+    len = MIN(pmsc->blk_len, MSC_MAX_DATA_BUF_LEN);
+    usbd_ept_recv(pudev, USBD_MSC_BULK_OUT_EPT, (uint8_t *)pmsc->data, len);
   }
-  pmsc->data_len = 0;
   return USB_OK;
 }
 
@@ -669,6 +767,7 @@ usb_sts_type bot_scsi_read10(void *udev, uint8_t lun)
   usbd_core_type *pudev = (usbd_core_type *)udev;
   msc_type *pmsc = (msc_type *)pudev->class_handler->pdata;
   uint8_t *cmd = pmsc->cbw_struct.CBWCB;
+  uint8_t *pdata = pmsc->data;
   uint32_t len;
 
   if(pmsc->msc_state == MSC_STATE_MACHINE_IDLE)
@@ -684,7 +783,7 @@ usb_sts_type bot_scsi_read10(void *udev, uint8_t lun)
       return USB_FAIL;
     }
     pmsc->blk_addr = cmd[2] << 24 | cmd[3] << 16 | cmd[4] << 8 | cmd[5];
-    pmsc->blk_len = cmd[7] << 8 | cmd[8];
+    pmsc->blk_len = bot_scsi_get_blk_len(cmd);
 
     if(bot_scsi_check_address(udev, lun, pmsc->blk_addr, pmsc->blk_len) != USB_OK)
     {
@@ -703,13 +802,31 @@ usb_sts_type bot_scsi_read10(void *udev, uint8_t lun)
   }
   pmsc->data_len = MSC_MAX_DATA_BUF_LEN;
 
-  len = MIN(pmsc->blk_len, MSC_MAX_DATA_BUF_LEN);
-  if( msc_disk_read(lun, pmsc->blk_addr, pmsc->data, len) != USB_OK)
+  /* memory mapped medium, send straight from its address */
+  if(msc_media_ops[lun]->xip_addr != NULL)
   {
-    bot_scsi_sense_code(udev, SENSE_KEY_HARDWARE_ERROR, MEDIUM_NOT_PRESENT);
-    return USB_FAIL;
+    len = MIN(pmsc->blk_len, MSC_XIP_MAX_LEN);
+    pdata = msc_media_ops[lun]->xip_addr(pmsc->blk_addr, len);
+    if(pdata == NULL)
+    {
+      pdata = pmsc->data;
+    }
+    else
+    {
+      usbd_ept_send(pudev, USBD_MSC_BULK_IN_EPT, pdata, len);
+    }
+  }
+
+  if(pdata == pmsc->data)
+  {
+    len = MIN(pmsc->blk_len, MSC_MAX_DATA_BUF_LEN);
+    if(msc_media_ops[lun]->read(pmsc->blk_addr, pmsc->data, len) != USB_OK)
+    {
+      bot_scsi_sense_code(udev, SENSE_KEY_HARDWARE_ERROR, MEDIUM_NOT_PRESENT);
+      return USB_FAIL;
+    }
+    usbd_ept_send(pudev, USBD_MSC_BULK_IN_EPT, pmsc->data, len);
   }
-  usbd_ept_send(pudev, USBD_MSC_BULK_IN_EPT, pmsc->data, len);
   pmsc->blk_addr += len;
   pmsc->blk_len -= len;
 
@@ -745,7 +862,7 @@ usb_sts_type bot_scsi_write10(void *udev, uint8_t lun)
     }
 
     pmsc->blk_addr = cmd[2] << 24 | cmd[3] << 16 | cmd[4] << 8 | cmd[5];
-    pmsc->blk_len = cmd[7] << 8 | cmd[8];
+    pmsc->blk_len = bot_scsi_get_blk_len(cmd);
 
     if(bot_scsi_check_address(udev, lun, pmsc->blk_addr, pmsc->blk_len) != USB_OK)
     {
@@ -769,7 +886,7 @@ usb_sts_type bot_scsi_write10(void *udev, uint8_t lun)
   else
   {
     len = MIN(pmsc->blk_len, MSC_MAX_DATA_BUF_LEN);
-    if(msc_disk_write(lun, pmsc->blk_addr, pmsc->data, len) != USB_OK)
+    if(msc_media_ops[lun]->write(pmsc->blk_addr, pmsc->data, len) != USB_OK)
     {
       bot_scsi_sense_code(udev, SENSE_KEY_HARDWARE_ERROR, MEDIUM_NOT_PRESENT);
       return USB_FAIL;
@@ -793,6 +910,30 @@ usb_sts_type bot_scsi_write10(void *udev, uint8_t lun)
   return USB_OK;
 }
 
+/**
+  * @brief  bulk-only transport scsi command read12
+  * @param  udev: to the structure of usbd_core_type
+  * @param  lun: logical units number
+  * @retval status of usb_sts_type
+  */
+usb_sts_type bot_scsi_read12(void *udev, uint8_t lun)
+{
+  /* same data phase as read10, only the length field differs */
+  return bot_scsi_read10(udev, lun);
+}
+
+/**
+  * @brief  bulk-only transport scsi command write12
+  * @param  udev: to the structure of usbd_core_type
+  * @param  lun: logical units number
+  * @retval status of usb_sts_type
+  */
+usb_sts_type bot_scsi_write12(void *udev, uint8_t lun)
+{
+  /* same data phase as write10, only the length field differs */
+  return bot_scsi_write10(udev, lun);
+}
+
 /**
   * @brief  clear feature
   * @param  udev: to the structure of usbd_core_type
@@ -850,6 +991,14 @@ usb_sts_type bot_scsi_cmd_process(void *udev)
       status = bot_scsi_read10(udev, pmsc->cbw_struct.bCBWLUN);
       break;
 
+    case MSC_CMD_READ_12:
+      status = bot_scsi_read12(udev, pmsc->cbw_struct.bCBWLUN);
+      break;
+
+    case MSC_CMD_WRITE_12:
+      status = bot_scsi_write12(udev, pmsc->cbw_struct.bCBWLUN);
+      break;
+
     case MSC_CMD_READ_CAPACITY:
       status = bot_scsi_capacity(udev, pmsc->cbw_struct.bCBWLUN);
       break;
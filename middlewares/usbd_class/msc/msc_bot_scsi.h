@@ -45,9 +45,20 @@ extern "C" {
   * @{
   */
 
+/**
+  * @brief number of logical units, can be overridden in usb_conf.h
+  */
+#ifndef MSC_SUPPORT_MAX_LUN
 #define MSC_SUPPORT_MAX_LUN              1
+#endif
 #define MSC_MAX_DATA_BUF_LEN             4096
 
+/**
+  * @brief largest read sent straight from a memory mapped medium, see the
+  *        xip_addr member of msc_media_ops_type
+  */
+#define MSC_XIP_MAX_LEN                  0x8000
+
 #define MSC_CMD_FORMAT_UNIT              0x04
 #define MSC_CMD_INQUIRY                  0x12
 #define MSC_CMD_START_STOP               0x1B
@@ -193,6 +204,26 @@ typedef struct
   uint32_t reserved3;
 }sense_type;
 
+/**
+  * @brief media operations of one logical unit, msc_diskio provides the
+  *        msc_media_ops table with one entry for each lun and the scsi
+  *        layer dispatches every medium access through it.
+  *        xip_addr may be null, otherwise it returns the memory mapped
+  *        address of a range, or null when the range must be read with read
+  */
+typedef struct
+{
+  usb_sts_type (*init)(void);
+  usb_sts_type (*ready)(void);
+  usb_sts_type (*capacity)(uint32_t *blk_nbr, uint32_t *blk_size);
+  usb_sts_type (*read)(uint64_t addr, uint8_t *buf, uint32_t len);
+  usb_sts_type (*write)(uint64_t addr, uint8_t *buf, uint32_t len);
+  uint8_t *(*xip_addr)(uint64_t addr, uint32_t len);
+  const uint8_t *inquiry;
+}msc_media_ops_type;
+
+extern const msc_media_ops_type *const msc_media_ops[MSC_SUPPORT_MAX_LUN];
+
 
 typedef struct
 {
@@ -242,6 +273,8 @@ usb_sts_type bot_scsi_format_capacity(void *udev, uint8_t lun);
 usb_sts_type bot_scsi_request_sense(void *udev, uint8_t lun);
 usb_sts_type bot_scsi_verify(void *udev, uint8_t lun);
 usb_sts_type bot_scsi_write10(void *udev, uint8_t lun);
+usb_sts_type bot_scsi_read12(void *udev, uint8_t lun);
+usb_sts_type bot_scsi_write12(void *udev, uint8_t lun);
 void bot_scsi_clear_feature(void *udev, uint8_t ept_num);
 
 /**
@@ -49,6 +49,9 @@ static usb_sts_type class_out_handler(void *udev, uint8_t ept_num);
 static usb_sts_type class_sof_handler(void *udev);
 static usb_sts_type class_event_handler(void *udev, usbd_event_type event);
 
+static void printer_rx_release(usbd_core_type *pudev, uint16_t slots);
+static void printer_sink_kick(usbd_core_type *pudev);
+
 ALIGNED_HEAD static uint8_t printer_device_id[PRINTER_DEVICE_ID_LEN] ALIGNED_TAIL=
 {
   0x00, 0x16,
@@ -91,11 +94,18 @@ static usb_sts_type class_init_handler(void *udev)
   /* open out endpoint */
   usbd_ept_open(pudev, USBD_PRINTER_BULK_OUT_EPT, EPT_BULK_TYPE, USBD_PRINTER_OUT_MAXPACKET_SIZE);
 
+  pprter->rx_wr_slot = 0;
+  pprter->rx_rd_slot = 0;
+  pprter->rx_slot_count = 0;
+  pprter->sink_slots = 0;
+  pprter->rx_pause = 0;
+  pprter->sink_stall = 0;
+
   /* set out endpoint to receive status */
-  usbd_ept_recv(pudev, USBD_PRINTER_BULK_OUT_EPT, pprter->g_rx_buff, USBD_PRINTER_OUT_MAXPACKET_SIZE);
+  usbd_ept_recv(pudev, USBD_PRINTER_BULK_OUT_EPT, pprter->g_rx_ring, USBD_PRINTER_OUT_MAXPACKET_SIZE);
 
   pprter->g_tx_completed = 1;
-  pprter->g_printer_port_status = 0x18;
+  pprter->g_printer_port_status = PRINTER_PORT_STATUS_SELECT | PRINTER_PORT_STATUS_NOT_ERROR;
 
   return status;
 }
@@ -141,6 +151,21 @@ static usb_sts_type class_setup_handler(void *udev, usb_setup_type *setup)
           usbd_ctrl_send(pudev, printer_device_id, PRINTER_DEVICE_ID_LEN);
           break;
         case PRINTER_REQ_GET_PORT_STATUS:
+          /* report the real state of the sink */
+          if(pprter->sink != NULL)
+          {
+            pprter->g_printer_port_status = PRINTER_PORT_STATUS_SELECT | PRINTER_PORT_STATUS_NOT_ERROR;
+            if(pprter->sink->get_port_status != NULL)
+            {
+              pprter->g_printer_port_status = pprter->sink->get_port_status();
+            }
+
+            /* a sink that refuses data is busy, report it not selected */
+            if(pprter->sink_stall)
+            {
+              pprter->g_printer_port_status &= ~PRINTER_PORT_STATUS_SELECT;
+            }
+          }
           usbd_ctrl_send(pudev, (uint8_t *)&pprter->g_printer_port_status, 1);
           break;
         case PRINTER_REQ_GET_SOFT_RESET:
@@ -240,12 +265,31 @@ static usb_sts_type class_out_handler(void *udev, uint8_t ept_num)
   usb_sts_type status = USB_OK;
   usbd_core_type *pudev = (usbd_core_type *)udev;
   printer_type *pprter = (printer_type *)pudev->class_handler->pdata;
-  
+  uint32_t primask;
+
   /* get endpoint receive data length  */
-  pprter->g_rxlen = usbd_get_recv_len(pudev, ept_num);
+  pprter->g_slot_len[pprter->rx_wr_slot] = (uint8_t)usbd_get_recv_len(pudev, ept_num);
+  pprter->rx_wr_slot = (pprter->rx_wr_slot + 1) % PRINTER_RX_SLOT_NUM;
 
-  /*set recv flag*/
-   pprter->g_rx_completed = 1;
+  primask = __get_PRIMASK();
+  __disable_irq();
+  pprter->rx_slot_count ++;
+
+  if(pprter->rx_slot_count < PRINTER_RX_HIGH_WATER)
+  {
+    /* keep streaming into the next free slot */
+    usbd_ept_recv(pudev, USBD_PRINTER_BULK_OUT_EPT,
+                  &pprter->g_rx_ring[pprter->rx_wr_slot * USBD_PRINTER_OUT_MAXPACKET_SIZE],
+                  USBD_PRINTER_OUT_MAXPACKET_SIZE);
+  }
+  else
+  {
+    /* ring at the high water mark, keep the endpoint nak until the sink releases a slot */
+    pprter->rx_pause = 1;
+  }
+  __set_PRIMASK(primask);
+
+  printer_sink_kick(pudev);
 
   return status;
 }
@@ -258,8 +302,14 @@ static usb_sts_type class_out_handler(void *udev, uint8_t ept_num)
 static usb_sts_type class_sof_handler(void *udev)
 {
   usb_sts_type status = USB_OK;
+  usbd_core_type *pudev = (usbd_core_type *)udev;
+  printer_type *pprter = (printer_type *)pudev->class_handler->pdata;
 
-  /* ...user code... */
+  /* retry a run the sink refused, no out packet or completion may follow */
+  if(pprter->sink_stall)
+  {
+    printer_sink_kick(pudev);
+  }
 
   return status;
 }
@@ -301,7 +351,136 @@ static usb_sts_type class_event_handler(void *udev, usbd_event_type event)
 }
 
 /**
-  * @brief  usb device class rx data process
+  * @brief  release consumed slots and resume the out endpoint if it was paused
+  * @param  pudev: to the structure of usbd_core_type
+  * @param  slots: number of slots to release
+  * @retval none
+  */
+static void printer_rx_release(usbd_core_type *pudev, uint16_t slots)
+{
+  printer_type *pprter = (printer_type *)pudev->class_handler->pdata;
+  uint32_t primask;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  pprter->rx_rd_slot = (pprter->rx_rd_slot + slots) % PRINTER_RX_SLOT_NUM;
+  pprter->rx_slot_count -= slots;
+
+  if(pprter->rx_pause && pprter->rx_slot_count < PRINTER_RX_HIGH_WATER)
+  {
+    pprter->rx_pause = 0;
+    usbd_ept_recv(pudev, USBD_PRINTER_BULK_OUT_EPT,
+                  &pprter->g_rx_ring[pprter->rx_wr_slot * USBD_PRINTER_OUT_MAXPACKET_SIZE],
+                  USBD_PRINTER_OUT_MAXPACKET_SIZE);
+  }
+  __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  hand the longest contiguous run of received data to the sink.
+  *         full slots are contiguous in the ring, a run ends at a short
+  *         packet or at the end of the ring.
+  * @param  pudev: to the structure of usbd_core_type
+  * @retval none
+  */
+static void printer_sink_kick(usbd_core_type *pudev)
+{
+  printer_type *pprter = (printer_type *)pudev->class_handler->pdata;
+  uint32_t primask, len;
+  uint16_t slots, avail;
+  uint8_t *data, slot_len;
+
+  if(pprter->sink == NULL)
+  {
+    return;
+  }
+
+  while(1)
+  {
+    primask = __get_PRIMASK();
+    __disable_irq();
+    avail = pprter->rx_slot_count;
+    if(pprter->sink_slots != 0 || avail == 0)
+    {
+      __set_PRIMASK(primask);
+      return;
+    }
+
+    len = 0;
+    slots = 0;
+    while(slots < avail && pprter->rx_rd_slot + slots < PRINTER_RX_SLOT_NUM)
+    {
+      slot_len = pprter->g_slot_len[pprter->rx_rd_slot + slots];
+      len += slot_len;
+      slots ++;
+      if(slot_len < USBD_PRINTER_OUT_MAXPACKET_SIZE)
+      {
+        break;
+      }
+    }
+    pprter->sink_slots = slots;
+    data = &pprter->g_rx_ring[pprter->rx_rd_slot * USBD_PRINTER_OUT_MAXPACKET_SIZE];
+    __set_PRIMASK(primask);
+
+    if(len == 0)
+    {
+      /* zero length packets carry no data */
+      pprter->sink_slots = 0;
+      printer_rx_release(pudev, slots);
+    }
+    else if(pprter->sink->start(data, len) != SUCCESS)
+    {
+      /* sink is not ready, retry on the next sof */
+      pprter->sink_slots = 0;
+      pprter->sink_stall = 1;
+      return;
+    }
+    else
+    {
+      pprter->sink_stall = 0;
+      return;
+    }
+  }
+}
+
+/**
+  * @brief  usb device class register the data sink. with a sink the print
+  *         data is streamed to it, without a sink use usb_printer_get_rxdata
+  * @param  udev: to the structure of usbd_core_type
+  * @param  sink: data sink, null to return to polled mode
+  * @retval none
+  */
+void usb_printer_set_sink(void *udev, printer_sink_type *sink)
+{
+  usbd_core_type *pudev = (usbd_core_type *)udev;
+  printer_type *pprter = (printer_type *)pudev->class_handler->pdata;
+
+  pprter->sink = sink;
+  pprter->sink_stall = 0;
+  printer_sink_kick(pudev);
+}
+
+/**
+  * @brief  usb device class sink complete, called by the sink (usually from
+  *         its dma interrupt) when the data given to start has been consumed
+  * @param  udev: to the structure of usbd_core_type
+  * @retval none
+  */
+void usb_printer_sink_complete(void *udev)
+{
+  usbd_core_type *pudev = (usbd_core_type *)udev;
+  printer_type *pprter = (printer_type *)pudev->class_handler->pdata;
+  uint16_t slots = pprter->sink_slots;
+
+  printer_rx_release(pudev, slots);
+  pprter->sink_slots = 0;
+
+  /* start the next run */
+  printer_sink_kick(pudev);
+}
+
+/**
+  * @brief  usb device class rx data process, polled mode without a sink
   * @param  udev: to the structure of usbd_core_type
   * @param  recv_data: receive buffer
   * @retval receive data len
@@ -310,21 +489,23 @@ uint16_t usb_printer_get_rxdata(void *udev, uint8_t *recv_data)
 {
   uint16_t i_index = 0;
   uint16_t tmp_len = 0;
+  uint8_t *slot;
   usbd_core_type *pudev = (usbd_core_type *)udev;
   printer_type *pprter = (printer_type *)pudev->class_handler->pdata;
 
-  if(pprter->g_rx_completed == 0)
+  if(pprter->sink != NULL || pprter->rx_slot_count == 0)
   {
     return 0;
   }
-  pprter->g_rx_completed = 0;
-  tmp_len = pprter->g_rxlen;
-  for(i_index = 0; i_index < pprter->g_rxlen; i_index ++)
+
+  tmp_len = pprter->g_slot_len[pprter->rx_rd_slot];
+  slot = &pprter->g_rx_ring[pprter->rx_rd_slot * USBD_PRINTER_OUT_MAXPACKET_SIZE];
+  for(i_index = 0; i_index < tmp_len; i_index ++)
   {
-    recv_data[i_index] = pprter->g_rx_buff[i_index];
+    recv_data[i_index] = slot[i_index];
   }
 
-  usbd_ept_recv(pudev, USBD_PRINTER_BULK_OUT_EPT, pprter->g_rx_buff, USBD_PRINTER_OUT_MAXPACKET_SIZE);
+  printer_rx_release(pudev, 1);
 
   return tmp_len;
 }
@@ -55,6 +55,29 @@ extern "C" {
 
 #define PRINTER_DEVICE_ID_LEN            24
 
+/**
+  * @brief usb printer receive ring size in bytes, must be a multiple of
+  *        USBD_PRINTER_OUT_MAXPACKET_SIZE, can be overridden in usb_conf.h
+  */
+#ifndef PRINTER_RX_RING_SIZE
+#define PRINTER_RX_RING_SIZE             2048
+#endif
+#define PRINTER_RX_SLOT_NUM              (PRINTER_RX_RING_SIZE / USBD_PRINTER_OUT_MAXPACKET_SIZE)
+
+/**
+  * @brief usb printer out endpoint naks when this many slots are in use,
+  *        the slot count tells a full ring from an empty one, so every
+  *        slot of the ring is used
+  */
+#define PRINTER_RX_HIGH_WATER            PRINTER_RX_SLOT_NUM
+
+/**
+  * @brief usb printer port status bits
+  */
+#define PRINTER_PORT_STATUS_PAPER_EMPTY  0x20
+#define PRINTER_PORT_STATUS_SELECT       0x10
+#define PRINTER_PORT_STATUS_NOT_ERROR    0x08
+
 typedef enum
 {
   PRINTER_REQ_GET_DEVICE_ID               = 0x00,
@@ -63,20 +86,38 @@ typedef enum
 }printer_req_type;
 
 
+/**
+  * @brief usb printer data sink, consumes the print data stream
+  */
+typedef struct
+{
+  error_status (*start)(uint8_t *data, uint32_t len);              /*!< start consuming len bytes, usb_printer_sink_complete must be
+                                                                        called when done, return ERROR if the sink cannot accept data */
+  uint8_t (*get_port_status)(void);                                /*!< return printer port status bits, null for default */
+}printer_sink_type;
+
 typedef struct
 {
   uint32_t alt_setting;
   uint32_t g_printer_port_status;
-  uint8_t g_rx_buff[USBD_PRINTER_OUT_MAXPACKET_SIZE];
+  uint8_t g_rx_ring[PRINTER_RX_RING_SIZE];                         /*!< out data ring, one max packet slot per transfer */
+  uint8_t g_slot_len[PRINTER_RX_SLOT_NUM];                         /*!< received length of each slot */
   uint8_t g_printer_data[USBD_PRINTER_OUT_MAXPACKET_SIZE];
-  uint32_t g_rxlen;
+  printer_sink_type *sink;                                         /*!< registered data sink, null for polled mode */
+  uint16_t rx_wr_slot;                                             /*!< slot armed for out endpoint */
+  uint16_t rx_rd_slot;                                             /*!< oldest slot not yet consumed */
+  __IO uint16_t rx_slot_count;                                     /*!< slots received and not yet released */
+  __IO uint16_t sink_slots;                                        /*!< slots handed to the sink */
+  __IO uint8_t rx_pause;                                           /*!< out endpoint left nak because the ring is full */
+  __IO uint8_t sink_stall;                                         /*!< sink refused the last run, retried on sof */
   __IO uint8_t g_tx_completed;
-  __IO uint8_t g_rx_completed;
 }printer_type;
 
 extern usbd_class_handler printer_class_handler;
 uint16_t usb_printer_get_rxdata(void *udev, uint8_t *recv_data);
 error_status usb_printer_send_data(void *udev, uint8_t *send_data, uint16_t len);
+void usb_printer_set_sink(void *udev, printer_sink_type *sink);
+void usb_printer_sink_complete(void *udev);
 /**
   * @}
   */
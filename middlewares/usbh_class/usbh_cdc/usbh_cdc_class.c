@@ -50,6 +50,8 @@ static usb_sts_type set_linecoding(usbh_core_type *uhost, cdc_line_coding_type *
 
 static void cdc_process_transmission(usbh_core_type *uhost);
 static void cdc_process_reception(usbh_core_type *uhost);
+static void cdc_stream_transmission(usbh_core_type *uhost);
+static void cdc_stream_reception(usbh_core_type *uhost);
 usbh_cdc_type usbh_cdc;
 
 usbh_class_handler_type uhost_cdc_class_handler =
@@ -345,8 +347,16 @@ static usb_sts_type uhost_process_handler(void *uhost)
     break;
     
     case CDC_TRANSFER_DATA:
-      cdc_process_transmission(puhost);
-      cdc_process_reception(puhost);   
+      if(pcdc->stream_enable)
+      {
+        cdc_stream_transmission(puhost);
+        cdc_stream_reception(puhost);
+      }
+      else
+      {
+        cdc_process_transmission(puhost);
+        cdc_process_reception(puhost);
+      }
     break;
     
     case CDC_ERROR_STATE:
@@ -518,6 +528,263 @@ __WEAK void cdc_receive_complete(usbh_core_type *uhost)
   
 }
 
+/**
+  * @brief  usb host cdc class stream transmission handler, send the oldest
+  *         queued bytes (up to one max packet) and start the next packet as
+  *         soon as the previous one is acknowledged
+  * @param  uhost: to the structure of usbh_core_type
+  * @retval none
+  */
+static void cdc_stream_transmission(usbh_core_type *uhost)
+{
+  usbh_cdc_type *pcdc = (usbh_cdc_type *)uhost->class_handler->pdata;
+  uint8_t hc_num = pcdc->data_interface.out_channel;
+  uint32_t len;
+
+  if(pcdc->data_tx_state == CDC_SEND_DATA_WAIT)
+  {
+    if(uhost->urb_state[hc_num] == URB_DONE)
+    {
+      /* packet acknowledged, release it from the queue */
+      pcdc->tx_rd = (pcdc->tx_rd + pcdc->tx_inflight) % USBH_CDC_TX_RING_SIZE;
+      pcdc->tx_count -= pcdc->tx_inflight;
+      pcdc->tx_inflight = 0;
+      pcdc->data_tx_state = CDC_IDLE;
+    }
+    else if(uhost->urb_state[hc_num] == URB_NOTREADY ||
+            uhost->urb_state[hc_num] == URB_ERROR)
+    {
+      /* device nak, send the same packet again */
+      usbh_bulk_send(uhost, hc_num, &pcdc->tx_ring[pcdc->tx_rd], pcdc->tx_inflight);
+      return;
+    }
+    else
+    {
+      return;
+    }
+  }
+
+  if(pcdc->tx_count == 0)
+  {
+    return;
+  }
+
+  /* merge everything written so far into one packet, bounded by the ring end */
+  len = USBH_CDC_TX_RING_SIZE - pcdc->tx_rd;
+  if(len > pcdc->tx_count)
+  {
+    len = pcdc->tx_count;
+  }
+  if(len > pcdc->data_interface.out_endpoint_size)
+  {
+    len = pcdc->data_interface.out_endpoint_size;
+  }
+
+  pcdc->tx_inflight = (uint16_t)len;
+  pcdc->data_tx_state = CDC_SEND_DATA_WAIT;
+  usbh_bulk_send(uhost, hc_num, &pcdc->tx_ring[pcdc->tx_rd], pcdc->tx_inflight);
+}
+
+/**
+  * @brief  usb host cdc class stream reception handler, push completed
+  *         packets into the rx ring and re-arm the in channel while the
+  *         ring can hold another max packet
+  * @param  uhost: to the structure of usbh_core_type
+  * @retval none
+  */
+static void cdc_stream_reception(usbh_core_type *uhost)
+{
+  usbh_cdc_type *pcdc = (usbh_cdc_type *)uhost->class_handler->pdata;
+  uint8_t hc_num = pcdc->data_interface.in_channel;
+  uint16_t mps = pcdc->data_interface.in_endpoint_size;
+  uint32_t len, part;
+
+  if(pcdc->data_rx_state == CDC_RECEIVE_DATA_WAIT)
+  {
+    if(uhost->urb_state[hc_num] == URB_DONE)
+    {
+      len = uhost->hch[hc_num].trans_count;
+      if(pcdc->rx_direct == 0)
+      {
+        /* packet landed in the bounce buffer across the ring end */
+        part = USBH_CDC_RX_RING_SIZE - pcdc->rx_wr;
+        if(part > len)
+        {
+          part = len;
+        }
+        memcpy(&pcdc->rx_ring[pcdc->rx_wr], pcdc->rx_packet, part);
+        memcpy(pcdc->rx_ring, &pcdc->rx_packet[part], len - part);
+      }
+      pcdc->rx_wr = (pcdc->rx_wr + len) % USBH_CDC_RX_RING_SIZE;
+      pcdc->rx_count += len;
+      pcdc->data_rx_state = CDC_RECEIVE_DATA;
+    }
+    else if(uhost->urb_state[hc_num] == URB_ERROR)
+    {
+      pcdc->data_rx_state = CDC_RECEIVE_DATA;
+    }
+    else
+    {
+      return;
+    }
+  }
+
+  /* not enough room for a full packet, stay paused until the application reads */
+  if(USBH_CDC_RX_RING_SIZE - pcdc->rx_count < mps)
+  {
+    return;
+  }
+
+  if(USBH_CDC_RX_RING_SIZE - pcdc->rx_wr >= mps)
+  {
+    pcdc->rx_direct = 1;
+    usbh_bulk_recv(uhost, hc_num, &pcdc->rx_ring[pcdc->rx_wr], mps);
+  }
+  else
+  {
+    pcdc->rx_direct = 0;
+    usbh_bulk_recv(uhost, hc_num, pcdc->rx_packet, mps);
+  }
+  pcdc->data_rx_state = CDC_RECEIVE_DATA_WAIT;
+}
+
+/**
+  * @brief  usb host cdc class start stream mode, the in channel is kept armed
+  *         into the rx ring and queued tx data is sent in max packet chunks.
+  *         stream and single buffer api must not be mixed.
+  * @param  uhost: to the structure of usbh_core_type
+  * @retval status: usb_sts_type status
+  */
+usb_sts_type cdc_start_stream(usbh_core_type *uhost)
+{
+  usbh_cdc_type *pcdc = (usbh_cdc_type *)uhost->class_handler->pdata;
+
+  if(uhost->global_state != USBH_CLASS ||
+     pcdc->data_tx_state != CDC_IDLE || pcdc->data_rx_state != CDC_IDLE)
+  {
+    return USB_FAIL;
+  }
+
+  if(pcdc->data_interface.in_endpoint_size > USBH_CDC_BULK_MPS ||
+     pcdc->data_interface.out_endpoint_size > USBH_CDC_BULK_MPS)
+  {
+    return USB_NOT_SUPPORT;
+  }
+
+  pcdc->rx_wr = pcdc->rx_rd = pcdc->rx_count = 0;
+  pcdc->tx_wr = pcdc->tx_rd = pcdc->tx_count = 0;
+  pcdc->tx_inflight = 0;
+  pcdc->data_rx_state = CDC_RECEIVE_DATA;
+  pcdc->stream_enable = 1;
+  pcdc->state = CDC_TRANSFER_DATA;
+
+  return USB_OK;
+}
+
+/**
+  * @brief  usb host cdc class stop stream mode, data still queued is dropped
+  * @param  uhost: to the structure of usbh_core_type
+  * @retval none
+  */
+void cdc_stop_stream(usbh_core_type *uhost)
+{
+  usbh_cdc_type *pcdc = (usbh_cdc_type *)uhost->class_handler->pdata;
+
+  usbh_ch_disable(uhost, pcdc->data_interface.in_channel);
+  usbh_ch_disable(uhost, pcdc->data_interface.out_channel);
+  pcdc->stream_enable = 0;
+  pcdc->data_tx_state = CDC_IDLE;
+  pcdc->data_rx_state = CDC_IDLE;
+  pcdc->state = CDC_IDLE_STATE;
+}
+
+/**
+  * @brief  usb host cdc class queue data for stream transmission
+  * @param  uhost: to the structure of usbh_core_type
+  * @param  data: tx data pointer
+  * @param  len: tx data len
+  * @retval number of bytes accepted, may be less than len when the queue is full
+  */
+uint32_t cdc_stream_write(usbh_core_type *uhost, const uint8_t *data, uint32_t len)
+{
+  usbh_cdc_type *pcdc = (usbh_cdc_type *)uhost->class_handler->pdata;
+  uint32_t part;
+
+  if(pcdc->stream_enable == 0)
+  {
+    return 0;
+  }
+
+  if(len > USBH_CDC_TX_RING_SIZE - pcdc->tx_count)
+  {
+    len = USBH_CDC_TX_RING_SIZE - pcdc->tx_count;
+  }
+
+  part = USBH_CDC_TX_RING_SIZE - pcdc->tx_wr;
+  if(part > len)
+  {
+    part = len;
+  }
+  memcpy(&pcdc->tx_ring[pcdc->tx_wr], data, part);
+  memcpy(pcdc->tx_ring, data + part, len - part);
+  pcdc->tx_wr = (pcdc->tx_wr + len) % USBH_CDC_TX_RING_SIZE;
+  pcdc->tx_count += len;
+
+  return len;
+}
+
+/**
+  * @brief  usb host cdc class read data received in stream mode
+  * @param  uhost: to the structure of usbh_core_type
+  * @param  data: receive data pointer
+  * @param  len: receive buffer len
+  * @retval number of bytes copied
+  */
+uint32_t cdc_stream_read(usbh_core_type *uhost, uint8_t *data, uint32_t len)
+{
+  usbh_cdc_type *pcdc = (usbh_cdc_type *)uhost->class_handler->pdata;
+  uint32_t part;
+
+  if(len > pcdc->rx_count)
+  {
+    len = pcdc->rx_count;
+  }
+
+  part = USBH_CDC_RX_RING_SIZE - pcdc->rx_rd;
+  if(part > len)
+  {
+    part = len;
+  }
+  memcpy(data, &pcdc->rx_ring[pcdc->rx_rd], part);
+  memcpy(data + part, pcdc->rx_ring, len - part);
+  pcdc->rx_rd = (pcdc->rx_rd + len) % USBH_CDC_RX_RING_SIZE;
+  pcdc->rx_count -= len;
+
+  return len;
+}
+
+/**
+  * @brief  usb host cdc class get free space of the stream tx queue
+  * @param  uhost: to the structure of usbh_core_type
+  * @retval free bytes
+  */
+uint32_t cdc_stream_tx_free(usbh_core_type *uhost)
+{
+  usbh_cdc_type *pcdc = (usbh_cdc_type *)uhost->class_handler->pdata;
+  return USBH_CDC_TX_RING_SIZE - pcdc->tx_count;
+}
+
+/**
+  * @brief  usb host cdc class get number of bytes waiting in the stream rx ring
+  * @param  uhost: to the structure of usbh_core_type
+  * @retval received bytes
+  */
+uint32_t cdc_stream_rx_count(usbh_core_type *uhost)
+{
+  usbh_cdc_type *pcdc = (usbh_cdc_type *)uhost->class_handler->pdata;
+  return pcdc->rx_count;
+}
+
 /**
   * @}
   */
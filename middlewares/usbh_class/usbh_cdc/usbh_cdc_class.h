@@ -123,6 +123,20 @@ extern "C" {
 
 #define LINE_CODING_STRUCTURE_SIZE                              0x07
 
+/**
+  * @brief  cdc stream ring buffer size, can be overridden in usb_conf.h
+  */
+#ifndef USBH_CDC_RX_RING_SIZE
+#define USBH_CDC_RX_RING_SIZE                                   1024
+#endif
+
+#ifndef USBH_CDC_TX_RING_SIZE
+#define USBH_CDC_TX_RING_SIZE                                   1024
+#endif
+
+/* full speed bulk max packet size */
+#define USBH_CDC_BULK_MPS                                       64
+
 /* states for cdc state machine */
 typedef enum
 {
@@ -257,6 +271,20 @@ typedef struct
   uint8_t                         *tx_data;
   uint32_t                        rx_len;
   uint32_t                        tx_len;
+
+  /* stream mode: rx ring re-armed on every completion, tx ring merged into max packet */
+  uint8_t                         stream_enable;
+  uint8_t                         rx_direct;
+  uint16_t                        tx_inflight;
+  uint8_t                         rx_packet[USBH_CDC_BULK_MPS];
+  uint8_t                         rx_ring[USBH_CDC_RX_RING_SIZE];
+  uint8_t                         tx_ring[USBH_CDC_TX_RING_SIZE];
+  uint32_t                        rx_wr;
+  uint32_t                        rx_rd;
+  uint32_t                        rx_count;
+  uint32_t                        tx_wr;
+  uint32_t                        tx_rd;
+  uint32_t                        tx_count;
 }usbh_cdc_type;
 
 extern usbh_class_handler_type uhost_cdc_class_handler;
@@ -265,6 +293,12 @@ void cdc_start_transmission(usbh_core_type *phost, uint8_t *data, uint32_t len);
 void cdc_start_reception(usbh_core_type *uhost, uint8_t *data, uint32_t len);
 void cdc_transmit_complete(usbh_core_type *uhost);
 void cdc_receive_complete(usbh_core_type *uhost);
+usb_sts_type cdc_start_stream(usbh_core_type *uhost);
+void cdc_stop_stream(usbh_core_type *uhost);
+uint32_t cdc_stream_write(usbh_core_type *uhost, const uint8_t *data, uint32_t len);
+uint32_t cdc_stream_read(usbh_core_type *uhost, uint8_t *data, uint32_t len);
+uint32_t cdc_stream_tx_free(usbh_core_type *uhost);
+uint32_t cdc_stream_rx_count(usbh_core_type *uhost);
 /**
   * @}
   */
@@ -0,0 +1,109 @@
+/**
+  **************************************************************************
+  * @file     dsp_bench.h
+  * @brief    cmsis-dsp kernel benchmark header
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* define to prevent recursive inclusion -------------------------------------*/
+#ifndef __DSP_BENCH_H
+#define __DSP_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* includes ------------------------------------------------------------------*/
+#include "at32f423.h"
+#include "arm_math.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_CORTEX_m4_dsp_benchmark
+  * @{
+  */
+
+/* largest complex and real fft, sized for the 50 KB sram with a double
+   precision reference of the same length */
+#ifndef BENCH_MAX_FFT
+#define BENCH_MAX_FFT                    512
+#endif
+
+/* largest filter block */
+#ifndef BENCH_MAX_BLOCK
+#define BENCH_MAX_BLOCK                  256
+#endif
+
+/* largest square matrix */
+#ifndef BENCH_MAX_MATRIX
+#define BENCH_MAX_MATRIX                 16
+#endif
+
+/* results kept by dsp_bench_run */
+#ifndef BENCH_MAX_RESULTS
+#define BENCH_MAX_RESULTS                64
+#endif
+
+/**
+  * @brief data type of a kernel variant
+  */
+typedef enum
+{
+  BENCH_F32                              = 0x00, /*!< float32_t */
+  BENCH_Q31                              = 0x01, /*!< q31_t */
+  BENCH_Q15                              = 0x02  /*!< q15_t */
+} bench_format_type;
+
+/**
+  * @brief result of one kernel variant at one size
+  */
+typedef struct
+{
+  const char                             *kernel;         /*!< cfft, rfft, fir, biquad or mat_mult */
+  const char                             *variant;        /*!< cmsis-dsp function measured */
+  bench_format_type                      format;          /*!< data type */
+  uint16_t                               size;            /*!< transform length, block or matrix order */
+  uint32_t                               cycles;          /*!< cycles of one call */
+  uint32_t                               samples;         /*!< output values produced by the call */
+  float32_t                              snr_db;          /*!< snr against the double precision reference */
+} bench_result_type;
+
+extern bench_result_type bench_results[BENCH_MAX_RESULTS];
+extern uint32_t bench_result_count;
+
+void dsp_bench_run(void);
+const bench_result_type *dsp_bench_best(const char *kernel, uint16_t size, float32_t min_snr_db);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
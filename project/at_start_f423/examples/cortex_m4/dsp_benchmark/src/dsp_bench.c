@@ -0,0 +1,606 @@
+/**
+  **************************************************************************
+  * @file     dsp_bench.c
+  * @brief    cmsis-dsp kernel benchmark
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include <math.h>
+#include <string.h>
+#include "dsp_bench.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_CORTEX_m4_dsp_benchmark
+  * @{
+  */
+
+#define BENCH_FIR_TAPS                   32
+#define BENCH_BIQUAD_STAGES              2
+
+/* snr reported when the output matches the reference exactly */
+#define BENCH_SNR_EXACT                  200.0f
+
+#define BENCH_START()                    (DWT->CYCCNT)
+#define BENCH_CYCLES(start)              (DWT->CYCCNT - (start))
+
+/* 0.1 fs lowpass, hamming windowed sinc */
+static const float32_t fir_coeffs_f32[BENCH_FIR_TAPS] =
+{
+  +0.00047589f, +0.00151411f, +0.00274609f, +0.00364049f,
+  +0.00290445f, -0.00087967f, -0.00806521f, -0.01681916f,
+  -0.02282894f, -0.02031463f, -0.00420346f, +0.02733640f,
+  +0.07115427f, +0.11913242f, +0.16023510f, +0.18397184f,
+  +0.18397184f, +0.16023510f, +0.11913242f, +0.07115427f,
+  +0.02733640f, -0.00420346f, -0.02031463f, -0.02282894f,
+  -0.01681916f, -0.00806521f, -0.00087967f, +0.00290445f,
+  +0.00364049f, +0.00274609f, +0.00151411f, +0.00047589f,
+};
+
+/* 0.05 fs fourth order butterworth lowpass, b0 b1 b2 a1 a2 per stage */
+static const float32_t biquad_coeffs_f32[5 * BENCH_BIQUAD_STAGES] =
+{
+  0.01903683f, 0.03807366f, 0.01903683f, 1.47967422f, -0.55582154f,
+  0.02188385f, 0.04376770f, 0.02188385f, 1.70096433f, -0.78849974f,
+};
+
+bench_result_type bench_results[BENCH_MAX_RESULTS];
+uint32_t bench_result_count = 0;
+
+/* double precision reference, the source in float and the kernel buffers
+   are shared by all benchmarks */
+static double bench_ref[2 * BENCH_MAX_FFT];
+static float32_t bench_src[2 * BENCH_MAX_FFT];
+static union
+{
+  float32_t f32[2 * BENCH_MAX_FFT];
+  q31_t q31[2 * BENCH_MAX_FFT];
+  q15_t q15[2 * BENCH_MAX_FFT];
+} bench_in;
+static union
+{
+  float32_t f32[2 * BENCH_MAX_FFT];
+  q31_t q31[2 * BENCH_MAX_FFT];
+  q15_t q15[2 * BENCH_MAX_FFT];
+} bench_out;
+static union
+{
+  float32_t f32[BENCH_FIR_TAPS + BENCH_MAX_BLOCK];
+  q31_t q31[BENCH_FIR_TAPS + BENCH_MAX_BLOCK];
+  q15_t q15[BENCH_MAX_MATRIX * BENCH_MAX_MATRIX];
+} bench_state;
+static union
+{
+  q31_t q31[BENCH_FIR_TAPS];
+  q15_t q15[BENCH_FIR_TAPS];
+} bench_coeffs;
+
+/**
+  * @brief  keep one result, extra results are dropped
+  * @param  kernel: kernel name
+  * @param  variant: function measured
+  * @param  format: data type
+  * @param  size: length, block or order
+  * @param  cycles: cycles of one call
+  * @param  samples: output values of one call
+  * @param  snr_db: snr against the reference
+  * @retval none
+  */
+static void bench_add(const char *kernel, const char *variant, bench_format_type format,
+                      uint16_t size, uint32_t cycles, uint32_t samples, float32_t snr_db)
+{
+  bench_result_type *result;
+
+  if(bench_result_count >= BENCH_MAX_RESULTS)
+  {
+    return;
+  }
+  result = &bench_results[bench_result_count++];
+  result->kernel = kernel;
+  result->variant = variant;
+  result->format = format;
+  result->size = size;
+  result->cycles = cycles;
+  result->samples = samples;
+  result->snr_db = snr_db;
+}
+
+/**
+  * @brief  value i of a kernel output as double
+  * @param  out: output buffer
+  * @param  format: data type of the buffer
+  * @param  i: index
+  * @retval value, q formats as fractions
+  */
+static double bench_value(const void *out, bench_format_type format, uint32_t i)
+{
+  switch(format)
+  {
+    case BENCH_Q31:
+      return ((const q31_t *)out)[i] / 2147483648.0;
+    case BENCH_Q15:
+      return ((const q15_t *)out)[i] / 32768.0;
+    default:
+      return ((const float32_t *)out)[i];
+  }
+}
+
+/**
+  * @brief  snr of an output against bench_ref
+  * @param  out: output buffer
+  * @param  format: data type of the buffer
+  * @param  n: values to compare
+  * @param  scale: factor applied to the output, undoes the fixed point
+  *         down scaling of the fft kernels
+  * @retval snr in db
+  */
+static float32_t bench_snr(const void *out, bench_format_type format, uint32_t n, double scale)
+{
+  double signal = 0, noise = 0, err;
+  uint32_t i;
+
+  for(i = 0; i < n; i ++)
+  {
+    err = bench_value(out, format, i) * scale - bench_ref[i];
+    signal += bench_ref[i] * bench_ref[i];
+    noise += err * err;
+  }
+  if(noise == 0)
+  {
+    return BENCH_SNR_EXACT;
+  }
+  return (float32_t)(10.0 * log10(signal / noise));
+}
+
+/**
+  * @brief  fill bench_src with two tones and pseudo random noise, all
+  *         values stay within +-0.5 so the q formats do not saturate
+  * @param  n: values to generate
+  * @retval none
+  */
+static void bench_signal(uint32_t n)
+{
+  uint32_t seed = 0x12345678;
+  uint32_t i;
+
+  for(i = 0; i < n; i ++)
+  {
+    seed = seed * 1664525 + 1013904223;
+    bench_src[i] = (float32_t)(0.3 * sin(2 * PI * 0.013 * i) + 0.1 * sin(2 * PI * 0.097 * i) +
+                               0.04 * ((int32_t)seed / 2147483648.0));
+  }
+}
+
+/**
+  * @brief  in place radix 2 fft of n complex values in bench_ref
+  * @param  n: length, a power of 2
+  * @retval none
+  */
+static void bench_ref_fft(uint32_t n)
+{
+  uint32_t i, j, k, len;
+  double wr, wi, tr, ti, ur, ui;
+
+  /* bit reversal */
+  for(i = 1, j = 0; i < n; i ++)
+  {
+    for(k = n >> 1; j & k; k >>= 1)
+    {
+      j ^= k;
+    }
+    j |= k;
+    if(i < j)
+    {
+      tr = bench_ref[2 * i]; bench_ref[2 * i] = bench_ref[2 * j]; bench_ref[2 * j] = tr;
+      ti = bench_ref[2 * i + 1]; bench_ref[2 * i + 1] = bench_ref[2 * j + 1]; bench_ref[2 * j + 1] = ti;
+    }
+  }
+
+  for(len = 2; len <= n; len <<= 1)
+  {
+    for(k = 0; k < len / 2; k ++)
+    {
+      wr = cos(2 * PI * k / len);
+      wi = -sin(2 * PI * k / len);
+      for(i = k; i < n; i += len)
+      {
+        j = i + len / 2;
+        tr = bench_ref[2 * j] * wr - bench_ref[2 * j + 1] * wi;
+        ti = bench_ref[2 * j] * wi + bench_ref[2 * j + 1] * wr;
+        ur = bench_ref[2 * i];
+        ui = bench_ref[2 * i + 1];
+        bench_ref[2 * i] = ur + tr;
+        bench_ref[2 * i + 1] = ui + ti;
+        bench_ref[2 * j] = ur - tr;
+        bench_ref[2 * j + 1] = ui - ti;
+      }
+    }
+  }
+}
+
+/**
+  * @brief  complex fft in f32, q31 and q15
+  * @param  n: fft length
+  * @retval none
+  */
+static void bench_cfft(uint16_t n)
+{
+  arm_cfft_instance_f32 cfft_f32;
+  arm_cfft_instance_q31 cfft_q31;
+  arm_cfft_instance_q15 cfft_q15;
+  uint32_t start, cycles, i;
+
+  bench_signal(2 * n);
+  for(i = 0; i < 2 * (uint32_t)n; i ++)
+  {
+    bench_ref[i] = bench_src[i];
+  }
+  bench_ref_fft(n);
+
+  if(arm_cfft_init_f32(&cfft_f32, n) == ARM_MATH_SUCCESS)
+  {
+    arm_copy_f32(bench_src, bench_in.f32, 2 * n);
+    start = BENCH_START();
+    arm_cfft_f32(&cfft_f32, bench_in.f32, 0, 1);
+    cycles = BENCH_CYCLES(start);
+    bench_add("cfft", "arm_cfft_f32", BENCH_F32, n, cycles, n, bench_snr(bench_in.f32, BENCH_F32, 2 * n, 1));
+  }
+
+  /* the fixed point transforms scale their output down by n */
+  if(arm_cfft_init_q31(&cfft_q31, n) == ARM_MATH_SUCCESS)
+  {
+    arm_float_to_q31(bench_src, bench_in.q31, 2 * n);
+    start = BENCH_START();
+    arm_cfft_q31(&cfft_q31, bench_in.q31, 0, 1);
+    cycles = BENCH_CYCLES(start);
+    bench_add("cfft", "arm_cfft_q31", BENCH_Q31, n, cycles, n, bench_snr(bench_in.q31, BENCH_Q31, 2 * n, n));
+  }
+
+  if(arm_cfft_init_q15(&cfft_q15, n) == ARM_MATH_SUCCESS)
+  {
+    arm_float_to_q15(bench_src, bench_in.q15, 2 * n);
+    start = BENCH_START();
+    arm_cfft_q15(&cfft_q15, bench_in.q15, 0, 1);
+    cycles = BENCH_CYCLES(start);
+    bench_add("cfft", "arm_cfft_q15", BENCH_Q15, n, cycles, n, bench_snr(bench_in.q15, BENCH_Q15, 2 * n, n));
+  }
+}
+
+/**
+  * @brief  real fft in f32
+  * @param  n: fft length
+  * @retval none
+  */
+static void bench_rfft(uint16_t n)
+{
+  arm_rfft_fast_instance_f32 rfft;
+  uint32_t start, cycles, i;
+
+  if(arm_rfft_fast_init_f32(&rfft, n) != ARM_MATH_SUCCESS)
+  {
+    return;
+  }
+
+  bench_signal(n);
+  for(i = 0; i < n; i ++)
+  {
+    bench_ref[2 * i] = bench_src[i];
+    bench_ref[2 * i + 1] = 0;
+  }
+  bench_ref_fft(n);
+
+  /* the output packs the real nyquist bin into the imaginary part of dc */
+  bench_ref[1] = bench_ref[n];
+
+  arm_copy_f32(bench_src, bench_in.f32, n);
+  start = BENCH_START();
+  arm_rfft_fast_f32(&rfft, bench_in.f32, bench_out.f32, 0);
+  cycles = BENCH_CYCLES(start);
+  bench_add("rfft", "arm_rfft_fast_f32", BENCH_F32, n, cycles, n, bench_snr(bench_out.f32, BENCH_F32, n, 1));
+}
+
+/**
+  * @brief  32 tap fir in f32, q31 and q15 with the fast variants
+  * @param  block: samples per call
+  * @retval none
+  */
+static void bench_fir(uint16_t block)
+{
+  arm_fir_instance_f32 fir_f32;
+  arm_fir_instance_q31 fir_q31;
+  arm_fir_instance_q15 fir_q15;
+  uint32_t start, cycles, i, k;
+  double acc;
+
+  bench_signal(block);
+  for(i = 0; i < block; i ++)
+  {
+    acc = 0;
+    for(k = 0; k < BENCH_FIR_TAPS && k <= i; k ++)
+    {
+      acc += (double)fir_coeffs_f32[k] * bench_src[i - k];
+    }
+    bench_ref[i] = acc;
+  }
+
+  memset(&bench_state, 0, sizeof(bench_state));
+  arm_fir_init_f32(&fir_f32, BENCH_FIR_TAPS, fir_coeffs_f32, bench_state.f32, block);
+  start = BENCH_START();
+  arm_fir_f32(&fir_f32, bench_src, bench_out.f32, block);
+  cycles = BENCH_CYCLES(start);
+  bench_add("fir", "arm_fir_f32", BENCH_F32, block, cycles, block, bench_snr(bench_out.f32, BENCH_F32, block, 1));
+
+  arm_float_to_q31(fir_coeffs_f32, bench_coeffs.q31, BENCH_FIR_TAPS);
+  arm_float_to_q31(bench_src, bench_in.q31, block);
+
+  memset(&bench_state, 0, sizeof(bench_state));
+  arm_fir_init_q31(&fir_q31, BENCH_FIR_TAPS, bench_coeffs.q31, bench_state.q31, block);
+  start = BENCH_START();
+  arm_fir_q31(&fir_q31, bench_in.q31, bench_out.q31, block);
+  cycles = BENCH_CYCLES(start);
+  bench_add("fir", "arm_fir_q31", BENCH_Q31, block, cycles, block, bench_snr(bench_out.q31, BENCH_Q31, block, 1));
+
+  memset(&bench_state, 0, sizeof(bench_state));
+  arm_fir_init_q31(&fir_q31, BENCH_FIR_TAPS, bench_coeffs.q31, bench_state.q31, block);
+  start = BENCH_START();
+  arm_fir_fast_q31(&fir_q31, bench_in.q31, bench_out.q31, block);
+  cycles = BENCH_CYCLES(start);
+  bench_add("fir", "arm_fir_fast_q31", BENCH_Q31, block, cycles, block, bench_snr(bench_out.q31, BENCH_Q31, block, 1));
+
+  arm_float_to_q15(fir_coeffs_f32, bench_coeffs.q15, BENCH_FIR_TAPS);
+  arm_float_to_q15(bench_src, bench_in.q15, block);
+
+  memset(&bench_state, 0, sizeof(bench_state));
+  if(arm_fir_init_q15(&fir_q15, BENCH_FIR_TAPS, bench_coeffs.q15, bench_state.q15, block) == ARM_MATH_SUCCESS)
+  {
+    start = BENCH_START();
+    arm_fir_q15(&fir_q15, bench_in.q15, bench_out.q15, block);
+    cycles = BENCH_CYCLES(start);
+    bench_add("fir", "arm_fir_q15", BENCH_Q15, block, cycles, block, bench_snr(bench_out.q15, BENCH_Q15, block, 1));
+
+    memset(&bench_state, 0, sizeof(bench_state));
+    arm_fir_init_q15(&fir_q15, BENCH_FIR_TAPS, bench_coeffs.q15, bench_state.q15, block);
+    start = BENCH_START();
+    arm_fir_fast_q15(&fir_q15, bench_in.q15, bench_out.q15, block);
+    cycles = BENCH_CYCLES(start);
+    bench_add("fir", "arm_fir_fast_q15", BENCH_Q15, block, cycles, block, bench_snr(bench_out.q15, BENCH_Q15, block, 1));
+  }
+}
+
+/**
+  * @brief  two stage biquad cascade, df2T in f32 and df1 in q31 and q15,
+  *         the fixed point coefficients are halved with a post shift of 1
+  * @param  block: samples per call
+  * @retval none
+  */
+static void bench_biquad(uint16_t block)
+{
+  arm_biquad_cascade_df2T_instance_f32 biquad_f32;
+  arm_biquad_casd_df1_inst_q31 biquad_q31;
+  arm_biquad_casd_df1_inst_q15 biquad_q15;
+  uint32_t start, cycles, i, s;
+  double x, y, d[4 * BENCH_BIQUAD_STAGES] = {0};
+  const float32_t *c;
+
+  bench_signal(block);
+  for(i = 0; i < block; i ++)
+  {
+    x = bench_src[i];
+    for(s = 0; s < BENCH_BIQUAD_STAGES; s ++)
+    {
+      c = &biquad_coeffs_f32[5 * s];
+      y = c[0] * x + c[1] * d[4 * s] + c[2] * d[4 * s + 1] + c[3] * d[4 * s + 2] + c[4] * d[4 * s + 3];
+      d[4 * s + 1] = d[4 * s];
+      d[4 * s] = x;
+      d[4 * s + 3] = d[4 * s + 2];
+      d[4 * s + 2] = y;
+      x = y;
+    }
+    bench_ref[i] = x;
+  }
+
+  memset(&bench_state, 0, sizeof(bench_state));
+  arm_biquad_cascade_df2T_init_f32(&biquad_f32, BENCH_BIQUAD_STAGES, biquad_coeffs_f32, bench_state.f32);
+  start = BENCH_START();
+  arm_biquad_cascade_df2T_f32(&biquad_f32, bench_src, bench_out.f32, block);
+  cycles = BENCH_CYCLES(start);
+  bench_add("biquad", "arm_biquad_cascade_df2T_f32", BENCH_F32, block, cycles, block,
+            bench_snr(bench_out.f32, BENCH_F32, block, 1));
+
+  for(i = 0; i < 5 * BENCH_BIQUAD_STAGES; i ++)
+  {
+    bench_coeffs.q31[i] = (q31_t)(biquad_coeffs_f32[i] / 2 * 2147483648.0);
+  }
+  arm_float_to_q31(bench_src, bench_in.q31, block);
+
+  memset(&bench_state, 0, sizeof(bench_state));
+  arm_biquad_cascade_df1_init_q31(&biquad_q31, BENCH_BIQUAD_STAGES, bench_coeffs.q31, bench_state.q31, 1);
+  start = BENCH_START();
+  arm_biquad_cascade_df1_q31(&biquad_q31, bench_in.q31, bench_out.q31, block);
+  cycles = BENCH_CYCLES(start);
+  bench_add("biquad", "arm_biquad_cascade_df1_q31", BENCH_Q31, block, cycles, block,
+            bench_snr(bench_out.q31, BENCH_Q31, block, 1));
+
+  memset(&bench_state, 0, sizeof(bench_state));
+  arm_biquad_cascade_df1_init_q31(&biquad_q31, BENCH_BIQUAD_STAGES, bench_coeffs.q31, bench_state.q31, 1);
+  start = BENCH_START();
+  arm_biquad_cascade_df1_fast_q31(&biquad_q31, bench_in.q31, bench_out.q31, block);
+  cycles = BENCH_CYCLES(start);
+  bench_add("biquad", "arm_biquad_cascade_df1_fast_q31", BENCH_Q31, block, cycles, block,
+            bench_snr(bench_out.q31, BENCH_Q31, block, 1));
+
+  /* q15 stages take b0 0 b1 b2 a1 a2 */
+  for(s = 0; s < BENCH_BIQUAD_STAGES; s ++)
+  {
+    c = &biquad_coeffs_f32[5 * s];
+    bench_coeffs.q15[6 * s] = (q15_t)(c[0] / 2 * 32768.0f);
+    bench_coeffs.q15[6 * s + 1] = 0;
+    bench_coeffs.q15[6 * s + 2] = (q15_t)(c[1] / 2 * 32768.0f);
+    bench_coeffs.q15[6 * s + 3] = (q15_t)(c[2] / 2 * 32768.0f);
+    bench_coeffs.q15[6 * s + 4] = (q15_t)(c[3] / 2 * 32768.0f);
+    bench_coeffs.q15[6 * s + 5] = (q15_t)(c[4] / 2 * 32768.0f);
+  }
+  arm_float_to_q15(bench_src, bench_in.q15, block);
+
+  memset(&bench_state, 0, sizeof(bench_state));
+  arm_biquad_cascade_df1_init_q15(&biquad_q15, BENCH_BIQUAD_STAGES, bench_coeffs.q15, bench_state.q15, 1);
+  start = BENCH_START();
+  arm_biquad_cascade_df1_q15(&biquad_q15, bench_in.q15, bench_out.q15, block);
+  cycles = BENCH_CYCLES(start);
+  bench_add("biquad", "arm_biquad_cascade_df1_q15", BENCH_Q15, block, cycles, block,
+            bench_snr(bench_out.q15, BENCH_Q15, block, 1));
+
+  memset(&bench_state, 0, sizeof(bench_state));
+  arm_biquad_cascade_df1_init_q15(&biquad_q15, BENCH_BIQUAD_STAGES, bench_coeffs.q15, bench_state.q15, 1);
+  start = BENCH_START();
+  arm_biquad_cascade_df1_fast_q15(&biquad_q15, bench_in.q15, bench_out.q15, block);
+  cycles = BENCH_CYCLES(start);
+  bench_add("biquad", "arm_biquad_cascade_df1_fast_q15", BENCH_Q15, block, cycles, block,
+            bench_snr(bench_out.q15, BENCH_Q15, block, 1));
+}
+
+/**
+  * @brief  square matrix multiply in f32, q31 and q15, entries stay within
+  *         +-0.2 so no product sum saturates
+  * @param  order: rows and columns
+  * @retval none
+  */
+static void bench_mat_mult(uint16_t order)
+{
+  arm_matrix_instance_f32 a_f32, b_f32, c_f32;
+  arm_matrix_instance_q31 a_q31, b_q31, c_q31;
+  arm_matrix_instance_q15 a_q15, b_q15, c_q15;
+  uint32_t n = (uint32_t)order * order;
+  uint32_t start, cycles, i, j, k;
+  double acc;
+
+  /* a in the first half of bench_src, b in the second */
+  bench_signal(2 * n);
+  arm_scale_f32(bench_src, 0.4f, bench_src, 2 * n);
+  for(i = 0; i < order; i ++)
+  {
+    for(j = 0; j < order; j ++)
+    {
+      acc = 0;
+      for(k = 0; k < order; k ++)
+      {
+        acc += (double)bench_src[i * order + k] * bench_src[n + k * order + j];
+      }
+      bench_ref[i * order + j] = acc;
+    }
+  }
+
+  arm_mat_init_f32(&a_f32, order, order, bench_src);
+  arm_mat_init_f32(&b_f32, order, order, bench_src + n);
+  arm_mat_init_f32(&c_f32, order, order, bench_out.f32);
+  start = BENCH_START();
+  arm_mat_mult_f32(&a_f32, &b_f32, &c_f32);
+  cycles = BENCH_CYCLES(start);
+  bench_add("mat_mult", "arm_mat_mult_f32", BENCH_F32, order, cycles, n, bench_snr(bench_out.f32, BENCH_F32, n, 1));
+
+  arm_float_to_q31(bench_src, bench_in.q31, 2 * n);
+  arm_mat_init_q31(&a_q31, order, order, bench_in.q31);
+  arm_mat_init_q31(&b_q31, order, order, bench_in.q31 + n);
+  arm_mat_init_q31(&c_q31, order, order, bench_out.q31);
+  start = BENCH_START();
+  arm_mat_mult_q31(&a_q31, &b_q31, &c_q31);
+  cycles = BENCH_CYCLES(start);
+  bench_add("mat_mult", "arm_mat_mult_q31", BENCH_Q31, order, cycles, n, bench_snr(bench_out.q31, BENCH_Q31, n, 1));
+
+  arm_float_to_q15(bench_src, bench_in.q15, 2 * n);
+  arm_mat_init_q15(&a_q15, order, order, bench_in.q15);
+  arm_mat_init_q15(&b_q15, order, order, bench_in.q15 + n);
+  arm_mat_init_q15(&c_q15, order, order, bench_out.q15);
+  start = BENCH_START();
+  arm_mat_mult_q15(&a_q15, &b_q15, &c_q15, bench_state.q15);
+  cycles = BENCH_CYCLES(start);
+  bench_add("mat_mult", "arm_mat_mult_q15", BENCH_Q15, order, cycles, n, bench_snr(bench_out.q15, BENCH_Q15, n, 1));
+}
+
+/**
+  * @brief  run every kernel at the typical sizes, results are kept in
+  *         bench_results
+  * @param  none
+  * @retval none
+  */
+void dsp_bench_run(void)
+{
+  static const uint16_t fft_size[] = {64, 256, BENCH_MAX_FFT};
+  static const uint16_t block_size[] = {32, 64, BENCH_MAX_BLOCK};
+  static const uint16_t order_size[] = {4, 8, BENCH_MAX_MATRIX};
+  uint32_t i;
+
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  bench_result_count = 0;
+  for(i = 0; i < sizeof(fft_size) / sizeof(fft_size[0]); i ++)
+  {
+    bench_cfft(fft_size[i]);
+    bench_rfft(fft_size[i]);
+  }
+  for(i = 0; i < sizeof(block_size) / sizeof(block_size[0]); i ++)
+  {
+    bench_fir(block_size[i]);
+    bench_biquad(block_size[i]);
+  }
+  for(i = 0; i < sizeof(order_size) / sizeof(order_size[0]); i ++)
+  {
+    bench_mat_mult(order_size[i]);
+  }
+}
+
+/**
+  * @brief  fastest variant of a kernel at a size that reaches an snr
+  * @param  kernel: kernel name
+  * @param  size: length, block or order
+  * @param  min_snr_db: accuracy required
+  * @retval result, 0 when no variant qualifies
+  */
+const bench_result_type *dsp_bench_best(const char *kernel, uint16_t size, float32_t min_snr_db)
+{
+  const bench_result_type *best = 0;
+  uint32_t i;
+
+  for(i = 0; i < bench_result_count; i ++)
+  {
+    if(strcmp(bench_results[i].kernel, kernel) != 0 || bench_results[i].size != size ||
+       bench_results[i].snr_db < min_snr_db)
+    {
+      continue;
+    }
+    if(best == 0 || bench_results[i].cycles < best->cycles)
+    {
+      best = &bench_results[i];
+    }
+  }
+  return best;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
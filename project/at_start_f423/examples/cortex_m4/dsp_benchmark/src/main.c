@@ -0,0 +1,134 @@
+/**
+  **************************************************************************
+  * @file     main.c
+  * @brief    main program
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "at32f423_board.h"
+#include "at32f423_clock.h"
+#include "dsp_bench.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_CORTEX_m4_dsp_benchmark CORTEX_m4_dsp_benchmark
+  * @{
+  */
+
+/* accuracy a variant needs to be picked as the fastest */
+#define BENCH_MIN_SNR_DB                 60.0f
+
+static const char *const format_name[] = {"f32", "q31", "q15"};
+
+/**
+  * @brief  print the results as csv between begin and end markers.
+  * @param  none
+  * @retval none
+  */
+static void bench_report(void)
+{
+  const bench_result_type *result;
+  uint32_t i;
+
+  printf("#begin dsp_bench sclk=%d\r\n", system_core_clock);
+  printf("kernel,variant,format,size,cycles,cycles_per_sample,snr_db\r\n");
+  for(i = 0; i < bench_result_count; i ++)
+  {
+    result = &bench_results[i];
+    printf("%s,%s,%s,%d,%d,%.2f,%.1f\r\n", result->kernel, result->variant, format_name[result->format],
+           result->size, result->cycles, (float32_t)result->cycles / result->samples, result->snr_db);
+  }
+  printf("#end dsp_bench\r\n");
+}
+
+/**
+  * @brief  print the fastest variant of each kernel and size.
+  * @param  none
+  * @retval none
+  */
+static void bench_summary(void)
+{
+  const bench_result_type *best;
+  uint32_t i, j;
+
+  printf("#begin dsp_bench_best min_snr_db=%.0f\r\n", BENCH_MIN_SNR_DB);
+  printf("kernel,size,variant,cycles,snr_db\r\n");
+  for(i = 0; i < bench_result_count; i ++)
+  {
+    /* first result of each kernel and size only */
+    for(j = 0; j < i; j ++)
+    {
+      if(bench_results[j].kernel == bench_results[i].kernel && bench_results[j].size == bench_results[i].size)
+      {
+        break;
+      }
+    }
+    if(j != i)
+    {
+      continue;
+    }
+    best = dsp_bench_best(bench_results[i].kernel, bench_results[i].size, BENCH_MIN_SNR_DB);
+    if(best != 0)
+    {
+      printf("%s,%d,%s,%d,%.1f\r\n", best->kernel, best->size, best->variant, best->cycles, best->snr_db);
+    }
+    else
+    {
+      printf("%s,%d,none,0,0\r\n", bench_results[i].kernel, bench_results[i].size);
+    }
+  }
+  printf("#end dsp_bench_best\r\n");
+}
+
+/**
+  * @brief  main function.
+  * @param  none
+  * @retval none
+  */
+int main(void)
+{
+  system_clock_config();
+
+  at32_board_init();
+
+  uart_print_init(115200);
+
+  /* the kernels run with interrupts off so the cycle counts are repeatable */
+  __disable_irq();
+  dsp_bench_run();
+  __enable_irq();
+
+  bench_report();
+  bench_summary();
+
+  at32_led_on(LED2);
+  while(1);
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,55 @@
+/**
+  **************************************************************************
+  * @file     at32f423.h
+  * @brief    host stub of the device header for the dsp benchmark test
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* dsp_bench.c only uses the dwt cycle counter of the core, this header
+   replaces the device header so that it builds on the host. the counter is
+   a plain structure that never advances, the host test checks the snr of
+   the kernels and not their cycles. */
+
+#ifndef __AT32F423_H
+#define __AT32F423_H
+
+#include <stdint.h>
+
+typedef struct
+{
+  volatile uint32_t CTRL;
+  volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+  volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+extern DWT_Type host_dwt;
+extern CoreDebug_Type host_core_debug;
+
+#define DWT                              (&host_dwt)
+#define CoreDebug                        (&host_core_debug)
+#define DWT_CTRL_CYCCNTENA_Msk           (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk       (1UL << 24)
+
+#endif
@@ -0,0 +1,6 @@
+# host replacement of configLib.cmake of the cmsis pack, the library is built
+# with the compiler and flags of the host and only needs its include path
+
+function(configLib project root)
+  target_include_directories(${project} PUBLIC "${root}/CMSIS/DSP/Include")
+endfunction()
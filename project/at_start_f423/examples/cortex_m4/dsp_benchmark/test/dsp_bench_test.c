@@ -0,0 +1,126 @@
+/**
+  **************************************************************************
+  * @file     dsp_bench_test.c
+  * @brief    host test of the dsp benchmark references and snr
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* dsp_bench_run runs every kernel against the cmsis-dsp library built for
+   the host. a wrong double precision reference, a wrong q format scale or a
+   kernel fed with the wrong layout shows up as an snr far below the bound
+   of its data type, and the fastest variant must exist for every kernel and
+   size at the accuracy the on-target report asks for. */
+
+#include "dsp_bench.h"
+#include <stdio.h>
+#include <string.h>
+
+/* accuracy of the on-target summary, see main.c */
+#define TEST_MIN_SNR_DB                  60.0f
+
+/* lowest snr of each data type, the q15 fft loses one bit per stage */
+#define TEST_F32_SNR_DB                  100.0f
+#define TEST_Q31_SNR_DB                  100.0f
+#define TEST_Q15_SNR_DB                  35.0f
+
+/* 3 sizes of cfft f32/q31/q15 and rfft, fir f32/q31/fast q31/q15/fast q15,
+   biquad f32/q31/fast q31/q15/fast q15 and mat_mult f32/q31/q15 */
+#define TEST_RESULT_COUNT                (3 * (3 + 1) + 3 * (5 + 5) + 3 * 3)
+
+#define TEST_CHECK(cond)                 do { if(!(cond)) { printf("  %s:%d: %s\n", __func__, __LINE__, #cond); \
+                                           test_failed ++; } } while(0)
+
+DWT_Type host_dwt;
+CoreDebug_Type host_core_debug;
+
+static int test_failed;
+
+/**
+  * @brief  every variant ran and reaches the snr of its data type
+  * @param  none
+  * @retval none
+  */
+static void test_snr(void)
+{
+  static const float32_t min_snr[] = {TEST_F32_SNR_DB, TEST_Q31_SNR_DB, TEST_Q15_SNR_DB};
+  const bench_result_type *result;
+  uint32_t i;
+
+  TEST_CHECK(bench_result_count == TEST_RESULT_COUNT);
+  for(i = 0; i < bench_result_count; i ++)
+  {
+    result = &bench_results[i];
+    printf("%s,%s,%d,%.1f\n", result->kernel, result->variant, result->size, result->snr_db);
+    if(result->snr_db < min_snr[result->format])
+    {
+      printf("  %s %d: snr %.1f db below %.1f db\n", result->variant, result->size,
+             result->snr_db, min_snr[result->format]);
+      test_failed ++;
+    }
+    TEST_CHECK(result->samples != 0);
+  }
+}
+
+/**
+  * @brief  each kernel and size has a variant for the summary
+  * @param  none
+  * @retval none
+  */
+static void test_best(void)
+{
+  static const char *const kernel[] = {"cfft", "rfft", "fir", "biquad", "mat_mult"};
+  static const uint16_t size[][3] =
+  {
+    {64, 256, BENCH_MAX_FFT},
+    {64, 256, BENCH_MAX_FFT},
+    {32, 64, BENCH_MAX_BLOCK},
+    {32, 64, BENCH_MAX_BLOCK},
+    {4, 8, BENCH_MAX_MATRIX},
+  };
+  const bench_result_type *best;
+  uint32_t i, j;
+
+  for(i = 0; i < sizeof(kernel) / sizeof(kernel[0]); i ++)
+  {
+    for(j = 0; j < 3; j ++)
+    {
+      best = dsp_bench_best(kernel[i], size[i][j], TEST_MIN_SNR_DB);
+      TEST_CHECK(best != 0);
+      if(best != 0)
+      {
+        TEST_CHECK(strcmp(best->kernel, kernel[i]) == 0 && best->size == size[i][j]);
+        TEST_CHECK(best->snr_db >= TEST_MIN_SNR_DB);
+      }
+    }
+  }
+  TEST_CHECK(dsp_bench_best("cfft", 128, TEST_MIN_SNR_DB) == 0);
+}
+
+int main(void)
+{
+  dsp_bench_run();
+
+  test_snr();
+  test_best();
+
+  printf("%d checks failed\n", test_failed);
+  return test_failed;
+}
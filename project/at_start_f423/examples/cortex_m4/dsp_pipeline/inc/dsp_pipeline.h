@@ -0,0 +1,163 @@
+/**
+  **************************************************************************
+  * @file     dsp_pipeline.h
+  * @brief    block processing dsp pipeline header
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* define to prevent recursive inclusion -------------------------------------*/
+#ifndef __DSP_PIPELINE_H
+#define __DSP_PIPELINE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* includes ------------------------------------------------------------------*/
+#include "at32f423.h"
+#include "arm_math.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_CORTEX_m4_dsp_pipeline
+  * @{
+  */
+
+/* stages of one pipeline, one bit each in a schedule entry */
+#ifndef DSP_PIPELINE_MAX_STAGES
+#define DSP_PIPELINE_MAX_STAGES          8
+#endif
+
+/* source blocks of the longest schedule, the block count after which every
+   stage has run a whole number of times */
+#ifndef DSP_PIPELINE_MAX_SCHEDULE
+#define DSP_PIPELINE_MAX_SCHEDULE        16
+#endif
+
+/**
+  * @brief processing of a stage
+  */
+typedef enum
+{
+  DSP_STAGE_CONVERT                      = 0x00, /*!< adc samples to float, first stage only */
+  DSP_STAGE_FIR                          = 0x01, /*!< arm_fir_f32 */
+  DSP_STAGE_BIQUAD                       = 0x02, /*!< arm_biquad_cascade_df2T_f32 */
+  DSP_STAGE_DECIMATE                     = 0x03, /*!< arm_fir_decimate_f32 */
+  DSP_STAGE_FFT                          = 0x04, /*!< window, arm_rfft_fast_f32 and magnitude */
+  DSP_STAGE_LEVEL                        = 0x05  /*!< rms and peak, samples pass through */
+} dsp_stage_kind_type;
+
+/**
+  * @brief convert stage instance, out = (in - offset) * scale
+  */
+typedef struct
+{
+  float32_t                              offset;          /*!< adc code of the zero level */
+  float32_t                              scale;           /*!< full scale per adc code */
+} dsp_convert_type;
+
+/**
+  * @brief fft stage instance
+  */
+typedef struct
+{
+  arm_rfft_fast_instance_f32             rfft;            /*!< initialized by dsp_stage_fft_init */
+  const float32_t                        *window;         /*!< length coefficients, 0 for none */
+  float32_t                              *work;           /*!< length samples of complex spectrum */
+} dsp_fft_type;
+
+/**
+  * @brief level stage instance, updated on every block
+  */
+typedef struct
+{
+  float32_t                              rms;             /*!< rms of the last block */
+  float32_t                              peak;            /*!< absolute peak of the last block */
+  float32_t                              peak_hold;       /*!< largest peak since the last clear */
+} dsp_level_type;
+
+/**
+  * @brief pipeline stage, the input buffer holds in_block samples and is
+  *        filled in place by the previous stage one output block at a time
+  */
+typedef struct
+{
+  const char                             *name;           /*!< name used in reports */
+  dsp_stage_kind_type                    kind;            /*!< processing */
+  void                                   *instance;       /*!< arm or dsp_xxx_type instance of the kind */
+  float32_t                              *input;          /*!< in_block samples, 0 for the first stage */
+  uint16_t                               in_block;        /*!< samples consumed per run */
+  uint16_t                               out_block;       /*!< samples produced per run */
+  uint16_t                               ratio;           /*!< runs of the previous stage per run */
+  uint16_t                               phase;           /*!< previous stage blocks already in input */
+  uint32_t                               runs;            /*!< completed runs */
+  uint32_t                               cycles_last;     /*!< cycles of the last run */
+  uint32_t                               cycles_max;      /*!< worst run */
+  uint64_t                               cycles_total;    /*!< cycles of all runs */
+} dsp_stage_type;
+
+/**
+  * @brief pipeline, driven by one source block per dsp_pipeline_run
+  */
+typedef struct
+{
+  dsp_stage_type                         *stage;          /*!< stages in data order */
+  uint8_t                                stage_count;     /*!< number of stages */
+  float32_t                              *output;         /*!< out_block samples of the last stage */
+  void                                   (*sink)(const float32_t *output, uint16_t length); /*!< called after the last stage, may be 0 */
+  uint32_t                               schedule[DSP_PIPELINE_MAX_SCHEDULE]; /*!< stages run at each source block */
+  uint16_t                               schedule_length; /*!< source blocks per schedule */
+  uint16_t                               slot;            /*!< next schedule entry */
+  uint32_t                               slot_cycles_max[DSP_PIPELINE_MAX_SCHEDULE]; /*!< worst cycles of each entry */
+  uint32_t                               budget;          /*!< cycles allowed per block, 0 for no check */
+  uint32_t                               blocks;          /*!< source blocks processed */
+  uint32_t                               frames;          /*!< outputs passed to the sink */
+  uint32_t                               overruns;        /*!< blocks over budget */
+  uint32_t                               cycles_last;     /*!< cycles of the last block */
+  uint32_t                               cycles_max;      /*!< worst block */
+} dsp_pipeline_type;
+
+void dsp_stage_convert_init(dsp_stage_type *stage, const char *name, dsp_convert_type *convert, uint16_t block);
+void dsp_stage_fir_init(dsp_stage_type *stage, const char *name, arm_fir_instance_f32 *fir, float32_t *input, uint16_t block);
+void dsp_stage_biquad_init(dsp_stage_type *stage, const char *name, arm_biquad_cascade_df2T_instance_f32 *biquad, float32_t *input, uint16_t block);
+void dsp_stage_decimate_init(dsp_stage_type *stage, const char *name, arm_fir_decimate_instance_f32 *decimate, float32_t *input, uint16_t block);
+error_status dsp_stage_fft_init(dsp_stage_type *stage, const char *name, dsp_fft_type *fft, float32_t *input, uint16_t length);
+void dsp_stage_level_init(dsp_stage_type *stage, const char *name, dsp_level_type *level, float32_t *input, uint16_t block);
+error_status dsp_pipeline_init(dsp_pipeline_type *pipeline, dsp_stage_type *stage, uint8_t stage_count,
+                               float32_t *output, void (*sink)(const float32_t *output, uint16_t length));
+void dsp_pipeline_run(dsp_pipeline_type *pipeline, const uint16_t *samples);
+void dsp_pipeline_stats_clear(dsp_pipeline_type *pipeline);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
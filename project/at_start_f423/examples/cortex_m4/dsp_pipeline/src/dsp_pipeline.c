@@ -0,0 +1,413 @@
+/**
+  **************************************************************************
+  * @file     dsp_pipeline.c
+  * @brief    block processing dsp pipeline
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "dsp_pipeline.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_CORTEX_m4_dsp_pipeline
+  * @{
+  */
+
+/**
+  * @brief  common part of the stage init functions
+  * @param  stage: stage to init
+  * @param  name: name used in reports
+  * @param  kind: processing of the stage
+  * @param  instance: instance of the kind
+  * @param  input: in_block samples buffer, 0 for the first stage
+  * @param  in_block: samples consumed per run
+  * @param  out_block: samples produced per run
+  * @retval none
+  */
+static void dsp_stage_setup(dsp_stage_type *stage, const char *name, dsp_stage_kind_type kind,
+                            void *instance, float32_t *input, uint16_t in_block, uint16_t out_block)
+{
+  stage->name = name;
+  stage->kind = kind;
+  stage->instance = instance;
+  stage->input = input;
+  stage->in_block = in_block;
+  stage->out_block = out_block;
+  stage->ratio = 1;
+  stage->phase = 0;
+  stage->runs = 0;
+  stage->cycles_last = 0;
+  stage->cycles_max = 0;
+  stage->cycles_total = 0;
+}
+
+/**
+  * @brief  init a stage converting adc samples to float, the first stage
+  * @param  stage: stage to init
+  * @param  name: name used in reports
+  * @param  convert: zero level and scale
+  * @param  block: samples per source block
+  * @retval none
+  */
+void dsp_stage_convert_init(dsp_stage_type *stage, const char *name, dsp_convert_type *convert, uint16_t block)
+{
+  dsp_stage_setup(stage, name, DSP_STAGE_CONVERT, convert, 0, block, block);
+}
+
+/**
+  * @brief  init a fir stage
+  * @param  stage: stage to init
+  * @param  name: name used in reports
+  * @param  fir: instance initialized by arm_fir_init_f32 with block
+  * @param  input: block samples buffer
+  * @param  block: samples per run
+  * @retval none
+  */
+void dsp_stage_fir_init(dsp_stage_type *stage, const char *name, arm_fir_instance_f32 *fir, float32_t *input, uint16_t block)
+{
+  dsp_stage_setup(stage, name, DSP_STAGE_FIR, fir, input, block, block);
+}
+
+/**
+  * @brief  init a biquad cascade stage
+  * @param  stage: stage to init
+  * @param  name: name used in reports
+  * @param  biquad: instance initialized by arm_biquad_cascade_df2T_init_f32
+  * @param  input: block samples buffer
+  * @param  block: samples per run
+  * @retval none
+  */
+void dsp_stage_biquad_init(dsp_stage_type *stage, const char *name, arm_biquad_cascade_df2T_instance_f32 *biquad, float32_t *input, uint16_t block)
+{
+  dsp_stage_setup(stage, name, DSP_STAGE_BIQUAD, biquad, input, block, block);
+}
+
+/**
+  * @brief  init a decimator stage, block / M samples are produced per run
+  * @param  stage: stage to init
+  * @param  name: name used in reports
+  * @param  decimate: instance initialized by arm_fir_decimate_init_f32 with block
+  * @param  input: block samples buffer
+  * @param  block: samples per run
+  * @retval none
+  */
+void dsp_stage_decimate_init(dsp_stage_type *stage, const char *name, arm_fir_decimate_instance_f32 *decimate, float32_t *input, uint16_t block)
+{
+  dsp_stage_setup(stage, name, DSP_STAGE_DECIMATE, decimate, input, block, block / decimate->M);
+}
+
+/**
+  * @brief  init an fft stage producing length / 2 bin magnitudes, the input
+  *         buffer is windowed and transformed in place
+  * @param  stage: stage to init
+  * @param  name: name used in reports
+  * @param  fft: instance, window and work set by the caller
+  * @param  input: length samples buffer
+  * @param  length: fft length, 32 to 4096 and a power of 2
+  * @retval error_status: ERROR when the length is not supported
+  */
+error_status dsp_stage_fft_init(dsp_stage_type *stage, const char *name, dsp_fft_type *fft, float32_t *input, uint16_t length)
+{
+  if(arm_rfft_fast_init_f32(&fft->rfft, length) != ARM_MATH_SUCCESS)
+  {
+    return ERROR;
+  }
+  dsp_stage_setup(stage, name, DSP_STAGE_FFT, fft, input, length, length / 2);
+  return SUCCESS;
+}
+
+/**
+  * @brief  init a level stage, samples are copied to the next stage unchanged
+  * @param  stage: stage to init
+  * @param  name: name used in reports
+  * @param  level: rms and peak results
+  * @param  input: block samples buffer
+  * @param  block: samples per run
+  * @retval none
+  */
+void dsp_stage_level_init(dsp_stage_type *stage, const char *name, dsp_level_type *level, float32_t *input, uint16_t block)
+{
+  level->rms = 0;
+  level->peak = 0;
+  level->peak_hold = 0;
+  dsp_stage_setup(stage, name, DSP_STAGE_LEVEL, level, input, block, block);
+}
+
+/**
+  * @brief  connect the stages and precompute the execution schedule
+  * @param  pipeline: pipeline to init
+  * @param  stage: stages in data order, initialized by dsp_stage_xxx_init
+  * @param  stage_count: number of stages
+  * @param  output: out_block samples of the last stage
+  * @param  sink: called with the output after the last stage runs, may be 0
+  * @retval error_status: ERROR when a stage input is not a whole number of
+  *         previous stage outputs or the schedule is too long
+  */
+error_status dsp_pipeline_init(dsp_pipeline_type *pipeline, dsp_stage_type *stage, uint8_t stage_count,
+                               float32_t *output, void (*sink)(const float32_t *output, uint16_t length))
+{
+  uint16_t period[DSP_PIPELINE_MAX_STAGES];
+  uint16_t i, k;
+
+  if(stage_count == 0 || stage_count > DSP_PIPELINE_MAX_STAGES || stage[0].kind != DSP_STAGE_CONVERT)
+  {
+    return ERROR;
+  }
+
+  /* a stage runs once every period source blocks, when ratio blocks of the
+     previous stage have been written into its input */
+  period[0] = 1;
+  for(i = 1; i < stage_count; i ++)
+  {
+    if(stage[i].kind == DSP_STAGE_CONVERT || stage[i].input == 0 ||
+       stage[i].in_block % stage[i - 1].out_block != 0)
+    {
+      return ERROR;
+    }
+    stage[i].ratio = stage[i].in_block / stage[i - 1].out_block;
+    stage[i].phase = 0;
+    period[i] = period[i - 1] * stage[i].ratio;
+  }
+  if(period[stage_count - 1] > DSP_PIPELINE_MAX_SCHEDULE)
+  {
+    return ERROR;
+  }
+
+  pipeline->stage = stage;
+  pipeline->stage_count = stage_count;
+  pipeline->output = output;
+  pipeline->sink = sink;
+  pipeline->schedule_length = period[stage_count - 1];
+  pipeline->slot = 0;
+  pipeline->budget = 0;
+  for(k = 0; k < pipeline->schedule_length; k ++)
+  {
+    pipeline->schedule[k] = 0;
+    for(i = 0; i < stage_count; i ++)
+    {
+      if((k + 1) % period[i] == 0)
+      {
+        pipeline->schedule[k] |= 1 << i;
+      }
+    }
+  }
+  dsp_pipeline_stats_clear(pipeline);
+
+  /* the cycle counter times every stage */
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  return SUCCESS;
+}
+
+/**
+  * @brief  clear the cycle and block counters of a pipeline and its stages
+  * @param  pipeline: pipeline
+  * @retval none
+  */
+void dsp_pipeline_stats_clear(dsp_pipeline_type *pipeline)
+{
+  uint16_t i;
+
+  for(i = 0; i < pipeline->stage_count; i ++)
+  {
+    pipeline->stage[i].runs = 0;
+    pipeline->stage[i].cycles_last = 0;
+    pipeline->stage[i].cycles_max = 0;
+    pipeline->stage[i].cycles_total = 0;
+  }
+  for(i = 0; i < DSP_PIPELINE_MAX_SCHEDULE; i ++)
+  {
+    pipeline->slot_cycles_max[i] = 0;
+  }
+  pipeline->blocks = 0;
+  pipeline->frames = 0;
+  pipeline->overruns = 0;
+  pipeline->cycles_last = 0;
+  pipeline->cycles_max = 0;
+}
+
+/**
+  * @brief  run the processing of one stage
+  * @param  stage: stage
+  * @param  input: in_block samples, adc codes for the convert stage
+  * @param  output: out_block samples
+  * @retval none
+  */
+static void dsp_stage_process(dsp_stage_type *stage, const void *input, float32_t *output)
+{
+  uint32_t i;
+
+  switch(stage->kind)
+  {
+    case DSP_STAGE_CONVERT:
+    {
+      dsp_convert_type *convert = (dsp_convert_type *)stage->instance;
+      const uint16_t *code = (const uint16_t *)input;
+
+      for(i = 0; i < stage->in_block; i ++)
+      {
+        output[i] = ((float32_t)code[i] - convert->offset) * convert->scale;
+      }
+      break;
+    }
+    case DSP_STAGE_FIR:
+      arm_fir_f32((arm_fir_instance_f32 *)stage->instance, (const float32_t *)input, output, stage->in_block);
+      break;
+    case DSP_STAGE_BIQUAD:
+      arm_biquad_cascade_df2T_f32((arm_biquad_cascade_df2T_instance_f32 *)stage->instance,
+                                  (const float32_t *)input, output, stage->in_block);
+      break;
+    case DSP_STAGE_DECIMATE:
+      arm_fir_decimate_f32((arm_fir_decimate_instance_f32 *)stage->instance,
+                           (const float32_t *)input, output, stage->in_block);
+      break;
+    case DSP_STAGE_FFT:
+    {
+      dsp_fft_type *fft = (dsp_fft_type *)stage->instance;
+      float32_t *samples = (float32_t *)input;
+
+      if(fft->window != 0)
+      {
+        arm_mult_f32(samples, fft->window, samples, stage->in_block);
+      }
+      arm_rfft_fast_f32(&fft->rfft, samples, fft->work, 0);
+      arm_cmplx_mag_f32(fft->work, output, stage->out_block);
+
+      /* the first pair packs the real dc and nyquist bins */
+      output[0] = fabsf(fft->work[0]);
+      break;
+    }
+    case DSP_STAGE_LEVEL:
+    {
+      dsp_level_type *level = (dsp_level_type *)stage->instance;
+
+      arm_rms_f32((const float32_t *)input, stage->in_block, &level->rms);
+      arm_absmax_f32((const float32_t *)input, stage->in_block, &level->peak, &i);
+      if(level->peak > level->peak_hold)
+      {
+        level->peak_hold = level->peak;
+      }
+      arm_copy_f32((const float32_t *)input, output, stage->in_block);
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+/**
+  * @brief  process one source block, called from the dma half and full
+  *         transfer interrupts so that every block takes the path of its
+  *         schedule entry and the cycles per entry stay the same
+  * @param  pipeline: pipeline
+  * @param  samples: in_block adc codes of the first stage
+  * @retval none
+  */
+void dsp_pipeline_run(dsp_pipeline_type *pipeline, const uint16_t *samples)
+{
+  dsp_stage_type *stage = pipeline->stage;
+  uint32_t mask = pipeline->schedule[pipeline->slot];
+  uint32_t start = DWT->CYCCNT;
+  uint32_t begin, cycles;
+  const void *input = samples;
+  float32_t *output;
+  uint16_t i;
+
+  for(i = 0; i < pipeline->stage_count; i ++)
+  {
+    /* periods grow along the chain, the first idle stage ends the block */
+    if((mask & (1 << i)) == 0)
+    {
+      break;
+    }
+
+    /* write straight into the next input at the slot of this block */
+    if(i + 1 < pipeline->stage_count)
+    {
+      output = stage[i + 1].input + stage[i + 1].phase * stage[i].out_block;
+    }
+    else
+    {
+      output = pipeline->output;
+    }
+
+    begin = DWT->CYCCNT;
+    dsp_stage_process(&stage[i], input, output);
+    cycles = DWT->CYCCNT - begin;
+
+    stage[i].cycles_last = cycles;
+    stage[i].cycles_total += cycles;
+    if(cycles > stage[i].cycles_max)
+    {
+      stage[i].cycles_max = cycles;
+    }
+    stage[i].runs++;
+
+    if(i + 1 < pipeline->stage_count)
+    {
+      if(++stage[i + 1].phase == stage[i + 1].ratio)
+      {
+        stage[i + 1].phase = 0;
+      }
+      input = stage[i + 1].input;
+    }
+    else
+    {
+      pipeline->frames++;
+      if(pipeline->sink != 0)
+      {
+        pipeline->sink(pipeline->output, stage[i].out_block);
+      }
+    }
+  }
+
+  cycles = DWT->CYCCNT - start;
+  pipeline->cycles_last = cycles;
+  if(cycles > pipeline->cycles_max)
+  {
+    pipeline->cycles_max = cycles;
+  }
+  if(cycles > pipeline->slot_cycles_max[pipeline->slot])
+  {
+    pipeline->slot_cycles_max[pipeline->slot] = cycles;
+  }
+  if(pipeline->budget != 0 && cycles > pipeline->budget)
+  {
+    pipeline->overruns++;
+  }
+  pipeline->blocks++;
+
+  if(++pipeline->slot == pipeline->schedule_length)
+  {
+    pipeline->slot = 0;
+  }
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
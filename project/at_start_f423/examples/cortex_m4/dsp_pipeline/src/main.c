@@ -0,0 +1,393 @@
+/**
+  **************************************************************************
+  * @file     main.c
+  * @brief    main program
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "at32f423_board.h"
+#include "at32f423_clock.h"
+#include "dsp_pipeline.h"
+#include "arm_dsp_tables_report.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_CORTEX_m4_dsp_pipeline CORTEX_m4_dsp_pipeline
+  * @{
+  */
+
+/* adc sample rate, tmr3 overflows at sclk / DSP_SAMPLE_RATE */
+#define DSP_SAMPLE_RATE                  25600
+/* samples per dma half transfer */
+#define DSP_BLOCK                        256
+#define DSP_DECIMATION                   4
+#define DSP_FIR_TAPS                     32
+#define DSP_BIQUAD_STAGES                1
+#define DSP_FFT_LENGTH                   512
+/* source blocks between two reports */
+#define DSP_REPORT_BLOCKS                200
+
+/* 2.4 khz anti-alias lowpass of the decimator, hamming windowed sinc */
+static const float32_t decimate_coeffs[DSP_FIR_TAPS] =
+{
+  +0.00047589f, +0.00151411f, +0.00274609f, +0.00364049f,
+  +0.00290445f, -0.00087967f, -0.00806521f, -0.01681916f,
+  -0.02282894f, -0.02031463f, -0.00420346f, +0.02733640f,
+  +0.07115427f, +0.11913242f, +0.16023510f, +0.18397184f,
+  +0.18397184f, +0.16023510f, +0.11913242f, +0.07115427f,
+  +0.02733640f, -0.00420346f, -0.02031463f, -0.02282894f,
+  -0.01681916f, -0.00806521f, -0.00087967f, +0.00290445f,
+  +0.00364049f, +0.00274609f, +0.00151411f, +0.00047589f,
+};
+
+/* 10 hz highpass removing the adc bias, b0 b1 b2 a1 a2 */
+static const float32_t biquad_coeffs[5 * DSP_BIQUAD_STAGES] =
+{
+  0.99826599f, -1.99653197f, 0.99826599f, 1.99652897f, -0.99653498f,
+};
+
+/* dma target, one half is processed while the other is filled */
+static uint16_t adc_buffer[2 * DSP_BLOCK];
+
+/* stage inputs, written in place by the previous stage */
+static float32_t biquad_input[DSP_BLOCK];
+static float32_t decimate_input[DSP_BLOCK];
+static float32_t level_input[DSP_BLOCK / DSP_DECIMATION];
+static float32_t fft_input[DSP_FFT_LENGTH];
+static float32_t spectrum[DSP_FFT_LENGTH / 2];
+
+static float32_t biquad_state[2 * DSP_BIQUAD_STAGES];
+static float32_t decimate_state[DSP_FIR_TAPS + DSP_BLOCK - 1];
+static float32_t fft_window[DSP_FFT_LENGTH];
+static float32_t fft_work[DSP_FFT_LENGTH];
+
+static dsp_convert_type convert;
+static arm_biquad_cascade_df2T_instance_f32 biquad;
+static arm_fir_decimate_instance_f32 decimate;
+static dsp_level_type level;
+static dsp_fft_type fft;
+
+static dsp_stage_type stages[5];
+static dsp_pipeline_type pipeline;
+
+/* copy of the last spectrum for the main loop */
+static float32_t spectrum_view[DSP_FFT_LENGTH / 2];
+__IO uint32_t spectrum_count = 0;
+
+/**
+  * @brief  pipeline sink, keeps the spectrum of the last frame
+  * @param  output: bin magnitudes
+  * @param  length: number of bins
+  * @retval none
+  */
+static void spectrum_sink(const float32_t *output, uint16_t length)
+{
+  arm_copy_f32(output, spectrum_view, length);
+  spectrum_count++;
+}
+
+/**
+  * @brief  build the stages and the pipeline.
+  * @param  none
+  * @retval error_status
+  */
+static error_status pipeline_config(void)
+{
+  uint32_t i;
+
+  for(i = 0; i < DSP_FFT_LENGTH; i ++)
+  {
+    fft_window[i] = 0.5f - 0.5f * arm_cos_f32(2.0f * PI * i / DSP_FFT_LENGTH);
+  }
+
+  convert.offset = 2048.0f;
+  convert.scale = 1.0f / 2048.0f;
+  arm_biquad_cascade_df2T_init_f32(&biquad, DSP_BIQUAD_STAGES, biquad_coeffs, biquad_state);
+  if(arm_fir_decimate_init_f32(&decimate, DSP_FIR_TAPS, DSP_DECIMATION, decimate_coeffs,
+                               decimate_state, DSP_BLOCK) != ARM_MATH_SUCCESS)
+  {
+    return ERROR;
+  }
+  fft.window = fft_window;
+  fft.work = fft_work;
+
+  dsp_stage_convert_init(&stages[0], "convert", &convert, DSP_BLOCK);
+  dsp_stage_biquad_init(&stages[1], "highpass", &biquad, biquad_input, DSP_BLOCK);
+  dsp_stage_decimate_init(&stages[2], "decimate", &decimate, decimate_input, DSP_BLOCK);
+  dsp_stage_level_init(&stages[3], "level", &level, level_input, DSP_BLOCK / DSP_DECIMATION);
+  if(dsp_stage_fft_init(&stages[4], "fft", &fft, fft_input, DSP_FFT_LENGTH) != SUCCESS)
+  {
+    return ERROR;
+  }
+
+  if(dsp_pipeline_init(&pipeline, stages, 5, spectrum, spectrum_sink) != SUCCESS)
+  {
+    return ERROR;
+  }
+
+  /* one block must be done before the next dma half completes */
+  pipeline.budget = DSP_BLOCK * (system_core_clock / DSP_SAMPLE_RATE);
+  return SUCCESS;
+}
+
+/**
+  * @brief  gpio configuration.
+  * @param  none
+  * @retval none
+  */
+static void gpio_config(void)
+{
+  gpio_init_type gpio_initstructure;
+  crm_periph_clock_enable(CRM_GPIOA_PERIPH_CLOCK, TRUE);
+
+  gpio_default_para_init(&gpio_initstructure);
+
+  /* config adc pin as analog input mode */
+  gpio_initstructure.gpio_mode = GPIO_MODE_ANALOG;
+  gpio_initstructure.gpio_pins = GPIO_PINS_4;
+  gpio_init(GPIOA, &gpio_initstructure);
+}
+
+/**
+  * @brief  tmr3 configuration, overflow event triggers each conversion.
+  * @param  none
+  * @retval none
+  */
+static void tmr3_config(void)
+{
+  crm_clocks_freq_type crm_clocks_freq_struct = {0};
+
+  crm_clocks_freq_get(&crm_clocks_freq_struct);
+  crm_periph_clock_enable(CRM_TMR3_PERIPH_CLOCK, TRUE);
+
+  tmr_base_init(TMR3, crm_clocks_freq_struct.sclk_freq / DSP_SAMPLE_RATE - 1, 0);
+  tmr_cnt_dir_set(TMR3, TMR_COUNT_UP);
+  tmr_primary_mode_select(TMR3, TMR_PRIMARY_SEL_OVERFLOW);
+}
+
+/**
+  * @brief  dma configuration.
+  * @param  none
+  * @retval none
+  */
+static void dma_config(void)
+{
+  dma_init_type dma_init_struct;
+  crm_periph_clock_enable(CRM_DMA1_PERIPH_CLOCK, TRUE);
+  nvic_irq_enable(DMA1_Channel1_IRQn, 0, 0);
+
+  dma_reset(DMA1_CHANNEL1);
+  dma_default_para_init(&dma_init_struct);
+  dma_init_struct.buffer_size = 2 * DSP_BLOCK;
+  dma_init_struct.direction = DMA_DIR_PERIPHERAL_TO_MEMORY;
+  dma_init_struct.memory_base_addr = (uint32_t)adc_buffer;
+  dma_init_struct.memory_data_width = DMA_MEMORY_DATA_WIDTH_HALFWORD;
+  dma_init_struct.memory_inc_enable = TRUE;
+  dma_init_struct.peripheral_base_addr = (uint32_t)&(ADC1->odt);
+  dma_init_struct.peripheral_data_width = DMA_PERIPHERAL_DATA_WIDTH_HALFWORD;
+  dma_init_struct.peripheral_inc_enable = FALSE;
+  dma_init_struct.priority = DMA_PRIORITY_HIGH;
+  dma_init_struct.loop_mode_enable = TRUE;
+  dma_init(DMA1_CHANNEL1, &dma_init_struct);
+
+  dmamux_enable(DMA1, TRUE);
+  dmamux_init(DMA1MUX_CHANNEL1, DMAMUX_DMAREQ_ID_ADC1);
+
+  /* enable dma half and full transfer interrupts */
+  dma_interrupt_enable(DMA1_CHANNEL1, DMA_HDT_INT, TRUE);
+  dma_interrupt_enable(DMA1_CHANNEL1, DMA_FDT_INT, TRUE);
+}
+
+/**
+  * @brief  adc configuration.
+  * @param  none
+  * @retval none
+  */
+static void adc_config(void)
+{
+  adc_common_config_type adc_common_struct;
+  adc_base_config_type adc_base_struct;
+  crm_periph_clock_enable(CRM_ADC1_PERIPH_CLOCK, TRUE);
+  adc_reset();
+  crm_adc_clock_select(CRM_ADC_CLOCK_SOURCE_HCLK);
+
+  adc_common_default_para_init(&adc_common_struct);
+
+  /* config division,adcclk is division by hclk */
+  adc_common_struct.div = ADC_HCLK_DIV_4;
+  adc_common_struct.tempervintrv_state = FALSE;
+  adc_common_config(&adc_common_struct);
+
+  adc_base_default_para_init(&adc_base_struct);
+  adc_base_struct.sequence_mode = FALSE;
+  adc_base_struct.repeat_mode = FALSE;
+  adc_base_struct.data_align = ADC_RIGHT_ALIGNMENT;
+  adc_base_struct.ordinary_channel_length = 1;
+  adc_base_config(ADC1, &adc_base_struct);
+  adc_resolution_set(ADC1, ADC_RESOLUTION_12B);
+
+  adc_ordinary_channel_set(ADC1, ADC_CHANNEL_4, 1, ADC_SAMPLETIME_47_5);
+
+  /* one conversion per tmr3 overflow */
+  adc_ordinary_conversion_trigger_set(ADC1, ADC_ORDINARY_TRIG_TMR3TRGOUT, ADC_ORDINARY_TRIG_EDGE_RISING);
+
+  adc_dma_mode_enable(ADC1, TRUE);
+  adc_dma_request_repeat_enable(ADC1, TRUE);
+
+  /* adc enable */
+  adc_enable(ADC1, TRUE);
+  while(adc_flag_get(ADC1, ADC_RDY_FLAG) == RESET);
+
+  /* adc calibration */
+  adc_calibration_init(ADC1);
+  while(adc_calibration_init_status_get(ADC1));
+  adc_calibration_start(ADC1);
+  while(adc_calibration_status_get(ADC1));
+}
+
+/**
+  * @brief  this function handles dma1_channel1 handler, each half of the
+  *         buffer is one source block of the pipeline.
+  * @param  none
+  * @retval none
+  */
+void DMA1_Channel1_IRQHandler(void)
+{
+  if(dma_interrupt_flag_get(DMA1_HDT1_FLAG) != RESET)
+  {
+    dma_flag_clear(DMA1_HDT1_FLAG);
+    dsp_pipeline_run(&pipeline, &adc_buffer[0]);
+  }
+  if(dma_interrupt_flag_get(DMA1_FDT1_FLAG) != RESET)
+  {
+    dma_flag_clear(DMA1_FDT1_FLAG);
+    dsp_pipeline_run(&pipeline, &adc_buffer[DSP_BLOCK]);
+  }
+}
+
+/**
+  * @brief  print the cmsis-dsp tables selected by arm_dsp_tables_conf.h.
+  * @param  none
+  * @retval none
+  */
+static void tables_report(void)
+{
+  const arm_dsp_table_info_t *info;
+
+  for(info = arm_dsp_table_info; info->name != 0; info++)
+  {
+    printf("  table %-24s %6d bytes\r\n", info->name, info->size);
+  }
+  printf("dsp tables %d bytes\r\n", arm_dsp_tables_size());
+}
+
+/**
+  * @brief  print the spectrum peak and the cycle accounting.
+  * @param  none
+  * @retval none
+  */
+static void pipeline_report(void)
+{
+  float32_t peak;
+  uint32_t bin;
+  uint32_t i;
+
+  /* skip the dc bin */
+  arm_max_f32(&spectrum_view[1], DSP_FFT_LENGTH / 2 - 1, &peak, &bin);
+  bin += 1;
+  printf("peak %d hz, magnitude %f, rms %f, peak hold %f\r\n",
+         (int)(bin * DSP_SAMPLE_RATE / DSP_DECIMATION / DSP_FFT_LENGTH), peak, level.rms, level.peak_hold);
+
+  printf("blocks %d, frames %d, overruns %d, cycles last %d max %d budget %d\r\n",
+         pipeline.blocks, pipeline.frames, pipeline.overruns,
+         pipeline.cycles_last, pipeline.cycles_max, pipeline.budget);
+  for(i = 0; i < pipeline.stage_count; i ++)
+  {
+    printf("  %-8s runs %6d, cycles last %6d max %6d avg %6d\r\n", stages[i].name,
+           stages[i].runs, stages[i].cycles_last, stages[i].cycles_max,
+           stages[i].runs ? (uint32_t)(stages[i].cycles_total / stages[i].runs) : 0);
+  }
+  for(i = 0; i < pipeline.schedule_length; i ++)
+  {
+    printf("  slot %2d stages 0x%02x worst %6d\r\n", i, pipeline.schedule[i], pipeline.slot_cycles_max[i]);
+  }
+}
+
+/**
+  * @brief  main function.
+  * @param  none
+  * @retval none
+  */
+int main(void)
+{
+  uint32_t report_blocks = 0;
+
+  nvic_priority_group_config(NVIC_PRIORITY_GROUP_4);
+
+  system_clock_config();
+
+  at32_board_init();
+
+  uart_print_init(115200);
+
+  tables_report();
+
+  if(pipeline_config() != SUCCESS)
+  {
+    printf("pipeline config failed\r\n");
+    at32_led_on(LED4);
+    while(1);
+  }
+
+  gpio_config();
+  tmr3_config();
+  dma_config();
+  adc_config();
+
+  /* enable DMA after ADC activation */
+  dma_channel_enable(DMA1_CHANNEL1, TRUE);
+  tmr_counter_enable(TMR3, TRUE);
+
+  printf("dsp pipeline, %d hz, block %d, fft %d\r\n", DSP_SAMPLE_RATE, DSP_BLOCK, DSP_FFT_LENGTH);
+  while(1)
+  {
+    if(pipeline.blocks - report_blocks >= DSP_REPORT_BLOCKS && spectrum_count != 0)
+    {
+      report_blocks = pipeline.blocks;
+      at32_led_toggle(LED2);
+      if(pipeline.overruns != 0)
+      {
+        at32_led_on(LED3);
+      }
+      pipeline_report();
+    }
+  }
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
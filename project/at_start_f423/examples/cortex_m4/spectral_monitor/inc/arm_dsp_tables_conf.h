@@ -0,0 +1,43 @@
+/**
+  **************************************************************************
+  * @file     arm_dsp_tables_conf.h
+  * @brief    cmsis-dsp table selection of the spectral monitor
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* define to prevent recursive inclusion -------------------------------------*/
+#ifndef _ARM_DSP_TABLES_CONF_H
+#define _ARM_DSP_TABLES_CONF_H
+
+/* only the tables used by the monitor are compiled, arm_dsp_tables.h is
+   force included by the project (--preinclude=arm_dsp_tables.h), see
+   libraries/cmsis/dsp/include/arm_dsp_tables_conf_template.h for all the
+   options */
+
+/* 128 point real fft, q31 and float builds (SPECTRAL_FIXED_POINT), follows
+   SPECTRAL_FFT_LENGTH */
+#define ARM_DSP_USE_RFFT_Q31_128
+#define ARM_DSP_USE_RFFT_FAST_F32_128
+
+/* arm_cos_f32 used to build the hann and flat-top windows */
+#define ARM_DSP_USE_COS_F32
+
+#endif
@@ -0,0 +1,172 @@
+/**
+  **************************************************************************
+  * @file     spectral_monitor.h
+  * @brief    adc spectral monitor header
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* define to prevent recursive inclusion -------------------------------------*/
+#ifndef __SPECTRAL_MONITOR_H
+#define __SPECTRAL_MONITOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* includes ------------------------------------------------------------------*/
+#include "at32f423.h"
+#include "arm_math.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_CORTEX_m4_spectral_monitor
+  * @{
+  */
+
+/* 1 runs the frames in q31 (arm_rfft_q31), 0 in float (arm_rfft_fast_f32) */
+#ifndef SPECTRAL_FIXED_POINT
+#define SPECTRAL_FIXED_POINT             1
+#endif
+
+/* fft length, a power of 2 supported by the selected rfft */
+#ifndef SPECTRAL_FFT_LENGTH
+#define SPECTRAL_FFT_LENGTH              128
+#endif
+
+/* harmonics searched above the fundamental, 2nd to SPECTRAL_HARMONICS + 1 */
+#ifndef SPECTRAL_HARMONICS
+#define SPECTRAL_HARMONICS               4
+#endif
+
+#define SPECTRAL_BINS                    (SPECTRAL_FFT_LENGTH / 2)
+
+/* frames summed per spectrum, bounds the 64 bit power sums */
+#define SPECTRAL_MAX_AVERAGE             1024
+
+/* samples and spectra, the fixed point power is 64 bit so that bins 100 db
+   below full scale keep their resolution */
+#if SPECTRAL_FIXED_POINT
+typedef q31_t spectral_value_type;
+typedef q63_t spectral_power_type;
+#else
+typedef float32_t spectral_value_type;
+typedef float32_t spectral_power_type;
+#endif
+
+/**
+  * @brief window applied to each frame
+  */
+typedef enum
+{
+  SPECTRAL_WINDOW_HANN                   = 0x00, /*!< hann, frequency resolution */
+  SPECTRAL_WINDOW_FLATTOP                = 0x01  /*!< 5 term flat-top, amplitude accuracy */
+} spectral_window_type;
+
+/**
+  * @brief overlap of two consecutive frames
+  */
+typedef enum
+{
+  SPECTRAL_OVERLAP_50                    = 0x02, /*!< hop of length / 2 */
+  SPECTRAL_OVERLAP_75                    = 0x04  /*!< hop of length / 4 */
+} spectral_overlap_type;
+
+/**
+  * @brief one spectral line
+  */
+typedef struct
+{
+  float32_t                              frequency;       /*!< hz, interpolated between bins */
+  float32_t                              level;           /*!< dbfs of a sine of this amplitude */
+} spectral_line_type;
+
+/**
+  * @brief result of spectral_monitor_analyze
+  */
+typedef struct
+{
+  spectral_line_type                     fundamental;     /*!< largest line above dc */
+  spectral_line_type                     harmonic[SPECTRAL_HARMONICS]; /*!< 2nd, 3rd... harmonic */
+  uint8_t                                harmonic_count;  /*!< harmonics below nyquist */
+  float32_t                              thd;             /*!< harmonic to fundamental power ratio, percent */
+  float32_t                              noise_floor;     /*!< median bin level, dbfs */
+} spectral_result_type;
+
+/**
+  * @brief spectral monitor, fed with one hop of adc samples per frame
+  */
+typedef struct
+{
+  spectral_window_type                   window_kind;     /*!< window of the frames */
+  uint16_t                               hop;             /*!< new samples per frame */
+  uint16_t                               head;            /*!< oldest sample of history */
+  uint16_t                               fill;            /*!< samples in history, frames start when full */
+  uint16_t                               average;         /*!< frames summed per spectrum */
+  uint16_t                               summed;          /*!< frames in sum */
+  uint8_t                                ema_shift;       /*!< exponential average weight 1 / 2^ema_shift */
+  uint8_t                                ema_primed;      /*!< average holds a spectrum */
+  float32_t                              sample_rate;     /*!< hz */
+  float32_t                              level_offset;    /*!< db from bin power to sine level, window and rfft scaling */
+  uint8_t                                lobe;            /*!< half width of the window main lobe, bins */
+#if SPECTRAL_FIXED_POINT
+  arm_rfft_instance_q31                  rfft;
+#else
+  arm_rfft_fast_instance_f32             rfft;
+#endif
+  spectral_value_type                    window[SPECTRAL_FFT_LENGTH];
+  spectral_value_type                    history[SPECTRAL_FFT_LENGTH]; /*!< ring of the last length samples */
+  spectral_value_type                    frame[SPECTRAL_FFT_LENGTH]; /*!< windowed frame, modified by the rfft */
+  spectral_value_type                    fft[2 * SPECTRAL_FFT_LENGTH];
+  spectral_power_type                    sum[SPECTRAL_BINS]; /*!< power of the frames of this spectrum */
+  spectral_power_type                    ema[SPECTRAL_BINS]; /*!< exponentially averaged spectra */
+  spectral_power_type                    spectrum[SPECTRAL_BINS]; /*!< copy of ema for the reader */
+  __IO uint8_t                           reading;         /*!< set by the reader, spectrum is not updated */
+  __IO uint32_t                          spectra;         /*!< spectra copied to spectrum */
+  uint32_t                               frames;          /*!< frames transformed */
+  uint32_t                               skipped;         /*!< spectra not copied while reading */
+  uint32_t                               overruns;        /*!< frames over budget */
+  uint32_t                               budget;          /*!< cycles allowed per frame, 0 for no check */
+  uint32_t                               cycles_last;     /*!< cycles of the last frame */
+  uint32_t                               cycles_max;      /*!< worst frame */
+} spectral_monitor_type;
+
+error_status spectral_monitor_init(spectral_monitor_type *monitor, spectral_window_type window,
+                                   spectral_overlap_type overlap, uint16_t average, uint8_t ema_shift,
+                                   float32_t sample_rate);
+void spectral_monitor_frame(spectral_monitor_type *monitor, const uint16_t *samples);
+void spectral_monitor_levels(spectral_monitor_type *monitor, float32_t *level);
+void spectral_monitor_analyze(spectral_monitor_type *monitor, const float32_t *level, spectral_result_type *result);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,314 @@
+/**
+  **************************************************************************
+  * @file     main.c
+  * @brief    main program
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "at32f423_board.h"
+#include "at32f423_clock.h"
+#include "spectral_monitor.h"
+#include "arm_dsp_tables_report.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_CORTEX_m4_spectral_monitor CORTEX_m4_spectral_monitor
+  * @{
+  */
+
+/* adc sample rate, tmr3 overflows at sclk / SAMPLE_RATE, with the 128 point
+   fft the bins are 1 khz wide */
+#define SAMPLE_RATE                      128000
+#define MONITOR_WINDOW                   SPECTRAL_WINDOW_FLATTOP
+#define MONITOR_OVERLAP                  SPECTRAL_OVERLAP_75
+/* frames summed per spectrum and exponential average weight 1 / 2^shift */
+#define MONITOR_AVERAGE                  8
+#define MONITOR_EMA_SHIFT                2
+/* spectra between two reports */
+#define REPORT_SPECTRA                   500
+
+/* dma target, one hop per half transfer, sized for the largest hop */
+static uint16_t adc_buffer[SPECTRAL_FFT_LENGTH];
+
+static spectral_monitor_type monitor;
+static float32_t level[SPECTRAL_BINS];
+static spectral_result_type result;
+
+/* both dma halves pending at once, a hop was overwritten before it was read */
+__IO uint32_t dropped_hops = 0;
+
+/**
+  * @brief  gpio configuration.
+  * @param  none
+  * @retval none
+  */
+static void gpio_config(void)
+{
+  gpio_init_type gpio_initstructure;
+  crm_periph_clock_enable(CRM_GPIOA_PERIPH_CLOCK, TRUE);
+
+  gpio_default_para_init(&gpio_initstructure);
+
+  /* config adc pin as analog input mode */
+  gpio_initstructure.gpio_mode = GPIO_MODE_ANALOG;
+  gpio_initstructure.gpio_pins = GPIO_PINS_4;
+  gpio_init(GPIOA, &gpio_initstructure);
+}
+
+/**
+  * @brief  tmr3 configuration, overflow event triggers each conversion.
+  * @param  none
+  * @retval none
+  */
+static void tmr3_config(void)
+{
+  crm_clocks_freq_type crm_clocks_freq_struct = {0};
+
+  crm_clocks_freq_get(&crm_clocks_freq_struct);
+  crm_periph_clock_enable(CRM_TMR3_PERIPH_CLOCK, TRUE);
+
+  tmr_base_init(TMR3, crm_clocks_freq_struct.sclk_freq / SAMPLE_RATE - 1, 0);
+  tmr_cnt_dir_set(TMR3, TMR_COUNT_UP);
+  tmr_primary_mode_select(TMR3, TMR_PRIMARY_SEL_OVERFLOW);
+}
+
+/**
+  * @brief  dma configuration.
+  * @param  none
+  * @retval none
+  */
+static void dma_config(void)
+{
+  dma_init_type dma_init_struct;
+  crm_periph_clock_enable(CRM_DMA1_PERIPH_CLOCK, TRUE);
+  nvic_irq_enable(DMA1_Channel1_IRQn, 0, 0);
+
+  dma_reset(DMA1_CHANNEL1);
+  dma_default_para_init(&dma_init_struct);
+  dma_init_struct.buffer_size = 2 * monitor.hop;
+  dma_init_struct.direction = DMA_DIR_PERIPHERAL_TO_MEMORY;
+  dma_init_struct.memory_base_addr = (uint32_t)adc_buffer;
+  dma_init_struct.memory_data_width = DMA_MEMORY_DATA_WIDTH_HALFWORD;
+  dma_init_struct.memory_inc_enable = TRUE;
+  dma_init_struct.peripheral_base_addr = (uint32_t)&(ADC1->odt);
+  dma_init_struct.peripheral_data_width = DMA_PERIPHERAL_DATA_WIDTH_HALFWORD;
+  dma_init_struct.peripheral_inc_enable = FALSE;
+  dma_init_struct.priority = DMA_PRIORITY_HIGH;
+  dma_init_struct.loop_mode_enable = TRUE;
+  dma_init(DMA1_CHANNEL1, &dma_init_struct);
+
+  dmamux_enable(DMA1, TRUE);
+  dmamux_init(DMA1MUX_CHANNEL1, DMAMUX_DMAREQ_ID_ADC1);
+
+  /* enable dma half and full transfer interrupts */
+  dma_interrupt_enable(DMA1_CHANNEL1, DMA_HDT_INT, TRUE);
+  dma_interrupt_enable(DMA1_CHANNEL1, DMA_FDT_INT, TRUE);
+}
+
+/**
+  * @brief  adc configuration.
+  * @param  none
+  * @retval none
+  */
+static void adc_config(void)
+{
+  adc_common_config_type adc_common_struct;
+  adc_base_config_type adc_base_struct;
+  crm_periph_clock_enable(CRM_ADC1_PERIPH_CLOCK, TRUE);
+  adc_reset();
+  crm_adc_clock_select(CRM_ADC_CLOCK_SOURCE_HCLK);
+
+  adc_common_default_para_init(&adc_common_struct);
+
+  /* config division,adcclk is division by hclk */
+  adc_common_struct.div = ADC_HCLK_DIV_4;
+  adc_common_struct.tempervintrv_state = FALSE;
+  adc_common_config(&adc_common_struct);
+
+  adc_base_default_para_init(&adc_base_struct);
+  adc_base_struct.sequence_mode = FALSE;
+  adc_base_struct.repeat_mode = FALSE;
+  adc_base_struct.data_align = ADC_RIGHT_ALIGNMENT;
+  adc_base_struct.ordinary_channel_length = 1;
+  adc_base_config(ADC1, &adc_base_struct);
+  adc_resolution_set(ADC1, ADC_RESOLUTION_12B);
+
+  adc_ordinary_channel_set(ADC1, ADC_CHANNEL_4, 1, ADC_SAMPLETIME_47_5);
+
+  /* one conversion per tmr3 overflow */
+  adc_ordinary_conversion_trigger_set(ADC1, ADC_ORDINARY_TRIG_TMR3TRGOUT, ADC_ORDINARY_TRIG_EDGE_RISING);
+
+  adc_dma_mode_enable(ADC1, TRUE);
+  adc_dma_request_repeat_enable(ADC1, TRUE);
+
+  /* adc enable */
+  adc_enable(ADC1, TRUE);
+  while(adc_flag_get(ADC1, ADC_RDY_FLAG) == RESET);
+
+  /* adc calibration */
+  adc_calibration_init(ADC1);
+  while(adc_calibration_init_status_get(ADC1));
+  adc_calibration_start(ADC1);
+  while(adc_calibration_status_get(ADC1));
+}
+
+/**
+  * @brief  this function handles dma1_channel1 handler, each half of the
+  *         buffer is one hop of the spectral monitor.
+  * @param  none
+  * @retval none
+  */
+void DMA1_Channel1_IRQHandler(void)
+{
+  if(dma_interrupt_flag_get(DMA1_HDT1_FLAG) != RESET &&
+     dma_interrupt_flag_get(DMA1_FDT1_FLAG) != RESET)
+  {
+    dropped_hops++;
+  }
+  if(dma_interrupt_flag_get(DMA1_HDT1_FLAG) != RESET)
+  {
+    dma_flag_clear(DMA1_HDT1_FLAG);
+    spectral_monitor_frame(&monitor, &adc_buffer[0]);
+  }
+  if(dma_interrupt_flag_get(DMA1_FDT1_FLAG) != RESET)
+  {
+    dma_flag_clear(DMA1_FDT1_FLAG);
+    spectral_monitor_frame(&monitor, &adc_buffer[monitor.hop]);
+  }
+}
+
+/**
+  * @brief  print the cmsis-dsp tables selected by arm_dsp_tables_conf.h.
+  * @param  none
+  * @retval none
+  */
+static void tables_report(void)
+{
+  const arm_dsp_table_info_t *info;
+
+  for(info = arm_dsp_table_info; info->name != 0; info++)
+  {
+    printf("  table %-24s %6d bytes\r\n", info->name, info->size);
+  }
+  printf("dsp tables %d bytes\r\n", arm_dsp_tables_size());
+}
+
+/**
+  * @brief  actual adc sample rate, sclk divided by the tmr3 period.
+  * @param  none
+  * @retval sample rate in hz
+  */
+static float32_t sample_rate_get(void)
+{
+  crm_clocks_freq_type crm_clocks_freq_struct = {0};
+
+  crm_clocks_freq_get(&crm_clocks_freq_struct);
+  return (float32_t)crm_clocks_freq_struct.sclk_freq / (crm_clocks_freq_struct.sclk_freq / SAMPLE_RATE);
+}
+
+/**
+  * @brief  print the lines of the last spectrum and the frame accounting.
+  * @param  none
+  * @retval none
+  */
+static void monitor_report(void)
+{
+  uint32_t i;
+
+  spectral_monitor_levels(&monitor, level);
+  spectral_monitor_analyze(&monitor, level, &result);
+
+  printf("fundamental %8.1f hz %7.2f dbfs, thd %6.3f %%, noise floor %7.2f dbfs\r\n",
+         result.fundamental.frequency, result.fundamental.level, result.thd, result.noise_floor);
+  for(i = 0; i < result.harmonic_count; i ++)
+  {
+    printf("  h%d %8.1f hz %7.2f dbfs\r\n", i + 2, result.harmonic[i].frequency, result.harmonic[i].level);
+  }
+  printf("spectra %d, frames %d, skipped %d, dropped hops %d, overruns %d, cycles last %d max %d budget %d\r\n",
+         monitor.spectra, monitor.frames, monitor.skipped, dropped_hops, monitor.overruns,
+         monitor.cycles_last, monitor.cycles_max, monitor.budget);
+}
+
+/**
+  * @brief  main function.
+  * @param  none
+  * @retval none
+  */
+int main(void)
+{
+  uint32_t report_spectra = 0;
+
+  nvic_priority_group_config(NVIC_PRIORITY_GROUP_4);
+
+  system_clock_config();
+
+  at32_board_init();
+
+  uart_print_init(115200);
+
+  tables_report();
+
+  if(spectral_monitor_init(&monitor, MONITOR_WINDOW, MONITOR_OVERLAP, MONITOR_AVERAGE,
+                           MONITOR_EMA_SHIFT, sample_rate_get()) != SUCCESS)
+  {
+    printf("spectral monitor init failed\r\n");
+    at32_led_on(LED4);
+    while(1);
+  }
+  /* a frame has to finish before the next hop is received */
+  monitor.budget = monitor.hop * (system_core_clock / SAMPLE_RATE);
+
+  gpio_config();
+  tmr3_config();
+  dma_config();
+  adc_config();
+
+  /* enable DMA after ADC activation */
+  dma_channel_enable(DMA1_CHANNEL1, TRUE);
+  tmr_counter_enable(TMR3, TRUE);
+
+  printf("spectral monitor, %s, %d hz, fft %d, hop %d, bin %d hz\r\n",
+         SPECTRAL_FIXED_POINT ? "q31" : "f32", SAMPLE_RATE, SPECTRAL_FFT_LENGTH, monitor.hop,
+         SAMPLE_RATE / SPECTRAL_FFT_LENGTH);
+  while(1)
+  {
+    if(monitor.spectra - report_spectra >= REPORT_SPECTRA)
+    {
+      report_spectra = monitor.spectra;
+      at32_led_toggle(LED2);
+      if(monitor.overruns != 0 || dropped_hops != 0)
+      {
+        at32_led_on(LED3);
+      }
+      monitor_report();
+    }
+  }
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,434 @@
+/**
+  **************************************************************************
+  * @file     spectral_monitor.c
+  * @brief    adc spectral monitor
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "spectral_monitor.h"
+#include <math.h>
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_CORTEX_m4_spectral_monitor
+  * @{
+  */
+
+/* 5 term flat-top window coefficients */
+#define FLATTOP_A0                       0.21557895f
+#define FLATTOP_A1                       0.41663158f
+#define FLATTOP_A2                       0.277263158f
+#define FLATTOP_A3                       0.083578947f
+#define FLATTOP_A4                       0.006947368f
+
+/* adc code of the zero level, 12 bit right aligned */
+#define SPECTRAL_ADC_ZERO                2048
+
+/* right shift of the fixed point power, (re^2 + im^2) of a full scale bin
+   stays below 2^53 so SPECTRAL_MAX_AVERAGE frames fit the 64 bit sums */
+#define SPECTRAL_POWER_SHIFT             8
+
+/* keeps log10 finite on empty bins */
+#define SPECTRAL_POWER_MIN               1e-20f
+
+/**
+  * @brief  fill the window table and the level scaling of the window.
+  * @param  monitor: monitor to init
+  * @param  window: window kind
+  * @retval none
+  */
+static void spectral_window_build(spectral_monitor_type *monitor, spectral_window_type window)
+{
+  float32_t x, w, sum = 0.0f;
+  uint32_t i;
+
+  for(i = 0; i < SPECTRAL_FFT_LENGTH; i ++)
+  {
+    x = 2.0f * PI * i / SPECTRAL_FFT_LENGTH;
+    if(window == SPECTRAL_WINDOW_FLATTOP)
+    {
+      w = FLATTOP_A0 - FLATTOP_A1 * arm_cos_f32(x) + FLATTOP_A2 * arm_cos_f32(2.0f * x)
+          - FLATTOP_A3 * arm_cos_f32(3.0f * x) + FLATTOP_A4 * arm_cos_f32(4.0f * x);
+    }
+    else
+    {
+      w = 0.5f - 0.5f * arm_cos_f32(x);
+    }
+    sum += w;
+#if SPECTRAL_FIXED_POINT
+    /* the flat-top peak rounds to slightly above 1 */
+    monitor->window[i] = (w >= 1.0f) ? 0x7FFFFFFF : (q31_t)(w * 2147483648.0f);
+#else
+    monitor->window[i] = w;
+#endif
+  }
+
+  /* a sine of amplitude a gives a bin magnitude of a * n * gain / 2, gain the
+     mean of the window. arm_rfft_q31 scales the transform by 1 / n, which
+     cancels n in the fixed point case */
+#if SPECTRAL_FIXED_POINT
+  monitor->level_offset = 20.0f * log10f(2.0f * SPECTRAL_FFT_LENGTH / sum);
+#else
+  monitor->level_offset = 20.0f * log10f(2.0f / sum);
+#endif
+  monitor->lobe = (window == SPECTRAL_WINDOW_FLATTOP) ? 5 : 2;
+  monitor->window_kind = window;
+}
+
+/**
+  * @brief  init a spectral monitor, the history starts empty so the first
+  *         frame is transformed once length samples were received.
+  * @param  monitor: monitor to init
+  * @param  window: window applied to each frame
+  * @param  overlap: overlap of consecutive frames, sets the hop
+  * @param  average: frames summed into one spectrum before the exponential average
+  * @param  ema_shift: each spectrum is weighted 1 / 2^ema_shift in the average, 0 for none
+  * @param  sample_rate: adc sample rate in hz, used for frequencies only
+  * @retval error_status: ERROR when the fft length or the parameters are not supported
+  */
+error_status spectral_monitor_init(spectral_monitor_type *monitor, spectral_window_type window,
+                                   spectral_overlap_type overlap, uint16_t average, uint8_t ema_shift,
+                                   float32_t sample_rate)
+{
+  uint32_t i;
+
+  if(average == 0 || average > SPECTRAL_MAX_AVERAGE || ema_shift > 15 ||
+     (overlap != SPECTRAL_OVERLAP_50 && overlap != SPECTRAL_OVERLAP_75))
+  {
+    return ERROR;
+  }
+#if SPECTRAL_FIXED_POINT
+  if(arm_rfft_init_q31(&monitor->rfft, SPECTRAL_FFT_LENGTH, 0, 1) != ARM_MATH_SUCCESS)
+#else
+  if(arm_rfft_fast_init_f32(&monitor->rfft, SPECTRAL_FFT_LENGTH) != ARM_MATH_SUCCESS)
+#endif
+  {
+    return ERROR;
+  }
+
+  spectral_window_build(monitor, window);
+  monitor->hop = SPECTRAL_FFT_LENGTH / overlap;
+  monitor->head = 0;
+  monitor->fill = 0;
+  monitor->average = average;
+  monitor->summed = 0;
+  monitor->ema_shift = ema_shift;
+  monitor->ema_primed = 0;
+  monitor->sample_rate = sample_rate;
+  for(i = 0; i < SPECTRAL_BINS; i ++)
+  {
+    monitor->sum[i] = 0;
+    monitor->spectrum[i] = 0;
+  }
+  monitor->reading = 0;
+  monitor->spectra = 0;
+  monitor->frames = 0;
+  monitor->skipped = 0;
+  monitor->overruns = 0;
+  monitor->budget = 0;
+  monitor->cycles_last = 0;
+  monitor->cycles_max = 0;
+
+  /* cycle counter for the frame accounting */
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  return SUCCESS;
+}
+
+/**
+  * @brief  close the spectrum of the summed frames: mean power, exponential
+  *         average and copy for the reader when it is not reading.
+  * @param  monitor: spectral monitor
+  * @retval none
+  */
+static void spectral_monitor_publish(spectral_monitor_type *monitor)
+{
+  spectral_power_type mean;
+  uint32_t i;
+
+  for(i = 0; i < SPECTRAL_BINS; i ++)
+  {
+#if SPECTRAL_FIXED_POINT
+    mean = monitor->sum[i] / monitor->summed;
+    if(monitor->ema_primed)
+    {
+      mean = monitor->ema[i] + ((mean - monitor->ema[i]) >> monitor->ema_shift);
+    }
+#else
+    mean = monitor->sum[i] / monitor->summed;
+    if(monitor->ema_primed)
+    {
+      mean = monitor->ema[i] + (mean - monitor->ema[i]) / (float32_t)(1U << monitor->ema_shift);
+    }
+#endif
+    monitor->ema[i] = mean;
+    monitor->sum[i] = 0;
+  }
+  monitor->ema_primed = 1;
+  monitor->summed = 0;
+
+  if(monitor->reading)
+  {
+    monitor->skipped++;
+  }
+  else
+  {
+#if SPECTRAL_FIXED_POINT
+    for(i = 0; i < SPECTRAL_BINS; i ++)
+    {
+      monitor->spectrum[i] = monitor->ema[i];
+    }
+#else
+    arm_copy_f32(monitor->ema, monitor->spectrum, SPECTRAL_BINS);
+#endif
+    monitor->spectra++;
+  }
+}
+
+/**
+  * @brief  feed one hop of adc samples, the last length samples are windowed,
+  *         transformed and their power summed. called from the dma interrupt.
+  * @param  monitor: spectral monitor
+  * @param  samples: hop adc samples, 12 bit right aligned
+  * @retval none
+  */
+void spectral_monitor_frame(spectral_monitor_type *monitor, const uint16_t *samples)
+{
+  uint32_t start = DWT->CYCCNT;
+  uint32_t cycles;
+#if SPECTRAL_FIXED_POINT
+  q31_t re, im;
+#endif
+  uint16_t head = monitor->head;
+  uint16_t tail;
+  uint32_t i;
+
+  /* the history is a ring of whole hops, a hop never wraps */
+  for(i = 0; i < monitor->hop; i ++)
+  {
+#if SPECTRAL_FIXED_POINT
+    monitor->history[head + i] = ((q31_t)samples[i] - SPECTRAL_ADC_ZERO) * (1 << 20);
+#else
+    monitor->history[head + i] = ((float32_t)samples[i] - SPECTRAL_ADC_ZERO) * (1.0f / SPECTRAL_ADC_ZERO);
+#endif
+  }
+  head += monitor->hop;
+  if(head == SPECTRAL_FFT_LENGTH)
+  {
+    head = 0;
+  }
+  monitor->head = head;
+
+  if(monitor->fill < SPECTRAL_FFT_LENGTH)
+  {
+    monitor->fill += monitor->hop;
+    if(monitor->fill < SPECTRAL_FFT_LENGTH)
+    {
+      return;
+    }
+  }
+
+  /* head is now the oldest sample, window the ring in two segments */
+  tail = SPECTRAL_FFT_LENGTH - head;
+#if SPECTRAL_FIXED_POINT
+  arm_mult_q31(&monitor->history[head], monitor->window, monitor->frame, tail);
+  if(head != 0)
+  {
+    arm_mult_q31(monitor->history, &monitor->window[tail], &monitor->frame[tail], head);
+  }
+  arm_rfft_q31(&monitor->rfft, monitor->frame, monitor->fft);
+  /* arm_cmplx_mag_squared_q31 keeps 32 bits and loses the bins below about
+     -70 dbfs, the power is kept in 64 bits instead */
+  for(i = 0; i < SPECTRAL_BINS; i ++)
+  {
+    re = monitor->fft[2 * i];
+    im = monitor->fft[2 * i + 1];
+    monitor->sum[i] += ((q63_t)re * re + (q63_t)im * im) >> SPECTRAL_POWER_SHIFT;
+  }
+#else
+  arm_mult_f32(&monitor->history[head], monitor->window, monitor->frame, tail);
+  if(head != 0)
+  {
+    arm_mult_f32(monitor->history, &monitor->window[tail], &monitor->frame[tail], head);
+  }
+  arm_rfft_fast_f32(&monitor->rfft, monitor->frame, monitor->fft, 0);
+  /* fft[1] holds the nyquist bin packed next to dc */
+  monitor->sum[0] += monitor->fft[0] * monitor->fft[0];
+  for(i = 1; i < SPECTRAL_BINS; i ++)
+  {
+    monitor->sum[i] += monitor->fft[2 * i] * monitor->fft[2 * i] + monitor->fft[2 * i + 1] * monitor->fft[2 * i + 1];
+  }
+#endif
+  monitor->frames++;
+
+  if(++monitor->summed == monitor->average)
+  {
+    spectral_monitor_publish(monitor);
+  }
+
+  cycles = DWT->CYCCNT - start;
+  monitor->cycles_last = cycles;
+  if(cycles > monitor->cycles_max)
+  {
+    monitor->cycles_max = cycles;
+  }
+  if(monitor->budget != 0 && cycles > monitor->budget)
+  {
+    monitor->overruns++;
+  }
+}
+
+/**
+  * @brief  level of every bin of the last spectrum, in dbfs of a sine whose
+  *         frequency is at the bin center. called from the main loop.
+  * @param  monitor: spectral monitor
+  * @param  level: SPECTRAL_BINS levels
+  * @retval none
+  */
+void spectral_monitor_levels(spectral_monitor_type *monitor, float32_t *level)
+{
+  uint32_t i;
+
+  /* the interrupt skips the copy while the flag is set */
+  monitor->reading = 1;
+  for(i = 0; i < SPECTRAL_BINS; i ++)
+  {
+#if SPECTRAL_FIXED_POINT
+    /* q31 products are 2^62 at full scale */
+    level[i] = 10.0f * log10f((float32_t)monitor->spectrum[i] * (1.0f / (float32_t)(1ULL << (62 - SPECTRAL_POWER_SHIFT))) + SPECTRAL_POWER_MIN);
+#else
+    level[i] = 10.0f * log10f(monitor->spectrum[i] + SPECTRAL_POWER_MIN);
+#endif
+    level[i] += monitor->level_offset;
+  }
+  monitor->reading = 0;
+}
+
+/**
+  * @brief  interpolate a spectral line around a local maximum bin. hann uses
+  *         a parabola through the levels of the bin and its two neighbours,
+  *         the flat top is too flat for it and uses the power centroid of
+  *         the five bins around the maximum.
+  * @param  monitor: spectral monitor
+  * @param  level: SPECTRAL_BINS levels
+  * @param  bin: maximum bin, 2 to SPECTRAL_BINS - 3
+  * @param  line: frequency and level of the line
+  * @retval none
+  */
+static void spectral_line_get(spectral_monitor_type *monitor, const float32_t *level, uint32_t bin, spectral_line_type *line)
+{
+  float32_t left = level[bin - 1], center = level[bin], right = level[bin + 1];
+  float32_t den = left - 2.0f * center + right;
+  float32_t delta = 0.0f, power, total = 0.0f;
+  int32_t i;
+
+  if(monitor->window_kind == SPECTRAL_WINDOW_FLATTOP)
+  {
+    for(i = -2; i <= 2; i ++)
+    {
+      power = powf(10.0f, (level[bin + i] - center) / 10.0f);
+      delta += i * power;
+      total += power;
+    }
+    delta /= total;
+    /* the flat-top level is already within 0.01 db at any offset */
+    line->level = center;
+  }
+  else
+  {
+    if(den < 0.0f)
+    {
+      delta = 0.5f * (left - right) / den;
+    }
+    line->level = center - 0.25f * (left - right) * delta;
+  }
+  line->frequency = (bin + delta) * monitor->sample_rate / SPECTRAL_FFT_LENGTH;
+}
+
+/**
+  * @brief  largest bin of level[first..last]
+  * @param  level: SPECTRAL_BINS levels
+  * @param  first: first bin searched
+  * @param  last: last bin searched
+  * @retval the bin
+  */
+static uint32_t spectral_bin_max(const float32_t *level, uint32_t first, uint32_t last)
+{
+  uint32_t bin = first;
+
+  for(first++; first <= last; first ++)
+  {
+    if(level[first] > level[bin])
+    {
+      bin = first;
+    }
+  }
+  return bin;
+}
+
+/**
+  * @brief  find the fundamental, its harmonics and the noise floor.
+  * @param  monitor: spectral monitor
+  * @param  level: SPECTRAL_BINS levels from spectral_monitor_levels
+  * @param  result: lines, thd and noise floor
+  * @retval none
+  */
+void spectral_monitor_analyze(spectral_monitor_type *monitor, const float32_t *level, spectral_result_type *result)
+{
+  static float32_t sorted[SPECTRAL_BINS];
+  arm_sort_instance_f32 sort;
+  float32_t bin_width = monitor->sample_rate / SPECTRAL_FFT_LENGTH;
+  float32_t harmonic_power = 0.0f;
+  uint32_t bin, h;
+
+  /* dc leaks over the main lobe of the window */
+  bin = spectral_bin_max(level, monitor->lobe, SPECTRAL_BINS - 3);
+  spectral_line_get(monitor, level, bin, &result->fundamental);
+
+  result->harmonic_count = 0;
+  for(h = 0; h < SPECTRAL_HARMONICS; h ++)
+  {
+    bin = (uint32_t)((h + 2) * result->fundamental.frequency / bin_width + 0.5f);
+    if(bin + 4 >= SPECTRAL_BINS)
+    {
+      break;
+    }
+    bin = spectral_bin_max(level, bin - 1, bin + 1);
+    spectral_line_get(monitor, level, bin, &result->harmonic[h]);
+    harmonic_power += powf(10.0f, (result->harmonic[h].level - result->fundamental.level) / 10.0f);
+    result->harmonic_count++;
+  }
+  result->thd = 100.0f * sqrtf(harmonic_power);
+
+  arm_sort_init_f32(&sort, ARM_SORT_INSERTION, ARM_SORT_ASCENDING);
+  arm_sort_f32(&sort, (float32_t *)level, sorted, SPECTRAL_BINS);
+  result->noise_floor = sorted[SPECTRAL_BINS / 2];
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,123 @@
+/**
+  **************************************************************************
+  * @file     clk_dvfs.h
+  * @brief    clock operating point service header
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* define to prevent recursive inclusion -------------------------------------*/
+#ifndef __CLK_DVFS_H
+#define __CLK_DVFS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* includes ------------------------------------------------------------------*/
+#include "at32f423.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_CRM_clock_scaling
+  * @{
+  */
+
+/* operating point used by clk_dvfs_boost_begin() */
+#ifndef CLK_DVFS_BOOST_POINT
+#define CLK_DVFS_BOOST_POINT             CLK_POINT_150M
+#endif
+
+/**
+  * @brief operating points, built from the hext crystal
+  */
+typedef enum
+{
+  CLK_POINT_150M                         = 0x00, /*!< pll 150mhz, ldo 1.3v */
+  CLK_POINT_96M                          = 0x01, /*!< pll 96mhz, ldo 1.2v */
+  CLK_POINT_48M                          = 0x02, /*!< pll 48mhz, ldo 1.1v */
+  CLK_POINT_8M                           = 0x03, /*!< hext 8mhz, pll off, ldo 1.1v */
+  CLK_POINT_NUM                          = 0x04
+} clk_point_id_type;
+
+/**
+  * @brief operating point, precomputed at build time
+  */
+typedef struct
+{
+  uint32_t                               sclk_freq;       /*!< system clock in hz */
+  uint32_t                               apb1_freq;       /*!< apb1 clock in hz */
+  uint32_t                               apb2_freq;       /*!< apb2 clock in hz */
+  crm_sclk_type                          sclk;            /*!< system clock source */
+  uint16_t                               pll_ns;          /*!< pll multiplication */
+  uint16_t                               pll_ms;          /*!< pll pre-division */
+  crm_pll_fr_type                        pll_fr;          /*!< pll post-division */
+  crm_ahb_div_type                       ahb_div;         /*!< ahb divider */
+  crm_apb1_div_type                      apb1_div;        /*!< apb1 divider */
+  crm_apb2_div_type                      apb2_div;        /*!< apb2 divider */
+  flash_wait_cycle_type                  wait_cycle;      /*!< flash wait cycles */
+  pwc_ldo_output_voltage_type            ldo;             /*!< ldo output voltage */
+} clk_point_type;
+
+/**
+  * @brief notifier events
+  */
+typedef enum
+{
+  CLK_EVENT_PRE_CHANGE                   = 0x00, /*!< before the change, return ERROR to refuse it */
+  CLK_EVENT_POST_CHANGE                  = 0x01, /*!< after the change, recompute baud rates and dividers */
+  CLK_EVENT_ABORT                        = 0x02  /*!< the change announced by pre change was refused */
+} clk_event_type;
+
+typedef error_status (*clk_notify_type)(clk_event_type event, const clk_point_type *point);
+
+/**
+  * @brief notifier, registered by every driver that derives rates from a bus clock
+  */
+typedef struct clk_notifier_struct
+{
+  clk_notify_type                        notify;          /*!< callback */
+  struct clk_notifier_struct             *next;           /*!< registration list */
+} clk_notifier_type;
+
+void clk_dvfs_init(clk_point_id_type id);
+error_status clk_dvfs_set(clk_point_id_type id);
+clk_point_id_type clk_dvfs_get(void);
+const clk_point_type *clk_dvfs_point(clk_point_id_type id);
+void clk_notifier_register(clk_notifier_type *notifier);
+error_status clk_dvfs_base_set(clk_point_id_type id);
+error_status clk_dvfs_boost_begin(void);
+void clk_dvfs_boost_end(void);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,272 @@
+/**
+  **************************************************************************
+  * @file     clk_dvfs.c
+  * @brief    clock operating point service
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* includes ------------------------------------------------------------------*/
+#include "clk_dvfs.h"
+#include "at32f423_board.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_CRM_clock_scaling
+  * @{
+  */
+
+/* sclk = (hext * pll_ns) / (pll_ms * pll_fr) / 2, hext = 8mhz */
+static const clk_point_type clk_point_table[CLK_POINT_NUM] =
+{
+  {150000000, 75000000, 150000000, CRM_SCLK_PLL, 75, 1, CRM_PLL_FR_2,
+   CRM_AHB_DIV_1, CRM_APB1_DIV_2, CRM_APB2_DIV_1, FLASH_WAIT_CYCLE_4, PWC_LDO_OUTPUT_1V3},
+  { 96000000, 96000000,  96000000, CRM_SCLK_PLL, 96, 1, CRM_PLL_FR_4,
+   CRM_AHB_DIV_1, CRM_APB1_DIV_1, CRM_APB2_DIV_1, FLASH_WAIT_CYCLE_2, PWC_LDO_OUTPUT_1V2},
+  { 48000000, 48000000,  48000000, CRM_SCLK_PLL, 96, 1, CRM_PLL_FR_8,
+   CRM_AHB_DIV_1, CRM_APB1_DIV_1, CRM_APB2_DIV_1, FLASH_WAIT_CYCLE_1, PWC_LDO_OUTPUT_1V1},
+  {  8000000,  8000000,   8000000, CRM_SCLK_HEXT, 0, 0, CRM_PLL_FR_1,
+   CRM_AHB_DIV_1, CRM_APB1_DIV_1, CRM_APB2_DIV_1, FLASH_WAIT_CYCLE_0, PWC_LDO_OUTPUT_1V1},
+};
+
+static clk_point_id_type current_point = CLK_POINT_NUM;
+static clk_point_id_type base_point = CLK_POINT_NUM;
+static uint32_t boost_count = 0;
+static clk_notifier_type *notifier_list = 0;
+
+/**
+  * @brief  switch the clock tree, ldo and flash wait cycles are raised
+  *         before the clock goes up and lowered after it went down, the
+  *         dividers change while the system runs from hext.
+  * @param  point: target operating point
+  * @retval none
+  */
+static void clk_dvfs_apply(const clk_point_type *point)
+{
+  if(point->ldo > PWC->ldoov_bit.ldoovsel)
+  {
+    pwc_ldo_output_voltage_set(point->ldo);
+  }
+  if(point->wait_cycle > FLASH->psr_bit.wtcyc)
+  {
+    flash_psr_set(point->wait_cycle);
+  }
+
+  if(crm_sysclk_switch_status_get() != CRM_SCLK_HEXT)
+  {
+    crm_sysclk_switch(CRM_SCLK_HEXT);
+    while(crm_sysclk_switch_status_get() != CRM_SCLK_HEXT);
+  }
+  crm_ahb_div_set(point->ahb_div);
+  crm_apb2_div_set(point->apb2_div);
+  crm_apb1_div_set(point->apb1_div);
+
+  /* the pll can only be programmed while it is off */
+  crm_clock_source_enable(CRM_CLOCK_SOURCE_PLL, FALSE);
+  if(point->sclk == CRM_SCLK_PLL)
+  {
+    crm_pll_config(CRM_PLL_SOURCE_HEXT, point->pll_ns, point->pll_ms, point->pll_fr);
+    crm_clock_source_enable(CRM_CLOCK_SOURCE_PLL, TRUE);
+    while(crm_flag_get(CRM_PLL_STABLE_FLAG) != SET);
+
+    /* auto step mode is handled by crm_sysclk_switch */
+    crm_sysclk_switch(CRM_SCLK_PLL);
+    while(crm_sysclk_switch_status_get() != CRM_SCLK_PLL);
+  }
+
+  if(point->wait_cycle < FLASH->psr_bit.wtcyc)
+  {
+    flash_psr_set(point->wait_cycle);
+  }
+  if(point->ldo < PWC->ldoov_bit.ldoovsel)
+  {
+    pwc_ldo_output_voltage_set(point->ldo);
+  }
+
+  system_core_clock_update();
+}
+
+/**
+  * @brief  call the notifiers.
+  * @param  event: event
+  * @param  point: target operating point
+  * @param  last: stop before this notifier, 0 for all
+  * @retval the first notifier that refused a pre change, 0 if none
+  */
+static clk_notifier_type *clk_dvfs_notify(clk_event_type event, const clk_point_type *point,
+                                          clk_notifier_type *last)
+{
+  clk_notifier_type *notifier;
+
+  for(notifier = notifier_list; notifier != last; notifier = notifier->next)
+  {
+    if(notifier->notify(event, point) != SUCCESS && event == CLK_EVENT_PRE_CHANGE)
+    {
+      return notifier;
+    }
+  }
+
+  return 0;
+}
+
+/**
+  * @brief  start the hext crystal and enter the first operating point,
+  *         replaces system_clock_config().
+  * @param  id: operating point
+  * @retval none
+  */
+void clk_dvfs_init(clk_point_id_type id)
+{
+  crm_periph_clock_enable(CRM_PWC_PERIPH_CLOCK, TRUE);
+
+  crm_clock_source_enable(CRM_CLOCK_SOURCE_HEXT, TRUE);
+  while(crm_hext_stable_wait() == ERROR);
+
+  clk_dvfs_apply(&clk_point_table[id]);
+  current_point = id;
+  base_point = id;
+  boost_count = 0;
+}
+
+/**
+  * @brief  change the operating point. the notifiers may refuse it, the
+  *         clock tree itself changes with interrupts disabled.
+  * @param  id: operating point
+  * @retval SUCCESS or ERROR if a notifier refused the change
+  */
+error_status clk_dvfs_set(clk_point_id_type id)
+{
+  const clk_point_type *point = &clk_point_table[id];
+  clk_notifier_type *refused;
+
+  if(id == current_point)
+  {
+    return SUCCESS;
+  }
+
+  refused = clk_dvfs_notify(CLK_EVENT_PRE_CHANGE, point, 0);
+  if(refused != 0)
+  {
+    clk_dvfs_notify(CLK_EVENT_ABORT, point, refused);
+    return ERROR;
+  }
+
+  __disable_irq();
+  clk_dvfs_apply(point);
+  current_point = id;
+  __enable_irq();
+
+  /* board delay follows the new system clock */
+  delay_init();
+
+  clk_dvfs_notify(CLK_EVENT_POST_CHANGE, point, 0);
+
+  return SUCCESS;
+}
+
+/**
+  * @brief  current operating point.
+  * @param  none
+  * @retval operating point
+  */
+clk_point_id_type clk_dvfs_get(void)
+{
+  return current_point;
+}
+
+/**
+  * @brief  operating point parameters.
+  * @param  id: operating point
+  * @retval parameters
+  */
+const clk_point_type *clk_dvfs_point(clk_point_id_type id)
+{
+  return &clk_point_table[id];
+}
+
+/**
+  * @brief  register a notifier.
+  * @param  notifier: notifier with notify set
+  * @retval none
+  */
+void clk_notifier_register(clk_notifier_type *notifier)
+{
+  notifier->next = notifier_list;
+  notifier_list = notifier;
+}
+
+/**
+  * @brief  set the operating point used outside of boosts.
+  * @param  id: operating point
+  * @retval SUCCESS or ERROR if a notifier refused the change
+  */
+error_status clk_dvfs_base_set(clk_point_id_type id)
+{
+  base_point = id;
+  if(boost_count != 0)
+  {
+    return SUCCESS;
+  }
+
+  return clk_dvfs_set(id);
+}
+
+/**
+  * @brief  enter the boost point for a burst of work, boosts nest.
+  * @param  none
+  * @retval SUCCESS or ERROR if a notifier refused the change
+  */
+error_status clk_dvfs_boost_begin(void)
+{
+  if(boost_count == 0 && clk_dvfs_set(CLK_DVFS_BOOST_POINT) != SUCCESS)
+  {
+    return ERROR;
+  }
+  boost_count++;
+
+  return SUCCESS;
+}
+
+/**
+  * @brief  leave a boost, the base point returns with the last one.
+  * @param  none
+  * @retval none
+  */
+void clk_dvfs_boost_end(void)
+{
+  if(boost_count != 0)
+  {
+    boost_count--;
+    if(boost_count == 0)
+    {
+      clk_dvfs_set(base_point);
+    }
+  }
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,232 @@
+/**
+  **************************************************************************
+  * @file     main.c
+  * @brief    main program
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "at32f423_board.h"
+#include "at32f423_clock.h"
+#include "clk_dvfs.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_CRM_clock_scaling CRM_clock_scaling
+  * @{
+  */
+
+#define WORK_SAMPLES                     256
+#define WORK_TAPS                        64
+
+float work_input[WORK_SAMPLES + WORK_TAPS];
+float work_coeff[WORK_TAPS];
+float work_output[WORK_SAMPLES];
+
+static void clkout_config(void);
+static void tmr3_config(void);
+static error_status uart_clock_notify(clk_event_type event, const clk_point_type *point);
+static error_status tmr3_clock_notify(clk_event_type event, const clk_point_type *point);
+static uint16_t dsp_work(void);
+
+clk_notifier_type uart_notifier = {uart_clock_notify, 0};
+clk_notifier_type tmr3_notifier = {tmr3_clock_notify, 0};
+
+/**
+  * @brief  clkout configuration.
+  * @param  none
+  * @retval none
+  */
+static void clkout_config(void)
+{
+  gpio_init_type gpio_init_struct;
+
+  /* enable gpio port clock */
+  crm_periph_clock_enable(CRM_GPIOA_PERIPH_CLOCK, TRUE);
+
+  /* set default parameter */
+  gpio_default_para_init(&gpio_init_struct);
+
+  /* clkout gpio init */
+  gpio_init_struct.gpio_drive_strength = GPIO_DRIVE_STRENGTH_STRONGER;
+  gpio_init_struct.gpio_mode = GPIO_MODE_MUX;
+  gpio_init_struct.gpio_pins = GPIO_PINS_8;
+  gpio_init_struct.gpio_pull = GPIO_PULL_NONE;
+  gpio_init(GPIOA, &gpio_init_struct);
+
+  /* config clkout division */
+  crm_clkout_div_set(CRM_CLKOUT_DIV1_4, CRM_CLKOUT_DIV2_1);
+
+  /* config clkout clock */
+  crm_clock_out_set(CRM_CLKOUT_SCLK);
+}
+
+/**
+  * @brief  tmr3 1mhz free running counter, times the work bursts.
+  * @param  none
+  * @retval none
+  */
+static void tmr3_config(void)
+{
+  crm_periph_clock_enable(CRM_TMR3_PERIPH_CLOCK, TRUE);
+
+  tmr_base_init(TMR3, 0xFFFF, 0);
+  tmr_cnt_dir_set(TMR3, TMR_COUNT_UP);
+  tmr3_clock_notify(CLK_EVENT_POST_CHANGE, clk_dvfs_point(clk_dvfs_get()));
+  tmr_counter_enable(TMR3, TRUE);
+}
+
+/**
+  * @brief  print uart notifier, drains the last byte before the change
+  *         and recomputes the baud rate after it.
+  * @param  event: clock event
+  * @param  point: target operating point
+  * @retval SUCCESS
+  */
+static error_status uart_clock_notify(clk_event_type event, const clk_point_type *point)
+{
+  if(event == CLK_EVENT_PRE_CHANGE)
+  {
+    while(usart_flag_get(PRINT_UART, USART_TDC_FLAG) == RESET);
+  }
+  else if(event == CLK_EVENT_POST_CHANGE)
+  {
+    usart_init(PRINT_UART, 115200, USART_DATA_8BITS, USART_STOP_1_BIT);
+  }
+
+  return SUCCESS;
+}
+
+/**
+  * @brief  tmr3 notifier, keeps the counter at 1mhz.
+  * @param  event: clock event
+  * @param  point: target operating point
+  * @retval SUCCESS
+  */
+static error_status tmr3_clock_notify(clk_event_type event, const clk_point_type *point)
+{
+  uint32_t tmr_clock;
+
+  if(event == CLK_EVENT_POST_CHANGE)
+  {
+    /* apb1 timers run at twice the apb1 clock when it is divided */
+    tmr_clock = (point->apb1_div == CRM_APB1_DIV_1) ? point->apb1_freq : point->apb1_freq * 2;
+    tmr_div_value_set(TMR3, (tmr_clock / 1000000) - 1);
+    tmr_event_sw_trigger(TMR3, TMR_OVERFLOW_SWTRIG);
+  }
+
+  return SUCCESS;
+}
+
+/**
+  * @brief  a burst of fir filtering.
+  * @param  none
+  * @retval duration in us
+  */
+static uint16_t dsp_work(void)
+{
+  uint16_t start = (uint16_t)tmr_counter_value_get(TMR3);
+  uint32_t i_index, j_index;
+  float acc;
+
+  for(i_index = 0; i_index < WORK_SAMPLES; i_index++)
+  {
+    acc = 0;
+    for(j_index = 0; j_index < WORK_TAPS; j_index++)
+    {
+      acc += work_input[i_index + j_index] * work_coeff[j_index];
+    }
+    work_output[i_index] = acc;
+  }
+
+  return (uint16_t)tmr_counter_value_get(TMR3) - start;
+}
+
+/**
+  * @brief  main function.
+  * @param  none
+  * @retval none
+  */
+int main(void)
+{
+  static const clk_point_id_type base_list[3] = {CLK_POINT_48M, CLK_POINT_8M, CLK_POINT_96M};
+  uint32_t base_index = 0, i_index;
+  uint16_t base_us, boost_us;
+
+  /* start at the 48mhz base point instead of system_clock_config() */
+  clk_dvfs_init(base_list[base_index]);
+
+  at32_board_init();
+
+  uart_print_init(115200);
+
+  clkout_config();
+
+  tmr3_config();
+
+  clk_notifier_register(&uart_notifier);
+  clk_notifier_register(&tmr3_notifier);
+
+  for(i_index = 0; i_index < WORK_SAMPLES + WORK_TAPS; i_index++)
+  {
+    work_input[i_index] = (float)(i_index & 0x1F);
+  }
+  for(i_index = 0; i_index < WORK_TAPS; i_index++)
+  {
+    work_coeff[i_index] = 1.0f / WORK_TAPS;
+  }
+
+  while(1)
+  {
+    /* user button changes the base point */
+    if(at32_button_press() == USER_BUTTON)
+    {
+      base_index = (base_index + 1) % 3;
+      clk_dvfs_base_set(base_list[base_index]);
+      at32_led_toggle(LED4);
+    }
+
+    /* the same work at the base point and boosted to 150mhz */
+    base_us = dsp_work();
+
+    clk_dvfs_boost_begin();
+    at32_led_on(LED3);
+    boost_us = dsp_work();
+    at32_led_off(LED3);
+    clk_dvfs_boost_end();
+
+    printf("base %dmhz: %dus, boost %dmhz: %dus\r\n",
+           clk_dvfs_point(base_list[base_index])->sclk_freq / 1000000, base_us,
+           clk_dvfs_point(CLK_DVFS_BOOST_POINT)->sclk_freq / 1000000, boost_us);
+
+    at32_led_toggle(LED2);
+    delay_ms(500);
+  }
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
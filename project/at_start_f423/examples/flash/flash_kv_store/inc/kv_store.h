@@ -0,0 +1,97 @@
+/**
+  **************************************************************************
+  * @file     kv_store.h
+  * @brief    key-value store header
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __KV_STORE_H__
+#define __KV_STORE_H__
+
+#include "at32f423_board.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_FLASH_kv_store
+  * @{
+  */
+
+/** @defgroup FLASH_kv_store_definition
+  * @{
+  */
+
+#ifndef KV_SECTOR_SIZE
+#if defined (AT32F423xC)
+#define KV_SECTOR_SIZE                   2048   /* this parameter depends on the specific model of the chip */
+#else
+#define KV_SECTOR_SIZE                   1024   /* this parameter depends on the specific model of the chip */
+#endif
+#endif
+
+/* sectors used by the store, records rotate through all of them */
+#ifndef KV_START_ADDR
+#define KV_START_ADDR                    (0x08000000 + 1024 * 32)
+#endif
+
+#ifndef KV_SECTOR_NUM
+#define KV_SECTOR_NUM                    4
+#endif
+
+/* number of ram index slots, must be a power of two */
+#ifndef KV_INDEX_SIZE
+#define KV_INDEX_SIZE                    64
+#endif
+
+#ifndef KV_MAX_VALUE_LEN
+#define KV_MAX_VALUE_LEN                 128
+#endif
+
+#define KV_KEY_EMPTY                     0xFFFF /* key 0xffff is reserved */
+
+/**
+  * @}
+  */
+
+/** @defgroup FLASH_kv_store_functions
+  * @{
+  */
+
+error_status kv_init(void);
+error_status kv_set(uint16_t key, const void *data, uint16_t len);
+error_status kv_get(uint16_t key, void *data, uint16_t size, uint16_t *len);
+error_status kv_delete(uint16_t key);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#endif
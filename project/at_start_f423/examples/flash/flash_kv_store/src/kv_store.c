@@ -0,0 +1,601 @@
+/**
+  **************************************************************************
+  * @file     kv_store.c
+  * @brief    log-structured key-value store on internal flash
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "kv_store.h"
+#include "string.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_FLASH_kv_store
+  * @{
+  */
+
+/*
+  sector layout:
+    word     sequence number, orders the sectors of the log
+    halfword KV_SECTOR_MAGIC, programmed after the sequence number
+    halfword 0x0000 once the sector is obsolete and about to be erased
+    records...
+
+  record layout (halfword aligned):
+    halfword key
+    halfword value length, 0 marks the key as deleted
+    value bytes, padded to halfword with 0xff
+    halfword crc16 of key, length and value
+*/
+#define KV_SECTOR_MAGIC                  0x4B56
+#define KV_HEADER_SIZE                   8
+#define KV_RECORD_SIZE(len)              (4 + (((uint32_t)(len) + 1) & ~1u) + 2)
+#define KV_ADDR_DELETED                  0
+
+typedef struct
+{
+  uint16_t key;
+  uint32_t addr;                         /* record address in flash, KV_ADDR_DELETED if erased */
+} kv_index_type;
+
+static kv_index_type kv_index[KV_INDEX_SIZE];
+static uint32_t kv_seq[KV_SECTOR_NUM];   /* sector sequence number, 0 for a free sector */
+static uint32_t kv_max_seq;
+static uint8_t kv_head;
+static uint32_t kv_head_offset;
+
+/**
+  * @brief  crc16-ccitt over a byte buffer
+  * @param  crc: initial value
+  * @param  data: data pointer
+  * @param  len: data length
+  * @retval crc value
+  */
+static uint16_t kv_crc16(uint16_t crc, const uint8_t *data, uint32_t len)
+{
+  uint8_t i;
+  while(len--)
+  {
+    crc ^= (uint16_t)(*data++) << 8;
+    for(i = 0; i < 8; i++)
+    {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+/**
+  * @brief  get the flash address of a store sector
+  * @param  sector: sector index in the store
+  * @retval sector address
+  */
+static uint32_t kv_sector_addr(uint8_t sector)
+{
+  return KV_START_ADDR + (uint32_t)sector * KV_SECTOR_SIZE;
+}
+
+/**
+  * @brief  look up a key in the ram index
+  * @param  key: record key
+  * @param  alloc: TRUE to take a free slot when the key is not indexed yet
+  * @retval index entry or NULL
+  */
+static kv_index_type *kv_index_find(uint16_t key, confirm_state alloc)
+{
+  uint32_t i, pos = ((uint32_t)key * 0x9E37u) & (KV_INDEX_SIZE - 1);
+
+  for(i = 0; i < KV_INDEX_SIZE; i++)
+  {
+    if(kv_index[pos].key == key)
+    {
+      return &kv_index[pos];
+    }
+    if(kv_index[pos].key == KV_KEY_EMPTY)
+    {
+      if(alloc == FALSE)
+      {
+        return NULL;
+      }
+      kv_index[pos].key = key;
+      kv_index[pos].addr = KV_ADDR_DELETED;
+      return &kv_index[pos];
+    }
+    pos = (pos + 1) & (KV_INDEX_SIZE - 1);
+  }
+  return NULL;
+}
+
+/**
+  * @brief  check that a flash range is erased
+  * @param  addr: start address, halfword aligned
+  * @param  end: end address
+  * @retval SUCCESS if every halfword reads 0xffff
+  */
+static error_status kv_blank_check(uint32_t addr, uint32_t end)
+{
+  for(; addr < end; addr += 2)
+  {
+    if(*(__IO uint16_t *)addr != 0xFFFF)
+    {
+      return ERROR;
+    }
+  }
+  return SUCCESS;
+}
+
+/**
+  * @brief  program a byte buffer using halfword mode, an odd tail is padded with 0xff
+  * @param  addr: halfword aligned flash address
+  * @param  data: data pointer
+  * @param  len: data length
+  * @retval result
+  */
+static error_status kv_program(uint32_t addr, const uint8_t *data, uint32_t len)
+{
+  uint32_t i;
+  uint16_t value;
+
+  for(i = 0; i < len; i += 2)
+  {
+    value = data[i];
+    value |= (uint16_t)((i + 1 < len) ? data[i + 1] : 0xFF) << 8;
+    if(flash_halfword_program(addr + i, value) != FLASH_OPERATE_DONE)
+    {
+      return ERROR;
+    }
+  }
+  return SUCCESS;
+}
+
+/**
+  * @brief  erase a store sector and mark it free
+  * @param  sector: sector index in the store
+  * @retval result
+  */
+static error_status kv_sector_erase(uint8_t sector)
+{
+  kv_seq[sector] = 0;
+  if(flash_sector_erase(kv_sector_addr(sector)) != FLASH_OPERATE_DONE)
+  {
+    return ERROR;
+  }
+  return kv_blank_check(kv_sector_addr(sector), kv_sector_addr(sector) + KV_SECTOR_SIZE);
+}
+
+/**
+  * @brief  start a new log sector after the current head
+  * @param  sector: free sector index in the store
+  * @retval result
+  */
+static error_status kv_sector_open(uint8_t sector)
+{
+  uint32_t addr = kv_sector_addr(sector);
+
+  /* the magic is written last, a torn header leaves an invalid sector that is erased at boot */
+  kv_max_seq++;
+  if(flash_word_program(addr, kv_max_seq) != FLASH_OPERATE_DONE ||
+     flash_halfword_program(addr + 4, KV_SECTOR_MAGIC) != FLASH_OPERATE_DONE)
+  {
+    return ERROR;
+  }
+
+  kv_seq[sector] = kv_max_seq;
+  kv_head = sector;
+  kv_head_offset = KV_HEADER_SIZE;
+  return SUCCESS;
+}
+
+/**
+  * @brief  append a record at the log head and update the index
+  * @param  key: record key
+  * @param  data: value pointer, may point into flash
+  * @param  len: value length, 0 to write a delete record
+  * @retval result
+  */
+static error_status kv_record_write(uint16_t key, const uint8_t *data, uint16_t len)
+{
+  uint32_t addr = kv_sector_addr(kv_head) + kv_head_offset;
+  uint16_t head[2];
+  uint16_t crc;
+  kv_index_type *entry;
+
+  head[0] = key;
+  head[1] = len;
+  crc = kv_crc16(0xFFFF, (const uint8_t *)head, 4);
+  crc = kv_crc16(crc, data, len);
+
+  /* advance first so that a failed program never reuses a dirty area */
+  kv_head_offset += KV_RECORD_SIZE(len);
+  if(kv_program(addr, (const uint8_t *)head, 4) != SUCCESS ||
+     kv_program(addr + 4, data, len) != SUCCESS ||
+     flash_halfword_program(addr + KV_RECORD_SIZE(len) - 2, crc) != FLASH_OPERATE_DONE)
+  {
+    kv_head_offset = KV_SECTOR_SIZE;
+    return ERROR;
+  }
+
+  entry = kv_index_find(key, TRUE);
+  if(entry == NULL)
+  {
+    return ERROR;
+  }
+  entry->addr = (len != 0) ? addr : KV_ADDR_DELETED;
+  return SUCCESS;
+}
+
+/**
+  * @brief  walk the records of a sector
+  * @param  sector: sector index in the store
+  * @param  replay: TRUE to apply valid records to the index, FALSE to copy
+  *         indexed records to the log head
+  * @retval write offset of the sector, KV_SECTOR_SIZE when it must not be
+  *         appended to any more
+  */
+static uint32_t kv_sector_walk(uint8_t sector, confirm_state replay)
+{
+  uint32_t base = kv_sector_addr(sector);
+  uint32_t addr = base + KV_HEADER_SIZE;
+  uint32_t size;
+  uint16_t key, len;
+  kv_index_type *entry;
+
+  while(addr + KV_RECORD_SIZE(0) <= base + KV_SECTOR_SIZE)
+  {
+    key = *(__IO uint16_t *)addr;
+    len = *(__IO uint16_t *)(addr + 2);
+    if(key == KV_KEY_EMPTY)
+    {
+      /* end of log, anything programmed beyond comes from an interrupted write */
+      if(kv_blank_check(addr, base + KV_SECTOR_SIZE) != SUCCESS)
+      {
+        return KV_SECTOR_SIZE;
+      }
+      return addr - base;
+    }
+
+    size = KV_RECORD_SIZE(len);
+    if(len > KV_MAX_VALUE_LEN || addr + size > base + KV_SECTOR_SIZE)
+    {
+      return KV_SECTOR_SIZE;
+    }
+
+    if(replay == TRUE)
+    {
+      if(kv_crc16(0xFFFF, (const uint8_t *)addr, 4 + (uint32_t)len) == *(__IO uint16_t *)(addr + size - 2))
+      {
+        entry = kv_index_find(key, TRUE);
+        if(entry != NULL)
+        {
+          entry->addr = (len != 0) ? addr : KV_ADDR_DELETED;
+        }
+      }
+    }
+    else
+    {
+      entry = kv_index_find(key, FALSE);
+      if(entry != NULL && entry->addr == addr)
+      {
+        if(kv_head_offset + size > KV_SECTOR_SIZE ||
+           kv_record_write(key, (const uint8_t *)(addr + 4), len) != SUCCESS)
+        {
+          return 0;
+        }
+      }
+    }
+    addr += size;
+  }
+  return addr - base;
+}
+
+/**
+  * @brief  check whether a free sector is left
+  * @param  none
+  * @retval TRUE if at least one sector is free
+  */
+static confirm_state kv_spare_get(void)
+{
+  uint8_t i;
+
+  for(i = 0; i < KV_SECTOR_NUM; i++)
+  {
+    if(kv_seq[i] == 0)
+    {
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+/**
+  * @brief  move the live records of the oldest sector to the log head and erase it
+  * @param  none
+  * @retval result
+  */
+static error_status kv_compact_oldest(void)
+{
+  uint8_t i, oldest = KV_SECTOR_NUM;
+
+  for(i = 0; i < KV_SECTOR_NUM; i++)
+  {
+    if(kv_seq[i] != 0 && i != kv_head &&
+       (oldest == KV_SECTOR_NUM || kv_seq[i] < kv_seq[oldest]))
+    {
+      oldest = i;
+    }
+  }
+  if(oldest == KV_SECTOR_NUM)
+  {
+    return ERROR;
+  }
+
+  if(kv_sector_walk(oldest, FALSE) == 0)
+  {
+    return ERROR;
+  }
+
+  /* live data now exists twice, the obsolete mark makes boot finish an interrupted erase */
+  if(flash_halfword_program(kv_sector_addr(oldest) + 6, 0x0000) != FLASH_OPERATE_DONE)
+  {
+    return ERROR;
+  }
+  return kv_sector_erase(oldest);
+}
+
+/**
+  * @brief  make room for a record at the log head, rotating to the next free
+  *         sector and compacting the oldest one when no spare sector is left
+  * @param  size: record size
+  * @retval result
+  */
+static error_status kv_reserve(uint32_t size)
+{
+  uint8_t i, n, next;
+
+  for(n = 0; n <= KV_SECTOR_NUM; n++)
+  {
+    if(kv_head_offset + size <= KV_SECTOR_SIZE)
+    {
+      return SUCCESS;
+    }
+
+    /* next free sector in ring order, so every sector is erased equally often */
+    next = KV_SECTOR_NUM;
+    for(i = 1; i <= KV_SECTOR_NUM; i++)
+    {
+      if(kv_seq[(kv_head + i) % KV_SECTOR_NUM] == 0)
+      {
+        next = (kv_head + i) % KV_SECTOR_NUM;
+        break;
+      }
+    }
+    if(next == KV_SECTOR_NUM)
+    {
+      if(kv_compact_oldest() != SUCCESS)
+      {
+        return ERROR;
+      }
+      continue;
+    }
+
+    if(kv_sector_open(next) != SUCCESS)
+    {
+      kv_head_offset = KV_SECTOR_SIZE;
+      kv_sector_erase(next);
+      continue;
+    }
+
+    /* keep one spare sector so that the next compaction always has room */
+    if(kv_spare_get() == FALSE && kv_compact_oldest() != SUCCESS)
+    {
+      return ERROR;
+    }
+  }
+  return ERROR;
+}
+
+/**
+  * @brief  mount the store: finish interrupted erases and rebuild the ram
+  *         index by replaying the sectors in sequence order
+  * @param  none
+  * @retval result
+  */
+error_status kv_init(void)
+{
+  uint32_t base, last_seq = 0;
+  uint8_t i, sector;
+  error_status status = SUCCESS;
+
+  for(i = 0; i < KV_INDEX_SIZE; i++)
+  {
+    kv_index[i].key = KV_KEY_EMPTY;
+    kv_index[i].addr = KV_ADDR_DELETED;
+  }
+  kv_max_seq = 0;
+  kv_head = 0;
+  kv_head_offset = KV_SECTOR_SIZE;
+
+  flash_unlock();
+  flash_flag_clear(FLASH_PRGMERR_FLAG | FLASH_EPPERR_FLAG);
+
+  for(i = 0; i < KV_SECTOR_NUM; i++)
+  {
+    base = kv_sector_addr(i);
+    kv_seq[i] = 0;
+    if(*(__IO uint16_t *)(base + 4) == KV_SECTOR_MAGIC && *(__IO uint16_t *)(base + 6) == 0xFFFF &&
+       *(__IO uint32_t *)base != 0 && *(__IO uint32_t *)base != 0xFFFFFFFF)
+    {
+      kv_seq[i] = *(__IO uint32_t *)base;
+      if(kv_seq[i] > kv_max_seq)
+      {
+        kv_max_seq = kv_seq[i];
+      }
+    }
+    else if(kv_blank_check(base, base + KV_SECTOR_SIZE) != SUCCESS)
+    {
+      if(kv_sector_erase(i) != SUCCESS)
+      {
+        status = ERROR;
+      }
+    }
+  }
+
+  /* replay oldest first so that newer records override older ones */
+  while(1)
+  {
+    sector = KV_SECTOR_NUM;
+    for(i = 0; i < KV_SECTOR_NUM; i++)
+    {
+      if(kv_seq[i] > last_seq && (sector == KV_SECTOR_NUM || kv_seq[i] < kv_seq[sector]))
+      {
+        sector = i;
+      }
+    }
+    if(sector == KV_SECTOR_NUM)
+    {
+      break;
+    }
+    last_seq = kv_seq[sector];
+    kv_head = sector;
+    kv_head_offset = kv_sector_walk(sector, TRUE);
+  }
+
+  if(kv_max_seq == 0)
+  {
+    if(status == SUCCESS)
+    {
+      status = kv_sector_open(0);
+    }
+  }
+  else
+  {
+    /* a power loss between opening the head and compacting leaves no spare sector */
+    if(kv_spare_get() == FALSE && kv_compact_oldest() != SUCCESS)
+    {
+      status = ERROR;
+    }
+  }
+
+  flash_lock();
+  return status;
+}
+
+/**
+  * @brief  store a value, nothing is programmed when it is unchanged
+  * @param  key: record key, KV_KEY_EMPTY is reserved
+  * @param  data: value pointer
+  * @param  len: value length, 1 to KV_MAX_VALUE_LEN
+  * @retval result
+  */
+error_status kv_set(uint16_t key, const void *data, uint16_t len)
+{
+  kv_index_type *entry;
+  error_status status;
+
+  if(key == KV_KEY_EMPTY || len == 0 || len > KV_MAX_VALUE_LEN)
+  {
+    return ERROR;
+  }
+
+  entry = kv_index_find(key, TRUE);
+  if(entry == NULL)
+  {
+    return ERROR;
+  }
+  if(entry->addr != KV_ADDR_DELETED && *(__IO uint16_t *)(entry->addr + 2) == len &&
+     memcmp((const void *)(entry->addr + 4), data, len) == 0)
+  {
+    return SUCCESS;
+  }
+
+  flash_unlock();
+  flash_flag_clear(FLASH_PRGMERR_FLAG | FLASH_EPPERR_FLAG);
+  status = kv_reserve(KV_RECORD_SIZE(len));
+  if(status == SUCCESS)
+  {
+    status = kv_record_write(key, (const uint8_t *)data, len);
+  }
+  flash_lock();
+  return status;
+}
+
+/**
+  * @brief  read a value
+  * @param  key: record key
+  * @param  data: buffer for the value
+  * @param  size: buffer size, the value is truncated to it
+  * @param  len: returns the stored value length, may be NULL
+  * @retval SUCCESS if the key exists
+  */
+error_status kv_get(uint16_t key, void *data, uint16_t size, uint16_t *len)
+{
+  kv_index_type *entry = kv_index_find(key, FALSE);
+  uint16_t value_len;
+
+  if(entry == NULL || entry->addr == KV_ADDR_DELETED)
+  {
+    return ERROR;
+  }
+
+  value_len = *(__IO uint16_t *)(entry->addr + 2);
+  memcpy(data, (const void *)(entry->addr + 4), (value_len < size) ? value_len : size);
+  if(len != NULL)
+  {
+    *len = value_len;
+  }
+  return SUCCESS;
+}
+
+/**
+  * @brief  delete a key by appending a zero length record
+  * @param  key: record key
+  * @retval result
+  */
+error_status kv_delete(uint16_t key)
+{
+  kv_index_type *entry = kv_index_find(key, FALSE);
+  error_status status;
+
+  if(entry == NULL || entry->addr == KV_ADDR_DELETED)
+  {
+    return SUCCESS;
+  }
+
+  flash_unlock();
+  flash_flag_clear(FLASH_PRGMERR_FLAG | FLASH_EPPERR_FLAG);
+  status = kv_reserve(KV_RECORD_SIZE(0));
+  if(status == SUCCESS)
+  {
+    status = kv_record_write(key, NULL, 0);
+  }
+  flash_lock();
+  return status;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
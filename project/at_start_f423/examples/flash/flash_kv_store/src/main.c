@@ -0,0 +1,127 @@
+/**
+  **************************************************************************
+  * @file     main.c
+  * @brief    main program
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "at32f423_board.h"
+#include "at32f423_clock.h"
+#include "kv_store.h"
+#include "string.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_FLASH_kv_store
+  * @{
+  */
+
+#define KEY_BOOT_COUNT                   0x0001
+#define KEY_CALIBRATION                  0x0002
+#define KEY_SAMPLE_COUNT                 0x0003
+
+#define TEST_WRITE_COUNT                 1000
+
+uint16_t calibration[16];
+
+/**
+  * @brief  main function.
+  * @param  none
+  * @retval none
+  */
+int main(void)
+{
+  uint32_t index, boot_count = 0, sample_count = 0;
+  uint16_t read_buf[16];
+  uint16_t len;
+  error_status err_status;
+  system_clock_config();
+  at32_board_init();
+
+  /* mount the store and count the resets */
+  err_status = kv_init();
+  kv_get(KEY_BOOT_COUNT, &boot_count, sizeof(boot_count), NULL);
+  boot_count++;
+  if(kv_set(KEY_BOOT_COUNT, &boot_count, sizeof(boot_count)) != SUCCESS)
+  {
+    err_status = ERROR;
+  }
+
+  /* calibration block is only programmed when it changes */
+  for(index = 0; index < 16; index++)
+  {
+    calibration[index] = (uint16_t)(index * 100);
+  }
+  if(kv_set(KEY_CALIBRATION, calibration, sizeof(calibration)) != SUCCESS)
+  {
+    err_status = ERROR;
+  }
+
+  /* frequent counter updates rotate through all store sectors */
+  kv_get(KEY_SAMPLE_COUNT, &sample_count, sizeof(sample_count), NULL);
+  for(index = 0; index < TEST_WRITE_COUNT; index++)
+  {
+    sample_count++;
+    if(kv_set(KEY_SAMPLE_COUNT, &sample_count, sizeof(sample_count)) != SUCCESS)
+    {
+      err_status = ERROR;
+      break;
+    }
+  }
+
+  /* rebuild the index from flash and check the values */
+  if(kv_init() != SUCCESS)
+  {
+    err_status = ERROR;
+  }
+  index = 0;
+  if(kv_get(KEY_SAMPLE_COUNT, &index, sizeof(index), NULL) != SUCCESS || index != sample_count)
+  {
+    err_status = ERROR;
+  }
+  if(kv_get(KEY_CALIBRATION, read_buf, sizeof(read_buf), &len) != SUCCESS ||
+     len != sizeof(calibration) || memcmp(read_buf, calibration, sizeof(calibration)) != 0)
+  {
+    err_status = ERROR;
+  }
+
+  if(err_status == SUCCESS)
+  {
+    at32_led_on(LED2);
+    at32_led_on(LED3);
+    at32_led_on(LED4);
+  }
+
+  while(1)
+  {
+  }
+}
+
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,116 @@
+/**
+  **************************************************************************
+  * @file     flash_engine.h
+  * @brief    sram resident flash engine header
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __FLASH_ENGINE_H__
+#define __FLASH_ENGINE_H__
+
+#include "at32f423_board.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_FLASH_ram_engine
+  * @{
+  */
+
+/** @defgroup FLASH_ram_engine_definition
+  * @{
+  */
+
+#ifndef FLASH_ENGINE_QUEUE_DEPTH
+#define FLASH_ENGINE_QUEUE_DEPTH         8
+#endif
+
+/* 16 core exceptions + peripheral interrupts up to ACC_IRQn */
+#define FLASH_ENGINE_VECTOR_NUM          (16 + ACC_IRQn + 1)
+
+/**
+  * @brief  place a function in sram. code that must keep running while the
+  *         flash is busy, and everything it calls, has to be marked with it.
+  */
+#if defined ( __ICCARM__ )
+#define FLASH_RAM_FUNC                   __ramfunc
+#elif defined ( __GNUC__ ) && !defined ( __ARMCC_VERSION )
+#define FLASH_RAM_FUNC                   __attribute__((section(".ramfunc"), long_call, noinline))
+#else
+#define FLASH_RAM_FUNC                   __attribute__((section("RAMCODE"), noinline))
+#endif
+
+/**
+  * @brief  flash job command
+  */
+typedef enum
+{
+  FLASH_JOB_ERASE                        = 0x00, /*!< erase one sector */
+  FLASH_JOB_PROGRAM                      = 0x01  /*!< program words */
+} flash_job_cmd_type;
+
+/**
+  * @brief  flash job completion callback, called from the flash interrupt
+  */
+typedef void (*flash_job_callback_type)(uint32_t address, flash_status_type status);
+
+/**
+  * @brief  flash job
+  */
+typedef struct
+{
+  flash_job_cmd_type                     cmd;
+  uint32_t                               address;
+  const uint32_t                         *data;   /*!< must stay valid in sram until completion */
+  uint32_t                               num;     /*!< number of words to program */
+  flash_job_callback_type                callback;
+} flash_job_type;
+
+/**
+  * @}
+  */
+
+/** @defgroup FLASH_ram_engine_functions
+  * @{
+  */
+
+void flash_engine_init(uint32_t preempt_priority);
+void flash_engine_vector_set(IRQn_Type irqn, void (*handler)(void));
+error_status flash_engine_erase(uint32_t sector_address, flash_job_callback_type callback);
+error_status flash_engine_program(uint32_t address, const uint32_t *data, uint32_t num, flash_job_callback_type callback);
+flag_status flash_engine_busy(void);
+void flash_engine_irq_handler(void);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#endif
@@ -0,0 +1,258 @@
+/**
+  **************************************************************************
+  * @file     flash_engine.c
+  * @brief    sram resident flash engine
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "flash_engine.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_FLASH_ram_engine
+  * @{
+  */
+
+/*
+  the flash controller signals completion through the operate done and error
+  interrupts instead of being polled. everything that runs while an erase or
+  program is in progress (the job start, the flash interrupt and the ram vector
+  table) lives in sram, so interrupts whose handlers are also in sram keep
+  their latency. code executing from flash simply stalls until the bank is idle.
+*/
+static flash_job_type flash_job_queue[FLASH_ENGINE_QUEUE_DEPTH];
+static volatile uint32_t flash_job_head = 0;
+static volatile uint32_t flash_job_count = 0;
+static volatile uint32_t flash_job_index = 0;
+static uint32_t flash_engine_vector[FLASH_ENGINE_VECTOR_NUM] __ALIGNED(512);
+
+/**
+  * @brief  start the job at the head of the queue
+  * @param  none
+  * @retval none
+  */
+static FLASH_RAM_FUNC void flash_engine_start(void)
+{
+  flash_job_type *job = &flash_job_queue[flash_job_head];
+
+  flash_job_index = 0;
+  FLASH->sts = FLASH_ODF_FLAG | FLASH_PRGMERR_FLAG | FLASH_EPPERR_FLAG;
+  FLASH->ctrl_bit.errie = TRUE;
+  FLASH->ctrl_bit.odfie = TRUE;
+
+  if(job->cmd == FLASH_JOB_ERASE)
+  {
+    FLASH->ctrl_bit.secers = TRUE;
+    FLASH->addr = job->address;
+    FLASH->ctrl_bit.erstr = TRUE;
+  }
+  else
+  {
+    FLASH->ctrl_bit.fprgm = TRUE;
+    *(__IO uint32_t *)job->address = job->data[0];
+  }
+}
+
+/**
+  * @brief  add a job to the queue and start it when the flash is idle. runs
+  *         from sram so that interrupts are enabled again before the cpu goes
+  *         back to fetching from the busy flash.
+  * @param  cmd: job command
+  * @param  address: sector address or program address
+  * @param  data: program data, NULL for erase
+  * @param  num: number of words to program
+  * @param  callback: completion callback, can be NULL
+  * @retval ERROR if the queue is full
+  */
+static FLASH_RAM_FUNC error_status flash_engine_push(flash_job_cmd_type cmd, uint32_t address,
+                                                     const uint32_t *data, uint32_t num,
+                                                     flash_job_callback_type callback)
+{
+  flash_job_type *job;
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  if(flash_job_count == FLASH_ENGINE_QUEUE_DEPTH)
+  {
+    __set_PRIMASK(primask);
+    return ERROR;
+  }
+
+  job = &flash_job_queue[(flash_job_head + flash_job_count) % FLASH_ENGINE_QUEUE_DEPTH];
+  job->cmd = cmd;
+  job->address = address;
+  job->data = data;
+  job->num = num;
+  job->callback = callback;
+  flash_job_count++;
+
+  if(flash_job_count == 1)
+  {
+    FLASH->unlock = FLASH_UNLOCK_KEY1;
+    FLASH->unlock = FLASH_UNLOCK_KEY2;
+    flash_engine_start();
+  }
+  __set_PRIMASK(primask);
+  return SUCCESS;
+}
+
+/**
+  * @brief  flash interrupt handler, installed in the ram vector table.
+  *         programs the next word of the current job or completes it and
+  *         starts the next one.
+  * @param  none
+  * @retval none
+  */
+FLASH_RAM_FUNC void flash_engine_irq_handler(void)
+{
+  flash_job_type *job = &flash_job_queue[flash_job_head];
+  flash_status_type status = FLASH_OPERATE_DONE;
+  uint32_t sts = FLASH->sts;
+
+  FLASH->sts = FLASH_ODF_FLAG | FLASH_PRGMERR_FLAG | FLASH_EPPERR_FLAG;
+  if(flash_job_count == 0)
+  {
+    return;
+  }
+
+  if(sts & FLASH_PRGMERR_FLAG)
+  {
+    status = FLASH_PROGRAM_ERROR;
+  }
+  else if(sts & FLASH_EPPERR_FLAG)
+  {
+    status = FLASH_EPP_ERROR;
+  }
+  else if(job->cmd == FLASH_JOB_PROGRAM && ++flash_job_index < job->num)
+  {
+    *(__IO uint32_t *)(job->address + flash_job_index * 4) = job->data[flash_job_index];
+    return;
+  }
+
+  FLASH->ctrl_bit.fprgm = FALSE;
+  FLASH->ctrl_bit.secers = FALSE;
+
+  /* the bank is idle here, the callback may execute from flash and queue new jobs */
+  if(job->callback != NULL)
+  {
+    job->callback(job->address, status);
+  }
+
+  flash_job_head = (flash_job_head + 1) % FLASH_ENGINE_QUEUE_DEPTH;
+  flash_job_count--;
+  if(flash_job_count != 0)
+  {
+    flash_engine_start();
+  }
+  else
+  {
+    FLASH->ctrl_bit.odfie = FALSE;
+    FLASH->ctrl_bit.errie = FALSE;
+    FLASH->ctrl_bit.oplk = TRUE;
+  }
+}
+
+/**
+  * @brief  copy the vector table to sram, route the flash interrupt to the
+  *         engine and enable it
+  * @param  preempt_priority: flash interrupt preemption priority, keep it
+  *         below the time critical interrupts
+  * @retval none
+  */
+void flash_engine_init(uint32_t preempt_priority)
+{
+  const uint32_t *vector = (const uint32_t *)SCB->VTOR;
+  uint32_t i;
+
+  for(i = 0; i < FLASH_ENGINE_VECTOR_NUM; i++)
+  {
+    flash_engine_vector[i] = vector[i];
+  }
+  flash_engine_vector[16 + FLASH_IRQn] = (uint32_t)flash_engine_irq_handler;
+
+  __disable_irq();
+  nvic_vector_table_set(NVIC_VECTTAB_RAM, (uint32_t)flash_engine_vector - NVIC_VECTTAB_RAM);
+  __DSB();
+  __enable_irq();
+
+  nvic_irq_enable(FLASH_IRQn, preempt_priority, 0);
+}
+
+/**
+  * @brief  install an interrupt handler in the ram vector table. the handler
+  *         keeps running during flash operations only if it is marked
+  *         FLASH_RAM_FUNC and calls nothing that executes from flash.
+  * @param  irqn: interrupt number, core exceptions are negative
+  * @param  handler: interrupt handler
+  * @retval none
+  */
+void flash_engine_vector_set(IRQn_Type irqn, void (*handler)(void))
+{
+  flash_engine_vector[16 + irqn] = (uint32_t)handler;
+}
+
+/**
+  * @brief  queue a sector erase
+  * @param  sector_address: address of the sector
+  * @param  callback: completion callback, can be NULL
+  * @retval ERROR if the queue is full
+  */
+error_status flash_engine_erase(uint32_t sector_address, flash_job_callback_type callback)
+{
+  return flash_engine_push(FLASH_JOB_ERASE, sector_address, NULL, 0, callback);
+}
+
+/**
+  * @brief  queue a word program, the data must stay valid until the callback
+  * @param  address: word aligned flash address
+  * @param  data: data buffer in sram
+  * @param  num: number of words
+  * @param  callback: completion callback, can be NULL
+  * @retval ERROR if the queue is full or the request is invalid
+  */
+error_status flash_engine_program(uint32_t address, const uint32_t *data, uint32_t num, flash_job_callback_type callback)
+{
+  if(num == 0 || (address & 0x3) != 0)
+  {
+    return ERROR;
+  }
+  return flash_engine_push(FLASH_JOB_PROGRAM, address, data, num, callback);
+}
+
+/**
+  * @brief  check whether jobs are pending
+  * @param  none
+  * @retval SET while a job is queued or in progress
+  */
+flag_status flash_engine_busy(void)
+{
+  return (flash_job_count != 0) ? SET : RESET;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,152 @@
+/**
+  **************************************************************************
+  * @file     main.c
+  * @brief    main program
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "at32f423_board.h"
+#include "at32f423_clock.h"
+#include "flash_engine.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_FLASH_ram_engine FLASH_ram_engine
+  * @{
+  */
+
+#if defined (AT32F423xC)
+#define SECTOR_SIZE                      2048   /* this parameter depends on the specific model of the chip */
+#else
+#define SECTOR_SIZE                      1024   /* this parameter depends on the specific model of the chip */
+#endif
+
+#define TEST_FLASH_ADDRESS_START         (0x08000000 + 1024 * 32)
+#define TEST_SECTOR_NUM                  4
+#define TEST_WORD_NUM                    (SECTOR_SIZE / 4)
+
+uint32_t buffer_write[TEST_WORD_NUM];
+volatile uint32_t control_ticks = 0;
+volatile uint32_t job_errors = 0;
+
+/**
+  * @brief  time critical 1 khz control loop, stands in for a motor control
+  *         interrupt. it runs from sram through the ram vector table and only
+  *         touches registers, so it keeps running while the flash is busy.
+  * @param  none
+  * @retval none
+  */
+FLASH_RAM_FUNC void control_loop_handler(void)
+{
+  control_ticks++;
+  if((control_ticks % 500) == 0)
+  {
+    LED2_GPIO->odt ^= LED2_PIN;
+  }
+}
+
+/**
+  * @brief  flash job completion callback
+  * @param  address: job address
+  * @param  status: job result
+  * @retval none
+  */
+void flash_job_done(uint32_t address, flash_status_type status)
+{
+  if(status != FLASH_OPERATE_DONE)
+  {
+    job_errors++;
+  }
+}
+
+/**
+  * @brief  main function.
+  * @param  none
+  * @retval none
+  */
+int main(void)
+{
+  uint32_t index, sector, ticks_start;
+  error_status err_status = SUCCESS;
+  system_clock_config();
+  at32_board_init();
+  nvic_priority_group_config(NVIC_PRIORITY_GROUP_4);
+
+  for(index = 0; index < TEST_WORD_NUM; index++)
+  {
+    buffer_write[index] = index * 0x01010101;
+  }
+
+  /* ram vector table, flash interrupt below the control loop */
+  flash_engine_init(1);
+  flash_engine_vector_set(SysTick_IRQn, control_loop_handler);
+  NVIC_SetPriority(SysTick_IRQn, 0);
+  SysTick->LOAD = system_core_clock / 1000 - 1;
+  SysTick->VAL = 0;
+  SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+
+  /* queue erase and program jobs, the control loop keeps ticking meanwhile */
+  ticks_start = control_ticks;
+  for(sector = 0; sector < TEST_SECTOR_NUM; sector++)
+  {
+    while(flash_engine_erase(TEST_FLASH_ADDRESS_START + sector * SECTOR_SIZE, flash_job_done) != SUCCESS);
+    while(flash_engine_program(TEST_FLASH_ADDRESS_START + sector * SECTOR_SIZE, buffer_write,
+                               TEST_WORD_NUM, flash_job_done) != SUCCESS);
+  }
+  while(flash_engine_busy() == SET);
+
+  /* check the data and that the control loop was serviced during the jobs */
+  for(sector = 0; sector < TEST_SECTOR_NUM; sector++)
+  {
+    for(index = 0; index < TEST_WORD_NUM; index++)
+    {
+      if(*(uint32_t *)(TEST_FLASH_ADDRESS_START + sector * SECTOR_SIZE + index * 4) != buffer_write[index])
+      {
+        err_status = ERROR;
+      }
+    }
+  }
+  if(job_errors != 0 || control_ticks == ticks_start)
+  {
+    err_status = ERROR;
+  }
+
+  if(err_status == SUCCESS)
+  {
+    at32_led_on(LED3);
+    at32_led_on(LED4);
+  }
+
+  while(1)
+  {
+  }
+}
+
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
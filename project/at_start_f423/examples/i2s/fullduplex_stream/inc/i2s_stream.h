@@ -0,0 +1,137 @@
+/**
+  **************************************************************************
+  * @file     i2s_stream.h
+  * @brief    i2s full duplex stream header
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* define to prevent recursive inclusion -------------------------------------*/
+#ifndef __I2S_STREAM_H
+#define __I2S_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* includes ------------------------------------------------------------------*/
+#include "at32f423.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_I2S_fullduplex_stream
+  * @{
+  */
+
+/**
+  * @brief samples per half buffer, left and right count as two samples.
+  *        one half is handed to the callbacks each half-transfer interrupt.
+  */
+#ifndef I2S_STREAM_HALF_SAMPLES
+#define I2S_STREAM_HALF_SAMPLES          128
+#endif
+
+/**
+  * @brief stream resources, i2s1 master tx and i2s2 slave rx on the
+  *        full duplex pair configured by scfg.
+  */
+#define I2S_STREAM_TX_SPI                SPI1
+#define I2S_STREAM_RX_SPI                SPI2
+#define I2S_STREAM_TX_DMA_CHANNEL        DMA1_CHANNEL2
+#define I2S_STREAM_RX_DMA_CHANNEL        DMA1_CHANNEL3
+#define I2S_STREAM_TX_DMAMUX_CHANNEL     DMA1MUX_CHANNEL2
+#define I2S_STREAM_RX_DMAMUX_CHANNEL     DMA1MUX_CHANNEL3
+#define I2S_STREAM_TX_DMA_IRQn           DMA1_Channel2_IRQn
+#define I2S_STREAM_RX_DMA_IRQn           DMA1_Channel3_IRQn
+#define I2S_STREAM_TX_HDT_FLAG           DMA1_HDT2_FLAG
+#define I2S_STREAM_TX_FDT_FLAG           DMA1_FDT2_FLAG
+#define I2S_STREAM_RX_HDT_FLAG           DMA1_HDT3_FLAG
+#define I2S_STREAM_RX_FDT_FLAG           DMA1_FDT3_FLAG
+
+/**
+  * @brief sample format of the callback buffers
+  */
+typedef enum
+{
+  I2S_STREAM_FORMAT_16BIT                = 0x00, /*!< int16_t per sample */
+  I2S_STREAM_FORMAT_24BIT_PACKED         = 0x01, /*!< 3 bytes per sample, little endian */
+  I2S_STREAM_FORMAT_24BIT_UNPACKED       = 0x02, /*!< int32_t per sample, right aligned and sign extended */
+  I2S_STREAM_FORMAT_32BIT                = 0x03  /*!< int32_t per sample */
+} i2s_stream_format_type;
+
+/**
+  * @brief tx callback, fill samples into buffer in the user format.
+  *        return the number of samples written, the rest is sent as silence
+  *        and counted as underrun.
+  */
+typedef uint32_t (*i2s_stream_tx_callback_type)(void *buffer, uint32_t samples);
+
+/**
+  * @brief rx callback, buffer holds samples in the user format
+  */
+typedef void (*i2s_stream_rx_callback_type)(const void *buffer, uint32_t samples);
+
+/**
+  * @brief stream init type
+  */
+typedef struct
+{
+  i2s_data_channel_format_type           data_channel_format; /*!< frame on the i2s bus */
+  i2s_audio_sampling_freq_type           audio_sampling_freq; /*!< sampling frequency */
+  i2s_audio_protocol_type                audio_protocol;      /*!< i2s protocol */
+  i2s_stream_format_type                 user_format;         /*!< callback buffer format */
+  i2s_stream_tx_callback_type            tx_callback;         /*!< tx half buffer request */
+  i2s_stream_rx_callback_type            rx_callback;         /*!< rx half buffer ready */
+} i2s_stream_init_type;
+
+/**
+  * @brief stream statistics
+  */
+typedef struct
+{
+  uint32_t                               tx_blocks;           /*!< tx halves refilled */
+  uint32_t                               rx_blocks;           /*!< rx halves delivered */
+  uint32_t                               tx_underrun;         /*!< late or short tx refills and i2s underload errors */
+  uint32_t                               rx_overrun;          /*!< late rx deliveries and i2s overflow errors */
+} i2s_stream_stats_type;
+
+void i2s_stream_default_para_init(i2s_stream_init_type *stream_init_struct);
+error_status i2s_stream_init(i2s_stream_init_type *stream_init_struct);
+void i2s_stream_start(void);
+void i2s_stream_stop(void);
+void i2s_stream_stats_get(i2s_stream_stats_type *stats);
+void i2s_stream_tx_dma_handler(void);
+void i2s_stream_rx_dma_handler(void);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,442 @@
+/**
+  **************************************************************************
+  * @file     i2s_stream.c
+  * @brief    i2s full duplex stream driver
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "i2s_stream.h"
+#include "string.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_I2S_fullduplex_stream
+  * @{
+  */
+
+/* dma buffers hold two halves, 24/32-bit frames take two halfwords per sample */
+static uint16_t tx_dma_buffer[I2S_STREAM_HALF_SAMPLES * 2 * 2];
+static uint16_t rx_dma_buffer[I2S_STREAM_HALF_SAMPLES * 2 * 2];
+static uint32_t tx_user_buffer[I2S_STREAM_HALF_SAMPLES];
+static uint32_t rx_user_buffer[I2S_STREAM_HALF_SAMPLES];
+
+static i2s_stream_init_type stream_config;
+static i2s_stream_stats_type stream_stats;
+static uint32_t stream_hw_words;
+
+/**
+  * @brief  read one sample from the dma buffer as a left aligned 32-bit value
+  * @param  pbuf: dma buffer position
+  * @retval sample
+  */
+static uint32_t i2s_stream_hw_read(const uint16_t *pbuf)
+{
+  if(stream_hw_words == 1)
+  {
+    return (uint32_t)pbuf[0] << 16;
+  }
+  return ((uint32_t)pbuf[0] << 16) | pbuf[1];
+}
+
+/**
+  * @brief  write one left aligned 32-bit sample to the dma buffer
+  * @param  pbuf: dma buffer position
+  * @param  value: sample
+  * @retval none
+  */
+static void i2s_stream_hw_write(uint16_t *pbuf, uint32_t value)
+{
+  pbuf[0] = (uint16_t)(value >> 16);
+  if(stream_hw_words == 2)
+  {
+    pbuf[1] = (uint16_t)value;
+  }
+}
+
+/**
+  * @brief  convert a dma half buffer to the user format
+  * @param  pbuf: dma half buffer
+  * @param  puser: user buffer
+  * @retval none
+  */
+static void i2s_stream_unpack(const uint16_t *pbuf, void *puser)
+{
+  uint32_t i_index, value;
+  int16_t *p16 = (int16_t *)puser;
+  uint8_t *p8 = (uint8_t *)puser;
+  int32_t *p32 = (int32_t *)puser;
+
+  for(i_index = 0; i_index < I2S_STREAM_HALF_SAMPLES; i_index ++)
+  {
+    value = i2s_stream_hw_read(pbuf);
+    pbuf += stream_hw_words;
+
+    switch(stream_config.user_format)
+    {
+      case I2S_STREAM_FORMAT_16BIT:
+        p16[i_index] = (int16_t)(value >> 16);
+        break;
+      case I2S_STREAM_FORMAT_24BIT_PACKED:
+        *p8 ++ = (uint8_t)(value >> 8);
+        *p8 ++ = (uint8_t)(value >> 16);
+        *p8 ++ = (uint8_t)(value >> 24);
+        break;
+      case I2S_STREAM_FORMAT_24BIT_UNPACKED:
+        p32[i_index] = (int32_t)value >> 8;
+        break;
+      default:
+        p32[i_index] = (int32_t)value;
+        break;
+    }
+  }
+}
+
+/**
+  * @brief  convert user samples to a dma half buffer
+  * @param  puser: user buffer
+  * @param  pbuf: dma half buffer
+  * @param  samples: valid samples in the user buffer, the rest is silence
+  * @retval none
+  */
+static void i2s_stream_pack(const void *puser, uint16_t *pbuf, uint32_t samples)
+{
+  uint32_t i_index, value;
+  const int16_t *p16 = (const int16_t *)puser;
+  const uint8_t *p8 = (const uint8_t *)puser;
+  const int32_t *p32 = (const int32_t *)puser;
+
+  for(i_index = 0; i_index < I2S_STREAM_HALF_SAMPLES; i_index ++)
+  {
+    if(i_index >= samples)
+    {
+      value = 0;
+    }
+    else
+    {
+      switch(stream_config.user_format)
+      {
+        case I2S_STREAM_FORMAT_16BIT:
+          value = (uint32_t)p16[i_index] << 16;
+          break;
+        case I2S_STREAM_FORMAT_24BIT_PACKED:
+          value = ((uint32_t)p8[0] << 8) | ((uint32_t)p8[1] << 16) | ((uint32_t)p8[2] << 24);
+          p8 += 3;
+          break;
+        case I2S_STREAM_FORMAT_24BIT_UNPACKED:
+          value = (uint32_t)p32[i_index] << 8;
+          break;
+        default:
+          value = (uint32_t)p32[i_index];
+          break;
+      }
+    }
+
+    i2s_stream_hw_write(pbuf, value);
+    pbuf += stream_hw_words;
+  }
+}
+
+/**
+  * @brief  check whether the dma already runs in the half just serviced
+  * @param  dma_channel: dma channel
+  * @param  half: half index, 0 or 1
+  * @retval TRUE if the service was too late
+  */
+static confirm_state i2s_stream_late(dma_channel_type *dma_channel, uint32_t half)
+{
+  uint32_t total = I2S_STREAM_HALF_SAMPLES * 2 * stream_hw_words;
+  uint32_t position = total - dma_data_number_get(dma_channel);
+
+  if(half == 0)
+  {
+    return (position < total / 2) ? TRUE : FALSE;
+  }
+  return (position >= total / 2) ? TRUE : FALSE;
+}
+
+/**
+  * @brief  refill one tx half buffer from the tx callback
+  * @param  half: half index, 0 or 1
+  * @retval none
+  */
+static void i2s_stream_tx_fill(uint32_t half)
+{
+  uint16_t *pbuf = tx_dma_buffer + half * I2S_STREAM_HALF_SAMPLES * stream_hw_words;
+  uint32_t samples = 0;
+
+  if(stream_config.tx_callback != NULL)
+  {
+    samples = stream_config.tx_callback(tx_user_buffer, I2S_STREAM_HALF_SAMPLES);
+    if(samples < I2S_STREAM_HALF_SAMPLES)
+    {
+      stream_stats.tx_underrun ++;
+    }
+  }
+  i2s_stream_pack(tx_user_buffer, pbuf, samples);
+}
+
+/**
+  * @brief  refill the tx half the dma just finished
+  * @param  half: half index, 0 or 1
+  * @retval none
+  */
+static void i2s_stream_tx_refill(uint32_t half)
+{
+  i2s_stream_tx_fill(half);
+
+  /* the dma wrapped into the half before it was refilled */
+  if(i2s_stream_late(I2S_STREAM_TX_DMA_CHANNEL, half) == TRUE)
+  {
+    stream_stats.tx_underrun ++;
+  }
+  stream_stats.tx_blocks ++;
+}
+
+/**
+  * @brief  convert one rx half buffer and hand it to the rx callback
+  * @param  half: half index, 0 or 1
+  * @retval none
+  */
+static void i2s_stream_rx_deliver(uint32_t half)
+{
+  i2s_stream_unpack(rx_dma_buffer + half * I2S_STREAM_HALF_SAMPLES * stream_hw_words, rx_user_buffer);
+
+  /* the half was overwritten while it was converted */
+  if(i2s_stream_late(I2S_STREAM_RX_DMA_CHANNEL, half) == TRUE)
+  {
+    stream_stats.rx_overrun ++;
+  }
+
+  if(stream_config.rx_callback != NULL)
+  {
+    stream_config.rx_callback(rx_user_buffer, I2S_STREAM_HALF_SAMPLES);
+  }
+  stream_stats.rx_blocks ++;
+}
+
+/**
+  * @brief  initialize the stream init struct with the default value
+  * @param  stream_init_struct: pointer to an i2s_stream_init_type structure
+  * @retval none
+  */
+void i2s_stream_default_para_init(i2s_stream_init_type *stream_init_struct)
+{
+  stream_init_struct->data_channel_format = I2S_DATA_16BIT_CHANNEL_32BIT;
+  stream_init_struct->audio_sampling_freq = I2S_AUDIO_FREQUENCY_48K;
+  stream_init_struct->audio_protocol = I2S_AUDIO_PROTOCOL_PHILLIPS;
+  stream_init_struct->user_format = I2S_STREAM_FORMAT_16BIT;
+  stream_init_struct->tx_callback = NULL;
+  stream_init_struct->rx_callback = NULL;
+}
+
+/**
+  * @brief  initialize the full duplex i2s pair and the circular dma channels,
+  *         the stream is started by i2s_stream_start.
+  * @param  stream_init_struct: pointer to an i2s_stream_init_type structure
+  * @retval SUCCESS or ERROR
+  */
+error_status i2s_stream_init(i2s_stream_init_type *stream_init_struct)
+{
+  i2s_init_type i2s_init_struct;
+  dma_init_type dma_init_struct;
+
+  if(stream_init_struct->user_format > I2S_STREAM_FORMAT_32BIT)
+  {
+    return ERROR;
+  }
+
+  stream_config = *stream_init_struct;
+  stream_hw_words = (stream_config.data_channel_format == I2S_DATA_24BIT_CHANNEL_32BIT ||
+                     stream_config.data_channel_format == I2S_DATA_32BIT_CHANNEL_32BIT) ? 2 : 1;
+
+  crm_periph_clock_enable(CRM_SPI1_PERIPH_CLOCK, TRUE);
+  crm_periph_clock_enable(CRM_SPI2_PERIPH_CLOCK, TRUE);
+  crm_periph_clock_enable(CRM_SCFG_PERIPH_CLOCK, TRUE);
+  crm_periph_clock_enable(CRM_DMA1_PERIPH_CLOCK, TRUE);
+  dmamux_enable(DMA1, TRUE);
+
+  /* i2s1 and i2s2 share the clocks as one full duplex module */
+  scfg_i2s_full_duplex_config(SCFG_FULL_DUPLEX_I2S1_I2S2);
+
+  i2s_default_para_init(&i2s_init_struct);
+  i2s_init_struct.audio_protocol = stream_config.audio_protocol;
+  i2s_init_struct.data_channel_format = stream_config.data_channel_format;
+  i2s_init_struct.mclk_output_enable = TRUE;
+  i2s_init_struct.audio_sampling_freq = stream_config.audio_sampling_freq;
+  i2s_init_struct.clock_polarity = I2S_CLOCK_POLARITY_LOW;
+  i2s_init_struct.operation_mode = I2S_MODE_MASTER_TX;
+  i2s_init(I2S_STREAM_TX_SPI, &i2s_init_struct);
+
+  i2s_init_struct.operation_mode = I2S_MODE_SLAVE_RX;
+  i2s_init(I2S_STREAM_RX_SPI, &i2s_init_struct);
+
+  /* circular tx dma, half and full transfer interrupts refill the idle half */
+  dma_reset(I2S_STREAM_TX_DMA_CHANNEL);
+  dma_default_para_init(&dma_init_struct);
+  dma_init_struct.buffer_size = I2S_STREAM_HALF_SAMPLES * 2 * stream_hw_words;
+  dma_init_struct.memory_data_width = DMA_MEMORY_DATA_WIDTH_HALFWORD;
+  dma_init_struct.memory_inc_enable = TRUE;
+  dma_init_struct.peripheral_data_width = DMA_PERIPHERAL_DATA_WIDTH_HALFWORD;
+  dma_init_struct.peripheral_inc_enable = FALSE;
+  dma_init_struct.priority = DMA_PRIORITY_VERY_HIGH;
+  dma_init_struct.loop_mode_enable = TRUE;
+  dma_init_struct.peripheral_base_addr = (uint32_t)&(I2S_STREAM_TX_SPI->dt);
+  dma_init_struct.memory_base_addr = (uint32_t)tx_dma_buffer;
+  dma_init_struct.direction = DMA_DIR_MEMORY_TO_PERIPHERAL;
+  dma_init(I2S_STREAM_TX_DMA_CHANNEL, &dma_init_struct);
+  dmamux_init(I2S_STREAM_TX_DMAMUX_CHANNEL, DMAMUX_DMAREQ_ID_SPI1_TX);
+
+  /* circular rx dma */
+  dma_reset(I2S_STREAM_RX_DMA_CHANNEL);
+  dma_init_struct.peripheral_base_addr = (uint32_t)&(I2S_STREAM_RX_SPI->dt);
+  dma_init_struct.memory_base_addr = (uint32_t)rx_dma_buffer;
+  dma_init_struct.direction = DMA_DIR_PERIPHERAL_TO_MEMORY;
+  dma_init(I2S_STREAM_RX_DMA_CHANNEL, &dma_init_struct);
+  dmamux_init(I2S_STREAM_RX_DMAMUX_CHANNEL, DMAMUX_DMAREQ_ID_SPI2_RX);
+
+  dma_interrupt_enable(I2S_STREAM_TX_DMA_CHANNEL, DMA_HDT_INT | DMA_FDT_INT, TRUE);
+  dma_interrupt_enable(I2S_STREAM_RX_DMA_CHANNEL, DMA_HDT_INT | DMA_FDT_INT, TRUE);
+  nvic_irq_enable(I2S_STREAM_TX_DMA_IRQn, 1, 0);
+  nvic_irq_enable(I2S_STREAM_RX_DMA_IRQn, 1, 0);
+
+  return SUCCESS;
+}
+
+/**
+  * @brief  start the stream, both tx halves are filled first and the slave
+  *         receiver is enabled before the master so that both sides begin
+  *         on the same frame.
+  * @param  none
+  * @retval none
+  */
+void i2s_stream_start(void)
+{
+  memset(&stream_stats, 0, sizeof(stream_stats));
+  memset(rx_dma_buffer, 0, sizeof(rx_dma_buffer));
+
+  i2s_stream_tx_fill(0);
+  i2s_stream_tx_fill(1);
+
+  dma_data_number_set(I2S_STREAM_TX_DMA_CHANNEL, I2S_STREAM_HALF_SAMPLES * 2 * stream_hw_words);
+  dma_data_number_set(I2S_STREAM_RX_DMA_CHANNEL, I2S_STREAM_HALF_SAMPLES * 2 * stream_hw_words);
+  dma_channel_enable(I2S_STREAM_RX_DMA_CHANNEL, TRUE);
+  dma_channel_enable(I2S_STREAM_TX_DMA_CHANNEL, TRUE);
+
+  spi_i2s_dma_receiver_enable(I2S_STREAM_RX_SPI, TRUE);
+  spi_i2s_dma_transmitter_enable(I2S_STREAM_TX_SPI, TRUE);
+
+  i2s_enable(I2S_STREAM_RX_SPI, TRUE);
+  i2s_enable(I2S_STREAM_TX_SPI, TRUE);
+}
+
+/**
+  * @brief  stop the stream
+  * @param  none
+  * @retval none
+  */
+void i2s_stream_stop(void)
+{
+  i2s_enable(I2S_STREAM_TX_SPI, FALSE);
+  i2s_enable(I2S_STREAM_RX_SPI, FALSE);
+
+  spi_i2s_dma_transmitter_enable(I2S_STREAM_TX_SPI, FALSE);
+  spi_i2s_dma_receiver_enable(I2S_STREAM_RX_SPI, FALSE);
+
+  dma_channel_enable(I2S_STREAM_TX_DMA_CHANNEL, FALSE);
+  dma_channel_enable(I2S_STREAM_RX_DMA_CHANNEL, FALSE);
+}
+
+/**
+  * @brief  get a copy of the stream statistics
+  * @param  stats: pointer to an i2s_stream_stats_type structure
+  * @retval none
+  */
+void i2s_stream_stats_get(i2s_stream_stats_type *stats)
+{
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  *stats = stream_stats;
+  __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  tx dma interrupt, call from the tx dma channel irq handler
+  * @param  none
+  * @retval none
+  */
+void i2s_stream_tx_dma_handler(void)
+{
+  if(dma_interrupt_flag_get(I2S_STREAM_TX_HDT_FLAG) != RESET)
+  {
+    dma_flag_clear(I2S_STREAM_TX_HDT_FLAG);
+    i2s_stream_tx_refill(0);
+  }
+
+  if(dma_interrupt_flag_get(I2S_STREAM_TX_FDT_FLAG) != RESET)
+  {
+    dma_flag_clear(I2S_STREAM_TX_FDT_FLAG);
+    i2s_stream_tx_refill(1);
+  }
+
+  /* the transmitter shifted out an empty data register */
+  if(spi_i2s_flag_get(I2S_STREAM_TX_SPI, I2S_TUERR_FLAG) != RESET)
+  {
+    spi_i2s_flag_clear(I2S_STREAM_TX_SPI, I2S_TUERR_FLAG);
+    stream_stats.tx_underrun ++;
+  }
+}
+
+/**
+  * @brief  rx dma interrupt, call from the rx dma channel irq handler
+  * @param  none
+  * @retval none
+  */
+void i2s_stream_rx_dma_handler(void)
+{
+  if(dma_interrupt_flag_get(I2S_STREAM_RX_HDT_FLAG) != RESET)
+  {
+    dma_flag_clear(I2S_STREAM_RX_HDT_FLAG);
+    i2s_stream_rx_deliver(0);
+  }
+
+  if(dma_interrupt_flag_get(I2S_STREAM_RX_FDT_FLAG) != RESET)
+  {
+    dma_flag_clear(I2S_STREAM_RX_FDT_FLAG);
+    i2s_stream_rx_deliver(1);
+  }
+
+  if(spi_i2s_flag_get(I2S_STREAM_RX_SPI, SPI_I2S_ROERR_FLAG) != RESET)
+  {
+    spi_i2s_flag_clear(I2S_STREAM_RX_SPI, SPI_I2S_ROERR_FLAG);
+    stream_stats.rx_overrun ++;
+  }
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,201 @@
+/**
+  **************************************************************************
+  * @file     main.c
+  * @brief    main program
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "at32f423_board.h"
+#include "at32f423_clock.h"
+#include "i2s_stream.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_I2S_fullduplex_stream I2S_fullduplex_stream
+  * @{
+  */
+
+#define SAMPLE_MASK                      0x00FFFFFF
+
+volatile uint32_t tx_counter = 0;
+volatile uint32_t rx_expect = 0;
+volatile uint32_t rx_locked = 0;
+volatile uint32_t rx_errors = 0;
+
+/**
+  * @brief  tx callback, sends a 24-bit ramp.
+  * @param  buffer: int32_t samples, right aligned
+  * @param  samples: number of samples requested
+  * @retval number of samples written
+  */
+uint32_t stream_tx_callback(void *buffer, uint32_t samples)
+{
+  int32_t *pbuf = (int32_t *)buffer;
+  uint32_t i_index;
+
+  for(i_index = 0; i_index < samples; i_index ++)
+  {
+    /* sign extend the 24-bit counter */
+    pbuf[i_index] = (int32_t)(tx_counter << 8) >> 8;
+    tx_counter = (tx_counter + 1) & SAMPLE_MASK;
+  }
+  return samples;
+}
+
+/**
+  * @brief  rx callback, checks that the looped back ramp has no gap.
+  * @param  buffer: int32_t samples, right aligned
+  * @param  samples: number of samples received
+  * @retval none
+  */
+void stream_rx_callback(const void *buffer, uint32_t samples)
+{
+  const int32_t *pbuf = (const int32_t *)buffer;
+  uint32_t i_index, value;
+
+  for(i_index = 0; i_index < samples; i_index ++)
+  {
+    value = (uint32_t)pbuf[i_index] & SAMPLE_MASK;
+
+    /* the first frames hold silence until the ramp arrives */
+    if(rx_locked == 0)
+    {
+      if(value == 0)
+      {
+        continue;
+      }
+      rx_locked = 1;
+    }
+    else if(value != rx_expect)
+    {
+      rx_errors ++;
+    }
+    rx_expect = (value + 1) & SAMPLE_MASK;
+  }
+}
+
+/**
+  * @brief  gpio configuration.
+  * @param  none
+  * @retval none
+  */
+static void gpio_config(void)
+{
+  gpio_init_type gpio_initstructure;
+  crm_periph_clock_enable(CRM_GPIOA_PERIPH_CLOCK, TRUE);
+  crm_periph_clock_enable(CRM_GPIOB_PERIPH_CLOCK, TRUE);
+
+  gpio_default_para_init(&gpio_initstructure);
+
+  /* i2s1 ws pin */
+  gpio_initstructure.gpio_out_type = GPIO_OUTPUT_PUSH_PULL;
+  gpio_initstructure.gpio_pull = GPIO_PULL_UP;
+  gpio_initstructure.gpio_mode = GPIO_MODE_MUX;
+  gpio_initstructure.gpio_drive_strength = GPIO_DRIVE_STRENGTH_STRONGER;
+  gpio_initstructure.gpio_pins = GPIO_PINS_4;
+  gpio_init(GPIOA, &gpio_initstructure);
+  gpio_pin_mux_config(GPIOA, GPIO_PINS_SOURCE4, GPIO_MUX_5);
+
+  /* i2s1 ck pin */
+  gpio_initstructure.gpio_pull = GPIO_PULL_DOWN;
+  gpio_initstructure.gpio_pins = GPIO_PINS_5;
+  gpio_init(GPIOA, &gpio_initstructure);
+  gpio_pin_mux_config(GPIOA, GPIO_PINS_SOURCE5, GPIO_MUX_5);
+  
+  /* i2s1 mck pin */
+  gpio_initstructure.gpio_pull = GPIO_PULL_DOWN;
+  gpio_initstructure.gpio_pins = GPIO_PINS_6;
+  gpio_init(GPIOA, &gpio_initstructure);
+  gpio_pin_mux_config(GPIOA, GPIO_PINS_SOURCE6, GPIO_MUX_5);
+
+  /* i2s1 sd pin */
+  gpio_initstructure.gpio_pull = GPIO_PULL_DOWN;
+  gpio_initstructure.gpio_pins = GPIO_PINS_7;
+  gpio_init(GPIOA, &gpio_initstructure);
+  gpio_pin_mux_config(GPIOA, GPIO_PINS_SOURCE7, GPIO_MUX_5);
+
+  /* i2s2 ext_sd pin */
+  gpio_initstructure.gpio_pull = GPIO_PULL_DOWN;
+  gpio_initstructure.gpio_pins = GPIO_PINS_14;
+  gpio_init(GPIOB, &gpio_initstructure);
+  gpio_pin_mux_config(GPIOB, GPIO_PINS_SOURCE14, GPIO_MUX_6);
+}
+
+/**
+  * @brief  main function.
+  * @param  none
+  * @retval none
+  */
+int main(void)
+{
+  i2s_stream_init_type stream_init_struct;
+  i2s_stream_stats_type stats;
+
+  system_clock_config();
+  at32_board_init();
+  at32_led_on(LED4);
+
+  /* i2s gpio config */
+  gpio_config();
+
+  /* 24-bit frames on the bus, int32_t samples in the callbacks */
+  i2s_stream_default_para_init(&stream_init_struct);
+  stream_init_struct.data_channel_format = I2S_DATA_24BIT_CHANNEL_32BIT;
+  stream_init_struct.audio_sampling_freq = I2S_AUDIO_FREQUENCY_48K;
+  stream_init_struct.user_format = I2S_STREAM_FORMAT_24BIT_UNPACKED;
+  stream_init_struct.tx_callback = stream_tx_callback;
+  stream_init_struct.rx_callback = stream_rx_callback;
+  i2s_stream_init(&stream_init_struct);
+
+  /* wait for key USER_BUTTON press before starting the stream */
+  while(at32_button_press() != USER_BUTTON)
+  {
+  }
+
+  i2s_stream_start();
+
+  while(1)
+  {
+    delay_ms(500);
+    i2s_stream_stats_get(&stats);
+
+    /* led2 blinks while the loop back is clean, led3 lights on any glitch */
+    if(rx_errors == 0 && stats.tx_underrun == 0 && stats.rx_overrun == 0)
+    {
+      at32_led_toggle(LED2);
+    }
+    else
+    {
+      at32_led_off(LED2);
+      at32_led_on(LED3);
+    }
+  }
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,139 @@
+/**
+  **************************************************************************
+  * @file     pm.h
+  * @brief    power mode manager header
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* define to prevent recursive inclusion -------------------------------------*/
+#ifndef __PM_H
+#define __PM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* includes ------------------------------------------------------------------*/
+#include "at32f423.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_PWC_power_manager
+  * @{
+  */
+
+/* number of deadline slots */
+#ifndef PM_DEADLINE_NUM
+#define PM_DEADLINE_NUM                  4
+#endif
+
+/* shortest idle time worth each mode, entry and exit cost included */
+#ifndef PM_DEEPSLEEP_MIN_MS
+#define PM_DEEPSLEEP_MIN_MS              5
+#endif
+#ifndef PM_DEEPSLEEP_ELP_MIN_MS
+#define PM_DEEPSLEEP_ELP_MIN_MS          50
+#endif
+#ifndef PM_STANDBY_MIN_MS
+#define PM_STANDBY_MIN_MS                2000
+#endif
+
+/* ertc from lext, ck_b = 32768 / (31 + 1) / (1023 + 1) = 1hz, 1ms sub-second */
+#define PM_ERTC_DIV_A                    31
+#define PM_ERTC_DIV_B                    1023
+
+/* wakeup timer on ertc_clk / 16, 16-bit counter */
+#define PM_WAKEUP_TIMER_HZ               2048
+#define PM_WAKEUP_TIMER_MAX_MS           30000
+
+/* battery powered registers used by the manager */
+#define PM_BPR_MAGIC                     ERTC_DT1
+#define PM_BPR_STANDBY_COUNT             ERTC_DT2
+#define PM_BPR_STANDBY_TIME              ERTC_DT3
+#define PM_BPR_STANDBY_ENTRY             ERTC_DT4
+#define PM_MAGIC                         0x504D4752
+
+#define PM_FOREVER                       0xFFFFFFFF
+
+/**
+  * @brief power modes, from shallow to deep
+  */
+typedef enum
+{
+  PM_MODE_RUN                            = 0x00, /*!< no low power mode */
+  PM_MODE_SLEEP                          = 0x01, /*!< core stopped, clocks running */
+  PM_MODE_DEEPSLEEP                      = 0x02, /*!< clocks stopped, sram and registers kept */
+  PM_MODE_STANDBY                        = 0x03, /*!< powered off, wakes up through reset */
+  PM_MODE_NUM                            = 0x04
+} pm_mode_type;
+
+/**
+  * @brief wakeup source, registered by the driver owning it
+  */
+typedef struct pm_wakeup_struct
+{
+  pm_mode_type                           deepest;         /*!< deepest mode the source wakes up from */
+  uint32_t                               standby_pin;     /*!< PWC_WAKEUP_PIN_x enabled in standby, 0 if none */
+  confirm_state                          enabled;         /*!< source must be able to wake up */
+  struct pm_wakeup_struct                *next;           /*!< registration list */
+} pm_wakeup_type;
+
+/**
+  * @brief residency counters
+  */
+typedef struct
+{
+  uint32_t                               count[PM_MODE_NUM];   /*!< entries, run counts idle calls that did not sleep */
+  uint32_t                               time_ms[PM_MODE_NUM]; /*!< time spent, standby over resets */
+} pm_residency_type;
+
+void pm_init(void);
+flag_status pm_standby_resumed(void);
+uint32_t pm_now(void);
+
+void pm_lock(pm_mode_type mode);
+void pm_unlock(pm_mode_type mode);
+void pm_wakeup_register(pm_wakeup_type *source);
+void pm_wakeup_enable(pm_wakeup_type *source, confirm_state new_state);
+
+void pm_deadline_set(uint32_t id, uint32_t delay_ms);
+void pm_deadline_clear(uint32_t id);
+flag_status pm_deadline_expired(uint32_t id);
+
+pm_mode_type pm_idle(void);
+void pm_residency_get(pm_residency_type *residency);
+void pm_wakeup_timer_handler(void);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,188 @@
+/**
+  **************************************************************************
+  * @file     main.c
+  * @brief    main program
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "at32f423_board.h"
+#include "at32f423_clock.h"
+#include "pm.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_PWC_power_manager PWC_power_manager
+  * @{
+  */
+
+#define DEADLINE_LED                     0
+#define DEADLINE_REPORT                  1
+
+#define LED_PERIOD_MS                    1000
+#define REPORT_PERIOD_MS                 10000
+
+/* the user button wakes up from deepsleep (exint) and standby (wakeup pin 1) */
+pm_wakeup_type button_wakeup = {PM_MODE_STANDBY, PWC_WAKEUP_PIN_1, FALSE, 0};
+__IO uint8_t button_pressed = 0;
+
+void button_exint_config(void);
+void residency_report(void);
+
+/**
+  * @brief  main function.
+  * @param  none
+  * @retval none
+  */
+int main(void)
+{
+  uint8_t standby_allowed = 0;
+
+  /* add a necessary delay to ensure that Vdd is higher than the operating
+     voltage of battery powered domain (2.57V) when the battery powered
+     domain is powered on for the first time and being operated. */
+  wait_for_power_stable();
+
+  /* congfig the system clock */
+  system_clock_config();
+
+  /* init at start board */
+  at32_board_init();
+
+  uart_print_init(115200);
+
+  /* config priority group */
+  nvic_priority_group_config(NVIC_PRIORITY_GROUP_4);
+
+  pm_init();
+  if(pm_standby_resumed() != RESET)
+  {
+    printf("resumed from standby\r\n");
+    residency_report();
+  }
+
+  /* the led task needs sram, standby is allowed by the user button */
+  pm_lock(PM_MODE_STANDBY);
+
+  button_exint_config();
+  pm_wakeup_register(&button_wakeup);
+  pm_wakeup_enable(&button_wakeup, TRUE);
+
+  pm_deadline_set(DEADLINE_LED, LED_PERIOD_MS);
+  pm_deadline_set(DEADLINE_REPORT, REPORT_PERIOD_MS);
+
+  while(1)
+  {
+    if(pm_deadline_expired(DEADLINE_LED) == SET)
+    {
+      at32_led_toggle(LED2);
+      pm_deadline_set(DEADLINE_LED, LED_PERIOD_MS);
+    }
+
+    if(pm_deadline_expired(DEADLINE_REPORT) == SET)
+    {
+      residency_report();
+      pm_deadline_set(DEADLINE_REPORT, REPORT_PERIOD_MS);
+    }
+
+    if(button_pressed != 0)
+    {
+      button_pressed = 0;
+      if(standby_allowed == 0)
+      {
+        /* stop the led task and allow standby */
+        standby_allowed = 1;
+        pm_deadline_clear(DEADLINE_LED);
+        at32_led_off(LED2);
+        pm_unlock(PM_MODE_STANDBY);
+      }
+    }
+
+    pm_idle();
+  }
+}
+
+/**
+  * @brief  print the residency counters, the usart keeps deepsleep locked
+  *         until the last byte is sent.
+  * @param  none
+  * @retval none
+  */
+void residency_report(void)
+{
+  pm_residency_type residency;
+
+  pm_lock(PM_MODE_DEEPSLEEP);
+
+  pm_residency_get(&residency);
+  printf("run       %u ms, %u idle calls\r\n", residency.time_ms[PM_MODE_RUN], residency.count[PM_MODE_RUN]);
+  printf("sleep     %u ms, %u entries\r\n", residency.time_ms[PM_MODE_SLEEP], residency.count[PM_MODE_SLEEP]);
+  printf("deepsleep %u ms, %u entries\r\n", residency.time_ms[PM_MODE_DEEPSLEEP], residency.count[PM_MODE_DEEPSLEEP]);
+  printf("standby   %u ms, %u entries\r\n", residency.time_ms[PM_MODE_STANDBY], residency.count[PM_MODE_STANDBY]);
+  while(usart_flag_get(PRINT_UART, USART_TDC_FLAG) == RESET);
+
+  pm_unlock(PM_MODE_DEEPSLEEP);
+}
+
+/**
+  * @brief  exint line0 config, user button pa0 in interrupt mode.
+  * @param  none
+  * @retval none
+  */
+void button_exint_config(void)
+{
+  exint_init_type exint_init_struct;
+
+  crm_periph_clock_enable(CRM_SCFG_PERIPH_CLOCK, TRUE);
+  scfg_exint_line_config(SCFG_PORT_SOURCE_GPIOA, SCFG_PINS_SOURCE0);
+
+  exint_default_para_init(&exint_init_struct);
+  exint_init_struct.line_enable = TRUE;
+  exint_init_struct.line_mode = EXINT_LINE_INTERRUPT;
+  exint_init_struct.line_select = EXINT_LINE_0;
+  exint_init_struct.line_polarity = EXINT_TRIGGER_RISING_EDGE;
+  exint_init(&exint_init_struct);
+
+  nvic_irq_enable(EXINT0_IRQn, 1, 0);
+}
+
+/**
+  * @brief  exint0 interrupt handler
+  * @param  none
+  * @retval none
+  */
+void EXINT0_IRQHandler(void)
+{
+  if(exint_interrupt_flag_get(EXINT_LINE_0) != RESET)
+  {
+    button_pressed = 1;
+    exint_flag_clear(EXINT_LINE_0);
+  }
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
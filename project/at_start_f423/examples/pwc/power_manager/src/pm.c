@@ -0,0 +1,581 @@
+/**
+  **************************************************************************
+  * @file     pm.c
+  * @brief    power mode manager
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* includes ------------------------------------------------------------------*/
+#include "pm.h"
+#include "at32f423_board.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_PWC_power_manager
+  * @{
+  */
+
+#define PM_DAY_MS                        86400000
+
+static uint16_t lock_count[PM_MODE_NUM];
+static pm_wakeup_type *wakeup_list = 0;
+static uint32_t deadline_at[PM_DEADLINE_NUM];
+static uint32_t deadline_active = 0;
+static pm_residency_type residency_data;
+static uint32_t pm_time = 0;
+static uint32_t pm_last_tod = 0;
+static flag_status standby_resumed = RESET;
+
+/**
+  * @brief  time of day from the ertc in ms.
+  * @param  none
+  * @retval ms since midnight
+  */
+static uint32_t pm_ertc_ms(void)
+{
+  ertc_time_type time;
+  uint32_t sbs, check;
+
+  /* sub-second counts down, retry if it reloaded while the calendar was read */
+  do
+  {
+    sbs = ertc_sub_second_get();
+    ertc_calendar_get(&time);
+    check = ertc_sub_second_get();
+  } while(check > sbs);
+
+  return ((time.hour * 60 + time.min) * 60 + time.sec) * 1000 +
+         ((PM_ERTC_DIV_B - sbs) * 1000) / (PM_ERTC_DIV_B + 1);
+}
+
+/**
+  * @brief  first power on ertc configuration, the calendar only serves as
+  *         time base of the manager.
+  * @param  none
+  * @retval none
+  */
+static void pm_ertc_config(void)
+{
+  /* reset ertc domain */
+  crm_battery_powered_domain_reset(TRUE);
+  crm_battery_powered_domain_reset(FALSE);
+
+  /* enable the lext osc */
+  crm_clock_source_enable(CRM_CLOCK_SOURCE_LEXT, TRUE);
+
+  /* wait till lext is ready */
+  while(crm_flag_get(CRM_LEXT_STABLE_FLAG) == RESET);
+
+  /* select and enable the ertc clock */
+  crm_ertc_clock_select(CRM_ERTC_CLOCK_LEXT);
+  crm_ertc_clock_enable(TRUE);
+
+  ertc_reset();
+  ertc_wait_update();
+  ertc_divider_set(PM_ERTC_DIV_A, PM_ERTC_DIV_B);
+  ertc_hour_mode_set(ERTC_HOUR_MODE_24);
+  ertc_time_set(0, 0, 0, ERTC_AM);
+
+  ertc_bpr_data_write(PM_BPR_STANDBY_COUNT, 0);
+  ertc_bpr_data_write(PM_BPR_STANDBY_TIME, 0);
+  ertc_bpr_data_write(PM_BPR_MAGIC, PM_MAGIC);
+}
+
+/**
+  * @brief  arm the ertc wakeup timer.
+  * @param  ms: time to wake up, PM_FOREVER leaves it disabled
+  * @retval none
+  */
+static void pm_wakeup_timer_set(uint32_t ms)
+{
+  uint32_t ticks;
+
+  ertc_wakeup_enable(FALSE);
+  if(ms == PM_FOREVER)
+  {
+    return;
+  }
+
+  /* longer idle times wake up early and sleep again */
+  if(ms > PM_WAKEUP_TIMER_MAX_MS)
+  {
+    ms = PM_WAKEUP_TIMER_MAX_MS;
+  }
+  ticks = (ms * PM_WAKEUP_TIMER_HZ) / 1000;
+  if(ticks == 0)
+  {
+    ticks = 1;
+  }
+
+  while(ertc_flag_get(ERTC_WATWF_FLAG) == RESET);
+  ertc_wakeup_counter_set(ticks - 1);
+  ertc_wakeup_enable(TRUE);
+}
+
+/**
+  * @brief  deepest mode allowed by the locks and the enabled wakeup sources.
+  * @param  none
+  * @retval mode
+  */
+static pm_mode_type pm_mode_limit(void)
+{
+  pm_mode_type mode = PM_MODE_STANDBY;
+  pm_wakeup_type *source;
+  uint32_t i_index;
+
+  for(i_index = PM_MODE_SLEEP; i_index < PM_MODE_NUM; i_index++)
+  {
+    if(lock_count[i_index] != 0)
+    {
+      mode = (pm_mode_type)(i_index - 1);
+      break;
+    }
+  }
+
+  for(source = wakeup_list; source != 0; source = source->next)
+  {
+    if(source->enabled == TRUE && source->deepest < mode)
+    {
+      mode = source->deepest;
+    }
+  }
+
+  return mode;
+}
+
+/**
+  * @brief  time to the earliest deadline.
+  * @param  now: current manager time
+  * @retval ms, 0 if a deadline expired, PM_FOREVER if none is set
+  */
+static uint32_t pm_idle_time(uint32_t now)
+{
+  uint32_t idle = PM_FOREVER, left, i_index;
+
+  for(i_index = 0; i_index < PM_DEADLINE_NUM; i_index++)
+  {
+    if(deadline_active & (1 << i_index))
+    {
+      if((int32_t)(deadline_at[i_index] - now) <= 0)
+      {
+        return 0;
+      }
+      left = deadline_at[i_index] - now;
+      if(left < idle)
+      {
+        idle = left;
+      }
+    }
+  }
+
+  return idle;
+}
+
+/**
+  * @brief  restore the system clock after deepsleep, which wakes up on hick.
+  * @param  sclk: system clock source before deepsleep
+  * @param  hext: hext was enabled before deepsleep
+  * @retval none
+  */
+static void pm_clock_restore(crm_sclk_type sclk, uint32_t hext)
+{
+  if(hext != 0)
+  {
+    crm_clock_source_enable(CRM_CLOCK_SOURCE_HEXT, TRUE);
+    while(crm_hext_stable_wait() == ERROR);
+  }
+
+  if(sclk == CRM_SCLK_PLL)
+  {
+    crm_clock_source_enable(CRM_CLOCK_SOURCE_PLL, TRUE);
+    while(crm_flag_get(CRM_PLL_STABLE_FLAG) == RESET);
+
+    /* enable auto step mode */
+    crm_auto_step_mode_enable(TRUE);
+    crm_sysclk_switch(CRM_SCLK_PLL);
+    while(crm_sysclk_switch_status_get() != CRM_SCLK_PLL);
+    crm_auto_step_mode_enable(FALSE);
+  }
+  else if(sclk == CRM_SCLK_HEXT)
+  {
+    crm_sysclk_switch(CRM_SCLK_HEXT);
+    while(crm_sysclk_switch_status_get() != CRM_SCLK_HEXT);
+  }
+}
+
+/**
+  * @brief  enter deepsleep, the ldo is lowered while the system runs from
+  *         hick and the regulator mode follows the expected idle time.
+  * @param  idle: expected idle time in ms
+  * @retval none
+  */
+static void pm_deepsleep_enter(uint32_t idle)
+{
+  crm_sclk_type sclk = crm_sysclk_switch_status_get();
+  uint32_t hext = CRM->ctrl_bit.hexten;
+  uint32_t ldo = PWC->ldoov_bit.ldoovsel;
+  uint32_t systick_enable;
+  uint32_t debug = ((DEBUGMCU->ctrl & 0x00000007) != 0x00000000);
+
+  /* save and disable systick */
+  systick_enable = SysTick->CTRL & SysTick_CTRL_ENABLE_Msk;
+  SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+
+  /* run from hick so the ldo can go to its lowest level */
+  if(sclk != CRM_SCLK_HICK)
+  {
+    crm_auto_step_mode_enable(TRUE);
+    crm_sysclk_switch(CRM_SCLK_HICK);
+    while(crm_sysclk_switch_status_get() != CRM_SCLK_HICK);
+    crm_auto_step_mode_enable(FALSE);
+  }
+  pwc_ldo_output_voltage_set(PWC_LDO_OUTPUT_1V1);
+
+  /* extra low power wakes up slower and is not allowed with deepsleep debug */
+  if(idle >= PM_DEEPSLEEP_ELP_MIN_MS && debug == 0)
+  {
+    pwc_voltage_regulate_set(PWC_REGULATOR_EXTRA_LOW_POWER);
+  }
+  else
+  {
+    pwc_voltage_regulate_set(PWC_REGULATOR_LOW_POWER);
+  }
+
+  pwc_deep_sleep_mode_enter(PWC_DEEP_SLEEP_ENTER_WFI);
+
+  /* restore systick */
+  SysTick->CTRL |= systick_enable;
+
+  if(debug != 0)
+  {
+    /* wait 3 lick (maximum 120us) cycles to ensure clock stable, sclk is hick 8mhz */
+    delay_us(((120 * HICK_VALUE) / system_core_clock) + 1);
+  }
+
+  /* the ldo settles while hext starts */
+  pwc_ldo_output_voltage_set(ldo);
+  pm_clock_restore(sclk, hext);
+
+  /* shadow calendar registers are stale after deepsleep */
+  ertc_wait_update();
+}
+
+/**
+  * @brief  enter standby, the entry time is kept in battery powered
+  *         registers for the residency counters. does not return.
+  * @param  none
+  * @retval none
+  */
+static void pm_standby_enter(void)
+{
+  pm_wakeup_type *source;
+
+  ertc_bpr_data_write(PM_BPR_STANDBY_COUNT, ertc_bpr_data_read(PM_BPR_STANDBY_COUNT) + 1);
+  ertc_bpr_data_write(PM_BPR_STANDBY_ENTRY, pm_ertc_ms());
+
+  for(source = wakeup_list; source != 0; source = source->next)
+  {
+    if(source->enabled == TRUE && source->standby_pin != 0)
+    {
+      pwc_wakeup_pin_enable(source->standby_pin, TRUE);
+    }
+  }
+
+  /* a pending wakeup flag would end standby at once */
+  ertc_flag_clear(ERTC_WATF_FLAG);
+  pwc_flag_clear(PWC_WAKEUP_FLAG);
+  pwc_standby_mode_enter();
+}
+
+/**
+  * @brief  initialize the manager, the ertc and its wakeup timer. the
+  *         calendar keeps running over standby.
+  * @param  none
+  * @retval none
+  */
+void pm_init(void)
+{
+  exint_init_type exint_init_struct;
+  uint32_t i_index, now;
+
+  for(i_index = 0; i_index < PM_MODE_NUM; i_index++)
+  {
+    lock_count[i_index] = 0;
+    residency_data.count[i_index] = 0;
+    residency_data.time_ms[i_index] = 0;
+  }
+  wakeup_list = 0;
+  deadline_active = 0;
+
+  crm_periph_clock_enable(CRM_PWC_PERIPH_CLOCK, TRUE);
+  pwc_battery_powered_domain_access(TRUE);
+
+  if(ertc_bpr_data_read(PM_BPR_MAGIC) != PM_MAGIC)
+  {
+    pm_ertc_config();
+  }
+  else
+  {
+    ertc_wait_update();
+  }
+  now = pm_ertc_ms();
+
+  standby_resumed = pwc_flag_get(PWC_STANDBY_FLAG);
+  if(standby_resumed != RESET)
+  {
+    ertc_bpr_data_write(PM_BPR_STANDBY_TIME, ertc_bpr_data_read(PM_BPR_STANDBY_TIME) +
+                        (now + PM_DAY_MS - ertc_bpr_data_read(PM_BPR_STANDBY_ENTRY)) % PM_DAY_MS);
+    pwc_flag_clear(PWC_STANDBY_FLAG);
+  }
+  pwc_flag_clear(PWC_WAKEUP_FLAG);
+  pm_time = 0;
+  pm_last_tod = now;
+
+  /* config the exint line of the ertc wakeup timer */
+  exint_init_struct.line_select   = EXINT_LINE_22;
+  exint_init_struct.line_enable   = TRUE;
+  exint_init_struct.line_mode     = EXINT_LINE_INTERRUPT;
+  exint_init_struct.line_polarity = EXINT_TRIGGER_RISING_EDGE;
+  exint_init(&exint_init_struct);
+
+  ertc_wakeup_enable(FALSE);
+  ertc_wakeup_clock_set(ERTC_WAT_CLK_ERTCCLK_DIV16);
+  ertc_flag_clear(ERTC_WATF_FLAG);
+  exint_flag_clear(EXINT_LINE_22);
+  ertc_interrupt_enable(ERTC_WAT_INT, TRUE);
+  nvic_irq_enable(ERTC_WKUP_IRQn, 0, 0);
+}
+
+/**
+  * @brief  the last reset was a wakeup from standby.
+  * @param  none
+  * @retval SET or RESET
+  */
+flag_status pm_standby_resumed(void)
+{
+  return standby_resumed;
+}
+
+/**
+  * @brief  monotonic manager time, it also advances during deepsleep.
+  * @param  none
+  * @retval ms since pm_init
+  */
+uint32_t pm_now(void)
+{
+  uint32_t tod = pm_ertc_ms();
+
+  pm_time += (tod + PM_DAY_MS - pm_last_tod) % PM_DAY_MS;
+  pm_last_tod = tod;
+
+  return pm_time;
+}
+
+/**
+  * @brief  forbid a mode and all deeper ones, locks nest.
+  * @param  mode: shallowest forbidden mode, PM_MODE_SLEEP..PM_MODE_STANDBY
+  * @retval none
+  */
+void pm_lock(pm_mode_type mode)
+{
+  __disable_irq();
+  lock_count[mode]++;
+  __enable_irq();
+}
+
+/**
+  * @brief  release a lock taken by pm_lock().
+  * @param  mode: same mode as the lock
+  * @retval none
+  */
+void pm_unlock(pm_mode_type mode)
+{
+  __disable_irq();
+  if(lock_count[mode] != 0)
+  {
+    lock_count[mode]--;
+  }
+  __enable_irq();
+}
+
+/**
+  * @brief  register a wakeup source, it constrains the mode while enabled.
+  * @param  source: wakeup source, deepest and standby_pin set
+  * @retval none
+  */
+void pm_wakeup_register(pm_wakeup_type *source)
+{
+  source->enabled = FALSE;
+  source->next = wakeup_list;
+  wakeup_list = source;
+}
+
+/**
+  * @brief  enable or disable a registered wakeup source.
+  * @param  source: wakeup source
+  * @param  new_state: TRUE or FALSE
+  * @retval none
+  */
+void pm_wakeup_enable(pm_wakeup_type *source, confirm_state new_state)
+{
+  source->enabled = new_state;
+}
+
+/**
+  * @brief  set a deadline, the idle hook does not sleep past it.
+  * @param  id: deadline slot, 0..PM_DEADLINE_NUM - 1
+  * @param  delay_ms: time from now
+  * @retval none
+  */
+void pm_deadline_set(uint32_t id, uint32_t delay_ms)
+{
+  deadline_at[id] = pm_now() + delay_ms;
+  deadline_active |= (1 << id);
+}
+
+/**
+  * @brief  clear a deadline.
+  * @param  id: deadline slot
+  * @retval none
+  */
+void pm_deadline_clear(uint32_t id)
+{
+  deadline_active &= ~(1 << id);
+}
+
+/**
+  * @brief  check and consume an expired deadline.
+  * @param  id: deadline slot
+  * @retval SET once when the deadline has passed
+  */
+flag_status pm_deadline_expired(uint32_t id)
+{
+  if((deadline_active & (1 << id)) && (int32_t)(deadline_at[id] - pm_now()) <= 0)
+  {
+    deadline_active &= ~(1 << id);
+    return SET;
+  }
+
+  return RESET;
+}
+
+/**
+  * @brief  idle hook, enter the deepest mode allowed by locks, wakeup
+  *         sources and the next deadline. interrupts stay masked until the
+  *         clocks are restored, a pending interrupt still ends the mode.
+  * @param  none
+  * @retval mode that was entered
+  */
+pm_mode_type pm_idle(void)
+{
+  pm_mode_type mode;
+  uint32_t start, idle;
+
+  __disable_irq();
+
+  start = pm_now();
+  idle = pm_idle_time(start);
+  mode = pm_mode_limit();
+
+  if(idle == 0)
+  {
+    mode = PM_MODE_RUN;
+  }
+  if(mode == PM_MODE_STANDBY && idle < PM_STANDBY_MIN_MS)
+  {
+    mode = PM_MODE_DEEPSLEEP;
+  }
+  if(mode == PM_MODE_DEEPSLEEP && idle < PM_DEEPSLEEP_MIN_MS)
+  {
+    mode = PM_MODE_SLEEP;
+  }
+
+  if(mode == PM_MODE_RUN)
+  {
+    residency_data.count[PM_MODE_RUN]++;
+    __enable_irq();
+    return mode;
+  }
+
+  pm_wakeup_timer_set(idle);
+
+  switch(mode)
+  {
+    case PM_MODE_SLEEP:
+      pwc_sleep_mode_enter(PWC_SLEEP_ENTER_WFI);
+      break;
+    case PM_MODE_DEEPSLEEP:
+      pm_deepsleep_enter(idle);
+      break;
+    default:
+      pm_standby_enter();
+      break;
+  }
+
+  ertc_wakeup_enable(FALSE);
+  residency_data.count[mode]++;
+  residency_data.time_ms[mode] += pm_now() - start;
+
+  __enable_irq();
+
+  return mode;
+}
+
+/**
+  * @brief  get the residency counters, run time is what is not spent in a
+  *         low power mode since pm_init.
+  * @param  residency: counters copy
+  * @retval none
+  */
+void pm_residency_get(pm_residency_type *residency)
+{
+  uint32_t now = pm_now();
+
+  *residency = residency_data;
+  residency->count[PM_MODE_STANDBY] = ertc_bpr_data_read(PM_BPR_STANDBY_COUNT);
+  residency->time_ms[PM_MODE_STANDBY] = ertc_bpr_data_read(PM_BPR_STANDBY_TIME);
+  residency->time_ms[PM_MODE_RUN] = now - residency_data.time_ms[PM_MODE_SLEEP] -
+                                    residency_data.time_ms[PM_MODE_DEEPSLEEP];
+}
+
+/**
+  * @brief  ertc wakeup timer interrupt, the wakeup itself is the purpose.
+  * @param  none
+  * @retval none
+  */
+void pm_wakeup_timer_handler(void)
+{
+  if(ertc_interrupt_flag_get(ERTC_WATF_FLAG) != RESET)
+  {
+    ertc_flag_clear(ERTC_WATF_FLAG);
+    exint_flag_clear(EXINT_LINE_22);
+  }
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,114 @@
+/**
+  **************************************************************************
+  * @file     tmr_cap.h
+  * @brief    tmr input capture timestamp service header
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* define to prevent recursive inclusion -------------------------------------*/
+#ifndef __TMR_CAP_H
+#define __TMR_CAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* includes ------------------------------------------------------------------*/
+#include "at32f423.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_TMR_capture_timestamp
+  * @{
+  */
+
+/**
+  * @brief capture channel, every edge timestamp is written by dma into a
+  *        circular ring, the reader extends it to 64 bits when draining.
+  *        the full transfer interrupt counts the ring laps so a reader that
+  *        fell a whole ring behind is detected.
+  */
+typedef struct
+{
+  tmr_type                               *tmr_x;          /*!< free running 32-bit timer, tmr2 */
+  tmr_channel_select_type                tmr_channel;     /*!< capture channel 1..4 */
+  tmr_input_polarity_type                polarity;        /*!< captured edge */
+  tmr_input_direction_mapped_type        mapped;          /*!< direct or indirect input */
+  uint8_t                                filter;          /*!< input filter value */
+  dma_channel_type                       *dma_channel;    /*!< dma channel */
+  dmamux_channel_type                    *dmamux_channel; /*!< dmamux channel of the dma channel */
+  dmamux_requst_id_sel_type              dmamux_request;  /*!< capture dma request of the channel */
+  uint32_t                               dma_fdt_flag;    /*!< full transfer flag of the dma channel */
+  uint32_t                               *ring;           /*!< timestamp ring */
+  uint16_t                               size;            /*!< ring entries, a power of two */
+  uint16_t                               read_index;      /*!< next entry to drain */
+  __IO uint32_t                          laps;            /*!< ring laps of the dma, counted by the interrupt */
+  uint32_t                               read_count;      /*!< entries drained or dropped */
+  uint32_t                               overruns;        /*!< resyncs after the dma overwrote undrained entries */
+  uint32_t                               high;            /*!< upper 32 bits of the last drained entry */
+  uint64_t                               last;            /*!< last drained timestamp */
+  uint8_t                                primed;          /*!< last is valid */
+} tmr_cap_type;
+
+/**
+  * @brief batch statistics, periods are accumulated as deviations from the
+  *        first period so the sums stay exact in integers.
+  */
+typedef struct
+{
+  uint32_t                               count;           /*!< accumulated periods */
+  uint32_t                               reference;       /*!< first period */
+  uint32_t                               period_min;      /*!< shortest period */
+  uint32_t                               period_max;      /*!< longest period */
+  int64_t                                dev_sum;         /*!< sum of period - reference */
+  uint64_t                               dev_sq_sum;      /*!< sum of (period - reference)^2 */
+  uint64_t                               high_sum;        /*!< sum of high times, duty batches only */
+} tmr_cap_stats_type;
+
+void tmr_cap_start(tmr_cap_type *cap);
+void tmr_cap_stop(tmr_cap_type *cap);
+void tmr_cap_dma_irq_handler(tmr_cap_type *cap);
+uint16_t tmr_cap_pending(tmr_cap_type *cap);
+uint64_t tmr_cap_pop(tmr_cap_type *cap);
+uint32_t tmr_cap_idle_ticks(tmr_cap_type *cap);
+
+void tmr_cap_stats_reset(tmr_cap_stats_type *stats);
+uint32_t tmr_cap_period_batch(tmr_cap_type *cap, tmr_cap_stats_type *stats);
+uint32_t tmr_cap_duty_batch(tmr_cap_type *rise, tmr_cap_type *fall, tmr_cap_stats_type *stats);
+float tmr_cap_frequency(tmr_cap_stats_type *stats, uint32_t clock);
+float tmr_cap_duty(tmr_cap_stats_type *stats);
+float tmr_cap_jitter(tmr_cap_stats_type *stats);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,328 @@
+/**
+  **************************************************************************
+  * @file     main.c
+  * @brief    main program
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "at32f423_board.h"
+#include "at32f423_clock.h"
+#include "tmr_cap.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_TMR_capture_timestamp TMR_capture_timestamp
+  * @{
+  */
+
+/* highest edge rate per channel, the rings are drained every DRAIN_MS and
+   keep half of the ring as margin for a late drain, the printing included */
+#define MAX_EDGE_HZ                      2000
+#define RING_SIZE                        512
+#define DRAIN_MS                         100
+#define REPORT_MS                        500
+
+#if (MAX_EDGE_HZ * DRAIN_MS / 1000) > (RING_SIZE / 2)
+#error "RING_SIZE is too small for MAX_EDGE_HZ edges per DRAIN_MS"
+#endif
+/* signal lost after 100ms without edge */
+#define IDLE_MS                          100
+
+uint32_t ring_rise[RING_SIZE];
+uint32_t ring_fall[RING_SIZE];
+uint32_t ring_tacho_a[RING_SIZE];
+uint32_t ring_tacho_b[RING_SIZE];
+
+tmr_cap_type cap_rise, cap_fall, cap_tacho_a, cap_tacho_b;
+tmr_cap_stats_type stats_pwm, stats_tacho_a, stats_tacho_b;
+
+crm_clocks_freq_type crm_clocks_freq_struct = {0};
+uint32_t tmr2_clock;
+
+void crm_configuration(void);
+void gpio_configuration(void);
+void test_signal_config(void);
+void capture_setup(tmr_cap_type *cap, tmr_channel_select_type channel, tmr_input_polarity_type polarity, \
+                   tmr_input_direction_mapped_type mapped, dma_channel_type *dma_channel, \
+                   dmamux_channel_type *dmamux_channel, dmamux_requst_id_sel_type request, \
+                   uint32_t fdt_flag, uint32_t *ring);
+void tacho_report(const char *name, tmr_cap_type *cap, tmr_cap_stats_type *stats);
+
+/**
+  * @brief  main function.
+  * @param  none
+  * @retval none
+  */
+int main(void)
+{
+  uint32_t drains = 0;
+
+  system_clock_config();
+
+  at32_board_init();
+
+  /* system peripheral configuration */
+  crm_configuration();
+
+  /* gpio configuration */
+  gpio_configuration();
+
+  uart_print_init(115200);
+
+  crm_clocks_freq_get(&crm_clocks_freq_struct);
+  tmr2_clock = crm_clocks_freq_struct.apb1_freq * 2;
+
+  /* tmr2 free running 32-bit counter at the full timer clock */
+  tmr_32_bit_function_enable(TMR2, TRUE);
+  tmr_base_init(TMR2, 0xFFFFFFFF, 0);
+  tmr_cnt_dir_set(TMR2, TMR_COUNT_UP);
+
+  /* pa0 drives channel 1 (rising edges) and channel 2 (falling edges),
+     pa2 and pa3 are two tachometer inputs */
+  capture_setup(&cap_rise, TMR_SELECT_CHANNEL_1, TMR_INPUT_RISING_EDGE, TMR_CC_CHANNEL_MAPPED_DIRECT,
+                DMA1_CHANNEL1, DMA1MUX_CHANNEL1, DMAMUX_DMAREQ_ID_TMR2_CH1, DMA1_FDT1_FLAG, ring_rise);
+  capture_setup(&cap_fall, TMR_SELECT_CHANNEL_2, TMR_INPUT_FALLING_EDGE, TMR_CC_CHANNEL_MAPPED_INDIRECT,
+                DMA1_CHANNEL2, DMA1MUX_CHANNEL2, DMAMUX_DMAREQ_ID_TMR2_CH2, DMA1_FDT2_FLAG, ring_fall);
+  capture_setup(&cap_tacho_a, TMR_SELECT_CHANNEL_3, TMR_INPUT_RISING_EDGE, TMR_CC_CHANNEL_MAPPED_DIRECT,
+                DMA1_CHANNEL3, DMA1MUX_CHANNEL3, DMAMUX_DMAREQ_ID_TMR2_CH3, DMA1_FDT3_FLAG, ring_tacho_a);
+  capture_setup(&cap_tacho_b, TMR_SELECT_CHANNEL_4, TMR_INPUT_RISING_EDGE, TMR_CC_CHANNEL_MAPPED_DIRECT,
+                DMA1_CHANNEL4, DMA1MUX_CHANNEL4, DMAMUX_DMAREQ_ID_TMR2_CH4, DMA1_FDT4_FLAG, ring_tacho_b);
+
+  tmr_cap_stats_reset(&stats_pwm);
+  tmr_cap_stats_reset(&stats_tacho_a);
+  tmr_cap_stats_reset(&stats_tacho_b);
+
+  /* ring lap interrupts for the overrun detection */
+  nvic_priority_group_config(NVIC_PRIORITY_GROUP_4);
+  nvic_irq_enable(DMA1_Channel1_IRQn, 1, 0);
+  nvic_irq_enable(DMA1_Channel2_IRQn, 1, 0);
+  nvic_irq_enable(DMA1_Channel3_IRQn, 1, 0);
+  nvic_irq_enable(DMA1_Channel4_IRQn, 1, 0);
+
+  /* tmr enable counter */
+  tmr_counter_enable(TMR2, TRUE);
+
+  /* 1khz 30% test signal on pa6, connect pa6 to pa0 */
+  test_signal_config();
+
+  while(1)
+  {
+    /* no interrupt per edge, the rings are drained in batches */
+    delay_ms(DRAIN_MS);
+
+    tmr_cap_duty_batch(&cap_rise, &cap_fall, &stats_pwm);
+    tmr_cap_period_batch(&cap_tacho_a, &stats_tacho_a);
+    tmr_cap_period_batch(&cap_tacho_b, &stats_tacho_b);
+
+    if(++drains < REPORT_MS / DRAIN_MS)
+    {
+      continue;
+    }
+    drains = 0;
+
+    if(stats_pwm.count != 0)
+    {
+      printf("pwm: %u periods, freq=%.3fHz, duty=%.2f%%, jitter=%.1f ticks, overruns=%u\r\n",
+             stats_pwm.count, tmr_cap_frequency(&stats_pwm, tmr2_clock),
+             tmr_cap_duty(&stats_pwm), tmr_cap_jitter(&stats_pwm),
+             cap_rise.overruns + cap_fall.overruns);
+    }
+    else
+    {
+      printf("pwm: no signal\r\n");
+    }
+    tacho_report("tacho a", &cap_tacho_a, &stats_tacho_a);
+    tacho_report("tacho b", &cap_tacho_b, &stats_tacho_b);
+
+    tmr_cap_stats_reset(&stats_pwm);
+    tmr_cap_stats_reset(&stats_tacho_a);
+    tmr_cap_stats_reset(&stats_tacho_b);
+    at32_led_toggle(LED2);
+  }
+}
+
+/**
+  * @brief  fill and start a capture channel of tmr2.
+  * @param  cap: capture channel
+  * @param  channel: tmr2 channel
+  * @param  polarity: captured edge
+  * @param  mapped: direct or indirect input
+  * @param  dma_channel: dma channel
+  * @param  dmamux_channel: dmamux channel of the dma channel
+  * @param  request: capture dma request
+  * @param  fdt_flag: full transfer flag of the dma channel
+  * @param  ring: timestamp ring of RING_SIZE entries
+  * @retval none
+  */
+void capture_setup(tmr_cap_type *cap, tmr_channel_select_type channel, tmr_input_polarity_type polarity, \
+                   tmr_input_direction_mapped_type mapped, dma_channel_type *dma_channel, \
+                   dmamux_channel_type *dmamux_channel, dmamux_requst_id_sel_type request, \
+                   uint32_t fdt_flag, uint32_t *ring)
+{
+  cap->tmr_x = TMR2;
+  cap->tmr_channel = channel;
+  cap->polarity = polarity;
+  cap->mapped = mapped;
+  cap->filter = 0;
+  cap->dma_channel = dma_channel;
+  cap->dmamux_channel = dmamux_channel;
+  cap->dmamux_request = request;
+  cap->dma_fdt_flag = fdt_flag;
+  cap->ring = ring;
+  cap->size = RING_SIZE;
+  tmr_cap_start(cap);
+}
+
+/**
+  * @brief  print the speed of a tachometer input.
+  * @param  name: input name
+  * @param  cap: capture channel
+  * @param  stats: statistics of the last batch
+  * @retval none
+  */
+void tacho_report(const char *name, tmr_cap_type *cap, tmr_cap_stats_type *stats)
+{
+  if(stats->count == 0 && tmr_cap_idle_ticks(cap) > (tmr2_clock / 1000) * IDLE_MS)
+  {
+    printf("%s: stopped\r\n", name);
+    return;
+  }
+
+  printf("%s: %u periods, freq=%.3fHz, min=%u max=%u jitter=%.1f ticks, overruns=%u\r\n",
+         name, stats->count, tmr_cap_frequency(stats, tmr2_clock),
+         stats->period_min, stats->period_max, tmr_cap_jitter(stats), cap->overruns);
+}
+
+/**
+  * @brief  this function handles dma1 channel1 handler, pwm rising edges.
+  * @param  none
+  * @retval none
+  */
+void DMA1_Channel1_IRQHandler(void)
+{
+  tmr_cap_dma_irq_handler(&cap_rise);
+}
+
+/**
+  * @brief  this function handles dma1 channel2 handler, pwm falling edges.
+  * @param  none
+  * @retval none
+  */
+void DMA1_Channel2_IRQHandler(void)
+{
+  tmr_cap_dma_irq_handler(&cap_fall);
+}
+
+/**
+  * @brief  this function handles dma1 channel3 handler, tachometer a.
+  * @param  none
+  * @retval none
+  */
+void DMA1_Channel3_IRQHandler(void)
+{
+  tmr_cap_dma_irq_handler(&cap_tacho_a);
+}
+
+/**
+  * @brief  this function handles dma1 channel4 handler, tachometer b.
+  * @param  none
+  * @retval none
+  */
+void DMA1_Channel4_IRQHandler(void)
+{
+  tmr_cap_dma_irq_handler(&cap_tacho_b);
+}
+
+/**
+  * @brief  tmr3 channel 1 1khz 30% pwm on pa6 as test signal.
+  * @param  none
+  * @retval none
+  */
+void test_signal_config(void)
+{
+  tmr_output_config_type tmr_oc_init_structure;
+
+  /* 1mhz counter clock, 1000 ticks period */
+  tmr_base_init(TMR3, 999, (tmr2_clock / 1000000) - 1);
+  tmr_cnt_dir_set(TMR3, TMR_COUNT_UP);
+
+  tmr_output_default_para_init(&tmr_oc_init_structure);
+  tmr_oc_init_structure.oc_mode = TMR_OUTPUT_CONTROL_PWM_MODE_A;
+  tmr_oc_init_structure.oc_idle_state = FALSE;
+  tmr_oc_init_structure.oc_polarity = TMR_OUTPUT_ACTIVE_HIGH;
+  tmr_oc_init_structure.oc_output_state = TRUE;
+  tmr_output_channel_config(TMR3, TMR_SELECT_CHANNEL_1, &tmr_oc_init_structure);
+  tmr_channel_value_set(TMR3, TMR_SELECT_CHANNEL_1, 300);
+
+  tmr_counter_enable(TMR3, TRUE);
+}
+
+/**
+  * @brief  configure the tmr2 input and tmr3 output pins.
+  * @param  none
+  * @retval none
+  */
+void gpio_configuration(void)
+{
+  gpio_init_type gpio_init_struct;
+
+  gpio_default_para_init(&gpio_init_struct);
+
+  gpio_init_struct.gpio_pins = GPIO_PINS_0 | GPIO_PINS_2 | GPIO_PINS_3 | GPIO_PINS_6;
+  gpio_init_struct.gpio_out_type = GPIO_OUTPUT_PUSH_PULL;
+  gpio_init_struct.gpio_pull = GPIO_PULL_NONE;
+  gpio_init_struct.gpio_mode = GPIO_MODE_MUX;
+  gpio_init_struct.gpio_drive_strength = GPIO_DRIVE_STRENGTH_STRONGER;
+  gpio_init(GPIOA, &gpio_init_struct);
+
+  gpio_pin_mux_config(GPIOA, GPIO_PINS_SOURCE0, GPIO_MUX_1);
+  gpio_pin_mux_config(GPIOA, GPIO_PINS_SOURCE2, GPIO_MUX_1);
+  gpio_pin_mux_config(GPIOA, GPIO_PINS_SOURCE3, GPIO_MUX_1);
+  gpio_pin_mux_config(GPIOA, GPIO_PINS_SOURCE6, GPIO_MUX_2);
+}
+
+/**
+  * @brief  configures the different peripheral clocks.
+  * @param  none
+  * @retval none
+  */
+void crm_configuration(void)
+{
+  /* tmr2/tmr3 clock enable */
+  crm_periph_clock_enable(CRM_TMR2_PERIPH_CLOCK, TRUE);
+  crm_periph_clock_enable(CRM_TMR3_PERIPH_CLOCK, TRUE);
+
+  /* gpioa clock enable */
+  crm_periph_clock_enable(CRM_GPIOA_PERIPH_CLOCK, TRUE);
+
+  /* dma clock enable */
+  crm_periph_clock_enable(CRM_DMA1_PERIPH_CLOCK, TRUE);
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
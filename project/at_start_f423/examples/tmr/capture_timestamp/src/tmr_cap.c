@@ -0,0 +1,427 @@
+/**
+  **************************************************************************
+  * @file     tmr_cap.c
+  * @brief    tmr input capture timestamp service
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* includes ------------------------------------------------------------------*/
+#include <math.h>
+#include "tmr_cap.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_TMR_capture_timestamp
+  * @{
+  */
+
+/**
+  * @brief  peek the oldest undrained timestamp, extended to 64 bits.
+  *         the 32-bit counter is assumed to wrap at most once between two
+  *         consecutive edges of the channel.
+  * @param  cap: capture channel with at least one pending entry
+  * @retval extended timestamp
+  */
+static uint64_t tmr_cap_peek(tmr_cap_type *cap)
+{
+  uint32_t stamp = cap->ring[cap->read_index];
+  uint32_t high = cap->high;
+
+  if(cap->primed != 0 && stamp < (uint32_t)cap->last)
+  {
+    high++;
+  }
+
+  return ((uint64_t)high << 32) | stamp;
+}
+
+/**
+  * @brief  add one period to the batch statistics.
+  * @param  stats: statistics
+  * @param  period: period in timer ticks
+  * @param  high: high time in timer ticks
+  * @retval none
+  */
+static void tmr_cap_stats_add(tmr_cap_stats_type *stats, uint32_t period, uint32_t high)
+{
+  int64_t dev;
+  uint64_t dev_abs;
+
+  if(stats->count == 0)
+  {
+    stats->reference = period;
+    stats->period_min = period;
+    stats->period_max = period;
+  }
+
+  if(period < stats->period_min)
+  {
+    stats->period_min = period;
+  }
+  if(period > stats->period_max)
+  {
+    stats->period_max = period;
+  }
+
+  dev = (int64_t)period - stats->reference;
+  dev_abs = (dev < 0) ? (uint64_t)(-dev) : (uint64_t)dev;
+  stats->dev_sum += dev;
+  stats->dev_sq_sum += dev_abs * dev_abs;
+  stats->high_sum += high;
+  stats->count++;
+}
+
+/**
+  * @brief  start a capture channel, the timer base is configured and the
+  *         dma clock is enabled by the application before.
+  * @param  cap: capture channel
+  * @retval none
+  */
+void tmr_cap_start(tmr_cap_type *cap)
+{
+  tmr_input_config_type input_struct;
+  dma_init_type dma_init_struct;
+  uint32_t index = cap->tmr_channel >> 1;
+
+  cap->read_index = 0;
+  cap->laps = 0;
+  cap->read_count = 0;
+  cap->overruns = 0;
+  cap->high = 0;
+  cap->last = 0;
+  cap->primed = 0;
+
+  /* c1dt..c4dt are consecutive words */
+  dmamux_enable(DMA1, TRUE);
+  dma_reset(cap->dma_channel);
+  dma_default_para_init(&dma_init_struct);
+  dma_init_struct.buffer_size = cap->size;
+  dma_init_struct.direction = DMA_DIR_PERIPHERAL_TO_MEMORY;
+  dma_init_struct.memory_base_addr = (uint32_t)cap->ring;
+  dma_init_struct.memory_data_width = DMA_MEMORY_DATA_WIDTH_WORD;
+  dma_init_struct.memory_inc_enable = TRUE;
+  dma_init_struct.peripheral_base_addr = (uint32_t)(&cap->tmr_x->c1dt + index);
+  dma_init_struct.peripheral_data_width = DMA_PERIPHERAL_DATA_WIDTH_WORD;
+  dma_init_struct.peripheral_inc_enable = FALSE;
+  dma_init_struct.priority = DMA_PRIORITY_HIGH;
+  dma_init_struct.loop_mode_enable = TRUE;
+  dma_init(cap->dma_channel, &dma_init_struct);
+  dmamux_init(cap->dmamux_channel, cap->dmamux_request);
+
+  /* one interrupt per ring lap, not per edge */
+  dma_flag_clear(cap->dma_fdt_flag);
+  dma_interrupt_enable(cap->dma_channel, DMA_FDT_INT, TRUE);
+  dma_channel_enable(cap->dma_channel, TRUE);
+
+  input_struct.input_channel_select = cap->tmr_channel;
+  input_struct.input_polarity_select = cap->polarity;
+  input_struct.input_mapped_select = cap->mapped;
+  input_struct.input_filter_value = cap->filter;
+  tmr_input_channel_init(cap->tmr_x, &input_struct, TMR_CHANNEL_INPUT_DIV_1);
+
+  tmr_dma_request_enable(cap->tmr_x, (tmr_dma_request_type)(TMR_C1_DMA_REQUEST << index), TRUE);
+}
+
+/**
+  * @brief  stop a capture channel.
+  * @param  cap: capture channel
+  * @retval none
+  */
+void tmr_cap_stop(tmr_cap_type *cap)
+{
+  uint32_t index = cap->tmr_channel >> 1;
+
+  tmr_dma_request_enable(cap->tmr_x, (tmr_dma_request_type)(TMR_C1_DMA_REQUEST << index), FALSE);
+  dma_interrupt_enable(cap->dma_channel, DMA_FDT_INT, FALSE);
+  dma_channel_enable(cap->dma_channel, FALSE);
+}
+
+/**
+  * @brief  count a ring lap, called from the dma channel interrupt.
+  * @param  cap: capture channel
+  * @retval none
+  */
+void tmr_cap_dma_irq_handler(tmr_cap_type *cap)
+{
+  if(dma_interrupt_flag_get(cap->dma_fdt_flag) != RESET)
+  {
+    dma_flag_clear(cap->dma_fdt_flag);
+    cap->laps++;
+  }
+}
+
+/**
+  * @brief  entries written by the dma since the start, modulo 2^32. a lap
+  *         whose interrupt is still pending is counted from its flag, the
+  *         flag is read around the counter to pair them consistently.
+  * @param  cap: capture channel
+  * @retval written entries
+  */
+static uint32_t tmr_cap_written(tmr_cap_type *cap)
+{
+  flag_status before, after;
+  uint32_t laps, remaining, primask;
+
+  primask = __get_PRIMASK();
+  do
+  {
+    __disable_irq();
+    before = dma_flag_get(cap->dma_fdt_flag);
+    remaining = dma_data_number_get(cap->dma_channel);
+    after = dma_flag_get(cap->dma_fdt_flag);
+    laps = cap->laps;
+    __set_PRIMASK(primask);
+  } while(before != after);
+
+  if(after == SET)
+  {
+    laps++;
+  }
+
+  return laps * cap->size + (cap->size - remaining) % cap->size;
+}
+
+/**
+  * @brief  number of timestamps written by the dma and not drained yet.
+  *         when the dma is a whole ring ahead the undrained entries may be
+  *         overwritten, they are dropped, the overrun is counted and the next
+  *         edge starts a new sequence without a period to the previous one.
+  * @param  cap: capture channel
+  * @retval pending entries
+  */
+uint16_t tmr_cap_pending(tmr_cap_type *cap)
+{
+  uint32_t written = tmr_cap_written(cap);
+  uint32_t pending = written - cap->read_count;
+
+  if((int32_t)pending < 0)
+  {
+    /* counter reloaded before its lap flag was set */
+    return 0;
+  }
+  if(pending >= cap->size)
+  {
+    cap->overruns++;
+    cap->read_count = written;
+    cap->read_index = written % cap->size;
+    cap->primed = 0;
+    return 0;
+  }
+
+  return (uint16_t)pending;
+}
+
+/**
+  * @brief  drain the oldest timestamp.
+  * @param  cap: capture channel with at least one pending entry
+  * @retval timestamp extended to 64 bits
+  */
+uint64_t tmr_cap_pop(tmr_cap_type *cap)
+{
+  uint64_t stamp = tmr_cap_peek(cap);
+
+  cap->high = (uint32_t)(stamp >> 32);
+  cap->last = stamp;
+  cap->primed = 1;
+  cap->read_index = (cap->read_index + 1) % cap->size;
+  cap->read_count++;
+
+  return stamp;
+}
+
+/**
+  * @brief  timer ticks since the last drained edge, used to detect a
+  *         stopped signal. valid up to one counter turn.
+  * @param  cap: capture channel
+  * @retval ticks, 0xFFFFFFFF if no edge was drained yet
+  */
+uint32_t tmr_cap_idle_ticks(tmr_cap_type *cap)
+{
+  if(cap->primed == 0)
+  {
+    return 0xFFFFFFFF;
+  }
+
+  return tmr_counter_value_get(cap->tmr_x) - (uint32_t)cap->last;
+}
+
+/**
+  * @brief  clear batch statistics.
+  * @param  stats: statistics
+  * @retval none
+  */
+void tmr_cap_stats_reset(tmr_cap_stats_type *stats)
+{
+  stats->count = 0;
+  stats->reference = 0;
+  stats->period_min = 0;
+  stats->period_max = 0;
+  stats->dev_sum = 0;
+  stats->dev_sq_sum = 0;
+  stats->high_sum = 0;
+}
+
+/**
+  * @brief  drain a channel and add the periods between its edges.
+  * @param  cap: capture channel
+  * @param  stats: statistics
+  * @retval number of periods added
+  */
+uint32_t tmr_cap_period_batch(tmr_cap_type *cap, tmr_cap_stats_type *stats)
+{
+  uint32_t added = 0;
+  uint64_t prev;
+  uint8_t primed;
+
+  while(tmr_cap_pending(cap) != 0)
+  {
+    prev = cap->last;
+    primed = cap->primed;
+    if(primed != 0)
+    {
+      tmr_cap_stats_add(stats, (uint32_t)(tmr_cap_pop(cap) - prev), 0);
+      added++;
+    }
+    else
+    {
+      tmr_cap_pop(cap);
+    }
+  }
+
+  return added;
+}
+
+/**
+  * @brief  drain a rising and a falling edge channel of the same signal and
+  *         add every period that has its falling edge captured. a period
+  *         stays pending until its closing rising edge is captured.
+  * @param  rise: rising edge channel
+  * @param  fall: falling edge channel
+  * @param  stats: statistics
+  * @retval number of periods added
+  */
+uint32_t tmr_cap_duty_batch(tmr_cap_type *rise, tmr_cap_type *fall, tmr_cap_stats_type *stats)
+{
+  uint32_t added = 0;
+  uint64_t next, falling, prev;
+
+  while(tmr_cap_pending(rise) != 0)
+  {
+    if(rise->primed == 0)
+    {
+      tmr_cap_pop(rise);
+      continue;
+    }
+
+    /* drop falling edges before the period start */
+    while(tmr_cap_pending(fall) != 0 && tmr_cap_peek(fall) <= rise->last)
+    {
+      tmr_cap_pop(fall);
+    }
+
+    next = tmr_cap_peek(rise);
+    if(tmr_cap_pending(fall) == 0 || tmr_cap_peek(fall) > next)
+    {
+      /* falling edge filtered out, skip the period */
+      tmr_cap_pop(rise);
+      continue;
+    }
+
+    falling = tmr_cap_pop(fall);
+    prev = rise->last;
+    tmr_cap_pop(rise);
+    tmr_cap_stats_add(stats, (uint32_t)(next - prev), (uint32_t)(falling - prev));
+    added++;
+  }
+
+  return added;
+}
+
+/**
+  * @brief  mean frequency of the batch.
+  * @param  stats: statistics
+  * @param  clock: timer counter clock in hz
+  * @retval frequency in hz, 0 if empty
+  */
+float tmr_cap_frequency(tmr_cap_stats_type *stats, uint32_t clock)
+{
+  float mean;
+
+  if(stats->count == 0)
+  {
+    return 0;
+  }
+
+  mean = (float)stats->reference + (float)stats->dev_sum / stats->count;
+  return (float)clock / mean;
+}
+
+/**
+  * @brief  mean duty cycle of a duty batch.
+  * @param  stats: statistics
+  * @retval duty in percent, 0 if empty
+  */
+float tmr_cap_duty(tmr_cap_stats_type *stats)
+{
+  float total;
+
+  if(stats->count == 0)
+  {
+    return 0;
+  }
+
+  total = (float)stats->reference * stats->count + (float)stats->dev_sum;
+  return (float)stats->high_sum * 100.0f / total;
+}
+
+/**
+  * @brief  rms period jitter of the batch.
+  * @param  stats: statistics
+  * @retval standard deviation of the period in timer ticks
+  */
+float tmr_cap_jitter(tmr_cap_stats_type *stats)
+{
+  float mean, variance;
+
+  if(stats->count == 0)
+  {
+    return 0;
+  }
+
+  mean = (float)stats->dev_sum / stats->count;
+  variance = (float)stats->dev_sq_sum / stats->count - mean * mean;
+  if(variance < 0)
+  {
+    variance = 0;
+  }
+
+  return sqrtf(variance);
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,141 @@
+/**
+  **************************************************************************
+  * @file     tmr_seq.h
+  * @brief    tmr dma burst sequencer header
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* define to prevent recursive inclusion -------------------------------------*/
+#ifndef __TMR_SEQ_H
+#define __TMR_SEQ_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* includes ------------------------------------------------------------------*/
+#include "at32f423.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_TMR_dma_burst_sequencer
+  * @{
+  */
+
+/* halfwords per frame, one dma burst from pr to c4dt */
+#define TMR_SEQ_FRAME_HALFWORDS          6
+
+/* electrical angle of 120 and 90 degrees, a full turn is 2^32 */
+#define TMR_SEQ_ANGLE_120                0x55555555
+#define TMR_SEQ_ANGLE_90                 0x40000000
+
+/**
+  * @brief one timer period, written by the overflow dma burst into pr, rpr
+  *        and c1dt..c4dt. the values take effect on the following overflow
+  *        since the period and channel buffers are enabled.
+  */
+typedef struct
+{
+  uint16_t period;                       /*!< pr value */
+  uint16_t repetition;                   /*!< rpr value, the frame lasts repetition + 1 periods */
+  uint16_t compare[4];                   /*!< c1dt..c4dt values */
+} tmr_seq_frame_type;
+
+/**
+  * @brief refill callback, write count frames starting at frames
+  */
+typedef void (*tmr_seq_refill_type)(tmr_seq_frame_type *frames, uint32_t count);
+
+/**
+  * @brief sequencer handle
+  */
+typedef struct
+{
+  tmr_type                               *tmr_x;          /*!< timer, rpr is only used by tmr1       */
+  dma_channel_type                       *dma_channel;    /*!< dma channel */
+  dmamux_channel_type                    *dmamux_channel; /*!< dmamux channel of the dma channel */
+  dmamux_requst_id_sel_type              dmamux_request;  /*!< overflow dma request of the timer */
+  uint32_t                               hdt_flag;        /*!< half transfer flag of the dma channel */
+  uint32_t                               fdt_flag;        /*!< full transfer flag of the dma channel */
+  tmr_seq_frame_type                     *frames;         /*!< circular buffer of 2 * half_frames */
+  uint16_t                               half_frames;     /*!< frames refilled per interrupt */
+  tmr_seq_refill_type                    refill;          /*!< refill callback */
+  uint32_t                               late_count;      /*!< refills done after the dma entered the half */
+} tmr_seq_type;
+
+/**
+  * @brief space vector pwm generator, three phases on channel 1..3 with
+  *        min-max zero sequence injection, channel 4 marks the half period.
+  */
+typedef struct
+{
+  uint32_t angle;                        /*!< electrical angle */
+  uint32_t angle_step;                   /*!< angle increment per frame */
+  uint16_t modulation;                   /*!< q15 modulation index, linear up to 37837 (2/sqrt(3)) */
+} tmr_seq_svpwm_type;
+
+/**
+  * @brief led dimmer generator, each channel fades to its target on a
+  *        quadratic curve that looks linear to the eye.
+  */
+typedef struct
+{
+  uint16_t level[4];                     /*!< current brightness, 0..65535 */
+  uint16_t target[4];                    /*!< target brightness */
+  uint16_t step[4];                      /*!< level change per frame */
+} tmr_seq_dimmer_type;
+
+/**
+  * @brief stepper micro-stepping generator for two full bridges, phase a
+  *        on channel 1/2 and phase b on channel 3/4 (one pwm per bridge leg).
+  */
+typedef struct
+{
+  uint32_t angle;                        /*!< electrical angle, one turn is four full steps */
+  int32_t angle_step;                    /*!< signed angle increment per frame, sets speed and direction */
+  uint16_t current;                      /*!< q15 phase current amplitude */
+} tmr_seq_stepper_type;
+
+error_status tmr_seq_init(tmr_seq_type *seq);
+void tmr_seq_start(tmr_seq_type *seq);
+void tmr_seq_stop(tmr_seq_type *seq);
+void tmr_seq_dma_handler(tmr_seq_type *seq);
+
+int32_t tmr_seq_sin(uint32_t angle);
+void tmr_seq_svpwm_fill(tmr_seq_svpwm_type *svpwm, tmr_seq_frame_type *frames, uint32_t count, uint16_t period);
+void tmr_seq_dimmer_fill(tmr_seq_dimmer_type *dimmer, tmr_seq_frame_type *frames, uint32_t count, uint16_t period);
+void tmr_seq_stepper_fill(tmr_seq_stepper_type *stepper, tmr_seq_frame_type *frames, uint32_t count, uint16_t period);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,205 @@
+/**
+  **************************************************************************
+  * @file     main.c
+  * @brief    main program
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "at32f423_board.h"
+#include "at32f423_clock.h"
+#include "tmr_seq.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_TMR_dma_burst_sequencer TMR_dma_burst_sequencer
+  * @{
+  */
+
+#define PWM_FREQUENCY                    20000
+#define SEQ_HALF_FRAMES                  32
+
+/* 50 hz electrical frequency at the pwm frequency */
+#define ANGLE_STEP_50HZ                  ((uint32_t)(((uint64_t)50 << 32) / PWM_FREQUENCY))
+
+gpio_init_type  gpio_init_struct = {0};
+tmr_output_config_type  tmr_output_struct;
+crm_clocks_freq_type crm_clocks_freq_struct = {0};
+
+uint16_t timerperiod = 0;
+tmr_seq_frame_type seq_frames[SEQ_HALF_FRAMES * 2];
+tmr_seq_type pwm_seq;
+tmr_seq_svpwm_type svpwm;
+tmr_seq_dimmer_type dimmer;
+tmr_seq_stepper_type stepper;
+volatile uint32_t seq_mode = 0;
+
+/**
+  * @brief  sequencer refill callback, generates the frames of the current mode.
+  * @param  frames: frames to fill
+  * @param  count: number of frames
+  * @retval none
+  */
+void seq_refill(tmr_seq_frame_type *frames, uint32_t count)
+{
+  uint32_t i_index;
+
+  switch(seq_mode)
+  {
+    case 0:
+      tmr_seq_svpwm_fill(&svpwm, frames, count, timerperiod);
+      break;
+    case 1:
+      /* breathing leds, reverse each channel at the end of its fade */
+      for(i_index = 0; i_index < 4; i_index ++)
+      {
+        if(dimmer.level[i_index] == dimmer.target[i_index])
+        {
+          dimmer.target[i_index] = dimmer.target[i_index] ? 0 : 0xFFFF;
+        }
+      }
+      tmr_seq_dimmer_fill(&dimmer, frames, count, timerperiod);
+      break;
+    default:
+      tmr_seq_stepper_fill(&stepper, frames, count, timerperiod);
+      break;
+  }
+}
+
+/**
+  * @brief  this function handles dma1 channel1 handler.
+  * @param  none
+  * @retval none
+  */
+void DMA1_Channel1_IRQHandler(void)
+{
+  tmr_seq_dma_handler(&pwm_seq);
+}
+
+/**
+  * @brief  main function.
+  * @param  none
+  * @retval none
+  */
+int main(void)
+{
+  uint32_t i_index;
+
+  system_clock_config();
+
+  at32_board_init();
+
+  /* get system clock */
+  crm_clocks_freq_get(&crm_clocks_freq_struct);
+
+  at32_led_on(LED2);
+
+  /* enable tmr1/gpioa clock */
+  crm_periph_clock_enable(CRM_TMR1_PERIPH_CLOCK, TRUE);
+  crm_periph_clock_enable(CRM_GPIOA_PERIPH_CLOCK, TRUE);
+
+  /* timer1 channel 1..4 output pins configuration */
+  gpio_init_struct.gpio_pins = GPIO_PINS_8 | GPIO_PINS_9 | GPIO_PINS_10 | GPIO_PINS_11;
+  gpio_init_struct.gpio_mode = GPIO_MODE_MUX;
+  gpio_init_struct.gpio_out_type = GPIO_OUTPUT_PUSH_PULL;
+  gpio_init_struct.gpio_pull = GPIO_PULL_NONE;
+  gpio_init_struct.gpio_drive_strength = GPIO_DRIVE_STRENGTH_STRONGER;
+  gpio_init(GPIOA, &gpio_init_struct);
+
+  gpio_pin_mux_config(GPIOA, GPIO_PINS_SOURCE8, GPIO_MUX_1);
+  gpio_pin_mux_config(GPIOA, GPIO_PINS_SOURCE9, GPIO_MUX_1);
+  gpio_pin_mux_config(GPIOA, GPIO_PINS_SOURCE10, GPIO_MUX_1);
+  gpio_pin_mux_config(GPIOA, GPIO_PINS_SOURCE11, GPIO_MUX_1);
+
+  /* tmr1 counter clock = apb2_freq, pwm frequency = 20 khz */
+  timerperiod = (crm_clocks_freq_struct.apb2_freq / PWM_FREQUENCY) - 1;
+  tmr_base_init(TMR1, timerperiod, 0);
+  tmr_cnt_dir_set(TMR1, TMR_COUNT_UP);
+
+  /* channel 1..4 in pwm mode a */
+  tmr_output_default_para_init(&tmr_output_struct);
+  tmr_output_struct.oc_mode = TMR_OUTPUT_CONTROL_PWM_MODE_A;
+  tmr_output_struct.oc_output_state = TRUE;
+  tmr_output_struct.oc_polarity = TMR_OUTPUT_ACTIVE_HIGH;
+  tmr_output_struct.oc_idle_state = FALSE;
+  tmr_output_channel_config(TMR1, TMR_SELECT_CHANNEL_1, &tmr_output_struct);
+  tmr_output_channel_config(TMR1, TMR_SELECT_CHANNEL_2, &tmr_output_struct);
+  tmr_output_channel_config(TMR1, TMR_SELECT_CHANNEL_3, &tmr_output_struct);
+  tmr_output_channel_config(TMR1, TMR_SELECT_CHANNEL_4, &tmr_output_struct);
+
+  /* generators */
+  svpwm.angle = 0;
+  svpwm.angle_step = ANGLE_STEP_50HZ;
+  svpwm.modulation = 29491;
+  for(i_index = 0; i_index < 4; i_index ++)
+  {
+    dimmer.level[i_index] = 0;
+    dimmer.target[i_index] = 0xFFFF;
+    dimmer.step[i_index] = 3 * (i_index + 1);
+  }
+  stepper.angle = 0;
+  stepper.angle_step = (int32_t)ANGLE_STEP_50HZ;
+  stepper.current = 26214;
+
+  /* stream pr, rpr and c1dt..c4dt from the frame buffer on every overflow */
+  pwm_seq.tmr_x = TMR1;
+  pwm_seq.dma_channel = DMA1_CHANNEL1;
+  pwm_seq.dmamux_channel = DMA1MUX_CHANNEL1;
+  pwm_seq.dmamux_request = DMAMUX_DMAREQ_ID_TMR1_OVERFLOW;
+  pwm_seq.hdt_flag = DMA1_HDT1_FLAG;
+  pwm_seq.fdt_flag = DMA1_FDT1_FLAG;
+  pwm_seq.frames = seq_frames;
+  pwm_seq.half_frames = SEQ_HALF_FRAMES;
+  pwm_seq.refill = seq_refill;
+  tmr_seq_init(&pwm_seq);
+  nvic_irq_enable(DMA1_Channel1_IRQn, 1, 0);
+  tmr_seq_start(&pwm_seq);
+
+  /* tmr1 output enable */
+  tmr_output_enable(TMR1, TRUE);
+  /* enable tmr1 */
+  tmr_counter_enable(TMR1, TRUE);
+
+  while(1)
+  {
+    /* user button selects svpwm, led dimming or stepper */
+    if(at32_button_press() == USER_BUTTON)
+    {
+      seq_mode = (seq_mode + 1) % 3;
+      at32_led_toggle(LED3);
+    }
+
+    /* led4 lights if a refill came too late */
+    if(pwm_seq.late_count != 0)
+    {
+      at32_led_on(LED4);
+    }
+  }
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
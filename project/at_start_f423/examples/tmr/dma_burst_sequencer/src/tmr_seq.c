@@ -0,0 +1,312 @@
+/**
+  **************************************************************************
+  * @file     tmr_seq.c
+  * @brief    tmr dma burst sequencer
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "tmr_seq.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_TMR_dma_burst_sequencer
+  * @{
+  */
+
+#define SEQ_MAX(a, b)                    (((a) > (b)) ? (a) : (b))
+#define SEQ_MIN(a, b)                    (((a) < (b)) ? (a) : (b))
+
+/* q15 sine of the first quadrant in 64 steps */
+static const int16_t sin_quarter_table[65] =
+{
+      0,   804,  1608,  2410,  3212,  4011,  4808,  5602,
+   6393,  7179,  7962,  8739,  9512, 10278, 11039, 11793,
+  12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+  18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+  23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+  27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+  30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971,
+  32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+  32767
+};
+
+/**
+  * @brief  refill one half of the frame buffer and check that the dma
+  *         had not yet wrapped into it
+  * @param  seq: sequencer handle
+  * @param  half: half index, 0 or 1
+  * @retval none
+  */
+static void tmr_seq_refill_half(tmr_seq_type *seq, uint32_t half)
+{
+  uint32_t total = seq->half_frames * 2 * TMR_SEQ_FRAME_HALFWORDS;
+  uint32_t position;
+
+  seq->refill(seq->frames + half * seq->half_frames, seq->half_frames);
+
+  position = total - dma_data_number_get(seq->dma_channel);
+  if((half == 0 && position < total / 2) || (half == 1 && position >= total / 2))
+  {
+    seq->late_count ++;
+  }
+}
+
+/**
+  * @brief  initialize the dma burst sequencer, the timer base and the channel
+  *         outputs are configured by the application before.
+  * @param  seq: sequencer handle with all fields but late_count set
+  * @retval SUCCESS or ERROR
+  */
+error_status tmr_seq_init(tmr_seq_type *seq)
+{
+  dma_init_type dma_init_struct;
+
+  if(seq->frames == 0 || seq->refill == 0 || seq->half_frames == 0)
+  {
+    return ERROR;
+  }
+
+  seq->late_count = 0;
+
+  /* new values are latched on the overflow after the burst */
+  tmr_period_buffer_enable(seq->tmr_x, TRUE);
+  tmr_output_channel_buffer_enable(seq->tmr_x, TMR_SELECT_CHANNEL_1, TRUE);
+  tmr_output_channel_buffer_enable(seq->tmr_x, TMR_SELECT_CHANNEL_2, TRUE);
+  tmr_output_channel_buffer_enable(seq->tmr_x, TMR_SELECT_CHANNEL_3, TRUE);
+  tmr_output_channel_buffer_enable(seq->tmr_x, TMR_SELECT_CHANNEL_4, TRUE);
+
+  /* every overflow request writes pr, rpr, c1dt, c2dt, c3dt and c4dt */
+  tmr_dma_control_config(seq->tmr_x, TMR_DMA_TRANSFER_6BYTES, TMR_PR_ADDRESS);
+
+  crm_periph_clock_enable(CRM_DMA1_PERIPH_CLOCK, TRUE);
+  dmamux_enable(DMA1, TRUE);
+
+  dma_reset(seq->dma_channel);
+  dma_default_para_init(&dma_init_struct);
+  dma_init_struct.buffer_size = seq->half_frames * 2 * TMR_SEQ_FRAME_HALFWORDS;
+  dma_init_struct.direction = DMA_DIR_MEMORY_TO_PERIPHERAL;
+  dma_init_struct.memory_base_addr = (uint32_t)seq->frames;
+  dma_init_struct.memory_data_width = DMA_MEMORY_DATA_WIDTH_HALFWORD;
+  dma_init_struct.memory_inc_enable = TRUE;
+  dma_init_struct.peripheral_base_addr = (uint32_t)&seq->tmr_x->dmadt;
+  dma_init_struct.peripheral_data_width = DMA_PERIPHERAL_DATA_WIDTH_HALFWORD;
+  dma_init_struct.peripheral_inc_enable = FALSE;
+  dma_init_struct.priority = DMA_PRIORITY_HIGH;
+  dma_init_struct.loop_mode_enable = TRUE;
+  dma_init(seq->dma_channel, &dma_init_struct);
+  dmamux_init(seq->dmamux_channel, seq->dmamux_request);
+
+  dma_interrupt_enable(seq->dma_channel, DMA_HDT_INT | DMA_FDT_INT, TRUE);
+
+  return SUCCESS;
+}
+
+/**
+  * @brief  fill both halves and start streaming frames, the timer counter
+  *         is started by the application.
+  * @param  seq: sequencer handle
+  * @retval none
+  */
+void tmr_seq_start(tmr_seq_type *seq)
+{
+  seq->refill(seq->frames, seq->half_frames);
+  seq->refill(seq->frames + seq->half_frames, seq->half_frames);
+
+  dma_data_number_set(seq->dma_channel, seq->half_frames * 2 * TMR_SEQ_FRAME_HALFWORDS);
+  dma_channel_enable(seq->dma_channel, TRUE);
+  tmr_dma_request_enable(seq->tmr_x, TMR_OVERFLOW_DMA_REQUEST, TRUE);
+}
+
+/**
+  * @brief  stop streaming, the last frame stays in the timer registers
+  * @param  seq: sequencer handle
+  * @retval none
+  */
+void tmr_seq_stop(tmr_seq_type *seq)
+{
+  tmr_dma_request_enable(seq->tmr_x, TMR_OVERFLOW_DMA_REQUEST, FALSE);
+  dma_channel_enable(seq->dma_channel, FALSE);
+}
+
+/**
+  * @brief  dma interrupt, call from the irq handler of the sequencer dma channel
+  * @param  seq: sequencer handle
+  * @retval none
+  */
+void tmr_seq_dma_handler(tmr_seq_type *seq)
+{
+  if(dma_interrupt_flag_get(seq->hdt_flag) != RESET)
+  {
+    dma_flag_clear(seq->hdt_flag);
+    tmr_seq_refill_half(seq, 0);
+  }
+
+  if(dma_interrupt_flag_get(seq->fdt_flag) != RESET)
+  {
+    dma_flag_clear(seq->fdt_flag);
+    tmr_seq_refill_half(seq, 1);
+  }
+}
+
+/**
+  * @brief  q15 sine with linear interpolation
+  * @param  angle: a full turn is 2^32
+  * @retval sine value, -32767..32767
+  */
+int32_t tmr_seq_sin(uint32_t angle)
+{
+  uint32_t quadrant = angle >> 30;
+  uint32_t index = (angle >> 24) & 0x3F;
+  int32_t frac = (angle >> 16) & 0xFF;
+  int32_t value, next;
+
+  if(quadrant & 1)
+  {
+    value = sin_quarter_table[64 - index];
+    next = sin_quarter_table[63 - index];
+  }
+  else
+  {
+    value = sin_quarter_table[index];
+    next = sin_quarter_table[index + 1];
+  }
+  value += ((next - value) * frac) >> 8;
+
+  return (quadrant & 2) ? -value : value;
+}
+
+/**
+  * @brief  generate space vector pwm frames
+  * @param  svpwm: generator state
+  * @param  frames: frame buffer
+  * @param  count: number of frames
+  * @param  period: pr value of every frame
+  * @retval none
+  */
+void tmr_seq_svpwm_fill(tmr_seq_svpwm_type *svpwm, tmr_seq_frame_type *frames, uint32_t count, uint16_t period)
+{
+  int32_t phase[3], offset, max, min;
+  uint32_t i_index, j_index;
+
+  for(i_index = 0; i_index < count; i_index ++)
+  {
+    phase[0] = (tmr_seq_sin(svpwm->angle) * svpwm->modulation) >> 15;
+    phase[1] = (tmr_seq_sin(svpwm->angle - TMR_SEQ_ANGLE_120) * svpwm->modulation) >> 15;
+    phase[2] = (tmr_seq_sin(svpwm->angle + TMR_SEQ_ANGLE_120) * svpwm->modulation) >> 15;
+
+    /* min-max injection centers the three duties, same result as the
+       sector based space vector modulation */
+    max = SEQ_MAX(phase[0], SEQ_MAX(phase[1], phase[2]));
+    min = SEQ_MIN(phase[0], SEQ_MIN(phase[1], phase[2]));
+    offset = -(max + min) / 2;
+
+    frames[i_index].period = period;
+    frames[i_index].repetition = 0;
+    for(j_index = 0; j_index < 3; j_index ++)
+    {
+      frames[i_index].compare[j_index] = (uint16_t)(((uint32_t)(32768 + phase[j_index] + offset) * (period + 1)) >> 16);
+    }
+    frames[i_index].compare[3] = (period + 1) / 2;
+
+    svpwm->angle += svpwm->angle_step;
+  }
+}
+
+/**
+  * @brief  generate led dimming frames
+  * @param  dimmer: generator state
+  * @param  frames: frame buffer
+  * @param  count: number of frames
+  * @param  period: pr value of every frame
+  * @retval none
+  */
+void tmr_seq_dimmer_fill(tmr_seq_dimmer_type *dimmer, tmr_seq_frame_type *frames, uint32_t count, uint16_t period)
+{
+  uint32_t i_index, j_index, level;
+
+  for(i_index = 0; i_index < count; i_index ++)
+  {
+    frames[i_index].period = period;
+    frames[i_index].repetition = 0;
+
+    for(j_index = 0; j_index < 4; j_index ++)
+    {
+      if(dimmer->level[j_index] + dimmer->step[j_index] < dimmer->target[j_index])
+      {
+        dimmer->level[j_index] += dimmer->step[j_index];
+      }
+      else if(dimmer->level[j_index] > dimmer->target[j_index] + dimmer->step[j_index])
+      {
+        dimmer->level[j_index] -= dimmer->step[j_index];
+      }
+      else
+      {
+        dimmer->level[j_index] = dimmer->target[j_index];
+      }
+
+      /* quadratic curve, duty = (level / 65536)^2 */
+      level = dimmer->level[j_index];
+      frames[i_index].compare[j_index] = (uint16_t)((((level * level) >> 16) * (period + 1)) >> 16);
+    }
+  }
+}
+
+/**
+  * @brief  generate stepper micro-stepping frames, each bridge leg gets the
+  *         positive or negative half of its phase current
+  * @param  stepper: generator state
+  * @param  frames: frame buffer
+  * @param  count: number of frames
+  * @param  period: pr value of every frame
+  * @retval none
+  */
+void tmr_seq_stepper_fill(tmr_seq_stepper_type *stepper, tmr_seq_frame_type *frames, uint32_t count, uint16_t period)
+{
+  int32_t phase[2];
+  uint32_t i_index, j_index, duty;
+
+  for(i_index = 0; i_index < count; i_index ++)
+  {
+    phase[0] = (tmr_seq_sin(stepper->angle) * stepper->current) >> 15;
+    phase[1] = (tmr_seq_sin(stepper->angle + TMR_SEQ_ANGLE_90) * stepper->current) >> 15;
+
+    frames[i_index].period = period;
+    frames[i_index].repetition = 0;
+    for(j_index = 0; j_index < 2; j_index ++)
+    {
+      duty = ((uint32_t)(phase[j_index] < 0 ? -phase[j_index] : phase[j_index]) * (period + 1)) >> 15;
+      frames[i_index].compare[j_index * 2] = (phase[j_index] > 0) ? (uint16_t)duty : 0;
+      frames[i_index].compare[j_index * 2 + 1] = (phase[j_index] < 0) ? (uint16_t)duty : 0;
+    }
+
+    stepper->angle += (uint32_t)stepper->angle_step;
+  }
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
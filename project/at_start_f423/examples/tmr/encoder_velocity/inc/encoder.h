@@ -0,0 +1,106 @@
+/**
+  **************************************************************************
+  * @file     encoder.h
+  * @brief    quadrature encoder header
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* define to prevent recursive inclusion -------------------------------------*/
+#ifndef __ENCODER_H
+#define __ENCODER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* includes ------------------------------------------------------------------*/
+#include "at32f423.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_TMR_encoder_velocity
+  * @{
+  */
+
+/* fractional bits of the velocity, counts per second */
+#define ENCODER_VELOCITY_Q               8
+
+/**
+  * @brief encoder snapshot, published as a whole by encoder_sample()
+  */
+typedef struct
+{
+  int64_t                                position;        /*!< multi-turn position from home, counts */
+  int32_t                                velocity;        /*!< counts per second, q8 */
+  uint32_t                               edge_time;       /*!< timestamp of the latest edge, time timer ticks */
+  uint32_t                               index_count;     /*!< index pulses seen */
+  int32_t                                index_error;     /*!< counts between the last two index pulses minus cpr */
+  uint8_t                                homed;           /*!< position is referenced to an index pulse */
+} encoder_snapshot_type;
+
+/**
+  * @brief encoder handle
+  */
+typedef struct
+{
+  tmr_type                               *count_tmr;      /*!< 16-bit timer in encoder mode, channel 3 captures the index */
+  tmr_type                               *time_tmr;       /*!< 32-bit free running timer, channel 1 captures every a/b edge */
+  uint32_t                               time_clock;      /*!< time_tmr counter clock in hz */
+  uint32_t                               timeout;         /*!< ticks without edge after which the velocity is zero */
+  uint32_t                               cpr;             /*!< counts per revolution, 0 disables the index check */
+
+  int64_t                                raw;             /*!< extended counter */
+  uint16_t                               last_count;      /*!< counter value at the last extension */
+  int64_t                                ref_position;    /*!< raw position at the reference edge */
+  uint32_t                               ref_time;        /*!< timestamp of the reference edge */
+  int32_t                                velocity;        /*!< last velocity, q8 */
+  int64_t                                home_offset;     /*!< raw position of the home index */
+  int64_t                                last_index;      /*!< raw position of the last index */
+  uint32_t                               index_count;     /*!< index pulses seen */
+  int32_t                                index_error;     /*!< last index check result */
+  uint8_t                                home_request;    /*!< take the next index as home */
+  uint8_t                                homed;           /*!< home_offset is valid */
+
+  volatile uint32_t                      sequence;        /*!< odd while the snapshot is written */
+  encoder_snapshot_type                  snapshot;        /*!< last published state */
+} encoder_type;
+
+void encoder_init(encoder_type *enc);
+void encoder_count_handler(encoder_type *enc);
+void encoder_sample(encoder_type *enc);
+void encoder_home(encoder_type *enc);
+void encoder_snapshot_read(encoder_type *enc, encoder_snapshot_type *snap);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,240 @@
+/**
+  **************************************************************************
+  * @file     encoder.c
+  * @brief    quadrature encoder position and velocity
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* includes ------------------------------------------------------------------*/
+#include "encoder.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_TMR_encoder_velocity
+  * @{
+  */
+
+/**
+  * @brief  extend the 16-bit counter by its signed difference, this is wrap
+  *         safe as long as it runs within 32768 counts.
+  * @param  enc: encoder handle
+  * @retval none
+  */
+static void encoder_extend(encoder_type *enc)
+{
+  uint16_t count = (uint16_t)tmr_counter_value_get(enc->count_tmr);
+
+  enc->raw += (int16_t)(count - enc->last_count);
+  enc->last_count = count;
+}
+
+/**
+  * @brief  q8 velocity of delta counts over ticks, saturated to int32.
+  * @param  delta: counts
+  * @param  ticks: time timer ticks, not 0
+  * @param  clock: time timer clock in hz
+  * @retval velocity in counts per second, q8
+  */
+static int32_t encoder_rate(int64_t delta, uint32_t ticks, uint32_t clock)
+{
+  uint64_t magnitude = (delta < 0) ? (uint64_t)(-delta) : (uint64_t)delta;
+
+  magnitude = ((magnitude * clock) << ENCODER_VELOCITY_Q) / ticks;
+  if(magnitude > 0x7FFFFFFF)
+  {
+    magnitude = 0x7FFFFFFF;
+  }
+
+  return (delta < 0) ? -(int32_t)magnitude : (int32_t)magnitude;
+}
+
+/**
+  * @brief  initialize the encoder state, both timers run already. the
+  *         count and sample interrupts must share one preemption priority.
+  * @param  enc: encoder handle with count_tmr, time_tmr, time_clock,
+  *         timeout and cpr set
+  * @retval none
+  */
+void encoder_init(encoder_type *enc)
+{
+  enc->raw = 0;
+  enc->last_count = (uint16_t)tmr_counter_value_get(enc->count_tmr);
+  enc->ref_position = 0;
+  enc->ref_time = tmr_counter_value_get(enc->time_tmr);
+  enc->velocity = 0;
+  enc->home_offset = 0;
+  enc->last_index = 0;
+  enc->index_count = 0;
+  enc->index_error = 0;
+  enc->home_request = 0;
+  enc->homed = 0;
+  enc->sequence = 0;
+
+  tmr_flag_clear(enc->count_tmr, TMR_OVF_FLAG | TMR_C3_FLAG);
+  tmr_interrupt_enable(enc->count_tmr, TMR_OVF_INT | TMR_C3_INT, TRUE);
+}
+
+/**
+  * @brief  count timer interrupt, keeps the position extended while the
+  *         sample is not running and latches the index position.
+  * @param  enc: encoder handle
+  * @retval none
+  */
+void encoder_count_handler(encoder_type *enc)
+{
+  int64_t index;
+
+  if(tmr_interrupt_flag_get(enc->count_tmr, TMR_OVF_FLAG) != RESET)
+  {
+    tmr_flag_clear(enc->count_tmr, TMR_OVF_FLAG);
+    encoder_extend(enc);
+  }
+
+  if(tmr_interrupt_flag_get(enc->count_tmr, TMR_C3_FLAG) != RESET)
+  {
+    tmr_flag_clear(enc->count_tmr, TMR_C3_FLAG);
+    encoder_extend(enc);
+
+    /* position at the index edge, the counter may have moved since */
+    index = enc->raw - (int16_t)(enc->last_count -
+            (uint16_t)tmr_channel_value_get(enc->count_tmr, TMR_SELECT_CHANNEL_3));
+
+    if(enc->cpr != 0 && enc->index_count != 0)
+    {
+      enc->index_error = (int32_t)((index > enc->last_index) ? (index - enc->last_index) :
+                                   (enc->last_index - index)) - (int32_t)enc->cpr;
+    }
+    enc->last_index = index;
+    enc->index_count++;
+
+    if(enc->home_request != 0)
+    {
+      enc->home_offset = index;
+      enc->home_request = 0;
+      enc->homed = 1;
+    }
+  }
+}
+
+/**
+  * @brief  servo rate sample, m/t velocity: counts moved between the last
+  *         two sampled edges over their timestamps, bounded by one count
+  *         over the time since the last edge when the encoder did not move.
+  * @param  enc: encoder handle
+  * @retval none
+  */
+void encoder_sample(encoder_type *enc)
+{
+  uint32_t edge_time, check, elapsed;
+  int64_t delta;
+  int32_t bound;
+
+  /* count and edge time of the same edge */
+  do
+  {
+    edge_time = tmr_channel_value_get(enc->time_tmr, TMR_SELECT_CHANNEL_1);
+    encoder_extend(enc);
+    check = tmr_channel_value_get(enc->time_tmr, TMR_SELECT_CHANNEL_1);
+  } while(edge_time != check);
+
+  delta = enc->raw - enc->ref_position;
+  if(delta != 0)
+  {
+    if(edge_time != enc->ref_time)
+    {
+      enc->velocity = encoder_rate(delta, edge_time - enc->ref_time, enc->time_clock);
+    }
+    enc->ref_position = enc->raw;
+    enc->ref_time = edge_time;
+  }
+  else
+  {
+    elapsed = tmr_counter_value_get(enc->time_tmr) - enc->ref_time;
+    if(elapsed >= enc->timeout)
+    {
+      enc->velocity = 0;
+    }
+    else if(elapsed != 0)
+    {
+      bound = encoder_rate(1, elapsed, enc->time_clock);
+      if(enc->velocity > bound)
+      {
+        enc->velocity = bound;
+      }
+      else if(enc->velocity < -bound)
+      {
+        enc->velocity = -bound;
+      }
+    }
+  }
+
+  /* publish */
+  enc->sequence++;
+  __DMB();
+  enc->snapshot.position = enc->raw - enc->home_offset;
+  enc->snapshot.velocity = enc->velocity;
+  enc->snapshot.edge_time = enc->ref_time;
+  enc->snapshot.index_count = enc->index_count;
+  enc->snapshot.index_error = enc->index_error;
+  enc->snapshot.homed = enc->homed;
+  __DMB();
+  enc->sequence++;
+}
+
+/**
+  * @brief  take the next index pulse as position zero.
+  * @param  enc: encoder handle
+  * @retval none
+  */
+void encoder_home(encoder_type *enc)
+{
+  enc->home_request = 1;
+}
+
+/**
+  * @brief  copy the last published snapshot without locking, from any
+  *         context preempted by the sample interrupt.
+  * @param  enc: encoder handle
+  * @param  snap: snapshot copy
+  * @retval none
+  */
+void encoder_snapshot_read(encoder_type *enc, encoder_snapshot_type *snap)
+{
+  uint32_t sequence;
+
+  do
+  {
+    sequence = enc->sequence;
+    __DMB();
+    *snap = enc->snapshot;
+    __DMB();
+  } while((sequence & 1) != 0 || sequence != enc->sequence);
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
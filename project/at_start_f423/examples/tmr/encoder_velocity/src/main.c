@@ -0,0 +1,237 @@
+/**
+  **************************************************************************
+  * @file     main.c
+  * @brief    main program
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "at32f423_board.h"
+#include "at32f423_clock.h"
+#include "encoder.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_TMR_encoder_velocity TMR_encoder_velocity
+  * @{
+  */
+
+/* simulated encoder, 100 lines, 400 counts per revolution */
+#define ENCODER_CPR                      400
+
+gpio_init_type  gpio_init_struct = {0};
+tmr_input_config_type  tmr_input_config_struct;
+crm_clocks_freq_type crm_clocks_freq_struct = {0};
+
+encoder_type encoder;
+int32_t gen_position = 0;
+
+void encoder_generate(int32_t counts, uint32_t step_us);
+void encoder_report(void);
+
+/**
+  * @brief  main function.
+  * @param  none
+  * @retval none
+  */
+int main(void)
+{
+  uint32_t tmr_clock;
+
+  system_clock_config();
+
+  at32_board_init();
+
+  uart_print_init(115200);
+
+  /* get system clock */
+  crm_clocks_freq_get(&crm_clocks_freq_struct);
+  tmr_clock = crm_clocks_freq_struct.apb1_freq * 2;
+
+  /* enable tmr2/tmr3/tmr7/gpioa/gpiob clock */
+  crm_periph_clock_enable(CRM_TMR2_PERIPH_CLOCK, TRUE);
+  crm_periph_clock_enable(CRM_TMR3_PERIPH_CLOCK, TRUE);
+  crm_periph_clock_enable(CRM_TMR7_PERIPH_CLOCK, TRUE);
+  crm_periph_clock_enable(CRM_GPIOA_PERIPH_CLOCK, TRUE);
+  crm_periph_clock_enable(CRM_GPIOB_PERIPH_CLOCK, TRUE);
+
+  /* tmr2 ch1/ch2 (pa0/pa1), tmr3 ch1/ch2 (pa6/pa7) and tmr3 ch3 (pb0) inputs */
+  gpio_init_struct.gpio_pins = GPIO_PINS_0 | GPIO_PINS_1 | GPIO_PINS_6 | GPIO_PINS_7;
+  gpio_init_struct.gpio_mode = GPIO_MODE_MUX;
+  gpio_init_struct.gpio_out_type = GPIO_OUTPUT_PUSH_PULL;
+  gpio_init_struct.gpio_pull = GPIO_PULL_NONE;
+  gpio_init_struct.gpio_drive_strength = GPIO_DRIVE_STRENGTH_STRONGER;
+  gpio_init(GPIOA, &gpio_init_struct);
+
+  gpio_init_struct.gpio_pins = GPIO_PINS_0;
+  gpio_init(GPIOB, &gpio_init_struct);
+
+  gpio_pin_mux_config(GPIOA, GPIO_PINS_SOURCE0, GPIO_MUX_1);
+  gpio_pin_mux_config(GPIOA, GPIO_PINS_SOURCE1, GPIO_MUX_1);
+  gpio_pin_mux_config(GPIOA, GPIO_PINS_SOURCE6, GPIO_MUX_2);
+  gpio_pin_mux_config(GPIOA, GPIO_PINS_SOURCE7, GPIO_MUX_2);
+  gpio_pin_mux_config(GPIOB, GPIO_PINS_SOURCE0, GPIO_MUX_2);
+
+  /* simulated encoder a/b/index outputs */
+  gpio_init_struct.gpio_pins = GPIO_PINS_12 | GPIO_PINS_13 | GPIO_PINS_14;
+  gpio_init_struct.gpio_mode = GPIO_MODE_OUTPUT;
+  gpio_init(GPIOB, &gpio_init_struct);
+
+  /* tmr3 16-bit encoder mode, counts every a/b edge, ch3 captures the index */
+  tmr_base_init(TMR3, 0xFFFF, 0);
+  tmr_cnt_dir_set(TMR3, TMR_COUNT_UP);
+  tmr_encoder_mode_config(TMR3, TMR_ENCODER_MODE_C, TMR_INPUT_RISING_EDGE, TMR_INPUT_RISING_EDGE);
+
+  tmr_input_config_struct.input_channel_select = TMR_SELECT_CHANNEL_3;
+  tmr_input_config_struct.input_mapped_select = TMR_CC_CHANNEL_MAPPED_DIRECT;
+  tmr_input_config_struct.input_polarity_select = TMR_INPUT_RISING_EDGE;
+  tmr_input_config_struct.input_filter_value = 0;
+  tmr_input_channel_init(TMR3, &tmr_input_config_struct, TMR_CHANNEL_INPUT_DIV_1);
+
+  /* tmr2 32-bit free running, ch1 captures the time of every a/b edge
+     through the xor of channel 1/2/3 inputs */
+  tmr_32_bit_function_enable(TMR2, TRUE);
+  tmr_base_init(TMR2, 0xFFFFFFFF, 0);
+  tmr_cnt_dir_set(TMR2, TMR_COUNT_UP);
+
+  tmr_channel1_input_select(TMR2, TMR_CHANEL1_2_3_CONNECTED_C1IRAW_XOR);
+  tmr_trigger_input_select(TMR2, TMR_SUB_INPUT_SEL_C1INC);
+  tmr_input_config_struct.input_channel_select = TMR_SELECT_CHANNEL_1;
+  tmr_input_config_struct.input_mapped_select = TMR_CC_CHANNEL_MAPPED_STI;
+  tmr_input_config_struct.input_polarity_select = TMR_INPUT_RISING_EDGE;
+  tmr_input_channel_init(TMR2, &tmr_input_config_struct, TMR_CHANNEL_INPUT_DIV_1);
+
+  tmr_counter_enable(TMR2, TRUE);
+  tmr_counter_enable(TMR3, TRUE);
+
+  /* velocity is zero after 100ms without edge */
+  encoder.count_tmr = TMR3;
+  encoder.time_tmr = TMR2;
+  encoder.time_clock = tmr_clock;
+  encoder.timeout = tmr_clock / 10;
+  encoder.cpr = ENCODER_CPR;
+  encoder_init(&encoder);
+  encoder_home(&encoder);
+
+  /* tmr7 10khz servo sample, same preemption priority as the tmr3 interrupt */
+  tmr_base_init(TMR7, 99, (tmr_clock / 1000000) - 1);
+  tmr_cnt_dir_set(TMR7, TMR_COUNT_UP);
+  tmr_interrupt_enable(TMR7, TMR_OVF_INT, TRUE);
+
+  nvic_priority_group_config(NVIC_PRIORITY_GROUP_4);
+  nvic_irq_enable(TMR3_GLOBAL_IRQn, 1, 0);
+  nvic_irq_enable(TMR7_GLOBAL_IRQn, 1, 0);
+
+  tmr_counter_enable(TMR7, TRUE);
+
+  while(1)
+  {
+    /* 5 turns forward at 10000 counts/s, 2 turns back at 2500 counts/s */
+    encoder_generate(5 * ENCODER_CPR, 100);
+    encoder_report();
+    encoder_generate(-2 * ENCODER_CPR, 400);
+    encoder_report();
+    delay_ms(200);
+    encoder_report();
+    at32_led_toggle(LED2);
+  }
+}
+
+/**
+  * @brief  this function handles tmr3 interrupt, counter overflow and index.
+  * @param  none
+  * @retval none
+  */
+void TMR3_GLOBAL_IRQHandler(void)
+{
+  encoder_count_handler(&encoder);
+}
+
+/**
+  * @brief  this function handles tmr7 interrupt, 10khz servo loop.
+  * @param  none
+  * @retval none
+  */
+void TMR7_GLOBAL_IRQHandler(void)
+{
+  if(tmr_interrupt_flag_get(TMR7, TMR_OVF_FLAG) != RESET)
+  {
+    tmr_flag_clear(TMR7, TMR_OVF_FLAG);
+    encoder_sample(&encoder);
+  }
+}
+
+/**
+  * @brief  move the simulated encoder, pb12 = a, pb13 = b, pb14 = index.
+  * @param  counts: signed counts to move
+  * @param  step_us: time per count
+  * @retval none
+  */
+void encoder_generate(int32_t counts, uint32_t step_us)
+{
+  static const uint8_t phase_a[4] = {0, 1, 1, 0};
+  static const uint8_t phase_b[4] = {0, 0, 1, 1};
+  uint32_t phase;
+
+  while(counts != 0)
+  {
+    if(counts > 0)
+    {
+      gen_position++;
+      counts--;
+    }
+    else
+    {
+      gen_position--;
+      counts++;
+    }
+
+    phase = (uint32_t)gen_position & 3;
+    gpio_bits_write(GPIOB, GPIO_PINS_12, phase_a[phase] ? TRUE : FALSE);
+    gpio_bits_write(GPIOB, GPIO_PINS_13, phase_b[phase] ? TRUE : FALSE);
+    gpio_bits_write(GPIOB, GPIO_PINS_14, ((gen_position % ENCODER_CPR) == 0) ? TRUE : FALSE);
+    delay_us(step_us);
+  }
+}
+
+/**
+  * @brief  print the encoder snapshot.
+  * @param  none
+  * @retval none
+  */
+void encoder_report(void)
+{
+  encoder_snapshot_type snap;
+
+  encoder_snapshot_read(&encoder, &snap);
+  printf("pos=%d vel=%d counts/s index=%u err=%d homed=%d\r\n",
+         (int)snap.position, (int)(snap.velocity >> ENCODER_VELOCITY_Q),
+         snap.index_count, (int)snap.index_error, snap.homed);
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
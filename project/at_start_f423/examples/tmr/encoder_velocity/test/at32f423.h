@@ -0,0 +1,69 @@
+/**
+  **************************************************************************
+  * @file     at32f423.h
+  * @brief    host stub of the device header for the encoder test
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* encoder.c only uses the tmr counter, capture and flag access, this header
+   replaces the device header so that it builds on the host. the timers are
+   plain structures driven by the test. */
+
+#ifndef __AT32F423_H
+#define __AT32F423_H
+
+#include <stdint.h>
+
+typedef enum {RESET = 0, SET = !RESET} flag_status;
+typedef enum {FALSE = 0, TRUE = !FALSE} confirm_state;
+
+#define TMR_OVF_FLAG                     ((uint32_t)0x000001)
+#define TMR_C3_FLAG                      ((uint32_t)0x000008)
+#define TMR_OVF_INT                      ((uint32_t)0x000001)
+#define TMR_C3_INT                       ((uint32_t)0x000008)
+
+typedef enum
+{
+  TMR_SELECT_CHANNEL_1                   = 0x00,
+  TMR_SELECT_CHANNEL_3                   = 0x04
+} tmr_channel_select_type;
+
+/**
+  * @brief simulated timer
+  */
+typedef struct
+{
+  uint32_t cval;                                   /*!< counter */
+  uint32_t c1dt;                                   /*!< channel 1 capture */
+  uint32_t c3dt;                                   /*!< channel 3 capture */
+  uint32_t ists;                                   /*!< flags */
+  uint32_t iden;                                   /*!< interrupt enables */
+} tmr_type;
+
+#define __DMB()                          __sync_synchronize()
+
+uint32_t tmr_counter_value_get(tmr_type *tmr_x);
+uint32_t tmr_channel_value_get(tmr_type *tmr_x, tmr_channel_select_type tmr_channel);
+void tmr_interrupt_enable(tmr_type *tmr_x, uint32_t tmr_interrupt, confirm_state new_state);
+flag_status tmr_interrupt_flag_get(tmr_type *tmr_x, uint32_t tmr_flag);
+void tmr_flag_clear(tmr_type *tmr_x, uint32_t tmr_flag);
+
+#endif
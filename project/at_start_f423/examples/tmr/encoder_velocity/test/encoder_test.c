@@ -0,0 +1,323 @@
+/**
+  **************************************************************************
+  * @file     encoder_test.c
+  * @brief    host test of the encoder position and velocity
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* encoder.c runs on two simulated timers: count_tmr counts the a/b edges in
+   16 bits and raises the overflow interrupt, time_tmr captures the time of
+   every edge. the cases cover the counter wrap, a direction reversal and the
+   switch between the m/t velocity and the one count bound when the encoder
+   stops and starts again. */
+
+#include "encoder.h"
+#include <stdio.h>
+
+#define SIM_CLOCK                        1000000
+#define SIM_TIMEOUT                      100000
+#define SIM_SAMPLE_TICKS                 100
+
+#define SIM_RATE(counts, ticks)          ((int32_t)((((uint64_t)(counts) * SIM_CLOCK) << ENCODER_VELOCITY_Q) / (ticks)))
+
+#define SIM_CHECK(cond)                  do { if(!(cond)) { printf("  %s:%d: %s\n", __func__, __LINE__, #cond); \
+                                           sim_failed ++; } } while(0)
+
+static tmr_type count_tmr;
+static tmr_type time_tmr;
+static encoder_type *sim_enc;
+static uint32_t sim_next_edge;
+static int sim_failed;
+
+uint32_t tmr_counter_value_get(tmr_type *tmr_x)
+{
+  return tmr_x->cval;
+}
+
+uint32_t tmr_channel_value_get(tmr_type *tmr_x, tmr_channel_select_type tmr_channel)
+{
+  return (tmr_channel == TMR_SELECT_CHANNEL_3) ? tmr_x->c3dt : tmr_x->c1dt;
+}
+
+void tmr_interrupt_enable(tmr_type *tmr_x, uint32_t tmr_interrupt, confirm_state new_state)
+{
+  if(new_state != FALSE)
+  {
+    tmr_x->iden |= tmr_interrupt;
+  }
+  else
+  {
+    tmr_x->iden &= ~tmr_interrupt;
+  }
+}
+
+flag_status tmr_interrupt_flag_get(tmr_type *tmr_x, uint32_t tmr_flag)
+{
+  return ((tmr_x->ists & tmr_x->iden & tmr_flag) != 0) ? SET : RESET;
+}
+
+void tmr_flag_clear(tmr_type *tmr_x, uint32_t tmr_flag)
+{
+  tmr_x->ists &= ~tmr_flag;
+}
+
+/**
+  * @brief  start a case, count_tmr at count and time_tmr at 0
+  */
+static void sim_init(encoder_type *enc, uint16_t count)
+{
+  count_tmr = (tmr_type){0};
+  time_tmr = (tmr_type){0};
+  count_tmr.cval = count;
+
+  *enc = (encoder_type){0};
+  enc->count_tmr = &count_tmr;
+  enc->time_tmr = &time_tmr;
+  enc->time_clock = SIM_CLOCK;
+  enc->timeout = SIM_TIMEOUT;
+  encoder_init(enc);
+  sim_enc = enc;
+}
+
+/**
+  * @brief  one a/b edge now, the counter overflow runs the count interrupt
+  */
+static void sim_edge(int32_t dir)
+{
+  uint16_t count = (uint16_t)count_tmr.cval;
+
+  count_tmr.cval = (uint16_t)(count + dir);
+  time_tmr.c1dt = time_tmr.cval;
+
+  if((dir > 0 && count == 0xFFFF) || (dir < 0 && count == 0))
+  {
+    count_tmr.ists |= TMR_OVF_FLAG;
+    if(count_tmr.iden & TMR_OVF_INT)
+    {
+      encoder_count_handler(sim_enc);
+    }
+  }
+}
+
+/**
+  * @brief  steps edges period ticks apart, no servo sample in between
+  */
+static void sim_move(int32_t steps, uint32_t period)
+{
+  int32_t dir = (steps < 0) ? -1 : 1;
+
+  while(steps != 0)
+  {
+    time_tmr.cval += period;
+    sim_edge(dir);
+    steps -= dir;
+  }
+}
+
+/**
+  * @brief  run the servo sample every SIM_SAMPLE_TICKS for duration ticks
+  *         with an edge every period ticks, dir 0 for a stopped encoder.
+  *         the velocity range of the samples is returned.
+  */
+static void sim_servo(int32_t dir, uint32_t period, uint32_t duration, int32_t *vmin, int32_t *vmax)
+{
+  encoder_snapshot_type snap;
+  uint32_t end = time_tmr.cval + duration;
+
+  *vmin = 0x7FFFFFFF;
+  *vmax = -0x7FFFFFFF;
+  while(time_tmr.cval != end)
+  {
+    uint32_t sample = time_tmr.cval + SIM_SAMPLE_TICKS;
+
+    while(dir != 0 && (int32_t)(sim_next_edge - sample) <= 0)
+    {
+      time_tmr.cval = sim_next_edge;
+      sim_edge(dir);
+      sim_next_edge += period;
+    }
+    time_tmr.cval = sample;
+
+    encoder_sample(sim_enc);
+    encoder_snapshot_read(sim_enc, &snap);
+    *vmin = (snap.velocity < *vmin) ? snap.velocity : *vmin;
+    *vmax = (snap.velocity > *vmax) ? snap.velocity : *vmax;
+  }
+}
+
+/**
+  * @brief  the 16-bit counter wraps up and down, with and without a sample
+  *         before the wrap, and further than 32768 counts between samples
+  */
+static void test_counter_wrap(void)
+{
+  encoder_type enc;
+  encoder_snapshot_type snap;
+  uint32_t i_index;
+
+  sim_init(&enc, 0xFFF0);
+
+  sim_move(100, 10);
+  encoder_sample(&enc);
+  encoder_snapshot_read(&enc, &snap);
+  SIM_CHECK(snap.position == 100);
+  SIM_CHECK(snap.velocity == SIM_RATE(100, 1000));
+
+  /* several full turns of the counter, less than half of it per sample */
+  for(i_index = 0; i_index < 10; i_index ++)
+  {
+    sim_move(30000, 10);
+    encoder_sample(&enc);
+  }
+  encoder_snapshot_read(&enc, &snap);
+  SIM_CHECK(snap.position == 300100);
+
+  for(i_index = 0; i_index < 20; i_index ++)
+  {
+    sim_move(-30000, 10);
+    encoder_sample(&enc);
+  }
+  encoder_snapshot_read(&enc, &snap);
+  SIM_CHECK(snap.position == -299900);
+  SIM_CHECK(snap.velocity == -SIM_RATE(1, 10));
+
+  /* more than half the counter between samples, the overflow interrupt
+     extends the position at the wrap */
+  sim_init(&enc, 0x9000);
+  sim_move(50000, 10);
+  encoder_sample(&enc);
+  encoder_snapshot_read(&enc, &snap);
+  SIM_CHECK(snap.position == 50000);
+
+  sim_move(-50000, 10);
+  encoder_sample(&enc);
+  encoder_snapshot_read(&enc, &snap);
+  SIM_CHECK(snap.position == 0);
+}
+
+/**
+  * @brief  the velocity changes sign with the first edge after a reversal,
+  *         also when the reversal crosses counter 0
+  */
+static void test_direction_reversal(void)
+{
+  encoder_type enc;
+  encoder_snapshot_type snap;
+
+  sim_init(&enc, 5);
+
+  sim_move(500, 1000);
+  encoder_sample(&enc);
+  encoder_snapshot_read(&enc, &snap);
+  SIM_CHECK(snap.position == 500);
+  SIM_CHECK(snap.velocity == SIM_RATE(1, 1000));
+
+  sim_move(-1, 1000);
+  encoder_sample(&enc);
+  encoder_snapshot_read(&enc, &snap);
+  SIM_CHECK(snap.position == 499);
+  SIM_CHECK(snap.velocity == -SIM_RATE(1, 1000));
+
+  sim_move(-509, 1000);
+  encoder_sample(&enc);
+  encoder_snapshot_read(&enc, &snap);
+  SIM_CHECK(snap.position == -10);
+  SIM_CHECK(snap.velocity == -SIM_RATE(1, 1000));
+
+  sim_move(4, 500);
+  encoder_sample(&enc);
+  encoder_snapshot_read(&enc, &snap);
+  SIM_CHECK(snap.position == -6);
+  SIM_CHECK(snap.velocity == SIM_RATE(1, 500));
+}
+
+/**
+  * @brief  m/t velocity while edges arrive, the one count bound decays it
+  *         after the encoder stops, the timeout zeroes it, and the first
+  *         edges after a restart switch back to the m/t velocity
+  */
+static void test_mt_switchover(void)
+{
+  encoder_type enc;
+  encoder_snapshot_type snap;
+  int32_t vmin, vmax;
+  uint32_t elapsed;
+
+  sim_init(&enc, 0);
+  sim_next_edge = 1000;
+
+  /* fewer edges than samples, the velocity holds between the edges */
+  sim_servo(1, 1000, 10000, &vmin, &vmax);
+  sim_servo(1, 1000, 40000, &vmin, &vmax);
+  SIM_CHECK(vmin == SIM_RATE(1, 1000) && vmax == SIM_RATE(1, 1000));
+
+  /* several edges per sample */
+  sim_next_edge = time_tmr.cval + 10;
+  sim_servo(1, 10, 1000, &vmin, &vmax);
+  sim_servo(1, 10, 10000, &vmin, &vmax);
+  SIM_CHECK(vmin == SIM_RATE(1, 10) && vmax == SIM_RATE(1, 10));
+
+  /* stopped, bounded by one count over the time since the last edge */
+  sim_servo(1, 1000, 10000, &vmin, &vmax);
+  while(1)
+  {
+    time_tmr.cval += SIM_SAMPLE_TICKS;
+    encoder_sample(&enc);
+    encoder_snapshot_read(&enc, &snap);
+    elapsed = time_tmr.cval - snap.edge_time;
+    if(elapsed >= SIM_TIMEOUT)
+    {
+      SIM_CHECK(snap.velocity == 0);
+      break;
+    }
+    if(elapsed <= 1000)
+    {
+      SIM_CHECK(snap.velocity == SIM_RATE(1, 1000));
+    }
+    else if(snap.velocity != SIM_RATE(1, elapsed))
+    {
+      SIM_CHECK(snap.velocity == SIM_RATE(1, elapsed));
+      break;
+    }
+  }
+  sim_servo(0, 0, 50000, &vmin, &vmax);
+  SIM_CHECK(vmin == 0 && vmax == 0);
+
+  /* restart backward, the first edge pairs with the edge before the stop */
+  elapsed = time_tmr.cval + 1000 - snap.edge_time;
+  sim_next_edge = time_tmr.cval + 1000;
+  sim_servo(-1, 1000, 1000, &vmin, &vmax);
+  SIM_CHECK(vmin == -SIM_RATE(1, elapsed));
+  sim_servo(-1, 1000, 1000, &vmin, &vmax);
+  SIM_CHECK(vmin == -SIM_RATE(1, 1000));
+  sim_servo(-1, 1000, 10000, &vmin, &vmax);
+  SIM_CHECK(vmin == -SIM_RATE(1, 1000) && vmax == -SIM_RATE(1, 1000));
+}
+
+int main(void)
+{
+  test_counter_wrap();
+  test_direction_reversal();
+  test_mt_switchover();
+
+  printf("%d checks failed\n", sim_failed);
+  return sim_failed;
+}
@@ -87,6 +87,9 @@ int main(void)
 
   while(1)
   {
+    /* process the out reports received from host */
+    custom_hid_class_process(&otg_core_struct.dev);
+
     if(at32_button_press() == USER_BUTTON)
     {
       report_buf[0] = HID_REPORT_ID_5;
@@ -42,8 +42,7 @@ extern "C" {
   * @{
   */
 #define INTERNAL_FLASH_LUN               0
-#define SPI_FLASH_LUN                    1
-#define SD_LUN                           2
+#define RAM_DISK_LUN                     1
 
 #define USB_FLASH_ADDR_OFFSET            0x08008000
 
@@ -51,10 +50,13 @@ extern "C" {
 #define SECTOR_SIZE_2K                   2048
 #define SECTOR_SIZE_4K                   4096
 
-uint8_t *get_inquiry(uint8_t lun);
-usb_sts_type msc_disk_read(uint8_t lun, uint64_t addr, uint8_t *read_buf, uint32_t len);
-usb_sts_type msc_disk_write(uint8_t lun, uint64_t addr, uint8_t *buf, uint32_t len);
-usb_sts_type msc_disk_capacity(uint8_t lun, uint32_t *blk_nbr, uint32_t *blk_size);
+#define SECTOR_CACHE_SIZE                SECTOR_SIZE_4K
+#define SECTOR_CACHE_INVALID             0xFFFFFFFF
+
+#define RAM_DISK_BLOCK_SIZE              512
+#define RAM_DISK_SIZE                    (16 * 1024)
+
+void msc_disk_idle_flush(void);
 
 /**
   * @}
@@ -132,6 +132,11 @@ extern "C" {
 #define USBH_P_TX_FIFO_SIZE              96
 #endif
 
+/**
+  * @brief usb msc logical units, lun 0 internal flash, lun 1 ram disk
+  */
+#define MSC_SUPPORT_MAX_LUN              2
+
 /**
   * @brief usb sof output enable
   */
@@ -30,6 +30,7 @@
 #include "usbd_int.h"
 #include "msc_class.h"
 #include "msc_desc.h"
+#include "msc_diskio.h"
 
 
 
@@ -85,7 +86,9 @@ int main(void)
 
   while(1)
   {
-
+    /* write back the flash sector cache once the host is idle */
+    delay_ms(100);
+    msc_disk_idle_flush();
   }
 }
 
@@ -34,113 +34,186 @@
   */
 uint32_t sector_size = 2048;
 uint32_t msc_flash_size;
-uint8_t scsi_inquiry[MSC_SUPPORT_MAX_LUN][SCSI_INQUIRY_DATA_LENGTH] =
+
+/* write back cache of one erase sector of the flash lun */
+#if defined ( __ICCARM__ ) /* iar compiler */
+  #pragma data_alignment=4
+#endif
+ALIGNED_HEAD uint8_t sector_cache[SECTOR_CACHE_SIZE] ALIGNED_TAIL;
+uint32_t sector_cache_addr = SECTOR_CACHE_INVALID;
+uint8_t sector_cache_dirty = 0;
+__IO uint32_t sector_cache_write_count = 0;
+uint32_t sector_cache_flush_count = 0;
+
+/* ram disk lun storage */
+#if defined ( __ICCARM__ ) /* iar compiler */
+  #pragma data_alignment=4
+#endif
+ALIGNED_HEAD uint8_t ram_disk[RAM_DISK_SIZE] ALIGNED_TAIL;
+
+static const uint8_t flash_lun_inquiry[SCSI_INQUIRY_DATA_LENGTH] =
 {
-  /* lun = 0 */
-  {
-    0x00,         /* peripheral device type (direct-access device) */
-    0x80,         /* removable media bit */
-    0x00,         /* ansi version, ecma version, iso version */
-    0x01,         /* respond data format */
-    SCSI_INQUIRY_DATA_LENGTH - 5, /* additional length */
-    0x00, 0x00, 0x00, /* reserved */
-    'A', 'T', '3', '2', ' ', ' ', ' ', ' ', /* vendor information "AT32" */
-    'D', 'i', 's', 'k', '0', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', /* Product identification "Disk" */
-    '2', '.', '0', '0'  /* product revision level */
-  }
+  0x00,         /* peripheral device type (direct-access device) */
+  0x80,         /* removable media bit */
+  0x00,         /* ansi version, ecma version, iso version */
+  0x01,         /* respond data format */
+  SCSI_INQUIRY_DATA_LENGTH - 5, /* additional length */
+  0x00, 0x00, 0x00, /* reserved */
+  'A', 'T', '3', '2', ' ', ' ', ' ', ' ', /* vendor information "AT32" */
+  'D', 'i', 's', 'k', '0', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', /* Product identification "Disk" */
+  '2', '.', '0', '0'  /* product revision level */
+};
+
+static const uint8_t ram_disk_inquiry[SCSI_INQUIRY_DATA_LENGTH] =
+{
+  0x00,         /* peripheral device type (direct-access device) */
+  0x80,         /* removable media bit */
+  0x00,         /* ansi version, ecma version, iso version */
+  0x01,         /* respond data format */
+  SCSI_INQUIRY_DATA_LENGTH - 5, /* additional length */
+  0x00, 0x00, 0x00, /* reserved */
+  'A', 'T', '3', '2', ' ', ' ', ' ', ' ', /* vendor information "AT32" */
+  'R', 'a', 'm', 'D', 'i', 's', 'k', '1', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', /* Product identification "RamDisk" */
+  '2', '.', '0', '0'  /* product revision level */
+};
+
+static usb_sts_type sector_cache_flush(void);
+static usb_sts_type sector_cache_load(uint32_t flash_addr);
+static usb_sts_type flash_lun_init(void);
+static usb_sts_type flash_lun_ready(void);
+static usb_sts_type flash_lun_capacity(uint32_t *blk_nbr, uint32_t *blk_size);
+static usb_sts_type flash_lun_read(uint64_t addr, uint8_t *buf, uint32_t len);
+static usb_sts_type flash_lun_write(uint64_t addr, uint8_t *buf, uint32_t len);
+static uint8_t *flash_lun_xip_addr(uint64_t addr, uint32_t len);
+static usb_sts_type ram_disk_init(void);
+static usb_sts_type ram_disk_ready(void);
+static usb_sts_type ram_disk_capacity(uint32_t *blk_nbr, uint32_t *blk_size);
+static usb_sts_type ram_disk_read(uint64_t addr, uint8_t *buf, uint32_t len);
+static usb_sts_type ram_disk_write(uint64_t addr, uint8_t *buf, uint32_t len);
+static uint8_t *ram_disk_xip_addr(uint64_t addr, uint32_t len);
+
+static const msc_media_ops_type flash_lun_ops =
+{
+  flash_lun_init,
+  flash_lun_ready,
+  flash_lun_capacity,
+  flash_lun_read,
+  flash_lun_write,
+  flash_lun_xip_addr,
+  flash_lun_inquiry
+};
+
+static const msc_media_ops_type ram_disk_ops =
+{
+  ram_disk_init,
+  ram_disk_ready,
+  ram_disk_capacity,
+  ram_disk_read,
+  ram_disk_write,
+  ram_disk_xip_addr,
+  ram_disk_inquiry
+};
+
+/* media of each lun, indexed by INTERNAL_FLASH_LUN and RAM_DISK_LUN */
+const msc_media_ops_type *const msc_media_ops[MSC_SUPPORT_MAX_LUN] =
+{
+  &flash_lun_ops,
+#if (MSC_SUPPORT_MAX_LUN > 1)
+  &ram_disk_ops,
+#endif
 };
 
 /**
-  * @brief  get disk inquiry
-  * @param  lun: logical units number
-  * @retval inquiry string
+  * @brief  write the cached sector back to flash if it was modified
+  * @param  none
+  * @retval status of usb_sts_type
   */
-uint8_t *get_inquiry(uint8_t lun)
+static usb_sts_type sector_cache_flush(void)
 {
-  if(lun < MSC_SUPPORT_MAX_LUN)
-    return (uint8_t *)scsi_inquiry[lun];
-  else
-    return NULL;
+  uint32_t i;
+  uint32_t *pdata = (uint32_t *)sector_cache;
+
+  if(sector_cache_dirty == 0)
+  {
+    return USB_OK;
+  }
+
+  flash_unlock();
+  if(flash_sector_erase(sector_cache_addr) != FLASH_OPERATE_DONE)
+  {
+    flash_lock();
+    return USB_FAIL;
+  }
+  for(i = 0; i < sector_size; i += 4)
+  {
+    if(flash_word_program(sector_cache_addr + i, *pdata ++) != FLASH_OPERATE_DONE)
+    {
+      flash_lock();
+      return USB_FAIL;
+    }
+  }
+  flash_lock();
+
+  sector_cache_dirty = 0;
+  sector_cache_flush_count ++;
+  return USB_OK;
 }
 
 /**
-  * @brief  disk read
-  * @param  lun: logical units number
-  * @param  addr: logical address
-  * @param  read_buf: pointer to read buffer
-  * @param  len: read length
+  * @brief  make the cache hold the sector containing flash_addr
+  * @param  flash_addr: flash address
   * @retval status of usb_sts_type
   */
-usb_sts_type msc_disk_read(uint8_t lun, uint64_t addr, uint8_t *read_buf, uint32_t len)
+static usb_sts_type sector_cache_load(uint32_t flash_addr)
 {
-  uint32_t i = 0;
-  uint32_t flash_addr = (uint32_t)addr + USB_FLASH_ADDR_OFFSET;
-  switch(lun)
+  uint32_t i;
+  uint32_t sector_addr = flash_addr - (flash_addr - FLASH_BASE) % sector_size;
+
+  if(sector_addr == sector_cache_addr)
   {
-    case INTERNAL_FLASH_LUN:
-      for(i = 0; i < len; i ++)
-      {
-        read_buf[i] = *((uint8_t *)flash_addr);
-        flash_addr += 1;
-      }
-      break;
-    case SPI_FLASH_LUN:
-      break;
-    case SD_LUN:
-      break;
-    default:
-      break;
+    return USB_OK;
   }
+
+  if(sector_cache_flush() != USB_OK)
+  {
+    return USB_FAIL;
+  }
+
+  for(i = 0; i < sector_size; i ++)
+  {
+    sector_cache[i] = *((uint8_t *)(sector_addr + i));
+  }
+  sector_cache_addr = sector_addr;
   return USB_OK;
 }
 
 /**
-  * @brief  disk write
-  * @param  lun: logical units number
-  * @param  addr: logical address
-  * @param  buf: pointer to write buffer
-  * @param  len: write length
-  * @retval status of usb_sts_type
+  * @brief  flush the sector cache when the host has stopped writing,
+  *         call it periodically from the main loop
+  * @param  none
+  * @retval none
   */
-usb_sts_type msc_disk_write(uint8_t lun, uint64_t addr, uint8_t *buf, uint32_t len)
+void msc_disk_idle_flush(void)
 {
-  uint32_t flash_addr = (uint32_t)addr + USB_FLASH_ADDR_OFFSET;
-  uint32_t i = 0, tolen = len;
-  uint32_t erase_addr = flash_addr;
-  switch(lun)
+  static uint32_t last_write_count = 0;
+
+  if(sector_cache_dirty && last_write_count == sector_cache_write_count)
   {
-    case INTERNAL_FLASH_LUN:
-      flash_unlock();
-      while(tolen >= sector_size)
-      {
-        flash_sector_erase(erase_addr);
-        tolen -= sector_size;
-        erase_addr += sector_size;
-      }
-      for(i = 0; i < len; i ++)
-      {
-        flash_byte_program(flash_addr+i, buf[i]);
-      }
-      flash_lock();
-      break;
-    case SPI_FLASH_LUN:
-      break;
-    case SD_LUN:
-      break;
-    default:
-      break;;
+    /* no write since the last call, the usb interrupt must not modify
+       the cache while it is written back */
+    nvic_irq_disable(OTG_IRQ);
+    sector_cache_flush();
+    nvic_irq_enable(OTG_IRQ, 0, 0);
   }
-  return USB_OK;
+  last_write_count = sector_cache_write_count;
 }
 
 /**
-  * @brief  disk capacity
-  * @param  lun: logical units number
-  * @param  blk_nbr: pointer to number of block
-  * @param  blk_size: pointer to block size
+  * @brief  detect the flash sector size and the size of the flash lun
+  * @param  none
   * @retval status of usb_sts_type
   */
-usb_sts_type msc_disk_capacity(uint8_t lun, uint32_t *blk_nbr, uint32_t *blk_size)
+static usb_sts_type flash_lun_init(void)
 {
   uint32_t devid = (*((uint32_t *)DEBUG_BASE) & 0x00007000) >> 12;
   msc_flash_size = (*((uint32_t *)0x1FFFF7E0) << 10) - (USB_FLASH_ADDR_OFFSET - FLASH_BASE);
@@ -159,22 +232,186 @@ usb_sts_type msc_disk_capacity(uint8_t lun, uint32_t *blk_nbr, uint32_t *blk_siz
       sector_size = SECTOR_SIZE_2K;
       break;
   }
-  switch(lun)
+  return USB_OK;
+}
+
+/**
+  * @brief  flash lun ready state, the internal flash is always present
+  * @param  none
+  * @retval status of usb_sts_type
+  */
+static usb_sts_type flash_lun_ready(void)
+{
+  return USB_OK;
+}
+
+/**
+  * @brief  flash lun capacity
+  * @param  blk_nbr: pointer to number of block
+  * @param  blk_size: pointer to block size
+  * @retval status of usb_sts_type
+  */
+static usb_sts_type flash_lun_capacity(uint32_t *blk_nbr, uint32_t *blk_size)
+{
+  *blk_nbr = msc_flash_size / sector_size;
+  *blk_size = sector_size;
+  return USB_OK;
+}
+
+/**
+  * @brief  flash lun read, the cached sector may be newer than the flash
+  * @param  addr: logical address
+  * @param  buf: pointer to read buffer
+  * @param  len: read length
+  * @retval status of usb_sts_type
+  */
+static usb_sts_type flash_lun_read(uint64_t addr, uint8_t *buf, uint32_t len)
+{
+  uint32_t i;
+  uint32_t flash_addr = (uint32_t)addr + USB_FLASH_ADDR_OFFSET;
+
+  for(i = 0; i < len; i ++)
   {
-    case INTERNAL_FLASH_LUN:
-      *blk_nbr = msc_flash_size / sector_size;
-      *blk_size = sector_size;
-      break;
-    case SPI_FLASH_LUN:
-      break;
-    case SD_LUN:
-      break;
-    default:
-      break;
+    if(sector_cache_dirty && flash_addr - sector_cache_addr < sector_size)
+    {
+      buf[i] = sector_cache[flash_addr - sector_cache_addr];
+    }
+    else
+    {
+      buf[i] = *((uint8_t *)flash_addr);
+    }
+    flash_addr += 1;
+  }
+  return USB_OK;
+}
+
+/**
+  * @brief  flash lun write, merge the data into the cached sector, a sector
+  *         is erased and programmed once when the host moves on to another sector
+  * @param  addr: logical address
+  * @param  buf: pointer to write buffer
+  * @param  len: write length
+  * @retval status of usb_sts_type
+  */
+static usb_sts_type flash_lun_write(uint64_t addr, uint8_t *buf, uint32_t len)
+{
+  uint32_t i;
+  uint32_t flash_addr = (uint32_t)addr + USB_FLASH_ADDR_OFFSET;
+
+  sector_cache_write_count ++;
+  for(i = 0; i < len; i ++)
+  {
+    if(sector_cache_load(flash_addr + i) != USB_OK)
+    {
+      return USB_FAIL;
+    }
+    sector_cache[flash_addr + i - sector_cache_addr] = buf[i];
+    sector_cache_dirty = 1;
+  }
+  return USB_OK;
+}
+
+/**
+  * @brief  get the memory mapped address of a flash lun range, used to send
+  *         read data to the host without a copy
+  * @param  addr: logical address
+  * @param  len: read length
+  * @retval address of the data or null if the cached sector is newer
+  */
+static uint8_t *flash_lun_xip_addr(uint64_t addr, uint32_t len)
+{
+  uint32_t flash_addr = (uint32_t)addr + USB_FLASH_ADDR_OFFSET;
+
+  if(sector_cache_dirty &&
+     flash_addr < sector_cache_addr + sector_size &&
+     flash_addr + len > sector_cache_addr)
+  {
+    return NULL;
+  }
+  return (uint8_t *)flash_addr;
+}
+
+/**
+  * @brief  ram disk init, the content is kept over a usb reconnection
+  * @param  none
+  * @retval status of usb_sts_type
+  */
+static usb_sts_type ram_disk_init(void)
+{
+  return USB_OK;
+}
+
+/**
+  * @brief  ram disk ready state
+  * @param  none
+  * @retval status of usb_sts_type
+  */
+static usb_sts_type ram_disk_ready(void)
+{
+  return USB_OK;
+}
+
+/**
+  * @brief  ram disk capacity
+  * @param  blk_nbr: pointer to number of block
+  * @param  blk_size: pointer to block size
+  * @retval status of usb_sts_type
+  */
+static usb_sts_type ram_disk_capacity(uint32_t *blk_nbr, uint32_t *blk_size)
+{
+  *blk_nbr = RAM_DISK_SIZE / RAM_DISK_BLOCK_SIZE;
+  *blk_size = RAM_DISK_BLOCK_SIZE;
+  return USB_OK;
+}
+
+/**
+  * @brief  ram disk read
+  * @param  addr: logical address
+  * @param  buf: pointer to read buffer
+  * @param  len: read length
+  * @retval status of usb_sts_type
+  */
+static usb_sts_type ram_disk_read(uint64_t addr, uint8_t *buf, uint32_t len)
+{
+  uint32_t i;
+
+  for(i = 0; i < len; i ++)
+  {
+    buf[i] = ram_disk[addr + i];
   }
   return USB_OK;
 }
 
+/**
+  * @brief  ram disk write
+  * @param  addr: logical address
+  * @param  buf: pointer to write buffer
+  * @param  len: write length
+  * @retval status of usb_sts_type
+  */
+static usb_sts_type ram_disk_write(uint64_t addr, uint8_t *buf, uint32_t len)
+{
+  uint32_t i;
+
+  for(i = 0; i < len; i ++)
+  {
+    ram_disk[addr + i] = buf[i];
+  }
+  return USB_OK;
+}
+
+/**
+  * @brief  get the address of a ram disk range, used to send read data to
+  *         the host without a copy
+  * @param  addr: logical address
+  * @param  len: read length
+  * @retval address of the data
+  */
+static uint8_t *ram_disk_xip_addr(uint64_t addr, uint32_t len)
+{
+  return &ram_disk[addr];
+}
+
 /**
   * @}
   */
@@ -42,14 +42,21 @@
 
 /* usb global struct define */
 otg_core_type otg_core_struct;
-#if defined ( __ICCARM__ ) /* iar compiler */
-  #pragma data_alignment=4
-#endif
-ALIGNED_HEAD uint8_t usb_buffer[256] ALIGNED_TAIL;
 void usb_clock48m_select(usb_clk48_s clk_s);
 void usb_gpio_config(void);
 void usb_low_power_wakeup_config(void);
 
+/* print data sink, stream the print data to spi2 through dma1 channel1 */
+static error_status spi_sink_start(uint8_t *data, uint32_t len);
+static uint8_t spi_sink_port_status(void);
+static void spi_sink_config(void);
+__IO uint8_t printer_paper_empty = 0;
+printer_sink_type spi_sink =
+{
+  spi_sink_start,
+  spi_sink_port_status
+};
+
 /**
   * @brief  main function.
   * @param  none
@@ -57,8 +64,6 @@ void usb_low_power_wakeup_config(void);
   */
 int main(void)
 {
-  uint32_t rx_len = 0;
-  
   nvic_priority_group_config(NVIC_PRIORITY_GROUP_4);
 
   system_clock_config();
@@ -81,6 +86,9 @@ int main(void)
   /* enable otgfs irq */
   nvic_irq_enable(OTG_IRQ, 0, 0);
 
+  /* config the print data sink */
+  spi_sink_config();
+
   /* init usb */
   usbd_init(&otg_core_struct,
             USB_FULL_SPEED_CORE_ID,
@@ -88,13 +96,126 @@ int main(void)
             &printer_class_handler,
             &printer_desc_handler);
 
+  /* stream the received data to the sink, without a sink the data
+     can be polled with usb_printer_get_rxdata */
+  usb_printer_set_sink(&otg_core_struct.dev, &spi_sink);
+
   while(1)
   {
-    /* get usb printer receive data */
-    rx_len = usb_printer_get_rxdata(&otg_core_struct.dev, usb_buffer);
-    UNUSED(rx_len);
+    /* user code ...
+       update printer_paper_empty from the paper sensor */
+  }
+}
 
-    /* user code ...*/
+/**
+  * @brief  spi sink config, spi2 master transmit only (pb13 sck, pb15 mosi)
+  *         fed by dma1 channel1
+  * @param  none
+  * @retval none
+  */
+static void spi_sink_config(void)
+{
+  gpio_init_type gpio_init_struct;
+  spi_init_type spi_init_struct;
+  dma_init_type dma_init_struct;
+
+  crm_periph_clock_enable(CRM_GPIOB_PERIPH_CLOCK, TRUE);
+  crm_periph_clock_enable(CRM_SPI2_PERIPH_CLOCK, TRUE);
+  crm_periph_clock_enable(CRM_DMA1_PERIPH_CLOCK, TRUE);
+
+  gpio_default_para_init(&gpio_init_struct);
+  gpio_init_struct.gpio_drive_strength = GPIO_DRIVE_STRENGTH_STRONGER;
+  gpio_init_struct.gpio_out_type = GPIO_OUTPUT_PUSH_PULL;
+  gpio_init_struct.gpio_mode = GPIO_MODE_MUX;
+  gpio_init_struct.gpio_pull = GPIO_PULL_NONE;
+  gpio_init_struct.gpio_pins = GPIO_PINS_13 | GPIO_PINS_15;
+  gpio_init(GPIOB, &gpio_init_struct);
+  gpio_pin_mux_config(GPIOB, GPIO_PINS_SOURCE13, GPIO_MUX_5);
+  gpio_pin_mux_config(GPIOB, GPIO_PINS_SOURCE15, GPIO_MUX_5);
+
+  spi_default_para_init(&spi_init_struct);
+  spi_init_struct.transmission_mode = SPI_TRANSMIT_HALF_DUPLEX_TX;
+  spi_init_struct.master_slave_mode = SPI_MODE_MASTER;
+  spi_init_struct.mclk_freq_division = SPI_MCLK_DIV_8;
+  spi_init_struct.first_bit_transmission = SPI_FIRST_BIT_MSB;
+  spi_init_struct.frame_bit_num = SPI_FRAME_8BIT;
+  spi_init_struct.clock_polarity = SPI_CLOCK_POLARITY_LOW;
+  spi_init_struct.clock_phase = SPI_CLOCK_PHASE_1EDGE;
+  spi_init_struct.cs_mode_selection = SPI_CS_SOFTWARE_MODE;
+  spi_init(SPI2, &spi_init_struct);
+  spi_i2s_dma_transmitter_enable(SPI2, TRUE);
+  spi_enable(SPI2, TRUE);
+
+  dmamux_enable(DMA1, TRUE);
+  dma_reset(DMA1_CHANNEL1);
+  dma_default_para_init(&dma_init_struct);
+  dma_init_struct.buffer_size = 0;
+  dma_init_struct.memory_data_width = DMA_MEMORY_DATA_WIDTH_BYTE;
+  dma_init_struct.memory_inc_enable = TRUE;
+  dma_init_struct.peripheral_data_width = DMA_PERIPHERAL_DATA_WIDTH_BYTE;
+  dma_init_struct.peripheral_inc_enable = FALSE;
+  dma_init_struct.priority = DMA_PRIORITY_HIGH;
+  dma_init_struct.loop_mode_enable = FALSE;
+  dma_init_struct.memory_base_addr = 0;
+  dma_init_struct.peripheral_base_addr = (uint32_t)&(SPI2->dt);
+  dma_init_struct.direction = DMA_DIR_MEMORY_TO_PERIPHERAL;
+  dma_init(DMA1_CHANNEL1, &dma_init_struct);
+  dmamux_init(DMA1MUX_CHANNEL1, DMAMUX_DMAREQ_ID_SPI2_TX);
+
+  dma_interrupt_enable(DMA1_CHANNEL1, DMA_FDT_INT, TRUE);
+  nvic_irq_enable(DMA1_Channel1_IRQn, 1, 0);
+}
+
+/**
+  * @brief  spi sink start, transmit a run of print data by dma
+  * @param  data: print data in the printer receive ring
+  * @param  len: data length
+  * @retval error status, ERROR while the print engine cannot take data
+  */
+static error_status spi_sink_start(uint8_t *data, uint32_t len)
+{
+  /* the print engine is out of paper or still shifting out the last run,
+     the class keeps the data in its ring and retries on sof */
+  if(printer_paper_empty || dma_data_number_get(DMA1_CHANNEL1) != 0)
+  {
+    return ERROR;
+  }
+
+  dma_channel_enable(DMA1_CHANNEL1, FALSE);
+  DMA1_CHANNEL1->maddr = (uint32_t)data;
+  dma_data_number_set(DMA1_CHANNEL1, (uint16_t)len);
+  dma_channel_enable(DMA1_CHANNEL1, TRUE);
+  return SUCCESS;
+}
+
+/**
+  * @brief  spi sink port status, reported to host by get_port_status
+  * @param  none
+  * @retval port status bits
+  */
+static uint8_t spi_sink_port_status(void)
+{
+  uint8_t port_status = PRINTER_PORT_STATUS_SELECT | PRINTER_PORT_STATUS_NOT_ERROR;
+
+  if(printer_paper_empty)
+  {
+    port_status = PRINTER_PORT_STATUS_PAPER_EMPTY;
+  }
+  return port_status;
+}
+
+/**
+  * @brief  this function handles dma1 channel1 interrupt, the spi sink
+  *         has consumed the data given to spi_sink_start.
+  * @param  none
+  * @retval none
+  */
+void DMA1_Channel1_IRQHandler(void)
+{
+  if(dma_interrupt_flag_get(DMA1_FDT1_FLAG) != RESET)
+  {
+    dma_flag_clear(DMA1_FDT1_FLAG);
+    usb_printer_sink_complete(&otg_core_struct.dev);
   }
 }
 
@@ -42,15 +42,9 @@ extern "C" {
   * @{
   */
 #define INTERNAL_FLASH_LUN               0
-#define SPI_FLASH_LUN                    1
-#define SD_LUN                           2
 
 #define USB_FLASH_ADDR_OFFSET  0x08004000
 
-uint8_t *get_inquiry(uint8_t lun);
-usb_sts_type msc_disk_read(uint8_t lun, uint64_t addr, uint8_t *read_buf, uint32_t len);
-usb_sts_type msc_disk_write(uint8_t lun, uint64_t addr, uint8_t *buf, uint32_t len);
-usb_sts_type msc_disk_capacity(uint8_t lun, uint32_t *blk_nbr, uint32_t *blk_size);
 
 /**
   * @}
@@ -34,100 +34,98 @@
   * @{
   */
 
-uint8_t scsi_inquiry[MSC_SUPPORT_MAX_LUN][SCSI_INQUIRY_DATA_LENGTH] =
+static const uint8_t flash_lun_inquiry[SCSI_INQUIRY_DATA_LENGTH] =
 {
-  /* lun = 0 */
-  {
-    0x00,         /* peripheral device type (direct-access device) */
-    0x80,         /* removable media bit */
-    0x00,         /* ansi version, ecma version, iso version */
-    0x01,         /* respond data format */
-    SCSI_INQUIRY_DATA_LENGTH - 5, /* additional length */
-    0x00, 0x00, 0x00, /* reserved */
-    'A', 'T', '3', '2', ' ', ' ', ' ', ' ', /* vendor information "AT32" */
-    'M', 's', 'c', ' ', 'i', 'a', 'p', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', /* Product identification "Disk" */
-    '2', '.', '0', '0'  /* product revision level */
-  },
+  0x00,         /* peripheral device type (direct-access device) */
+  0x80,         /* removable media bit */
+  0x00,         /* ansi version, ecma version, iso version */
+  0x01,         /* respond data format */
+  SCSI_INQUIRY_DATA_LENGTH - 5, /* additional length */
+  0x00, 0x00, 0x00, /* reserved */
+  'A', 'T', '3', '2', ' ', ' ', ' ', ' ', /* vendor information "AT32" */
+  'M', 's', 'c', ' ', 'i', 'a', 'p', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', /* Product identification "Disk" */
+  '2', '.', '0', '0'  /* product revision level */
+};
+
+static usb_sts_type flash_lun_init(void);
+static usb_sts_type flash_lun_ready(void);
+static usb_sts_type flash_lun_capacity(uint32_t *blk_nbr, uint32_t *blk_size);
+static usb_sts_type flash_lun_read(uint64_t addr, uint8_t *buf, uint32_t len);
+static usb_sts_type flash_lun_write(uint64_t addr, uint8_t *buf, uint32_t len);
+
+static const msc_media_ops_type flash_lun_ops =
+{
+  flash_lun_init,
+  flash_lun_ready,
+  flash_lun_capacity,
+  flash_lun_read,
+  flash_lun_write,
+  NULL,
+  flash_lun_inquiry
+};
+
+/* media of each lun, the virtual fat16 disk is the only lun */
+const msc_media_ops_type *const msc_media_ops[MSC_SUPPORT_MAX_LUN] =
+{
+  &flash_lun_ops,
 };
 
 /**
-  * @brief  get disk inquiry
-  * @param  lun: logical units number
-  * @retval inquiry string
+  * @brief  virtual disk init
+  * @param  none
+  * @retval status of usb_sts_type
   */
-uint8_t *get_inquiry(uint8_t lun)
+static usb_sts_type flash_lun_init(void)
 {
-  if(lun < MSC_SUPPORT_MAX_LUN)
-    return (uint8_t *)scsi_inquiry[lun];
-  else
-    return NULL;
+  return USB_OK;
 }
 
 /**
-  * @brief  disk read
-  * @param  lun: logical units number
-  * @param  addr: logical address
-  * @param  read_buf: pointer to read buffer
-  * @param  len: read length
+  * @brief  virtual disk ready state
+  * @param  none
   * @retval status of usb_sts_type
   */
-usb_sts_type msc_disk_read(uint8_t lun, uint64_t addr, uint8_t *read_buf, uint32_t len)
+static usb_sts_type flash_lun_ready(void)
 {
+  return USB_OK;
+}
 
-  switch(lun)
-  {
-    case 0:
-      flash_fat16_read((uint32_t)addr, read_buf, len);
-      break;
-    case 1:
-      break;
-  }
+/**
+  * @brief  virtual disk capacity
+  * @param  blk_nbr: pointer to number of block
+  * @param  blk_size: pointer to block size
+  * @retval status of usb_sts_type
+  */
+static usb_sts_type flash_lun_capacity(uint32_t *blk_nbr, uint32_t *blk_size)
+{
+  *blk_nbr = 0x0FFF;
+  *blk_size = FLASH_SECTOR_2K_SIZE;
   return USB_OK;
 }
 
 /**
-  * @brief  disk write
-  * @param  lun: logical units number
+  * @brief  virtual disk read
   * @param  addr: logical address
-  * @param  buf: pointer to write buffer
-  * @param  len: write length
+  * @param  buf: pointer to read buffer
+  * @param  len: read length
   * @retval status of usb_sts_type
   */
-usb_sts_type msc_disk_write(uint8_t lun, uint64_t addr, uint8_t *buf, uint32_t len)
+static usb_sts_type flash_lun_read(uint64_t addr, uint8_t *buf, uint32_t len)
 {
-  switch(lun)
-  {
-    case 0:
-      flash_fat16_write((uint32_t)addr, buf, len);
-      break;
-    case 1:
-      break;
-  }
+  flash_fat16_read((uint32_t)addr, buf, len);
   return USB_OK;
 }
 
 /**
-  * @brief  disk capacity
-  * @param  lun: logical units number
-  * @param  blk_nbr: pointer to number of block
-  * @param  blk_size: pointer to block size
+  * @brief  virtual disk write
+  * @param  addr: logical address
+  * @param  buf: pointer to write buffer
+  * @param  len: write length
   * @retval status of usb_sts_type
   */
-usb_sts_type msc_disk_capacity(uint8_t lun, uint32_t *blk_nbr, uint32_t *blk_size)
+static usb_sts_type flash_lun_write(uint64_t addr, uint8_t *buf, uint32_t len)
 {
-  switch(lun)
-  {
-    case INTERNAL_FLASH_LUN:
-      *blk_nbr = 0x0FFF;
-      *blk_size = FLASH_SECTOR_2K_SIZE;
-      break;
-    case SPI_FLASH_LUN:
-      break;
-    case SD_LUN:
-      break;
-    default:
-      break;
-  }
+  flash_fat16_write((uint32_t)addr, buf, len);
   return USB_OK;
 }
 
@@ -44,8 +44,7 @@ otg_core_type otg_core_struct;
 void usb_clock48m_select(usb_clk48_s clk_s);
 void usb_gpio_config(void);
 void usb_low_power_wakeup_config(void);
-uint32_t tx_data[16] = {0};
-uint32_t rx_data[16];
+uint8_t bridge_buf[USBH_CDC_BULK_MPS];
 /**
   * @brief  main function.
   * @param  none
@@ -86,42 +85,22 @@ int main(void)
   while(1)
   {
     usbh_loop_handler(&otg_core_struct.host);
-    /* if press user key, host send data to device */
+    /* if press user key, start stream mode on the attached device */
     if(at32_button_press() == USER_BUTTON)
     {
-      cdc_start_transmission(&otg_core_struct.host, (uint8_t *)tx_data, 60);
-      cdc_start_reception(&otg_core_struct.host, (uint8_t *)rx_data, 64);
+      if(cdc_start_stream(&otg_core_struct.host) == USB_OK)
+      {
+        USBH_DEBUG("cdc stream start");
+      }
     }
-  }
-}
-
-/**
-  * @brief  usb host cdc class transmit complete
-  * @param  uhost: to the structure of usbh_core_type
-  * @retval status: usb_sts_type status
-  */
-void cdc_transmit_complete(usbh_core_type *uhost)
-{
-  tx_data[0] ++;
-  cdc_start_transmission(&otg_core_struct.host, (uint8_t *)tx_data, 60);
-}
 
-/**
-  * @brief  usb host cdc class reception complete
-  * @param  uhost: to the structure of usbh_core_type
-  * @retval status: usb_sts_type status
-  */
-void cdc_receive_complete(usbh_core_type *uhost)
-{
-  usbh_core_type *puhost = (usbh_core_type *)uhost;
-  usbh_cdc_type *pcdc = (usbh_cdc_type *)puhost->class_handler->pdata;
-  
-  if(uhost->hch[pcdc->data_interface.in_channel].trans_count != 0)
-  {
-    USBH_DEBUG("%x", rx_data[0]);
+    /* loop received data back to the device */
+    if(cdc_stream_tx_free(&otg_core_struct.host) >= sizeof(bridge_buf))
+    {
+      uint32_t len = cdc_stream_read(&otg_core_struct.host, bridge_buf, sizeof(bridge_buf));
+      cdc_stream_write(&otg_core_struct.host, bridge_buf, len);
+    }
   }
-
-  cdc_start_reception(&otg_core_struct.host, (uint8_t *)rx_data, 64);
 }
 
 /**
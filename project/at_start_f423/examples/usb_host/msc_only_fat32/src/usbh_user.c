@@ -63,9 +63,13 @@ usbh_user_handler_type usbh_user_handle =
   usbh_user_not_support,
 };
 
+/* fat regions scanned per application pass */
+#define FREEMAP_SCAN_REGIONS             16
+
 typedef enum
 {
   USR_IDLE,
+  USR_SCAN,
   USR_APP,
   USR_FINISH
 }msc_usr_state;
@@ -203,61 +207,85 @@ static usb_sts_type usbh_user_application(void)
   uint32_t len;
   uint8_t write_data[] = "usb host msc demo";
   uint8_t read_data[32] = {0};
+  DWORD left, free_clst;
+  FATFS *pfs;
 
   switch(usr_state)
   {
     case USR_IDLE:
-      usr_state = USR_APP;
+      if(f_mount(&fs, "", 0) == FR_OK)
+      {
+        usr_state = USR_SCAN;
+      }
+      else
+      {
+        usr_state = USR_FINISH;
+      }
+      break;
+    case USR_SCAN:
+      /* build the free cluster map a few regions per pass, the host keeps
+         running between the passes and later allocations skip full regions */
+      res = f_freemap_scan("", FREEMAP_SCAN_REGIONS, &left);
+      if(res != FR_OK)
+      {
+        USBH_DEBUG("Free cluster scan failed");
+        f_mount(NULL, "", 0);
+        usr_state = USR_FINISH;
+      }
+      else if(left == 0)
+      {
+        if(f_getfree("", &free_clst, &pfs) == FR_OK)
+        {
+          USBH_DEBUG("Free clusters: %lu", (unsigned long)free_clst);
+        }
+        usr_state = USR_APP;
+      }
       break;
     case USR_APP:
-      res = f_mount(&fs, "", 0);
-      if(res == FR_OK)
+      /* start write data */
+      if(f_open(&file, "0:AT32.txt", FA_CREATE_ALWAYS | FA_WRITE) != FR_OK)
+      {
+        // error
+        USBH_DEBUG("Open AT32.txt failed");
+      }
+      else
       {
-        /* start write data */
-        if(f_open(&file, "0:AT32.txt", FA_CREATE_ALWAYS | FA_WRITE) != FR_OK)
+        res = f_write(&file, write_data, sizeof(write_data), &len);
+        if(res != FR_OK || len == 0)
         {
-          // error
-          USBH_DEBUG("Open AT32.txt failed");
+          //write error
+          USBH_DEBUG("Write AT32.txt failed");
         }
         else
         {
-          res = f_write(&file, write_data, sizeof(write_data), &len);
-          if(res != FR_OK || len == 0)
-          {
-            //write error
-            USBH_DEBUG("Write AT32.txt failed");
-          }
-          else
-          {
-            //write success
-            USBH_DEBUG("Write AT32.txt Success");
-          }
-          f_close(&file);
+          //write success
+          USBH_DEBUG("Write AT32.txt Success");
         }
+        f_close(&file);
+      }
 
-        /* start read file */
-        if(f_open(&file, "0:AT32.txt", FA_READ) != FR_OK)
+      /* start read file */
+      if(f_open(&file, "0:AT32.txt", FA_READ) != FR_OK)
+      {
+        // error
+        USBH_DEBUG("Open AT32.txt failed");
+      }
+      else
+      {
+        res = f_read(&file, read_data, sizeof(read_data), &len);
+        if(res != FR_OK || len == 0)
         {
-          // error
-          USBH_DEBUG("Open AT32.txt failed");
+          //read error
+          USBH_DEBUG("Read AT32.txt failed");
         }
         else
         {
-          res = f_read(&file, read_data, sizeof(read_data), &len);
-          if(res != FR_OK || len == 0)
-          {
-            //read error
-            USBH_DEBUG("Read AT32.txt failed");
-          }
-          else
-          {
-            //read success
-            USBH_DEBUG("Read AT32.txt Success");
-          }
-          f_close(&file);
+          //read success
+          USBH_DEBUG("Read AT32.txt Success");
         }
-        f_mount(NULL, "", 0);
+        f_close(&file);
       }
+      f_mount(NULL, "", 0);
       usr_state = USR_FINISH;
       break;
     case USR_FINISH:
@@ -0,0 +1,106 @@
+/**
+  **************************************************************************
+  * @file     log_stream.h
+  * @brief    contiguous streaming log header
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* define to prevent recursive inclusion -------------------------------------*/
+#ifndef __LOG_STREAM_H
+#define __LOG_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* includes ------------------------------------------------------------------*/
+#include "at32f423.h"
+#include "ff.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_USB_host_msc_stream_log
+  * @{
+  */
+
+/* sectors written per burst, each of the two buffers holds one burst */
+#ifndef LOG_STREAM_BURST_SECTORS
+#define LOG_STREAM_BURST_SECTORS         8
+#endif
+
+/* bursts between two size commits to the directory entry */
+#ifndef LOG_STREAM_COMMIT_BURSTS
+#define LOG_STREAM_COMMIT_BURSTS         64
+#endif
+
+/* fast seek link map entries, a contiguous file needs four */
+#ifndef LOG_STREAM_LINKMAP_SIZE
+#define LOG_STREAM_LINKMAP_SIZE          8
+#endif
+
+#define LOG_STREAM_SECTOR_SIZE           FF_MAX_SS
+#define LOG_STREAM_BURST_SIZE            (LOG_STREAM_BURST_SECTORS * LOG_STREAM_SECTOR_SIZE)
+
+/**
+  * @brief streaming log handle. one producer fills the active buffer with
+  *        log_stream_put (main loop or a single interrupt), the main loop
+  *        writes full buffers with log_stream_service.
+  */
+typedef struct
+{
+  FIL                                    file;            /*!< file object, preallocated by f_expand */
+  uint32_t                               buffer[2][LOG_STREAM_BURST_SIZE / 4]; /*!< word aligned burst buffers */
+  volatile uint8_t                       full[2];         /*!< set by the producer, cleared after the write */
+  volatile uint8_t                       active;          /*!< buffer being filled by the producer */
+  uint8_t                                next;            /*!< next buffer to be written */
+  volatile uint32_t                      fill;            /*!< bytes in the active buffer */
+  FSIZE_t                                capacity;        /*!< preallocated size */
+  FSIZE_t                                written;         /*!< bytes streamed to the disk */
+  FSIZE_t                                committed;       /*!< size recorded in the directory entry */
+  uint32_t                               bursts;          /*!< bursts since the last commit */
+  volatile uint32_t                      dropped;         /*!< bytes lost because both buffers were full */
+  uint32_t                               busy_cycles;     /*!< dwt cycles spent in the last burst */
+  uint32_t                               max_cycles;      /*!< longest burst in dwt cycles */
+  uint64_t                               total_cycles;    /*!< dwt cycles spent in all bursts */
+} log_stream_type;
+
+FRESULT log_stream_create(log_stream_type *ls, const TCHAR *path, FSIZE_t capacity);
+uint32_t log_stream_put(log_stream_type *ls, const void *data, uint32_t len);
+FRESULT log_stream_service(log_stream_type *ls);
+FRESULT log_stream_commit(log_stream_type *ls);
+FRESULT log_stream_close(log_stream_type *ls);
+FRESULT log_stream_open_read(FIL *file, const TCHAR *path, DWORD *linkmap, UINT entries);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
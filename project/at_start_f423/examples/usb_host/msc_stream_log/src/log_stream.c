@@ -0,0 +1,300 @@
+/**
+  **************************************************************************
+  * @file     log_stream.c
+  * @brief    contiguous streaming log
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "log_stream.h"
+#include <string.h>
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_USB_host_msc_stream_log
+  * @{
+  */
+
+/**
+  * @brief  create a log file and preallocate a contiguous cluster block.
+  *         the size recorded in the directory stays at zero until the first
+  *         commit, so a reset never exposes the unwritten part of the block.
+  * @param  ls: log stream handle
+  * @param  path: file name
+  * @param  capacity: bytes to preallocate, rounded down to whole bursts
+  * @retval FRESULT
+  */
+FRESULT log_stream_create(log_stream_type *ls, const TCHAR *path, FSIZE_t capacity)
+{
+  FRESULT res;
+
+  capacity -= capacity % LOG_STREAM_BURST_SIZE;
+  if(capacity == 0)
+  {
+    return FR_INVALID_PARAMETER;
+  }
+
+  ls->full[0] = 0;
+  ls->full[1] = 0;
+  ls->active = 0;
+  ls->next = 0;
+  ls->fill = 0;
+  ls->capacity = capacity;
+  ls->written = 0;
+  ls->committed = 0;
+  ls->bursts = 0;
+  ls->dropped = 0;
+  ls->busy_cycles = 0;
+  ls->max_cycles = 0;
+  ls->total_cycles = 0;
+
+  /* dwt cycle counter for the burst timing */
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  res = f_open(&ls->file, path, FA_CREATE_ALWAYS | FA_WRITE);
+  if(res != FR_OK)
+  {
+    return res;
+  }
+
+  /* one fat pass now instead of a cluster allocation every few sectors */
+  res = f_expand(&ls->file, capacity, 1);
+  if(res == FR_OK)
+  {
+    res = f_stream_commit(&ls->file, 0);
+  }
+  if(res != FR_OK)
+  {
+    /* a failed commit leaves the file modified, release the block so that
+       f_close records an empty file */
+    f_truncate(&ls->file);
+    f_close(&ls->file);
+  }
+  return res;
+}
+
+/**
+  * @brief  append data to the active buffer. only one context may produce,
+  *         either the main loop or a single interrupt.
+  * @param  ls: log stream handle
+  * @param  data: data to append
+  * @param  len: data length in bytes
+  * @retval bytes accepted, the rest is counted in dropped
+  */
+uint32_t log_stream_put(log_stream_type *ls, const void *data, uint32_t len)
+{
+  const uint8_t *src = (const uint8_t *)data;
+  uint8_t active = ls->active;
+  uint32_t fill = ls->fill;
+  uint32_t done = 0;
+  uint32_t n;
+
+  while(done < len)
+  {
+    /* the writer is still busy with this buffer */
+    if(ls->full[active])
+    {
+      ls->dropped += len - done;
+      break;
+    }
+    n = LOG_STREAM_BURST_SIZE - fill;
+    if(n > len - done)
+    {
+      n = len - done;
+    }
+    memcpy((uint8_t *)ls->buffer[active] + fill, src + done, n);
+    fill += n;
+    done += n;
+    if(fill == LOG_STREAM_BURST_SIZE)
+    {
+      ls->full[active] = 1;
+      active ^= 1;
+      fill = 0;
+    }
+  }
+  ls->fill = fill;
+  ls->active = active;
+  return done;
+}
+
+/**
+  * @brief  write the full buffers in one multi-sector transfer each and
+  *         commit the size every LOG_STREAM_COMMIT_BURSTS bursts.
+  * @param  ls: log stream handle
+  * @retval FRESULT, FR_DENIED once the preallocated block is used up
+  */
+FRESULT log_stream_service(log_stream_type *ls)
+{
+  FRESULT res = FR_OK;
+  uint32_t start;
+
+  while(ls->full[ls->next])
+  {
+    start = DWT->CYCCNT;
+    res = f_stream_write(&ls->file, ls->buffer[ls->next], LOG_STREAM_BURST_SECTORS);
+    if(res != FR_OK)
+    {
+      break;
+    }
+    ls->busy_cycles = DWT->CYCCNT - start;
+    if(ls->busy_cycles > ls->max_cycles)
+    {
+      ls->max_cycles = ls->busy_cycles;
+    }
+    ls->total_cycles += ls->busy_cycles;
+    ls->written += LOG_STREAM_BURST_SIZE;
+
+    /* hand the buffer back to the producer */
+    ls->full[ls->next] = 0;
+    ls->next ^= 1;
+
+    if(++ls->bursts >= LOG_STREAM_COMMIT_BURSTS)
+    {
+      res = log_stream_commit(ls);
+      if(res != FR_OK)
+      {
+        break;
+      }
+    }
+  }
+  return res;
+}
+
+/**
+  * @brief  record the streamed size in the directory entry. after a reset
+  *         the file holds the data up to the last commit, the rest of the
+  *         preallocation stays in the cluster chain until the file is
+  *         truncated or deleted.
+  * @param  ls: log stream handle
+  * @retval FRESULT
+  */
+FRESULT log_stream_commit(log_stream_type *ls)
+{
+  FRESULT res;
+
+  res = f_stream_commit(&ls->file, ls->written);
+  if(res == FR_OK)
+  {
+    ls->committed = ls->written;
+    ls->bursts = 0;
+  }
+  return res;
+}
+
+/**
+  * @brief  flush the partial buffer, commit the exact size and release the
+  *         unused part of the preallocation. the producer must be stopped.
+  * @param  ls: log stream handle
+  * @retval FRESULT
+  */
+FRESULT log_stream_close(log_stream_type *ls)
+{
+  FRESULT res, close_res;
+  uint32_t nsect;
+  uint8_t *tail;
+
+  res = log_stream_service(ls);
+
+  /* pad the last sectors, only the valid bytes are counted in the size */
+  if(res == FR_OK && ls->fill != 0)
+  {
+    nsect = (ls->fill + LOG_STREAM_SECTOR_SIZE - 1) / LOG_STREAM_SECTOR_SIZE;
+    tail = (uint8_t *)ls->buffer[ls->active];
+    memset(tail + ls->fill, 0, nsect * LOG_STREAM_SECTOR_SIZE - ls->fill);
+    res = f_stream_write(&ls->file, tail, nsect);
+    if(res == FR_OK)
+    {
+      ls->written += ls->fill;
+      ls->fill = 0;
+    }
+  }
+
+  if(res == FR_OK)
+  {
+    res = log_stream_commit(ls);
+  }
+  if(res == FR_OK)
+  {
+    res = f_lseek(&ls->file, ls->written);
+  }
+  if(res == FR_OK)
+  {
+    res = f_truncate(&ls->file);
+  }
+
+  /* on an error the directory keeps the last committed size, it is committed
+     again so that f_close does not record the preallocated size */
+  if(res != FR_OK)
+  {
+    f_stream_commit(&ls->file, ls->committed);
+  }
+  close_res = f_close(&ls->file);
+  if(res == FR_OK)
+  {
+    res = close_res;
+  }
+  return res;
+}
+
+/**
+  * @brief  open a log for reading with a fast seek link map, so random
+  *         access does not walk the fat. a file with more fragments than
+  *         the map can hold falls back to the normal seek.
+  * @param  file: file object
+  * @param  path: file name
+  * @param  linkmap: link map buffer, must stay valid while the file is open
+  * @param  entries: number of DWORD entries in linkmap
+  * @retval FRESULT
+  */
+FRESULT log_stream_open_read(FIL *file, const TCHAR *path, DWORD *linkmap, UINT entries)
+{
+  FRESULT res;
+
+  res = f_open(file, path, FA_READ);
+  if(res != FR_OK)
+  {
+    return res;
+  }
+
+  linkmap[0] = entries;
+  file->cltbl = linkmap;
+  res = f_lseek(file, CREATE_LINKMAP);
+  if(res == FR_NOT_ENOUGH_CORE)
+  {
+    file->cltbl = 0;
+    res = FR_OK;
+  }
+  if(res != FR_OK)
+  {
+    f_close(file);
+  }
+  return res;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
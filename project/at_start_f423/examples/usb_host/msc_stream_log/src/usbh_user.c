@@ -0,0 +1,424 @@
+/**
+  **************************************************************************
+  * @file     usbh_user.c
+  * @brief    usb user function
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+#include "usbh_user.h"
+#include "ff.h"
+#include "log_stream.h"
+
+/** @addtogroup AT32F423_periph_examples
+  * @{
+  */
+
+/** @addtogroup 423_USB_host_msc_stream_log
+  * @{
+  */
+
+static usb_sts_type usbh_user_init(void);
+static usb_sts_type usbh_user_reset(void);
+static usb_sts_type usbh_user_attached(void);
+static usb_sts_type usbh_user_disconnect(void);
+static usb_sts_type usbh_user_speed(uint8_t speed);
+static usb_sts_type usbh_user_mfc_string(void *string);
+static usb_sts_type usbh_user_product_string(void *string);
+static usb_sts_type usbh_user_serial_string(void *string);
+static usb_sts_type usbh_user_enumeration_done(void);
+static usb_sts_type usbh_user_application(void);
+static usb_sts_type usbh_user_active_vbus(void *uhost, confirm_state state);
+static usb_sts_type usbh_user_not_support(void);
+
+
+usbh_user_handler_type usbh_user_handle =
+{
+  usbh_user_init,
+  usbh_user_reset,
+  usbh_user_attached,
+  usbh_user_disconnect,
+  usbh_user_speed,
+  usbh_user_mfc_string,
+  usbh_user_product_string,
+  usbh_user_serial_string,
+  usbh_user_enumeration_done,
+  usbh_user_application,
+  usbh_user_active_vbus,
+  usbh_user_not_support,
+};
+
+typedef enum
+{
+  USR_IDLE,
+  USR_APP,
+  USR_FINISH
+}msc_usr_state;
+
+msc_usr_state usr_state = USR_IDLE;
+
+/**
+  * @brief  usb host init user handler
+  * @param  none
+  * @retval usb_sts_type
+  */
+static usb_sts_type usbh_user_init(void)
+{
+  usb_sts_type status = USB_OK;
+
+  return status;
+}
+
+/**
+  * @brief  usb host reset user handler
+  * @param  none
+  * @retval usb_sts_type
+  */
+static usb_sts_type usbh_user_reset(void)
+{
+  usb_sts_type status = USB_OK;
+
+  return status;
+}
+
+/**
+  * @brief  usb host check device attached
+  * @param  none
+  * @retval usb_sts_type
+  */
+static usb_sts_type usbh_user_attached(void)
+{
+  usb_sts_type status = USB_OK;
+  USBH_DEBUG("USB Device Attached");
+  return status;
+}
+
+/**
+  * @brief  usb host discconet user handler
+  * @param  none
+  * @retval usb_sts_type
+  */
+static usb_sts_type usbh_user_disconnect(void)
+{
+  usb_sts_type status = USB_OK;
+  usr_state = USR_IDLE;
+  USBH_DEBUG("Device Disconnect");
+  return status;
+}
+
+/**
+  * @brief  usb host speed user handler
+  * @param  none
+  * @retval usb_sts_type
+  */
+static usb_sts_type usbh_user_speed(uint8_t speed)
+{
+  usb_sts_type status = USB_OK;
+  if(speed == USB_PRTSPD_FULL_SPEED)
+  {
+    USBH_DEBUG("This is a Full-Speed device");
+  }
+  else if(speed == USB_PRTSPD_LOW_SPEED)
+  {
+    USBH_DEBUG("This is a Low-Speed device");
+  }
+  return status;
+}
+
+/**
+  * @brief  usb host manufacturer string user handler
+  * @param  none
+  * @retval usb_sts_type
+  */
+static usb_sts_type usbh_user_mfc_string(void *string)
+{
+  usb_sts_type status = USB_OK;
+  USBH_DEBUG("Manufacturer: %s", (uint8_t *)string);
+  return status;
+}
+
+/**
+  * @brief  usb host product string user handler
+  * @param  none
+  * @retval usb_sts_type
+  */
+static usb_sts_type usbh_user_product_string(void *string)
+{
+  usb_sts_type status = USB_OK;
+  USBH_DEBUG("Product: %s", (uint8_t *)string);
+  return status;
+}
+
+/**
+  * @brief  usb host serial string user handler
+  * @param  none
+  * @retval usb_sts_type
+  */
+static usb_sts_type usbh_user_serial_string(void *string)
+{
+  usb_sts_type status = USB_OK;
+  USBH_DEBUG("Serial: %s", (uint8_t *)string);
+  return status;
+}
+
+/**
+  * @brief  usb host enumeration done user handler
+  * @param  none
+  * @retval usb_sts_type
+  */
+static usb_sts_type usbh_user_enumeration_done(void)
+{
+  usb_sts_type status = USB_OK;
+  USBH_DEBUG("Enumeration done");
+  return status;
+}
+
+/* log file, preallocated size and number of 32 byte records streamed */
+#define LOG_FILE_NAME                    "0:LOG.BIN"
+#define LOG_CAPACITY                     (4 * 1024 * 1024)
+#define LOG_RECORDS                      (3 * 1024 * 1024 / 32 + 37)
+
+/* random reads done on the finished log */
+#define LOG_VERIFY_READS                 64
+
+/**
+  * @brief synthetic log record, the payload is derived from the sequence
+  *        number so any record can be checked on its own.
+  */
+typedef struct
+{
+  uint32_t sequence;
+  uint32_t cycles;
+  uint32_t payload[6];
+} log_record_type;
+
+FATFS fs;
+FIL file;
+log_stream_type log_stream;
+DWORD log_linkmap[LOG_STREAM_LINKMAP_SIZE];
+
+/**
+  * @brief  fill a log record
+  * @param  record: record to fill
+  * @param  sequence: record sequence number
+  * @retval none
+  */
+static void log_record_fill(log_record_type *record, uint32_t sequence)
+{
+  uint32_t i;
+
+  record->sequence = sequence;
+  record->cycles = DWT->CYCCNT;
+  for(i = 0; i < 6; i++)
+  {
+    record->payload[i] = sequence * 2654435761u + i;
+  }
+}
+
+/**
+  * @brief  check a log record read back from the file
+  * @param  record: record read back
+  * @param  sequence: expected sequence number
+  * @retval SUCCESS or ERROR
+  */
+static error_status log_record_check(const log_record_type *record, uint32_t sequence)
+{
+  uint32_t i;
+
+  if(record->sequence != sequence)
+  {
+    return ERROR;
+  }
+  for(i = 0; i < 6; i++)
+  {
+    if(record->payload[i] != sequence * 2654435761u + i)
+    {
+      return ERROR;
+    }
+  }
+  return SUCCESS;
+}
+
+/**
+  * @brief  stream the synthetic log and report the write throughput
+  * @param  none
+  * @retval FRESULT
+  */
+static FRESULT log_stream_demo(void)
+{
+  FRESULT res;
+  log_record_type record;
+  uint32_t sequence;
+  uint32_t kbps, max_us;
+
+  res = log_stream_create(&log_stream, LOG_FILE_NAME, LOG_CAPACITY);
+  if(res != FR_OK)
+  {
+    USBH_DEBUG("Create %s failed: %d", LOG_FILE_NAME, res);
+    return res;
+  }
+
+  for(sequence = 0; sequence < LOG_RECORDS && res == FR_OK; sequence++)
+  {
+    log_record_fill(&record, sequence);
+    log_stream_put(&log_stream, &record, sizeof(record));
+    res = log_stream_service(&log_stream);
+  }
+  if(res == FR_OK)
+  {
+    res = log_stream_close(&log_stream);
+  }
+  else
+  {
+    log_stream_close(&log_stream);
+  }
+  if(res != FR_OK)
+  {
+    USBH_DEBUG("Stream %s failed: %d, %u bytes committed", LOG_FILE_NAME, res, (uint32_t)log_stream.committed);
+    return res;
+  }
+
+  kbps = 0;
+  if(log_stream.total_cycles != 0)
+  {
+    kbps = (uint32_t)((uint64_t)log_stream.written * system_core_clock / 1024 / log_stream.total_cycles);
+  }
+  max_us = log_stream.max_cycles / (system_core_clock / 1000000);
+  USBH_DEBUG("Stream %u bytes, %u KB/s, longest burst %u us, %u bytes dropped",
+             (uint32_t)log_stream.written, kbps, max_us, log_stream.dropped);
+  return FR_OK;
+}
+
+/**
+  * @brief  read records at random offsets through the fast seek link map
+  * @param  none
+  * @retval FRESULT
+  */
+static FRESULT log_verify_demo(void)
+{
+  FRESULT res;
+  log_record_type record;
+  uint32_t i, sequence, len, errors = 0;
+
+  res = log_stream_open_read(&file, LOG_FILE_NAME, log_linkmap, LOG_STREAM_LINKMAP_SIZE);
+  if(res != FR_OK)
+  {
+    USBH_DEBUG("Open %s failed: %d", LOG_FILE_NAME, res);
+    return res;
+  }
+  if(f_size(&file) != (FSIZE_t)LOG_RECORDS * sizeof(record))
+  {
+    errors++;
+  }
+
+  sequence = 17;
+  for(i = 0; i < LOG_VERIFY_READS && res == FR_OK; i++)
+  {
+    /* stride through the log in a scattered order */
+    sequence = (sequence + 40503) % LOG_RECORDS;
+    res = f_lseek(&file, (FSIZE_t)sequence * sizeof(record));
+    if(res == FR_OK)
+    {
+      res = f_read(&file, &record, sizeof(record), &len);
+    }
+    if(res == FR_OK && (len != sizeof(record) || log_record_check(&record, sequence) != SUCCESS))
+    {
+      errors++;
+    }
+  }
+  f_close(&file);
+
+  if(res != FR_OK || errors != 0)
+  {
+    USBH_DEBUG("Verify %s failed: %d, %u errors", LOG_FILE_NAME, res, errors);
+  }
+  else
+  {
+    USBH_DEBUG("Verify %s Success, %u link map entries", LOG_FILE_NAME, log_linkmap[0]);
+  }
+  return res;
+}
+
+/**
+  * @brief  usb host application user handler
+  * @param  none
+  * @retval usb_sts_type
+  */
+static usb_sts_type usbh_user_application(void)
+{
+  usb_sts_type status = USB_OK;
+  FRESULT res;
+
+  switch(usr_state)
+  {
+    case USR_IDLE:
+      usr_state = USR_APP;
+      break;
+    case USR_APP:
+      res = f_mount(&fs, "", 0);
+      if(res == FR_OK)
+      {
+        if(log_stream_demo() == FR_OK)
+        {
+          log_verify_demo();
+        }
+        f_mount(NULL, "", 0);
+      }
+      usr_state = USR_FINISH;
+      break;
+    case USR_FINISH:
+      break;
+  }
+  return status;
+}
+
+/**
+  * @brief  usb host active vbus user handler
+  * @param  uhost: to the structure of usbh_core_type
+  * @param  state: vbus state
+            TRUE: active vbus
+            FALSE: deactive vbus
+  * @retval usb_sts_type
+  */
+static usb_sts_type usbh_user_active_vbus(void *uhost, confirm_state state)
+{
+  usb_sts_type status = USB_OK;
+
+  return status;
+}
+
+/**
+  * @brief  usb host not support user handler
+  * @param  none
+  * @retval usb_sts_type
+  */
+static usb_sts_type usbh_user_not_support(void)
+{
+  usb_sts_type status = USB_OK;
+
+  return status;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,408 @@
+/**
+  **************************************************************************
+  * @file     ff_stream_test.c
+  * @brief    host test of the fatfs streaming write and region map
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* ff.c runs on a ram disk formatted as fat16 with 1 kb clusters, the disk
+   functions below count the calls and record the sectors written. the
+   cases cover f_stream_write on a block from f_expand: one disk_write per
+   burst at the mapped sector, no fat access, the file buffer refilled and
+   the bounds; the contiguity check of an allocation made by f_write, a
+   fragmented chain rejected and accepted again after f_truncate; the size
+   recorded by f_stream_commit and the pending changes it keeps when the sync
+   fails; and the region map: f_freemap_scan counting
+   the free clusters in steps, allocations skipping full regions without
+   reading their fat sector and frees during a scan. */
+
+#include "ff.h"
+#include "diskio.h"
+#include <stdio.h>
+#include <string.h>
+
+#define DISK_SECTORS                     16384
+#define CLUSTER_SIZE                     1024
+
+/* file status flags private to ff.c */
+#define FA_MODIFIED                      0x40
+#define FA_DIRTY                         0x80
+
+#define TEST_CHECK(cond)                 do { if(!(cond)) { printf("  %s:%d: %s\n", __func__, __LINE__, #cond); \
+                                           test_failed ++; } } while(0)
+
+static BYTE disk[DISK_SECTORS][FF_MAX_SS];
+static int disk_read_count;
+static int disk_write_count;
+static LBA_t disk_write_sector;
+static UINT disk_write_sectors;
+static int disk_write_failures;
+static LBA_t disk_watch_sector;
+static int disk_watch_read;
+
+static FATFS fs;
+static FIL fil;
+static BYTE work[FF_MAX_SS];
+static BYTE data[16 * FF_MAX_SS];
+static BYTE back[16 * FF_MAX_SS];
+
+static int test_failed;
+
+DSTATUS disk_initialize(BYTE pdrv)
+{
+  (void)pdrv;
+  return 0;
+}
+
+DSTATUS disk_status(BYTE pdrv)
+{
+  (void)pdrv;
+  return 0;
+}
+
+DRESULT disk_read(BYTE pdrv, BYTE *buff, LBA_t sector, UINT count)
+{
+  (void)pdrv;
+  if(sector + count > DISK_SECTORS)
+  {
+    return RES_PARERR;
+  }
+  if(disk_watch_sector >= sector && disk_watch_sector < sector + count)
+  {
+    disk_watch_read ++;
+  }
+  memcpy(buff, disk[sector], count * FF_MAX_SS);
+  disk_read_count ++;
+  return RES_OK;
+}
+
+DRESULT disk_write(BYTE pdrv, const BYTE *buff, LBA_t sector, UINT count)
+{
+  (void)pdrv;
+  if(sector + count > DISK_SECTORS)
+  {
+    return RES_PARERR;
+  }
+  if(disk_write_failures > 0)
+  {
+    disk_write_failures --;
+    return RES_ERROR;
+  }
+  memcpy(disk[sector], buff, count * FF_MAX_SS);
+  disk_write_count ++;
+  disk_write_sector = sector;
+  disk_write_sectors = count;
+  return RES_OK;
+}
+
+DRESULT disk_ioctl(BYTE pdrv, BYTE cmd, void *buff)
+{
+  (void)pdrv;
+  switch(cmd)
+  {
+    case CTRL_SYNC:
+      return RES_OK;
+    case GET_SECTOR_COUNT:
+      *(LBA_t *)buff = DISK_SECTORS;
+      return RES_OK;
+    case GET_BLOCK_SIZE:
+      *(DWORD *)buff = 1;
+      return RES_OK;
+    default:
+      return RES_PARERR;
+  }
+}
+
+DWORD get_fattime(void)
+{
+  return ((DWORD)(2025 - 1980) << 25) | ((DWORD)1 << 21) | ((DWORD)1 << 16);
+}
+
+static void fill(BYTE *buf, UINT len, BYTE seed)
+{
+  UINT i;
+
+  for(i = 0; i < len; i ++)
+  {
+    buf[i] = (BYTE)(seed + i * 7 + (i >> 9));
+  }
+}
+
+static void format(void)
+{
+  const MKFS_PARM opt = {FM_FAT | FM_SFD, 1, 0, 0, CLUSTER_SIZE};
+
+  TEST_CHECK(f_mkfs("", &opt, work, sizeof(work)) == FR_OK);
+  TEST_CHECK(f_mount(&fs, "", 1) == FR_OK);
+  TEST_CHECK(fs.fs_type == FS_FAT16 && fs.csize * FF_MAX_SS == CLUSTER_SIZE);
+}
+
+/* first sector of the data area of a cluster */
+static LBA_t cluster_sector(DWORD clst)
+{
+  return fs.database + (LBA_t)fs.csize * (clst - 2);
+}
+
+/* writes a file with f_write, one call per cluster */
+static void write_clusters(const TCHAR *path, BYTE mode, UINT n, BYTE seed)
+{
+  UINT i, bw;
+
+  TEST_CHECK(f_open(&fil, path, FA_WRITE | mode) == FR_OK);
+  if(mode == FA_OPEN_APPEND)
+  {
+    TEST_CHECK(f_lseek(&fil, f_size(&fil)) == FR_OK);
+  }
+  for(i = 0; i < n; i ++)
+  {
+    fill(data, CLUSTER_SIZE, (BYTE)(seed + i));
+    TEST_CHECK(f_write(&fil, data, CLUSTER_SIZE, &bw) == FR_OK && bw == CLUSTER_SIZE);
+  }
+  TEST_CHECK(f_close(&fil) == FR_OK);
+}
+
+static void test_expand(void)
+{
+  DWORD sclust;
+  UINT br;
+
+  format();
+  TEST_CHECK(f_open(&fil, "log.bin", FA_CREATE_ALWAYS | FA_WRITE | FA_READ) == FR_OK);
+  TEST_CHECK(f_expand(&fil, 64 * CLUSTER_SIZE, 1) == FR_OK);
+  sclust = fil.obj.sclust;
+  TEST_CHECK(fil.ct_sclust == sclust && fil.ct_size == 64 * CLUSTER_SIZE);
+
+  /* one burst, one disk_write at the mapped sector, no fat access */
+  fill(data, 8 * FF_MAX_SS, 1);
+  disk_read_count = 0;
+  disk_write_count = 0;
+  TEST_CHECK(f_stream_write(&fil, data, 8) == FR_OK);
+  TEST_CHECK(disk_read_count == 0 && disk_write_count == 1);
+  TEST_CHECK(disk_write_sector == cluster_sector(sclust) && disk_write_sectors == 8);
+  TEST_CHECK(f_tell(&fil) == 8 * FF_MAX_SS && fil.clust == sclust + 3);
+  TEST_CHECK(memcmp(disk[cluster_sector(sclust)], data, 8 * FF_MAX_SS) == 0);
+
+  /* a second burst continues in the next cluster */
+  fill(data, 4 * FF_MAX_SS, 2);
+  TEST_CHECK(f_stream_write(&fil, data, 4) == FR_OK);
+  TEST_CHECK(disk_write_count == 2 && disk_write_sector == cluster_sector(sclust + 4));
+  TEST_CHECK(fil.clust == sclust + 5);
+
+  /* bounds: sector alignment and the end of the allocation */
+  disk_write_count = 0;
+  TEST_CHECK(f_lseek(&fil, 100) == FR_OK);
+  TEST_CHECK(f_stream_write(&fil, data, 1) == FR_DENIED);
+  TEST_CHECK(f_lseek(&fil, 64 * CLUSTER_SIZE - FF_MAX_SS) == FR_OK);
+  TEST_CHECK(f_stream_write(&fil, data, 2) == FR_DENIED);
+  TEST_CHECK(disk_write_count == 0);
+  TEST_CHECK(f_stream_write(&fil, data, 1) == FR_OK && disk_write_count == 1);
+  TEST_CHECK(disk_write_sector == cluster_sector(sclust + 63) + 1);
+  TEST_CHECK(f_stream_write(&fil, data, 0) == FR_OK);
+
+  /* commit a size behind the file pointer, the allocation stays */
+  TEST_CHECK(f_stream_commit(&fil, f_tell(&fil) + 1) == FR_DENIED);
+  TEST_CHECK(f_stream_commit(&fil, 12 * FF_MAX_SS) == FR_OK);
+  TEST_CHECK(f_size(&fil) == 64 * CLUSTER_SIZE);
+  TEST_CHECK(f_close(&fil) == FR_OK);
+
+  TEST_CHECK(f_open(&fil, "log.bin", FA_READ) == FR_OK);
+  TEST_CHECK(f_size(&fil) == 12 * FF_MAX_SS && fil.obj.sclust == sclust);
+  TEST_CHECK(f_read(&fil, back, sizeof(back), &br) == FR_OK && br == 12 * FF_MAX_SS);
+  fill(data, 8 * FF_MAX_SS, 1);
+  TEST_CHECK(memcmp(back, data, 8 * FF_MAX_SS) == 0);
+  fill(data, 4 * FF_MAX_SS, 2);
+  TEST_CHECK(memcmp(back + 8 * FF_MAX_SS, data, 4 * FF_MAX_SS) == 0);
+
+  /* a read only file */
+  TEST_CHECK(f_lseek(&fil, 0) == FR_OK);
+  TEST_CHECK(f_stream_write(&fil, data, 1) == FR_DENIED);
+  TEST_CHECK(f_close(&fil) == FR_OK);
+}
+
+static void test_cache(void)
+{
+  UINT br;
+
+  /* the sector held by the file buffer is overwritten by a burst */
+  TEST_CHECK(f_open(&fil, "log.bin", FA_READ | FA_WRITE) == FR_OK);
+  TEST_CHECK(f_lseek(&fil, FF_MAX_SS) == FR_OK);
+  TEST_CHECK(f_read(&fil, back, 16, &br) == FR_OK && br == 16);
+  TEST_CHECK(f_lseek(&fil, 0) == FR_OK);
+  fill(data, 2 * FF_MAX_SS, 3);
+  TEST_CHECK(f_stream_write(&fil, data, 2) == FR_OK);
+  TEST_CHECK(f_lseek(&fil, FF_MAX_SS) == FR_OK);
+  TEST_CHECK(f_read(&fil, back, 16, &br) == FR_OK && br == 16);
+  TEST_CHECK(fil.sect == disk_write_sector + 1);
+  TEST_CHECK(memcmp(back, data + FF_MAX_SS, 16) == 0);
+
+  /* the size from the directory was verified by a walk of the chain */
+  TEST_CHECK(fil.ct_sclust == fil.obj.sclust && fil.ct_size == 12 * FF_MAX_SS);
+  TEST_CHECK(f_close(&fil) == FR_OK);
+}
+
+static void test_commit_failure(void)
+{
+  UINT bw;
+
+  /* a partial sector written by f_write is pending in the file buffer */
+  TEST_CHECK(f_open(&fil, "log.bin", FA_READ | FA_WRITE) == FR_OK);
+  TEST_CHECK(f_expand(&fil, 16 * CLUSTER_SIZE, 1) == FR_DENIED);
+  TEST_CHECK(f_lseek(&fil, 4 * FF_MAX_SS) == FR_OK);
+  fill(data, 16, 5);
+  TEST_CHECK(f_write(&fil, data, 16, &bw) == FR_OK && bw == 16);
+  TEST_CHECK((fil.flag & FA_DIRTY) != 0 && (fil.flag & FA_MODIFIED) != 0);
+
+  /* the failed commit keeps the file modified with its allocated size */
+  disk_write_failures = 1;
+  TEST_CHECK(f_stream_commit(&fil, 4 * FF_MAX_SS) == FR_DISK_ERR);
+  TEST_CHECK((fil.flag & FA_MODIFIED) != 0);
+  TEST_CHECK(f_size(&fil) == 12 * FF_MAX_SS && f_tell(&fil) == 4 * FF_MAX_SS + 16);
+
+  TEST_CHECK(f_stream_commit(&fil, 4 * FF_MAX_SS + 16) == FR_OK);
+  TEST_CHECK((fil.flag & (FA_MODIFIED | FA_DIRTY)) == 0);
+  TEST_CHECK(f_size(&fil) == 12 * FF_MAX_SS);
+  TEST_CHECK(f_close(&fil) == FR_OK);
+
+  TEST_CHECK(f_open(&fil, "log.bin", FA_READ) == FR_OK);
+  TEST_CHECK(f_size(&fil) == 4 * FF_MAX_SS + 16);
+  TEST_CHECK(f_close(&fil) == FR_OK);
+}
+
+static void test_fragmented(void)
+{
+  DWORD sclust;
+  UINT br;
+
+  /* f_write allocations, contiguous on a new volume */
+  format();
+  write_clusters("a.bin", FA_CREATE_ALWAYS, 4, 10);
+  TEST_CHECK(f_open(&fil, "a.bin", FA_READ | FA_WRITE) == FR_OK);
+  TEST_CHECK(fil.ct_sclust == 0 && fil.ct_size == 0);
+  fill(data, 2 * FF_MAX_SS, 4);
+  TEST_CHECK(f_stream_write(&fil, data, 2) == FR_OK);
+  TEST_CHECK(fil.ct_sclust == fil.obj.sclust && fil.ct_size == 4 * CLUSTER_SIZE);
+  disk_read_count = 0;
+  TEST_CHECK(f_stream_write(&fil, data, 2) == FR_OK && disk_read_count == 0);
+  TEST_CHECK(f_close(&fil) == FR_OK);
+
+  /* b.bin after a.bin, a.bin grows past it */
+  write_clusters("b.bin", FA_CREATE_ALWAYS, 1, 20);
+  write_clusters("a.bin", FA_OPEN_APPEND, 1, 30);
+  TEST_CHECK(f_open(&fil, "a.bin", FA_READ | FA_WRITE) == FR_OK);
+  sclust = fil.obj.sclust;
+  disk_write_count = 0;
+  TEST_CHECK(f_stream_write(&fil, data, 2) == FR_DENIED);
+  TEST_CHECK(disk_write_count == 0 && fil.ct_size == 0 && fil.err == FR_OK);
+
+  /* the clusters up to the gap form a block again */
+  TEST_CHECK(f_lseek(&fil, 4 * CLUSTER_SIZE) == FR_OK);
+  TEST_CHECK(f_truncate(&fil) == FR_OK);
+  TEST_CHECK(f_lseek(&fil, 0) == FR_OK);
+  TEST_CHECK(f_stream_write(&fil, data, 2) == FR_OK);
+  TEST_CHECK(disk_write_sector == cluster_sector(sclust));
+  TEST_CHECK(fil.ct_size == 4 * CLUSTER_SIZE);
+  TEST_CHECK(f_lseek(&fil, 0) == FR_OK);
+  TEST_CHECK(f_read(&fil, back, 2 * FF_MAX_SS, &br) == FR_OK && br == 2 * FF_MAX_SS);
+  TEST_CHECK(memcmp(back, data, 2 * FF_MAX_SS) == 0);
+  TEST_CHECK(f_close(&fil) == FR_OK);
+
+  /* f_truncate shortens the verified block */
+  TEST_CHECK(f_open(&fil, "c.bin", FA_CREATE_ALWAYS | FA_WRITE) == FR_OK);
+  TEST_CHECK(f_expand(&fil, 16 * CLUSTER_SIZE, 1) == FR_OK);
+  TEST_CHECK(f_lseek(&fil, 8 * CLUSTER_SIZE) == FR_OK);
+  TEST_CHECK(f_truncate(&fil) == FR_OK);
+  TEST_CHECK(fil.ct_size == 8 * CLUSTER_SIZE);
+  TEST_CHECK(f_close(&fil) == FR_OK);
+}
+
+static void test_freemap(void)
+{
+  DWORD region, nleft, last, nfree;
+  FATFS *pfs;
+  int calls;
+
+  /* clusters 2 to 301 fill region 0 and part of region 1 */
+  format();
+  region = (DWORD)1 << fs.fm_shift;
+  TEST_CHECK(((fs.n_fatent - 1) >> fs.fm_shift) < FF_FREEMAP_SIZE * 8);
+  TEST_CHECK(((fs.n_fatent - 1) >> (fs.fm_shift - 1)) >= FF_FREEMAP_SIZE * 8);
+  TEST_CHECK(region == 256);
+  TEST_CHECK(f_open(&fil, "big.bin", FA_CREATE_ALWAYS | FA_WRITE) == FR_OK);
+  TEST_CHECK(f_expand(&fil, 300 * CLUSTER_SIZE, 1) == FR_OK);
+  TEST_CHECK(fil.obj.sclust == 2);
+  TEST_CHECK(f_close(&fil) == FR_OK);
+
+  /* scan three regions per call after a new mount */
+  TEST_CHECK(f_mount(&fs, "", 1) == FR_OK);
+  TEST_CHECK(fs.fm_scan == 2 && fs.fm_full[0] == 0);
+  calls = 0;
+  last = fs.n_fatent;
+  do
+  {
+    TEST_CHECK(f_freemap_scan("", 3, &nleft) == FR_OK);
+    TEST_CHECK(nleft < last);
+    last = nleft;
+    calls ++;
+  } while(nleft != 0 && calls < 100);
+  TEST_CHECK(calls == (int)((fs.n_fatent + 3 * region - 1) / (3 * region)));
+  TEST_CHECK(fs.fm_scan == 0 && fs.free_clst == fs.n_fatent - 2 - 300);
+  TEST_CHECK((fs.fm_full[0] & 0x03) == 0x01);
+  TEST_CHECK(f_getfree("", &nfree, &pfs) == FR_OK && nfree == fs.n_fatent - 2 - 300);
+
+  /* a new chain skips region 0 without reading its fat sector */
+  TEST_CHECK(f_mount(&fs, "", 1) == FR_OK);
+  TEST_CHECK(f_freemap_scan("", FF_FREEMAP_SIZE * 8, &nleft) == FR_OK && nleft == 0);
+  disk_watch_sector = fs.fatbase;
+  disk_watch_read = 0;
+  write_clusters("one.bin", FA_CREATE_ALWAYS, 1, 40);
+  TEST_CHECK(disk_watch_read == 0);
+  TEST_CHECK(f_open(&fil, "one.bin", FA_READ) == FR_OK && fil.obj.sclust == 302);
+  TEST_CHECK(f_close(&fil) == FR_OK);
+  disk_watch_sector = DISK_SECTORS;
+
+  /* frees in the scanned part are counted, region 0 is no longer full */
+  TEST_CHECK(f_mount(&fs, "", 1) == FR_OK);
+  TEST_CHECK(f_freemap_scan("", 1, &nleft) == FR_OK && fs.fm_scan == region);
+  TEST_CHECK(fs.fm_free == 0 && (fs.fm_full[0] & 0x01) == 0x01);
+  TEST_CHECK(f_unlink("big.bin") == FR_OK);
+  TEST_CHECK((fs.fm_full[0] & 0x01) == 0 && fs.fm_free == region - 2);
+  TEST_CHECK(f_unlink("one.bin") == FR_OK);
+  TEST_CHECK(fs.fm_free == region - 2);
+  do
+  {
+    TEST_CHECK(f_freemap_scan("", 4, &nleft) == FR_OK);
+  } while(nleft != 0 && fs.fm_scan != 0);
+  TEST_CHECK(fs.free_clst == fs.n_fatent - 2);
+}
+
+int main(void)
+{
+  disk_watch_sector = DISK_SECTORS;
+
+  test_expand();
+  test_cache();
+  test_commit_failure();
+  test_fragmented();
+  test_freemap();
+
+  printf("%d checks failed\n", test_failed);
+  return test_failed;
+}
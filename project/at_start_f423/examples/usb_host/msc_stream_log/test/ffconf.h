@@ -0,0 +1,41 @@
+/**
+  **************************************************************************
+  * @file     ffconf.h
+  * @brief    fatfs configuration of the streaming write test
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* the configuration of the example with f_mkfs to format the ram disk and a
+   free cluster region map of 32 regions, small enough that the allocations
+   of the test fill whole regions. */
+
+#ifndef __TEST_FFCONF_H
+#define __TEST_FFCONF_H
+
+#include "../inc/ffconf.h"
+
+#undef FF_USE_MKFS
+#define FF_USE_MKFS                      1
+
+#define FF_USE_FREEMAP                   1
+#define FF_FREEMAP_SIZE                  4
+
+#endif
@@ -0,0 +1,151 @@
+/**
+  **************************************************************************
+  * @file     irq_plan.h
+  * @brief    interrupt priority planner and isr budget monitor header
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* define to prevent recursive inclusion -------------------------------------*/
+#ifndef __IRQ_PLAN_H
+#define __IRQ_PLAN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* includes ------------------------------------------------------------------*/
+#include "at32f423.h"
+#include "irq_plan_conf.h"
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup FreeRTOS_irq_plan_demo
+  * @{
+  */
+
+#ifndef IRQ_PLAN_SYSCALL_PRIORITY
+#define IRQ_PLAN_SYSCALL_PRIORITY        1
+#endif
+
+#ifndef IRQ_PLAN_LOWEST_PRIORITY
+#define IRQ_PLAN_LOWEST_PRIORITY         ((1 << __NVIC_PRIO_BITS) - 1)
+#endif
+
+#ifndef IRQ_PLAN_CRITICAL_US
+#define IRQ_PLAN_CRITICAL_US             0
+#endif
+
+/* exception entry and return of the cortex-m4 without floating point context,
+   added to the budget of every handler */
+#ifndef IRQ_PLAN_OVERHEAD_CYCLES
+#define IRQ_PLAN_OVERHEAD_CYCLES         24
+#endif
+
+#if (IRQ_PLAN_SYSCALL_PRIORITY < 1) || (IRQ_PLAN_SYSCALL_PRIORITY >= IRQ_PLAN_LOWEST_PRIORITY)
+#error "IRQ_PLAN_SYSCALL_PRIORITY leaves no priority for the interrupts above or below it"
+#endif
+
+#define IRQ_PLAN_ID(id, name, irqn, deadline, period, budget, rtos) IRQ_PLAN_##id,
+
+/**
+  * @brief interrupt identifiers, in the order of IRQ_PLAN_TABLE
+  */
+typedef enum
+{
+  IRQ_PLAN_TABLE(IRQ_PLAN_ID)
+  IRQ_PLAN_COUNT
+} irq_plan_id_type;
+
+/**
+  * @brief interrupt declaration, one IRQ_PLAN_TABLE entry
+  */
+typedef struct
+{
+  const char                             *name;           /*!< name in the reports */
+  IRQn_Type                              irqn;            /*!< interrupt number */
+  uint32_t                               deadline_us;     /*!< longest time from the request to the end of the handler */
+  uint32_t                               period_us;       /*!< shortest time between two requests */
+  uint32_t                               budget_us;       /*!< longest execution time of the handler */
+  confirm_state                          rtos;            /*!< handler calls freertos api functions */
+} irq_plan_entry_type;
+
+/**
+  * @brief planned priority and measured execution of an interrupt
+  */
+typedef struct
+{
+  uint8_t                                priority;        /*!< assigned preemption priority */
+  error_status                           schedulable;     /*!< SUCCESS if response is within the deadline */
+  uint32_t                               response;        /*!< worst case response time, cycles */
+  uint32_t                               deadline;        /*!< deadline_us, cycles */
+  uint32_t                               budget;          /*!< budget_us, cycles */
+  uint32_t                               count;           /*!< handler executions */
+  uint32_t                               self_max;        /*!< longest execution without nested handlers, cycles */
+  uint32_t                               elapsed_max;     /*!< longest execution with nested handlers, cycles */
+  uint32_t                               overruns;        /*!< executions longer than the budget */
+  uint32_t                               late;            /*!< executions that ended after the deadline */
+} irq_plan_state_type;
+
+/**
+  * @brief cycle counter and nested time at the entry of a handler
+  */
+typedef struct
+{
+  uint32_t                               start;
+  uint32_t                               busy;
+} irq_plan_frame_type;
+
+extern const irq_plan_entry_type irq_plan_table[IRQ_PLAN_COUNT];
+extern irq_plan_state_type irq_plan_state[IRQ_PLAN_COUNT];
+extern __IO uint32_t irq_plan_busy;
+
+/**
+  * @brief  mark the entry of a planned handler, first statement of the handler.
+  * @param  frame: entry time, local to the handler
+  * @retval none
+  */
+__STATIC_INLINE void irq_plan_enter(irq_plan_frame_type *frame)
+{
+  frame->start = DWT->CYCCNT;
+  frame->busy = irq_plan_busy;
+}
+
+error_status irq_plan_init(void);
+void irq_plan_apply(void);
+error_status irq_plan_verify(void);
+void irq_plan_exit(irq_plan_id_type id, irq_plan_frame_type *frame);
+void irq_plan_report(void);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,88 @@
+/**
+  **************************************************************************
+  * @file     irq_plan_conf.h
+  * @brief    interrupt plan of the application
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* define to prevent recursive inclusion -------------------------------------*/
+#ifndef __IRQ_PLAN_CONF_H
+#define __IRQ_PLAN_CONF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* includes ------------------------------------------------------------------*/
+#include "FreeRTOSConfig.h"
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup FreeRTOS_irq_plan_demo
+  * @{
+  */
+
+/* a plan given before this file, the host test in test/, replaces the
+   definitions below */
+#ifndef IRQ_PLAN_TABLE
+
+/* interrupts that call freertos api functions are placed at or below this
+   preemption priority, the others above it */
+#define IRQ_PLAN_SYSCALL_PRIORITY        configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+
+/* lowest preemption priority, used by pendsv and systick */
+#define IRQ_PLAN_LOWEST_PRIORITY         configLIBRARY_LOWEST_INTERRUPT_PRIORITY
+
+/* longest section that masks the freertos interrupts, taskENTER_CRITICAL and
+   the kernel, in microseconds */
+#define IRQ_PLAN_CRITICAL_US             10
+
+/* one entry per interrupt, the driver owning the interrupt declares:
+   X(id, name, irqn, deadline_us, period_us, budget_us, rtos)
+   - deadline_us: longest time from the request to the end of the handler
+   - period_us: shortest time between two requests
+   - budget_us: longest execution time of the handler
+   - rtos: TRUE if the handler calls freertos api functions */
+#define IRQ_PLAN_TABLE(X) \
+  /* control loop, tmr1 overflow at 10 khz, must finish well inside a period */ \
+  X(CONTROL, "control", TMR1_OVF_TMR10_IRQn,      20,   100,  4, FALSE) \
+  /* usart2 receive without fifo, a byte at 115200 baud every 87 us */ \
+  X(CONSOLE, "console", USART2_IRQn,              80,    87,  6, TRUE) \
+  /* memory to memory dma, bulk copy completion every 10 ms */ \
+  X(BULK,    "bulk",    DMA1_Channel1_IRQn,     2000, 10000, 10, TRUE)
+
+#endif
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,304 @@
+/**
+  **************************************************************************
+  * @file     irq_plan.c
+  * @brief    interrupt priority planner and isr budget monitor
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "irq_plan.h"
+#include <stdio.h>
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup FreeRTOS_irq_plan_demo
+  * @{
+  */
+
+#define IRQ_PLAN_ENTRY(id, name, irqn, deadline, period, budget, rtos) {name, irqn, deadline, period, budget, rtos},
+
+const irq_plan_entry_type irq_plan_table[IRQ_PLAN_COUNT] =
+{
+  IRQ_PLAN_TABLE(IRQ_PLAN_ENTRY)
+};
+
+irq_plan_state_type irq_plan_state[IRQ_PLAN_COUNT];
+
+/* execution time of the finished handlers without their nested handlers, the
+   part of it gained during a handler is the time it was preempted */
+__IO uint32_t irq_plan_busy = 0;
+
+static uint32_t irq_plan_cycles_us;
+
+/**
+  * @brief  deadline monotonic assignment, in each band the shorter deadline
+  *         gets the higher priority and equal deadlines share a priority.
+  *         the interrupts calling freertos use the band from
+  *         IRQ_PLAN_SYSCALL_PRIORITY to the priority above the kernel, the
+  *         others the band above IRQ_PLAN_SYSCALL_PRIORITY. a band with more
+  *         deadlines than priorities shares its last priority.
+  * @param  none
+  * @retval none
+  */
+static void irq_plan_assign(void)
+{
+  uint8_t order[IRQ_PLAN_COUNT];
+  uint32_t i, k, band, level, last, deadline;
+  confirm_state rtos;
+  int32_t j;
+
+  /* entries sorted by deadline */
+  for(i = 0; i < IRQ_PLAN_COUNT; i ++)
+  {
+    for(j = (int32_t)i - 1; j >= 0 && irq_plan_table[order[j]].deadline_us > irq_plan_table[i].deadline_us; j --)
+    {
+      order[j + 1] = order[j];
+    }
+    order[j + 1] = (uint8_t)i;
+  }
+
+  for(band = 0; band < 2; band ++)
+  {
+    rtos = (band == 0) ? FALSE : TRUE;
+    level = (rtos == TRUE) ? IRQ_PLAN_SYSCALL_PRIORITY : 0;
+    last = (rtos == TRUE) ? IRQ_PLAN_LOWEST_PRIORITY - 1 : IRQ_PLAN_SYSCALL_PRIORITY - 1;
+    deadline = 0;
+    for(i = 0; i < IRQ_PLAN_COUNT; i ++)
+    {
+      k = order[i];
+      if(irq_plan_table[k].rtos != rtos)
+      {
+        continue;
+      }
+      if(deadline != 0 && irq_plan_table[k].deadline_us != deadline && level < last)
+      {
+        level++;
+      }
+      deadline = irq_plan_table[k].deadline_us;
+      irq_plan_state[k].priority = (uint8_t)level;
+    }
+  }
+}
+
+/**
+  * @brief  worst case response time of an interrupt: its budget, a handler
+  *         of the same priority that has just started, the critical sections
+  *         for freertos interrupts and the requests of the higher priorities
+  *         arriving meanwhile.
+  * @param  id: interrupt
+  * @retval SUCCESS if the response time is within the deadline
+  */
+static error_status irq_plan_response(uint32_t id)
+{
+  uint32_t i, blocking = 0, response, next, period;
+  uint8_t priority = irq_plan_state[id].priority;
+
+  for(i = 0; i < IRQ_PLAN_COUNT; i ++)
+  {
+    if(i != id && irq_plan_state[i].priority == priority &&
+       irq_plan_state[i].budget + IRQ_PLAN_OVERHEAD_CYCLES > blocking)
+    {
+      blocking = irq_plan_state[i].budget + IRQ_PLAN_OVERHEAD_CYCLES;
+    }
+  }
+  if(irq_plan_table[id].rtos == TRUE)
+  {
+    blocking += IRQ_PLAN_CRITICAL_US * irq_plan_cycles_us;
+  }
+
+  next = irq_plan_state[id].budget + IRQ_PLAN_OVERHEAD_CYCLES + blocking;
+  do
+  {
+    response = next;
+    next = irq_plan_state[id].budget + IRQ_PLAN_OVERHEAD_CYCLES + blocking;
+    for(i = 0; i < IRQ_PLAN_COUNT; i ++)
+    {
+      if(irq_plan_state[i].priority < priority)
+      {
+        period = irq_plan_table[i].period_us * irq_plan_cycles_us;
+        next += (response + period - 1) / period * (irq_plan_state[i].budget + IRQ_PLAN_OVERHEAD_CYCLES);
+      }
+    }
+  } while(next != response && next <= irq_plan_state[id].deadline);
+
+  irq_plan_state[id].response = next;
+  return (next <= irq_plan_state[id].deadline) ? SUCCESS : ERROR;
+}
+
+/**
+  * @brief  assign the priorities of IRQ_PLAN_TABLE, check the response times
+  *         against the deadlines and start the cycle counter of the monitor.
+  * @param  none
+  * @retval SUCCESS or ERROR if an interrupt can miss its deadline
+  */
+error_status irq_plan_init(void)
+{
+  error_status status = SUCCESS;
+  uint32_t i;
+
+  irq_plan_cycles_us = system_core_clock / 1000000;
+  for(i = 0; i < IRQ_PLAN_COUNT; i ++)
+  {
+    irq_plan_state[i].deadline = irq_plan_table[i].deadline_us * irq_plan_cycles_us;
+    irq_plan_state[i].budget = irq_plan_table[i].budget_us * irq_plan_cycles_us;
+  }
+
+  irq_plan_assign();
+  for(i = 0; i < IRQ_PLAN_COUNT; i ++)
+  {
+    irq_plan_state[i].schedulable = irq_plan_response(i);
+    if(irq_plan_state[i].schedulable == ERROR)
+    {
+      status = ERROR;
+    }
+  }
+
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  return status;
+}
+
+/**
+  * @brief  configure the priority group and enable the planned interrupts
+  *         at their priorities, all bits select the preemption priority as
+  *         freertos requires.
+  * @param  none
+  * @retval none
+  */
+void irq_plan_apply(void)
+{
+  uint32_t i;
+
+  nvic_priority_group_config(NVIC_PRIORITY_GROUP_4);
+  for(i = 0; i < IRQ_PLAN_COUNT; i ++)
+  {
+    nvic_irq_enable(irq_plan_table[i].irqn, irq_plan_state[i].priority, 0);
+  }
+}
+
+/**
+  * @brief  read back the priority group and the priorities of the planned
+  *         interrupts, catches a later nvic_irq_enable with other values.
+  * @param  none
+  * @retval SUCCESS or ERROR on a mismatch
+  */
+error_status irq_plan_verify(void)
+{
+  error_status status = SUCCESS;
+  uint32_t i, priority;
+
+  if(NVIC_GetPriorityGrouping() != NVIC_PRIORITY_GROUP_4)
+  {
+    printf("irq plan: priority group %d instead of 4 preemption bits\r\n", NVIC_GetPriorityGrouping());
+    status = ERROR;
+  }
+  for(i = 0; i < IRQ_PLAN_COUNT; i ++)
+  {
+    priority = NVIC_GetPriority(irq_plan_table[i].irqn);
+    if(priority != irq_plan_state[i].priority)
+    {
+      printf("irq plan: %s priority %d instead of %d\r\n", irq_plan_table[i].name,
+             priority, irq_plan_state[i].priority);
+      status = ERROR;
+    }
+    if(irq_plan_table[i].rtos == TRUE && priority < IRQ_PLAN_SYSCALL_PRIORITY)
+    {
+      printf("irq plan: %s calls freertos above the syscall priority %d\r\n", irq_plan_table[i].name,
+             IRQ_PLAN_SYSCALL_PRIORITY);
+      status = ERROR;
+    }
+  }
+  return status;
+}
+
+/**
+  * @brief  mark the exit of a planned handler, last statement of the handler.
+  *         the time of the nested handlers is taken out of the execution
+  *         time, interrupts outside of the plan are counted as execution.
+  * @param  id: interrupt of the handler
+  * @param  frame: entry time from irq_plan_enter
+  * @retval none
+  */
+void irq_plan_exit(irq_plan_id_type id, irq_plan_frame_type *frame)
+{
+  irq_plan_state_type *state = &irq_plan_state[id];
+  uint32_t primask, elapsed, self;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  elapsed = DWT->CYCCNT - frame->start;
+  self = elapsed - (irq_plan_busy - frame->busy);
+  irq_plan_busy += self;
+  __set_PRIMASK(primask);
+
+  state->count++;
+  if(self > state->self_max)
+  {
+    state->self_max = self;
+  }
+  if(elapsed > state->elapsed_max)
+  {
+    state->elapsed_max = elapsed;
+  }
+  if(self > state->budget)
+  {
+    state->overruns++;
+  }
+  if(elapsed > state->deadline)
+  {
+    state->late++;
+  }
+}
+
+/**
+  * @brief  print the plan and the measured execution times in microseconds.
+  * @param  none
+  * @retval none
+  */
+void irq_plan_report(void)
+{
+  const irq_plan_entry_type *entry;
+  irq_plan_state_type *state;
+  uint32_t i;
+
+  printf("irq     prio rtos deadline period budget response   count  self elapsed overruns late\r\n");
+  for(i = 0; i < IRQ_PLAN_COUNT; i ++)
+  {
+    entry = &irq_plan_table[i];
+    state = &irq_plan_state[i];
+    printf("%-8s %3d %4s %8d %6d %6d %8d%s %7d %5d %7d %8d %4d\r\n",
+           entry->name, state->priority, entry->rtos == TRUE ? "yes" : "no",
+           entry->deadline_us, entry->period_us, entry->budget_us,
+           state->response / irq_plan_cycles_us, state->schedulable == SUCCESS ? " " : "!",
+           state->count, state->self_max / irq_plan_cycles_us, state->elapsed_max / irq_plan_cycles_us,
+           state->overruns, state->late);
+  }
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,390 @@
+/**
+  **************************************************************************
+  * @file     main.c
+  * @brief    main program
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "at32f423_board.h"
+#include "at32f423_clock.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "irq_plan.h"
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup FreeRTOS_irq_plan_demo
+  * @{
+  */
+
+/* the periods below are the ones declared in irq_plan_conf.h */
+#define CONTROL_PERIOD_US                100
+#define CONSOLE_BAUDRATE                 115200
+#define BULK_WORDS                       1024
+#define BULK_INTERVAL_MS                 10
+#define REPORT_INTERVAL_MS               2000
+
+/* pi controller on a first order plant, gains in 1/256 */
+#define CONTROL_SETPOINT                 1000
+#define CONTROL_KP                       64
+#define CONTROL_KI                       4
+#define CONTROL_OUTPUT_MAX               4095
+
+TaskHandle_t console_handler;
+TaskHandle_t bulk_handler;
+TaskHandle_t report_handler;
+
+static QueueHandle_t console_queue;
+
+static uint32_t bulk_src[BULK_WORDS];
+static uint32_t bulk_dst[BULK_WORDS];
+static uint32_t bulk_errors = 0;
+
+static int32_t control_integral = 0;
+static int32_t control_output = 0;
+__IO int32_t control_feedback = 0;
+
+/* console task */
+void console_task_function(void *pvParameters);
+/* bulk task */
+void bulk_task_function(void *pvParameters);
+/* report task */
+void report_task_function(void *pvParameters);
+
+/**
+  * @brief  tmr1 overflow at 1 / CONTROL_PERIOD_US, the interrupt priority
+  *         is set by irq_plan_apply.
+  * @param  none
+  * @retval none
+  */
+static void control_config(void)
+{
+  crm_clocks_freq_type crm_clocks_freq_struct = {0};
+
+  crm_clocks_freq_get(&crm_clocks_freq_struct);
+  crm_periph_clock_enable(CRM_TMR1_PERIPH_CLOCK, TRUE);
+
+  /* 1 mhz count clock */
+  tmr_base_init(TMR1, CONTROL_PERIOD_US - 1, (crm_clocks_freq_struct.apb2_freq / 1000000) - 1);
+  tmr_cnt_dir_set(TMR1, TMR_COUNT_UP);
+  tmr_interrupt_enable(TMR1, TMR_OVF_INT, TRUE);
+  tmr_counter_enable(TMR1, TRUE);
+}
+
+/**
+  * @brief  usart2 receive interrupt, pa2 tx and pa3 rx.
+  * @param  none
+  * @retval none
+  */
+static void console_config(void)
+{
+  gpio_init_type gpio_init_struct;
+
+  crm_periph_clock_enable(CRM_USART2_PERIPH_CLOCK, TRUE);
+  crm_periph_clock_enable(CRM_GPIOA_PERIPH_CLOCK, TRUE);
+
+  gpio_default_para_init(&gpio_init_struct);
+  gpio_init_struct.gpio_drive_strength = GPIO_DRIVE_STRENGTH_STRONGER;
+  gpio_init_struct.gpio_out_type  = GPIO_OUTPUT_PUSH_PULL;
+  gpio_init_struct.gpio_mode = GPIO_MODE_MUX;
+  gpio_init_struct.gpio_pins = GPIO_PINS_2 | GPIO_PINS_3;
+  gpio_init_struct.gpio_pull = GPIO_PULL_NONE;
+  gpio_init(GPIOA, &gpio_init_struct);
+  gpio_pin_mux_config(GPIOA, GPIO_PINS_SOURCE2, GPIO_MUX_7);
+  gpio_pin_mux_config(GPIOA, GPIO_PINS_SOURCE3, GPIO_MUX_7);
+
+  usart_init(USART2, CONSOLE_BAUDRATE, USART_DATA_8BITS, USART_STOP_1_BIT);
+  usart_transmitter_enable(USART2, TRUE);
+  usart_receiver_enable(USART2, TRUE);
+  usart_interrupt_enable(USART2, USART_RDBF_INT, TRUE);
+  usart_enable(USART2, TRUE);
+}
+
+/**
+  * @brief  dma1 channel1 memory to memory copy of bulk_src to bulk_dst.
+  * @param  none
+  * @retval none
+  */
+static void bulk_config(void)
+{
+  dma_init_type dma_init_struct;
+  uint32_t i;
+
+  for(i = 0; i < BULK_WORDS; i ++)
+  {
+    bulk_src[i] = i * 0x01010101;
+  }
+
+  crm_periph_clock_enable(CRM_DMA1_PERIPH_CLOCK, TRUE);
+
+  dma_reset(DMA1_CHANNEL1);
+  dma_default_para_init(&dma_init_struct);
+  dma_init_struct.buffer_size = BULK_WORDS;
+  dma_init_struct.direction = DMA_DIR_MEMORY_TO_MEMORY;
+  dma_init_struct.memory_base_addr = (uint32_t)bulk_dst;
+  dma_init_struct.memory_data_width = DMA_MEMORY_DATA_WIDTH_WORD;
+  dma_init_struct.memory_inc_enable = TRUE;
+  dma_init_struct.peripheral_base_addr = (uint32_t)bulk_src;
+  dma_init_struct.peripheral_data_width = DMA_PERIPHERAL_DATA_WIDTH_WORD;
+  dma_init_struct.peripheral_inc_enable = TRUE;
+  dma_init_struct.priority = DMA_PRIORITY_LOW;
+  dma_init_struct.loop_mode_enable = FALSE;
+  dma_init(DMA1_CHANNEL1, &dma_init_struct);
+
+  dma_interrupt_enable(DMA1_CHANNEL1, DMA_FDT_INT, TRUE);
+}
+
+/**
+  * @brief  main function.
+  * @param  none
+  * @retval none
+  */
+int main(void)
+{
+  system_clock_config();
+
+  /* init led2, led3 and led4 */
+  at32_led_init(LED2);
+  at32_led_init(LED3);
+  at32_led_init(LED4);
+
+  /* init usart1 */
+  uart_print_init(115200);
+
+  /* priorities from the deadlines of irq_plan_conf.h */
+  if(irq_plan_init() != SUCCESS)
+  {
+    printf("irq plan: an interrupt can miss its deadline.\r\n");
+    at32_led_on(LED4);
+  }
+  irq_plan_report();
+
+  control_config();
+  console_config();
+  bulk_config();
+
+  /* enter critical */
+  taskENTER_CRITICAL();
+
+  console_queue = xQueueCreate(32, sizeof(uint8_t));
+  if(console_queue == NULL)
+  {
+    printf("console queue could not be created as there was insufficient heap memory remaining.\r\n");
+  }
+
+  /* create console task */
+  if(xTaskCreate((TaskFunction_t )console_task_function,
+                 (const char*    )"console_task",
+                 (uint16_t       )256,
+                 (void*          )NULL,
+                 (UBaseType_t    )3,
+                 (TaskHandle_t*  )&console_handler) != pdPASS)
+  {
+    printf("console task could not be created as there was insufficient heap memory remaining.\r\n");
+  }
+  else
+  {
+    printf("console task was created successfully.\r\n");
+  }
+  /* create bulk task */
+  if(xTaskCreate((TaskFunction_t )bulk_task_function,
+                 (const char*    )"bulk_task",
+                 (uint16_t       )256,
+                 (void*          )NULL,
+                 (UBaseType_t    )2,
+                 (TaskHandle_t*  )&bulk_handler) != pdPASS)
+  {
+    printf("bulk task could not be created as there was insufficient heap memory remaining.\r\n");
+  }
+  else
+  {
+    printf("bulk task was created successfully.\r\n");
+  }
+  /* create report task */
+  if(xTaskCreate((TaskFunction_t )report_task_function,
+                 (const char*    )"report_task",
+                 (uint16_t       )512,
+                 (void*          )NULL,
+                 (UBaseType_t    )1,
+                 (TaskHandle_t*  )&report_handler) != pdPASS)
+  {
+    printf("report task could not be created as there was insufficient heap memory remaining.\r\n");
+  }
+  else
+  {
+    printf("report task was created successfully.\r\n");
+  }
+
+  /* group and priorities of the planned interrupts, the ones calling
+     freertos stay masked until the scheduler starts */
+  irq_plan_apply();
+  if(irq_plan_verify() != SUCCESS)
+  {
+    at32_led_on(LED4);
+  }
+
+  /* exit critical */
+  taskEXIT_CRITICAL();
+
+  /* start scheduler */
+  vTaskStartScheduler();
+}
+
+/**
+  * @brief  this function handles tmr1 overflow handler, one step of the
+  *         control loop. it calls no freertos function and runs above the
+  *         kernel.
+  * @param  none
+  * @retval none
+  */
+void TMR1_OVF_TMR10_IRQHandler(void)
+{
+  irq_plan_frame_type frame;
+  int32_t error;
+
+  irq_plan_enter(&frame);
+  if(tmr_interrupt_flag_get(TMR1, TMR_OVF_FLAG) == SET)
+  {
+    tmr_flag_clear(TMR1, TMR_OVF_FLAG);
+
+    error = CONTROL_SETPOINT - control_feedback;
+    control_integral += error;
+    control_output = (error * CONTROL_KP + control_integral * CONTROL_KI) / 256;
+    if(control_output > CONTROL_OUTPUT_MAX)
+    {
+      control_output = CONTROL_OUTPUT_MAX;
+      control_integral -= error;
+    }
+    else if(control_output < 0)
+    {
+      control_output = 0;
+      control_integral -= error;
+    }
+    /* simulated plant, time constant of 8 periods */
+    control_feedback += (control_output - control_feedback) / 8;
+  }
+  irq_plan_exit(IRQ_PLAN_CONTROL, &frame);
+}
+
+/**
+  * @brief  this function handles usart2 handler, passes each received byte
+  *         to the console task.
+  * @param  none
+  * @retval none
+  */
+void USART2_IRQHandler(void)
+{
+  irq_plan_frame_type frame;
+  BaseType_t woken = pdFALSE;
+  uint8_t data;
+
+  irq_plan_enter(&frame);
+  if(usart_interrupt_flag_get(USART2, USART_RDBF_FLAG) != RESET)
+  {
+    data = (uint8_t)usart_data_receive(USART2);
+    xQueueSendFromISR(console_queue, &data, &woken);
+  }
+  irq_plan_exit(IRQ_PLAN_CONSOLE, &frame);
+
+  portYIELD_FROM_ISR(woken);
+}
+
+/**
+  * @brief  this function handles dma1 channel1 handler, end of a bulk copy.
+  * @param  none
+  * @retval none
+  */
+void DMA1_Channel1_IRQHandler(void)
+{
+  irq_plan_frame_type frame;
+  BaseType_t woken = pdFALSE;
+
+  irq_plan_enter(&frame);
+  if(dma_interrupt_flag_get(DMA1_FDT1_FLAG) != RESET)
+  {
+    dma_flag_clear(DMA1_FDT1_FLAG);
+    vTaskNotifyGiveFromISR(bulk_handler, &woken);
+  }
+  irq_plan_exit(IRQ_PLAN_BULK, &frame);
+
+  portYIELD_FROM_ISR(woken);
+}
+
+/* console task function, echoes the bytes received on usart2 */
+void console_task_function(void *pvParameters)
+{
+  uint8_t data;
+
+  while(1)
+  {
+    if(xQueueReceive(console_queue, &data, portMAX_DELAY) == pdPASS)
+    {
+      while(usart_flag_get(USART2, USART_TDBE_FLAG) == RESET);
+      usart_data_transmit(USART2, data);
+    }
+  }
+}
+
+/* bulk task function, copies bulk_src to bulk_dst by dma every BULK_INTERVAL_MS */
+void bulk_task_function(void *pvParameters)
+{
+  while(1)
+  {
+    dma_channel_enable(DMA1_CHANNEL1, FALSE);
+    dma_data_number_set(DMA1_CHANNEL1, BULK_WORDS);
+    dma_channel_enable(DMA1_CHANNEL1, TRUE);
+
+    if(ulTaskNotifyTake(pdTRUE, BULK_INTERVAL_MS) == 0 ||
+       bulk_dst[BULK_WORDS - 1] != bulk_src[BULK_WORDS - 1])
+    {
+      bulk_errors++;
+    }
+    vTaskDelay(BULK_INTERVAL_MS);
+  }
+}
+
+/* report task function, prints the plan with the measured execution times */
+void report_task_function(void *pvParameters)
+{
+  while(1)
+  {
+    vTaskDelay(REPORT_INTERVAL_MS);
+    at32_led_toggle(LED2);
+
+    irq_plan_report();
+    if(irq_plan_verify() != SUCCESS)
+    {
+      at32_led_on(LED4);
+    }
+    printf("control feedback %d, bulk errors %d\r\n\r\n", control_feedback, bulk_errors);
+  }
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,93 @@
+/**
+  **************************************************************************
+  * @file     at32f423.h
+  * @brief    host replacement of the device header for the irq plan test
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* irq_plan.c only uses the nvic priorities, the dwt cycle counter and primask,
+   this header replaces the device header so that it builds on the host. the
+   nvic, the cycle counter and primask are plain variables of irq_plan_test.c */
+
+#ifndef __AT32F423_H
+#define __AT32F423_H
+
+#include <stdint.h>
+
+#define __IO                             volatile
+#define __STATIC_INLINE                  static inline
+#define __NVIC_PRIO_BITS                 4
+
+typedef enum {FALSE = 0, TRUE = !FALSE} confirm_state;
+typedef enum {ERROR = 0, SUCCESS = !ERROR} error_status;
+
+typedef enum IRQn
+{
+  EXINT0_IRQn                            = 6,
+  DMA1_Channel1_IRQn                     = 11,
+  DMA1_Channel2_IRQn                     = 12,
+  TMR1_OVF_TMR10_IRQn                    = 25,
+  TMR2_GLOBAL_IRQn                       = 28,
+  TMR3_GLOBAL_IRQn                       = 29,
+  SPI1_IRQn                              = 35,
+  USART2_IRQn                            = 38,
+  IRQ_NUMBER                             = 64
+} IRQn_Type;
+
+typedef enum
+{
+  NVIC_PRIORITY_GROUP_0                  = ((uint32_t)0x7),
+  NVIC_PRIORITY_GROUP_4                  = ((uint32_t)0x3)
+} nvic_priority_group_type;
+
+/**
+  * @brief simulated dwt and core debug
+  */
+typedef struct
+{
+  __IO uint32_t CTRL;
+  __IO uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+  __IO uint32_t DEMCR;
+} CoreDebug_Type;
+
+#define DWT_CTRL_CYCCNTENA_Msk           (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk       (1UL << 24)
+
+extern DWT_Type test_dwt;
+extern CoreDebug_Type test_core_debug;
+#define DWT                              (&test_dwt)
+#define CoreDebug                        (&test_core_debug)
+
+#include "system_at32f423.h"
+
+void nvic_priority_group_config(nvic_priority_group_type priority_group);
+void nvic_irq_enable(IRQn_Type irqn, uint32_t preempt_priority, uint32_t sub_priority);
+uint32_t NVIC_GetPriorityGrouping(void);
+uint32_t NVIC_GetPriority(IRQn_Type irqn);
+uint32_t __get_PRIMASK(void);
+void __disable_irq(void);
+void __set_PRIMASK(uint32_t primask);
+
+#endif
@@ -0,0 +1,255 @@
+/**
+  **************************************************************************
+  * @file     irq_plan_test.c
+  * @brief    host test of the interrupt plan
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* the table of test/irq_plan_conf.h runs with a 1 mhz core clock, one cycle
+   per microsecond. the cases cover the deadline monotonic priorities in the
+   two bands with shared deadlines and full bands, the response times worked
+   out by hand with the blocking of a same priority handler, the critical
+   sections and the higher priority requests, an interrupt that misses its
+   deadline, the nvic read back after irq_plan_apply and a later change, and
+   the execution times of nested handlers measured by irq_plan_exit. */
+
+#include "irq_plan.h"
+#include <stdio.h>
+
+#define TEST_CHECK(cond)                 do { if(!(cond)) { printf("  %s:%d: %s\n", __func__, __LINE__, #cond); \
+                                           test_failed ++; } } while(0)
+
+DWT_Type test_dwt;
+CoreDebug_Type test_core_debug;
+uint32_t system_core_clock = 1000000;
+
+static uint32_t nvic_group = NVIC_PRIORITY_GROUP_0;
+static uint32_t nvic_priority[IRQ_NUMBER];
+static uint32_t primask;
+static int primask_disabled;
+
+static int test_failed;
+
+void nvic_priority_group_config(nvic_priority_group_type priority_group)
+{
+  nvic_group = priority_group;
+}
+
+void nvic_irq_enable(IRQn_Type irqn, uint32_t preempt_priority, uint32_t sub_priority)
+{
+  TEST_CHECK(nvic_group == NVIC_PRIORITY_GROUP_4 && sub_priority == 0);
+  nvic_priority[irqn] = preempt_priority;
+}
+
+uint32_t NVIC_GetPriorityGrouping(void)
+{
+  return nvic_group;
+}
+
+uint32_t NVIC_GetPriority(IRQn_Type irqn)
+{
+  return nvic_priority[irqn];
+}
+
+uint32_t __get_PRIMASK(void)
+{
+  return primask;
+}
+
+void __disable_irq(void)
+{
+  primask = 1;
+  primask_disabled ++;
+}
+
+void __set_PRIMASK(uint32_t value)
+{
+  primask = value;
+}
+
+static void test_priorities(void)
+{
+  uint32_t i;
+
+  TEST_CHECK(irq_plan_init() == ERROR);
+  TEST_CHECK((test_core_debug.DEMCR & CoreDebug_DEMCR_TRCENA_Msk) != 0);
+  TEST_CHECK((test_dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk) != 0);
+
+  /* without freertos calls: 20 us, then 100 and 300 us sharing the last
+     level of the band */
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_FAST].priority == 0);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_SLOW_A].priority == 1);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_SLOW_B].priority == 1);
+
+  /* freertos calls: the two 60 us deadlines share a level, 150 us, then 160
+     and 200 us sharing the level above the kernel */
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_TICK_A].priority == 2);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_TICK_B].priority == 2);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_MID].priority == 3);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_HEAVY].priority == 4);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_LATE].priority == 4);
+
+  for(i = 0; i < IRQ_PLAN_COUNT; i ++)
+  {
+    TEST_CHECK(irq_plan_state[i].deadline == irq_plan_table[i].deadline_us);
+    TEST_CHECK(irq_plan_state[i].budget == irq_plan_table[i].budget_us);
+    if(irq_plan_table[i].rtos == TRUE)
+    {
+      TEST_CHECK(irq_plan_state[i].priority >= IRQ_PLAN_SYSCALL_PRIORITY);
+      TEST_CHECK(irq_plan_state[i].priority < IRQ_PLAN_LOWEST_PRIORITY);
+    }
+    else
+    {
+      TEST_CHECK(irq_plan_state[i].priority < IRQ_PLAN_SYSCALL_PRIORITY);
+    }
+  }
+}
+
+static void test_response(void)
+{
+  /* budget + overhead: fast 5, slow_a 6, slow_b 7, tick_a 4, tick_b 3,
+     mid 11, late 31, heavy 81 */
+
+  /* nothing above it and alone at its level */
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_FAST].response == 5);
+
+  /* 6 + slow_b 7 + fast 5 */
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_SLOW_A].response == 18);
+  /* 7 + slow_a 6 + fast 5 */
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_SLOW_B].response == 18);
+
+  /* 4 + tick_b 3 + critical 3 + fast 5 + slow_a 6 + slow_b 7 */
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_TICK_A].response == 28);
+  /* 3 + tick_a 4 + critical 3 + 18 */
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_TICK_B].response == 28);
+
+  /* 11 + critical 3 + one request of each level above, 25 */
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_MID].response == 39);
+
+  /* 31 + heavy 81 + critical 3 = 115, then 165 and 173 with four fast, two
+     tick_a and two tick_b requests */
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_LATE].response == 173);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_LATE].schedulable == SUCCESS);
+
+  /* 81 + late 31 + critical 3 = 115, then 165 past the 160 us deadline */
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_HEAVY].response == 165);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_HEAVY].schedulable == ERROR);
+
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_FAST].schedulable == SUCCESS);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_SLOW_B].schedulable == SUCCESS);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_TICK_B].schedulable == SUCCESS);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_MID].schedulable == SUCCESS);
+}
+
+static void test_verify(void)
+{
+  uint32_t i;
+
+  TEST_CHECK(irq_plan_verify() == ERROR);
+
+  irq_plan_apply();
+  TEST_CHECK(nvic_group == NVIC_PRIORITY_GROUP_4);
+  for(i = 0; i < IRQ_PLAN_COUNT; i ++)
+  {
+    TEST_CHECK(nvic_priority[irq_plan_table[i].irqn] == irq_plan_state[i].priority);
+  }
+  TEST_CHECK(irq_plan_verify() == SUCCESS);
+
+  /* a driver moving a freertos interrupt above the syscall priority */
+  nvic_irq_enable(USART2_IRQn, 1, 0);
+  TEST_CHECK(irq_plan_verify() == ERROR);
+  nvic_irq_enable(USART2_IRQn, irq_plan_state[IRQ_PLAN_LATE].priority, 0);
+  TEST_CHECK(irq_plan_verify() == SUCCESS);
+
+  /* another interrupt at a lower priority than planned */
+  nvic_irq_enable(TMR1_OVF_TMR10_IRQn, 1, 0);
+  TEST_CHECK(irq_plan_verify() == ERROR);
+  irq_plan_apply();
+
+  /* priority group with sub priority bits */
+  nvic_group = NVIC_PRIORITY_GROUP_0;
+  TEST_CHECK(irq_plan_verify() == ERROR);
+  irq_plan_apply();
+  TEST_CHECK(irq_plan_verify() == SUCCESS);
+}
+
+static void test_exit(void)
+{
+  irq_plan_frame_type late, mid;
+
+  /* late preempted by mid for 20 cycles, mid is over its 10 cycle budget,
+     late runs its 30 cycle budget */
+  test_dwt.CYCCNT = 1000;
+  irq_plan_enter(&late);
+  test_dwt.CYCCNT = 1010;
+  irq_plan_enter(&mid);
+  test_dwt.CYCCNT = 1030;
+  irq_plan_exit(IRQ_PLAN_MID, &mid);
+  test_dwt.CYCCNT = 1050;
+  irq_plan_exit(IRQ_PLAN_LATE, &late);
+
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_MID].count == 1);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_MID].self_max == 20);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_MID].elapsed_max == 20);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_MID].overruns == 1);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_MID].late == 0);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_LATE].count == 1);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_LATE].self_max == 30);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_LATE].elapsed_max == 50);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_LATE].overruns == 0);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_LATE].late == 0);
+
+  /* primask is masked for the update and restored */
+  TEST_CHECK(primask_disabled == 2 && primask == 0);
+  primask = 1;
+  test_dwt.CYCCNT = 2000;
+  irq_plan_enter(&mid);
+  test_dwt.CYCCNT = 2005;
+  irq_plan_exit(IRQ_PLAN_MID, &mid);
+  TEST_CHECK(primask == 1);
+  primask = 0;
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_MID].count == 2);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_MID].self_max == 20);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_MID].overruns == 1);
+
+  /* late alone for 250 cycles across the wrap of the counter, past its
+     200 us deadline */
+  test_dwt.CYCCNT = 0xFFFFFF80;
+  irq_plan_enter(&late);
+  test_dwt.CYCCNT = 0x7A;
+  irq_plan_exit(IRQ_PLAN_LATE, &late);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_LATE].count == 2);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_LATE].self_max == 250);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_LATE].elapsed_max == 250);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_LATE].overruns == 1);
+  TEST_CHECK(irq_plan_state[IRQ_PLAN_LATE].late == 1);
+}
+
+int main(void)
+{
+  test_priorities();
+  test_response();
+  test_verify();
+  test_exit();
+
+  printf("%d checks failed\n", test_failed);
+  return test_failed;
+}
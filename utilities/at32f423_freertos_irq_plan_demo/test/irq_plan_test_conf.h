@@ -0,0 +1,52 @@
+/**
+  **************************************************************************
+  * @file     irq_plan_test_conf.h
+  * @brief    interrupt plan of the irq plan test
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* plan of the host test, included before the sources by the makefile in place
+   of the table of ../inc/irq_plan_conf.h. a small nvic so that both bands
+   overflow: levels 0 and 1 for the interrupts
+   without freertos calls, 2 to 4 for the others. with a 1 mhz core clock one
+   cycle is one microsecond, the expected response times of irq_plan_test.c
+   are worked out by hand from this table. */
+
+#ifndef __IRQ_PLAN_TEST_CONF_H
+#define __IRQ_PLAN_TEST_CONF_H
+
+#define IRQ_PLAN_SYSCALL_PRIORITY        2
+#define IRQ_PLAN_LOWEST_PRIORITY         5
+#define IRQ_PLAN_CRITICAL_US             3
+#define IRQ_PLAN_OVERHEAD_CYCLES         1
+
+/*      id        name       irqn                  deadline period budget rtos */
+#define IRQ_PLAN_TABLE(X) \
+  X(MID,    "mid",    TMR2_GLOBAL_IRQn,     150,   500,  10,   TRUE)  \
+  X(FAST,   "fast",   TMR1_OVF_TMR10_IRQn,  20,    50,   4,    FALSE) \
+  X(TICK_A, "tick_a", EXINT0_IRQn,          60,    100,  3,    TRUE)  \
+  X(SLOW_B, "slow_b", SPI1_IRQn,            300,   400,  6,    FALSE) \
+  X(LATE,   "late",   USART2_IRQn,          200,   1000, 30,   TRUE)  \
+  X(SLOW_A, "slow_a", TMR3_GLOBAL_IRQn,     100,   200,  5,    FALSE) \
+  X(TICK_B, "tick_b", DMA1_Channel1_IRQn,   60,    120,  2,    TRUE)  \
+  X(HEAVY,  "heavy",  DMA1_Channel2_IRQn,   160,   1000, 80,   TRUE)
+
+#endif
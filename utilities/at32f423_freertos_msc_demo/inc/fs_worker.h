@@ -0,0 +1,126 @@
+/**
+  **************************************************************************
+  * @file     fs_worker.h
+  * @brief    fatfs io worker header
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* define to prevent recursive inclusion -------------------------------------*/
+#ifndef __FS_WORKER_H
+#define __FS_WORKER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* includes ------------------------------------------------------------------*/
+#include "at32f423.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "ff.h"
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup FreeRTOS_msc_demo
+  * @{
+  */
+
+/* requests the queue holds before fs_worker_submit fails */
+#ifndef FS_WORKER_QUEUE_LENGTH
+#define FS_WORKER_QUEUE_LENGTH           8
+#endif
+
+/* requests taken from the queue and served as one batch */
+#ifndef FS_WORKER_BATCH
+#define FS_WORKER_BATCH                  8
+#endif
+
+#ifndef FS_WORKER_STACK_SIZE
+#define FS_WORKER_STACK_SIZE             512
+#endif
+
+#ifndef FS_WORKER_PRIORITY
+#define FS_WORKER_PRIORITY               2
+#endif
+
+/**
+  * @brief file operation of a request
+  */
+typedef enum
+{
+  FS_WORKER_OPEN,                        /*!< f_open(file, path, mode) */
+  FS_WORKER_CLOSE,                       /*!< f_close(file) */
+  FS_WORKER_WRITE,                       /*!< f_write(file, buffer, len) */
+  FS_WORKER_READ,                        /*!< f_read(file, buffer, len) */
+  FS_WORKER_SYNC                         /*!< f_sync(file) */
+} fs_worker_op_type;
+
+/**
+  * @brief file request, owned by the caller until its notification arrives
+  */
+typedef struct
+{
+  fs_worker_op_type                      op;              /*!< operation */
+  FIL                                    *file;           /*!< file object */
+  const TCHAR                            *path;           /*!< file name of FS_WORKER_OPEN */
+  BYTE                                   mode;            /*!< access mode of FS_WORKER_OPEN */
+  void                                   *buffer;         /*!< data of FS_WORKER_WRITE and FS_WORKER_READ */
+  UINT                                   len;             /*!< bytes to transfer */
+  UINT                                   done;            /*!< bytes transferred */
+  FRESULT                                result;          /*!< result of the operation */
+  TaskHandle_t                           task;            /*!< task notified on completion */
+  uint32_t                               notify;          /*!< notification bits set on completion */
+} fs_worker_request_type;
+
+/**
+  * @brief worker statistics
+  */
+typedef struct
+{
+  uint32_t                               requests;        /*!< requests served */
+  uint32_t                               batches;         /*!< batches served */
+  uint32_t                               merged;          /*!< writes merged into the previous write */
+  uint32_t                               syncs_saved;     /*!< syncs served by the sync of another request */
+  uint32_t                               rejected;        /*!< submits refused because the queue was full */
+} fs_worker_stats_type;
+
+extern fs_worker_stats_type fs_worker_stats;
+
+error_status fs_worker_init(void);
+error_status fs_worker_submit(fs_worker_request_type *request, uint32_t notify);
+uint32_t fs_worker_poll(uint32_t notify);
+uint32_t fs_worker_wait(uint32_t notify, TickType_t timeout);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,51 @@
+/**
+  **************************************************************************
+  * @file     usbh_user.h
+  * @brief    usb host user header file
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+/* define to prevent recursive inclusion -------------------------------------*/
+#ifndef __USBH_USER_H
+#define __USBH_USER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "usbh_core.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+
+extern usbh_user_handler_type usbh_user_handle;
+
+/* serializes the usb host core between the host task and the disk io layer */
+extern SemaphoreHandle_t usb_host_mutex;
+
+/* set once the attached mass storage device is ready for file system access */
+extern volatile uint8_t usbh_user_ready;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
@@ -0,0 +1,116 @@
+/**
+  **************************************************************************
+  * @file     ffsystem_freertos.c
+  * @brief    fatfs os dependent functions for freertos
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "ff.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup FreeRTOS_msc_demo
+  * @{
+  */
+
+#if FF_USE_LFN == 3
+
+/**
+  * @brief  allocate a memory block from the freertos heap
+  * @param  msize: number of bytes to allocate
+  * @retval pointer to the memory block, null if not enough heap
+  */
+void* ff_memalloc(UINT msize)
+{
+  return pvPortMalloc(msize);
+}
+
+/**
+  * @brief  free a memory block to the freertos heap
+  * @param  mblock: pointer to the memory block, nothing to do if null
+  * @retval none
+  */
+void ff_memfree(void* mblock)
+{
+  vPortFree(mblock);
+}
+
+#endif
+
+#if FF_FS_REENTRANT
+
+/**
+  * @brief  create the volume lock, called in f_mount
+  * @param  vol: logical drive number
+  * @param  sobj: pointer to return the created mutex
+  * @retval 1: succeeded, 0: could not create the mutex
+  */
+int ff_cre_syncobj(BYTE vol, FF_SYNC_t* sobj)
+{
+  *sobj = xSemaphoreCreateMutex();
+  return (int)(*sobj != NULL);
+}
+
+/**
+  * @brief  delete the volume lock, called in f_mount
+  * @param  sobj: mutex of the volume
+  * @retval 1: succeeded
+  */
+int ff_del_syncobj(FF_SYNC_t sobj)
+{
+  vSemaphoreDelete(sobj);
+  return 1;
+}
+
+/**
+  * @brief  lock the volume on entering a file function. a mutex gives
+  *         priority inheritance to the task holding the volume.
+  * @param  sobj: mutex of the volume
+  * @retval 1: got the volume, 0: timeout, the function fails with FR_TIMEOUT
+  */
+int ff_req_grant(FF_SYNC_t sobj)
+{
+  return (int)(xSemaphoreTake(sobj, FF_FS_TIMEOUT) == pdTRUE);
+}
+
+/**
+  * @brief  unlock the volume on leaving a file function
+  * @param  sobj: mutex of the volume
+  * @retval none
+  */
+void ff_rel_grant(FF_SYNC_t sobj)
+{
+  xSemaphoreGive(sobj);
+}
+
+#endif
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
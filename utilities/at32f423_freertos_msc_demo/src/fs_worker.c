@@ -0,0 +1,274 @@
+/**
+  **************************************************************************
+  * @file     fs_worker.c
+  * @brief    fatfs io worker
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "fs_worker.h"
+#include "queue.h"
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup FreeRTOS_msc_demo
+  * @{
+  */
+
+fs_worker_stats_type fs_worker_stats;
+
+static QueueHandle_t fs_worker_queue;
+static TaskHandle_t fs_worker_handler;
+
+/* syncs deferred to the end of the batch */
+static fs_worker_request_type *fs_worker_sync_list[FS_WORKER_BATCH];
+static uint32_t fs_worker_sync_count;
+
+static void fs_worker_task_function(void *pvParameters);
+
+/**
+  * @brief  create the request queue and the worker task
+  * @param  none
+  * @retval SUCCESS or ERROR
+  */
+error_status fs_worker_init(void)
+{
+  fs_worker_queue = xQueueCreate(FS_WORKER_QUEUE_LENGTH, sizeof(fs_worker_request_type *));
+  if(fs_worker_queue == NULL)
+  {
+    return ERROR;
+  }
+  if(xTaskCreate((TaskFunction_t )fs_worker_task_function,
+                 (const char*    )"fs_worker",
+                 (uint16_t       )FS_WORKER_STACK_SIZE,
+                 (void*          )NULL,
+                 (UBaseType_t    )FS_WORKER_PRIORITY,
+                 (TaskHandle_t*  )&fs_worker_handler) != pdPASS)
+  {
+    return ERROR;
+  }
+  return SUCCESS;
+}
+
+/**
+  * @brief  queue a request without blocking. the calling task gets the
+  *         notify bits set when the request is done.
+  * @param  request: request, must stay valid until it is done
+  * @param  notify: notification bits of the request
+  * @retval SUCCESS or ERROR when the queue is full
+  */
+error_status fs_worker_submit(fs_worker_request_type *request, uint32_t notify)
+{
+  request->task = xTaskGetCurrentTaskHandle();
+  request->notify = notify;
+  request->done = 0;
+  request->result = FR_OK;
+  if(xQueueSend(fs_worker_queue, &request, 0) != pdPASS)
+  {
+    fs_worker_stats.rejected++;
+    return ERROR;
+  }
+  return SUCCESS;
+}
+
+/**
+  * @brief  take the completed requests among notify without blocking
+  * @param  notify: notification bits to check
+  * @retval bits of the completed requests
+  */
+uint32_t fs_worker_poll(uint32_t notify)
+{
+  return ulTaskNotifyValueClear(NULL, notify) & notify;
+}
+
+/**
+  * @brief  wait until at least one request among notify is done
+  * @param  notify: notification bits to wait for
+  * @param  timeout: ticks to wait
+  * @retval bits of the completed requests, 0 on timeout
+  */
+uint32_t fs_worker_wait(uint32_t notify, TickType_t timeout)
+{
+  TimeOut_t time_out;
+  uint32_t done;
+
+  vTaskSetTimeOutState(&time_out);
+  done = fs_worker_poll(notify);
+  while(done == 0)
+  {
+    if(xTaskCheckForTimeOut(&time_out, &timeout) != pdFALSE)
+    {
+      break;
+    }
+    /* wakes on any notification, other bits are left for later polls */
+    xTaskNotifyWait(0, 0, NULL, timeout);
+    done = fs_worker_poll(notify);
+  }
+  return done;
+}
+
+/**
+  * @brief  finish a request and notify its task
+  * @param  request: request
+  * @param  result: result of the operation
+  * @retval none
+  */
+static void fs_worker_complete(fs_worker_request_type *request, FRESULT result)
+{
+  request->result = result;
+  xTaskNotify(request->task, request->notify, eSetBits);
+}
+
+/**
+  * @brief  run the deferred syncs, one f_sync per file
+  * @param  none
+  * @retval none
+  */
+static void fs_worker_sync_flush(void)
+{
+  uint32_t i, j;
+  FRESULT res;
+
+  for(i = 0; i < fs_worker_sync_count; i++)
+  {
+    if(fs_worker_sync_list[i] == NULL)
+    {
+      continue;
+    }
+    res = f_sync(fs_worker_sync_list[i]->file);
+    for(j = i + 1; j < fs_worker_sync_count; j++)
+    {
+      if(fs_worker_sync_list[j] != NULL && fs_worker_sync_list[j]->file == fs_worker_sync_list[i]->file)
+      {
+        fs_worker_complete(fs_worker_sync_list[j], res);
+        fs_worker_sync_list[j] = NULL;
+        fs_worker_stats.syncs_saved++;
+      }
+    }
+    fs_worker_complete(fs_worker_sync_list[i], res);
+  }
+  fs_worker_sync_count = 0;
+}
+
+/**
+  * @brief  serve a write, together with the following writes of the batch
+  *         whose buffers continue this one in memory, in one f_write
+  * @param  batch: requests of the batch
+  * @param  index: index of the write
+  * @param  count: number of requests in the batch
+  * @retval index of the last request served
+  */
+static uint32_t fs_worker_write(fs_worker_request_type **batch, uint32_t index, uint32_t count)
+{
+  fs_worker_request_type *request = batch[index];
+  uint32_t last = index;
+  UINT len = request->len;
+  UINT done, n;
+  FRESULT res;
+
+  while(last + 1 < count && batch[last + 1]->op == FS_WORKER_WRITE &&
+        batch[last + 1]->file == request->file &&
+        (uint8_t *)request->buffer + len == (uint8_t *)batch[last + 1]->buffer)
+  {
+    last++;
+    len += batch[last]->len;
+    fs_worker_stats.merged++;
+  }
+
+  res = f_write(request->file, request->buffer, len, &done);
+
+  /* share the transferred bytes out in order */
+  for(; index <= last; index++)
+  {
+    n = (done < batch[index]->len) ? done : batch[index]->len;
+    batch[index]->done = n;
+    done -= n;
+    fs_worker_complete(batch[index], res);
+  }
+  return last;
+}
+
+/**
+  * @brief  worker task, serves the queued requests in batches
+  * @param  pvParameters: not used
+  * @retval none
+  */
+static void fs_worker_task_function(void *pvParameters)
+{
+  fs_worker_request_type *batch[FS_WORKER_BATCH];
+  fs_worker_request_type *request;
+  uint32_t count, i;
+  FRESULT res;
+  UINT done;
+
+  while(1)
+  {
+    xQueueReceive(fs_worker_queue, &batch[0], portMAX_DELAY);
+    count = 1;
+    while(count < FS_WORKER_BATCH && xQueueReceive(fs_worker_queue, &batch[count], 0) == pdPASS)
+    {
+      count++;
+    }
+    fs_worker_stats.batches++;
+    fs_worker_stats.requests += count;
+
+    for(i = 0; i < count; i++)
+    {
+      request = batch[i];
+      switch(request->op)
+      {
+        case FS_WORKER_WRITE:
+          i = fs_worker_write(batch, i, count);
+          break;
+        case FS_WORKER_READ:
+          res = f_read(request->file, request->buffer, request->len, &done);
+          request->done = done;
+          fs_worker_complete(request, res);
+          break;
+        case FS_WORKER_SYNC:
+          /* later writes of the batch are covered by the same sync */
+          fs_worker_sync_list[fs_worker_sync_count++] = request;
+          break;
+        case FS_WORKER_OPEN:
+          fs_worker_sync_flush();
+          fs_worker_complete(request, f_open(request->file, request->path, request->mode));
+          break;
+        case FS_WORKER_CLOSE:
+          fs_worker_sync_flush();
+          fs_worker_complete(request, f_close(request->file));
+          break;
+        default:
+          fs_worker_complete(request, FR_INVALID_PARAMETER);
+          break;
+      }
+    }
+    fs_worker_sync_flush();
+  }
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,565 @@
+/**
+  **************************************************************************
+  * @file     main.c
+  * @brief    main program
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include <stdio.h>
+#include <string.h>
+#include "at32f423_board.h"
+#include "at32f423_clock.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "usb_conf.h"
+#include "usb_core.h"
+#include "usbh_int.h"
+#include "usbh_user.h"
+#include "usbh_msc_class.h"
+#include "ff.h"
+#include "fs_worker.h"
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup FreeRTOS_msc_demo
+  * @{
+  */
+
+/* bytes of one log record */
+#define LOG_RECORD_SIZE                  32
+/* bytes of one log buffer, two buffers per logger */
+#define LOG_BUFFER_SIZE                  1024
+/* records written by each logger */
+#define LOG_RECORDS                      4096
+/* records between two f_sync requests */
+#define LOG_SYNC_RECORDS                 512
+
+/* notification bits of the logger requests */
+#define LOG_NOTIFY_BUFFER0               (1 << 0)
+#define LOG_NOTIFY_BUFFER1               (1 << 1)
+#define LOG_NOTIFY_CONTROL               (1 << 2)
+
+/**
+  * @brief logger context, the two buffers are adjacent so back to back
+  *        writes of a logger can be merged by the worker
+  */
+typedef struct
+{
+  const TCHAR                            *path;
+  FIL                                    file;
+  uint8_t                                buffer[2][LOG_BUFFER_SIZE];
+  fs_worker_request_type                 request[2];
+  fs_worker_request_type                 control;
+  uint8_t                                busy[2];
+  uint8_t                                control_busy;
+  uint8_t                                active;
+  uint32_t                               fill;
+  uint32_t                               records;
+  uint32_t                               lost;
+  uint32_t                               errors;
+} logger_type;
+
+/* usb global struct define */
+otg_core_type otg_core_struct;
+SemaphoreHandle_t usb_host_mutex;
+
+FATFS fs;
+logger_type logger[2] =
+{
+  {.path = "0:LOG0.TXT"},
+  {.path = "0:LOG1.TXT"},
+};
+
+TaskHandle_t usb_host_handler;
+TaskHandle_t logger_handler[2];
+TaskHandle_t stat_handler;
+
+void usb_clock48m_select(usb_clk48_s clk_s);
+void usb_gpio_config(void);
+void usb_low_power_wakeup_config(void);
+
+/* usb host task */
+void usb_host_task_function(void *pvParameters);
+/* logger task */
+void logger_task_function(void *pvParameters);
+/* statistics task */
+void stat_task_function(void *pvParameters);
+
+/**
+  * @brief  main function.
+  * @param  none
+  * @retval none
+  */
+int main(void)
+{
+  nvic_priority_group_config(NVIC_PRIORITY_GROUP_4);
+
+  system_clock_config();
+
+  at32_board_init();
+
+  /* the cycle counter times usb_delay_us, systick belongs to the kernel */
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  /* usb gpio config */
+  usb_gpio_config();
+
+#ifdef USB_LOW_POWER_WAKUP
+  usb_low_power_wakeup_config();
+#endif
+
+  uart_print_init(115200);
+
+  /* enable otgfs clock */
+  crm_periph_clock_enable(OTG_CLOCK, TRUE);
+
+  /* select usb 48m clcok source */
+  usb_clock48m_select(USB_CLK_HEXT);
+
+  /* enable otgfs irq, the handler makes no kernel calls */
+  nvic_irq_enable(OTG_IRQ, 0, 0);
+
+  usb_host_mutex = xSemaphoreCreateMutex();
+  if(usb_host_mutex == NULL)
+  {
+    printf("USB host mutex could not be created.\r\n");
+  }
+
+  /* init usb */
+  usbh_init(&otg_core_struct,
+            USB_FULL_SPEED_CORE_ID,
+            USB_ID,
+            &uhost_msc_class_handler,
+            &usbh_user_handle);
+
+  /* the volume is mounted on first access, after the device is ready */
+  f_mount(&fs, "", 0);
+
+  if(fs_worker_init() != SUCCESS)
+  {
+    printf("File system worker could not be created.\r\n");
+  }
+
+  /* enter critical */
+  taskENTER_CRITICAL();
+
+  /* create usb host task */
+  if(xTaskCreate((TaskFunction_t )usb_host_task_function,
+                 (const char*    )"USB_host_task",
+                 (uint16_t       )512,
+                 (void*          )NULL,
+                 (UBaseType_t    )3,
+                 (TaskHandle_t*  )&usb_host_handler) != pdPASS)
+  {
+    printf("USB host task could not be created as there was insufficient heap memory remaining.\r\n");
+  }
+  /* create logger tasks */
+  if(xTaskCreate((TaskFunction_t )logger_task_function,
+                 (const char*    )"Logger0_task",
+                 (uint16_t       )384,
+                 (void*          )&logger[0],
+                 (UBaseType_t    )1,
+                 (TaskHandle_t*  )&logger_handler[0]) != pdPASS)
+  {
+    printf("Logger0 task could not be created as there was insufficient heap memory remaining.\r\n");
+  }
+  if(xTaskCreate((TaskFunction_t )logger_task_function,
+                 (const char*    )"Logger1_task",
+                 (uint16_t       )384,
+                 (void*          )&logger[1],
+                 (UBaseType_t    )1,
+                 (TaskHandle_t*  )&logger_handler[1]) != pdPASS)
+  {
+    printf("Logger1 task could not be created as there was insufficient heap memory remaining.\r\n");
+  }
+  /* create statistics task */
+  if(xTaskCreate((TaskFunction_t )stat_task_function,
+                 (const char*    )"Stat_task",
+                 (uint16_t       )384,
+                 (void*          )NULL,
+                 (UBaseType_t    )1,
+                 (TaskHandle_t*  )&stat_handler) != pdPASS)
+  {
+    printf("Stat task could not be created as there was insufficient heap memory remaining.\r\n");
+  }
+
+  /* exit critical */
+  taskEXIT_CRITICAL();
+
+  /* start scheduler */
+  vTaskStartScheduler();
+}
+
+/* usb host task function, the host core is only touched under usb_host_mutex */
+void usb_host_task_function(void *pvParameters)
+{
+  while(1)
+  {
+    xSemaphoreTake(usb_host_mutex, portMAX_DELAY);
+    usbh_loop_handler(&otg_core_struct.host);
+    xSemaphoreGive(usb_host_mutex);
+    vTaskDelay(1);
+  }
+}
+
+/**
+  * @brief  collect the finished requests of a logger
+  * @param  log: logger
+  * @param  done: completed notification bits
+  * @retval none
+  */
+static void logger_collect(logger_type *log, uint32_t done)
+{
+  uint32_t i;
+
+  for(i = 0; i < 2; i ++)
+  {
+    if(done & (LOG_NOTIFY_BUFFER0 << i))
+    {
+      if(log->request[i].result != FR_OK || log->request[i].done != log->request[i].len)
+      {
+        log->errors++;
+      }
+      log->busy[i] = 0;
+    }
+  }
+  if(done & LOG_NOTIFY_CONTROL)
+  {
+    if(log->control.result != FR_OK)
+    {
+      log->errors++;
+    }
+    log->control_busy = 0;
+  }
+}
+
+/**
+  * @brief  run a control request of a logger and wait for its completion
+  * @param  log: logger
+  * @param  op: FS_WORKER_OPEN, FS_WORKER_CLOSE or FS_WORKER_SYNC
+  * @retval result of the request
+  */
+static FRESULT logger_control(logger_type *log, fs_worker_op_type op)
+{
+  log->control.op = op;
+  log->control.file = &log->file;
+  log->control.path = log->path;
+  log->control.mode = FA_CREATE_ALWAYS | FA_WRITE;
+  while(fs_worker_submit(&log->control, LOG_NOTIFY_CONTROL) != SUCCESS)
+  {
+    vTaskDelay(1);
+  }
+  logger_collect(log, fs_worker_wait(LOG_NOTIFY_CONTROL, portMAX_DELAY));
+  return log->control.result;
+}
+
+/* logger task function, records are produced every tick and never wait for
+   the file system, a record is lost when both buffers are still in flight */
+void logger_task_function(void *pvParameters)
+{
+  logger_type *log = (logger_type *)pvParameters;
+  char line[LOG_RECORD_SIZE + 1];
+  uint32_t index;
+
+  while(usbh_user_ready == 0)
+  {
+    vTaskDelay(100);
+  }
+
+  if(logger_control(log, FS_WORKER_OPEN) != FR_OK)
+  {
+    printf("%s open failed\r\n", log->path);
+    vTaskDelete(NULL);
+  }
+
+  for(index = 0; index < LOG_RECORDS; index ++)
+  {
+    logger_collect(log, fs_worker_poll(LOG_NOTIFY_BUFFER0 | LOG_NOTIFY_BUFFER1 | LOG_NOTIFY_CONTROL));
+
+    if(log->busy[log->active])
+    {
+      log->lost++;
+    }
+    else
+    {
+      snprintf(line, sizeof(line), "%-10u %-10u %-9u\r\n",
+               (unsigned int)index, (unsigned int)xTaskGetTickCount(), (unsigned int)log->lost);
+      memcpy(&log->buffer[log->active][log->fill], line, LOG_RECORD_SIZE);
+      log->fill += LOG_RECORD_SIZE;
+      log->records++;
+
+      if(log->fill == LOG_BUFFER_SIZE)
+      {
+        fs_worker_request_type *request = &log->request[log->active];
+
+        request->op = FS_WORKER_WRITE;
+        request->file = &log->file;
+        request->buffer = log->buffer[log->active];
+        request->len = LOG_BUFFER_SIZE;
+        if(fs_worker_submit(request, LOG_NOTIFY_BUFFER0 << log->active) == SUCCESS)
+        {
+          log->busy[log->active] = 1;
+        }
+        else
+        {
+          /* queue full, the buffer is dropped rather than blocking */
+          log->lost += LOG_BUFFER_SIZE / LOG_RECORD_SIZE;
+          log->records -= LOG_BUFFER_SIZE / LOG_RECORD_SIZE;
+        }
+        log->fill = 0;
+        log->active ^= 1;
+      }
+    }
+
+    /* periodic sync, skipped while the previous one is still pending */
+    if((index + 1) % LOG_SYNC_RECORDS == 0 && log->control_busy == 0)
+    {
+      log->control.op = FS_WORKER_SYNC;
+      log->control.file = &log->file;
+      if(fs_worker_submit(&log->control, LOG_NOTIFY_CONTROL) == SUCCESS)
+      {
+        log->control_busy = 1;
+      }
+    }
+
+    vTaskDelay(1);
+  }
+
+  /* drain the requests in flight before the file is closed */
+  while(log->busy[0] || log->busy[1] || log->control_busy)
+  {
+    logger_collect(log, fs_worker_wait(LOG_NOTIFY_BUFFER0 | LOG_NOTIFY_BUFFER1 | LOG_NOTIFY_CONTROL, portMAX_DELAY));
+  }
+  logger_control(log, FS_WORKER_CLOSE);
+
+  printf("%s: %u records, %u lost, %u errors\r\n", log->path,
+         (unsigned int)log->records, (unsigned int)log->lost, (unsigned int)log->errors);
+  vTaskDelete(NULL);
+}
+
+/* statistics task function, calls f_getfree directly next to the worker */
+void stat_task_function(void *pvParameters)
+{
+  DWORD free_clst;
+  FATFS *pfs;
+
+  while(1)
+  {
+    at32_led_toggle(LED2);
+    vTaskDelay(2000);
+    if(usbh_user_ready == 0)
+    {
+      continue;
+    }
+    if(f_getfree("", &free_clst, &pfs) == FR_OK)
+    {
+      printf("free %u clusters, requests %u, batches %u, merged %u, syncs saved %u, rejected %u\r\n",
+             (unsigned int)free_clst,
+             (unsigned int)fs_worker_stats.requests,
+             (unsigned int)fs_worker_stats.batches,
+             (unsigned int)fs_worker_stats.merged,
+             (unsigned int)fs_worker_stats.syncs_saved,
+             (unsigned int)fs_worker_stats.rejected);
+    }
+  }
+}
+
+/**
+  * @brief  usb 48M clock select
+  * @param  clk_s:USB_CLK_HICK, USB_CLK_HEXT
+  * @retval none
+  */
+void usb_clock48m_select(usb_clk48_s clk_s)
+{
+  crm_clocks_freq_type clocks_struct;
+  
+  if(clk_s == USB_CLK_HICK)
+  {
+    crm_usb_clock_source_select(CRM_USB_CLOCK_SOURCE_HICK);
+
+    /* enable the acc calibration ready interrupt */
+    crm_periph_clock_enable(CRM_ACC_PERIPH_CLOCK, TRUE);
+
+    /* update the c1\c2\c3 value */
+    acc_write_c1(7980);
+    acc_write_c2(8000);
+    acc_write_c3(8020);
+
+    /* open acc calibration */
+    acc_calibration_mode_enable(ACC_CAL_HICKTRIM, TRUE);
+  }
+  else
+  {
+    crm_clocks_freq_get(&clocks_struct);
+    switch(clocks_struct.sclk_freq)
+    {
+      /* 48MHz */
+      case 48000000:
+        crm_usb_clock_div_set(CRM_USB_DIV_2);
+        break;
+
+      /* 72MHz */
+      case 72000000:
+        crm_usb_clock_div_set(CRM_USB_DIV_3);
+        break;
+
+      /* 96MHz */
+      case 96000000:
+        crm_usb_clock_div_set(CRM_USB_DIV_4);
+        break;
+
+      /* 120MHz */
+      case 120000000:
+        crm_usb_clock_div_set(CRM_USB_DIV_5);
+        break;
+      
+      /* 144MHz */
+      case 144000000:
+        crm_usb_clock_div_set(CRM_USB_DIV_6);
+        break;
+
+      default:
+        break;
+
+    }
+  }
+}
+
+/**
+  * @brief  this function config gpio.
+  * @param  none
+  * @retval none
+  */
+void usb_gpio_config(void)
+{
+  gpio_init_type gpio_init_struct;
+
+  crm_periph_clock_enable(OTG_PIN_GPIO_CLOCK, TRUE);
+  gpio_default_para_init(&gpio_init_struct);
+
+  gpio_init_struct.gpio_drive_strength = GPIO_DRIVE_STRENGTH_STRONGER;
+  gpio_init_struct.gpio_out_type  = GPIO_OUTPUT_PUSH_PULL;
+  gpio_init_struct.gpio_mode = GPIO_MODE_MUX;
+  gpio_init_struct.gpio_pull = GPIO_PULL_NONE;
+
+#ifdef USB_SOF_OUTPUT_ENABLE
+  crm_periph_clock_enable(OTG_PIN_SOF_GPIO_CLOCK, TRUE);
+  gpio_init_struct.gpio_pins = OTG_PIN_SOF;
+  gpio_init(OTG_PIN_SOF_GPIO, &gpio_init_struct);
+  gpio_pin_mux_config(OTG_PIN_GPIO, OTG_PIN_SOF_SOURCE, OTG_PIN_MUX);
+#endif
+
+  /* otgfs use vbus pin */
+#ifndef USB_VBUS_IGNORE
+  gpio_init_struct.gpio_pins = OTG_PIN_VBUS;
+  gpio_init_struct.gpio_pull = GPIO_PULL_DOWN;
+  gpio_pin_mux_config(OTG_PIN_GPIO, OTG_PIN_VBUS_SOURCE, OTG_PIN_MUX);
+  gpio_init(OTG_PIN_GPIO, &gpio_init_struct);
+#endif
+
+}
+#ifdef USB_LOW_POWER_WAKUP
+/**
+  * @brief  usb low power wakeup interrupt config
+  * @param  none
+  * @retval none
+  */
+void usb_low_power_wakeup_config(void)
+{
+  exint_init_type exint_init_struct;
+
+  crm_periph_clock_enable(CRM_SCFG_PERIPH_CLOCK, TRUE);
+  exint_default_para_init(&exint_init_struct);
+
+  exint_init_struct.line_enable = TRUE;
+  exint_init_struct.line_mode = EXINT_LINE_INTERRUPT;
+  exint_init_struct.line_select = OTG_WKUP_EXINT_LINE;
+  exint_init_struct.line_polarity = EXINT_TRIGGER_RISING_EDGE;
+  exint_init(&exint_init_struct);
+
+  nvic_irq_enable(OTG_WKUP_IRQ, 0, 0);
+}
+
+/**
+  * @brief  this function handles otgfs wakup interrupt.
+  * @param  none
+  * @retval none
+  */
+void OTG_WKUP_HANDLER(void)
+{
+  exint_flag_clear(OTG_WKUP_EXINT_LINE);
+}
+
+#endif
+
+/**
+  * @brief  this function handles otgfs interrupt.
+  * @param  none
+  * @retval none
+  */
+void OTG_IRQ_HANDLER(void)
+{
+  usbh_irq_handler(&otg_core_struct);
+}
+
+/**
+  * @brief  usb delay millisecond function.
+  * @param  ms: number of millisecond delay
+  * @retval none
+  */
+void usb_delay_ms(uint32_t ms)
+{
+  /* the board delay_ms reprograms systick, sleep on the kernel tick instead */
+  if(xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)
+  {
+    vTaskDelay(pdMS_TO_TICKS(ms) ? pdMS_TO_TICKS(ms) : 1);
+  }
+  else
+  {
+    usb_delay_us(ms * 1000);
+  }
+}
+
+/**
+  * @brief  usb delay microsecond function.
+  * @param  us: number of microsecond delay
+  * @retval none
+  */
+void usb_delay_us(uint32_t us)
+{
+  uint32_t start = DWT->CYCCNT;
+  uint32_t cycles = us * (system_core_clock / 1000000);
+
+  while((DWT->CYCCNT - start) < cycles);
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,263 @@
+/**
+  **************************************************************************
+  * @file     usbh_msc_diskio.c
+  * @brief    usb mass storage disk io
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+#include "ff.h"      /* Obtains integer types */
+#include "diskio.h"    /* Declarations of disk functions */
+#include "usb_core.h"
+#include "usbh_msc_class.h"
+#include "usbh_user.h"
+#include <string.h>
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup FreeRTOS_msc_demo
+  * @{
+  */
+
+extern otg_core_type otg_core_struct;
+
+/* single sector writes to consecutive sectors are gathered and sent to the
+   device as one multi-sector transfer, 0 disables the gathering */
+#ifndef DISKIO_GATHER_SECTORS
+#define DISKIO_GATHER_SECTORS  8
+#endif
+
+#if DISKIO_GATHER_SECTORS
+static uint32_t gather_buffer[DISKIO_GATHER_SECTORS * FF_MAX_SS / 4];
+static LBA_t gather_sector;
+static UINT gather_count;
+static BYTE gather_pdrv;
+
+/**
+  * @brief  write the gathered sectors, called with usb_host_mutex held.
+  *         on a failure the sectors stay gathered and are written again
+  *         by the next flush.
+  * @param  none
+  * @retval DRESULT
+  */
+static DRESULT gather_flush(void)
+{
+  usb_sts_type status;
+
+  if(gather_count == 0)
+    return RES_OK;
+
+  status = usbh_msc_write(&otg_core_struct.host, gather_sector, gather_count, (uint8_t *)gather_buffer, gather_pdrv);
+  if(status == USB_OK)
+  {
+    gather_count = 0;
+    return RES_OK;
+  }
+
+  return RES_ERROR;
+}
+#endif
+
+/* Definitions of physical drive number for each drive */
+#define DEV_RAM    0  /* Example: Map Ramdisk to physical drive 0 */
+#define DEV_MMC    1  /* Example: Map MMC/SD card to physical drive 1 */
+#define DEV_USB    2  /* Example: Map USB MSD to physical drive 2 */
+
+
+/*-----------------------------------------------------------------------*/
+/* Get Drive Status                                                      */
+/*-----------------------------------------------------------------------*/
+
+DSTATUS disk_status (
+  BYTE pdrv    /* Physical drive nmuber to identify the drive */
+)
+{
+  if(usbh_msc_is_ready(&otg_core_struct.host, pdrv) == MSC_OK)
+  {
+    return RES_OK;
+  }
+
+  return RES_ERROR;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Inidialize a Drive                                                    */
+/*-----------------------------------------------------------------------*/
+
+DSTATUS disk_initialize (
+  BYTE pdrv        /* Physical drive nmuber to identify the drive */
+)
+{
+  return RES_OK;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Read Sector(s)                                                        */
+/*-----------------------------------------------------------------------*/
+DRESULT disk_read (
+  BYTE pdrv,    /* Physical drive nmuber to identify the drive */
+  BYTE *buff,    /* Data buffer to store read data */
+  LBA_t sector,  /* Start sector in LBA */
+  UINT count    /* Number of sectors to read */
+)
+{
+  usb_sts_type status;
+
+  xSemaphoreTake(usb_host_mutex, portMAX_DELAY);
+#if DISKIO_GATHER_SECTORS
+  /* the gathered sectors must reach the device before they are read back */
+  if(gather_count != 0 && pdrv == gather_pdrv &&
+     sector < gather_sector + gather_count && gather_sector < sector + count)
+  {
+    if(gather_flush() != RES_OK)
+    {
+      xSemaphoreGive(usb_host_mutex);
+      return RES_ERROR;
+    }
+  }
+#endif
+  status = usbh_msc_read(&otg_core_struct.host, sector, count, buff, pdrv);
+  xSemaphoreGive(usb_host_mutex);
+
+  if(status == USB_OK)
+    return RES_OK;
+
+  return RES_ERROR;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Write Sector(s)                                                       */
+/*-----------------------------------------------------------------------*/
+
+#if FF_FS_READONLY == 0
+
+DRESULT disk_write (
+  BYTE pdrv,      /* Physical drive nmuber to identify the drive */
+  const BYTE *buff,  /* Data to be written */
+  LBA_t sector,    /* Start sector in LBA */
+  UINT count      /* Number of sectors to write */
+)
+{
+  usb_sts_type status = USB_OK;
+  DRESULT res = RES_OK;
+
+  xSemaphoreTake(usb_host_mutex, portMAX_DELAY);
+#if DISKIO_GATHER_SECTORS
+  if(count == 1)
+  {
+    /* a sector that does not follow the gathered ones starts a new run */
+    if(gather_count != 0 && (pdrv != gather_pdrv || sector != gather_sector + gather_count ||
+                             gather_count == DISKIO_GATHER_SECTORS))
+    {
+      res = gather_flush();
+    }
+
+    /* the new sector is not taken while the gathered ones are not written */
+    if(res == RES_OK)
+    {
+      if(gather_count == 0)
+      {
+        gather_sector = sector;
+        gather_pdrv = pdrv;
+      }
+      memcpy((uint8_t *)gather_buffer + gather_count * FF_MAX_SS, buff, FF_MAX_SS);
+      gather_count++;
+    }
+    xSemaphoreGive(usb_host_mutex);
+    return res;
+  }
+  res = gather_flush();
+#endif
+  if(res == RES_OK)
+  {
+    status = usbh_msc_write(&otg_core_struct.host, sector, count, (uint8_t *)buff, pdrv);
+  }
+  xSemaphoreGive(usb_host_mutex);
+
+  if(res == RES_OK && status == USB_OK)
+    return RES_OK;
+
+  return RES_ERROR;
+}
+
+#endif
+
+
+/*-----------------------------------------------------------------------*/
+/* Miscellaneous Functions                                               */
+/*-----------------------------------------------------------------------*/
+
+DRESULT disk_ioctl (
+  BYTE pdrv,    /* Physical drive nmuber (0..) */
+  BYTE cmd,    /* Control code */
+  void *buff    /* Buffer to send/receive control data */
+)
+{
+  usbh_core_type *host = (usbh_core_type *)&otg_core_struct.host;
+  usbh_msc_type *pmsc = (usbh_msc_type *)host->class_handler->pdata;
+  DRESULT res = RES_OK;
+  switch(cmd)
+  {
+    case CTRL_SYNC:
+#if DISKIO_GATHER_SECTORS
+      xSemaphoreTake(usb_host_mutex, portMAX_DELAY);
+      res = gather_flush();
+      xSemaphoreGive(usb_host_mutex);
+#else
+      res = RES_OK;
+#endif
+      break;
+    case GET_SECTOR_COUNT:
+      *(DWORD*)buff = pmsc->l_unit_n[pdrv].capacity.blk_nbr;
+      break;
+    case GET_SECTOR_SIZE:
+      *(DWORD*)buff = pmsc->l_unit_n[pdrv].capacity.blk_size;
+      break;
+    case GET_BLOCK_SIZE:
+      *(DWORD*)buff = pmsc->l_unit_n[pdrv].capacity.blk_size;
+      break;
+    default:
+      res = RES_PARERR;
+  }
+  return res;
+}
+
+/*-----------------------------------------------------------------------*/
+/* get_fattime                                                    */
+/*-----------------------------------------------------------------------*/
+DWORD get_fattime (void)
+{
+ return 0;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
@@ -0,0 +1,42 @@
+/**
+  **************************************************************************
+  * @file     FreeRTOS.h
+  * @brief    host replacement of the kernel header for the disk io test
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* usbh_msc_diskio.c and ffconf.h only use the mutex api, these headers
+   replace the kernel so that the disk io layer builds on the host. the mutex
+   is a counter of diskio_gather_test.c */
+
+#ifndef INC_FREERTOS_H
+#define INC_FREERTOS_H
+
+#include <stdint.h>
+
+typedef long BaseType_t;
+typedef uint32_t TickType_t;
+typedef struct test_mutex_type *SemaphoreHandle_t;
+
+#define portMAX_DELAY                    ((TickType_t)0xffffffffUL)
+#define pdTRUE                           ((BaseType_t)1)
+
+#endif
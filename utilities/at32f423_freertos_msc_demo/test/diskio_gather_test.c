@@ -0,0 +1,307 @@
+/**
+  **************************************************************************
+  * @file     diskio_gather_test.c
+  * @brief    host test of the write gathering of the msc disk io
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* the msc class functions below write to a simulated device with two
+   logical units and record every transfer, they check that the usb host
+   mutex is held. the cases cover consecutive single sector writes sent as
+   one transfer, the runs broken by a gap, another drive or a full buffer,
+   a multi-sector write and a read of a gathered sector sent after the
+   gathered ones, CTRL_SYNC, and a failed transfer that keeps the gathered
+   sectors for the next flush. */
+
+#include "ff.h"
+#include "diskio.h"
+#include "usb_core.h"
+#include "usbh_msc_class.h"
+#include "usbh_user.h"
+#include <stdio.h>
+#include <string.h>
+
+#define DISK_SECTORS                     128
+#define GATHER_SECTORS                   8
+
+#define TEST_CHECK(cond)                 do { if(!(cond)) { printf("  %s:%d: %s\n", __func__, __LINE__, #cond); \
+                                           test_failed ++; } } while(0)
+
+/**
+  * @brief transfer to the simulated device
+  */
+typedef struct
+{
+  uint32_t                               address;
+  uint32_t                               len;
+  uint8_t                                lun;
+  uint8_t                                write;
+} test_transfer_type;
+
+otg_core_type otg_core_struct;
+SemaphoreHandle_t usb_host_mutex;
+
+static usbh_msc_type msc;
+static usbh_class_handler_type msc_handler = {&msc};
+static uint8_t device[USBH_SUPPORT_MAX_LUN][DISK_SECTORS][FF_MAX_SS];
+static test_transfer_type transfer[32];
+static int transfer_count;
+static int write_failures;
+static int mutex_held;
+
+static BYTE sector_data[GATHER_SECTORS + 2][FF_MAX_SS];
+static BYTE read_data[2 * FF_MAX_SS];
+
+static int test_failed;
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xBlockTime)
+{
+  (void)xSemaphore;
+  TEST_CHECK(xBlockTime == portMAX_DELAY && mutex_held == 0);
+  mutex_held ++;
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore)
+{
+  (void)xSemaphore;
+  TEST_CHECK(mutex_held == 1);
+  mutex_held --;
+  return pdTRUE;
+}
+
+msc_error_type usbh_msc_is_ready(void *uhost, uint8_t lun)
+{
+  (void)uhost;
+  return (lun < USBH_SUPPORT_MAX_LUN) ? MSC_OK : MSC_NOT_READY;
+}
+
+static void record(uint32_t address, uint32_t len, uint8_t lun, uint8_t write)
+{
+  TEST_CHECK(mutex_held == 1);
+  TEST_CHECK(lun < USBH_SUPPORT_MAX_LUN && address + len <= DISK_SECTORS);
+  if(transfer_count < (int)(sizeof(transfer) / sizeof(transfer[0])))
+  {
+    transfer[transfer_count].address = address;
+    transfer[transfer_count].len = len;
+    transfer[transfer_count].lun = lun;
+    transfer[transfer_count].write = write;
+  }
+  transfer_count ++;
+}
+
+usb_sts_type usbh_msc_write(void *uhost, uint32_t address, uint32_t len, uint8_t *buffer, uint8_t lun)
+{
+  TEST_CHECK(uhost == &otg_core_struct.host);
+  record(address, len, lun, 1);
+  if(write_failures > 0)
+  {
+    write_failures --;
+    return USB_FAIL;
+  }
+  memcpy(device[lun][address], buffer, len * FF_MAX_SS);
+  return USB_OK;
+}
+
+usb_sts_type usbh_msc_read(void *uhost, uint32_t address, uint32_t len, uint8_t *buffer, uint8_t lun)
+{
+  TEST_CHECK(uhost == &otg_core_struct.host);
+  record(address, len, lun, 0);
+  memcpy(buffer, device[lun][address], len * FF_MAX_SS);
+  return USB_OK;
+}
+
+static void fill(BYTE seed)
+{
+  UINT i, j;
+
+  for(i = 0; i < GATHER_SECTORS + 2; i ++)
+  {
+    for(j = 0; j < FF_MAX_SS; j ++)
+    {
+      sector_data[i][j] = (BYTE)(seed + i * 13 + j);
+    }
+  }
+}
+
+static int check_transfer(int index, uint32_t address, uint32_t len, uint8_t lun, uint8_t write)
+{
+  return index < transfer_count && transfer[index].address == address && transfer[index].len == len &&
+         transfer[index].lun == lun && transfer[index].write == write;
+}
+
+static void reset(void)
+{
+  TEST_CHECK(disk_ioctl(0, CTRL_SYNC, NULL) == RES_OK);
+  transfer_count = 0;
+  write_failures = 0;
+  memset(device, 0, sizeof(device));
+}
+
+static void test_gather(void)
+{
+  UINT i;
+
+  reset();
+  fill(1);
+
+  /* eight consecutive sectors are one transfer, sent when the buffer is full */
+  for(i = 0; i < GATHER_SECTORS; i ++)
+  {
+    TEST_CHECK(disk_write(0, sector_data[i], 10 + i, 1) == RES_OK);
+  }
+  TEST_CHECK(transfer_count == 0);
+  TEST_CHECK(disk_write(0, sector_data[GATHER_SECTORS], 10 + GATHER_SECTORS, 1) == RES_OK);
+  TEST_CHECK(transfer_count == 1 && check_transfer(0, 10, GATHER_SECTORS, 0, 1));
+  TEST_CHECK(memcmp(device[0][10], sector_data, GATHER_SECTORS * FF_MAX_SS) == 0);
+
+  /* the ninth sector goes with the sync */
+  TEST_CHECK(disk_ioctl(0, CTRL_SYNC, NULL) == RES_OK);
+  TEST_CHECK(transfer_count == 2 && check_transfer(1, 10 + GATHER_SECTORS, 1, 0, 1));
+  TEST_CHECK(memcmp(device[0][10 + GATHER_SECTORS], sector_data[GATHER_SECTORS], FF_MAX_SS) == 0);
+  TEST_CHECK(disk_ioctl(0, CTRL_SYNC, NULL) == RES_OK && transfer_count == 2);
+  TEST_CHECK(mutex_held == 0);
+}
+
+static void test_runs(void)
+{
+  reset();
+  fill(2);
+
+  /* a gap */
+  TEST_CHECK(disk_write(0, sector_data[0], 5, 1) == RES_OK);
+  TEST_CHECK(disk_write(0, sector_data[1], 6, 1) == RES_OK);
+  TEST_CHECK(disk_write(0, sector_data[2], 20, 1) == RES_OK);
+  TEST_CHECK(transfer_count == 1 && check_transfer(0, 5, 2, 0, 1));
+
+  /* the same sector again */
+  TEST_CHECK(disk_write(0, sector_data[3], 20, 1) == RES_OK);
+  TEST_CHECK(transfer_count == 2 && check_transfer(1, 20, 1, 0, 1));
+
+  /* another drive */
+  TEST_CHECK(disk_write(1, sector_data[4], 21, 1) == RES_OK);
+  TEST_CHECK(transfer_count == 3 && check_transfer(2, 20, 1, 0, 1));
+  TEST_CHECK(disk_ioctl(1, CTRL_SYNC, NULL) == RES_OK);
+  TEST_CHECK(transfer_count == 4 && check_transfer(3, 21, 1, 1, 1));
+
+  TEST_CHECK(memcmp(device[0][5], sector_data[0], 2 * FF_MAX_SS) == 0);
+  TEST_CHECK(memcmp(device[0][20], sector_data[3], FF_MAX_SS) == 0);
+  TEST_CHECK(memcmp(device[1][21], sector_data[4], FF_MAX_SS) == 0);
+  TEST_CHECK(mutex_held == 0);
+}
+
+static void test_order(void)
+{
+  reset();
+  fill(3);
+
+  /* a multi-sector write over a gathered sector lands after it */
+  TEST_CHECK(disk_write(0, sector_data[0], 30, 1) == RES_OK);
+  TEST_CHECK(disk_write(0, sector_data[1], 30, 2) == RES_OK);
+  TEST_CHECK(transfer_count == 2 && check_transfer(0, 30, 1, 0, 1) && check_transfer(1, 30, 2, 0, 1));
+  TEST_CHECK(memcmp(device[0][30], sector_data[1], 2 * FF_MAX_SS) == 0);
+
+  /* a read next to the gathered sectors leaves them gathered */
+  transfer_count = 0;
+  TEST_CHECK(disk_write(0, sector_data[2], 40, 1) == RES_OK);
+  TEST_CHECK(disk_write(0, sector_data[3], 41, 1) == RES_OK);
+  TEST_CHECK(disk_read(0, read_data, 38, 2) == RES_OK);
+  TEST_CHECK(transfer_count == 1 && check_transfer(0, 38, 2, 0, 0));
+
+  /* a read of a gathered sector gets it from the device */
+  TEST_CHECK(disk_read(0, read_data, 41, 1) == RES_OK);
+  TEST_CHECK(transfer_count == 3 && check_transfer(1, 40, 2, 0, 1) && check_transfer(2, 41, 1, 0, 0));
+  TEST_CHECK(memcmp(read_data, sector_data[3], FF_MAX_SS) == 0);
+  TEST_CHECK(disk_read(0, read_data, 40, 2) == RES_OK && transfer_count == 4);
+  TEST_CHECK(memcmp(read_data, sector_data[2], 2 * FF_MAX_SS) == 0);
+
+  /* the same sector on the other drive is another sector */
+  transfer_count = 0;
+  TEST_CHECK(disk_write(0, sector_data[4], 50, 1) == RES_OK);
+  TEST_CHECK(disk_read(1, read_data, 50, 1) == RES_OK);
+  TEST_CHECK(transfer_count == 1 && check_transfer(0, 50, 1, 1, 0));
+  TEST_CHECK(mutex_held == 0);
+}
+
+static void test_failure(void)
+{
+  reset();
+  fill(4);
+
+  /* a failed flush keeps the gathered sectors and refuses the new one */
+  TEST_CHECK(disk_write(0, sector_data[0], 60, 1) == RES_OK);
+  TEST_CHECK(disk_write(0, sector_data[1], 61, 1) == RES_OK);
+  write_failures = 1;
+  TEST_CHECK(disk_write(0, sector_data[2], 70, 1) == RES_ERROR);
+  TEST_CHECK(transfer_count == 1 && check_transfer(0, 60, 2, 0, 1));
+
+  /* a failed sync keeps them as well */
+  write_failures = 1;
+  TEST_CHECK(disk_ioctl(0, CTRL_SYNC, NULL) == RES_ERROR);
+  TEST_CHECK(transfer_count == 2 && check_transfer(1, 60, 2, 0, 1));
+
+  /* a read of them fails without reading stale data */
+  write_failures = 1;
+  TEST_CHECK(disk_read(0, read_data, 61, 1) == RES_ERROR);
+  TEST_CHECK(transfer_count == 3 && check_transfer(2, 60, 2, 0, 1));
+
+  /* a multi-sector write is not sent before them */
+  write_failures = 1;
+  TEST_CHECK(disk_write(0, sector_data[3], 80, 2) == RES_ERROR);
+  TEST_CHECK(transfer_count == 4 && check_transfer(3, 60, 2, 0, 1));
+
+  /* the next flush writes them */
+  TEST_CHECK(disk_ioctl(0, CTRL_SYNC, NULL) == RES_OK);
+  TEST_CHECK(transfer_count == 5 && check_transfer(4, 60, 2, 0, 1));
+  TEST_CHECK(memcmp(device[0][60], sector_data[0], 2 * FF_MAX_SS) == 0);
+  TEST_CHECK(device[0][70][0] == 0 && device[0][80][0] == 0);
+
+  TEST_CHECK(disk_write(0, sector_data[2], 70, 1) == RES_OK);
+  TEST_CHECK(disk_ioctl(0, CTRL_SYNC, NULL) == RES_OK);
+  TEST_CHECK(memcmp(device[0][70], sector_data[2], FF_MAX_SS) == 0);
+  TEST_CHECK(mutex_held == 0);
+}
+
+static void test_ioctl(void)
+{
+  DWORD value = 0;
+
+  msc.l_unit_n[1].capacity.blk_nbr = 1000;
+  msc.l_unit_n[1].capacity.blk_size = FF_MAX_SS;
+  TEST_CHECK(disk_ioctl(1, GET_SECTOR_COUNT, &value) == RES_OK && value == 1000);
+  TEST_CHECK(disk_ioctl(1, GET_SECTOR_SIZE, &value) == RES_OK && value == FF_MAX_SS);
+  TEST_CHECK(disk_ioctl(1, CTRL_TRIM, &value) == RES_PARERR);
+  TEST_CHECK(disk_status(0) == 0);
+}
+
+int main(void)
+{
+  otg_core_struct.host.class_handler = &msc_handler;
+
+  test_gather();
+  test_runs();
+  test_order();
+  test_failure();
+  test_ioctl();
+
+  printf("%d checks failed\n", test_failed);
+  return test_failed;
+}
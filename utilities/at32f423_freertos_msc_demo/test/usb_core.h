@@ -0,0 +1,55 @@
+/**
+  **************************************************************************
+  * @file     usb_core.h
+  * @brief    host replacement of the usb core header for the disk io test
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* the parts of the otg core the disk io layer reaches: the host and the
+   class data of the msc class */
+
+#ifndef __USB_CORE_H
+#define __USB_CORE_H
+
+#include <stdint.h>
+
+typedef enum
+{
+  USB_OK,
+  USB_FAIL
+} usb_sts_type;
+
+typedef struct
+{
+  void                                   *pdata;
+} usbh_class_handler_type;
+
+typedef struct
+{
+  usbh_class_handler_type                *class_handler;
+} usbh_core_type;
+
+typedef struct
+{
+  usbh_core_type                         host;
+} otg_core_type;
+
+#endif
@@ -0,0 +1,63 @@
+/**
+  **************************************************************************
+  * @file     usbh_msc_class.h
+  * @brief    host replacement of the msc class header for the disk io test
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* the logical units of the simulated device and the msc class functions,
+   implemented by diskio_gather_test.c */
+
+#ifndef __USBH_MSC_CLASS_H
+#define __USBH_MSC_CLASS_H
+
+#include "usb_core.h"
+
+#define USBH_SUPPORT_MAX_LUN             2
+
+typedef enum
+{
+  MSC_OK,
+  MSC_NOT_READY,
+  MSC_ERROR
+} msc_error_type;
+
+typedef struct
+{
+  uint32_t                               blk_nbr;
+  uint32_t                               blk_size;
+} msc_scsi_data_read_capacity10;
+
+typedef struct
+{
+  msc_scsi_data_read_capacity10          capacity;
+} usbh_msc_unit_type;
+
+typedef struct
+{
+  usbh_msc_unit_type                     l_unit_n[USBH_SUPPORT_MAX_LUN];
+} usbh_msc_type;
+
+msc_error_type usbh_msc_is_ready(void *uhost, uint8_t lun);
+usb_sts_type usbh_msc_write(void *uhost, uint32_t address, uint32_t len, uint8_t *buffer, uint8_t lun);
+usb_sts_type usbh_msc_read(void *uhost, uint32_t address, uint32_t len, uint8_t *buffer, uint8_t lun);
+
+#endif
@@ -0,0 +1,156 @@
+/**
+  **************************************************************************
+  * @file     rtos_objects.h
+  * @brief    statically allocated freertos objects header
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* define to prevent recursive inclusion -------------------------------------*/
+#ifndef __RTOS_OBJECTS_H
+#define __RTOS_OBJECTS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* includes ------------------------------------------------------------------*/
+#include "at32f423.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+#include "timers.h"
+#include "rtos_objects_conf.h"
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup FreeRTOS_static_demo
+  * @{
+  */
+
+#if (configSUPPORT_STATIC_ALLOCATION != 1)
+#error "rtos_objects requires configSUPPORT_STATIC_ALLOCATION"
+#endif
+
+#ifndef RTOS_TASK_TABLE
+#define RTOS_TASK_TABLE(X)
+#endif
+
+#ifndef RTOS_QUEUE_TABLE
+#define RTOS_QUEUE_TABLE(X)
+#endif
+
+#ifndef RTOS_SEMAPHORE_TABLE
+#define RTOS_SEMAPHORE_TABLE(X)
+#endif
+
+#ifndef RTOS_STREAM_TABLE
+#define RTOS_STREAM_TABLE(X)
+#endif
+
+#ifndef RTOS_TIMER_TABLE
+#define RTOS_TIMER_TABLE(X)
+#endif
+
+/**
+  * @brief  place a control block, stack or storage area in the zero
+  *         initialized .bss.rtos_objects section, the map file lists the
+  *         section with its size.
+  */
+#if defined ( __ICCARM__ )
+#define RTOS_OBJECT                      _Pragma("location=\".bss.rtos_objects\"")
+#elif defined ( __CC_ARM )
+#define RTOS_OBJECT                      __attribute__((section(".bss.rtos_objects"), zero_init))
+#else
+#define RTOS_OBJECT                      __attribute__((section(".bss.rtos_objects")))
+#endif
+
+/* ram of each kind of object, a stream buffer stores one byte more than its size */
+#define RTOS_TASK_RAM(name, function, stack, priority) \
+  + sizeof(StaticTask_t) + (stack) * sizeof(StackType_t)
+#define RTOS_QUEUE_RAM(name, length, size) \
+  + sizeof(StaticQueue_t) + (length) * (size)
+#define RTOS_SEMAPHORE_RAM(name, type, max, initial) \
+  + sizeof(StaticSemaphore_t)
+#define RTOS_STREAM_RAM(name, size, trigger) \
+  + sizeof(StaticStreamBuffer_t) + (size) + 1
+#define RTOS_TIMER_RAM(name, period, reload, callback) \
+  + sizeof(StaticTimer_t)
+
+#if (configUSE_TIMERS == 1)
+#define RTOS_TIMER_TASK_RAM              (sizeof(StaticTask_t) + configTIMER_TASK_STACK_DEPTH * sizeof(StackType_t))
+#else
+#define RTOS_TIMER_TASK_RAM              0
+#endif
+
+/* bytes of the .bss.rtos_objects section, the idle and timer tasks included */
+#define RTOS_OBJECTS_RAM                 (sizeof(StaticTask_t) + configMINIMAL_STACK_SIZE * sizeof(StackType_t) + \
+                                          RTOS_TIMER_TASK_RAM \
+                                          RTOS_TASK_TABLE(RTOS_TASK_RAM) \
+                                          RTOS_QUEUE_TABLE(RTOS_QUEUE_RAM) \
+                                          RTOS_SEMAPHORE_TABLE(RTOS_SEMAPHORE_RAM) \
+                                          RTOS_STREAM_TABLE(RTOS_STREAM_RAM) \
+                                          RTOS_TIMER_TABLE(RTOS_TIMER_RAM))
+
+/* handles of the table objects */
+#define RTOS_TASK_HANDLE(name, function, stack, priority) extern TaskHandle_t rtos_task_##name;
+#define RTOS_QUEUE_HANDLE(name, length, size) extern QueueHandle_t rtos_queue_##name;
+#define RTOS_SEMAPHORE_HANDLE(name, type, max, initial) extern SemaphoreHandle_t rtos_semaphore_##name;
+#define RTOS_STREAM_HANDLE(name, size, trigger) extern StreamBufferHandle_t rtos_stream_##name;
+#define RTOS_TIMER_HANDLE(name, period, reload, callback) extern TimerHandle_t rtos_timer_##name;
+
+RTOS_TASK_TABLE(RTOS_TASK_HANDLE)
+RTOS_QUEUE_TABLE(RTOS_QUEUE_HANDLE)
+RTOS_SEMAPHORE_TABLE(RTOS_SEMAPHORE_HANDLE)
+RTOS_STREAM_TABLE(RTOS_STREAM_HANDLE)
+RTOS_TIMER_TABLE(RTOS_TIMER_HANDLE)
+
+/**
+  * @brief ram of one object
+  */
+typedef struct
+{
+  const char                             *name;           /*!< name in the table */
+  const char                             *kind;           /*!< task, queue, mutex, ... */
+  uint32_t                               control;         /*!< bytes of the control block */
+  uint32_t                               storage;         /*!< bytes of the stack or storage area */
+} rtos_object_info_type;
+
+error_status rtos_objects_create(void);
+void rtos_objects_report(void);
+void rtos_objects_stack_report(void);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,85 @@
+/**
+  **************************************************************************
+  * @file     rtos_objects_conf.h
+  * @brief    freertos objects of the application
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* define to prevent recursive inclusion -------------------------------------*/
+#ifndef __RTOS_OBJECTS_CONF_H
+#define __RTOS_OBJECTS_CONF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup FreeRTOS_static_demo
+  * @{
+  */
+
+/* ram of the tables below, the build fails when the objects need more */
+#define RTOS_OBJECTS_RAM_LIMIT           (12 * 1024)
+
+/* tasks, X(name, function, stack_words, priority), the handle is rtos_task_<name>
+   and the function is void function(void *pvParameters) */
+#define RTOS_TASK_TABLE(X) \
+  X(producer, producer_task_function, 256, 3) \
+  X(consumer, consumer_task_function, 256, 2) \
+  X(logger,   logger_task_function,   384, 1)
+
+/* queues, X(name, length, item_size), the handle is rtos_queue_<name> */
+#define RTOS_QUEUE_TABLE(X) \
+  X(sample,   16, sizeof(uint32_t))
+
+/* semaphores, X(name, type, max_count, initial_count) with type BINARY,
+   COUNTING or MUTEX, the counts are used by COUNTING only, the handle is
+   rtos_semaphore_<name> */
+#define RTOS_SEMAPHORE_TABLE(X) \
+  X(print,    MUTEX,    0, 0) \
+  X(report,   BINARY,   0, 0) \
+  X(lines,    COUNTING, 8, 8)
+
+/* stream buffers, X(name, size, trigger_level), the handle is rtos_stream_<name> */
+#define RTOS_STREAM_TABLE(X) \
+  X(log,      512, 1)
+
+/* software timers, X(name, period_ms, auto_reload, callback), the callback is
+   void callback(TimerHandle_t xTimer), the handle is rtos_timer_<name> */
+#define RTOS_TIMER_TABLE(X) \
+  X(led,      500, pdTRUE, led_timer_function)
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,159 @@
+/**
+  **************************************************************************
+  * @file     main.c
+  * @brief    main program
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "at32f423_board.h"
+#include "at32f423_clock.h"
+#include "rtos_objects.h"
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup FreeRTOS_static_demo
+  * @{
+  */
+
+#define SAMPLE_INTERVAL_MS               10
+#define SAMPLES_PER_LINE                 50
+/* led timer periods between two stack reports */
+#define REPORT_PERIODS                   20
+
+/**
+  * @brief  main function.
+  * @param  none
+  * @retval none
+  */
+int main(void)
+{
+  system_clock_config();
+
+  nvic_priority_group_config(NVIC_PRIORITY_GROUP_4);
+
+  /* init led2 and led3 */
+  at32_led_init(LED2);
+  at32_led_init(LED3);
+
+  /* init usart1 */
+  uart_print_init(115200);
+
+  /* every object and its memory is fixed at build time, the creation can only
+     fail on a table error */
+  rtos_objects_report();
+  if(rtos_objects_create() != SUCCESS)
+  {
+    printf("rtos objects could not be created, check rtos_objects_conf.h.\r\n");
+    at32_led_on(LED3);
+    while(1);
+  }
+  xTimerStart(rtos_timer_led, 0);
+
+  /* start scheduler */
+  vTaskStartScheduler();
+}
+
+/* producer task function, queues one sample every SAMPLE_INTERVAL_MS */
+void producer_task_function(void *pvParameters)
+{
+  TickType_t wake = xTaskGetTickCount();
+  uint32_t sample = 0;
+
+  while(1)
+  {
+    vTaskDelayUntil(&wake, pdMS_TO_TICKS(SAMPLE_INTERVAL_MS));
+    sample += xTaskGetTickCount() & 0xff;
+    xQueueSend(rtos_queue_sample, &sample, 0);
+  }
+}
+
+/* consumer task function, averages the samples and writes one log line per
+   SAMPLES_PER_LINE samples, a lines token guarantees the room of the line */
+void consumer_task_function(void *pvParameters)
+{
+  char line[48];
+  uint32_t sample, previous = 0, sum = 0, count = 0, lines = 0;
+  int length;
+
+  while(1)
+  {
+    xQueueReceive(rtos_queue_sample, &sample, portMAX_DELAY);
+    sum += sample - previous;
+    previous = sample;
+    if(++count == SAMPLES_PER_LINE)
+    {
+      xSemaphoreTake(rtos_semaphore_lines, portMAX_DELAY);
+      length = sprintf(line, "line %d, average step %d\r\n", ++lines, sum / count);
+      xStreamBufferSend(rtos_stream_log, line, length, portMAX_DELAY);
+      sum = 0;
+      count = 0;
+    }
+  }
+}
+
+/* logger task function, prints the log lines and the stack report */
+void logger_task_function(void *pvParameters)
+{
+  char text[48];
+  size_t length;
+
+  while(1)
+  {
+    length = xStreamBufferReceive(rtos_stream_log, text, sizeof(text) - 1, pdMS_TO_TICKS(100));
+    if(length != 0)
+    {
+      text[length] = 0;
+      xSemaphoreTake(rtos_semaphore_print, portMAX_DELAY);
+      printf("%s", text);
+      xSemaphoreGive(rtos_semaphore_print);
+      xSemaphoreGive(rtos_semaphore_lines);
+    }
+    if(xSemaphoreTake(rtos_semaphore_report, 0) == pdTRUE)
+    {
+      xSemaphoreTake(rtos_semaphore_print, portMAX_DELAY);
+      rtos_objects_stack_report();
+      xSemaphoreGive(rtos_semaphore_print);
+    }
+  }
+}
+
+/* led timer function, runs in the timer service task */
+void led_timer_function(TimerHandle_t xTimer)
+{
+  static uint32_t periods = 0;
+
+  at32_led_toggle(LED2);
+  if(++periods == REPORT_PERIODS)
+  {
+    periods = 0;
+    xSemaphoreGive(rtos_semaphore_report);
+  }
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,248 @@
+/**
+  **************************************************************************
+  * @file     rtos_objects.c
+  * @brief    statically allocated freertos objects
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "rtos_objects.h"
+#include <stdio.h>
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup FreeRTOS_static_demo
+  * @{
+  */
+
+/* the objects of the tables fit in RTOS_OBJECTS_RAM_LIMIT */
+typedef char rtos_objects_ram_check[(RTOS_OBJECTS_RAM <= RTOS_OBJECTS_RAM_LIMIT) ? 1 : -1];
+
+/* task functions and timer callbacks named in the tables */
+#define RTOS_TASK_PROTOTYPE(name, function, stack, priority) void function(void *pvParameters);
+#define RTOS_TIMER_PROTOTYPE(name, period, reload, callback) void callback(TimerHandle_t xTimer);
+
+RTOS_TASK_TABLE(RTOS_TASK_PROTOTYPE)
+RTOS_TIMER_TABLE(RTOS_TIMER_PROTOTYPE)
+
+/* handles, control blocks and storage of the table objects */
+#define RTOS_TASK_STORAGE(name, function, stack, priority) \
+  TaskHandle_t rtos_task_##name; \
+  RTOS_OBJECT static StaticTask_t rtos_task_##name##_tcb; \
+  RTOS_OBJECT static StackType_t rtos_task_##name##_stack[stack];
+#define RTOS_QUEUE_STORAGE(name, length, size) \
+  QueueHandle_t rtos_queue_##name; \
+  RTOS_OBJECT static StaticQueue_t rtos_queue_##name##_control; \
+  RTOS_OBJECT static uint8_t rtos_queue_##name##_storage[(length) * (size)];
+#define RTOS_SEMAPHORE_STORAGE(name, type, max, initial) \
+  SemaphoreHandle_t rtos_semaphore_##name; \
+  RTOS_OBJECT static StaticSemaphore_t rtos_semaphore_##name##_control;
+#define RTOS_STREAM_STORAGE(name, size, trigger) \
+  StreamBufferHandle_t rtos_stream_##name; \
+  RTOS_OBJECT static StaticStreamBuffer_t rtos_stream_##name##_control; \
+  RTOS_OBJECT static uint8_t rtos_stream_##name##_storage[(size) + 1];
+#define RTOS_TIMER_STORAGE(name, period, reload, callback) \
+  TimerHandle_t rtos_timer_##name; \
+  RTOS_OBJECT static StaticTimer_t rtos_timer_##name##_control;
+
+RTOS_TASK_TABLE(RTOS_TASK_STORAGE)
+RTOS_QUEUE_TABLE(RTOS_QUEUE_STORAGE)
+RTOS_SEMAPHORE_TABLE(RTOS_SEMAPHORE_STORAGE)
+RTOS_STREAM_TABLE(RTOS_STREAM_STORAGE)
+RTOS_TIMER_TABLE(RTOS_TIMER_STORAGE)
+
+RTOS_OBJECT static StaticTask_t rtos_idle_tcb;
+RTOS_OBJECT static StackType_t rtos_idle_stack[configMINIMAL_STACK_SIZE];
+
+#if (configUSE_TIMERS == 1)
+RTOS_OBJECT static StaticTask_t rtos_timer_service_tcb;
+RTOS_OBJECT static StackType_t rtos_timer_service_stack[configTIMER_TASK_STACK_DEPTH];
+#endif
+
+/* ram report, one entry per object */
+#define RTOS_TASK_INFO(name, function, stack, priority) \
+  {#name, "task", sizeof(StaticTask_t), (stack) * sizeof(StackType_t)},
+#define RTOS_QUEUE_INFO(name, length, size) \
+  {#name, "queue", sizeof(StaticQueue_t), (length) * (size)},
+#define RTOS_SEMAPHORE_INFO(name, type, max, initial) \
+  {#name, RTOS_SEMAPHORE_KIND_##type, sizeof(StaticSemaphore_t), 0},
+#define RTOS_STREAM_INFO(name, size, trigger) \
+  {#name, "stream", sizeof(StaticStreamBuffer_t), (size) + 1},
+#define RTOS_TIMER_INFO(name, period, reload, callback) \
+  {#name, "timer", sizeof(StaticTimer_t), 0},
+
+#define RTOS_SEMAPHORE_KIND_BINARY       "binary"
+#define RTOS_SEMAPHORE_KIND_COUNTING     "counting"
+#define RTOS_SEMAPHORE_KIND_MUTEX        "mutex"
+
+static const rtos_object_info_type rtos_object_info[] =
+{
+  {"idle", "task", sizeof(StaticTask_t), configMINIMAL_STACK_SIZE * sizeof(StackType_t)},
+#if (configUSE_TIMERS == 1)
+  {"timer service", "task", sizeof(StaticTask_t), configTIMER_TASK_STACK_DEPTH * sizeof(StackType_t)},
+#endif
+  RTOS_TASK_TABLE(RTOS_TASK_INFO)
+  RTOS_QUEUE_TABLE(RTOS_QUEUE_INFO)
+  RTOS_SEMAPHORE_TABLE(RTOS_SEMAPHORE_INFO)
+  RTOS_STREAM_TABLE(RTOS_STREAM_INFO)
+  RTOS_TIMER_TABLE(RTOS_TIMER_INFO)
+  {0, 0, 0, 0}
+};
+
+/* creation of each kind of object, a static create only fails on a null
+   argument, so a failure here is a table error. a stream buffer is given its
+   whole storage area, one byte of it stays free to tell full from empty */
+#define RTOS_TASK_CREATE(name, function, stack, priority) \
+  rtos_task_##name = xTaskCreateStatic(function, #name, stack, NULL, priority, \
+                                       rtos_task_##name##_stack, &rtos_task_##name##_tcb); \
+  if(rtos_task_##name == NULL) \
+  { \
+    status = ERROR; \
+  }
+#define RTOS_QUEUE_CREATE(name, length, size) \
+  rtos_queue_##name = xQueueCreateStatic(length, size, rtos_queue_##name##_storage, \
+                                         &rtos_queue_##name##_control); \
+  if(rtos_queue_##name == NULL) \
+  { \
+    status = ERROR; \
+  }
+#define RTOS_SEMAPHORE_CREATE(name, type, max, initial) \
+  rtos_semaphore_##name = RTOS_SEMAPHORE_CREATE_##type(&rtos_semaphore_##name##_control, max, initial); \
+  if(rtos_semaphore_##name == NULL) \
+  { \
+    status = ERROR; \
+  }
+#define RTOS_STREAM_CREATE(name, size, trigger) \
+  rtos_stream_##name = xStreamBufferCreateStatic((size) + 1, trigger, rtos_stream_##name##_storage, \
+                                                 &rtos_stream_##name##_control); \
+  if(rtos_stream_##name == NULL) \
+  { \
+    status = ERROR; \
+  }
+#define RTOS_TIMER_CREATE(name, period, reload, callback) \
+  rtos_timer_##name = xTimerCreateStatic(#name, pdMS_TO_TICKS(period), reload, NULL, callback, \
+                                         &rtos_timer_##name##_control); \
+  if(rtos_timer_##name == NULL) \
+  { \
+    status = ERROR; \
+  }
+
+#define RTOS_SEMAPHORE_CREATE_BINARY(control, max, initial)   xSemaphoreCreateBinaryStatic(control)
+#define RTOS_SEMAPHORE_CREATE_COUNTING(control, max, initial) xSemaphoreCreateCountingStatic(max, initial, control)
+#define RTOS_SEMAPHORE_CREATE_MUTEX(control, max, initial)    xSemaphoreCreateMutexStatic(control)
+
+/**
+  * @brief  create the objects of the tables in their static storage, the
+  *         timers are created dormant.
+  * @param  none
+  * @retval SUCCESS or ERROR
+  */
+error_status rtos_objects_create(void)
+{
+  error_status status = SUCCESS;
+
+  RTOS_QUEUE_TABLE(RTOS_QUEUE_CREATE)
+  RTOS_SEMAPHORE_TABLE(RTOS_SEMAPHORE_CREATE)
+  RTOS_STREAM_TABLE(RTOS_STREAM_CREATE)
+  RTOS_TIMER_TABLE(RTOS_TIMER_CREATE)
+  RTOS_TASK_TABLE(RTOS_TASK_CREATE)
+
+  return status;
+}
+
+/**
+  * @brief  print the ram of each object and the total of the
+  *         .bss.rtos_objects section.
+  * @param  none
+  * @retval none
+  */
+void rtos_objects_report(void)
+{
+  const rtos_object_info_type *info;
+  uint32_t total = 0;
+
+  printf("rtos objects:\r\n");
+  for(info = rtos_object_info; info->name != 0; info++)
+  {
+    printf("  %-8s %-14s control %4d, storage %5d bytes\r\n", info->kind, info->name,
+           info->control, info->storage);
+    total += info->control + info->storage;
+  }
+  printf("rtos objects %d of %d bytes, no heap\r\n", total, RTOS_OBJECTS_RAM_LIMIT);
+}
+
+#define RTOS_TASK_STACK_REPORT(name, function, stack, priority) \
+  printf("  %-14s %4d of %4d stack words unused\r\n", #name, \
+         (uint32_t)uxTaskGetStackHighWaterMark(rtos_task_##name), stack);
+
+/**
+  * @brief  print the unused stack of the table tasks, the stacks can be
+  *         trimmed to the high water mark plus a margin.
+  * @param  none
+  * @retval none
+  */
+void rtos_objects_stack_report(void)
+{
+  RTOS_TASK_TABLE(RTOS_TASK_STACK_REPORT)
+}
+
+/**
+  * @brief  memory of the idle task, called by vTaskStartScheduler.
+  * @param  ppxIdleTaskTCBBuffer: returns the task control block
+  * @param  ppxIdleTaskStackBuffer: returns the stack
+  * @param  pulIdleTaskStackSize: returns the stack words
+  * @retval none
+  */
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer,
+                                   StackType_t **ppxIdleTaskStackBuffer,
+                                   uint32_t *pulIdleTaskStackSize)
+{
+  *ppxIdleTaskTCBBuffer = &rtos_idle_tcb;
+  *ppxIdleTaskStackBuffer = rtos_idle_stack;
+  *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+#if (configUSE_TIMERS == 1)
+/**
+  * @brief  memory of the timer service task, called by vTaskStartScheduler.
+  * @param  ppxTimerTaskTCBBuffer: returns the task control block
+  * @param  ppxTimerTaskStackBuffer: returns the stack
+  * @param  pulTimerTaskStackSize: returns the stack words
+  * @retval none
+  */
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer,
+                                    StackType_t **ppxTimerTaskStackBuffer,
+                                    uint32_t *pulTimerTaskStackSize)
+{
+  *ppxTimerTaskTCBBuffer = &rtos_timer_service_tcb;
+  *ppxTimerTaskStackBuffer = rtos_timer_service_stack;
+  *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+#endif
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,416 @@
+/**
+  **************************************************************************
+  * @file     rtos_objects_test.c
+  * @brief    host test of the rtos object tables
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* rtos_objects_create runs on the demo tables without the scheduler. the
+   stubs below record the arguments of the static create functions and the
+   control blocks, stacks and storage areas they receive with the sizes the
+   kernel would use, an area declared smaller than the table asks for runs
+   into its neighbour once the shortfall is more than the alignment padding.
+   the cases cover the arguments of each kind of object, the full size of the
+   stream buffers, the idle and timer service task memory, the areas not
+   overlapping and the ram total checked against RTOS_OBJECTS_RAM_LIMIT. */
+
+#include "rtos_objects.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_CHECK(cond)                 do { if(!(cond)) { printf("  %s:%d: %s\n", __func__, __LINE__, #cond); \
+                                           test_failed ++; } } while(0)
+
+#define TEST_OBJECT_MAX                  8
+#define TEST_AREA_MAX                    32
+
+/**
+  * @brief memory handed to the kernel
+  */
+typedef struct
+{
+  const uint8_t                          *start;
+  uint32_t                               size;
+} test_area_type;
+
+/**
+  * @brief arguments of a static create
+  */
+typedef struct
+{
+  const void                             *control;
+  const char                             *name;
+  void                                   *function;
+  uint32_t                               size;
+  uint32_t                               count;
+  uint32_t                               initial;
+  uint8_t                                type;
+} test_object_type;
+
+uint32_t system_core_clock = 150000000;
+
+static test_object_type task_created[TEST_OBJECT_MAX];
+static test_object_type queue_created[TEST_OBJECT_MAX];
+static test_object_type timer_created[TEST_OBJECT_MAX];
+static int task_count;
+static int queue_count;
+static int timer_count;
+static test_area_type area[TEST_AREA_MAX];
+static int area_count;
+
+static int test_failed;
+static int assert_count;
+
+void test_assert_failed(const char *file, int line)
+{
+  printf("  assert %s:%d\n", file, line);
+  assert_count ++;
+}
+
+/* task functions and timer callbacks of the tables, never run */
+void producer_task_function(void *pvParameters)
+{
+  (void)pvParameters;
+}
+
+void consumer_task_function(void *pvParameters)
+{
+  (void)pvParameters;
+}
+
+void logger_task_function(void *pvParameters)
+{
+  (void)pvParameters;
+}
+
+void led_timer_function(TimerHandle_t xTimer)
+{
+  (void)xTimer;
+}
+
+static void test_area(const void *start, uint32_t size)
+{
+  TEST_CHECK(start != NULL && area_count < TEST_AREA_MAX);
+  if(area_count < TEST_AREA_MAX)
+  {
+    area[area_count].start = (const uint8_t *)start;
+    area[area_count].size = size;
+    area_count ++;
+  }
+}
+
+static test_object_type *test_record(test_object_type *list, int *count, const void *control)
+{
+  test_object_type *object;
+
+  TEST_CHECK(*count < TEST_OBJECT_MAX);
+  object = &list[*count % TEST_OBJECT_MAX];
+  (*count) ++;
+  memset(object, 0, sizeof(test_object_type));
+  object->control = control;
+  return object;
+}
+
+static test_object_type *test_find(test_object_type *list, int count, const void *handle)
+{
+  int i;
+
+  for(i = 0; i < count; i ++)
+  {
+    if(list[i].control == handle)
+    {
+      return &list[i];
+    }
+  }
+  return NULL;
+}
+
+TaskHandle_t xTaskCreateStatic(TaskFunction_t pxTaskCode, const char * const pcName, const uint32_t ulStackDepth,
+                               void * const pvParameters, UBaseType_t uxPriority,
+                               StackType_t * const puxStackBuffer, StaticTask_t * const pxTaskBuffer)
+{
+  test_object_type *object = test_record(task_created, &task_count, pxTaskBuffer);
+
+  (void)pvParameters;
+  object->name = pcName;
+  object->function = (void *)pxTaskCode;
+  object->size = ulStackDepth;
+  object->type = (uint8_t)uxPriority;
+  test_area(pxTaskBuffer, sizeof(StaticTask_t));
+  test_area(puxStackBuffer, ulStackDepth * sizeof(StackType_t));
+  return (TaskHandle_t)pxTaskBuffer;
+}
+
+QueueHandle_t xQueueGenericCreateStatic(const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize,
+                                        uint8_t * pucQueueStorage, StaticQueue_t * pxStaticQueue,
+                                        const uint8_t ucQueueType)
+{
+  test_object_type *object = test_record(queue_created, &queue_count, pxStaticQueue);
+
+  object->count = uxQueueLength;
+  object->size = uxItemSize;
+  object->type = ucQueueType;
+  test_area(pxStaticQueue, sizeof(StaticQueue_t));
+  if(uxItemSize != 0)
+  {
+    test_area(pucQueueStorage, uxQueueLength * uxItemSize);
+  }
+  return (QueueHandle_t)pxStaticQueue;
+}
+
+QueueHandle_t xQueueCreateMutexStatic(const uint8_t ucQueueType, StaticQueue_t * pxStaticQueue)
+{
+  return xQueueGenericCreateStatic(1, 0, NULL, pxStaticQueue, ucQueueType);
+}
+
+QueueHandle_t xQueueCreateCountingSemaphoreStatic(const UBaseType_t uxMaxCount, const UBaseType_t uxInitialCount,
+                                                  StaticQueue_t * pxStaticQueue)
+{
+  QueueHandle_t queue = xQueueGenericCreateStatic(uxMaxCount, 0, NULL, pxStaticQueue,
+                                                  queueQUEUE_TYPE_COUNTING_SEMAPHORE);
+
+  queue_created[queue_count - 1].initial = uxInitialCount;
+  return queue;
+}
+
+TimerHandle_t xTimerCreateStatic(const char * const pcTimerName, const TickType_t xTimerPeriodInTicks,
+                                 const UBaseType_t uxAutoReload, void * const pvTimerID,
+                                 TimerCallbackFunction_t pxCallbackFunction, StaticTimer_t * pxTimerBuffer)
+{
+  test_object_type *object = test_record(timer_created, &timer_count, pxTimerBuffer);
+
+  (void)pvTimerID;
+  object->name = pcTimerName;
+  object->function = (void *)pxCallbackFunction;
+  object->size = xTimerPeriodInTicks;
+  object->type = (uint8_t)uxAutoReload;
+  test_area(pxTimerBuffer, sizeof(StaticTimer_t));
+  return (TimerHandle_t)pxTimerBuffer;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t xTask)
+{
+  test_object_type *object = test_find(task_created, task_count, xTask);
+
+  TEST_CHECK(object != NULL);
+  return (object != NULL) ? object->size / 2 : 0;
+}
+
+/* the stream buffers of stream_buffer.c are only used from this thread */
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+  return NULL;
+}
+
+BaseType_t xTaskGenericNotify(TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue,
+                              eNotifyAction eAction, uint32_t *pulPreviousNotificationValue)
+{
+  (void)xTaskToNotify;
+  (void)uxIndexToNotify;
+  (void)ulValue;
+  (void)eAction;
+  (void)pulPreviousNotificationValue;
+  return pdPASS;
+}
+
+BaseType_t xTaskGenericNotifyFromISR(TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue,
+                                     eNotifyAction eAction, uint32_t *pulPreviousNotificationValue,
+                                     BaseType_t *pxHigherPriorityTaskWoken)
+{
+  (void)xTaskToNotify;
+  (void)uxIndexToNotify;
+  (void)ulValue;
+  (void)eAction;
+  (void)pulPreviousNotificationValue;
+  (void)pxHigherPriorityTaskWoken;
+  return pdPASS;
+}
+
+BaseType_t xTaskGenericNotifyWait(UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry,
+                                  uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue,
+                                  TickType_t xTicksToWait)
+{
+  (void)uxIndexToWaitOn;
+  (void)ulBitsToClearOnEntry;
+  (void)ulBitsToClearOnExit;
+  (void)pulNotificationValue;
+  (void)xTicksToWait;
+  return pdFALSE;
+}
+
+BaseType_t xTaskGenericNotifyStateClear(TaskHandle_t xTask, UBaseType_t uxIndexToClear)
+{
+  (void)xTask;
+  (void)uxIndexToClear;
+  return pdTRUE;
+}
+
+void vTaskSetTimeOutState(TimeOut_t * const pxTimeOut)
+{
+  (void)pxTimeOut;
+}
+
+BaseType_t xTaskCheckForTimeOut(TimeOut_t * const pxTimeOut, TickType_t * const pxTicksToWait)
+{
+  (void)pxTimeOut;
+  (void)pxTicksToWait;
+  return pdTRUE;
+}
+
+void vTaskSuspendAll(void)
+{
+}
+
+BaseType_t xTaskResumeAll(void)
+{
+  return pdFALSE;
+}
+
+static void test_create(void)
+{
+  test_object_type *object;
+
+  TEST_CHECK(rtos_objects_create() == SUCCESS);
+  TEST_CHECK(task_count == 3 && queue_count == 4 && timer_count == 1);
+  TEST_CHECK(assert_count == 0);
+
+  object = test_find(task_created, task_count, rtos_task_producer);
+  TEST_CHECK(object != NULL && strcmp(object->name, "producer") == 0);
+  TEST_CHECK(object != NULL && object->function == (void *)producer_task_function);
+  TEST_CHECK(object != NULL && object->size == 256 && object->type == 3);
+  object = test_find(task_created, task_count, rtos_task_consumer);
+  TEST_CHECK(object != NULL && object->function == (void *)consumer_task_function);
+  TEST_CHECK(object != NULL && object->size == 256 && object->type == 2);
+  object = test_find(task_created, task_count, rtos_task_logger);
+  TEST_CHECK(object != NULL && object->function == (void *)logger_task_function);
+  TEST_CHECK(object != NULL && object->size == 384 && object->type == 1);
+
+  object = test_find(queue_created, queue_count, rtos_queue_sample);
+  TEST_CHECK(object != NULL && object->type == queueQUEUE_TYPE_BASE);
+  TEST_CHECK(object != NULL && object->count == 16 && object->size == sizeof(uint32_t));
+  object = test_find(queue_created, queue_count, rtos_semaphore_print);
+  TEST_CHECK(object != NULL && object->type == queueQUEUE_TYPE_MUTEX);
+  object = test_find(queue_created, queue_count, rtos_semaphore_report);
+  TEST_CHECK(object != NULL && object->type == queueQUEUE_TYPE_BINARY_SEMAPHORE && object->count == 1);
+  object = test_find(queue_created, queue_count, rtos_semaphore_lines);
+  TEST_CHECK(object != NULL && object->type == queueQUEUE_TYPE_COUNTING_SEMAPHORE);
+  TEST_CHECK(object != NULL && object->count == 8 && object->initial == 8);
+
+  object = test_find(timer_created, timer_count, rtos_timer_led);
+  TEST_CHECK(object != NULL && strcmp(object->name, "led") == 0);
+  TEST_CHECK(object != NULL && object->function == (void *)led_timer_function);
+  TEST_CHECK(object != NULL && object->size == pdMS_TO_TICKS(500) && object->type == pdTRUE);
+}
+
+static void test_stream(void)
+{
+  static uint8_t data[513];
+  uint32_t i;
+
+  for(i = 0; i < sizeof(data); i ++)
+  {
+    data[i] = (uint8_t)i;
+  }
+
+  /* the 512 bytes of the table fit, not one more */
+  TEST_CHECK(rtos_stream_log != NULL);
+  TEST_CHECK(xStreamBufferSpacesAvailable(rtos_stream_log) == 512);
+  TEST_CHECK(xStreamBufferSend(rtos_stream_log, data, sizeof(data), 0) == 512);
+  TEST_CHECK(xStreamBufferIsFull(rtos_stream_log) == pdTRUE);
+  memset(data, 0, sizeof(data));
+  TEST_CHECK(xStreamBufferReceive(rtos_stream_log, data, sizeof(data), 0) == 512);
+  for(i = 0; i < 512; i ++)
+  {
+    if(data[i] != (uint8_t)i)
+    {
+      break;
+    }
+  }
+  TEST_CHECK(i == 512);
+  TEST_CHECK(assert_count == 0);
+}
+
+static void test_service_tasks(void)
+{
+  StaticTask_t *tcb = NULL;
+  StackType_t *stack = NULL;
+  uint32_t size = 0;
+
+  vApplicationGetIdleTaskMemory(&tcb, &stack, &size);
+  TEST_CHECK(size == configMINIMAL_STACK_SIZE);
+  test_area(tcb, sizeof(StaticTask_t));
+  test_area(stack, size * sizeof(StackType_t));
+
+  tcb = NULL;
+  stack = NULL;
+  size = 0;
+  vApplicationGetTimerTaskMemory(&tcb, &stack, &size);
+  TEST_CHECK(size == configTIMER_TASK_STACK_DEPTH);
+  test_area(tcb, sizeof(StaticTask_t));
+  test_area(stack, size * sizeof(StackType_t));
+}
+
+static void test_areas(void)
+{
+  int i, j;
+
+  /* the stream buffer is not created by a stub */
+  test_area(rtos_stream_log, sizeof(StaticStreamBuffer_t));
+
+  for(i = 0; i < area_count; i ++)
+  {
+    for(j = i + 1; j < area_count; j ++)
+    {
+      TEST_CHECK(area[i].start + area[i].size <= area[j].start ||
+                 area[j].start + area[j].size <= area[i].start);
+    }
+  }
+}
+
+static void test_ram(void)
+{
+  uint32_t ram;
+
+  /* idle, timer service and the three table tasks */
+  ram = 5 * sizeof(StaticTask_t) +
+        (configMINIMAL_STACK_SIZE + configTIMER_TASK_STACK_DEPTH + 256 + 256 + 384) * sizeof(StackType_t);
+  ram += sizeof(StaticQueue_t) + 16 * sizeof(uint32_t);
+  ram += 3 * sizeof(StaticSemaphore_t);
+  ram += sizeof(StaticStreamBuffer_t) + 512 + 1;
+  ram += sizeof(StaticTimer_t);
+  TEST_CHECK(RTOS_OBJECTS_RAM == ram);
+  TEST_CHECK(RTOS_OBJECTS_RAM <= RTOS_OBJECTS_RAM_LIMIT);
+
+  rtos_objects_report();
+  rtos_objects_stack_report();
+}
+
+int main(void)
+{
+  test_create();
+  test_stream();
+  test_service_tasks();
+  test_areas();
+  test_ram();
+
+  printf("%d checks failed\n", test_failed);
+  return test_failed;
+}
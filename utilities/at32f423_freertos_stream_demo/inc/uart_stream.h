@@ -0,0 +1,99 @@
+/**
+  **************************************************************************
+  * @file     uart_stream.h
+  * @brief    uart stream buffer dma header
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* define to prevent recursive inclusion -------------------------------------*/
+#ifndef __UART_STREAM_H
+#define __UART_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* includes ------------------------------------------------------------------*/
+#include "at32f423.h"
+#include "FreeRTOS.h"
+#include "stream_buffer.h"
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup FreeRTOS_stream_demo
+  * @{
+  */
+
+/* storage of the receive and transmit stream buffers */
+#ifndef UART_STREAM_RX_SIZE
+#define UART_STREAM_RX_SIZE              1024
+#endif
+
+#ifndef UART_STREAM_TX_SIZE
+#define UART_STREAM_TX_SIZE              1024
+#endif
+
+/* largest receive dma transfer, the data is committed at least this often */
+#ifndef UART_STREAM_RX_CHUNK
+#define UART_STREAM_RX_CHUNK             128
+#endif
+
+/* preemption priority of the usart2 and dma interrupts, they call freertos
+   api functions so it must not be above configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY */
+#ifndef UART_STREAM_IRQ_PRIORITY
+#define UART_STREAM_IRQ_PRIORITY         5
+#endif
+
+/**
+  * @brief uart stream counters
+  */
+typedef struct
+{
+  uint32_t                               rx_bytes;        /*!< bytes committed to the receive stream buffer */
+  uint32_t                               rx_dropped;      /*!< bytes received while the receive stream buffer was full */
+  uint32_t                               tx_bytes;        /*!< bytes released from the transmit stream buffer */
+  uint32_t                               tx_transfers;    /*!< transmit dma transfers */
+} uart_stream_stats_type;
+
+extern StreamBufferHandle_t uart_stream_rx;
+extern StreamBufferHandle_t uart_stream_tx;
+extern uart_stream_stats_type uart_stream_stats;
+
+error_status uart_stream_init(uint32_t baudrate);
+void uart_stream_tx_start(void);
+void uart_stream_rx_irq_handler(void);
+void uart_stream_tx_irq_handler(void);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,315 @@
+/**
+  **************************************************************************
+  * @file     main.c
+  * @brief    main program
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "at32f423_board.h"
+#include "at32f423_clock.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+#include "uart_stream.h"
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup FreeRTOS_stream_demo
+  * @{
+  */
+
+/* bytes moved through the benchmark stream buffer per chunk size */
+#define BENCH_BYTES                      (16 * 1024)
+#define BENCH_BUFFER_SIZE                1024
+#define BENCH_CHUNK_MAX                  256
+
+TaskHandle_t gateway_handler;
+TaskHandle_t stats_handler;
+
+static const uint16_t bench_chunk[] = {16, 64, 256};
+static uint8_t bench_staging[BENCH_CHUNK_MAX];
+
+/* gateway task */
+void gateway_task_function(void *pvParameters);
+/* stats task */
+void stats_task_function(void *pvParameters);
+
+/**
+  * @brief  main function.
+  * @param  none
+  * @retval none
+  */
+int main(void)
+{
+  system_clock_config();
+
+  nvic_priority_group_config(NVIC_PRIORITY_GROUP_4);
+
+  /* init led2 and led3 */
+  at32_led_init(LED2);
+  at32_led_init(LED3);
+
+  /* init usart1 */
+  uart_print_init(115200);
+
+  /* enter critical */
+  taskENTER_CRITICAL();
+
+  if(uart_stream_init(115200) != SUCCESS)
+  {
+    printf("uart stream buffers could not be created as there was insufficient heap memory remaining.\r\n");
+  }
+
+  /* create gateway task */
+  if(xTaskCreate((TaskFunction_t )gateway_task_function,
+                 (const char*    )"gateway_task",
+                 (uint16_t       )256,
+                 (void*          )NULL,
+                 (UBaseType_t    )2,
+                 (TaskHandle_t*  )&gateway_handler) != pdPASS)
+  {
+    printf("gateway task could not be created as there was insufficient heap memory remaining.\r\n");
+  }
+  else
+  {
+    printf("gateway task was created successfully.\r\n");
+  }
+  /* create stats task, above the gateway so the benchmark runs undisturbed */
+  if(xTaskCreate((TaskFunction_t )stats_task_function,
+                 (const char*    )"stats_task",
+                 (uint16_t       )512,
+                 (void*          )NULL,
+                 (UBaseType_t    )3,
+                 (TaskHandle_t*  )&stats_handler) != pdPASS)
+  {
+    printf("stats task could not be created as there was insufficient heap memory remaining.\r\n");
+  }
+  else
+  {
+    printf("stats task was created successfully.\r\n");
+  }
+
+  /* exit critical */
+  taskEXIT_CRITICAL();
+
+  /* start scheduler */
+  vTaskStartScheduler();
+}
+
+/**
+  * @brief  gateway task function, converts the bytes received on usart2 to
+  *         upper case and sends them back, reading the receive stream buffer
+  *         and writing the transmit stream buffer in place.
+  * @param  pvParameters: not used
+  * @retval none
+  */
+void gateway_task_function(void *pvParameters)
+{
+  uint8_t *rx_data, *tx_data;
+  size_t rx_length, tx_length, i;
+
+  while(1)
+  {
+    rx_length = xStreamBufferReadAcquire(uart_stream_rx, &rx_data, portMAX_DELAY);
+    if(rx_length == 0)
+    {
+      continue;
+    }
+    tx_length = xStreamBufferWriteAcquire(uart_stream_tx, &tx_data, portMAX_DELAY);
+    if(tx_length < rx_length)
+    {
+      rx_length = tx_length;
+    }
+
+    for(i = 0; i < rx_length; i ++)
+    {
+      tx_data[i] = (rx_data[i] >= 'a' && rx_data[i] <= 'z') ? rx_data[i] - 'a' + 'A' : rx_data[i];
+    }
+
+    xStreamBufferWriteCommit(uart_stream_tx, rx_length);
+    uart_stream_tx_start();
+    xStreamBufferReadRelease(uart_stream_rx, rx_length);
+  }
+}
+
+/**
+  * @brief  fill a block with the benchmark pattern, stands in for a
+  *         peripheral producing the data.
+  * @param  data: block to fill
+  * @param  length: bytes in the block
+  * @param  offset: stream offset of the first byte
+  * @retval none
+  */
+static void bench_fill(uint8_t *data, uint32_t length, uint32_t offset)
+{
+  uint32_t i;
+
+  for(i = 0; i < length; i ++)
+  {
+    data[i] = (uint8_t)(offset + i);
+  }
+}
+
+/**
+  * @brief  add a block to the benchmark checksum, stands in for a consumer.
+  * @param  data: block to read
+  * @param  length: bytes in the block
+  * @param  sum: checksum of the previous blocks
+  * @retval checksum
+  */
+static uint32_t bench_sum(const uint8_t *data, uint32_t length, uint32_t sum)
+{
+  uint32_t i;
+
+  for(i = 0; i < length; i ++)
+  {
+    sum = (sum << 1 | sum >> 31) ^ data[i];
+  }
+  return sum;
+}
+
+/**
+  * @brief  move BENCH_BYTES through a stream buffer with xStreamBufferSend
+  *         and xStreamBufferReceive, through a staging block on each side.
+  * @param  stream: empty stream buffer
+  * @param  chunk: bytes per send
+  * @param  sum: returns the checksum of the received data
+  * @retval cpu cycles
+  */
+static uint32_t bench_copy(StreamBufferHandle_t stream, uint32_t chunk, uint32_t *sum)
+{
+  uint32_t offset, start;
+
+  *sum = 0;
+  start = DWT->CYCCNT;
+  for(offset = 0; offset < BENCH_BYTES; offset += chunk)
+  {
+    bench_fill(bench_staging, chunk, offset);
+    xStreamBufferSend(stream, bench_staging, chunk, 0);
+    xStreamBufferReceive(stream, bench_staging, chunk, 0);
+    *sum = bench_sum(bench_staging, chunk, *sum);
+  }
+  return DWT->CYCCNT - start;
+}
+
+/**
+  * @brief  move BENCH_BYTES through a stream buffer with the acquire, commit
+  *         and release functions, in the storage of the stream buffer.
+  * @param  stream: empty stream buffer
+  * @param  chunk: largest block per commit
+  * @param  sum: returns the checksum of the received data
+  * @retval cpu cycles
+  */
+static uint32_t bench_zero_copy(StreamBufferHandle_t stream, uint32_t chunk, uint32_t *sum)
+{
+  uint32_t offset, start;
+  uint8_t *data;
+  size_t length;
+
+  *sum = 0;
+  start = DWT->CYCCNT;
+  for(offset = 0; offset < BENCH_BYTES; offset += length)
+  {
+    /* the region is shorter than the chunk where the storage wraps */
+    length = xStreamBufferWriteAcquire(stream, &data, 0);
+    if(length > chunk)
+    {
+      length = chunk;
+    }
+    bench_fill(data, length, offset);
+    xStreamBufferWriteCommit(stream, length);
+
+    length = xStreamBufferReadAcquire(stream, &data, 0);
+    *sum = bench_sum(data, length, *sum);
+    xStreamBufferReadRelease(stream, length);
+  }
+  return DWT->CYCCNT - start;
+}
+
+/**
+  * @brief  compare the copying and the in place stream buffer functions,
+  *         prints the cpu cycles per byte for each chunk size.
+  * @param  none
+  * @retval none
+  */
+static void stream_bench(void)
+{
+  StreamBufferHandle_t stream;
+  uint32_t i, copy_cycles, zero_cycles, copy_sum, zero_sum;
+
+  stream = xStreamBufferCreate(BENCH_BUFFER_SIZE, 1);
+  if(stream == NULL)
+  {
+    printf("benchmark stream buffer could not be created.\r\n");
+    return;
+  }
+
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  printf("stream buffer %d bytes, %d bytes per run, cycles per byte:\r\n", BENCH_BUFFER_SIZE, BENCH_BYTES);
+  for(i = 0; i < sizeof(bench_chunk) / sizeof(bench_chunk[0]); i ++)
+  {
+    copy_cycles = bench_copy(stream, bench_chunk[i], &copy_sum);
+    zero_cycles = bench_zero_copy(stream, bench_chunk[i], &zero_sum);
+
+    printf("  chunk %3d: send/receive %d.%02d, acquire/commit %d.%02d%s\r\n", bench_chunk[i],
+           copy_cycles / BENCH_BYTES, copy_cycles * 100 / BENCH_BYTES % 100,
+           zero_cycles / BENCH_BYTES, zero_cycles * 100 / BENCH_BYTES % 100,
+           copy_sum == zero_sum ? "" : ", checksum mismatch");
+  }
+
+  vStreamBufferDelete(stream);
+}
+
+/**
+  * @brief  stats task function, runs the benchmark once and then prints the
+  *         uart stream counters every second.
+  * @param  pvParameters: not used
+  * @retval none
+  */
+void stats_task_function(void *pvParameters)
+{
+  stream_bench();
+
+  while(1)
+  {
+    vTaskDelay(1000);
+    at32_led_toggle(LED2);
+    if(uart_stream_stats.rx_dropped != 0)
+    {
+      at32_led_on(LED3);
+    }
+    printf("rx %d bytes, dropped %d, tx %d bytes in %d transfers\r\n",
+           uart_stream_stats.rx_bytes, uart_stream_stats.rx_dropped,
+           uart_stream_stats.tx_bytes, uart_stream_stats.tx_transfers);
+  }
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
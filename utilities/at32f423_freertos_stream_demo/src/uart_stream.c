@@ -0,0 +1,279 @@
+/**
+  **************************************************************************
+  * @file     uart_stream.c
+  * @brief    uart stream buffers filled and drained by dma
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "uart_stream.h"
+#include "task.h"
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup FreeRTOS_stream_demo
+  * @{
+  */
+
+/* usart2 rx on dma1 channel2, tx on dma1 channel1 */
+#define UART_STREAM_RX_CHANNEL           DMA1_CHANNEL2
+#define UART_STREAM_RX_FDT_FLAG          DMA1_FDT2_FLAG
+#define UART_STREAM_TX_CHANNEL           DMA1_CHANNEL1
+#define UART_STREAM_TX_FDT_FLAG          DMA1_FDT1_FLAG
+
+StreamBufferHandle_t uart_stream_rx;
+StreamBufferHandle_t uart_stream_tx;
+uart_stream_stats_type uart_stream_stats;
+
+/* receive target while the receive stream buffer is full */
+static uint8_t uart_stream_discard[16];
+
+/* length of the running transfers, the rx transfer goes to the discard buffer
+   when rx_discard is set, tx_length is 0 while the tx dma is idle */
+static uint32_t uart_stream_rx_length;
+static confirm_state uart_stream_rx_discard;
+static uint32_t uart_stream_tx_length;
+
+/**
+  * @brief  start a dma transfer from or to a stream buffer region.
+  * @param  channel: dma channel, disabled
+  * @param  data: region of the stream buffer
+  * @param  length: bytes in the region
+  * @retval none
+  */
+static void uart_stream_dma_start(dma_channel_type *channel, uint8_t *data, uint32_t length)
+{
+  channel->maddr = (uint32_t)data;
+  dma_data_number_set(channel, (uint16_t)length);
+  dma_channel_enable(channel, TRUE);
+}
+
+/**
+  * @brief  point the receive dma at the free region of the receive stream
+  *         buffer, or at the discard buffer when there is none.
+  * @param  none
+  * @retval none
+  */
+static void uart_stream_rx_arm(void)
+{
+  uint8_t *data;
+  size_t length;
+
+  length = xStreamBufferWriteAcquire(uart_stream_rx, &data, 0);
+  if(length == 0)
+  {
+    data = uart_stream_discard;
+    length = sizeof(uart_stream_discard);
+    uart_stream_rx_discard = TRUE;
+  }
+  else
+  {
+    uart_stream_rx_discard = FALSE;
+  }
+  if(length > UART_STREAM_RX_CHUNK)
+  {
+    length = UART_STREAM_RX_CHUNK;
+  }
+  uart_stream_rx_length = length;
+  uart_stream_dma_start(UART_STREAM_RX_CHANNEL, data, length);
+}
+
+/**
+  * @brief  start the transmit dma on the data of the transmit stream buffer,
+  *         the caller has checked the dma is idle.
+  * @param  none
+  * @retval none
+  */
+static void uart_stream_tx_next(void)
+{
+  uint8_t *data;
+
+  uart_stream_tx_length = xStreamBufferReadAcquire(uart_stream_tx, &data, 0);
+  if(uart_stream_tx_length != 0)
+  {
+    uart_stream_stats.tx_transfers++;
+    uart_stream_dma_start(UART_STREAM_TX_CHANNEL, data, uart_stream_tx_length);
+  }
+}
+
+/**
+  * @brief  usart2 and dma configuration.
+  * @param  baudrate: usart2 baudrate
+  * @retval none
+  */
+static void uart_stream_config(uint32_t baudrate)
+{
+  gpio_init_type gpio_init_struct;
+  dma_init_type dma_init_struct;
+
+  crm_periph_clock_enable(CRM_USART2_PERIPH_CLOCK, TRUE);
+  crm_periph_clock_enable(CRM_GPIOA_PERIPH_CLOCK, TRUE);
+  crm_periph_clock_enable(CRM_DMA1_PERIPH_CLOCK, TRUE);
+
+  /* configure the usart2 tx, rx pin */
+  gpio_default_para_init(&gpio_init_struct);
+  gpio_init_struct.gpio_drive_strength = GPIO_DRIVE_STRENGTH_STRONGER;
+  gpio_init_struct.gpio_out_type  = GPIO_OUTPUT_PUSH_PULL;
+  gpio_init_struct.gpio_mode = GPIO_MODE_MUX;
+  gpio_init_struct.gpio_pins = GPIO_PINS_2 | GPIO_PINS_3;
+  gpio_init_struct.gpio_pull = GPIO_PULL_NONE;
+  gpio_init(GPIOA, &gpio_init_struct);
+  gpio_pin_mux_config(GPIOA, GPIO_PINS_SOURCE2, GPIO_MUX_7);
+  gpio_pin_mux_config(GPIOA, GPIO_PINS_SOURCE3, GPIO_MUX_7);
+
+  dmamux_enable(DMA1, TRUE);
+
+  /* dma1 channel1 for usart2 tx, the memory address is set per transfer */
+  dma_reset(UART_STREAM_TX_CHANNEL);
+  dma_default_para_init(&dma_init_struct);
+  dma_init_struct.buffer_size = 0;
+  dma_init_struct.direction = DMA_DIR_MEMORY_TO_PERIPHERAL;
+  dma_init_struct.memory_base_addr = 0;
+  dma_init_struct.memory_data_width = DMA_MEMORY_DATA_WIDTH_BYTE;
+  dma_init_struct.memory_inc_enable = TRUE;
+  dma_init_struct.peripheral_base_addr = (uint32_t)&USART2->dt;
+  dma_init_struct.peripheral_data_width = DMA_PERIPHERAL_DATA_WIDTH_BYTE;
+  dma_init_struct.peripheral_inc_enable = FALSE;
+  dma_init_struct.priority = DMA_PRIORITY_MEDIUM;
+  dma_init_struct.loop_mode_enable = FALSE;
+  dma_init(UART_STREAM_TX_CHANNEL, &dma_init_struct);
+  dma_interrupt_enable(UART_STREAM_TX_CHANNEL, DMA_FDT_INT, TRUE);
+  dmamux_init(DMA1MUX_CHANNEL1, DMAMUX_DMAREQ_ID_USART2_TX);
+
+  /* dma1 channel2 for usart2 rx */
+  dma_reset(UART_STREAM_RX_CHANNEL);
+  dma_init_struct.direction = DMA_DIR_PERIPHERAL_TO_MEMORY;
+  dma_init_struct.priority = DMA_PRIORITY_HIGH;
+  dma_init(UART_STREAM_RX_CHANNEL, &dma_init_struct);
+  dma_interrupt_enable(UART_STREAM_RX_CHANNEL, DMA_FDT_INT, TRUE);
+  dmamux_init(DMA1MUX_CHANNEL2, DMAMUX_DMAREQ_ID_USART2_RX);
+
+  /* the idle line ends a receive transfer before it is full */
+  usart_init(USART2, baudrate, USART_DATA_8BITS, USART_STOP_1_BIT);
+  usart_transmitter_enable(USART2, TRUE);
+  usart_receiver_enable(USART2, TRUE);
+  usart_dma_transmitter_enable(USART2, TRUE);
+  usart_dma_receiver_enable(USART2, TRUE);
+  usart_interrupt_enable(USART2, USART_IDLE_INT, TRUE);
+
+  /* equal priorities, the receive handlers never preempt each other */
+  nvic_irq_enable(DMA1_Channel1_IRQn, UART_STREAM_IRQ_PRIORITY, 0);
+  nvic_irq_enable(DMA1_Channel2_IRQn, UART_STREAM_IRQ_PRIORITY, 0);
+  nvic_irq_enable(USART2_IRQn, UART_STREAM_IRQ_PRIORITY, 0);
+}
+
+/**
+  * @brief  create the stream buffers and start receiving on usart2.
+  * @param  baudrate: usart2 baudrate
+  * @retval SUCCESS or ERROR
+  */
+error_status uart_stream_init(uint32_t baudrate)
+{
+  /* the trigger level of 1 wakes the reader on every commit, a commit
+     already carries a whole dma transfer */
+  uart_stream_rx = xStreamBufferCreate(UART_STREAM_RX_SIZE, 1);
+  uart_stream_tx = xStreamBufferCreate(UART_STREAM_TX_SIZE, 1);
+  if(uart_stream_rx == NULL || uart_stream_tx == NULL)
+  {
+    return ERROR;
+  }
+
+  uart_stream_config(baudrate);
+  uart_stream_rx_arm();
+  usart_enable(USART2, TRUE);
+
+  return SUCCESS;
+}
+
+/**
+  * @brief  start transmitting the data committed to the transmit stream
+  *         buffer, called by its writer after a commit.
+  * @param  none
+  * @retval none
+  */
+void uart_stream_tx_start(void)
+{
+  taskENTER_CRITICAL();
+  if(uart_stream_tx_length == 0)
+  {
+    uart_stream_tx_next();
+  }
+  taskEXIT_CRITICAL();
+}
+
+/**
+  * @brief  end the receive transfer, commit the received bytes and restart
+  *         on the next free region, called on the dma1 channel2 full
+  *         transfer and on the usart2 idle line.
+  * @param  none
+  * @retval none
+  */
+void uart_stream_rx_irq_handler(void)
+{
+  BaseType_t woken = pdFALSE;
+  uint32_t count;
+
+  dma_channel_enable(UART_STREAM_RX_CHANNEL, FALSE);
+  dma_flag_clear(UART_STREAM_RX_FDT_FLAG);
+  count = uart_stream_rx_length - dma_data_number_get(UART_STREAM_RX_CHANNEL);
+
+  if(uart_stream_rx_discard == TRUE)
+  {
+    uart_stream_stats.rx_dropped += count;
+  }
+  else if(count != 0)
+  {
+    xStreamBufferWriteCommitFromISR(uart_stream_rx, count, &woken);
+    uart_stream_stats.rx_bytes += count;
+  }
+  uart_stream_rx_arm();
+
+  portYIELD_FROM_ISR(woken);
+}
+
+/**
+  * @brief  release the transmitted region and send the next one, called on
+  *         the dma1 channel1 full transfer.
+  * @param  none
+  * @retval none
+  */
+void uart_stream_tx_irq_handler(void)
+{
+  BaseType_t woken = pdFALSE;
+
+  dma_channel_enable(UART_STREAM_TX_CHANNEL, FALSE);
+  dma_flag_clear(UART_STREAM_TX_FDT_FLAG);
+
+  xStreamBufferReadReleaseFromISR(uart_stream_tx, uart_stream_tx_length, &woken);
+  uart_stream_stats.tx_bytes += uart_stream_tx_length;
+  uart_stream_tx_next();
+
+  portYIELD_FROM_ISR(woken);
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
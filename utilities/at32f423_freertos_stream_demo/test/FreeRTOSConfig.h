@@ -0,0 +1,51 @@
+/**
+  **************************************************************************
+  * @file     FreeRTOSConfig.h
+  * @brief    host kernel configuration of the stream buffer test
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* stream_buffer.c is built on the host with the kernel configuration the
+   demo uses for it, the scheduler itself is replaced by the stubs of
+   stream_zero_copy_test.c. */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#define configUSE_PREEMPTION                 1
+#define configUSE_IDLE_HOOK                  0
+#define configUSE_TICK_HOOK                  0
+#define configTICK_RATE_HZ                   ( ( TickType_t ) 1000 )
+#define configMAX_PRIORITIES                 ( 5 )
+#define configMINIMAL_STACK_SIZE             ( ( unsigned short ) 128 )
+#define configSUPPORT_STATIC_ALLOCATION      1
+#define configSUPPORT_DYNAMIC_ALLOCATION     0
+#define configMAX_TASK_NAME_LEN              ( 16 )
+#define configUSE_16_BIT_TICKS               0
+#define configUSE_STREAM_BUFFER_ZERO_COPY    1
+
+#define INCLUDE_xTaskGetCurrentTaskHandle    1
+
+/* a failed assert is counted by the test instead of halting */
+void test_assert_failed( const char * file, int line );
+#define configASSERT( x )                    if( ( x ) == 0 ) { test_assert_failed( __FILE__, __LINE__ ); }
+
+#endif
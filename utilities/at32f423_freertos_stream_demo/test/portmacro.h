@@ -0,0 +1,70 @@
+/**
+  **************************************************************************
+  * @file     portmacro.h
+  * @brief    host port of the stream buffer test
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* single threaded host port: critical sections are empty and a yield does
+   nothing, the test drives the writer, the reader and the interrupt side
+   of a stream buffer from one thread. */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <stdint.h>
+
+#define portCHAR                             char
+#define portFLOAT                            float
+#define portDOUBLE                           double
+#define portLONG                             long
+#define portSHORT                            short
+#define portSTACK_TYPE                       uint32_t
+#define portBASE_TYPE                        long
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define portMAX_DELAY                        ( TickType_t ) 0xffffffffUL
+#define portTICK_TYPE_IS_ATOMIC              1
+#define portSTACK_GROWTH                     ( -1 )
+#define portTICK_PERIOD_MS                   ( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT                   8
+
+#define portYIELD()
+#define portEND_SWITCHING_ISR( xSwitchRequired )    ( void ) ( xSwitchRequired )
+#define portYIELD_FROM_ISR( x )                     portEND_SWITCHING_ISR( x )
+
+#define portSET_INTERRUPT_MASK_FROM_ISR()           0
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )      ( void ) ( x )
+#define portDISABLE_INTERRUPTS()
+#define portENABLE_INTERRUPTS()
+#define portENTER_CRITICAL()
+#define portEXIT_CRITICAL()
+
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters )    void vFunction( void * pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters )          void vFunction( void * pvParameters )
+
+#define portNOP()
+
+#endif
@@ -0,0 +1,454 @@
+/**
+  **************************************************************************
+  * @file     stream_zero_copy_test.c
+  * @brief    host test of the stream buffer acquire and commit api
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* the writer, the reader and the interrupt side run in one thread. the
+   cases cover the contiguous regions handed out around the end of the
+   storage area, a random mix with xStreamBufferSend/Receive checked against
+   a byte counter, the wake up of a task blocked in an acquire by a commit or
+   release from an interrupt, and the asserts on misuse. */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+#include <stdio.h>
+#include <string.h>
+
+/* the storage area keeps one byte free to tell a full buffer from an empty
+   one, SB_SIZE bytes can be stored */
+#define SB_SIZE                          16
+#define SB_STORAGE_SIZE                  ( SB_SIZE + 1 )
+
+#define TEST_CHECK(cond)                 do { if(!(cond)) { printf("  %s:%d: %s\n", __func__, __LINE__, #cond); \
+                                           test_failed ++; } } while(0)
+
+static uint8_t sb_storage[SB_STORAGE_SIZE];
+static StaticStreamBuffer_t sb_struct;
+static StreamBufferHandle_t sb;
+
+/* byte sequence written and expected by the reader */
+static uint8_t wr_seq;
+static uint8_t rd_seq;
+
+static int test_failed;
+static int assert_count;
+static int notify_count;
+static int notify_isr_count;
+static int wait_count;
+static int task_tcb;
+static void (*pending_isr)(void);
+
+void test_assert_failed(const char *file, int line)
+{
+  (void)file;
+  (void)line;
+  assert_count ++;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+  return (TaskHandle_t)&task_tcb;
+}
+
+BaseType_t xTaskGenericNotify(TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue,
+                              eNotifyAction eAction, uint32_t *pulPreviousNotificationValue)
+{
+  (void)uxIndexToNotify;
+  (void)ulValue;
+  (void)eAction;
+  (void)pulPreviousNotificationValue;
+  TEST_CHECK(xTaskToNotify == (TaskHandle_t)&task_tcb);
+  notify_count ++;
+  return pdPASS;
+}
+
+BaseType_t xTaskGenericNotifyFromISR(TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue,
+                                     eNotifyAction eAction, uint32_t *pulPreviousNotificationValue,
+                                     BaseType_t *pxHigherPriorityTaskWoken)
+{
+  (void)uxIndexToNotify;
+  (void)ulValue;
+  (void)eAction;
+  (void)pulPreviousNotificationValue;
+  TEST_CHECK(xTaskToNotify == (TaskHandle_t)&task_tcb);
+  notify_isr_count ++;
+  if(pxHigherPriorityTaskWoken != NULL)
+  {
+    *pxHigherPriorityTaskWoken = pdTRUE;
+  }
+  return pdPASS;
+}
+
+/* the blocked task gives way to the pending interrupt, if any */
+BaseType_t xTaskGenericNotifyWait(UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry,
+                                  uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue,
+                                  TickType_t xTicksToWait)
+{
+  void (*isr)(void) = pending_isr;
+
+  (void)uxIndexToWaitOn;
+  (void)ulBitsToClearOnEntry;
+  (void)ulBitsToClearOnExit;
+  (void)pulNotificationValue;
+  (void)xTicksToWait;
+  wait_count ++;
+  pending_isr = NULL;
+  if(isr != NULL)
+  {
+    isr();
+  }
+  return pdTRUE;
+}
+
+BaseType_t xTaskGenericNotifyStateClear(TaskHandle_t xTask, UBaseType_t uxIndexToClear)
+{
+  (void)xTask;
+  (void)uxIndexToClear;
+  return pdTRUE;
+}
+
+void vTaskSetTimeOutState(TimeOut_t * const pxTimeOut)
+{
+  memset(pxTimeOut, 0, sizeof(TimeOut_t));
+}
+
+/* every wait takes one tick */
+BaseType_t xTaskCheckForTimeOut(TimeOut_t * const pxTimeOut, TickType_t * const pxTicksToWait)
+{
+  (void)pxTimeOut;
+  if(*pxTicksToWait <= 1)
+  {
+    *pxTicksToWait = 0;
+    return pdTRUE;
+  }
+  (*pxTicksToWait) --;
+  return pdFALSE;
+}
+
+void vTaskSuspendAll(void)
+{
+}
+
+BaseType_t xTaskResumeAll(void)
+{
+  return pdFALSE;
+}
+
+static void sb_create(size_t trigger)
+{
+  memset(sb_storage, 0, sizeof(sb_storage));
+  sb = xStreamBufferCreateStatic(SB_STORAGE_SIZE, trigger, sb_storage, &sb_struct);
+  wr_seq = 0;
+  rd_seq = 0;
+  assert_count = 0;
+  notify_count = 0;
+  notify_isr_count = 0;
+  wait_count = 0;
+  pending_isr = NULL;
+}
+
+static void sb_fill(uint8_t *p, size_t len)
+{
+  while(len --)
+  {
+    *p ++ = wr_seq ++;
+  }
+}
+
+static int sb_match(const uint8_t *p, size_t len)
+{
+  int match = 1;
+
+  while(len --)
+  {
+    if(*p ++ != rd_seq ++)
+    {
+      match = 0;
+    }
+  }
+  return match;
+}
+
+/**
+  * @brief  the regions handed out split at the end of the storage area and
+  *         continue at its start
+  */
+static void test_wrap(void)
+{
+  uint8_t *p;
+  size_t len;
+
+  sb_create(1);
+
+  len = xStreamBufferWriteAcquire(sb, &p, 0);
+  TEST_CHECK(len == SB_SIZE && p == sb_storage);
+  sb_fill(p, 10);
+  TEST_CHECK(xStreamBufferWriteCommit(sb, 10) == 10);
+  TEST_CHECK(xStreamBufferBytesAvailable(sb) == 10);
+
+  len = xStreamBufferReadAcquire(sb, &p, 0);
+  TEST_CHECK(len == 10 && p == sb_storage);
+  TEST_CHECK(sb_match(p, len));
+  TEST_CHECK(xStreamBufferReadRelease(sb, len) == 10);
+  TEST_CHECK(xStreamBufferIsEmpty(sb) == pdTRUE);
+
+  /* head at 10, the free space runs to the end of the storage area */
+  len = xStreamBufferWriteAcquire(sb, &p, 0);
+  TEST_CHECK(len == SB_STORAGE_SIZE - 10 && p == &sb_storage[10]);
+  sb_fill(p, len);
+  xStreamBufferWriteCommit(sb, len);
+
+  /* then continues at the start, one byte stays free to tell full from empty */
+  len = xStreamBufferWriteAcquire(sb, &p, 0);
+  TEST_CHECK(len == SB_SIZE - (SB_STORAGE_SIZE - 10) && p == sb_storage);
+  sb_fill(p, len);
+  xStreamBufferWriteCommit(sb, len);
+  TEST_CHECK(xStreamBufferIsFull(sb) == pdTRUE);
+  TEST_CHECK(xStreamBufferSpacesAvailable(sb) == 0);
+  TEST_CHECK(xStreamBufferWriteAcquire(sb, &p, 0) == 0);
+
+  len = xStreamBufferReadAcquire(sb, &p, 0);
+  TEST_CHECK(len == SB_STORAGE_SIZE - 10 && p == &sb_storage[10]);
+  TEST_CHECK(sb_match(p, len));
+  xStreamBufferReadRelease(sb, len);
+
+  len = xStreamBufferReadAcquire(sb, &p, 0);
+  TEST_CHECK(len == SB_SIZE - (SB_STORAGE_SIZE - 10) && p == sb_storage);
+  TEST_CHECK(sb_match(p, len));
+  xStreamBufferReadRelease(sb, len);
+
+  TEST_CHECK(xStreamBufferIsEmpty(sb) == pdTRUE);
+  TEST_CHECK(xStreamBufferReadAcquire(sb, &p, 0) == 0);
+  TEST_CHECK(assert_count == 0);
+}
+
+/**
+  * @brief  acquire/commit and send/receive on the same buffer, in random
+  *         order and with partial commits and releases
+  */
+static void test_mixed(void)
+{
+  uint32_t seed = 0x2545F491;
+  uint8_t data[SB_SIZE + 4];
+  size_t used = 0, len, space, n;
+  uint8_t *p;
+  int step;
+
+  sb_create(1);
+
+  for(step = 0; step < 20000; step ++)
+  {
+    seed = seed * 1664525 + 1013904223;
+    n = (seed >> 8) % (SB_SIZE + 4);
+    switch((seed >> 28) & 3)
+    {
+      case 0:
+        /* the region ends at the end of the storage area or covers all the space */
+        space = xStreamBufferSpacesAvailable(sb);
+        TEST_CHECK(space == SB_SIZE - used);
+        len = xStreamBufferWriteAcquire(sb, &p, 0);
+        TEST_CHECK(len <= space);
+        TEST_CHECK(len == space || p + len == sb_storage + SB_STORAGE_SIZE);
+        n = n < len ? n : len;
+        sb_fill(p, n);
+        xStreamBufferWriteCommit(sb, n);
+        used += n;
+        break;
+      case 1:
+        /* a send of nothing is rejected by the kernel */
+        n = n < SB_SIZE - used ? n : SB_SIZE - used;
+        if(n == 0)
+        {
+          break;
+        }
+        sb_fill(data, n);
+        TEST_CHECK(xStreamBufferSend(sb, data, n, 0) == n);
+        used += n;
+        break;
+      case 2:
+        len = xStreamBufferReadAcquire(sb, &p, 0);
+        TEST_CHECK(len <= used);
+        TEST_CHECK(len == used || p + len == sb_storage + SB_STORAGE_SIZE);
+        n = n < len ? n : len;
+        TEST_CHECK(sb_match(p, n));
+        xStreamBufferReadRelease(sb, n);
+        used -= n;
+        break;
+      default:
+        len = xStreamBufferReceive(sb, data, n, 0);
+        TEST_CHECK(len == (n < used ? n : used));
+        TEST_CHECK(sb_match(data, len));
+        used -= len;
+        break;
+    }
+    TEST_CHECK(xStreamBufferBytesAvailable(sb) == used);
+    if(test_failed != 0)
+    {
+      printf("  step %d\n", step);
+      break;
+    }
+  }
+  TEST_CHECK(assert_count == 0);
+}
+
+static BaseType_t isr_woken;
+
+static void isr_write_6(void)
+{
+  uint8_t *p;
+  size_t len = xStreamBufferWriteAcquire(sb, &p, 0);
+
+  TEST_CHECK(len >= 6);
+  sb_fill(p, 6);
+  xStreamBufferWriteCommitFromISR(sb, 6, &isr_woken);
+}
+
+static void isr_write_2(void)
+{
+  uint8_t *p;
+
+  xStreamBufferWriteAcquire(sb, &p, 0);
+  sb_fill(p, 2);
+  xStreamBufferWriteCommitFromISR(sb, 2, &isr_woken);
+}
+
+static void isr_read_5(void)
+{
+  uint8_t *p;
+  size_t len = xStreamBufferReadAcquire(sb, &p, 0);
+
+  TEST_CHECK(len >= 5);
+  TEST_CHECK(sb_match(p, 5));
+  xStreamBufferReadReleaseFromISR(sb, 5, &isr_woken);
+}
+
+/**
+  * @brief  a task blocked in an acquire is woken by a commit or a release
+  *         from an interrupt, a commit below the trigger level does not wake
+  */
+static void test_blocking(void)
+{
+  uint8_t data[SB_SIZE];
+  uint8_t *p;
+  size_t len;
+
+  /* reader waits for data */
+  sb_create(4);
+  isr_woken = pdFALSE;
+  pending_isr = isr_write_6;
+  len = xStreamBufferReadAcquire(sb, &p, 10);
+  TEST_CHECK(wait_count == 1);
+  TEST_CHECK(notify_isr_count == 1 && isr_woken == pdTRUE);
+  TEST_CHECK(len == 6 && p == sb_storage);
+  TEST_CHECK(sb_match(p, len));
+  xStreamBufferReadRelease(sb, len);
+  TEST_CHECK(notify_count == 0);
+
+  /* data below the trigger level does not wake the reader */
+  sb_create(4);
+  isr_woken = pdFALSE;
+  pending_isr = isr_write_2;
+  len = xStreamBufferReadAcquire(sb, &p, 10);
+  TEST_CHECK(notify_isr_count == 0 && isr_woken == pdFALSE);
+  TEST_CHECK(len == 2 && sb_match(p, len));
+
+  /* writer waits for space */
+  sb_create(1);
+  sb_fill(data, SB_SIZE);
+  TEST_CHECK(xStreamBufferSend(sb, data, SB_SIZE, 0) == SB_SIZE);
+  isr_woken = pdFALSE;
+  pending_isr = isr_read_5;
+  len = xStreamBufferWriteAcquire(sb, &p, 10);
+  TEST_CHECK(wait_count == 1);
+  TEST_CHECK(notify_isr_count == 1 && isr_woken == pdTRUE);
+
+  /* the head is at the last byte of the storage area */
+  TEST_CHECK(len == 1 && p == &sb_storage[SB_SIZE]);
+  sb_fill(p, len);
+  xStreamBufferWriteCommit(sb, len);
+  len = xStreamBufferWriteAcquire(sb, &p, 0);
+  TEST_CHECK(len == 4 && p == sb_storage);
+
+  /* no space frees up, the acquire times out empty handed */
+  sb_fill(p, len);
+  xStreamBufferWriteCommit(sb, len);
+  wait_count = 0;
+  TEST_CHECK(xStreamBufferWriteAcquire(sb, &p, 3) == 0);
+  TEST_CHECK(wait_count == 3);
+  TEST_CHECK(assert_count == 0);
+}
+
+/**
+  * @brief  a commit past the acquired region and an acquire on a message
+  *         buffer are rejected
+  */
+static void test_asserts(void)
+{
+  static uint8_t mb_storage[SB_STORAGE_SIZE];
+  static StaticMessageBuffer_t mb_struct;
+  MessageBufferHandle_t mb;
+  uint8_t *p;
+  size_t len;
+
+  sb_create(1);
+  len = xStreamBufferWriteAcquire(sb, &p, 0);
+  xStreamBufferWriteCommit(sb, len);
+  len = xStreamBufferReadAcquire(sb, &p, 0);
+  xStreamBufferReadRelease(sb, len - 2);
+  TEST_CHECK(assert_count == 0);
+
+  /* more than is stored */
+  xStreamBufferReadRelease(sb, 3);
+  TEST_CHECK(assert_count != 0);
+
+  /* past the end of the storage area */
+  sb_create(1);
+  len = xStreamBufferWriteAcquire(sb, &p, 0);
+  xStreamBufferWriteCommit(sb, 10);
+  len = xStreamBufferReadAcquire(sb, &p, 0);
+  xStreamBufferReadRelease(sb, len);
+  len = xStreamBufferWriteAcquire(sb, &p, 0);
+  TEST_CHECK(len == SB_STORAGE_SIZE - 10 && assert_count == 0);
+  xStreamBufferWriteCommit(sb, len + 1);
+  TEST_CHECK(assert_count != 0);
+
+  sb_create(1);
+  mb = xMessageBufferCreateStatic(SB_STORAGE_SIZE, mb_storage, &mb_struct);
+  xStreamBufferWriteAcquire(mb, &p, 0);
+  TEST_CHECK(assert_count == 1);
+  xStreamBufferReadAcquire(mb, &p, 0);
+  TEST_CHECK(assert_count == 2);
+}
+
+int main(void)
+{
+  test_wrap();
+  test_mixed();
+  test_blocking();
+  test_asserts();
+
+  printf("%d checks failed\n", test_failed);
+  return test_failed;
+}
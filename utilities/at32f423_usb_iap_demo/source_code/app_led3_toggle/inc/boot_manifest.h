@@ -0,0 +1,133 @@
+/**
+  **************************************************************************
+  * @file     boot_manifest.h
+  * @brief    boot manifest header file
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* define to prevent recursive inclusion -------------------------------------*/
+#ifndef __BOOT_MANIFEST_H
+#define __BOOT_MANIFEST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "at32f423.h"
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup USB_iap_app_led3_toggle
+  * @{
+  */
+
+/**
+  * @brief application slot layout, each slot is preceded by one manifest sector.
+  *        slot b is only used when the device flash is large enough to hold it.
+  */
+#define BOOT_SLOT_A_ADDRESS              0x08006000
+#define BOOT_SLOT_B_ADDRESS              0x08023000
+#define BOOT_SLOT_NUM                    2
+
+/**
+  * @brief bootloader flash size, the linker files limit the bootloader to it.
+  *        it must end below the manifest sector of slot a for the largest
+  *        flash sector, boot_image_begin never erases a sector inside it.
+  */
+#define BOOT_LOADER_SIZE                 0x5800
+#define BOOT_MAX_SECTOR_SIZE             0x800
+
+#if (0x08000000 + BOOT_LOADER_SIZE) > (BOOT_SLOT_A_ADDRESS - BOOT_MAX_SECTOR_SIZE)
+#error "the bootloader overlaps the manifest sector of slot a"
+#endif
+
+#define BOOT_MANIFEST_MAGIC              0x424F4F54
+#define BOOT_REQUEST_MAGIC               0x49415051
+#define BOOT_MAX_SECTOR_NUM              128
+#define BOOT_MAX_ATTEMPTS                3
+#define BOOT_MAX_REQUESTS                8
+
+/**
+  * @brief state word values, an erased word reads BOOT_WORD_ERASED and each
+  *        state word is programmed once to BOOT_WORD_SET.
+  */
+#define BOOT_WORD_ERASED                 0xFFFFFFFF
+#define BOOT_WORD_SET                    0x00000000
+#define BOOT_SECTOR_DIRTY                0xFFFF
+#define BOOT_SECTOR_VERIFIED             0x0000
+
+/**
+  * @brief watchdog timeout of a trial boot, the application must call
+  *        wdt_counter_reload() within this period until it confirms itself.
+  *        timeout = reload * divider / 40000 = 4095 * 64 / 40000 = 6.5s
+  */
+#ifndef BOOT_WDT_DIVIDER
+#define BOOT_WDT_DIVIDER                 WDT_CLK_DIV_64
+#endif
+#ifndef BOOT_WDT_RELOAD
+#define BOOT_WDT_RELOAD                  0xFFF
+#endif
+
+/**
+  * @brief image manifest, stored at the start of the sector in front of each slot.
+  *        the header up to manifest_crc is written once after the image has been
+  *        programmed (magic last), the state words after it are programmed later
+  *        by the bootloader and the application without erasing the sector.
+  *        an application requests iap by programming BOOT_REQUEST_MAGIC into the
+  *        next erased request word of its own manifest, the bootloader serves it
+  *        when the download starts. only the manifest of the slot the new image
+  *        is written to is erased, the running image stays for a rollback.
+  */
+typedef struct
+{
+  uint32_t magic;                                  /*!< BOOT_MANIFEST_MAGIC, programmed last */
+  uint32_t version;                                /*!< image version from the packer trailer, the higher one is preferred */
+  uint32_t length;                                 /*!< image length in bytes */
+  uint32_t sector_size;                            /*!< flash sector size the crc table was built with */
+  uint32_t sector_num;                             /*!< number of entries in sector_crc */
+  uint32_t sector_crc[BOOT_MAX_SECTOR_NUM];        /*!< hardware crc32 of each image sector */
+  uint32_t manifest_crc;                           /*!< crc32 from version to the last sector_crc */
+
+  uint32_t confirm;                                /*!< set by the application once it runs */
+  uint32_t revoke;                                 /*!< set by the bootloader to roll back */
+  uint32_t attempt[BOOT_MAX_ATTEMPTS];             /*!< one word per unconfirmed boot */
+  uint32_t request[BOOT_MAX_REQUESTS];             /*!< one word per iap request of the application */
+  uint32_t served[BOOT_MAX_REQUESTS];              /*!< one word per request served by the bootloader */
+  uint16_t verified[BOOT_MAX_SECTOR_NUM];          /*!< sector checked since it was programmed */
+}boot_manifest_type;
+
+#define BOOT_MANIFEST(address)           ((boot_manifest_type *)(address))
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -36,53 +36,50 @@
   */
 
 void iap_clear_upgrade_flag(void);
-void iap_set_upgrade_flag(void);
-uint32_t crc_cal(uint32_t addr, uint16_t nk);
 void iap_idle(void);
 void iap_start(void);
 void iap_finish(void);
 void iap_respond(uint8_t *res_buf, uint16_t iap_cmd, uint16_t result);
 
 /**
-  * @brief  clear iap upgrade flag
+  * @brief  request iap mode, the request magic is programmed into the next
+  *         erased request word of the running image manifest. the bootloader
+  *         then stays in iap mode, the other slot keeps its image until the
+  *         download of the new image to it starts.
   * @param  none
   * @retval none
   */
 void iap_clear_upgrade_flag(void)
 {
-  flash_unlock();
-  flash_sector_erase(iap_info.flag_address);
-  flash_lock();
+  boot_manifest_type *manifest = BOOT_MANIFEST(iap_info.flag_address);
+  uint32_t i_index;
+
+  for(i_index = 0; i_index < BOOT_MAX_REQUESTS; i_index ++)
+  {
+    if(manifest->request[i_index] == BOOT_WORD_ERASED)
+    {
+      flash_unlock();
+      flash_word_program((uint32_t)&manifest->request[i_index], BOOT_REQUEST_MAGIC);
+      flash_lock();
+      return;
+    }
+  }
 }
 
 /**
-  * @brief  set iap upgrade complete flag
+  * @brief  confirm the running image, a trial boot is then no longer rolled back
   * @param  none
   * @retval none
   */
-void iap_set_upgrade_flag(void)
+void iap_confirm_image(void)
 {
-  flash_unlock();
-  flash_word_program(iap_info.flag_address,
-                      IAP_UPGRADE_COMPLETE_FLAG);
-  flash_lock();
-}
+  boot_manifest_type *manifest = BOOT_MANIFEST(iap_info.flag_address);
 
-/**
-  * @brief  get iap upgrade complete flag
-  * @param  none
-  * @retval the status of the iap flag
-  */
-iap_result_type iap_get_upgrade_flag(void)
-{
-  uint32_t flag_address = iap_info.flag_address;
-  if(*((uint32_t *)flag_address) == IAP_UPGRADE_COMPLETE_FLAG)
+  if(manifest->magic == BOOT_MANIFEST_MAGIC && manifest->confirm == BOOT_WORD_ERASED)
   {
-    return IAP_SUCCESS;
-  }
-  else
-  {
-    return IAP_FAILED;
+    flash_unlock();
+    flash_word_program((uint32_t)&manifest->confirm, BOOT_WORD_SET);
+    flash_lock();
   }
 }
 
@@ -116,7 +113,7 @@ void iap_init(void)
   iap_info.flash_end_address = iap_info.flash_start_address + iap_info.flash_size;
 
   iap_info.app_address = FLASH_APP_ADDRESS;
-  iap_info.flag_address = iap_info.app_address -  iap_info.sector_size;
+  iap_info.flag_address = iap_info.app_address - iap_info.sector_size;
 
   iap_info.fifo_length = 0;
   iap_info.iap_address = 0;
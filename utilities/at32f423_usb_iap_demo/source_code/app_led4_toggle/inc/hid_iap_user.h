@@ -32,6 +32,7 @@ extern "C" {
 #endif
 
 #include "hid_iap_class.h"
+#include "boot_manifest.h"
 
 /** @addtogroup UTILITIES_examples
   * @{
@@ -41,10 +42,10 @@ extern "C" {
   * @{
   */
 
-#define FLASH_APP_ADDRESS                0x08006000
+#define FLASH_APP_ADDRESS                BOOT_SLOT_B_ADDRESS
 
 void iap_init(void);
-iap_result_type iap_get_upgrade_flag(void);
+void iap_confirm_image(void);
 void app_loop(void);
 void jump_to_iap(uint32_t address);
 
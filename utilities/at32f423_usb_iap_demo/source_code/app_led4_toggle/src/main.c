@@ -53,7 +53,7 @@ void usb_low_power_wakeup_config(void);
   */
 int main(void)
 {
-  nvic_vector_table_set(NVIC_VECTTAB_FLASH, 0x6000);
+  nvic_vector_table_set(NVIC_VECTTAB_FLASH, FLASH_APP_ADDRESS - NVIC_VECTTAB_FLASH);
 
   system_clock_config();
 
@@ -87,8 +87,14 @@ int main(void)
             &hid_iap_class_handler,
             &hid_iap_desc_handler);
 
+  /* the image is up, stop the bootloader from rolling it back */
+  iap_confirm_image();
+
   while(1)
   {
+    /* the bootloader starts the watchdog for a trial boot */
+    wdt_counter_reload();
+
     app_loop();
     at32_led_toggle(LED4);
     delay_ms(200);
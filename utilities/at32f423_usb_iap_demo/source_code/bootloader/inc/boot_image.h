@@ -0,0 +1,74 @@
+/**
+  **************************************************************************
+  * @file     boot_image.h
+  * @brief    image trailer written by the host packer
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* define to prevent recursive inclusion -------------------------------------*/
+#ifndef __BOOT_IMAGE_H
+#define __BOOT_IMAGE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* no device header, the host packer builds with this file */
+#include <stdint.h>
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup USB_iap_bootloader
+  * @{
+  */
+
+#define BOOT_IMAGE_MAGIC                 0x474D4941
+
+/**
+  * @brief image trailer, appended by host_tool/iap_pack to the image padded
+  *        to a word. the download may pad it further with erased words.
+  *        image_crc is the hardware crc32 (poly 0x04C11DB7, init 0xFFFFFFFF,
+  *        bytes in address order) of the image followed by the version and
+  *        length words. all words are little endian.
+  */
+typedef struct
+{
+  uint32_t version;                                /*!< image version, must be higher than the one of the other slots */
+  uint32_t length;                                 /*!< image length in bytes without the trailer, multiple of 4 */
+  uint32_t image_crc;                              /*!< crc32 of the image, version and length */
+  uint32_t magic;                                  /*!< BOOT_IMAGE_MAGIC, last word of the trailer */
+}boot_image_trailer_type;
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
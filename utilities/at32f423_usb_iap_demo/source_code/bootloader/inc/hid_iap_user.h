@@ -32,6 +32,8 @@ extern "C" {
 #endif
 
 #include "hid_iap_class.h"
+#include "boot_manifest.h"
+#include "iap_window.h"
 
 /** @addtogroup UTILITIES_examples
   * @{
@@ -41,10 +43,9 @@ extern "C" {
   * @{
   */
 
-#define FLASH_APP_ADDRESS                0x08006000
+#define FLASH_APP_ADDRESS                BOOT_SLOT_A_ADDRESS
 
 void iap_init(void);
-iap_result_type iap_get_upgrade_flag(void);
 void iap_loop(void);
 void jump_to_app(uint32_t address);
 
@@ -0,0 +1,162 @@
+/**
+  **************************************************************************
+  * @file     iap_window.h
+  * @brief    iap windowed transfer header file
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* define to prevent recursive inclusion -------------------------------------*/
+#ifndef __IAP_WINDOW_H
+#define __IAP_WINDOW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* no device header, the flash and usb accesses go through the port functions
+   so that the transfer logic also builds into the host test */
+#include <stdint.h>
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup USB_iap_bootloader
+  * @{
+  */
+
+/**
+  * @brief window commands and results, same values as in hid_iap_class.h
+  */
+#define IAP_WINDOW_CMD_WSTART            0x5AA8
+#define IAP_WINDOW_CMD_WDATA             0x5AA9
+#define IAP_WINDOW_CMD_WFLUSH            0x5AAA
+#define IAP_WINDOW_ACK                   0xFF00
+#define IAP_WINDOW_NACK                  0x00FF
+#define IAP_WINDOW_REPORT_SIZE           64
+
+/**
+  * @brief windowed transfer, reports are staged in sector sized buffers
+  *        that are programmed by iap_window_poll while the next one is received.
+  *        wstart report:   cmd(2) address(4)
+  *        wstart respond:  cmd(2) result(2) window(2) data_len(2)
+  *        wdata report:    cmd(2) seq(2) len(2) data(len)
+  *        wdata respond:   cmd(2) result(2) seq(2) error(1), seq is the next
+  *                         expected report, nack if it was out of order
+  *        wflush respond:  same as wdata, sent when all data is in flash
+  */
+#ifndef IAP_WINDOW_BUFFER_SIZE
+#define IAP_WINDOW_BUFFER_SIZE           2048
+#endif
+#ifndef IAP_WINDOW_BUFFER_NUM
+#define IAP_WINDOW_BUFFER_NUM            2
+#endif
+#ifndef IAP_WINDOW_ACK_INTERVAL
+#define IAP_WINDOW_ACK_INTERVAL          16
+#endif
+#define IAP_WINDOW_SIZE                  (IAP_WINDOW_ACK_INTERVAL * 2)
+#define IAP_WINDOW_DATA_LEN              (IAP_WINDOW_REPORT_SIZE - 6)
+
+/**
+  * @brief window report result
+  */
+typedef enum
+{
+  IAP_WINDOW_OK,
+  IAP_WINDOW_HOLD,
+  IAP_WINDOW_ERROR
+}iap_window_result_type;
+
+/**
+  * @brief window staging buffer state
+  */
+typedef enum
+{
+  IAP_WBUF_FREE,
+  IAP_WBUF_FILL,
+  IAP_WBUF_READY
+}iap_wbuf_state_type;
+
+/**
+  * @brief window staging buffer
+  */
+typedef struct
+{
+  uint32_t data[IAP_WINDOW_BUFFER_SIZE / sizeof(uint32_t)];
+  uint32_t address;
+  uint32_t length;
+  volatile iap_wbuf_state_type state;
+}iap_wbuf_type;
+
+/**
+  * @brief windowed transfer state
+  */
+typedef struct
+{
+  iap_wbuf_type wbuf[IAP_WINDOW_BUFFER_NUM];
+  uint32_t fill_index;
+  uint32_t prog_index;
+  uint32_t address;
+  uint32_t end_address;
+  uint32_t slot_address;
+  uint32_t slot_size;
+  uint32_t sector_size;
+  uint8_t *hold_report;
+  uint32_t hold_len;
+  uint16_t seq;
+  uint16_t ack_seq;
+  volatile uint8_t active;
+  volatile uint8_t rx_hold;
+  volatile uint8_t ack_pending;
+  volatile uint8_t nack_sent;
+  volatile uint8_t flush;
+  volatile uint8_t error;
+}iap_window_type;
+
+extern iap_window_type iap_window;
+
+void iap_window_init(uint32_t slot_address, uint32_t slot_size, uint32_t sector_size);
+iap_window_result_type iap_window_start(uint8_t *pdata, uint32_t len, uint8_t *respond);
+iap_window_result_type iap_window_data(uint8_t *pdata, uint32_t len);
+uint8_t iap_window_flush(uint8_t *respond);
+void iap_window_stop(void);
+uint8_t iap_window_busy(void);
+void iap_window_poll(void);
+
+/* port functions, implemented by the bootloader or by the host test */
+void iap_window_port_erase(uint32_t address);
+uint8_t iap_window_port_program(uint32_t address, const uint32_t *data, uint32_t len);
+uint8_t iap_window_port_send(const uint8_t *report);
+void iap_window_port_resume(void);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,599 @@
+/**
+  **************************************************************************
+  * @file     boot_manifest.c
+  * @brief    image manifest, slot selection and rollback
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "boot_manifest.h"
+#include "boot_image.h"
+#include "hid_iap_class.h"
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup USB_iap_bootloader
+  * @{
+  */
+
+static const uint32_t boot_slot_address[BOOT_SLOT_NUM] =
+{
+  BOOT_SLOT_A_ADDRESS,
+  BOOT_SLOT_B_ADDRESS
+};
+
+static uint32_t image_slot = BOOT_SLOT_A_ADDRESS;
+static uint32_t image_end = BOOT_SLOT_A_ADDRESS;
+static uint32_t image_crc[BOOT_MAX_SECTOR_NUM];
+static confirm_state image_valid = FALSE;
+
+/**
+  * @brief  program one word of a manifest
+  * @param  address: word address
+  * @param  value: word value
+  * @retval SUCCESS or ERROR
+  */
+static error_status boot_word_program(uint32_t address, uint32_t value)
+{
+  flash_status_type status;
+
+  flash_unlock();
+  status = flash_word_program(address, value);
+  flash_lock();
+
+  return (status == FLASH_OPERATE_DONE) ? SUCCESS : ERROR;
+}
+
+/**
+  * @brief  continue a hardware crc32 over a number of words
+  * @param  crc_value: crc of the preceding words, 0xFFFFFFFF to start
+  * @param  pdata: words in the iap crc command order, NULL for erased words
+  * @param  wlen: word number
+  * @retval crc value
+  */
+static uint32_t boot_crc_update(uint32_t crc_value, const uint32_t *pdata, uint32_t wlen)
+{
+  uint32_t value = BOOT_WORD_ERASED, i_index;
+
+  crm_periph_clock_enable(CRM_CRC_PERIPH_CLOCK, TRUE);
+  crc_init_data_set(crc_value);
+  crc_data_reset();
+
+  for(i_index = 0; i_index < wlen; i_index ++)
+  {
+    if(pdata != NULL)
+    {
+      value = *pdata ++;
+    }
+    crc_one_word_calculate(CONVERT_ENDIAN(value));
+  }
+  crc_init_data_set(0xFFFFFFFF);
+  return crc_data_get();
+}
+
+/**
+  * @brief  hardware crc32 of a flash area, same word order as the iap crc command
+  * @param  address: start address, word aligned
+  * @param  size: byte size, multiple of 4
+  * @retval crc value
+  */
+uint32_t boot_sector_crc(uint32_t address, uint32_t size)
+{
+  return boot_crc_update(0xFFFFFFFF, (uint32_t *)address, size / sizeof(uint32_t));
+}
+
+/**
+  * @brief  add words to the crc of the new image sectors
+  * @param  offset: byte offset of the words in the slot, word aligned
+  * @param  pdata: words, NULL for erased words
+  * @param  wlen: word number
+  * @retval none
+  */
+static void boot_image_crc_add(uint32_t offset, const uint32_t *pdata, uint32_t wlen)
+{
+  uint32_t sector_size = iap_info.sector_size;
+  uint32_t sector, count;
+
+  while(wlen > 0)
+  {
+    sector = offset / sector_size;
+    count = (sector_size - offset % sector_size) / sizeof(uint32_t);
+    if(count > wlen)
+    {
+      count = wlen;
+    }
+
+    if(offset % sector_size == 0)
+    {
+      image_crc[sector] = 0xFFFFFFFF;
+    }
+    image_crc[sector] = boot_crc_update(image_crc[sector], pdata, count);
+
+    offset += count * sizeof(uint32_t);
+    wlen -= count;
+    if(pdata != NULL)
+    {
+      pdata += count;
+    }
+  }
+}
+
+/**
+  * @brief  get the manifest address of a slot
+  * @param  slot_address: slot start address
+  * @retval manifest address
+  */
+uint32_t boot_manifest_address(uint32_t slot_address)
+{
+  return slot_address - iap_info.sector_size;
+}
+
+/**
+  * @brief  get the byte size of an application slot
+  * @param  none
+  * @retval slot size
+  */
+uint32_t boot_slot_size(void)
+{
+  return BOOT_SLOT_B_ADDRESS - BOOT_SLOT_A_ADDRESS - iap_info.sector_size;
+}
+
+/**
+  * @brief  get the number of slots the device flash can hold
+  * @param  none
+  * @retval slot number
+  */
+static uint32_t boot_slot_count(void)
+{
+  if(BOOT_SLOT_B_ADDRESS + boot_slot_size() <= iap_info.flash_end_address)
+  {
+    return BOOT_SLOT_NUM;
+  }
+  return 1;
+}
+
+/**
+  * @brief  check the manifest header and the image vectors of a slot
+  * @param  slot_address: slot start address
+  * @param  check_revoke: TRUE to treat a revoked slot as invalid
+  * @retval TRUE if the manifest is usable
+  */
+static confirm_state boot_manifest_valid(uint32_t slot_address, confirm_state check_revoke)
+{
+  boot_manifest_type *manifest = BOOT_MANIFEST(boot_manifest_address(slot_address));
+  uint32_t stack = *(uint32_t *)slot_address;
+  uint32_t reset = *(uint32_t *)(slot_address + sizeof(uint32_t));
+
+  if(manifest->magic != BOOT_MANIFEST_MAGIC ||
+     manifest->sector_size != iap_info.sector_size ||
+     manifest->sector_num == 0 ||
+     manifest->sector_num > BOOT_MAX_SECTOR_NUM ||
+     manifest->length > manifest->sector_num * manifest->sector_size ||
+     manifest->length > boot_slot_size())
+  {
+    return FALSE;
+  }
+
+  if(manifest->manifest_crc != boot_sector_crc((uint32_t)&manifest->version,
+                                               (4 + manifest->sector_num) * sizeof(uint32_t)))
+  {
+    return FALSE;
+  }
+
+  /* an image linked for the other slot must not be started from here */
+  if((stack & 0xFFF00000) != SRAM_BASE ||
+     reset < slot_address || reset >= slot_address + manifest->length)
+  {
+    return FALSE;
+  }
+
+  if(check_revoke == TRUE && manifest->revoke != BOOT_WORD_ERASED)
+  {
+    return FALSE;
+  }
+  return TRUE;
+}
+
+/**
+  * @brief  check the dirty sectors of a slot against the manifest and mark them verified
+  * @param  slot_address: slot start address
+  * @retval SUCCESS or ERROR
+  */
+static error_status boot_image_verify(uint32_t slot_address)
+{
+  boot_manifest_type *manifest = BOOT_MANIFEST(boot_manifest_address(slot_address));
+  uint32_t sector_size = manifest->sector_size;
+  uint32_t i_index;
+
+  for(i_index = 0; i_index < manifest->sector_num; i_index ++)
+  {
+    if(manifest->verified[i_index] != BOOT_SECTOR_DIRTY)
+    {
+      continue;
+    }
+
+    if(boot_sector_crc(slot_address + i_index * sector_size, sector_size) != manifest->sector_crc[i_index])
+    {
+      return ERROR;
+    }
+
+    flash_unlock();
+    flash_halfword_program((uint32_t)&manifest->verified[i_index], BOOT_SECTOR_VERIFIED);
+    flash_lock();
+  }
+  return SUCCESS;
+}
+
+/**
+  * @brief  mark a slot as revoked so that the other slot is booted
+  * @param  slot_address: slot start address
+  * @retval none
+  */
+static void boot_slot_revoke(uint32_t slot_address)
+{
+  boot_manifest_type *manifest = BOOT_MANIFEST(boot_manifest_address(slot_address));
+
+  if(manifest->revoke == BOOT_WORD_ERASED)
+  {
+    boot_word_program((uint32_t)&manifest->revoke, BOOT_WORD_SET);
+  }
+}
+
+/**
+  * @brief  start the watchdog for a trial boot of an unconfirmed image
+  * @param  none
+  * @retval none
+  */
+static void boot_wdt_start(void)
+{
+  wdt_register_write_enable(TRUE);
+  wdt_divider_set(BOOT_WDT_DIVIDER);
+  wdt_reload_value_set(BOOT_WDT_RELOAD);
+  wdt_counter_reload();
+  wdt_enable();
+}
+
+/**
+  * @brief  check if the application of a slot has an iap request not served yet
+  * @param  slot_address: slot start address
+  * @retval TRUE if a request is pending
+  */
+static confirm_state boot_request_pending(uint32_t slot_address)
+{
+  boot_manifest_type *manifest = BOOT_MANIFEST(boot_manifest_address(slot_address));
+  uint32_t i_index;
+
+  for(i_index = 0; i_index < BOOT_MAX_REQUESTS; i_index ++)
+  {
+    if(manifest->request[i_index] != BOOT_WORD_ERASED && manifest->served[i_index] == BOOT_WORD_ERASED)
+    {
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+/**
+  * @brief  select the image to boot
+  *         - a watchdog reset during a trial boot revokes the unconfirmed image.
+  *         - an iap request pending in a valid slot keeps the bootloader in iap mode.
+  *         - valid slots are tried from the highest version down, only sectors
+  *           not verified since they were programmed are checked with the crc.
+  *         - an unconfirmed image gets BOOT_MAX_ATTEMPTS boots under the watchdog.
+  * @param  none
+  * @retval slot address to jump to, 0 to stay in iap mode
+  */
+uint32_t boot_select(void)
+{
+  boot_manifest_type *manifest;
+  uint32_t slot[BOOT_SLOT_NUM];
+  uint32_t slot_num = 0, slot_count = boot_slot_count();
+  uint32_t i_index, temp;
+
+  for(i_index = 0; i_index < slot_count; i_index ++)
+  {
+    if(boot_manifest_valid(boot_slot_address[i_index], TRUE) == FALSE)
+    {
+      continue;
+    }
+
+    manifest = BOOT_MANIFEST(boot_manifest_address(boot_slot_address[i_index]));
+    if(crm_flag_get(CRM_WDT_RESET_FLAG) != RESET &&
+       manifest->confirm == BOOT_WORD_ERASED && manifest->attempt[0] != BOOT_WORD_ERASED)
+    {
+      boot_slot_revoke(boot_slot_address[i_index]);
+      continue;
+    }
+    slot[slot_num ++] = boot_slot_address[i_index];
+  }
+  crm_flag_clear(CRM_WDT_RESET_FLAG);
+
+  /* iap requested by the running application */
+  for(i_index = 0; i_index < slot_num; i_index ++)
+  {
+    if(boot_request_pending(slot[i_index]) == TRUE)
+    {
+      return 0;
+    }
+  }
+
+  if(slot_num == BOOT_SLOT_NUM &&
+     BOOT_MANIFEST(boot_manifest_address(slot[1]))->version >
+     BOOT_MANIFEST(boot_manifest_address(slot[0]))->version)
+  {
+    temp = slot[0];
+    slot[0] = slot[1];
+    slot[1] = temp;
+  }
+
+  for(i_index = 0; i_index < slot_num; i_index ++)
+  {
+    manifest = BOOT_MANIFEST(boot_manifest_address(slot[i_index]));
+
+    if(boot_image_verify(slot[i_index]) != SUCCESS)
+    {
+      boot_slot_revoke(slot[i_index]);
+      continue;
+    }
+
+    if(manifest->confirm == BOOT_WORD_ERASED)
+    {
+      for(temp = 0; temp < BOOT_MAX_ATTEMPTS; temp ++)
+      {
+        if(manifest->attempt[temp] == BOOT_WORD_ERASED)
+        {
+          break;
+        }
+      }
+
+      /* all trial boots used without confirmation */
+      if(temp == BOOT_MAX_ATTEMPTS)
+      {
+        boot_slot_revoke(slot[i_index]);
+        continue;
+      }
+
+      boot_word_program((uint32_t)&manifest->attempt[temp], BOOT_WORD_SET);
+      boot_wdt_start();
+    }
+    return slot[i_index];
+  }
+
+  return 0;
+}
+
+/**
+  * @brief  get the slot a new image is downloaded to, that is an unused or
+  *         revoked slot, otherwise the slot holding the older version
+  * @param  none
+  * @retval slot address
+  */
+uint32_t boot_target_slot(void)
+{
+  uint32_t i_index, slot_count = boot_slot_count();
+
+  for(i_index = 0; i_index < slot_count; i_index ++)
+  {
+    if(boot_manifest_valid(boot_slot_address[i_index], TRUE) == FALSE)
+    {
+      return boot_slot_address[i_index];
+    }
+  }
+
+  if(slot_count == BOOT_SLOT_NUM &&
+     BOOT_MANIFEST(boot_manifest_address(BOOT_SLOT_B_ADDRESS))->version <
+     BOOT_MANIFEST(boot_manifest_address(BOOT_SLOT_A_ADDRESS))->version)
+  {
+    return BOOT_SLOT_B_ADDRESS;
+  }
+  return BOOT_SLOT_A_ADDRESS;
+}
+
+/**
+  * @brief  invalidate the manifest of the slot a new image is written to,
+  *         pending iap requests of the other slots are marked served, their
+  *         manifests are kept for a rollback.
+  * @param  slot_address: slot start address
+  * @retval none
+  */
+void boot_image_begin(uint32_t slot_address)
+{
+  boot_manifest_type *manifest;
+  uint32_t i_index, temp;
+
+  for(i_index = 0; i_index < boot_slot_count(); i_index ++)
+  {
+    if(boot_slot_address[i_index] == slot_address)
+    {
+      continue;
+    }
+
+    manifest = BOOT_MANIFEST(boot_manifest_address(boot_slot_address[i_index]));
+    for(temp = 0; temp < BOOT_MAX_REQUESTS; temp ++)
+    {
+      if(manifest->request[temp] != BOOT_WORD_ERASED && manifest->served[temp] == BOOT_WORD_ERASED)
+      {
+        boot_word_program((uint32_t)&manifest->served[temp], BOOT_WORD_SET);
+      }
+    }
+  }
+
+  image_slot = slot_address;
+  image_end = slot_address;
+  image_valid = TRUE;
+
+  /* a sector size larger than BOOT_MAX_SECTOR_SIZE puts the manifest into the bootloader */
+  if(boot_manifest_address(slot_address) < FLASH_BASE + BOOT_LOADER_SIZE)
+  {
+    image_valid = FALSE;
+    return;
+  }
+
+  flash_unlock();
+  flash_sector_erase(boot_manifest_address(slot_address));
+  flash_lock();
+}
+
+/**
+  * @brief  record a block of the new image before it is programmed, the sector
+  *         crc is taken from the received data so a program error is found
+  *         when the flash is checked against it.
+  * @param  address: block address
+  * @param  data: block data
+  * @param  len: block length, multiple of 4
+  * @retval none
+  */
+void boot_image_block(uint32_t address, const uint32_t *data, uint32_t len)
+{
+  /* blocks are written in address order, a gap is left erased */
+  if(address < image_end || address + len > image_slot + boot_slot_size())
+  {
+    image_valid = FALSE;
+    return;
+  }
+
+  boot_image_crc_add(image_end - image_slot, NULL, (address - image_end) / sizeof(uint32_t));
+  boot_image_crc_add(address - image_slot, data, len / sizeof(uint32_t));
+  image_end = address + len;
+}
+
+/**
+  * @brief  find and check the trailer the host packer appended to the new image
+  * @param  length: programmed length from the slot start
+  * @retval trailer, NULL if there is none or the image crc does not match
+  */
+static boot_image_trailer_type *boot_image_trailer(uint32_t length)
+{
+  boot_image_trailer_type *trailer;
+  uint32_t address = image_slot + length;
+
+  /* the download pads the trailer with erased words to its block size */
+  while(address > image_slot + sizeof(boot_image_trailer_type) &&
+        image_slot + length - address < iap_info.sector_size &&
+        *(uint32_t *)(address - sizeof(uint32_t)) == BOOT_WORD_ERASED)
+  {
+    address -= sizeof(uint32_t);
+  }
+
+  if(address < image_slot + sizeof(boot_image_trailer_type))
+  {
+    return NULL;
+  }
+
+  trailer = (boot_image_trailer_type *)(address - sizeof(boot_image_trailer_type));
+  if(trailer->magic != BOOT_IMAGE_MAGIC ||
+     trailer->length != (uint32_t)trailer - image_slot)
+  {
+    return NULL;
+  }
+
+  /* the image, version and length words as the packer computed it */
+  if(boot_sector_crc(image_slot, trailer->length + 2 * sizeof(uint32_t)) != trailer->image_crc)
+  {
+    return NULL;
+  }
+  return trailer;
+}
+
+/**
+  * @brief  build the manifest of the new image from the received data, the
+  *         flash is checked against it first. the version is taken from the
+  *         trailer of the host packer, whose crc covers the whole image. the magic word is programmed
+  *         last so an interrupted write leaves the slot invalid.
+  * @param  none
+  * @retval SUCCESS or ERROR
+  */
+error_status boot_image_finish(void)
+{
+  boot_manifest_type *manifest = BOOT_MANIFEST(boot_manifest_address(image_slot));
+  boot_manifest_type *other;
+  uint32_t sector_size = iap_info.sector_size;
+  uint32_t length = image_end - image_slot;
+  uint32_t sector_num = (length + sector_size - 1) / sector_size;
+  boot_image_trailer_type *trailer;
+  uint32_t crc_value, i_index;
+
+  if(image_valid == FALSE || length == 0 || sector_num > BOOT_MAX_SECTOR_NUM ||
+     manifest->magic != BOOT_WORD_ERASED)
+  {
+    return ERROR;
+  }
+
+  /* the rest of the last sector is erased */
+  boot_image_crc_add(length, NULL, (sector_num * sector_size - length) / sizeof(uint32_t));
+
+  for(i_index = 0; i_index < sector_num; i_index ++)
+  {
+    if(boot_sector_crc(image_slot + i_index * sector_size, sector_size) != image_crc[i_index])
+    {
+      return ERROR;
+    }
+  }
+
+  trailer = boot_image_trailer(length);
+  if(trailer == NULL)
+  {
+    return ERROR;
+  }
+
+  /* the new image is newer than anything in the other slots, revoked or not */
+  for(i_index = 0; i_index < boot_slot_count(); i_index ++)
+  {
+    other = BOOT_MANIFEST(boot_manifest_address(boot_slot_address[i_index]));
+    if(other != manifest && other->magic == BOOT_MANIFEST_MAGIC && other->version >= trailer->version)
+    {
+      return ERROR;
+    }
+  }
+
+  if(boot_word_program((uint32_t)&manifest->version, trailer->version) != SUCCESS ||
+     boot_word_program((uint32_t)&manifest->length, length) != SUCCESS ||
+     boot_word_program((uint32_t)&manifest->sector_size, sector_size) != SUCCESS ||
+     boot_word_program((uint32_t)&manifest->sector_num, sector_num) != SUCCESS)
+  {
+    return ERROR;
+  }
+
+  for(i_index = 0; i_index < sector_num; i_index ++)
+  {
+    if(boot_word_program((uint32_t)&manifest->sector_crc[i_index], image_crc[i_index]) != SUCCESS)
+    {
+      return ERROR;
+    }
+  }
+
+  crc_value = boot_sector_crc((uint32_t)&manifest->version, (4 + sector_num) * sizeof(uint32_t));
+  if(boot_word_program((uint32_t)&manifest->manifest_crc, crc_value) != SUCCESS)
+  {
+    return ERROR;
+  }
+
+  return boot_word_program((uint32_t)&manifest->magic, BOOT_MANIFEST_MAGIC);
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
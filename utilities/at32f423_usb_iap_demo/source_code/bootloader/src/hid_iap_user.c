@@ -25,6 +25,7 @@
 
 #include "hid_iap_user.h"
 #include "hid_iap_class.h"
+#include "boot_manifest.h"
 #include "string.h"
 
 /** @addtogroup UTILITIES_examples
@@ -37,7 +38,7 @@
 
 void (*pftarget)(void);
 void iap_clear_upgrade_flag(void);
-void iap_set_upgrade_flag(void);
+error_status iap_set_upgrade_flag(void);
 uint32_t crc_cal(uint32_t addr, uint16_t nk);
 
 void iap_idle(void);
@@ -47,7 +48,20 @@ void iap_finish(void);
 iap_result_type iap_data_write(uint8_t *pdata, uint32_t len);
 void iap_jump(void);
 void iap_respond(uint8_t *res_buf, uint16_t iap_cmd, uint16_t result);
+void iap_window_begin(uint8_t *pdata, uint32_t len);
 uint32_t stkptr, jumpaddr;
+
+#if (IAP_WINDOW_CMD_WSTART != IAP_CMD_WSTART) || (IAP_WINDOW_CMD_WDATA != IAP_CMD_WDATA) || \
+    (IAP_WINDOW_CMD_WFLUSH != IAP_CMD_WFLUSH) || (IAP_WINDOW_REPORT_SIZE != USBD_HIDIAP_IN_MAXPACKET_SIZE)
+#error "iap_window.h does not match hid_iap_class.h"
+#endif
+
+/* the in endpoint is shared by the responds sent from the otg interrupt and
+   the window responds sent from the main loop */
+static uint8_t iap_window_tx[USBD_HIDIAP_IN_MAXPACKET_SIZE];
+static volatile uint8_t iap_tx_busy = 0;
+static volatile uint8_t iap_tx_defer = 0;
+static void *iap_udev;
 /* app_load don't optimize */
 #if defined (__ARMCC_VERSION)
  #if (__ARMCC_VERSION >= 6010050)
@@ -87,45 +101,23 @@ void jump_to_app(uint32_t address)
 }
 
 /**
-  * @brief  clear iap upgrade flag
+  * @brief  clear iap upgrade flag, the manifest of the target slot is erased
   * @param  none
   * @retval none
   */
 void iap_clear_upgrade_flag(void)
 {
-  flash_unlock();
-  flash_sector_erase(iap_info.flag_address);
-  flash_lock();
+  boot_image_begin(iap_info.app_address);
 }
 
 /**
-  * @brief  set iap upgrade complete flag
+  * @brief  set iap upgrade complete flag, the manifest of the target slot is written
   * @param  none
-  * @retval none
+  * @retval SUCCESS or ERROR
   */
-void iap_set_upgrade_flag(void)
+error_status iap_set_upgrade_flag(void)
 {
-  flash_unlock();
-  flash_word_program(iap_info.flag_address, IAP_UPGRADE_COMPLETE_FLAG);
-  flash_lock();
-}
-
-/**
-  * @brief  get iap upgrade complete flag
-  * @param  none
-  * @retval the status of the iap flag
-  */
-iap_result_type iap_get_upgrade_flag(void)
-{
-  uint32_t flag_address = iap_info.flag_address;
-  if(*((uint32_t *)flag_address) == IAP_UPGRADE_COMPLETE_FLAG)
-  {
-    return IAP_SUCCESS;
-  }
-  else
-  {
-    return IAP_FAILED;
-  }
+  return boot_image_finish();
 }
 
 /**
@@ -166,20 +158,7 @@ void iap_erase_sector(uint32_t address)
   */
 uint32_t crc_cal(uint32_t addr, uint16_t nk)
 {
-  uint32_t *paddr = (uint32_t *)addr;
-  uint32_t wlen = nk * 1024 / sizeof(uint32_t);
-  uint32_t value, i_index = 0;
-  crm_periph_clock_enable(CRM_CRC_PERIPH_CLOCK, TRUE);
-  crc_data_reset();
-
-  for(i_index = 0; i_index < wlen; i_index ++)
-  {
-    value = *paddr;
-    crc_one_word_calculate(CONVERT_ENDIAN(value));
-
-    paddr ++;
-  }
-  return crc_data_get();
+  return boot_sector_crc(addr, nk * 1024);
 }
 
 /**
@@ -212,11 +191,14 @@ void iap_init(void)
   iap_info.flash_start_address = FLASH_BASE;
   iap_info.flash_end_address = iap_info.flash_start_address + iap_info.flash_size;
 
-  iap_info.app_address = FLASH_APP_ADDRESS;
-  iap_info.flag_address = iap_info.app_address - iap_info.sector_size;
+  /* new images are written to the unused or older slot */
+  iap_info.app_address = boot_target_slot();
+  iap_info.flag_address = boot_manifest_address(iap_info.app_address);
 
   iap_info.fifo_length = 0;
   iap_info.iap_address = 0;
+
+  iap_window_init(iap_info.app_address, boot_slot_size(), iap_info.sector_size);
 }
 
 /**
@@ -262,7 +244,7 @@ iap_result_type iap_address(uint8_t *pdata, uint32_t len)
              paddr[3];
 
   /* check the address is valid */
-  if(address < iap_info.app_address || address > iap_info.flash_end_address)
+  if(address < iap_info.app_address || address >= iap_info.app_address + boot_slot_size())
   {
     status = IAP_FAILED;
     result = IAP_NACK;
@@ -309,6 +291,7 @@ iap_result_type iap_data_write(uint8_t *pdata, uint32_t len)
     /* buffer full */
     if(iap_info.fifo_length == HID_IAP_BUFFER_LEN)
     {
+      boot_image_block(iap_info.iap_address, (uint32_t *)iap_info.iap_fifo, iap_info.fifo_length);
       flash_unlock();
       pbuf = (uint32_t *)iap_info.iap_fifo;
       for(i_index = 0; i_index < iap_info.fifo_length / sizeof(uint32_t); i_index ++)
@@ -337,9 +320,22 @@ iap_result_type iap_data_write(uint8_t *pdata, uint32_t len)
   */
 void iap_finish()
 {
+  /* the write-behind buffers must be programmed before the manifest */
+  if(iap_window_busy())
+  {
+    iap_respond(iap_info.iap_tx, IAP_CMD_FINISH, IAP_NACK);
+    return;
+  }
+
   iap_info.state = IAP_STS_FINISH;
-  iap_set_upgrade_flag();
-  iap_respond(iap_info.iap_tx, IAP_CMD_FINISH, IAP_ACK);
+  if(iap_window.error == 0 && iap_set_upgrade_flag() == SUCCESS)
+  {
+    iap_respond(iap_info.iap_tx, IAP_CMD_FINISH, IAP_ACK);
+  }
+  else
+  {
+    iap_respond(iap_info.iap_tx, IAP_CMD_FINISH, IAP_NACK);
+  }
 }
 
 /*
@@ -398,6 +394,101 @@ void iap_get()
 
 
 
+/**
+  * @brief  iap window start, the manifest of the target slot is erased
+  *         before the first window of a download
+  * @param  pdata: data buffer pointer.
+  * @param  len: data length
+  * @retval none
+  */
+void iap_window_begin(uint8_t *pdata, uint32_t len)
+{
+  if(iap_window_start(pdata, len, iap_info.iap_tx) == IAP_WINDOW_OK)
+  {
+    if(iap_info.state == IAP_STS_START)
+    {
+      iap_clear_upgrade_flag();
+    }
+    iap_info.state = IAP_STS_WINDOW;
+  }
+  iap_info.respond_flag = 1;
+}
+
+/**
+  * @brief  erase a flash sector for the window transfer
+  * @param  address: sector address
+  * @retval none
+  */
+void iap_window_port_erase(uint32_t address)
+{
+  flash_unlock();
+  flash_sector_erase(address);
+  flash_lock();
+}
+
+/**
+  * @brief  program a staged block of the window transfer
+  * @param  address: block address
+  * @param  data: block data
+  * @param  len: block length, multiple of 4
+  * @retval 0 if programmed, 1 on a program error
+  */
+uint8_t iap_window_port_program(uint32_t address, const uint32_t *data, uint32_t len)
+{
+  uint32_t i_index;
+  uint8_t result = 0;
+
+  boot_image_block(address, data, len);
+
+  flash_unlock();
+  for(i_index = 0; i_index < len / sizeof(uint32_t); i_index ++)
+  {
+    if(flash_word_program(address, data[i_index]) != FLASH_OPERATE_DONE)
+    {
+      result = 1;
+    }
+    address += sizeof(uint32_t);
+  }
+  flash_lock();
+
+  return result;
+}
+
+/**
+  * @brief  send a window respond from the main loop, the check of the in
+  *         endpoint and the send are not interrupted by the otg interrupt
+  * @param  report: respond report
+  * @retval 1 if sent, 0 if the in endpoint is busy
+  */
+uint8_t iap_window_port_send(const uint8_t *report)
+{
+  uint8_t sent = 0;
+
+  __disable_irq();
+  if(iap_tx_busy == 0)
+  {
+    memcpy(iap_window_tx, report, sizeof(iap_window_tx));
+    iap_tx_busy = 1;
+    usb_iap_class_send_report(iap_udev, iap_window_tx, sizeof(iap_window_tx));
+    sent = 1;
+  }
+  __enable_irq();
+
+  return sent;
+}
+
+/**
+  * @brief  restart the out endpoint from the main loop after a held report
+  * @param  none
+  * @retval none
+  */
+void iap_window_port_resume(void)
+{
+  __disable_irq();
+  usb_iap_class_recv_resume(iap_udev);
+  __enable_irq();
+}
+
 /*
   * @brief  iap respond
   * @param  res_buf: data buffer pointer.
@@ -433,9 +524,16 @@ iap_result_type usbd_hid_iap_process(void *udev, uint8_t *pdata, uint16_t len)
   }
 
   iap_info.respond_flag = 0;
+  iap_udev = udev;
 
   iap_cmd = (pdata[0] << 8) | pdata[1];
 
+  /* any other command ends the window transfer */
+  if(iap_cmd != IAP_CMD_WDATA && iap_cmd != IAP_CMD_WFLUSH)
+  {
+    iap_window_stop();
+  }
+
   switch(iap_cmd)
   {
     case IAP_CMD_IDLE:
@@ -462,14 +560,43 @@ iap_result_type usbd_hid_iap_process(void *udev, uint8_t *pdata, uint16_t len)
     case IAP_CMD_GET:
       iap_get();
       break;
+    case IAP_CMD_WSTART:
+      iap_window_begin(pdata, len);
+      break;
+    case IAP_CMD_WDATA:
+      /* answered by iap_window_poll */
+      switch(iap_window_data(pdata, len))
+      {
+        case IAP_WINDOW_OK:
+          break;
+        case IAP_WINDOW_HOLD:
+          status = IAP_WAIT;
+          break;
+        default:
+          status = IAP_FAILED;
+          break;
+      }
+      break;
+    case IAP_CMD_WFLUSH:
+      iap_info.respond_flag = iap_window_flush(iap_info.iap_tx);
+      break;
     default:
       status = IAP_FAILED;
       break;
   }
 
+  /* a window respond is in flight, send this one when it completes */
   if(iap_info.respond_flag)
   {
-    usb_iap_class_send_report(udev, iap_info.iap_tx, 64);
+    if(iap_tx_busy)
+    {
+      iap_tx_defer = 1;
+    }
+    else
+    {
+      iap_tx_busy = 1;
+      usb_iap_class_send_report(udev, iap_info.iap_tx, 64);
+    }
   }
 
   return status;
@@ -482,6 +609,16 @@ iap_result_type usbd_hid_iap_process(void *udev, uint8_t *pdata, uint16_t len)
   */
 void usbd_hid_iap_in_complete(void *udev)
 {
+  iap_tx_busy = 0;
+
+  if(iap_tx_defer)
+  {
+    iap_tx_defer = 0;
+    iap_tx_busy = 1;
+    usb_iap_class_send_report(udev, iap_info.iap_tx, 64);
+    return;
+  }
+
   if(iap_info.state == IAP_STS_JMP_WAIT)
   {
     iap_info.state = IAP_STS_JMP;
@@ -495,10 +632,14 @@ void usbd_hid_iap_in_complete(void *udev)
   */
 void iap_loop(void)
 {
+  iap_window_poll();
+
   if(iap_info.state == IAP_STS_JMP)
   {
     delay_ms(100);
-    jump_to_app(iap_info.app_address);
+
+    /* restart so that the new image is verified and selected by boot_select */
+    nvic_system_reset();
   }
 }
 
@@ -0,0 +1,382 @@
+/**
+  **************************************************************************
+  * @file     iap_window.c
+  * @brief    iap windowed transfer with flash write-behind
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "iap_window.h"
+#include "string.h"
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup USB_iap_bootloader
+  * @{
+  */
+
+iap_window_type iap_window;
+
+/**
+  * @brief  write the command and result of a window respond
+  * @param  respond: respond report
+  * @param  iap_cmd: iap command
+  * @param  result: IAP_WINDOW_ACK or IAP_WINDOW_NACK
+  * @retval none
+  */
+static void iap_window_header(uint8_t *respond, uint16_t iap_cmd, uint16_t result)
+{
+  memset(respond, 0, IAP_WINDOW_REPORT_SIZE);
+  respond[0] = (uint8_t)((iap_cmd >> 8) & 0xFF);
+  respond[1] = (uint8_t)((iap_cmd) & 0xFF);
+  respond[2] = (uint8_t)((result >> 8) & 0xFF);
+  respond[3] = (uint8_t)((result) & 0xFF);
+}
+
+/**
+  * @brief  get the free space of the window staging buffers
+  * @param  none
+  * @retval free bytes
+  */
+static uint32_t iap_window_space(void)
+{
+  uint32_t i_index, space = 0;
+
+  for(i_index = 0; i_index < IAP_WINDOW_BUFFER_NUM; i_index ++)
+  {
+    if(iap_window.wbuf[i_index].state == IAP_WBUF_FREE)
+    {
+      space += IAP_WINDOW_BUFFER_SIZE;
+    }
+    else if(iap_window.wbuf[i_index].state == IAP_WBUF_FILL)
+    {
+      space += IAP_WINDOW_BUFFER_SIZE - iap_window.wbuf[i_index].length;
+    }
+  }
+  return space;
+}
+
+/**
+  * @brief  set the slot the window transfer may write to, any transfer is stopped
+  * @param  slot_address: slot start address
+  * @param  slot_size: slot byte size
+  * @param  sector_size: flash sector size
+  * @retval none
+  */
+void iap_window_init(uint32_t slot_address, uint32_t slot_size, uint32_t sector_size)
+{
+  iap_window_stop();
+  iap_window.slot_address = slot_address;
+  iap_window.slot_size = slot_size;
+  iap_window.sector_size = sector_size;
+}
+
+/**
+  * @brief  iap window start, the following wdata reports are written from this address
+  * @param  pdata: data buffer pointer.
+  * @param  len: data length
+  * @param  respond: respond report
+  * @retval IAP_WINDOW_OK if the window is open
+  */
+iap_window_result_type iap_window_start(uint8_t *pdata, uint32_t len, uint8_t *respond)
+{
+  uint8_t *paddr = pdata + 2;   /* skip iap cmd */
+  uint32_t address, i_index;
+
+  address = (paddr[0] << 24) |
+            (paddr[1] << 16) |
+            (paddr[2] << 8) |
+             paddr[3];
+
+  /* the window starts on a sector of the target slot with no write pending */
+  if(len < 6 ||
+     address < iap_window.slot_address || address >= iap_window.slot_address + iap_window.slot_size ||
+     (address & (iap_window.sector_size - 1)) != 0 || iap_window_busy())
+  {
+    iap_window_header(respond, IAP_WINDOW_CMD_WSTART, IAP_WINDOW_NACK);
+    return IAP_WINDOW_ERROR;
+  }
+
+  for(i_index = 0; i_index < IAP_WINDOW_BUFFER_NUM; i_index ++)
+  {
+    iap_window.wbuf[i_index].length = 0;
+  }
+  iap_window.fill_index = 0;
+  iap_window.prog_index = 0;
+  iap_window.address = address;
+  iap_window.end_address = iap_window.slot_address + iap_window.slot_size;
+  iap_window.seq = 0;
+  iap_window.ack_seq = 0;
+  iap_window.rx_hold = 0;
+  iap_window.ack_pending = 0;
+  iap_window.nack_sent = 0;
+  iap_window.flush = 0;
+  iap_window.error = 0;
+  iap_window.active = 1;
+
+  /* tell the host how many reports it may send ahead and their payload */
+  iap_window_header(respond, IAP_WINDOW_CMD_WSTART, IAP_WINDOW_ACK);
+  respond[4] = (uint8_t)((IAP_WINDOW_SIZE >> 8) & 0xFF);
+  respond[5] = (uint8_t)((IAP_WINDOW_SIZE) & 0xFF);
+  respond[6] = (uint8_t)((IAP_WINDOW_DATA_LEN >> 8) & 0xFF);
+  respond[7] = (uint8_t)((IAP_WINDOW_DATA_LEN) & 0xFF);
+  return IAP_WINDOW_OK;
+}
+
+/**
+  * @brief  iap window data, the report is copied to the staging buffers and
+  *         acknowledged every IAP_WINDOW_ACK_INTERVAL reports by iap_window_poll
+  * @param  pdata: data buffer pointer.
+  * @param  len: buffer length
+  * @retval IAP_WINDOW_HOLD if the report must be kept until a buffer is free
+  */
+iap_window_result_type iap_window_data(uint8_t *pdata, uint32_t len)
+{
+  uint16_t seq = (pdata[2] << 8) | pdata[3];
+  uint32_t data_len = (pdata[4] << 8) | pdata[5];
+  uint8_t *valid_data = pdata + 6;
+  iap_wbuf_type *pbuf;
+  uint32_t copy_len;
+
+  if(iap_window.active == 0 || iap_window.flush || len < 6 ||
+     data_len > IAP_WINDOW_DATA_LEN || data_len + 6 > len ||
+     iap_window.address + data_len > iap_window.end_address)
+  {
+    iap_window.error = 1;
+    iap_window.ack_pending = 1;
+    return IAP_WINDOW_ERROR;
+  }
+
+  /* out of order report, answer once with the expected sequence */
+  if(seq != iap_window.seq)
+  {
+    if(iap_window.nack_sent == 0)
+    {
+      iap_window.nack_sent = 1;
+      iap_window.ack_pending = 1;
+    }
+    return IAP_WINDOW_ERROR;
+  }
+
+  if(iap_window_space() < data_len)
+  {
+    iap_window.hold_report = pdata;
+    iap_window.hold_len = len;
+    iap_window.rx_hold = 1;
+    return IAP_WINDOW_HOLD;
+  }
+
+  while(data_len > 0)
+  {
+    pbuf = &iap_window.wbuf[iap_window.fill_index];
+    if(pbuf->state == IAP_WBUF_FREE)
+    {
+      pbuf->address = iap_window.address;
+      pbuf->length = 0;
+      pbuf->state = IAP_WBUF_FILL;
+    }
+
+    copy_len = IAP_WINDOW_BUFFER_SIZE - pbuf->length;
+    if(copy_len > data_len)
+    {
+      copy_len = data_len;
+    }
+    memcpy((uint8_t *)pbuf->data + pbuf->length, valid_data, copy_len);
+    pbuf->length += copy_len;
+    iap_window.address += copy_len;
+    valid_data += copy_len;
+    data_len -= copy_len;
+
+    /* hand the full buffer to the write-behind */
+    if(pbuf->length == IAP_WINDOW_BUFFER_SIZE)
+    {
+      pbuf->state = IAP_WBUF_READY;
+      iap_window.fill_index = (iap_window.fill_index + 1) % IAP_WINDOW_BUFFER_NUM;
+    }
+  }
+
+  iap_window.seq ++;
+  iap_window.nack_sent = 0;
+  if((uint16_t)(iap_window.seq - iap_window.ack_seq) >= IAP_WINDOW_ACK_INTERVAL)
+  {
+    iap_window.ack_pending = 1;
+  }
+  return IAP_WINDOW_OK;
+}
+
+/**
+  * @brief  iap window flush, the partly filled buffer is padded and programmed,
+  *         iap_window_poll responds when all buffers are written
+  * @param  respond: respond report
+  * @retval 1 if the respond was written now, 0 if it is sent by iap_window_poll
+  */
+uint8_t iap_window_flush(uint8_t *respond)
+{
+  iap_wbuf_type *pbuf = &iap_window.wbuf[iap_window.fill_index];
+
+  if(iap_window.active == 0)
+  {
+    iap_window_header(respond, IAP_WINDOW_CMD_WFLUSH, IAP_WINDOW_NACK);
+    return 1;
+  }
+
+  if(pbuf->state == IAP_WBUF_FILL)
+  {
+    while(pbuf->length & (sizeof(uint32_t) - 1))
+    {
+      ((uint8_t *)pbuf->data)[pbuf->length ++] = 0xFF;
+    }
+    pbuf->state = IAP_WBUF_READY;
+    iap_window.fill_index = (iap_window.fill_index + 1) % IAP_WINDOW_BUFFER_NUM;
+  }
+  /* the flush respond only reports program errors */
+  iap_window.nack_sent = 0;
+  iap_window.flush = 1;
+  return 0;
+}
+
+/**
+  * @brief  end the window transfer, the staged buffers are still programmed
+  * @param  none
+  * @retval none
+  */
+void iap_window_stop(void)
+{
+  iap_window.active = 0;
+  iap_window.flush = 0;
+  iap_window.ack_pending = 0;
+}
+
+/**
+  * @brief  check for staged data not programmed yet
+  * @param  none
+  * @retval 1 if a staging buffer is in use
+  */
+uint8_t iap_window_busy(void)
+{
+  return iap_window_space() != IAP_WINDOW_BUFFER_SIZE * IAP_WINDOW_BUFFER_NUM;
+}
+
+/**
+  * @brief  program one window staging buffer, sectors are erased when the
+  *         buffer reaches their first word
+  * @param  pbuf: staging buffer
+  * @retval none
+  */
+static void iap_window_program(iap_wbuf_type *pbuf)
+{
+  uint32_t sector_mask = iap_window.sector_size - 1;
+  uint32_t address = (pbuf->address + sector_mask) & ~sector_mask;
+
+  for(; address < pbuf->address + pbuf->length; address += iap_window.sector_size)
+  {
+    iap_window_port_erase(address);
+  }
+
+  if(iap_window_port_program(pbuf->address, pbuf->data, pbuf->length) != 0)
+  {
+    iap_window.error = 1;
+  }
+}
+
+/**
+  * @brief  build a window respond with the next expected sequence
+  * @param  respond: respond report
+  * @param  iap_cmd: iap command
+  * @retval none
+  */
+static void iap_window_ack(uint8_t *respond, uint16_t iap_cmd)
+{
+  uint16_t result = IAP_WINDOW_ACK;
+
+  if(iap_window.error || iap_window.nack_sent)
+  {
+    result = IAP_WINDOW_NACK;
+  }
+
+  iap_window.ack_seq = iap_window.seq;
+  iap_window_header(respond, iap_cmd, result);
+  respond[4] = (uint8_t)((iap_window.ack_seq >> 8) & 0xFF);
+  respond[5] = (uint8_t)((iap_window.ack_seq) & 0xFF);
+  respond[6] = iap_window.error;
+}
+
+/**
+  * @brief  iap window poll, called from the main loop. programs the staged
+  *         buffers while usb keeps receiving into the other one and sends the
+  *         pending respond once the in endpoint is free.
+  * @param  none
+  * @retval none
+  */
+void iap_window_poll(void)
+{
+  iap_wbuf_type *pbuf = &iap_window.wbuf[iap_window.prog_index];
+  uint8_t respond[IAP_WINDOW_REPORT_SIZE];
+
+  if(pbuf->state == IAP_WBUF_READY)
+  {
+    iap_window_program(pbuf);
+    pbuf->length = 0;
+    pbuf->state = IAP_WBUF_FREE;
+    iap_window.prog_index = (iap_window.prog_index + 1) % IAP_WINDOW_BUFFER_NUM;
+
+    /* the held report fits now, the endpoint still naks so no race with the isr */
+    if(iap_window.rx_hold)
+    {
+      iap_window.rx_hold = 0;
+      if(iap_window_data(iap_window.hold_report, iap_window.hold_len) != IAP_WINDOW_HOLD)
+      {
+        iap_window_port_resume();
+      }
+    }
+  }
+
+  /* the pending flag is cleared before the respond is built so that a
+     report received meanwhile requests the next one */
+  if(iap_window.flush && iap_window_busy() == 0)
+  {
+    iap_window.flush = 0;
+    iap_window.ack_pending = 0;
+    iap_window_ack(respond, IAP_WINDOW_CMD_WFLUSH);
+    if(iap_window_port_send(respond) == 0)
+    {
+      iap_window.flush = 1;
+    }
+  }
+  else if(iap_window.ack_pending)
+  {
+    iap_window.ack_pending = 0;
+    iap_window_ack(respond, IAP_WINDOW_CMD_WDATA);
+    if(iap_window_port_send(respond) == 0)
+    {
+      iap_window.ack_pending = 1;
+    }
+  }
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -53,15 +53,19 @@ void usb_low_power_wakeup_config(void);
   */
 int main(void)
 {
+  uint32_t app_address;
+
   system_clock_config();
 
   nvic_priority_group_config(NVIC_PRIORITY_GROUP_4);
 
   iap_init();
 
-  if(iap_get_upgrade_flag() == IAP_SUCCESS)
+  /* boot the newest valid image, or stay in iap mode */
+  app_address = boot_select();
+  if(app_address != 0)
   {
-    jump_to_app(FLASH_APP_ADDRESS);
+    jump_to_app(app_address);
   }
 
   at32_board_init();
@@ -92,8 +96,13 @@ int main(void)
   while(1)
   {
     iap_loop();
-    at32_led_toggle(LED2);
-    delay_ms(200);
+
+    /* no delay while the window write-behind is running */
+    if(iap_info.state != IAP_STS_WINDOW)
+    {
+      at32_led_toggle(LED2);
+      delay_ms(200);
+    }
   }
 }
 
@@ -0,0 +1,379 @@
+/**
+  **************************************************************************
+  * @file     iap_host.c
+  * @brief    hid iap host protocol, windowed transfer with go-back-n
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "iap_host.h"
+#include <string.h>
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup USB_iap_host_tool
+  * @{
+  */
+
+/**
+  * @brief  write a big endian half word
+  * @param  pbuf: buffer
+  * @param  value: half word
+  * @retval none
+  */
+static void iap_host_put16(uint8_t *pbuf, uint16_t value)
+{
+  pbuf[0] = (uint8_t)((value >> 8) & 0xFF);
+  pbuf[1] = (uint8_t)((value) & 0xFF);
+}
+
+/**
+  * @brief  write a big endian word
+  * @param  pbuf: buffer
+  * @param  value: word
+  * @retval none
+  */
+static void iap_host_put32(uint8_t *pbuf, uint32_t value)
+{
+  iap_host_put16(pbuf, (uint16_t)(value >> 16));
+  iap_host_put16(pbuf + 2, (uint16_t)value);
+}
+
+/**
+  * @brief  read a big endian half word
+  * @param  pbuf: buffer
+  * @retval half word
+  */
+static uint16_t iap_host_get16(const uint8_t *pbuf)
+{
+  return (uint16_t)((pbuf[0] << 8) | pbuf[1]);
+}
+
+/**
+  * @brief  read a big endian word
+  * @param  pbuf: buffer
+  * @retval word
+  */
+static uint32_t iap_host_get32(const uint8_t *pbuf)
+{
+  return ((uint32_t)iap_host_get16(pbuf) << 16) | iap_host_get16(pbuf + 2);
+}
+
+/**
+  * @brief  send a report, responds received while the device naks are stale
+  *         because this report was not taken yet and are dropped
+  * @param  host: host link
+  * @param  report: report
+  * @retval IAP_HOST_OK when the report was taken
+  */
+static iap_host_status_type iap_host_send(iap_host_type *host, const uint8_t *report)
+{
+  uint8_t stale[IAP_HOST_REPORT_SIZE];
+  uint32_t timeouts = 0;
+  int rc;
+
+  while((rc = host->send(host->ctx, report)) == 0)
+  {
+    rc = host->recv(host->ctx, stale, host->timeout_ms);
+    if(rc < 0)
+    {
+      return IAP_HOST_ERROR;
+    }
+    if(rc == 0 && ++timeouts > host->retry)
+    {
+      return IAP_HOST_TIMEOUT;
+    }
+  }
+  return (rc < 0) ? IAP_HOST_ERROR : IAP_HOST_OK;
+}
+
+/**
+  * @brief  send a command and wait for its respond, responds of other
+  *         commands are skipped
+  * @param  host: host link
+  * @param  cmd: iap command
+  * @param  param: command parameters, may be NULL
+  * @param  param_len: parameter length
+  * @param  respond: respond report, may be NULL
+  * @retval IAP_HOST_OK if acknowledged, IAP_HOST_NACKED if refused
+  */
+iap_host_status_type iap_host_command(iap_host_type *host, uint16_t cmd, const uint8_t *param,
+                                      uint32_t param_len, uint8_t *respond)
+{
+  uint8_t report[IAP_HOST_REPORT_SIZE];
+  uint32_t timeouts = 0;
+  iap_host_status_type status;
+  int rc;
+
+  if(param_len > IAP_HOST_REPORT_SIZE - 2)
+  {
+    return IAP_HOST_ERROR;
+  }
+
+  memset(report, 0, sizeof(report));
+  iap_host_put16(report, cmd);
+  if(param_len != 0)
+  {
+    memcpy(report + 2, param, param_len);
+  }
+
+  status = iap_host_send(host, report);
+  if(status != IAP_HOST_OK)
+  {
+    return status;
+  }
+
+  while(timeouts <= host->retry)
+  {
+    rc = host->recv(host->ctx, report, host->timeout_ms);
+    if(rc < 0)
+    {
+      return IAP_HOST_ERROR;
+    }
+    if(rc == 0)
+    {
+      timeouts ++;
+      continue;
+    }
+    if(iap_host_get16(report) != cmd)
+    {
+      continue;
+    }
+
+    if(respond != NULL)
+    {
+      memcpy(respond, report, IAP_HOST_REPORT_SIZE);
+    }
+    return (iap_host_get16(report + 2) == IAP_HOST_ACK) ? IAP_HOST_OK : IAP_HOST_NACKED;
+  }
+  return IAP_HOST_TIMEOUT;
+}
+
+/**
+  * @brief  get the slot address the device downloads the new image to
+  * @param  host: host link
+  * @param  address: slot address
+  * @retval IAP_HOST_OK if acknowledged
+  */
+iap_host_status_type iap_host_get(iap_host_type *host, uint32_t *address)
+{
+  uint8_t respond[IAP_HOST_REPORT_SIZE];
+  iap_host_status_type status;
+
+  status = iap_host_command(host, IAP_HOST_CMD_GET, NULL, 0, respond);
+  if(status == IAP_HOST_OK)
+  {
+    *address = iap_host_get32(respond + 4);
+  }
+  return status;
+}
+
+/**
+  * @brief  build the wdata report of a sequence number
+  * @param  report: report
+  * @param  data: image data
+  * @param  len: image length
+  * @param  payload: data bytes per report
+  * @param  seq: report index
+  * @retval none
+  */
+static void iap_host_wdata(uint8_t *report, const uint8_t *data, uint32_t len,
+                           uint32_t payload, uint32_t seq)
+{
+  uint32_t offset = seq * payload;
+  uint32_t size = len - offset;
+
+  if(size > payload)
+  {
+    size = payload;
+  }
+
+  memset(report, 0, IAP_HOST_REPORT_SIZE);
+  iap_host_put16(report, IAP_HOST_CMD_WDATA);
+  iap_host_put16(report + 2, (uint16_t)seq);
+  iap_host_put16(report + 4, (uint16_t)size);
+  memcpy(report + 6, data + offset, size);
+}
+
+/**
+  * @brief  write data with the windowed transfer. up to window reports are
+  *         sent ahead, the device acknowledges the next expected sequence.
+  *         on a nack or a timeout the reports are sent again from the first
+  *         one not acknowledged (go-back-n). once everything is sent the last
+  *         report is sent again, the device answers that out of order report
+  *         at once so the tail needs no timeout.
+  * @param  host: host link
+  * @param  address: sector aligned start address in the target slot
+  * @param  data: data
+  * @param  len: data length
+  * @retval IAP_HOST_OK when all data is in flash
+  */
+iap_host_status_type iap_host_window_write(iap_host_type *host, uint32_t address,
+                                           const uint8_t *data, uint32_t len)
+{
+  uint8_t param[4], report[IAP_HOST_REPORT_SIZE];
+  uint32_t window, payload, total, base = 0, next = 0, acked, timeouts = 0;
+  uint8_t probe = 0;
+  iap_host_status_type status;
+  int rc;
+
+  iap_host_put32(param, address);
+  status = iap_host_command(host, IAP_HOST_CMD_WSTART, param, sizeof(param), report);
+  if(status != IAP_HOST_OK)
+  {
+    return status;
+  }
+
+  window = iap_host_get16(report + 4);
+  payload = iap_host_get16(report + 6);
+  if(window == 0 || payload == 0 || payload > IAP_HOST_REPORT_SIZE - 6)
+  {
+    return IAP_HOST_ERROR;
+  }
+  total = (len + payload - 1) / payload;
+
+  while(base < total)
+  {
+    while(next < total && next - base < window)
+    {
+      iap_host_wdata(report, data, len, payload, next);
+      rc = host->send(host->ctx, report);
+      if(rc < 0)
+      {
+        return IAP_HOST_ERROR;
+      }
+      /* the device holds a report until flash is free, collect responds */
+      if(rc == 0)
+      {
+        break;
+      }
+      next ++;
+    }
+
+    if(next == total && probe == 0)
+    {
+      iap_host_wdata(report, data, len, payload, total - 1);
+      rc = host->send(host->ctx, report);
+      if(rc < 0)
+      {
+        return IAP_HOST_ERROR;
+      }
+      probe = (uint8_t)rc;
+    }
+
+    rc = host->recv(host->ctx, report, host->timeout_ms);
+    if(rc < 0)
+    {
+      return IAP_HOST_ERROR;
+    }
+    if(rc == 0)
+    {
+      if(++timeouts > host->retry)
+      {
+        return IAP_HOST_TIMEOUT;
+      }
+      host->resend += next - base;
+      next = base;
+      probe = 0;
+      continue;
+    }
+    if(iap_host_get16(report) != IAP_HOST_CMD_WDATA)
+    {
+      continue;
+    }
+    timeouts = 0;
+
+    /* program error or a report the device could not take */
+    if(report[6] != 0)
+    {
+      return IAP_HOST_ERROR;
+    }
+
+    acked = base + (uint16_t)(iap_host_get16(report + 4) - (uint16_t)base);
+    if(acked > total)
+    {
+      return IAP_HOST_ERROR;
+    }
+    base = acked;
+    if(next < base)
+    {
+      next = base;
+    }
+
+    if(iap_host_get16(report + 2) == IAP_HOST_NACK && base < total)
+    {
+      host->nack ++;
+      host->resend += next - base;
+      next = base;
+      probe = 0;
+    }
+  }
+
+  status = iap_host_command(host, IAP_HOST_CMD_WFLUSH, NULL, 0, report);
+  if(status != IAP_HOST_OK)
+  {
+    return status;
+  }
+  if(report[6] != 0 || iap_host_get16(report + 4) != (uint16_t)total)
+  {
+    return IAP_HOST_ERROR;
+  }
+  return IAP_HOST_OK;
+}
+
+/**
+  * @brief  download an image to the slot selected by the device and build
+  *         its manifest, the caller sends IAP_HOST_CMD_JMP to start it
+  * @param  host: host link
+  * @param  image: image data
+  * @param  len: image length
+  * @param  address: slot the image was written to
+  * @retval IAP_HOST_OK when the manifest is written
+  */
+iap_host_status_type iap_host_download(iap_host_type *host, const uint8_t *image,
+                                       uint32_t len, uint32_t *address)
+{
+  iap_host_status_type status;
+
+  status = iap_host_command(host, IAP_HOST_CMD_START, NULL, 0, NULL);
+  if(status == IAP_HOST_OK)
+  {
+    status = iap_host_get(host, address);
+  }
+  if(status == IAP_HOST_OK)
+  {
+    status = iap_host_window_write(host, *address, image, len);
+  }
+  if(status == IAP_HOST_OK)
+  {
+    status = iap_host_command(host, IAP_HOST_CMD_FINISH, NULL, 0, NULL);
+  }
+  return status;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,111 @@
+/**
+  **************************************************************************
+  * @file     iap_host.h
+  * @brief    hid iap host protocol header file
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* define to prevent recursive inclusion -------------------------------------*/
+#ifndef __IAP_HOST_H
+#define __IAP_HOST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup USB_iap_host_tool
+  * @{
+  */
+
+/**
+  * @brief iap commands and results, see hid_iap_class.h of the bootloader
+  */
+#define IAP_HOST_CMD_IDLE                0x5AA0
+#define IAP_HOST_CMD_START               0x5AA1
+#define IAP_HOST_CMD_ADDR                0x5AA2
+#define IAP_HOST_CMD_DATA                0x5AA3
+#define IAP_HOST_CMD_FINISH              0x5AA4
+#define IAP_HOST_CMD_CRC                 0x5AA5
+#define IAP_HOST_CMD_JMP                 0x5AA6
+#define IAP_HOST_CMD_GET                 0x5AA7
+#define IAP_HOST_CMD_WSTART              0x5AA8
+#define IAP_HOST_CMD_WDATA               0x5AA9
+#define IAP_HOST_CMD_WFLUSH              0x5AAA
+
+#define IAP_HOST_ACK                     0xFF00
+#define IAP_HOST_NACK                    0x00FF
+#define IAP_HOST_REPORT_SIZE             64
+
+/**
+  * @brief host operation status
+  */
+typedef enum
+{
+  IAP_HOST_OK,
+  IAP_HOST_NACKED,
+  IAP_HOST_TIMEOUT,
+  IAP_HOST_ERROR
+}iap_host_status_type;
+
+/**
+  * @brief host link, one hid report is IAP_HOST_REPORT_SIZE bytes
+  *        - send: 1 if the report was taken, 0 if the device naks it, < 0 on error
+  *        - recv: 1 if a report was received, 0 on timeout, < 0 on error
+  */
+typedef struct
+{
+  int (*send)(void *ctx, const uint8_t *report);
+  int (*recv)(void *ctx, uint8_t *report, uint32_t timeout_ms);
+  void *ctx;
+  uint32_t timeout_ms;                             /*!< respond timeout */
+  uint32_t retry;                                  /*!< timeouts in a row before giving up */
+
+  uint32_t resend;                                 /*!< reports sent again */
+  uint32_t nack;                                   /*!< out of order responds */
+}iap_host_type;
+
+iap_host_status_type iap_host_command(iap_host_type *host, uint16_t cmd, const uint8_t *param,
+                                      uint32_t param_len, uint8_t *respond);
+iap_host_status_type iap_host_get(iap_host_type *host, uint32_t *address);
+iap_host_status_type iap_host_window_write(iap_host_type *host, uint32_t address,
+                                           const uint8_t *data, uint32_t len);
+iap_host_status_type iap_host_download(iap_host_type *host, const uint8_t *image,
+                                       uint32_t len, uint32_t *address);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,159 @@
+/**
+  **************************************************************************
+  * @file     iap_image.c
+  * @brief    image trailer of the bootloader, written and checked on the host
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "iap_image.h"
+#include <string.h>
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup USB_iap_host_tool
+  * @{
+  */
+
+/**
+  * @brief  crc32 as the at32 crc unit computes it over the flash words of
+  *         the bootloader: poly 0x04C11DB7, msb first, no reflection and no
+  *         final xor, the bytes in address order.
+  * @param  crc: crc of the preceding bytes, 0xFFFFFFFF to start
+  * @param  data: bytes
+  * @param  len: byte number
+  * @retval crc value
+  */
+uint32_t iap_image_crc(uint32_t crc, const uint8_t *data, uint32_t len)
+{
+  uint32_t i_index, bit;
+
+  for(i_index = 0; i_index < len; i_index ++)
+  {
+    crc ^= (uint32_t)data[i_index] << 24;
+    for(bit = 0; bit < 8; bit ++)
+    {
+      crc = (crc & 0x80000000) ? (crc << 1) ^ 0x04C11DB7 : (crc << 1);
+    }
+  }
+  return crc;
+}
+
+/**
+  * @brief  store a little endian word
+  * @param  pdata: destination
+  * @param  value: word
+  * @retval none
+  */
+static void iap_image_put(uint8_t *pdata, uint32_t value)
+{
+  pdata[0] = (uint8_t)(value);
+  pdata[1] = (uint8_t)(value >> 8);
+  pdata[2] = (uint8_t)(value >> 16);
+  pdata[3] = (uint8_t)(value >> 24);
+}
+
+/**
+  * @brief  load a little endian word
+  * @param  pdata: source
+  * @retval word
+  */
+static uint32_t iap_image_get(const uint8_t *pdata)
+{
+  return (uint32_t)pdata[0] | (uint32_t)pdata[1] << 8 |
+         (uint32_t)pdata[2] << 16 | (uint32_t)pdata[3] << 24;
+}
+
+/**
+  * @brief  pad the image to a word with erased bytes and append the trailer
+  * @param  image: image, IAP_IMAGE_PACK_EXTRA bytes of room after len
+  * @param  len: image length
+  * @param  version: image version
+  * @retval packed length
+  */
+uint32_t iap_image_pack(uint8_t *image, uint32_t len, uint32_t version)
+{
+  uint8_t *trailer;
+
+  while(len & (sizeof(uint32_t) - 1))
+  {
+    image[len ++] = 0xFF;
+  }
+
+  trailer = image + len;
+  iap_image_put(trailer + 0, version);
+  iap_image_put(trailer + 4, len);
+  iap_image_put(trailer + 8, iap_image_crc(0xFFFFFFFF, image, len + 8));
+  iap_image_put(trailer + 12, BOOT_IMAGE_MAGIC);
+
+  return len + sizeof(boot_image_trailer_type);
+}
+
+/**
+  * @brief  check the trailer of a packed image the way the bootloader does,
+  *         erased words after the trailer are skipped.
+  * @param  image: packed image
+  * @param  len: length
+  * @param  trailer: trailer found, may be NULL
+  * @retval 0 if the image is packed and its crc matches, -1 otherwise
+  */
+int iap_image_check(const uint8_t *image, uint32_t len, boot_image_trailer_type *trailer)
+{
+  boot_image_trailer_type found;
+  const uint8_t *ptrailer;
+
+  len &= ~(uint32_t)(sizeof(uint32_t) - 1);
+  while(len > sizeof(boot_image_trailer_type) && iap_image_get(image + len - 4) == 0xFFFFFFFF)
+  {
+    len -= sizeof(uint32_t);
+  }
+  if(len < sizeof(boot_image_trailer_type))
+  {
+    return -1;
+  }
+
+  ptrailer = image + len - sizeof(boot_image_trailer_type);
+  found.version = iap_image_get(ptrailer + 0);
+  found.length = iap_image_get(ptrailer + 4);
+  found.image_crc = iap_image_get(ptrailer + 8);
+  found.magic = iap_image_get(ptrailer + 12);
+
+  if(found.magic != BOOT_IMAGE_MAGIC || found.length != (uint32_t)(ptrailer - image) ||
+     iap_image_crc(0xFFFFFFFF, image, found.length + 8) != found.image_crc)
+  {
+    return -1;
+  }
+
+  if(trailer != NULL)
+  {
+    memcpy(trailer, &found, sizeof(found));
+  }
+  return 0;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
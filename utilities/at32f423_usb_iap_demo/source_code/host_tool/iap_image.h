@@ -0,0 +1,63 @@
+/**
+  **************************************************************************
+  * @file     iap_image.h
+  * @brief    image packing of the host tool header file
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* define to prevent recursive inclusion -------------------------------------*/
+#ifndef __IAP_IMAGE_H
+#define __IAP_IMAGE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "boot_image.h"
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup USB_iap_host_tool
+  * @{
+  */
+
+/* room iap_image_pack needs after the image: word padding and the trailer */
+#define IAP_IMAGE_PACK_EXTRA             (3 + sizeof(boot_image_trailer_type))
+
+uint32_t iap_image_crc(uint32_t crc, const uint8_t *data, uint32_t len);
+uint32_t iap_image_pack(uint8_t *image, uint32_t len, uint32_t version);
+int iap_image_check(const uint8_t *image, uint32_t len, boot_image_trailer_type *trailer);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
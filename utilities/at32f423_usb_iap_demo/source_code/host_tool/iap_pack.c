@@ -0,0 +1,117 @@
+/**
+  **************************************************************************
+  * @file     iap_pack.c
+  * @brief    image packer, appends the version and crc trailer for the bootloader
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "iap_image.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup USB_iap_host_tool
+  * @{
+  */
+
+/**
+  * @brief  pack a binary image for the at32 hid iap bootloader
+  *         usage: iap_pack version app.bin app_packed.bin
+  * @param  argc: argument count
+  * @param  argv: arguments
+  * @retval 0 on success
+  */
+int main(int argc, char *argv[])
+{
+  FILE *file;
+  uint8_t *image = NULL;
+  uint32_t version, len = 0;
+  long size = 0;
+  char *end;
+
+  if(argc != 4)
+  {
+    fprintf(stderr, "usage: %s version app.bin app_packed.bin\n", argv[0]);
+    return 2;
+  }
+
+  version = (uint32_t)strtoul(argv[1], &end, 0);
+  if(*end != '\0' || version == 0 || version == 0xFFFFFFFF)
+  {
+    fprintf(stderr, "invalid version %s\n", argv[1]);
+    return 2;
+  }
+
+  file = fopen(argv[2], "rb");
+  if(file != NULL && fseek(file, 0, SEEK_END) == 0 && (size = ftell(file)) > 0 &&
+     fseek(file, 0, SEEK_SET) == 0 && (image = malloc((size_t)size + IAP_IMAGE_PACK_EXTRA)) != NULL &&
+     fread(image, 1, (size_t)size, file) == (size_t)size)
+  {
+    len = (uint32_t)size;
+  }
+  if(file != NULL)
+  {
+    fclose(file);
+  }
+  if(len == 0)
+  {
+    fprintf(stderr, "cannot read %s\n", argv[2]);
+    free(image);
+    return 1;
+  }
+
+  if(iap_image_check(image, len, NULL) == 0)
+  {
+    fprintf(stderr, "%s is packed already\n", argv[2]);
+    free(image);
+    return 1;
+  }
+
+  len = iap_image_pack(image, len, version);
+
+  file = fopen(argv[3], "wb");
+  if(file == NULL || fwrite(image, 1, len, file) != len)
+  {
+    fprintf(stderr, "cannot write %s\n", argv[3]);
+    if(file != NULL)
+    {
+      fclose(file);
+    }
+    free(image);
+    return 1;
+  }
+  fclose(file);
+
+  printf("%s: version %u, %u bytes\n", argv[3], version, len);
+  free(image);
+  return 0;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
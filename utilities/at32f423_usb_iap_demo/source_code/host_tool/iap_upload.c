@@ -0,0 +1,197 @@
+/**
+  **************************************************************************
+  * @file     iap_upload.c
+  * @brief    hid iap uploader for linux hidraw
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+#include "iap_host.h"
+#include "iap_image.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/** @addtogroup UTILITIES_examples
+  * @{
+  */
+
+/** @addtogroup USB_iap_host_tool
+  * @{
+  */
+
+/**
+  * @brief  send one output report, the report id 0 is prepended because the
+  *         iap interface has no numbered reports. write blocks while the
+  *         device naks, so the report is always taken.
+  * @param  ctx: hidraw file descriptor
+  * @param  report: report
+  * @retval 1 if sent, -1 on error
+  */
+static int hidraw_send(void *ctx, const uint8_t *report)
+{
+  int fd = *(int *)ctx;
+  uint8_t buf[IAP_HOST_REPORT_SIZE + 1];
+
+  buf[0] = 0;
+  memcpy(buf + 1, report, IAP_HOST_REPORT_SIZE);
+  if(write(fd, buf, sizeof(buf)) != (ssize_t)sizeof(buf))
+  {
+    return -1;
+  }
+  return 1;
+}
+
+/**
+  * @brief  receive one input report
+  * @param  ctx: hidraw file descriptor
+  * @param  report: report
+  * @param  timeout_ms: timeout
+  * @retval 1 if received, 0 on timeout, -1 on error
+  */
+static int hidraw_recv(void *ctx, uint8_t *report, uint32_t timeout_ms)
+{
+  struct pollfd pfd;
+  ssize_t len;
+  int rc;
+
+  pfd.fd = *(int *)ctx;
+  pfd.events = POLLIN;
+  rc = poll(&pfd, 1, (int)timeout_ms);
+  if(rc <= 0)
+  {
+    return (rc == 0 || errno == EINTR) ? 0 : -1;
+  }
+
+  len = read(pfd.fd, report, IAP_HOST_REPORT_SIZE);
+  return (len == IAP_HOST_REPORT_SIZE) ? 1 : -1;
+}
+
+/**
+  * @brief  read the image file
+  * @param  path: file path
+  * @param  len: image length
+  * @retval image data, NULL on error
+  */
+static uint8_t *image_load(const char *path, uint32_t *len)
+{
+  FILE *file = fopen(path, "rb");
+  uint8_t *image = NULL;
+  long size;
+
+  if(file == NULL)
+  {
+    return NULL;
+  }
+  if(fseek(file, 0, SEEK_END) == 0 && (size = ftell(file)) > 0 &&
+     fseek(file, 0, SEEK_SET) == 0 && (image = malloc((size_t)size)) != NULL)
+  {
+    if(fread(image, 1, (size_t)size, file) == (size_t)size)
+    {
+      *len = (uint32_t)size;
+    }
+    else
+    {
+      free(image);
+      image = NULL;
+    }
+  }
+  fclose(file);
+  return image;
+}
+
+/**
+  * @brief  download a binary image to the at32 hid iap bootloader
+  *         usage: iap_upload /dev/hidrawN image.bin [--no-jump], the image
+  *         is packed by iap_pack
+  * @param  argc: argument count
+  * @param  argv: arguments
+  * @retval 0 on success
+  */
+int main(int argc, char *argv[])
+{
+  iap_host_type host;
+  iap_host_status_type status;
+  boot_image_trailer_type trailer;
+  uint8_t *image;
+  uint32_t len = 0, address = 0;
+  int fd;
+
+  if(argc < 3)
+  {
+    fprintf(stderr, "usage: %s /dev/hidrawN image.bin [--no-jump]\n", argv[0]);
+    return 2;
+  }
+
+  image = image_load(argv[2], &len);
+  if(image == NULL)
+  {
+    fprintf(stderr, "cannot read %s\n", argv[2]);
+    return 1;
+  }
+
+  /* the bootloader only accepts images with the trailer of iap_pack */
+  if(iap_image_check(image, len, &trailer) != 0)
+  {
+    fprintf(stderr, "%s has no image trailer, pack it with iap_pack first\n", argv[2]);
+    free(image);
+    return 1;
+  }
+
+  fd = open(argv[1], O_RDWR);
+  if(fd < 0)
+  {
+    fprintf(stderr, "cannot open %s: %s\n", argv[1], strerror(errno));
+    free(image);
+    return 1;
+  }
+
+  memset(&host, 0, sizeof(host));
+  host.send = hidraw_send;
+  host.recv = hidraw_recv;
+  host.ctx = &fd;
+  host.timeout_ms = 1000;
+  host.retry = 5;
+
+  status = iap_host_download(&host, image, len, &address);
+  printf("version %u, %u bytes to 0x%08X: %s (%u resent, %u nack)\n", trailer.version, len, address,
+         (status == IAP_HOST_OK) ? "ok" : "failed", host.resend, host.nack);
+
+  if(status == IAP_HOST_OK && (argc < 4 || strcmp(argv[3], "--no-jump") != 0))
+  {
+    status = iap_host_command(&host, IAP_HOST_CMD_JMP, NULL, 0, NULL);
+  }
+
+  close(fd);
+  free(image);
+  return (status == IAP_HOST_OK) ? 0 : 1;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,170 @@
+/**
+  **************************************************************************
+  * @file     iap_image_test.c
+  * @brief    host test of the image packer against the crc unit word order
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* the packer computes the crc over bytes, the bootloader feeds the flash
+   words to the crc unit msb first after an endian swap. the reference model
+   here does the latter, then packed images are checked against it and
+   against the trailer search of the bootloader. */
+
+#include "iap_image.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_MAX_LEN                     4096
+#define TEST_PAD_LEN                     1024
+
+#define TEST_CHECK(cond)                 do { if(!(cond)) { printf("  %s:%d: %s\n", __func__, __LINE__, #cond); \
+                                           test_failed ++; } } while(0)
+
+static int test_failed;
+static uint8_t test_image[TEST_MAX_LEN + IAP_IMAGE_PACK_EXTRA + TEST_PAD_LEN];
+
+/**
+  * @brief  crc unit model, one little endian flash word after CONVERT_ENDIAN
+  */
+static uint32_t test_crc_word(uint32_t crc, const uint8_t *pdata)
+{
+  uint32_t word = (uint32_t)pdata[0] << 24 | (uint32_t)pdata[1] << 16 |
+                  (uint32_t)pdata[2] << 8 | pdata[3];
+  uint32_t bit;
+
+  crc ^= word;
+  for(bit = 0; bit < 32; bit ++)
+  {
+    crc = (crc & 0x80000000) ? (crc << 1) ^ 0x04C11DB7 : (crc << 1);
+  }
+  return crc;
+}
+
+/**
+  * @brief  fill the image with a pseudo random pattern
+  */
+static void test_fill(uint32_t len, uint32_t seed)
+{
+  uint32_t i_index;
+
+  for(i_index = 0; i_index < len; i_index ++)
+  {
+    seed = seed * 1103515245 + 12345;
+    test_image[i_index] = (uint8_t)(seed >> 16);
+  }
+}
+
+/**
+  * @brief  the byte crc matches the crc unit over words and the standard check value
+  */
+static void test_crc(void)
+{
+  uint32_t crc = 0xFFFFFFFF, i_index;
+
+  TEST_CHECK(iap_image_crc(0xFFFFFFFF, (const uint8_t *)"123456789", 9) == 0x0376E6E7);
+
+  test_fill(TEST_MAX_LEN, 1);
+  for(i_index = 0; i_index < TEST_MAX_LEN; i_index += 4)
+  {
+    crc = test_crc_word(crc, test_image + i_index);
+  }
+  TEST_CHECK(iap_image_crc(0xFFFFFFFF, test_image, TEST_MAX_LEN) == crc);
+
+  /* continued over two parts as the bootloader does per block */
+  TEST_CHECK(iap_image_crc(iap_image_crc(0xFFFFFFFF, test_image, 1000), test_image + 1000,
+                           TEST_MAX_LEN - 1000) == crc);
+}
+
+/**
+  * @brief  packed images of every length alignment, with and without erased padding
+  */
+static void test_pack(void)
+{
+  boot_image_trailer_type trailer;
+  uint32_t len, packed, crc, i_index;
+
+  for(len = 1; len <= 64; len ++)
+  {
+    test_fill(len, len);
+    packed = iap_image_pack(test_image, len, len + 100);
+
+    TEST_CHECK(packed == ((len + 3) & ~3u) + sizeof(boot_image_trailer_type));
+    TEST_CHECK(iap_image_check(test_image, packed, &trailer) == 0);
+    TEST_CHECK(trailer.version == len + 100 && trailer.length == ((len + 3) & ~3u));
+    TEST_CHECK(trailer.magic == BOOT_IMAGE_MAGIC);
+
+    for(i_index = len; i_index < trailer.length; i_index ++)
+    {
+      TEST_CHECK(test_image[i_index] == 0xFF);
+    }
+
+    /* the crc unit over the image, version and length words */
+    crc = 0xFFFFFFFF;
+    for(i_index = 0; i_index < trailer.length + 8; i_index += 4)
+    {
+      crc = test_crc_word(crc, test_image + i_index);
+    }
+    TEST_CHECK(crc == trailer.image_crc);
+
+    /* the download pads the last block with erased bytes */
+    memset(test_image + packed, 0xFF, TEST_PAD_LEN);
+    TEST_CHECK(iap_image_check(test_image, packed + TEST_PAD_LEN, NULL) == 0);
+  }
+}
+
+/**
+  * @brief  unpacked and damaged images are refused
+  */
+static void test_reject(void)
+{
+  uint32_t packed;
+
+  test_fill(TEST_MAX_LEN, 7);
+  TEST_CHECK(iap_image_check(test_image, TEST_MAX_LEN, NULL) != 0);
+  TEST_CHECK(iap_image_check(test_image, 8, NULL) != 0);
+
+  packed = iap_image_pack(test_image, 1000, 3);
+  TEST_CHECK(iap_image_check(test_image, packed, NULL) == 0);
+
+  /* a changed image byte */
+  test_image[500] ^= 0x01;
+  TEST_CHECK(iap_image_check(test_image, packed, NULL) != 0);
+  test_image[500] ^= 0x01;
+
+  /* a changed version, covered by the crc */
+  test_image[1000] ^= 0x01;
+  TEST_CHECK(iap_image_check(test_image, packed, NULL) != 0);
+  test_image[1000] ^= 0x01;
+
+  /* a truncated download */
+  TEST_CHECK(iap_image_check(test_image, packed - 4, NULL) != 0);
+  TEST_CHECK(iap_image_check(test_image, packed, NULL) == 0);
+}
+
+int main(void)
+{
+  test_crc();
+  test_pack();
+  test_reject();
+
+  printf("%d checks failed\n", test_failed);
+  return test_failed;
+}
@@ -0,0 +1,437 @@
+/**
+  **************************************************************************
+  * @file     iap_window_test.c
+  * @brief    host test of the windowed transfer against a simulated device
+  **************************************************************************
+  *
+  * Copyright (c) 2025, Artery Technology, All rights reserved.
+  *
+  * The software Board Support Package (BSP) that is made available to
+  * download from Artery official website is the copyrighted work of Artery.
+  * Artery authorizes customers to use, copy, and distribute the BSP
+  * software and its related documentation for the purpose of design and
+  * development in conjunction with Artery microcontrollers. Use of the
+  * software is governed by this copyright notice and the following disclaimer.
+  *
+  * THIS SOFTWARE IS PROVIDED ON "AS IS" BASIS WITHOUT WARRANTIES,
+  * GUARANTEES OR REPRESENTATIONS OF ANY KIND. ARTERY EXPRESSLY DISCLAIMS,
+  * TO THE FULLEST EXTENT PERMITTED BY LAW, ALL EXPRESS, IMPLIED OR
+  * STATUTORY OR OTHER WARRANTIES, GUARANTEES OR REPRESENTATIONS,
+  * INCLUDING BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, OR NON-INFRINGEMENT.
+  *
+  **************************************************************************
+  */
+
+/* the bootloader window engine runs on a simulated flash and usb endpoints,
+   iap_host drives it like the uploader. each case injects a fault: lost
+   reports, a slow flash that makes the device hold reports, a busy in
+   endpoint or a program error. */
+
+#include "iap_window.h"
+#include "iap_host.h"
+#include <stdio.h>
+#include <string.h>
+
+#define SIM_FLASH_BASE                   0x08000000
+#define SIM_FLASH_SIZE                   (256 * 1024)
+#define SIM_SLOT_ADDRESS                 0x08006000
+#define SIM_SLOT_END                     0x08022000
+#define SIM_IN_DEPTH                     4
+#define SIM_DROP_NUM                     4
+#define SIM_OLD_DATA                     0x00
+
+/* the device only holds reports when the window does not fit in the staging
+   buffers, build with -DIAP_WINDOW_BUFFER_SIZE=1024 -DIAP_WINDOW_ACK_INTERVAL=32 */
+#if (IAP_WINDOW_SIZE * IAP_WINDOW_DATA_LEN) > (IAP_WINDOW_BUFFER_SIZE * IAP_WINDOW_BUFFER_NUM)
+#define SIM_HOLD                         1
+#else
+#define SIM_HOLD                         0
+#endif
+
+/**
+  * @brief test case, the faults are injected by the simulated device
+  */
+typedef struct
+{
+  const char *name;
+  uint32_t sector_size;
+  uint32_t len;
+  uint32_t offset;                                 /*!< window start in the slot */
+  uint32_t poll_every;                             /*!< host operations per device main loop pass */
+  uint32_t busy_percent;                           /*!< in endpoint busy for main loop responds */
+  uint32_t drop[SIM_DROP_NUM];                     /*!< wdata sequences lost once, 0xFFFF: last */
+  uint32_t fail_offset;                            /*!< program error at this slot offset, 0: none */
+  iap_host_status_type expect;
+}sim_case_type;
+
+/**
+  * @brief simulated device
+  */
+typedef struct
+{
+  const sim_case_type *test;
+  uint8_t flash[SIM_FLASH_SIZE];
+  uint8_t rx[IAP_WINDOW_REPORT_SIZE];
+  uint8_t in_fifo[SIM_IN_DEPTH][IAP_WINDOW_REPORT_SIZE];
+  uint32_t in_head;
+  uint32_t in_count;
+  uint8_t out_armed;
+  uint8_t dropped[SIM_DROP_NUM];
+  uint32_t total;
+  uint32_t ops;
+  uint32_t rand;
+  uint32_t holds;
+  uint32_t busy;
+  uint32_t overwrite;
+}sim_device_type;
+
+static sim_device_type sim;
+
+/**
+  * @brief  pseudo random number, same sequence on every run
+  * @param  none
+  * @retval random value
+  */
+static uint32_t sim_rand(void)
+{
+  sim.rand = sim.rand * 1103515245 + 12345;
+  return (sim.rand >> 16) & 0x7FFF;
+}
+
+/**
+  * @brief  pointer into the simulated flash
+  * @param  address: flash address
+  * @retval pointer
+  */
+static uint8_t *sim_flash(uint32_t address)
+{
+  return &sim.flash[address - SIM_FLASH_BASE];
+}
+
+/**
+  * @brief  queue a respond on the in endpoint
+  * @param  report: respond report
+  * @retval 1 if queued
+  */
+static int sim_in_push(const uint8_t *report)
+{
+  if(sim.in_count == SIM_IN_DEPTH)
+  {
+    return 0;
+  }
+  memcpy(sim.in_fifo[(sim.in_head + sim.in_count) % SIM_IN_DEPTH], report, IAP_WINDOW_REPORT_SIZE);
+  sim.in_count ++;
+  return 1;
+}
+
+void iap_window_port_erase(uint32_t address)
+{
+  if((address & (sim.test->sector_size - 1)) != 0 || address < SIM_SLOT_ADDRESS || address >= SIM_SLOT_END)
+  {
+    sim.overwrite ++;
+    return;
+  }
+  memset(sim_flash(address), 0xFF, sim.test->sector_size);
+}
+
+uint8_t iap_window_port_program(uint32_t address, const uint32_t *data, uint32_t len)
+{
+  uint32_t i_index, word;
+
+  for(i_index = 0; i_index < len / sizeof(uint32_t); i_index ++, address += sizeof(uint32_t))
+  {
+    if(sim.test->fail_offset != 0 && address == SIM_SLOT_ADDRESS + sim.test->fail_offset)
+    {
+      return 1;
+    }
+
+    /* a word is only programmed once after its sector was erased */
+    memcpy(&word, sim_flash(address), sizeof(word));
+    if(word != 0xFFFFFFFF)
+    {
+      sim.overwrite ++;
+      return 1;
+    }
+    memcpy(sim_flash(address), &data[i_index], sizeof(word));
+  }
+  return 0;
+}
+
+uint8_t iap_window_port_send(const uint8_t *report)
+{
+  if(sim_rand() % 100 < sim.test->busy_percent)
+  {
+    sim.busy ++;
+    return 0;
+  }
+  return (uint8_t)sim_in_push(report);
+}
+
+void iap_window_port_resume(void)
+{
+  sim.out_armed = 1;
+}
+
+/**
+  * @brief  out endpoint interrupt, same dispatch as usbd_hid_iap_process
+  * @param  report: received report
+  * @retval none
+  */
+static void sim_device_out(const uint8_t *report)
+{
+  uint8_t respond[IAP_WINDOW_REPORT_SIZE];
+  uint16_t cmd = (uint16_t)((report[0] << 8) | report[1]);
+
+  memcpy(sim.rx, report, IAP_WINDOW_REPORT_SIZE);
+  memset(respond, 0, sizeof(respond));
+  respond[0] = report[0];
+  respond[1] = report[1];
+  respond[2] = (uint8_t)(IAP_WINDOW_ACK >> 8);
+  respond[3] = (uint8_t)(IAP_WINDOW_ACK & 0xFF);
+
+  if(cmd != IAP_WINDOW_CMD_WDATA && cmd != IAP_WINDOW_CMD_WFLUSH)
+  {
+    iap_window_stop();
+  }
+
+  switch(cmd)
+  {
+    case IAP_HOST_CMD_START:
+      iap_window_init(SIM_SLOT_ADDRESS, SIM_SLOT_END - SIM_SLOT_ADDRESS, sim.test->sector_size);
+      sim_in_push(respond);
+      break;
+    case IAP_HOST_CMD_GET:
+      respond[4] = (uint8_t)(SIM_SLOT_ADDRESS >> 24);
+      respond[5] = (uint8_t)(SIM_SLOT_ADDRESS >> 16);
+      respond[6] = (uint8_t)(SIM_SLOT_ADDRESS >> 8);
+      respond[7] = (uint8_t)(SIM_SLOT_ADDRESS);
+      sim_in_push(respond);
+      break;
+    case IAP_HOST_CMD_FINISH:
+      if(iap_window_busy() || iap_window.error)
+      {
+        respond[2] = (uint8_t)(IAP_WINDOW_NACK >> 8);
+        respond[3] = (uint8_t)(IAP_WINDOW_NACK & 0xFF);
+      }
+      sim_in_push(respond);
+      break;
+    case IAP_WINDOW_CMD_WSTART:
+      iap_window_start(sim.rx, IAP_WINDOW_REPORT_SIZE, respond);
+      sim_in_push(respond);
+      break;
+    case IAP_WINDOW_CMD_WDATA:
+      if(iap_window_data(sim.rx, IAP_WINDOW_REPORT_SIZE) == IAP_WINDOW_HOLD)
+      {
+        sim.holds ++;
+        sim.out_armed = 0;
+      }
+      break;
+    case IAP_WINDOW_CMD_WFLUSH:
+      if(iap_window_flush(respond))
+      {
+        sim_in_push(respond);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+/**
+  * @brief  one time step of the host, the device main loop runs every
+  *         poll_every steps to model the flash programming time
+  * @param  none
+  * @retval none
+  */
+static void sim_tick(void)
+{
+  if(++sim.ops % sim.test->poll_every == 0)
+  {
+    iap_window_poll();
+  }
+}
+
+/**
+  * @brief  check if a wdata report is lost on its first transmission
+  * @param  report: wdata report
+  * @retval 1 if lost
+  */
+static int sim_drop(const uint8_t *report)
+{
+  uint32_t seq = (report[2] << 8) | report[3];
+  uint32_t i_index;
+
+  for(i_index = 0; i_index < SIM_DROP_NUM; i_index ++)
+  {
+    if(sim.dropped[i_index] == 0 && sim.test->drop[i_index] != 0 &&
+       (sim.test->drop[i_index] == seq || (sim.test->drop[i_index] == 0xFFFF && seq == sim.total - 1)))
+    {
+      sim.dropped[i_index] = 1;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+  * @brief  host send, the device main loop runs every poll_every operations
+  */
+static int sim_host_send(void *ctx, const uint8_t *report)
+{
+  uint16_t cmd = (uint16_t)((report[0] << 8) | report[1]);
+
+  (void)ctx;
+  sim_tick();
+  if(sim.out_armed == 0)
+  {
+    return 0;
+  }
+  if(cmd == IAP_WINDOW_CMD_WDATA && sim_drop(report))
+  {
+    return 1;
+  }
+  sim_device_out(report);
+  return 1;
+}
+
+/**
+  * @brief  host receive, the device main loop runs while the host waits,
+  *         the timeout counts main loop passes
+  */
+static int sim_host_recv(void *ctx, uint8_t *report, uint32_t timeout_ms)
+{
+  uint32_t i_index;
+
+  (void)ctx;
+  for(i_index = 0; i_index <= timeout_ms; i_index ++)
+  {
+    if(sim.in_count != 0)
+    {
+      memcpy(report, sim.in_fifo[sim.in_head], IAP_WINDOW_REPORT_SIZE);
+      sim.in_head = (sim.in_head + 1) % SIM_IN_DEPTH;
+      sim.in_count --;
+      return 1;
+    }
+    sim_tick();
+  }
+  return 0;
+}
+
+/**
+  * @brief  run one case and check the flash content
+  * @param  test: test case
+  * @retval 0 if passed
+  */
+static int sim_run(const sim_case_type *test)
+{
+  static uint8_t image[SIM_SLOT_END - SIM_SLOT_ADDRESS];
+  uint8_t start[IAP_WINDOW_REPORT_SIZE] = {0x5A, 0xA1};
+  iap_host_type host;
+  iap_host_status_type status;
+  uint32_t address, payload = IAP_WINDOW_DATA_LEN, i_index, end, sector_end;
+  const char *reason = NULL;
+
+  memset(&sim, 0, sizeof(sim));
+  memset(&iap_window, 0, sizeof(iap_window));
+  sim.test = test;
+  sim.rand = test->len;
+  sim.out_armed = 1;
+  sim.total = (test->len + payload - 1) / payload;
+  memset(sim.flash, SIM_OLD_DATA, sizeof(sim.flash));
+  for(i_index = 0; i_index < test->len; i_index ++)
+  {
+    image[i_index] = (uint8_t)(sim_rand() >> 3);
+  }
+
+  memset(&host, 0, sizeof(host));
+  host.send = sim_host_send;
+  host.recv = sim_host_recv;
+  host.timeout_ms = 200;
+  host.retry = 8;
+
+  if(test->offset == 0)
+  {
+    status = iap_host_download(&host, image, test->len, &address);
+  }
+  else
+  {
+    sim_device_out(start);
+    sim.in_count = 0;
+    status = iap_host_window_write(&host, SIM_SLOT_ADDRESS + test->offset, image, test->len);
+  }
+
+  if(status != test->expect)
+  {
+    reason = "unexpected status";
+  }
+  else if(sim.overwrite != 0)
+  {
+    reason = "flash programmed without erase or erased outside the slot";
+  }
+  else if(status == IAP_HOST_OK)
+  {
+    end = SIM_SLOT_ADDRESS + test->len;
+    sector_end = (end + test->sector_size - 1) & ~(test->sector_size - 1);
+    if(address != SIM_SLOT_ADDRESS || memcmp(sim_flash(SIM_SLOT_ADDRESS), image, test->len) != 0)
+    {
+      reason = "image mismatch";
+    }
+    for(i_index = end; reason == NULL && i_index < sector_end; i_index ++)
+    {
+      if(*sim_flash(i_index) != 0xFF)
+      {
+        reason = "tail of the last sector not erased";
+      }
+    }
+    if(reason == NULL && sector_end < SIM_SLOT_END && *sim_flash(sector_end) != SIM_OLD_DATA)
+    {
+      reason = "sector after the image touched";
+    }
+    if(reason == NULL && test->drop[0] != 0 && host.resend == 0)
+    {
+      reason = "lost reports not sent again";
+    }
+    if(reason == NULL && SIM_HOLD && test->poll_every > 1 && sim.holds == 0)
+    {
+      reason = "device never held a report";
+    }
+  }
+
+  printf("%s %-28s status=%d resend=%u nack=%u holds=%u busy=%u%s%s\n",
+         reason ? "FAIL" : "PASS", test->name, (int)status, host.resend, host.nack,
+         sim.holds, sim.busy, reason ? ": " : "", reason ? reason : "");
+  return reason ? 1 : 0;
+}
+
+static const sim_case_type sim_case[] =
+{
+  {"clean, 2KB sectors",           0x800,  10000, 0,      1,  0, {0},               0,    IAP_HOST_OK},
+  {"clean, 1KB sectors",           0x400,  7001,  0,      1,  0, {0},               0,    IAP_HOST_OK},
+  {"slow flash, 4KB sectors",      0x1000, 20000, 0,      40, 0, {0},               0,    IAP_HOST_OK},
+  {"lost reports",                 0x800,  12000, 0,      1,  0, {5, 40, 0xFFFF},   0,    IAP_HOST_OK},
+  {"lost reports, slow flash",     0x800,  12000, 0,      25, 0, {3, 17, 0xFFFF},   0,    IAP_HOST_OK},
+  {"busy in endpoint",             0x800,  9000,  0,      1,  60, {0},              0,    IAP_HOST_OK},
+  {"exact buffer multiple",        0x800,  0x1000, 0,     1,  0, {0},               0,    IAP_HOST_OK},
+  {"program error",                0x800,  10000, 0,      1,  0, {0},               3000, IAP_HOST_ERROR},
+  {"unaligned window start",       0x800,  1000,  4,      1,  0, {0},               0,    IAP_HOST_NACKED},
+  {"beyond the slot",              0x800,  0x2000, 0x1B000, 1, 0, {0},              0,    IAP_HOST_ERROR},
+};
+
+/**
+  * @brief  run all cases
+  * @param  none
+  * @retval number of failed cases
+  */
+int main(void)
+{
+  uint32_t i_index;
+  int failed = 0;
+
+  for(i_index = 0; i_index < sizeof(sim_case) / sizeof(sim_case[0]); i_index ++)
+  {
+    failed += sim_run(&sim_case[i_index]);
+  }
+  printf("%d of %u cases failed\n", failed, (unsigned)(sizeof(sim_case) / sizeof(sim_case[0])));
+  return failed;
+}